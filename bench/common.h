@@ -0,0 +1,180 @@
+/** \file common.h
+    \brief Common header for all the benchmark files.
+
+    This includes the main library headers, and declares a very simple framework
+     for registering, running and timing benchmarks.
+    Every result is printed as it's measured. The results can also be written to
+     a JSON file for tracking performance over time (see main.cpp).
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#ifndef ail_bench_common_h
+#define ail_bench_common_h
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ail/math/ailmath.h"
+
+//--------------
+namespace bench {
+//--------------
+
+/// A function which runs a group of related measurements.
+typedef void (*Function)();
+
+/// A benchmark function and its name.
+struct Benchmark
+{
+    const char * name;
+    Function function;
+};
+
+/// Get the list of all registered benchmarks.
+inline std::vector<Benchmark> & getRegistry()
+{
+    static std::vector<Benchmark> registry;
+    return registry;
+}
+
+/// Adds a benchmark to the registry when constructed.
+/// Use the AIL_BENCHMARK macro instead of using this directly.
+struct Registrar
+{
+    Registrar(const char * name, const Function function)
+    {
+        const Benchmark benchmark = { name, function };
+        getRegistry().push_back(benchmark);
+    }
+};
+
+/// Prevent the compiler from optimising away the calculation of a value.
+template <typename T_ty>
+inline void doNotOptimise(const T_ty & value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void * sink;
+    sink = &value;
+#endif
+}
+
+/// Repeatedly call a function, and return the average time per call in nanoseconds.
+/// Calls are made in batches of increasing size until a batch takes long
+///  enough to time reliably. The fastest of several such batches is used.
+template <typename T_function>
+double time(const T_function & function)
+{
+    typedef std::chrono::steady_clock Clock;
+    const double minBatchSeconds = 0.02;
+    const int batchCount = 5;
+
+    std::size_t calls = 1;
+    double best = 0.0;
+    for (int batch = 0; batch < batchCount; ) {
+        const Clock::time_point start = Clock::now();
+        for (std::size_t i = 0; i < calls; ++i)
+            function();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        if (seconds < minBatchSeconds) {
+            calls *= 2;
+            continue;
+        }
+
+        const double perCall = (seconds * 1e9) / static_cast<double>(calls);
+        if (batch == 0 || perCall < best)
+            best = perCall;
+        ++batch;
+    }
+    return best;
+}
+
+/// Time a function which processes one item of a batch, and return the average time per item in nanoseconds.
+/// The function is called with each index from 0 to count - 1 in turn. Its
+///  results are stored, so the calculations can't be optimised away, but the
+///  compiler is still free to vectorise or interleave the calls. This measures
+///  throughput rather than latency, which is usually what matters in a frame.
+/// The function must return a value, which can be a copy of a modified object.
+template <typename T_function>
+double timeEach(const std::size_t count, const T_function & function)
+{
+    typedef typename std::decay<decltype(function(std::size_t(0)))>::type Result;
+    std::unique_ptr<Result[]> results(new Result[count]);
+    const double nanoseconds = time([&] {
+        for (std::size_t i = 0; i < count; ++i)
+            results[i] = function(i);
+        doNotOptimise(results);
+    });
+    return nanoseconds / static_cast<double>(count);
+}
+
+/// Generate random values in the given range, for use as benchmark inputs.
+/// The same seed always gives the same values, so runs can be compared.
+template <typename T_ty>
+std::vector<T_ty> makeRandomValues(const std::size_t count, const T_ty min, const T_ty max, const unsigned seed)
+{
+    typedef typename std::conditional<
+        std::is_integral<T_ty>::value,
+        std::uniform_int_distribution<T_ty>,
+        std::uniform_real_distribution<T_ty>
+    >::type Distribution;
+
+    std::mt19937 rng(seed);
+    Distribution dist(min, max);
+    std::vector<T_ty> values;
+    for (std::size_t i = 0; i < count; ++i)
+        values.push_back(dist(rng));
+    return values;
+}
+
+/// Output the result of a measurement, and record it for the JSON output.
+/// ratioTo optionally gives the time of another measurement to compare against.
+void report(const std::string & name, const double nanoseconds, const double ratioTo = 0.0);
+
+//--------------
+} // bench
+//--------------
+
+// Helpers for AIL_BENCHMARK, to generate a unique identifier from the line number.
+#define AIL_BENCHMARK_CONCAT2(a, b) a##b
+#define AIL_BENCHMARK_CONCAT(a, b) AIL_BENCHMARK_CONCAT2(a, b)
+#define AIL_BENCHMARK_FUNCTION AIL_BENCHMARK_CONCAT(benchmarkFunction, __LINE__)
+
+/// Define and register a benchmark function, with the given name as a string.
+/// The function body should follow the macro, e.g. AIL_BENCHMARK("math::Foo") { ... }
+#define AIL_BENCHMARK(name) \
+    static void AIL_BENCHMARK_FUNCTION(); \
+    static const bench::Registrar AIL_BENCHMARK_CONCAT(benchmarkRegistrar, __LINE__)(name, AIL_BENCHMARK_FUNCTION); \
+    static void AIL_BENCHMARK_FUNCTION()
+
+/// Define and register a benchmark function template, which is run for float, double and int.
+/// The name must be a string literal. The type is appended to it in angle brackets.
+/// The function body should follow the macro, and can refer to the type as T_ty,
+///  e.g. AIL_BENCHMARK_TEMPLATE("math::Foo") { Foo<T_ty> foo; ... }
+#define AIL_BENCHMARK_TEMPLATE(name) \
+    template <typename T_ty> static void AIL_BENCHMARK_FUNCTION(); \
+    static const bench::Registrar AIL_BENCHMARK_CONCAT(benchmarkRegistrarFloat, __LINE__)(name "<float>", AIL_BENCHMARK_FUNCTION<float>); \
+    static const bench::Registrar AIL_BENCHMARK_CONCAT(benchmarkRegistrarDouble, __LINE__)(name "<double>", AIL_BENCHMARK_FUNCTION<double>); \
+    static const bench::Registrar AIL_BENCHMARK_CONCAT(benchmarkRegistrarInt, __LINE__)(name "<int>", AIL_BENCHMARK_FUNCTION<int>); \
+    template <typename T_ty> static void AIL_BENCHMARK_FUNCTION()
+
+/// Define and register a benchmark function template, which is run for float and double only.
+/// This is the same as AIL_BENCHMARK_TEMPLATE, but for operations which only
+///  make sense (or only compile) for floating point types.
+#define AIL_BENCHMARK_TEMPLATE_FP(name) \
+    template <typename T_ty> static void AIL_BENCHMARK_FUNCTION(); \
+    static const bench::Registrar AIL_BENCHMARK_CONCAT(benchmarkRegistrarFloat, __LINE__)(name "<float>", AIL_BENCHMARK_FUNCTION<float>); \
+    static const bench::Registrar AIL_BENCHMARK_CONCAT(benchmarkRegistrarDouble, __LINE__)(name "<double>", AIL_BENCHMARK_FUNCTION<double>); \
+    template <typename T_ty> static void AIL_BENCHMARK_FUNCTION()
+
+#endif //ail_bench_common_h
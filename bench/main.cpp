@@ -0,0 +1,152 @@
+/** \file main.cpp
+    \brief Defines the entry point for the benchmark project.
+
+    Usage: bench [filter] [--json=<file>]
+    Runs every registered benchmark, or only those whose names contain the
+     filter string.
+    If a JSON file is given, all the results are also written to it when the
+     run finishes. The layout follows Google Benchmark's JSON output: a context
+     object describing the run, and a benchmarks array where each entry has a
+     name, real_time, cpu_time and time_unit. That means results can be diffed
+     with the same tools. Only wall-clock time is measured, so cpu_time is the
+     same as real_time. Each name is made of the benchmark name and the
+     measurement name, separated by a slash, e.g. "math::Vector2d<float>/dot".
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "common.h"
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <thread>
+
+namespace {
+
+/// A single recorded measurement.
+struct Result
+{
+    std::string name;
+    double nanoseconds;
+    double ratioTo;
+};
+
+/// Name of the benchmark which is currently running.
+std::string g_currentBenchmark;
+
+/// All the measurements so far.
+std::vector<Result> g_results;
+
+// Write a string as a JSON string literal, with quotes and escaping.
+void writeJsonString(std::FILE * file, const std::string & str)
+{
+    std::fputc('"', file);
+    for (const char c : str) {
+        if (c == '"' || c == '\\')
+            std::fprintf(file, "\\%c", c);
+        else if (static_cast<unsigned char>(c) < 0x20)
+            std::fprintf(file, "\\u%04x", static_cast<unsigned>(c));
+        else
+            std::fputc(c, file);
+    }
+    std::fputc('"', file);
+}
+
+// Write all the recorded measurements to a JSON file.
+// Returns false if the file couldn't be written.
+bool writeJson(const char * path, const char * executable)
+{
+    std::FILE * file = std::fopen(path, "w");
+    if (!file)
+        return false;
+
+    char date[32] = "";
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    std::fprintf(file, "{\n  \"context\": {\n    \"date\": ");
+    writeJsonString(file, date);
+    std::fprintf(file, ",\n    \"executable\": ");
+    writeJsonString(file, executable);
+    std::fprintf(file, ",\n    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+#if defined(NDEBUG)
+    std::fprintf(file, "    \"library_build_type\": \"release\"\n");
+#else
+    std::fprintf(file, "    \"library_build_type\": \"debug\"\n");
+#endif
+    std::fprintf(file, "  },\n  \"benchmarks\": [");
+
+    for (std::size_t i = 0; i < g_results.size(); ++i) {
+        const Result & result = g_results[i];
+        std::fprintf(file, "%s\n    {\n      \"name\": ", (i > 0) ? "," : "");
+        writeJsonString(file, result.name);
+        std::fprintf(file, ",\n      \"run_name\": ");
+        writeJsonString(file, result.name);
+        std::fprintf(file, ",\n      \"run_type\": \"iteration\",\n");
+        std::fprintf(file, "      \"real_time\": %.3f,\n", result.nanoseconds);
+        std::fprintf(file, "      \"cpu_time\": %.3f,\n", result.nanoseconds);
+        std::fprintf(file, "      \"time_unit\": \"ns\"");
+        if (result.ratioTo > 0.0)
+            std::fprintf(file, ",\n      \"speedup\": %.3f", result.ratioTo / result.nanoseconds);
+        std::fprintf(file, "\n    }");
+    }
+
+    std::fprintf(file, "\n  ]\n}\n");
+    return std::fclose(file) == 0;
+}
+
+} // namespace
+
+//--------------
+namespace bench {
+//--------------
+
+void report(const std::string & name, const double nanoseconds, const double ratioTo)
+{
+    if (ratioTo > 0.0)
+        std::printf("  %-48s %12.1f ns  (%.2fx)\n", name.c_str(), nanoseconds, ratioTo / nanoseconds);
+    else
+        std::printf("  %-48s %12.1f ns\n", name.c_str(), nanoseconds);
+    std::fflush(stdout);
+
+    const Result result = { g_currentBenchmark + "/" + name, nanoseconds, ratioTo };
+    g_results.push_back(result);
+}
+
+//--------------
+} // bench
+//--------------
+
+int main(int argc, char * argv[])
+{
+    const char * filter = "";
+    const char * jsonPath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--json=", 7) == 0) {
+            jsonPath = argv[i] + 7;
+        } else if (argv[i][0] == '-') {
+            std::fprintf(stderr, "Usage: %s [filter] [--json=<file>]\n", argv[0]);
+            return 1;
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    for (const bench::Benchmark & benchmark : bench::getRegistry()) {
+        if (std::strstr(benchmark.name, filter) == nullptr)
+            continue;
+        std::printf("%s\n", benchmark.name);
+        g_currentBenchmark = benchmark.name;
+        benchmark.function();
+    }
+
+    if (jsonPath && !writeJson(jsonPath, argv[0])) {
+        std::fprintf(stderr, "Failed to write JSON results to %s\n", jsonPath);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+/** \file bench_Aabb2d.cpp
+    \brief Benchmarks for Aabb2d and Aabb2dArray, compared to BoundingBox2d.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace ail::math;
+
+AIL_BENCHMARK("math::Aabb2d")
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coord(0.0f, 1000.0f);
+    std::uniform_real_distribution<float> size(0.5f, 8.0f);
+
+    const std::size_t count = 10000;
+    const std::string suffix = " (" + std::to_string(count) + " boxes)";
+
+    std::vector<BoundingBox2d<float>> boxes;
+    for (std::size_t i = 0; i < count; ++i)
+        boxes.push_back(BoundingBox2d<float>(coord(rng), coord(rng), size(rng), size(rng)));
+
+    std::vector<Aabb2d<float>> aabbs;
+    for (const BoundingBox2d<float> & box : boxes)
+        aabbs.push_back(Aabb2d<float>(box));
+    const Aabb2dArray<float> arr(aabbs.data(), aabbs.size());
+
+    std::vector<BoundingBox2d<float>> queries;
+    for (int q = 0; q < 256; ++q)
+        queries.push_back(BoundingBox2d<float>(coord(rng), coord(rng), 50.0f, 50.0f));
+
+    // Each measurement tests one query box against every box, writing a flag per box.
+    std::unique_ptr<bool[]> output(new bool[count]);
+    std::size_t q = 0;
+
+    const double boundingBox = bench::time([&] {
+        const BoundingBox2d<float> & query = queries[q++ & 255];
+        for (std::size_t i = 0; i < count; ++i)
+            output[i] = boxes[i].intersects(query);
+        bench::doNotOptimise(output);
+    });
+    bench::report("BoundingBox2d::intersects" + suffix, boundingBox);
+
+    const double aabb = bench::time([&] {
+        const Aabb2d<float> query(queries[q++ & 255]);
+        for (std::size_t i = 0; i < count; ++i)
+            output[i] = aabbs[i].intersects(query);
+        bench::doNotOptimise(output);
+    });
+    bench::report("Aabb2d::intersects" + suffix, aabb, boundingBox);
+
+    const SimdLevel original = getSimdLevel();
+    for (int level = 0; level <= static_cast<int>(getSupportedSimdLevel()); ++level) {
+        setSimdLevel(static_cast<SimdLevel>(level));
+        const double batch = bench::time([&] {
+            arr.intersects(Aabb2d<float>(queries[q++ & 255]), output.get());
+            bench::doNotOptimise(output);
+        });
+        bench::report("Aabb2dArray::intersects, SIMD level " + std::to_string(level) + suffix, batch, boundingBox);
+    }
+    setSimdLevel(original);
+
+    // Merging boxes is a common operation when building trees.
+    const double merge = bench::time([&] {
+        Aabb2d<float> total(aabbs[0]);
+        for (std::size_t i = 1; i < count; ++i)
+            total.expand(aabbs[i]);
+        bench::doNotOptimise(total);
+    });
+    bench::report("Aabb2d::expand over all boxes" + suffix, merge);
+}
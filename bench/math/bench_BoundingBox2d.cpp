@@ -0,0 +1,88 @@
+/** \file bench_BoundingBox2d.cpp
+    \brief Benchmarks for every public operation of the BoundingBox2d class.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Number of items processed per call. This is small enough to stay in the L1 cache.
+const std::size_t itemCount = 1024;
+
+// Make a set of boxes which overlap each other fairly often.
+template <typename T_ty>
+std::vector<BoundingBox2d<T_ty>> makeBoxes(const unsigned seed)
+{
+    const std::vector<T_ty> pos = bench::makeRandomValues<T_ty>(itemCount * 2, T_ty(-100), T_ty(100), seed);
+    const std::vector<T_ty> radius = bench::makeRandomValues<T_ty>(itemCount * 2, T_ty(1), T_ty(50), seed + 1);
+    std::vector<BoundingBox2d<T_ty>> boxes;
+    for (std::size_t i = 0; i < itemCount; ++i)
+        boxes.push_back(BoundingBox2d<T_ty>(pos[i * 2], pos[(i * 2) + 1], radius[i * 2], radius[(i * 2) + 1]));
+    return boxes;
+}
+
+} // namespace
+
+AIL_BENCHMARK_TEMPLATE("math::BoundingBox2d")
+{
+    const std::vector<BoundingBox2d<T_ty>> a = makeBoxes<T_ty>(1);
+    const std::vector<BoundingBox2d<T_ty>> b = makeBoxes<T_ty>(3);
+    const std::vector<T_ty> values = bench::makeRandomValues<T_ty>(itemCount * 2, T_ty(-150), T_ty(150), 5);
+    std::vector<Vector2d<T_ty>> points;
+    for (std::size_t i = 0; i < itemCount; ++i)
+        points.push_back(Vector2d<T_ty>(values[i * 2], values[(i * 2) + 1]));
+    const std::size_t n = itemCount;
+
+    // Construction / destruction.
+    bench::report("construct default", bench::timeEach(n, [&](std::size_t) { return BoundingBox2d<T_ty>(); }));
+    bench::report("construct from vectors", bench::timeEach(n, [&](std::size_t i) { return BoundingBox2d<T_ty>(points[i], b[i].radius); }));
+    bench::report("construct from initializer list", bench::timeEach(n, [&](std::size_t i) { return BoundingBox2d<T_ty> { points[i], b[i].radius }; }));
+    bench::report("construct from components", bench::timeEach(n, [&](std::size_t i) { return BoundingBox2d<T_ty>(points[i].x, points[i].y, b[i].radius.x, b[i].radius.y); }));
+    bench::report("copy construct", bench::timeEach(n, [&](std::size_t i) { return BoundingBox2d<T_ty>(a[i]); }));
+
+    // Operators.
+    bench::report("operator =", bench::timeEach(n, [&](std::size_t i) { BoundingBox2d<T_ty> box; box = a[i]; return box; }));
+    bench::report("operator ==", bench::timeEach(n, [&](std::size_t i) { return a[i] == b[i]; }));
+    bench::report("operator !=", bench::timeEach(n, [&](std::size_t i) { return a[i] != b[i]; }));
+
+    // Accessors / operations.
+    bench::report("set (vectors)", bench::timeEach(n, [&](std::size_t i) { BoundingBox2d<T_ty> box; box.set(points[i], b[i].radius); return box; }));
+    bench::report("set (components)", bench::timeEach(n, [&](std::size_t i) { BoundingBox2d<T_ty> box; box.set(points[i].x, points[i].y, b[i].radius.x, b[i].radius.y); return box; }));
+    bench::report("getCornerX1Y1", bench::timeEach(n, [&](std::size_t i) { return a[i].getCornerX1Y1(); }));
+    bench::report("getCornerX2Y2", bench::timeEach(n, [&](std::size_t i) { return a[i].getCornerX2Y2(); }));
+    bench::report("getCornerX1Y2", bench::timeEach(n, [&](std::size_t i) { return a[i].getCornerX1Y2(); }));
+    bench::report("getCornerX2Y1", bench::timeEach(n, [&](std::size_t i) { return a[i].getCornerX2Y1(); }));
+
+    // Tests.
+    bench::report("contains", bench::timeEach(n, [&](std::size_t i) { return a[i].contains(points[i]); }));
+    bench::report("intersects", bench::timeEach(n, [&](std::size_t i) { return a[i].intersects(b[i]); }));
+
+    // Construction from a set of points. Times are per point, and the ratios
+    //  are relative to a hand-written min/max loop followed by fromCorners().
+    std::vector<T_ty> xs, ys;
+    for (const Vector2d<T_ty> & p : points) {
+        xs.push_back(p.x);
+        ys.push_back(p.y);
+    }
+    const double loopTime = bench::time([&] {
+        Vector2d<T_ty> minCorner = points[0], maxCorner = points[0];
+        for (std::size_t i = 1; i < n; ++i) {
+            minCorner.x = (points[i].x < minCorner.x) ? points[i].x : minCorner.x;
+            minCorner.y = (points[i].y < minCorner.y) ? points[i].y : minCorner.y;
+            maxCorner.x = (points[i].x > maxCorner.x) ? points[i].x : maxCorner.x;
+            maxCorner.y = (points[i].y > maxCorner.y) ? points[i].y : maxCorner.y;
+        }
+        bench::doNotOptimise(BoundingBox2d<T_ty>::fromCorners(minCorner, maxCorner));
+    }) / static_cast<double>(n);
+    bench::report("fromCorners after a serial loop (per point)", loopTime);
+    bench::report("fromPoints (per point)", bench::time([&] { bench::doNotOptimise(BoundingBox2d<T_ty>::fromPoints(points.data(), n)); }) / static_cast<double>(n), loopTime);
+    bench::report("fromPoints, separate lanes (per point)", bench::time([&] { bench::doNotOptimise(BoundingBox2d<T_ty>::fromPoints(xs.data(), ys.data(), n)); }) / static_cast<double>(n), loopTime);
+}
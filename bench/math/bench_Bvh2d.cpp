@@ -0,0 +1,110 @@
+/** \file bench_Bvh2d.cpp
+    \brief Benchmarks for the Bvh2d bounding volume hierarchy, compared to brute force.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <random>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Generate boxes resembling level geometry: lots of small pieces spread over a large area.
+std::vector<BoundingBox2d<float>> makeBoxes(std::mt19937 & rng, const std::size_t count)
+{
+    std::uniform_real_distribution<float> coord(0.0f, 2000.0f);
+    std::uniform_real_distribution<float> size(0.5f, 8.0f);
+    std::vector<BoundingBox2d<float>> boxes;
+    for (std::size_t i = 0; i < count; ++i)
+        boxes.push_back(BoundingBox2d<float>(coord(rng), coord(rng), size(rng), size(rng)));
+    return boxes;
+}
+
+} // namespace
+
+AIL_BENCHMARK("math::Bvh2d")
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coord(0.0f, 2000.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+    for (const std::size_t count : { std::size_t(1000), std::size_t(10000), std::size_t(50000) }) {
+        std::vector<BoundingBox2d<float>> boxes = makeBoxes(rng, count);
+        const std::string suffix = " (" + std::to_string(count) + " boxes)";
+
+        // Query with lots of different small boxes, rays and points.
+        std::vector<BoundingBox2d<float>> queries;
+        std::vector<Vector2d<float>> directions;
+        for (int q = 0; q < 256; ++q) {
+            queries.push_back(BoundingBox2d<float>(coord(rng), coord(rng), 10.0f, 10.0f));
+            const float a = angle(rng);
+            directions.push_back(Vector2d<float>(std::cos(a), std::sin(a)));
+        }
+
+        Bvh2d<float> bvh;
+        const double build = bench::time([&] { bvh.build(boxes.data(), boxes.size()); });
+        bench::report("build" + suffix, build);
+        const double refit = bench::time([&] { bvh.refit(boxes.data(), boxes.size()); });
+        bench::report("refit" + suffix, refit, build);
+
+        std::vector<std::size_t> output;
+        std::size_t q = 0;
+        const double bruteBox = bench::time([&] {
+            const BoundingBox2d<float> & query = queries[q++ & 255];
+            output.clear();
+            for (std::size_t i = 0; i < boxes.size(); ++i) {
+                if (boxes[i].intersects(query))
+                    output.push_back(i);
+            }
+            bench::doNotOptimise(output);
+        });
+        bench::report("brute force intersects" + suffix, bruteBox);
+
+        const double bvhBox = bench::time([&] {
+            output.clear();
+            bvh.queryBox(queries[q++ & 255], output);
+            bench::doNotOptimise(output);
+        });
+        bench::report("queryBox" + suffix, bvhBox, bruteBox);
+
+        const double brutePoint = bench::time([&] {
+            const Vector2d<float> & point = queries[q++ & 255].pos;
+            output.clear();
+            for (std::size_t i = 0; i < boxes.size(); ++i) {
+                if (boxes[i].contains(point))
+                    output.push_back(i);
+            }
+            bench::doNotOptimise(output);
+        });
+        bench::report("brute force contains" + suffix, brutePoint);
+
+        const double bvhPoint = bench::time([&] {
+            output.clear();
+            bvh.queryPoint(queries[q++ & 255].pos, output);
+            bench::doNotOptimise(output);
+        });
+        bench::report("queryPoint" + suffix, bvhPoint, brutePoint);
+
+        const double bvhRay = bench::time([&] {
+            output.clear();
+            bvh.queryRay(queries[q & 255].pos, directions[q & 255], 200.0f, output);
+            ++q;
+            bench::doNotOptimise(output);
+        });
+        bench::report("queryRay (length 200)" + suffix, bvhRay);
+
+        const double bvhRaycast = bench::time([&] {
+            float t = 0.0f;
+            const std::size_t hit = bvh.raycast(queries[q & 255].pos, directions[q & 255], 1e30f, t);
+            ++q;
+            bench::doNotOptimise(hit);
+        });
+        bench::report("raycast (unlimited)" + suffix, bvhRaycast);
+    }
+}
@@ -0,0 +1,74 @@
+/** \file bench_Contact2d.cpp
+    \brief Benchmarks for the narrow phase tests between circles, capsules and oriented boxes.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace ail::math;
+
+namespace
+{
+    // Test every shape in one list against the next shape in the other.
+    template <typename T_ty, typename T_first, typename T_second>
+    void runPairs(const std::string & name, const std::vector<T_first> & first, const std::vector<T_second> & second,
+        const std::string & suffix)
+    {
+        const std::size_t count = first.size();
+        std::unique_ptr<bool[]> hit(new bool[count]);
+        std::unique_ptr<Contact2d<T_ty>[]> contacts(new Contact2d<T_ty>[count]);
+
+        const double overlap = bench::time([&] {
+            for (std::size_t i = 0; i < count; ++i)
+                hit[i] = first[i].intersects(second[(i + 1) % count]);
+            bench::doNotOptimise(hit);
+        });
+        bench::report(name + "::intersects" + suffix, overlap);
+
+        const double contact = bench::time([&] {
+            for (std::size_t i = 0; i < count; ++i)
+                hit[i] = first[i].getContact(second[(i + 1) % count], contacts[i]);
+            bench::doNotOptimise(hit);
+            bench::doNotOptimise(contacts);
+        });
+        bench::report(name + "::getContact" + suffix, contact, overlap);
+    }
+}
+
+AIL_BENCHMARK_TEMPLATE_FP("math::Contact2d")
+{
+    // The shapes are packed closely enough that roughly half of the pairs intersect.
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T_ty> coord(T_ty(0), T_ty(8));
+    std::uniform_real_distribution<T_ty> size(T_ty(0.25), T_ty(2));
+    std::uniform_real_distribution<T_ty> angle(T_ty(-3.14159), T_ty(3.14159));
+
+    const std::size_t count = 4096;
+
+    std::vector<Circle2d<T_ty>> circles;
+    std::vector<Capsule2d<T_ty>> capsules;
+    std::vector<OrientedBox2d<T_ty>> boxes;
+    for (std::size_t i = 0; i < count; ++i) {
+        circles.push_back(Circle2d<T_ty>(Vector2d<T_ty>(coord(rng), coord(rng)), size(rng)));
+        const Vector2d<T_ty> start(coord(rng), coord(rng));
+        const T_ty a = angle(rng), length = size(rng) * T_ty(2);
+        capsules.push_back(Capsule2d<T_ty>(start, start + Vector2d<T_ty>(std::cos(a) * length, std::sin(a) * length), size(rng) / T_ty(2)));
+        boxes.push_back(OrientedBox2d<T_ty>::fromAngle(Vector2d<T_ty>(coord(rng), coord(rng)), Vector2d<T_ty>(size(rng), size(rng)), angle(rng)));
+    }
+
+    const std::string suffix = " (" + std::to_string(count) + " pairs)";
+    runPairs<T_ty>("Circle2d vs Circle2d", circles, circles, suffix);
+    runPairs<T_ty>("Circle2d vs Capsule2d", circles, capsules, suffix);
+    runPairs<T_ty>("Circle2d vs OrientedBox2d", circles, boxes, suffix);
+    runPairs<T_ty>("Capsule2d vs Capsule2d", capsules, capsules, suffix);
+    runPairs<T_ty>("Capsule2d vs OrientedBox2d", capsules, boxes, suffix);
+    runPairs<T_ty>("OrientedBox2d vs OrientedBox2d", boxes, boxes, suffix);
+}
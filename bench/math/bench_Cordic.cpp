@@ -0,0 +1,66 @@
+/** \file bench_Cordic.cpp
+    \brief Benchmarks for the CORDIC trig functions, compared to the standard library.
+
+    The ratios for the conversions are relative to the default policy (TrigExact).
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Number of items processed per call. This is small enough to stay in the L1 cache.
+const std::size_t itemCount = 1024;
+
+// Time one number of iterations against the standard library timings.
+template <int T_iterations, typename T_ty>
+void benchIterations(
+    const std::vector<T_ty> & angles, const std::vector<T_ty> & xs, const std::vector<T_ty> & ys,
+    const double sinCosTime, const double atan2Time, const double hypotTime,
+    const double toVectorTime, const double toPolarTime)
+{
+    typedef TrigCordic<T_iterations> Policy;
+    const std::size_t n = itemCount;
+    const std::string suffix = " (" + std::to_string(T_iterations) + " iterations)";
+
+    bench::report("cordicSinCos" + suffix, bench::timeEach(n, [&](std::size_t i) { T_ty s, c; cordicSinCos<T_iterations>(angles[i], s, c); return s + c; }), sinCosTime);
+    bench::report("cordicAtan2" + suffix, bench::timeEach(n, [&](std::size_t i) { return cordicAtan2<T_iterations>(ys[i], xs[i]); }), atan2Time);
+    bench::report("cordicHypot" + suffix, bench::timeEach(n, [&](std::size_t i) { return cordicHypot<T_iterations>(xs[i], ys[i]); }), hypotTime);
+    bench::report("Polar toVector2d" + suffix, bench::timeEach(n, [&](std::size_t i) { return Polar<T_ty>(angles[i], xs[i]).template toVector2d<Policy>(); }), toVectorTime);
+    bench::report("Vector2d toPolar" + suffix, bench::timeEach(n, [&](std::size_t i) { return Vector2d<T_ty>(xs[i], ys[i]).template toPolar<Policy>(); }), toPolarTime);
+}
+
+} // namespace
+
+AIL_BENCHMARK_TEMPLATE_FP("math::Cordic")
+{
+    const std::vector<T_ty> angles = bench::makeRandomValues<T_ty>(itemCount, T_ty(-20), T_ty(20), 1);
+    const std::vector<T_ty> xs = bench::makeRandomValues<T_ty>(itemCount, T_ty(-1000), T_ty(1000), 2);
+    const std::vector<T_ty> ys = bench::makeRandomValues<T_ty>(itemCount, T_ty(-1000), T_ty(1000), 3);
+    const std::size_t n = itemCount;
+
+    // Standard library, and the default (exact) conversions.
+    const double sinCosTime = bench::timeEach(n, [&](std::size_t i) { return std::sin(angles[i]) + std::cos(angles[i]); });
+    bench::report("std::sin and std::cos", sinCosTime);
+    const double atan2Time = bench::timeEach(n, [&](std::size_t i) { return std::atan2(ys[i], xs[i]); });
+    bench::report("std::atan2", atan2Time);
+    const double hypotTime = bench::timeEach(n, [&](std::size_t i) { return std::hypot(xs[i], ys[i]); });
+    bench::report("std::hypot", hypotTime);
+    const double toVectorTime = bench::timeEach(n, [&](std::size_t i) { return Polar<T_ty>(angles[i], xs[i]).toVector2d(); });
+    bench::report("Polar toVector2d (exact)", toVectorTime);
+    const double toPolarTime = bench::timeEach(n, [&](std::size_t i) { return Vector2d<T_ty>(xs[i], ys[i]).toPolar(); });
+    bench::report("Vector2d toPolar (exact)", toPolarTime);
+
+    benchIterations<16>(angles, xs, ys, sinCosTime, atan2Time, hypotTime, toVectorTime, toPolarTime);
+    benchIterations<24>(angles, xs, ys, sinCosTime, atan2Time, hypotTime, toVectorTime, toPolarTime);
+    benchIterations<30>(angles, xs, ys, sinCosTime, atan2Time, hypotTime, toVectorTime, toPolarTime);
+}
@@ -0,0 +1,79 @@
+/** \file bench_Fixed.cpp
+    \brief Benchmarks for the fixed point number type, compared to float.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+typedef Fixed<16, 16> Fx;
+
+// Number of items processed per call. This is small enough to stay in the L1 cache.
+const std::size_t itemCount = 1024;
+
+// Convert floating point benchmark inputs to fixed point.
+std::vector<Fx> toFixed(const std::vector<float> & values)
+{
+    std::vector<Fx> result;
+    for (const float value : values)
+        result.push_back(Fx(value));
+    return result;
+}
+
+} // namespace
+
+AIL_BENCHMARK("math::Fixed<16, 16>")
+{
+    // Components are kept small enough that the squared length doesn't overflow.
+    const std::vector<float> xs = bench::makeRandomValues(itemCount, -100.0f, 100.0f, 1);
+    const std::vector<float> ys = bench::makeRandomValues(itemCount, -100.0f, 100.0f, 2);
+    const std::vector<float> angles = bench::makeRandomValues(itemCount, -20.0f, 20.0f, 3);
+    const std::vector<float> positives = bench::makeRandomValues(itemCount, 0.0f, 10000.0f, 4);
+    const std::vector<Fx> fixedXs = toFixed(xs);
+    const std::vector<Fx> fixedYs = toFixed(ys);
+    const std::vector<Fx> fixedAngles = toFixed(angles);
+    const std::vector<Fx> fixedPositives = toFixed(positives);
+    const std::size_t n = itemCount;
+
+    // Basic arithmetic.
+    const double mulTime = bench::timeEach(n, [&](std::size_t i) { return xs[i] * ys[i]; });
+    bench::report("operator * (float)", mulTime);
+    bench::report("operator *", bench::timeEach(n, [&](std::size_t i) { return fixedXs[i] * fixedYs[i]; }), mulTime);
+    const double divTime = bench::timeEach(n, [&](std::size_t i) { return xs[i] / positives[i]; });
+    bench::report("operator / (float)", divTime);
+    bench::report("operator /", bench::timeEach(n, [&](std::size_t i) { return fixedXs[i] / fixedPositives[i]; }), divTime);
+
+    // Maths functions.
+    const double sqrtTime = bench::timeEach(n, [&](std::size_t i) { return std::sqrt(positives[i]); });
+    bench::report("sqrt (float)", sqrtTime);
+    bench::report("sqrt", bench::timeEach(n, [&](std::size_t i) { return sqrt(fixedPositives[i]); }), sqrtTime);
+    const double sinTime = bench::timeEach(n, [&](std::size_t i) { return std::sin(angles[i]); });
+    bench::report("sin (float)", sinTime);
+    bench::report("sin", bench::timeEach(n, [&](std::size_t i) { return sin(fixedAngles[i]); }), sinTime);
+    const double atan2Time = bench::timeEach(n, [&](std::size_t i) { return std::atan2(ys[i], xs[i]); });
+    bench::report("atan2 (float)", atan2Time);
+    bench::report("atan2", bench::timeEach(n, [&](std::size_t i) { return atan2(fixedYs[i], fixedXs[i]); }), atan2Time);
+
+    // Use in Vector2d and Polar.
+    const double lengthTime = bench::timeEach(n, [&](std::size_t i) { return Vector2d<float>(xs[i], ys[i]).getLength(); });
+    bench::report("Vector2d getLength (float)", lengthTime);
+    bench::report("Vector2d getLength", bench::timeEach(n, [&](std::size_t i) { return Vector2d<Fx>(fixedXs[i], fixedYs[i]).getLength(); }), lengthTime);
+    const double toPolarTime = bench::timeEach(n, [&](std::size_t i) { return Vector2d<float>(xs[i], ys[i]).toPolar(); });
+    bench::report("Vector2d toPolar (float)", toPolarTime);
+    bench::report("Vector2d toPolar", bench::timeEach(n, [&](std::size_t i) { return Vector2d<Fx>(fixedXs[i], fixedYs[i]).toPolar(); }), toPolarTime);
+    const double toVectorTime = bench::timeEach(n, [&](std::size_t i) { return Polar<float>(angles[i], xs[i]).toVector2d(); });
+    bench::report("Polar toVector2d (float)", toVectorTime);
+    bench::report("Polar toVector2d", bench::timeEach(n, [&](std::size_t i) { return Polar<Fx>(fixedAngles[i], fixedXs[i]).toVector2d(); }), toVectorTime);
+    const double simplifyTime = bench::timeEach(n, [&](std::size_t i) { return Polar<float>(angles[i], xs[i]).getSimplified(); });
+    bench::report("Polar getSimplified (float)", simplifyTime);
+    bench::report("Polar getSimplified", bench::timeEach(n, [&](std::size_t i) { return Polar<Fx>(fixedAngles[i], fixedXs[i]).getSimplified(); }), simplifyTime);
+}
@@ -0,0 +1,76 @@
+/** \file bench_ParallelBatch.cpp
+    \brief Benchmarks for the parallel batch operations, scaling from one thread up to every hardware thread.
+
+    Times are per point. The ratios are relative to the same operation on a
+     pool with one thread, which runs the plain serial loop.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Number of points in each batch. This is far too big for the caches, like a large point cloud.
+const std::size_t pointCount = 1 << 20;
+
+// Get the thread counts to measure: powers of 2, and the number of hardware threads.
+std::vector<unsigned> getThreadCounts()
+{
+    const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < hardwareThreads; threads *= 2)
+        counts.push_back(threads);
+    counts.push_back(hardwareThreads);
+    return counts;
+}
+
+} // namespace
+
+AIL_BENCHMARK_TEMPLATE_FP("math::ParallelBatch")
+{
+    const std::vector<T_ty> xs = bench::makeRandomValues<T_ty>(pointCount, T_ty(-1000), T_ty(1000), 1);
+    const std::vector<T_ty> ys = bench::makeRandomValues<T_ty>(pointCount, T_ty(-1000), T_ty(1000), 2);
+    std::vector<Vector2d<T_ty>> points;
+    for (std::size_t i = 0; i < pointCount; ++i)
+        points.push_back(Vector2d<T_ty>(xs[i], ys[i]));
+    const Vector2d<T_ty> target(T_ty(12), T_ty(-34));
+    const double n = static_cast<double>(pointCount);
+
+    // Normalising works in place, so it runs on unit vectors after the first
+    //  call. That doesn't change the amount of work.
+    std::vector<Vector2d<T_ty>> vectors(points);
+    std::vector<Polar<T_ty>> polars(pointCount);
+
+    double normaliseTime = 0.0, toPolarTime = 0.0, boxTime = 0.0, nearestTime = 0.0;
+    for (const unsigned threads : getThreadCounts()) {
+        ThreadPool pool(threads);
+        const std::string suffix = " (" + std::to_string(threads) + (threads == 1 ? " thread)" : " threads)");
+
+        const double normalise = bench::time([&] { parallelNormalise(vectors.data(), pointCount, pool); bench::doNotOptimise(vectors); }) / n;
+        const double toPolar = bench::time([&] { parallelToPolar(points.data(), polars.data(), pointCount, pool); bench::doNotOptimise(polars); }) / n;
+        const double box = bench::time([&] { bench::doNotOptimise(parallelBoundingBox(points.data(), pointCount, pool)); }) / n;
+        const double nearest = bench::time([&] { bench::doNotOptimise(parallelFindNearest(points.data(), pointCount, target, pool)); }) / n;
+
+        if (threads == 1) {
+            normaliseTime = normalise;
+            toPolarTime = toPolar;
+            boxTime = box;
+            nearestTime = nearest;
+        }
+
+        bench::report("parallelNormalise" + suffix, normalise, normaliseTime);
+        bench::report("parallelToPolar" + suffix, toPolar, toPolarTime);
+        bench::report("parallelBoundingBox" + suffix, box, boxTime);
+        bench::report("parallelFindNearest" + suffix, nearest, nearestTime);
+    }
+}
@@ -0,0 +1,71 @@
+/** \file bench_Polar.cpp
+    \brief Benchmarks for every public operation of the Polar class.
+
+    Polar uses radians, so only floating point types are measured.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Number of items processed per call. This is small enough to stay in the L1 cache.
+const std::size_t itemCount = 1024;
+
+// Make a set of polar coordinates, including angles outside [0, 2pi) and negative magnitudes.
+template <typename T_ty>
+std::vector<Polar<T_ty>> makePolars(const unsigned seed)
+{
+    const std::vector<T_ty> angles = bench::makeRandomValues<T_ty>(itemCount, T_ty(-20), T_ty(20), seed);
+    const std::vector<T_ty> mags = bench::makeRandomValues<T_ty>(itemCount, T_ty(-1000), T_ty(1000), seed + 1);
+    std::vector<Polar<T_ty>> polars;
+    for (std::size_t i = 0; i < itemCount; ++i)
+        polars.push_back(Polar<T_ty>(angles[i], mags[i]));
+    return polars;
+}
+
+} // namespace
+
+AIL_BENCHMARK_TEMPLATE_FP("math::Polar")
+{
+    const std::vector<Polar<T_ty>> a = makePolars<T_ty>(1);
+    const std::vector<Polar<T_ty>> b = makePolars<T_ty>(3);
+    const std::vector<T_ty> margins = bench::makeRandomValues<T_ty>(itemCount, T_ty(-2), T_ty(2), 5);
+    const std::vector<T_ty> dists = bench::makeRandomValues<T_ty>(itemCount, T_ty(-1500), T_ty(1500), 6);
+    std::vector<Vector2d<T_ty>> vectors;
+    for (const Polar<T_ty> & p : a)
+        vectors.push_back(p.toVector2d());
+    const std::size_t n = itemCount;
+
+    // Construction / destruction.
+    bench::report("construct default", bench::timeEach(n, [&](std::size_t) { return Polar<T_ty>(); }));
+    bench::report("construct from angle and magnitude", bench::timeEach(n, [&](std::size_t i) { return Polar<T_ty>(margins[i], dists[i]); }));
+    bench::report("construct from initializer list", bench::timeEach(n, [&](std::size_t i) { return Polar<T_ty> { margins[i], dists[i] }; }));
+    bench::report("copy construct", bench::timeEach(n, [&](std::size_t i) { return Polar<T_ty>(a[i]); }));
+    bench::report("construct from Vector2d", bench::timeEach(n, [&](std::size_t i) { return Polar<T_ty>(vectors[i]); }));
+
+    // Operators.
+    bench::report("operator =", bench::timeEach(n, [&](std::size_t i) { Polar<T_ty> p; p = a[i]; return p; }));
+    bench::report("operator ==", bench::timeEach(n, [&](std::size_t i) { return a[i] == b[i]; }));
+    bench::report("operator !=", bench::timeEach(n, [&](std::size_t i) { return a[i] != b[i]; }));
+    bench::report("operator - (unary)", bench::timeEach(n, [&](std::size_t i) { return -a[i]; }));
+
+    // Accessors / operations.
+    bench::report("set", bench::timeEach(n, [&](std::size_t i) { Polar<T_ty> p; p.set(margins[i], dists[i]); return p; }));
+    bench::report("simplify", bench::timeEach(n, [&](std::size_t i) { Polar<T_ty> p(a[i]); p.simplify(); return p; }));
+    bench::report("getSimplified", bench::timeEach(n, [&](std::size_t i) { return a[i].getSimplified(); }));
+    bench::report("isNear", bench::timeEach(n, [&](std::size_t i) { return a[i].isNear(b[i], dists[i]); }));
+    bench::report("isApproxEqual (one margin)", bench::timeEach(n, [&](std::size_t i) { return a[i].isApproxEqual(b[i], margins[i]); }));
+    bench::report("isApproxEqual (two margins)", bench::timeEach(n, [&](std::size_t i) { return a[i].isApproxEqual(b[i], margins[i], dists[i]); }));
+
+    // Conversions.
+    bench::report("toVector2d (output parameter)", bench::timeEach(n, [&](std::size_t i) { Vector2d<T_ty> v; a[i].toVector2d(v); return v; }));
+    bench::report("toVector2d", bench::timeEach(n, [&](std::size_t i) { return a[i].toVector2d(); }));
+}
@@ -0,0 +1,74 @@
+/** \file bench_PolarBatch.cpp
+    \brief Benchmarks for the batch cartesian/polar conversions at each SIMD level, compared to scalar loops.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Number of items processed per call. This is small enough to stay in the L1 cache.
+const std::size_t itemCount = 4096;
+
+} // namespace
+
+AIL_BENCHMARK_TEMPLATE_FP("math::PolarBatch")
+{
+    // Times are per element.
+    const std::vector<T_ty> x = bench::makeRandomValues<T_ty>(itemCount, T_ty(-1000), T_ty(1000), 1);
+    const std::vector<T_ty> y = bench::makeRandomValues<T_ty>(itemCount, T_ty(-1000), T_ty(1000), 2);
+    std::vector<Vector2d<T_ty>> vectors;
+    for (std::size_t i = 0; i < itemCount; ++i)
+        vectors.push_back(Vector2d<T_ty>(x[i], y[i]));
+    std::vector<T_ty> angles(itemCount), mags(itemCount);
+    std::vector<Polar<T_ty>> polars(itemCount);
+    const double n = static_cast<double>(itemCount);
+
+    const double loop = bench::time([&] {
+        for (std::size_t i = 0; i < itemCount; ++i)
+            polars[i] = vectors[i].toPolar();
+        bench::doNotOptimise(polars);
+    }) / n;
+    bench::report("Vector2d::toPolar (scalar loop)", loop);
+
+    const char * const levelNames[] = { "Scalar", "SSE2", "AVX2", "AVX-512" };
+    const SimdLevel original = getSimdLevel();
+    for (int level = 0; level <= static_cast<int>(getSupportedSimdLevel()); ++level) {
+        setSimdLevel(static_cast<SimdLevel>(level));
+        const double lanes = bench::time([&] {
+            toPolarBatch(x.data(), y.data(), angles.data(), mags.data(), itemCount);
+            bench::doNotOptimise(angles);
+            bench::doNotOptimise(mags);
+        }) / n;
+        bench::report(std::string("toPolarBatch (lanes, ") + levelNames[level] + ")", lanes, loop);
+
+        const double structs = bench::time([&] {
+            toPolarBatch(vectors.data(), polars.data(), itemCount);
+            bench::doNotOptimise(polars);
+        }) / n;
+        bench::report(std::string("toPolarBatch (structures, ") + levelNames[level] + ")", structs, loop);
+    }
+    setSimdLevel(original);
+
+    const double cartesianLoop = bench::time([&] {
+        for (std::size_t i = 0; i < itemCount; ++i)
+            vectors[i] = polars[i].toVector2d();
+        bench::doNotOptimise(vectors);
+    }) / n;
+    bench::report("Polar::toVector2d (scalar loop)", cartesianLoop);
+
+    std::vector<T_ty> outX(itemCount), outY(itemCount);
+    const double cartesian = bench::time([&] {
+        toCartesianBatch(angles.data(), mags.data(), outX.data(), outY.data(), itemCount);
+        bench::doNotOptimise(outX);
+        bench::doNotOptimise(outY);
+    }) / n;
+    bench::report("toCartesianBatch (lanes)", cartesian, cartesianLoop);
+}
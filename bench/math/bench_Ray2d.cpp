@@ -0,0 +1,116 @@
+/** \file bench_Ray2d.cpp
+    \brief Benchmarks for casting Ray2d and Segment2d against boxes, one at a time and in batches.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace ail::math;
+
+AIL_BENCHMARK_TEMPLATE_FP("math::Ray2d")
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T_ty> coord(T_ty(0), T_ty(1000));
+    std::uniform_real_distribution<T_ty> size(T_ty(0.5), T_ty(8));
+    std::uniform_real_distribution<T_ty> direction(T_ty(-1), T_ty(1));
+
+    const std::size_t count = 10000;
+    const std::string suffix = " (" + std::to_string(count) + " casts)";
+
+    std::vector<BoundingBox2d<T_ty>> boxes;
+    std::vector<Aabb2d<T_ty>> aabbs;
+    for (std::size_t i = 0; i < count; ++i) {
+        boxes.push_back(BoundingBox2d<T_ty>(coord(rng), coord(rng), size(rng), size(rng)));
+        aabbs.push_back(Aabb2d<T_ty>(boxes.back()));
+    }
+    const Aabb2dArray<T_ty> arr(aabbs.data(), aabbs.size());
+
+    std::vector<Segment2d<T_ty>> segments;
+    for (int r = 0; r < 256; ++r)
+        segments.push_back(Segment2d<T_ty>(Vector2d<T_ty>(coord(rng), coord(rng)), Vector2d<T_ty>(coord(rng), coord(rng))));
+
+    std::unique_ptr<T_ty[]> entry(new T_ty[count]), exit(new T_ty[count]);
+    std::unique_ptr<bool[]> hit(new bool[count]);
+    std::size_t r = 0;
+    const SimdLevel original = getSimdLevel();
+
+    // One ray against every box.
+    const double single = bench::time([&] {
+        const Ray2d<T_ty> ray = segments[r++ & 255].toRay();
+        for (std::size_t i = 0; i < count; ++i)
+            hit[i] = ray.intersects(boxes[i], entry[i], exit[i]);
+        bench::doNotOptimise(hit);
+        bench::doNotOptimise(entry);
+    });
+    bench::report("Ray2d::intersects, one ray against each box" + suffix, single);
+
+    for (int level = 0; level <= static_cast<int>(getSupportedSimdLevel()); ++level) {
+        setSimdLevel(static_cast<SimdLevel>(level));
+        const double batch = bench::time([&] {
+            arr.castRay(segments[r++ & 255].toRay(), entry.get(), exit.get(), hit.get());
+            bench::doNotOptimise(hit);
+            bench::doNotOptimise(entry);
+        });
+        bench::report("Aabb2dArray::castRay, SIMD level " + std::to_string(level) + suffix, batch, single);
+    }
+    setSimdLevel(original);
+
+    // One segment against every box.
+    const double singleSegment = bench::time([&] {
+        const Segment2d<T_ty> & segment = segments[r++ & 255];
+        for (std::size_t i = 0; i < count; ++i)
+            hit[i] = segment.intersects(boxes[i], entry[i], exit[i]);
+        bench::doNotOptimise(hit);
+        bench::doNotOptimise(entry);
+    });
+    bench::report("Segment2d::intersects, one segment against each box" + suffix, singleSegment);
+
+    const double batchSegment = bench::time([&] {
+        arr.castSegment(segments[r++ & 255], entry.get(), exit.get(), hit.get());
+        bench::doNotOptimise(hit);
+        bench::doNotOptimise(entry);
+    });
+    bench::report("Aabb2dArray::castSegment" + suffix, batchSegment, singleSegment);
+
+    // Many rays against one box, with the rays held as separate lanes.
+    Vector2dArray<T_ty> origins(count), directions(count);
+    std::vector<Ray2d<T_ty>> rays;
+    for (std::size_t i = 0; i < count; ++i) {
+        rays.push_back(Ray2d<T_ty>(Vector2d<T_ty>(coord(rng), coord(rng)), Vector2d<T_ty>(direction(rng), direction(rng))));
+        origins.x()[i] = rays.back().origin.x;
+        origins.y()[i] = rays.back().origin.y;
+        directions.x()[i] = rays.back().direction.x;
+        directions.y()[i] = rays.back().direction.y;
+    }
+
+    const double many = bench::time([&] {
+        const BoundingBox2d<T_ty> & box = boxes[r++ & 255];
+        for (std::size_t i = 0; i < count; ++i)
+            hit[i] = rays[i].intersects(box, entry[i], exit[i]);
+        bench::doNotOptimise(hit);
+        bench::doNotOptimise(entry);
+    });
+    bench::report("Ray2d::intersects, each ray against one box" + suffix, many);
+
+    for (int level = 0; level <= static_cast<int>(getSupportedSimdLevel()); ++level) {
+        setSimdLevel(static_cast<SimdLevel>(level));
+        const double batch = bench::time([&] {
+            const Aabb2d<T_ty> & box = aabbs[r++ & 255];
+            kernels::castRays(origins.x(), origins.y(), directions.x(), directions.y(),
+                box.min.x, box.min.y, box.max.x, box.max.y, std::numeric_limits<T_ty>::max(),
+                entry.get(), exit.get(), hit.get(), count);
+            bench::doNotOptimise(hit);
+            bench::doNotOptimise(entry);
+        });
+        bench::report("kernels::castRays, SIMD level " + std::to_string(level) + suffix, batch, many);
+    }
+    setSimdLevel(original);
+}
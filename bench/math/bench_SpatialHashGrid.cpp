@@ -0,0 +1,61 @@
+/** \file bench_SpatialHashGrid.cpp
+    \brief Benchmarks for rebuilding and querying the SpatialHashGrid, compared to inserting points one at a time.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <string>
+#include <vector>
+
+using namespace ail::math;
+
+AIL_BENCHMARK_TEMPLATE_FP("math::SpatialHashGrid")
+{
+    for (const std::size_t count : { std::size_t(100000), std::size_t(1000000) }) {
+        const std::string suffix = " (" + std::to_string(count) + " points)";
+
+        // Points are spread evenly, with a few in each cell on average.
+        const T_ty extent = T_ty(std::sqrt(static_cast<double>(count)) * 2.0);
+        const std::vector<T_ty> x = bench::makeRandomValues<T_ty>(count, T_ty(0), extent, 1);
+        const std::vector<T_ty> y = bench::makeRandomValues<T_ty>(count, T_ty(0), extent, 2);
+        std::vector<Vector2d<T_ty>> positions;
+        for (std::size_t i = 0; i < count; ++i)
+            positions.push_back(Vector2d<T_ty>(x[i], y[i]));
+
+        SpatialHashGrid<T_ty> grid(T_ty(4));
+        const double insertAll = bench::time([&] {
+            grid.clear();
+            for (std::size_t i = 0; i < count; ++i)
+                grid.insert(positions[i]);
+            bench::doNotOptimise(grid);
+        });
+        bench::report("clear and insert each point" + suffix, insertAll);
+
+        const double rebuild = bench::time([&] {
+            grid.rebuild(positions.data(), count);
+            bench::doNotOptimise(grid);
+        });
+        bench::report("rebuild from vectors" + suffix, rebuild, insertAll);
+
+        const double rebuildLanes = bench::time([&] {
+            grid.rebuild(x.data(), y.data(), count);
+            bench::doNotOptimise(grid);
+        });
+        bench::report("rebuild from lanes" + suffix, rebuildLanes, insertAll);
+
+        // Time per query, just after a rebuild.
+        const std::size_t queryCount = 4096;
+        std::vector<typename SpatialHashGrid<T_ty>::Handle> found;
+        const double query = bench::time([&] {
+            found.clear();
+            for (std::size_t i = 0; i < queryCount; ++i)
+                grid.queryRadius(positions[i], T_ty(4), found);
+            bench::doNotOptimise(found);
+        }) / static_cast<double>(queryCount);
+        bench::report("queryRadius" + suffix, query);
+    }
+}
@@ -0,0 +1,71 @@
+/** \file bench_SweepAndPrune2d.cpp
+    \brief Benchmarks for the SweepAndPrune2d broadphase, compared to brute force.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <random>
+#include <vector>
+
+using namespace ail::math;
+
+AIL_BENCHMARK("math::SweepAndPrune2d")
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coord(0.0f, 3000.0f);
+    std::uniform_real_distribution<float> size(1.0f, 4.0f);
+    std::uniform_real_distribution<float> speed(-0.5f, 0.5f);
+
+    for (const std::size_t count : { std::size_t(5000), std::size_t(50000) }) {
+        const std::string suffix = " (" + std::to_string(count) + " boxes)";
+
+        std::vector<BoundingBox2d<float>> boxes;
+        std::vector<Vector2d<float>> velocities;
+        for (std::size_t i = 0; i < count; ++i) {
+            boxes.push_back(BoundingBox2d<float>(coord(rng), coord(rng), size(rng), size(rng)));
+            velocities.push_back(Vector2d<float>(speed(rng), speed(rng)));
+        }
+
+        SweepAndPrune2d<float> sap;
+        std::vector<SweepAndPrune2d<float>::Handle> handles;
+        for (const BoundingBox2d<float> & box : boxes)
+            handles.push_back(sap.insert(box));
+
+        std::vector<SweepAndPrune2d<float>::Pair> added, removed;
+        sap.update(added, removed);
+
+        // Each frame moves every box a little, then finds the overlapping pairs.
+        std::size_t frames = 0;
+        const double incremental = bench::time([&] {
+            // Reverse direction every so often, so the boxes stay in roughly the same area.
+            const float direction = ((frames++ / 64) % 2 == 0) ? 1.0f : -1.0f;
+            for (std::size_t i = 0; i < count; ++i) {
+                boxes[i].pos += velocities[i] * direction;
+                sap.setBox(handles[i], boxes[i]);
+            }
+            added.clear();
+            removed.clear();
+            sap.update(added, removed);
+            bench::doNotOptimise(added);
+        });
+
+        std::vector<std::pair<std::size_t, std::size_t>> pairs;
+        const double brute = bench::time([&] {
+            pairs.clear();
+            for (std::size_t i = 0; i < count; ++i) {
+                for (std::size_t j = i + 1; j < count; ++j) {
+                    if (boxes[i].intersects(boxes[j]))
+                        pairs.push_back(std::make_pair(i, j));
+                }
+            }
+            bench::doNotOptimise(pairs);
+        });
+
+        bench::report("brute force intersects (all pairs)" + suffix, brute);
+        bench::report("move all and update" + suffix, incremental, brute);
+    }
+}
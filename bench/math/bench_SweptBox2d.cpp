@@ -0,0 +1,76 @@
+/** \file bench_SweptBox2d.cpp
+    \brief Benchmarks for sweeping a moving box against static boxes, one at a time and in a batch.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace ail::math;
+
+AIL_BENCHMARK_TEMPLATE_FP("math::SweptBox2d")
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T_ty> coord(T_ty(0), T_ty(1000));
+    std::uniform_real_distribution<T_ty> size(T_ty(0.5), T_ty(8));
+    std::uniform_real_distribution<T_ty> velocity(T_ty(-200), T_ty(200));
+
+    const std::size_t count = 10000;
+    const std::string suffix = " (" + std::to_string(count) + " boxes)";
+
+    std::vector<BoundingBox2d<T_ty>> boxes;
+    std::vector<Aabb2d<T_ty>> aabbs;
+    for (std::size_t i = 0; i < count; ++i) {
+        boxes.push_back(BoundingBox2d<T_ty>(coord(rng), coord(rng), size(rng), size(rng)));
+        aabbs.push_back(Aabb2d<T_ty>(boxes.back()));
+    }
+    const Aabb2dArray<T_ty> arr(aabbs.data(), aabbs.size());
+
+    std::vector<SweptBox2d<T_ty>> movers;
+    for (int m = 0; m < 256; ++m) {
+        movers.push_back(SweptBox2d<T_ty>(BoundingBox2d<T_ty>(coord(rng), coord(rng), size(rng), size(rng)),
+            Vector2d<T_ty>(velocity(rng), velocity(rng))));
+    }
+
+    // Each measurement sweeps one moving box against every static box.
+    std::unique_ptr<T_ty[]> time(new T_ty[count]), normalX(new T_ty[count]), normalY(new T_ty[count]);
+    std::unique_ptr<Vector2d<T_ty>[]> normals(new Vector2d<T_ty>[count]);
+    std::unique_ptr<bool[]> hit(new bool[count]);
+    std::size_t m = 0;
+
+    const double single = bench::time([&] {
+        const SweptBox2d<T_ty> & mover = movers[m++ & 255];
+        for (std::size_t i = 0; i < count; ++i)
+            hit[i] = mover.intersects(boxes[i], time[i], normals[i]);
+        bench::doNotOptimise(hit);
+        bench::doNotOptimise(time);
+    });
+    bench::report("SweptBox2d::intersects" + suffix, single);
+
+    const SimdLevel original = getSimdLevel();
+    for (int level = 0; level <= static_cast<int>(getSupportedSimdLevel()); ++level) {
+        setSimdLevel(static_cast<SimdLevel>(level));
+        const double batch = bench::time([&] {
+            arr.sweep(movers[m++ & 255], time.get(), normalX.get(), normalY.get(), hit.get());
+            bench::doNotOptimise(hit);
+            bench::doNotOptimise(time);
+        });
+        bench::report("Aabb2dArray::sweep, SIMD level " + std::to_string(level) + suffix, batch, single);
+    }
+    setSimdLevel(original);
+
+    // The discrete test which misses tunnelling, for comparison.
+    const double discrete = bench::time([&] {
+        const BoundingBox2d<T_ty> end = movers[m++ & 255].getBoxAt(T_ty(1));
+        for (std::size_t i = 0; i < count; ++i)
+            hit[i] = boxes[i].intersects(end);
+        bench::doNotOptimise(hit);
+    });
+    bench::report("BoundingBox2d::intersects at the end of the step" + suffix, discrete, single);
+}
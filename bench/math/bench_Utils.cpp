@@ -0,0 +1,67 @@
+/** \file bench_Utils.cpp
+    \brief Benchmarks for every function in Utils.h.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Number of items processed per call. This is small enough to stay in the L1 cache.
+const std::size_t itemCount = 1024;
+
+} // namespace
+
+// Angle conversions. Most of these are only defined for floating point types.
+AIL_BENCHMARK_TEMPLATE_FP("math::Utils angles")
+{
+    const std::vector<T_ty> angles = bench::makeRandomValues<T_ty>(itemCount, T_ty(-720), T_ty(720), 1);
+    const std::size_t n = itemCount;
+
+    bench::report("degToRad", bench::timeEach(n, [&](std::size_t i) { return degToRad(angles[i]); }));
+    bench::report("degToGrad", bench::timeEach(n, [&](std::size_t i) { return degToGrad(angles[i]); }));
+    bench::report("degToTurn", bench::timeEach(n, [&](std::size_t i) { return degToTurn(angles[i]); }));
+    bench::report("radToDeg", bench::timeEach(n, [&](std::size_t i) { return radToDeg(angles[i]); }));
+    bench::report("radToGrad", bench::timeEach(n, [&](std::size_t i) { return radToGrad(angles[i]); }));
+    bench::report("radToTurn", bench::timeEach(n, [&](std::size_t i) { return radToTurn(angles[i]); }));
+    bench::report("gradToDeg", bench::timeEach(n, [&](std::size_t i) { return gradToDeg(angles[i]); }));
+    bench::report("gradToRad", bench::timeEach(n, [&](std::size_t i) { return gradToRad(angles[i]); }));
+    bench::report("gradToTurn", bench::timeEach(n, [&](std::size_t i) { return gradToTurn(angles[i]); }));
+    bench::report("turnToRad", bench::timeEach(n, [&](std::size_t i) { return turnToRad(angles[i]); }));
+    bench::report("lerp", bench::timeEach(n, [&](std::size_t i) { return lerp(angles[i] / T_ty(360), T_ty(-5), T_ty(5)); }));
+    bench::report("lerpClamp", bench::timeEach(n, [&](std::size_t i) { return lerpClamp(angles[i] / T_ty(360), T_ty(-5), T_ty(5)); }));
+
+    // The angles are treated as radians here, so almost all of them need wrapping.
+    const double wrapTime = bench::timeEach(n, [&](std::size_t i) { return wrap(angles[i], T_ty(0), T_ty(2) * pi<T_ty>()); });
+    bench::report("wrap (0 to 2 pi)", wrapTime);
+    bench::report("wrapAngle", bench::timeEach(n, [&](std::size_t i) { return wrapAngle(angles[i]); }), wrapTime);
+}
+
+// Numerical utilities and comparisons, plus the angle conversions which also work for integers.
+AIL_BENCHMARK_TEMPLATE("math::Utils")
+{
+    const std::vector<T_ty> a = bench::makeRandomValues<T_ty>(itemCount, T_ty(-1000), T_ty(1000), 2);
+    const std::vector<T_ty> b = bench::makeRandomValues<T_ty>(itemCount, T_ty(-1000), T_ty(1000), 3);
+    const std::vector<T_ty> c = bench::makeRandomValues<T_ty>(itemCount, T_ty(-1000), T_ty(1000), 4);
+    const std::size_t n = itemCount;
+
+    bench::report("turnToDeg", bench::timeEach(n, [&](std::size_t i) { return turnToDeg(a[i]); }));
+    bench::report("turnToGrad", bench::timeEach(n, [&](std::size_t i) { return turnToGrad(a[i]); }));
+    bench::report("diff", bench::timeEach(n, [&](std::size_t i) { return diff(a[i], b[i]); }));
+    bench::report("clamp", bench::timeEach(n, [&](std::size_t i) { return clamp(a[i], b[i], c[i]); }));
+
+    // About half the values need wrapping, and about half are already in range.
+    bench::report("wrap", bench::timeEach(n, [&](std::size_t i) { return wrap(a[i], T_ty(-500), T_ty(500)); }));
+    bench::report("wrap (all out of range)", bench::timeEach(n, [&](std::size_t i) { return wrap(a[i] * T_ty(10), T_ty(0), T_ty(360)); }));
+
+    bench::report("isApproxEqual", bench::timeEach(n, [&](std::size_t i) { return isApproxEqual(a[i], b[i], c[i]); }));
+    bench::report("isApproxZero", bench::timeEach(n, [&](std::size_t i) { return isApproxZero(a[i], c[i]); }));
+    bench::report("isInRange", bench::timeEach(n, [&](std::size_t i) { return isInRange(a[i], b[i], c[i]); }));
+}
@@ -0,0 +1,67 @@
+/** \file bench_UtilsBatch.cpp
+    \brief Benchmarks for the span versions of the utility functions at each SIMD level, compared to scalar loops.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Number of items processed per call. This is small enough to stay in the L1 cache.
+const std::size_t itemCount = 4096;
+
+// Time a span function at every SIMD level the CPU supports, relative to a scalar loop.
+template <typename T_ty, typename T_span, typename T_scalar>
+void reportLevels(const std::string & name, const std::vector<T_ty> & input, const T_span & spanFunction, const T_scalar & scalarFunction)
+{
+    std::vector<T_ty> output(input.size());
+    const std::size_t n = input.size();
+
+    const double loop = bench::time([&] {
+        for (std::size_t i = 0; i < n; ++i)
+            output[i] = scalarFunction(input[i]);
+        bench::doNotOptimise(output);
+    }) / static_cast<double>(n);
+    bench::report(name + " (scalar loop)", loop);
+
+    const char * const levelNames[] = { "Scalar", "SSE2", "AVX2", "AVX-512" };
+    const SimdLevel original = getSimdLevel();
+    for (int level = 0; level <= static_cast<int>(getSupportedSimdLevel()); ++level) {
+        setSimdLevel(static_cast<SimdLevel>(level));
+        const double span = bench::time([&] {
+            spanFunction(input.data(), output.data(), n);
+            bench::doNotOptimise(output);
+        }) / static_cast<double>(n);
+        bench::report(name + " (span, " + levelNames[level] + ")", span, loop);
+    }
+    setSimdLevel(original);
+}
+
+} // namespace
+
+AIL_BENCHMARK_TEMPLATE_FP("math::UtilsBatch")
+{
+    // Every value needs wrapping, so the scalar loop always calls fmod. Times are per element.
+    const std::vector<T_ty> angles = bench::makeRandomValues<T_ty>(itemCount, T_ty(-3600), T_ty(3600), 1);
+    const std::vector<T_ty> amounts = bench::makeRandomValues<T_ty>(itemCount, T_ty(-0.5), T_ty(1.5), 2);
+
+    reportLevels("wrap", angles,
+        [](const T_ty * in, T_ty * out, std::size_t n) { wrap(in, T_ty(0), T_ty(360), out, n); },
+        [](const T_ty val) { return wrap(val, T_ty(0), T_ty(360)); });
+    reportLevels("clamp", angles,
+        [](const T_ty * in, T_ty * out, std::size_t n) { clamp(in, T_ty(-1000), T_ty(1000), out, n); },
+        [](const T_ty val) { return clamp(val, T_ty(-1000), T_ty(1000)); });
+    reportLevels("lerpClamp", amounts,
+        [](const T_ty * in, T_ty * out, std::size_t n) { lerpClamp(in, T_ty(-5), T_ty(5), out, n); },
+        [](const T_ty val) { return lerpClamp(val, T_ty(-5), T_ty(5)); });
+    reportLevels("degToRad", angles,
+        [](const T_ty * in, T_ty * out, std::size_t n) { degToRad(in, out, n); },
+        [](const T_ty val) { return degToRad(val); });
+}
@@ -0,0 +1,112 @@
+/** \file bench_Vector2d.cpp
+    \brief Benchmarks for every public operation of the Vector2d class.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Number of items processed per call. This is small enough to stay in the L1 cache.
+const std::size_t itemCount = 1024;
+
+// Make a set of vectors with components in the range [-1000, 1000].
+template <typename T_ty>
+std::vector<Vector2d<T_ty>> makeVectors(const unsigned seed)
+{
+    const std::vector<T_ty> values = bench::makeRandomValues<T_ty>(itemCount * 2, T_ty(-1000), T_ty(1000), seed);
+    std::vector<Vector2d<T_ty>> vectors;
+    for (std::size_t i = 0; i < itemCount; ++i)
+        vectors.push_back(Vector2d<T_ty>(values[i * 2], values[(i * 2) + 1]));
+    return vectors;
+}
+
+} // namespace
+
+AIL_BENCHMARK_TEMPLATE("math::Vector2d")
+{
+    const std::vector<Vector2d<T_ty>> a = makeVectors<T_ty>(1);
+    const std::vector<Vector2d<T_ty>> b = makeVectors<T_ty>(2);
+    const std::vector<T_ty> scalars = bench::makeRandomValues<T_ty>(itemCount, T_ty(1), T_ty(100), 3);
+    const std::vector<T_ty> dists = bench::makeRandomValues<T_ty>(itemCount, T_ty(-1500), T_ty(1500), 4);
+    const std::size_t n = itemCount;
+
+    // Construction / destruction.
+    bench::report("construct default", bench::timeEach(n, [&](std::size_t) { return Vector2d<T_ty>(); }));
+    bench::report("construct from components", bench::timeEach(n, [&](std::size_t i) { return Vector2d<T_ty>(scalars[i], dists[i]); }));
+    bench::report("construct from initializer list", bench::timeEach(n, [&](std::size_t i) { return Vector2d<T_ty> { scalars[i], dists[i] }; }));
+    bench::report("copy construct", bench::timeEach(n, [&](std::size_t i) { return Vector2d<T_ty>(a[i]); }));
+
+    // Operators.
+    bench::report("operator =", bench::timeEach(n, [&](std::size_t i) { Vector2d<T_ty> v; v = a[i]; return v; }));
+    bench::report("operator ==", bench::timeEach(n, [&](std::size_t i) { return a[i] == b[i]; }));
+    bench::report("operator !=", bench::timeEach(n, [&](std::size_t i) { return a[i] != b[i]; }));
+    bench::report("operator +=", bench::timeEach(n, [&](std::size_t i) { Vector2d<T_ty> v(a[i]); v += b[i]; return v; }));
+    bench::report("operator -=", bench::timeEach(n, [&](std::size_t i) { Vector2d<T_ty> v(a[i]); v -= b[i]; return v; }));
+    bench::report("operator *= (scalar)", bench::timeEach(n, [&](std::size_t i) { Vector2d<T_ty> v(a[i]); v *= scalars[i]; return v; }));
+    bench::report("operator /= (scalar)", bench::timeEach(n, [&](std::size_t i) { Vector2d<T_ty> v(a[i]); v /= scalars[i]; return v; }));
+    bench::report("operator - (unary)", bench::timeEach(n, [&](std::size_t i) { return -a[i]; }));
+    bench::report("operator + (vector)", bench::timeEach(n, [&](std::size_t i) { return a[i] + b[i]; }));
+    bench::report("operator - (vector)", bench::timeEach(n, [&](std::size_t i) { return a[i] - b[i]; }));
+    bench::report("operator * (vector, scalar)", bench::timeEach(n, [&](std::size_t i) { return a[i] * scalars[i]; }));
+    bench::report("operator * (scalar, vector)", bench::timeEach(n, [&](std::size_t i) { return scalars[i] * a[i]; }));
+    bench::report("operator / (vector, scalar)", bench::timeEach(n, [&](std::size_t i) { return a[i] / scalars[i]; }));
+    bench::report("operator / (scalar, vector)", bench::timeEach(n, [&](std::size_t i) { return scalars[i] / (b[i] + Vector2d<T_ty>(T_ty(2000), T_ty(2000))); }));
+
+    // Accessors / operations.
+    bench::report("set", bench::timeEach(n, [&](std::size_t i) { Vector2d<T_ty> v; v.set(scalars[i], dists[i]); return v; }));
+    bench::report("getLength", bench::timeEach(n, [&](std::size_t i) { return a[i].getLength(); }));
+    bench::report("getSqLength", bench::timeEach(n, [&](std::size_t i) { return a[i].getSqLength(); }));
+    bench::report("getWideSqLength", bench::timeEach(n, [&](std::size_t i) { return a[i].getWideSqLength(); }));
+    bench::report("getRectilinearLength", bench::timeEach(n, [&](std::size_t i) { return a[i].getRectilinearLength(); }));
+    bench::report("getChebyshevLength", bench::timeEach(n, [&](std::size_t i) { return a[i].getChebyshevLength(); }));
+    bench::report("normalise", bench::timeEach(n, [&](std::size_t i) { Vector2d<T_ty> v(a[i]); v.normalise(); return v; }));
+    bench::report("getNormalised", bench::timeEach(n, [&](std::size_t i) { return a[i].getNormalised(); }));
+    bench::report("getRightTangent", bench::timeEach(n, [&](std::size_t i) { return a[i].getRightTangent(); }));
+    bench::report("getLeftTangent", bench::timeEach(n, [&](std::size_t i) { return a[i].getLeftTangent(); }));
+    bench::report("dot", bench::timeEach(n, [&](std::size_t i) { return a[i].dot(b[i]); }));
+    bench::report("getScalarProjection", bench::timeEach(n, [&](std::size_t i) { return a[i].getScalarProjection(b[i]); }));
+    bench::report("getVectorProjection", bench::timeEach(n, [&](std::size_t i) { return a[i].getVectorProjection(b[i]); }));
+    bench::report("getDistance", bench::timeEach(n, [&](std::size_t i) { return a[i].getDistance(b[i]); }));
+    bench::report("getSqDistance", bench::timeEach(n, [&](std::size_t i) { return a[i].getSqDistance(b[i]); }));
+    bench::report("getWideSqDistance", bench::timeEach(n, [&](std::size_t i) { return a[i].getWideSqDistance(b[i]); }));
+    bench::report("getRectilinearDistance", bench::timeEach(n, [&](std::size_t i) { return a[i].getRectilinearDistance(b[i]); }));
+    bench::report("getChebyshevDistance", bench::timeEach(n, [&](std::size_t i) { return a[i].getChebyshevDistance(b[i]); }));
+    bench::report("isNear", bench::timeEach(n, [&](std::size_t i) { return a[i].isNear(b[i], dists[i]); }));
+    bench::report("isNearRectilinear", bench::timeEach(n, [&](std::size_t i) { return a[i].isNearRectilinear(b[i], dists[i]); }));
+    bench::report("isApproxEqual", bench::timeEach(n, [&](std::size_t i) { return a[i].isApproxEqual(b[i], dists[i]); }));
+}
+
+// Conversions to and from Polar, which doesn't support integer types.
+AIL_BENCHMARK_TEMPLATE_FP("math::Vector2d conversions")
+{
+    const std::vector<Vector2d<T_ty>> a = makeVectors<T_ty>(1);
+    const std::vector<Polar<T_ty>> polars(a.begin(), a.end());
+    const std::size_t n = itemCount;
+
+    bench::report("construct from Polar", bench::timeEach(n, [&](std::size_t i) { return Vector2d<T_ty>(polars[i]); }));
+    bench::report("toPolar (output parameter)", bench::timeEach(n, [&](std::size_t i) { Polar<T_ty> p; a[i].toPolar(p); return p; }));
+    bench::report("toPolar", bench::timeEach(n, [&](std::size_t i) { return a[i].toPolar(); }));
+}
+
+// Grid operations, which are only available for integer types.
+AIL_BENCHMARK("math::Vector2d<int> grid operations")
+{
+    const std::vector<Vector2d<int>> a = makeVectors<int>(1);
+    const std::vector<int> sizes = bench::makeRandomValues<int>(itemCount, 1, 64, 3);
+    const std::size_t n = itemCount;
+
+    // Compare against plain division, which rounds the wrong way for negative positions.
+    const double divTime = bench::timeEach(n, [&](std::size_t i) { return a[i] / sizes[i]; });
+    bench::report("operator / (vector, scalar)", divTime);
+    bench::report("floorDiv (vector, scalar)", bench::timeEach(n, [&](std::size_t i) { return floorDiv(a[i], sizes[i]); }), divTime);
+    bench::report("floorDiv (vector, vector)", bench::timeEach(n, [&](std::size_t i) { return floorDiv(a[i], Vector2d<int>(sizes[i], 16)); }));
+    bench::report("isqrt", bench::timeEach(n, [&](std::size_t i) { return isqrt(a[i].getSqLength()); }));
+}
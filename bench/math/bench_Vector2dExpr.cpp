@@ -0,0 +1,51 @@
+/** \file bench_Vector2dExpr.cpp
+    \brief Benchmarks for the Vector2d expression templates, compared to the normal operators.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <vector>
+
+using namespace ail::math;
+
+AIL_BENCHMARK_TEMPLATE_FP("math::Vector2dExpr")
+{
+    // A simple integration step over a buffer: p = p + v * dt - g * (dt * dt).
+    const std::size_t count = 4096;
+    const std::string suffix = " (" + std::to_string(count) + " vectors)";
+
+    const std::vector<T_ty> values = bench::makeRandomValues<T_ty>(count * 4, T_ty(-100), T_ty(100), 1);
+    std::vector<Vector2d<T_ty>> positions, velocities;
+    for (std::size_t i = 0; i < count; ++i) {
+        positions.push_back(Vector2d<T_ty>(values[i * 4], values[(i * 4) + 1]));
+        velocities.push_back(Vector2d<T_ty>(values[(i * 4) + 2], values[(i * 4) + 3]));
+    }
+    const Vector2d<T_ty> gravity(T_ty(0), T_ty(-9.81));
+    const T_ty dt = T_ty(1) / T_ty(60);
+
+    const double normal = bench::time([&] {
+        for (std::size_t i = 0; i < count; ++i)
+            positions[i] = positions[i] + velocities[i] * dt - gravity * (dt * dt);
+        bench::doNotOptimise(positions);
+    });
+    bench::report("normal operators, element by element" + suffix, normal);
+
+    const double fused = bench::time([&] {
+        expr::assign(positions, expr::lazy(positions) + expr::lazy(velocities) * dt - gravity * (dt * dt));
+        bench::doNotOptimise(positions);
+    });
+    bench::report("expr::assign" + suffix, fused, normal);
+
+    const Vector2d<T_ty> a(values[0], values[1]), b(values[2], values[3]), c(values[4], values[5]);
+    const std::vector<T_ty> scalars = bench::makeRandomValues<T_ty>(1024, T_ty(-2), T_ty(2), 2);
+    bench::report("single vector, normal operators", bench::timeEach(scalars.size(), [&](std::size_t i) {
+        return a + b * scalars[i] - c;
+    }));
+    bench::report("single vector, expr::eval", bench::timeEach(scalars.size(), [&](std::size_t i) {
+        return expr::eval(expr::lazy(a) + expr::lazy(b) * scalars[i] - c);
+    }));
+}
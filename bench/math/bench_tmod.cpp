@@ -0,0 +1,30 @@
+/** \file bench_tmod.cpp
+    \brief Benchmarks for the tmod modulus template.
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Number of items processed per call. This is small enough to stay in the L1 cache.
+const std::size_t itemCount = 1024;
+
+} // namespace
+
+AIL_BENCHMARK_TEMPLATE("math::tmod")
+{
+    const std::vector<T_ty> numers = bench::makeRandomValues<T_ty>(itemCount, T_ty(-100000), T_ty(100000), 1);
+    const std::vector<T_ty> denoms = bench::makeRandomValues<T_ty>(itemCount, T_ty(1), T_ty(1000), 2);
+    const std::size_t n = itemCount;
+
+    bench::report("mod", bench::timeEach(n, [&](std::size_t i) { return tmod<T_ty>::mod(numers[i], denoms[i]); }));
+    bench::report("mod (constant denominator)", bench::timeEach(n, [&](std::size_t i) { return tmod<T_ty>::mod(numers[i], T_ty(360)); }));
+}
@@ -0,0 +1,78 @@
+# Defines ail_apply_build_options(), which applies the optimisation and
+#  instrumentation settings chosen by the AIL_* cache variables to a target.
+# These only affect the test and benchmark projects. They are never added to
+#  the ail::math interface, so they don't leak into other projects.
+#
+# Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+# Copyright (C) 2015-16 Peter R. Bloomfield.
+# Released open source under the MIT licence.
+
+include_guard(GLOBAL)
+
+if(CMAKE_INTERPROCEDURAL_OPTIMIZATION)
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT AIL_IPO_SUPPORTED OUTPUT AIL_IPO_OUTPUT LANGUAGES CXX)
+    if(NOT AIL_IPO_SUPPORTED)
+        message(FATAL_ERROR "Link time optimisation was requested, but it isn't supported: ${AIL_IPO_OUTPUT}")
+    endif()
+endif()
+
+string(TOUPPER "${AIL_PGO}" AIL_PGO_STAGE)
+if(NOT AIL_PGO_STAGE MATCHES "^(OFF|GENERATE|USE)$")
+    message(FATAL_ERROR "AIL_PGO must be OFF, GENERATE or USE (got '${AIL_PGO}').")
+endif()
+
+if(NOT AIL_PGO_STAGE STREQUAL "OFF" AND NOT CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+    message(FATAL_ERROR "Profile guided optimisation is only supported for GCC and Clang.")
+endif()
+
+if(AIL_SANITIZE AND MSVC AND NOT AIL_SANITIZE STREQUAL "address")
+    message(FATAL_ERROR "MSVC only supports the address sanitizer.")
+endif()
+
+function(ail_apply_build_options target)
+    if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+        target_compile_options(${target} PRIVATE -Wall -Wextra)
+    elseif(MSVC)
+        target_compile_options(${target} PRIVATE /W4)
+    endif()
+
+    if(AIL_NATIVE)
+        if(MSVC)
+            message(WARNING "AIL_NATIVE has no equivalent for MSVC, and is ignored.")
+        else()
+            target_compile_options(${target} PRIVATE -march=native)
+        endif()
+    endif()
+
+    if(AIL_PGO_STAGE STREQUAL "GENERATE")
+        if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+            # Clang writes raw profiles, which must be merged with llvm-profdata
+            #  into ${AIL_PGO_DIR}/default.profdata before the USE stage.
+            target_compile_options(${target} PRIVATE "-fprofile-instr-generate=${AIL_PGO_DIR}/%p.profraw")
+            target_link_options(${target} PRIVATE "-fprofile-instr-generate=${AIL_PGO_DIR}/%p.profraw")
+        else()
+            target_compile_options(${target} PRIVATE "-fprofile-generate=${AIL_PGO_DIR}" -fprofile-update=atomic)
+            target_link_options(${target} PRIVATE "-fprofile-generate=${AIL_PGO_DIR}")
+        endif()
+    elseif(AIL_PGO_STAGE STREQUAL "USE")
+        if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+            target_compile_options(${target} PRIVATE "-fprofile-instr-use=${AIL_PGO_DIR}/default.profdata")
+            target_link_options(${target} PRIVATE "-fprofile-instr-use=${AIL_PGO_DIR}/default.profdata")
+        else()
+            # Missing or stale profiles are reported as warnings rather than errors.
+            target_compile_options(${target} PRIVATE "-fprofile-use=${AIL_PGO_DIR}" -fprofile-correction -Wno-missing-profile)
+            target_link_options(${target} PRIVATE "-fprofile-use=${AIL_PGO_DIR}")
+        endif()
+    endif()
+
+    if(AIL_SANITIZE)
+        if(MSVC)
+            target_compile_options(${target} PRIVATE /fsanitize=address)
+        else()
+            string(REPLACE ";" "," sanitizers "${AIL_SANITIZE}")
+            target_compile_options(${target} PRIVATE "-fsanitize=${sanitizers}" -fno-omit-frame-pointer -fno-sanitize-recover=all)
+            target_link_options(${target} PRIVATE "-fsanitize=${sanitizers}")
+        endif()
+    endif()
+endfunction()
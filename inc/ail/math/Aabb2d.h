@@ -0,0 +1,169 @@
+#ifndef ail_math_Aabb2d_h
+#define ail_math_Aabb2d_h
+
+/** \file Aabb2d.h
+    \brief Declares a 2d axis-aligned box stored as minimum and maximum corners. See Aabb2d.inl for implementation.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "BoundingBox2d.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/** An axis-aligned 2d box, stored as its minimum and maximum corners.
+This describes the same kind of box as BoundingBox2d, which stores a centre and
+ radius instead. Storing the corners means tests don't need to recalculate the
+ edges every time, and boxes can be combined without any division. It's a better
+ fit for code which merges lots of boxes, or tests the same boxes many times.
+A box is empty if its minimum is greater than its maximum on either axis. The
+ result of intersecting two separate boxes is empty, for example. An empty box
+ has no area and doesn't contain or intersect anything.
+None of the operations branch on the values of the boxes, so they can be
+ vectorised when used in loops.
+Like Vector2d, the class is trivially copyable and can be constructed at compile time.
+Template parameter gives the underlying numerical type (e.g. float or double).
+*/
+template <typename T_ty>
+class Aabb2d
+{
+public:
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - initialises everything to 0.
+    constexpr Aabb2d();
+
+    /// Constructor - explicitly initialises the corners of the box.
+    constexpr Aabb2d(const Vector2d<T_ty> & min, const Vector2d<T_ty> & max);
+
+    /// Constructor - explicitly initialises the corners of the box.
+    constexpr Aabb2d(const T_ty minX, const T_ty minY, const T_ty maxX, const T_ty maxY);
+
+    /// Constructor - converts a centre/radius box.
+    /// The corners are exactly the same as BoundingBox2d::getCornerX1Y1() and
+    ///  BoundingBox2d::getCornerX2Y2(), so contains() gives exactly the same
+    ///  results as BoundingBox2d::contains().
+    AIL_MATH_CONSTEXPR14 explicit Aabb2d(const BoundingBox2d<T_ty> & box);
+
+
+//------------------------------------------------------------------------------
+// Operators.
+
+    /// Equality test.
+    /// Note that this tests for exact equality, which isn't usually desirable for
+    ///  floating point types.
+    constexpr bool operator == (const Aabb2d<T_ty> & rhs) const;
+
+    /// Inequality test.
+    /// Note that this tests for (lack of) exact equality, which isn't usually
+    ///  desirable for floating point types.
+    constexpr bool operator != (const Aabb2d<T_ty> & rhs) const;
+
+
+//------------------------------------------------------------------------------
+// Conversion.
+
+    /// Convert to a centre/radius box, which always encloses this box.
+    /// Converting a BoundingBox2d to Aabb2d and back again is exact for integer
+    ///  types. For floating point types it's exact unless adding the radius to
+    ///  the position rounds, e.g. if the radius is tiny compared to the position.
+    /// For integer types, the centre of a box with an odd width or height is
+    ///  rounded down, and the radius is rounded up to cover the remainder.
+    BoundingBox2d<T_ty> toBoundingBox() const;
+
+
+//------------------------------------------------------------------------------
+// Accessors / operations.
+
+    /// Set both corners in one call.
+    void set(const Vector2d<T_ty> & min, const Vector2d<T_ty> & max);
+
+    /// Set both corners in one call.
+    void set(const T_ty minX, const T_ty minY, const T_ty maxX, const T_ty maxY);
+
+    /// Get the position of the centre of the box.
+    Vector2d<T_ty> getCentre() const;
+
+    /// Get the overall width and height of the box.
+    /// These will be negative on any axis where the box is empty.
+    Vector2d<T_ty> getSize() const;
+
+    /// Check if the box is empty, i.e. its minimum is greater than its maximum on either axis.
+    /// A box with NaN corners is also treated as empty.
+    bool isEmpty() const;
+
+    /// Get the area of the box. This is 0 if the box is empty.
+    T_ty getArea() const;
+
+    /// Get the perimeter of the box.
+    /// Any axis where the box is empty contributes 0.
+    T_ty getPerimeter() const;
+
+    /// Get the smallest box which encloses this box and another one.
+    /// If either box is empty, the result may be larger than necessary.
+    Aabb2d<T_ty> getUnion(const Aabb2d<T_ty> & rhs) const;
+
+    /// Get the region where this box overlaps another one.
+    /// The result is empty if the boxes don't intersect.
+    Aabb2d<T_ty> getIntersection(const Aabb2d<T_ty> & rhs) const;
+
+    /// Grow the box just enough to include the given point.
+    void expand(const Vector2d<T_ty> & point);
+
+    /// Grow the box just enough to include another box.
+    void expand(const Aabb2d<T_ty> & rhs);
+
+    /// Move every edge of the box outwards by the given amount.
+    /// A negative amount shrinks the box, possibly making it empty.
+    void expand(const T_ty margin);
+
+
+//------------------------------------------------------------------------------
+// Tests.
+
+    /// Check if this box contains the given point, including on the edges.
+    bool contains(const Vector2d<T_ty> & point) const;
+
+    /// Check if this box entirely contains another box.
+    bool contains(const Aabb2d<T_ty> & rhs) const;
+
+    /// Check if this box intersects another box, including if they just touch.
+    bool intersects(const Aabb2d<T_ty> & rhs) const;
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// Corner of the box with the lowest coordinates.
+    Vector2d<T_ty> min;
+
+    /// Corner of the box with the highest coordinates.
+    Vector2d<T_ty> max;
+
+
+private:
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+    /// Get the lower of two values.
+    /// This is written so that compilers can use a single min instruction.
+    static T_ty minOf(const T_ty lhs, const T_ty rhs);
+
+    /// Get the higher of two values.
+    /// This is written so that compilers can use a single max instruction.
+    static T_ty maxOf(const T_ty lhs, const T_ty rhs);
+};
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Aabb2d_h
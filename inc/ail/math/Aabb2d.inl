@@ -0,0 +1,216 @@
+#ifndef ail_math_Aabb2d_inl
+#define ail_math_Aabb2d_inl
+
+/** \file Aabb2d.inl
+    \brief Implementation for a 2d axis-aligned box stored as minimum and maximum corners (see Aabb2d.h).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "Aabb2d.h"
+#include "BoundingBox2d.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+template <typename T_ty>
+constexpr Aabb2d<T_ty>::Aabb2d() :
+    min(), max()
+{
+}
+
+template <typename T_ty>
+constexpr Aabb2d<T_ty>::Aabb2d(const Vector2d<T_ty> & min, const Vector2d<T_ty> & max) :
+    min(min), max(max)
+{
+}
+
+template <typename T_ty>
+constexpr Aabb2d<T_ty>::Aabb2d(const T_ty minX, const T_ty minY, const T_ty maxX, const T_ty maxY) :
+    min(minX, minY), max(maxX, maxY)
+{
+}
+
+template <typename T_ty>
+AIL_MATH_CONSTEXPR14 Aabb2d<T_ty>::Aabb2d(const BoundingBox2d<T_ty> & box) :
+    min(box.pos - box.radius), max(box.pos + box.radius)
+{
+}
+
+//------------------------------------------------------------------------------
+// Operators.
+
+template <typename T_ty>
+constexpr bool Aabb2d<T_ty>::operator == (const Aabb2d<T_ty> & rhs) const
+{
+    return min == rhs.min && max == rhs.max;
+}
+
+template <typename T_ty>
+constexpr bool Aabb2d<T_ty>::operator != (const Aabb2d<T_ty> & rhs) const
+{
+    return !(*this == rhs);
+}
+
+//------------------------------------------------------------------------------
+// Conversion.
+
+template <typename T_ty>
+BoundingBox2d<T_ty> Aabb2d<T_ty>::toBoundingBox() const
+{
+    // fromCorners() rounds the radius up where necessary, so the result always
+    //  encloses this box. It's the same box a BoundingBox2d was converted from,
+    //  unless the corners were rounded on the way (see the header).
+    return BoundingBox2d<T_ty>::fromCorners(min, max);
+}
+
+//------------------------------------------------------------------------------
+// Accessors / operations.
+
+template <typename T_ty>
+void Aabb2d<T_ty>::set(const Vector2d<T_ty> & min, const Vector2d<T_ty> & max)
+{
+    this->min = min;
+    this->max = max;
+}
+
+template <typename T_ty>
+void Aabb2d<T_ty>::set(const T_ty minX, const T_ty minY, const T_ty maxX, const T_ty maxY)
+{
+    min.set(minX, minY);
+    max.set(maxX, maxY);
+}
+
+template <typename T_ty>
+Vector2d<T_ty> Aabb2d<T_ty>::getCentre() const
+{
+    return Vector2d<T_ty>((min.x + max.x) / T_ty(2), (min.y + max.y) / T_ty(2));
+}
+
+template <typename T_ty>
+Vector2d<T_ty> Aabb2d<T_ty>::getSize() const
+{
+    return max - min;
+}
+
+template <typename T_ty>
+bool Aabb2d<T_ty>::isEmpty() const
+{
+    // Written so that a box with NaN corners counts as empty.
+    // Deliberately not short-circuiting, to avoid branches.
+    return !((min.x <= max.x) & (min.y <= max.y));
+}
+
+template <typename T_ty>
+T_ty Aabb2d<T_ty>::getArea() const
+{
+    return maxOf(max.x - min.x, T_ty(0)) * maxOf(max.y - min.y, T_ty(0));
+}
+
+template <typename T_ty>
+T_ty Aabb2d<T_ty>::getPerimeter() const
+{
+    return T_ty(2) * (maxOf(max.x - min.x, T_ty(0)) + maxOf(max.y - min.y, T_ty(0)));
+}
+
+template <typename T_ty>
+Aabb2d<T_ty> Aabb2d<T_ty>::getUnion(const Aabb2d<T_ty> & rhs) const
+{
+    return Aabb2d<T_ty>(
+        minOf(min.x, rhs.min.x), minOf(min.y, rhs.min.y),
+        maxOf(max.x, rhs.max.x), maxOf(max.y, rhs.max.y));
+}
+
+template <typename T_ty>
+Aabb2d<T_ty> Aabb2d<T_ty>::getIntersection(const Aabb2d<T_ty> & rhs) const
+{
+    return Aabb2d<T_ty>(
+        maxOf(min.x, rhs.min.x), maxOf(min.y, rhs.min.y),
+        minOf(max.x, rhs.max.x), minOf(max.y, rhs.max.y));
+}
+
+template <typename T_ty>
+void Aabb2d<T_ty>::expand(const Vector2d<T_ty> & point)
+{
+    min.set(minOf(min.x, point.x), minOf(min.y, point.y));
+    max.set(maxOf(max.x, point.x), maxOf(max.y, point.y));
+}
+
+template <typename T_ty>
+void Aabb2d<T_ty>::expand(const Aabb2d<T_ty> & rhs)
+{
+    *this = getUnion(rhs);
+}
+
+template <typename T_ty>
+void Aabb2d<T_ty>::expand(const T_ty margin)
+{
+    min.set(min.x - margin, min.y - margin);
+    max.set(max.x + margin, max.y + margin);
+}
+
+//------------------------------------------------------------------------------
+// Tests.
+
+template <typename T_ty>
+bool Aabb2d<T_ty>::contains(const Vector2d<T_ty> & point) const
+{
+    return
+        (point.x >= min.x) &
+        (point.y >= min.y) &
+        (point.x <= max.x) &
+        (point.y <= max.y);
+}
+
+template <typename T_ty>
+bool Aabb2d<T_ty>::contains(const Aabb2d<T_ty> & rhs) const
+{
+    return
+        (rhs.min.x >= min.x) &
+        (rhs.min.y >= min.y) &
+        (rhs.max.x <= max.x) &
+        (rhs.max.y <= max.y) &
+        !rhs.isEmpty();
+}
+
+template <typename T_ty>
+bool Aabb2d<T_ty>::intersects(const Aabb2d<T_ty> & rhs) const
+{
+    return
+        (min.x <= rhs.max.x) &
+        (min.y <= rhs.max.y) &
+        (rhs.min.x <= max.x) &
+        (rhs.min.y <= max.y) &
+        !isEmpty() &
+        !rhs.isEmpty();
+}
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+template <typename T_ty>
+T_ty Aabb2d<T_ty>::minOf(const T_ty lhs, const T_ty rhs)
+{
+    return (rhs < lhs) ? rhs : lhs;
+}
+
+template <typename T_ty>
+T_ty Aabb2d<T_ty>::maxOf(const T_ty lhs, const T_ty rhs)
+{
+    return (lhs < rhs) ? rhs : lhs;
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Aabb2d_inl
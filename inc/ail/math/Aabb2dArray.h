@@ -0,0 +1,224 @@
+#ifndef ail_math_Aabb2dArray_h
+#define ail_math_Aabb2dArray_h
+
+/** \file Aabb2dArray.h
+    \brief Declares a structure-of-arrays container of 2d axis-aligned boxes. See Aabb2dArray.inl for implementation.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+#include "Aabb2d.h"
+#include "Ray2d.h"
+#include "Segment2d.h"
+#include "SweptBox2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/** A contiguous array of 2d axis-aligned boxes, stored as a structure of arrays.
+Each coordinate of the corners (minimum x, minimum y, maximum x and maximum y) is
+ held in a separate aligned lane, rather than as interleaved Aabb2d objects.
+ This lets the batch tests compare several boxes at once using the SIMD kernels
+ from Vector2dKernels.h and Ray2dKernels.h.
+The batch tests give exactly the same results as calling the equivalent Aabb2d
+ function on each box.
+Template parameter gives the underlying numerical type, typically float or double.
+It must be a plain numeric type which can be copied with memcpy.
+*/
+template <typename T_ty>
+class Aabb2dArray
+{
+public:
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - creates an empty array.
+    Aabb2dArray();
+
+    /// Constructor - creates an array of the given size, with all corners set to 0.
+    explicit Aabb2dArray(const std::size_t count);
+
+    /// Constructor - initializer list of boxes.
+    Aabb2dArray(std::initializer_list<Aabb2d<T_ty>> args);
+
+    /// Constructor - copies the given range of interleaved boxes.
+    Aabb2dArray(const Aabb2d<T_ty> * boxes, const std::size_t count);
+
+    /// Copy constructor.
+    Aabb2dArray(const Aabb2dArray<T_ty> & rhs);
+
+    /// Move constructor.
+    Aabb2dArray(Aabb2dArray<T_ty> && rhs);
+
+    /// Destructor.
+    ~Aabb2dArray();
+
+
+//------------------------------------------------------------------------------
+// Operators.
+
+    /// Copy assignment operator.
+    Aabb2dArray<T_ty> & operator = (const Aabb2dArray<T_ty> & rhs);
+
+    /// Move assignment operator.
+    Aabb2dArray<T_ty> & operator = (Aabb2dArray<T_ty> && rhs);
+
+    /// Equality test. Arrays are equal if they have the same size and all boxes are equal.
+    bool operator == (const Aabb2dArray<T_ty> & rhs) const;
+    /// Inequality test.
+    bool operator != (const Aabb2dArray<T_ty> & rhs) const;
+
+    /// Get a copy of the box at the given index.
+    Aabb2d<T_ty> operator [] (const std::size_t index) const;
+
+
+//------------------------------------------------------------------------------
+// Size / storage.
+
+    /// Get the number of boxes in the array.
+    std::size_t size() const;
+
+    /// Check if the array has no boxes.
+    bool empty() const;
+
+    /// Get the number of boxes which can be stored without reallocating.
+    std::size_t capacity() const;
+
+    /// Ensure there is space for at least count boxes without reallocating.
+    void reserve(const std::size_t count);
+
+    /// Change the number of boxes in the array.
+    /// New boxes have all their corners set to 0.
+    void resize(const std::size_t count);
+
+    /// Remove all boxes. This does not release the storage.
+    void clear();
+
+    /// Append a box to the end of the array.
+    /// Throws std::length_error if the capacity can't grow any further, or
+    ///  std::bad_alloc if the allocation fails.
+    void push_back(const Aabb2d<T_ty> & box);
+
+    /// Get a pointer to the contiguous lane of minimum x coordinates.
+    T_ty * minX();
+    /// Get a pointer to the contiguous lane of minimum x coordinates.
+    const T_ty * minX() const;
+
+    /// Get a pointer to the contiguous lane of minimum y coordinates.
+    T_ty * minY();
+    /// Get a pointer to the contiguous lane of minimum y coordinates.
+    const T_ty * minY() const;
+
+    /// Get a pointer to the contiguous lane of maximum x coordinates.
+    T_ty * maxX();
+    /// Get a pointer to the contiguous lane of maximum x coordinates.
+    const T_ty * maxX() const;
+
+    /// Get a pointer to the contiguous lane of maximum y coordinates.
+    T_ty * maxY();
+    /// Get a pointer to the contiguous lane of maximum y coordinates.
+    const T_ty * maxY() const;
+
+
+//------------------------------------------------------------------------------
+// Element access.
+
+    /// Get a copy of the box at the given index.
+    Aabb2d<T_ty> get(const std::size_t index) const;
+
+    /// Set the box at the given index.
+    void set(const std::size_t index, const Aabb2d<T_ty> & box);
+
+
+//------------------------------------------------------------------------------
+// Batch operations.
+
+    /// Check whether every box intersects a single query box.
+    /// This gives the same results as calling Aabb2d::intersects() on each box.
+    /// The output buffer must have space for size() values.
+    void intersects(const Aabb2d<T_ty> & query, bool * output) const;
+
+    /// Find every box which intersects a single query box.
+    /// Their indices are appended to the output container in ascending order,
+    ///  without clearing it first.
+    void getIntersecting(const Aabb2d<T_ty> & query, std::vector<std::size_t> & output) const;
+
+    /// Cast a ray against every box.
+    /// This gives the same results as calling Ray2d::intersects() on each box,
+    ///  except that the entry and exit distances are written for misses too.
+    /// Each output buffer must have space for size() values.
+    /// Only valid for floating point types.
+    void castRay(const Ray2d<T_ty> & ray, T_ty * entry, T_ty * exit, bool * hit) const;
+
+    /// Cast a line segment against every box.
+    /// This gives the same results as calling Segment2d::intersects() on each box,
+    ///  except that the entry and exit fractions are written for misses too.
+    /// Each output buffer must have space for size() values.
+    /// Only valid for floating point types.
+    void castSegment(const Segment2d<T_ty> & segment, T_ty * entry, T_ty * exit, bool * hit) const;
+
+    /// Sweep a moving box against every (static) box.
+    /// This gives the same results as calling SweptBox2d::intersects() on each
+    ///  box, except that the times and normals are written for misses too. The
+    ///  normals are split into separate x and y outputs.
+    /// Each output buffer must have space for size() values.
+    /// Only valid for floating point types.
+    void sweep(const SweptBox2d<T_ty> & mover, T_ty * time, T_ty * normalX, T_ty * normalY, bool * hit) const;
+
+
+private:
+//------------------------------------------------------------------------------
+// Internal types.
+
+    /// Identifies the lanes of coordinates.
+    enum Lane
+    {
+        LaneMinX,
+        LaneMinY,
+        LaneMaxX,
+        LaneMaxY,
+        /// Number of lanes. This must come last.
+        LaneCount
+    };
+
+    /// Number of boxes tested at a time by getIntersecting().
+    static const std::size_t chunkSize = 256;
+
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+    /// Reallocate the lanes to hold exactly newCapacity boxes.
+    /// Existing contents are kept if preserve is true. Otherwise the array is
+    ///  left empty, which avoids copying data that's about to be overwritten.
+    /// Throws std::length_error if the lanes would be too big to address, or
+    ///  std::bad_alloc if the allocation fails.
+    void reallocate(const std::size_t newCapacity, const bool preserve = true);
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// Lanes of coordinates, indexed by Lane.
+    T_ty * m_lanes[LaneCount];
+
+    /// Number of boxes in use.
+    std::size_t m_size;
+
+    /// Number of boxes allocated.
+    std::size_t m_capacity;
+};
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Aabb2dArray_h
@@ -0,0 +1,388 @@
+#ifndef ail_math_Aabb2dArray_inl
+#define ail_math_Aabb2dArray_inl
+
+/** \file Aabb2dArray.inl
+    \brief Implementation for a structure-of-arrays container of 2d axis-aligned boxes (see Aabb2dArray.h).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "Aabb2dArray.h"
+#include "Aabb2d.h"
+#include "Ray2dKernels.h"
+#include "Segment2d.inl"
+#include "SweptBox2d.inl"
+#include "Vector2dKernels.h"
+#include "Aligned.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+template <typename T_ty>
+const std::size_t Aabb2dArray<T_ty>::chunkSize;
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+template <typename T_ty>
+Aabb2dArray<T_ty>::Aabb2dArray() :
+    m_size(0), m_capacity(0)
+{
+    for (int lane = 0; lane < LaneCount; ++lane)
+        m_lanes[lane] = nullptr;
+}
+
+template <typename T_ty>
+Aabb2dArray<T_ty>::Aabb2dArray(const std::size_t count) :
+    Aabb2dArray()
+{
+    resize(count);
+}
+
+template <typename T_ty>
+Aabb2dArray<T_ty>::Aabb2dArray(std::initializer_list<Aabb2d<T_ty>> args) :
+    Aabb2dArray(args.begin(), args.size())
+{
+}
+
+template <typename T_ty>
+Aabb2dArray<T_ty>::Aabb2dArray(const Aabb2d<T_ty> * boxes, const std::size_t count) :
+    Aabb2dArray()
+{
+    reallocate(count);
+    m_size = count;
+    for (std::size_t i = 0; i < count; ++i)
+        set(i, boxes[i]);
+}
+
+template <typename T_ty>
+Aabb2dArray<T_ty>::Aabb2dArray(const Aabb2dArray<T_ty> & rhs) :
+    Aabb2dArray()
+{
+    *this = rhs;
+}
+
+template <typename T_ty>
+Aabb2dArray<T_ty>::Aabb2dArray(Aabb2dArray<T_ty> && rhs) :
+    m_size(rhs.m_size), m_capacity(rhs.m_capacity)
+{
+    for (int lane = 0; lane < LaneCount; ++lane) {
+        m_lanes[lane] = rhs.m_lanes[lane];
+        rhs.m_lanes[lane] = nullptr;
+    }
+    rhs.m_size = 0;
+    rhs.m_capacity = 0;
+}
+
+template <typename T_ty>
+Aabb2dArray<T_ty>::~Aabb2dArray()
+{
+    for (int lane = 0; lane < LaneCount; ++lane)
+        alignedFree(m_lanes[lane]);
+}
+
+//------------------------------------------------------------------------------
+// Operators.
+
+template <typename T_ty>
+Aabb2dArray<T_ty> & Aabb2dArray<T_ty>::operator = (const Aabb2dArray<T_ty> & rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    if (m_capacity < rhs.m_size)
+        reallocate(rhs.m_size, false);
+
+    if (rhs.m_size > 0) {
+        for (int lane = 0; lane < LaneCount; ++lane)
+            std::memcpy(m_lanes[lane], rhs.m_lanes[lane], rhs.m_size * sizeof(T_ty));
+    }
+    m_size = rhs.m_size;
+    return *this;
+}
+
+template <typename T_ty>
+Aabb2dArray<T_ty> & Aabb2dArray<T_ty>::operator = (Aabb2dArray<T_ty> && rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    for (int lane = 0; lane < LaneCount; ++lane) {
+        alignedFree(m_lanes[lane]);
+        m_lanes[lane] = rhs.m_lanes[lane];
+        rhs.m_lanes[lane] = nullptr;
+    }
+    m_size = rhs.m_size;
+    m_capacity = rhs.m_capacity;
+
+    rhs.m_size = 0;
+    rhs.m_capacity = 0;
+    return *this;
+}
+
+template <typename T_ty>
+bool Aabb2dArray<T_ty>::operator == (const Aabb2dArray<T_ty> & rhs) const
+{
+    if (m_size != rhs.m_size)
+        return false;
+
+    for (int lane = 0; lane < LaneCount; ++lane) {
+        for (std::size_t i = 0; i < m_size; ++i) {
+            if (m_lanes[lane][i] != rhs.m_lanes[lane][i])
+                return false;
+        }
+    }
+    return true;
+}
+
+template <typename T_ty>
+bool Aabb2dArray<T_ty>::operator != (const Aabb2dArray<T_ty> & rhs) const
+{
+    return !(*this == rhs);
+}
+
+template <typename T_ty>
+Aabb2d<T_ty> Aabb2dArray<T_ty>::operator [] (const std::size_t index) const
+{
+    return get(index);
+}
+
+//------------------------------------------------------------------------------
+// Size / storage.
+
+template <typename T_ty>
+std::size_t Aabb2dArray<T_ty>::size() const
+{
+    return m_size;
+}
+
+template <typename T_ty>
+bool Aabb2dArray<T_ty>::empty() const
+{
+    return m_size == 0;
+}
+
+template <typename T_ty>
+std::size_t Aabb2dArray<T_ty>::capacity() const
+{
+    return m_capacity;
+}
+
+template <typename T_ty>
+void Aabb2dArray<T_ty>::reserve(const std::size_t count)
+{
+    if (count > m_capacity)
+        reallocate(count);
+}
+
+template <typename T_ty>
+void Aabb2dArray<T_ty>::resize(const std::size_t count)
+{
+    reserve(count);
+    for (int lane = 0; lane < LaneCount; ++lane) {
+        for (std::size_t i = m_size; i < count; ++i)
+            m_lanes[lane][i] = T_ty(0);
+    }
+    m_size = count;
+}
+
+template <typename T_ty>
+void Aabb2dArray<T_ty>::clear()
+{
+    m_size = 0;
+}
+
+template <typename T_ty>
+void Aabb2dArray<T_ty>::push_back(const Aabb2d<T_ty> & box)
+{
+    if (m_size == m_capacity) {
+        // Doubling a huge capacity would wrap round, so it's reported as too big instead.
+        if (m_capacity > std::numeric_limits<std::size_t>::max() / (2 * sizeof(T_ty)))
+            throw std::length_error("Aabb2dArray capacity is too large.");
+        reallocate(m_capacity < 8 ? 8 : m_capacity * 2);
+    }
+
+    ++m_size;
+    set(m_size - 1, box);
+}
+
+template <typename T_ty>
+T_ty * Aabb2dArray<T_ty>::minX()
+{
+    return m_lanes[LaneMinX];
+}
+
+template <typename T_ty>
+const T_ty * Aabb2dArray<T_ty>::minX() const
+{
+    return m_lanes[LaneMinX];
+}
+
+template <typename T_ty>
+T_ty * Aabb2dArray<T_ty>::minY()
+{
+    return m_lanes[LaneMinY];
+}
+
+template <typename T_ty>
+const T_ty * Aabb2dArray<T_ty>::minY() const
+{
+    return m_lanes[LaneMinY];
+}
+
+template <typename T_ty>
+T_ty * Aabb2dArray<T_ty>::maxX()
+{
+    return m_lanes[LaneMaxX];
+}
+
+template <typename T_ty>
+const T_ty * Aabb2dArray<T_ty>::maxX() const
+{
+    return m_lanes[LaneMaxX];
+}
+
+template <typename T_ty>
+T_ty * Aabb2dArray<T_ty>::maxY()
+{
+    return m_lanes[LaneMaxY];
+}
+
+template <typename T_ty>
+const T_ty * Aabb2dArray<T_ty>::maxY() const
+{
+    return m_lanes[LaneMaxY];
+}
+
+//------------------------------------------------------------------------------
+// Element access.
+
+template <typename T_ty>
+Aabb2d<T_ty> Aabb2dArray<T_ty>::get(const std::size_t index) const
+{
+    assert(index < m_size);
+    return Aabb2d<T_ty>(
+        m_lanes[LaneMinX][index], m_lanes[LaneMinY][index],
+        m_lanes[LaneMaxX][index], m_lanes[LaneMaxY][index]);
+}
+
+template <typename T_ty>
+void Aabb2dArray<T_ty>::set(const std::size_t index, const Aabb2d<T_ty> & box)
+{
+    assert(index < m_size);
+    m_lanes[LaneMinX][index] = box.min.x;
+    m_lanes[LaneMinY][index] = box.min.y;
+    m_lanes[LaneMaxX][index] = box.max.x;
+    m_lanes[LaneMaxY][index] = box.max.y;
+}
+
+//------------------------------------------------------------------------------
+// Batch operations.
+
+template <typename T_ty>
+void Aabb2dArray<T_ty>::intersects(const Aabb2d<T_ty> & query, bool * output) const
+{
+    kernels::intersects(
+        m_lanes[LaneMinX], m_lanes[LaneMinY], m_lanes[LaneMaxX], m_lanes[LaneMaxY],
+        query.min.x, query.min.y, query.max.x, query.max.y,
+        output, m_size);
+}
+
+template <typename T_ty>
+void Aabb2dArray<T_ty>::getIntersecting(const Aabb2d<T_ty> & query, std::vector<std::size_t> & output) const
+{
+    // Test a small chunk at a time, so the flags stay in the cache.
+    bool hits[chunkSize];
+    for (std::size_t begin = 0; begin < m_size; begin += chunkSize) {
+        const std::size_t count = (m_size - begin < chunkSize) ? m_size - begin : chunkSize;
+        kernels::intersects(
+            m_lanes[LaneMinX] + begin, m_lanes[LaneMinY] + begin,
+            m_lanes[LaneMaxX] + begin, m_lanes[LaneMaxY] + begin,
+            query.min.x, query.min.y, query.max.x, query.max.y,
+            hits, count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            if (hits[i])
+                output.push_back(begin + i);
+        }
+    }
+}
+
+template <typename T_ty>
+void Aabb2dArray<T_ty>::castRay(const Ray2d<T_ty> & ray, T_ty * entry, T_ty * exit, bool * hit) const
+{
+    const Vector2d<T_ty> inv = ray.getInverseDirection();
+    kernels::castRay(
+        m_lanes[LaneMinX], m_lanes[LaneMinY], m_lanes[LaneMaxX], m_lanes[LaneMaxY],
+        ray.origin.x, ray.origin.y, inv.x, inv.y, std::numeric_limits<T_ty>::max(),
+        entry, exit, hit, m_size);
+}
+
+template <typename T_ty>
+void Aabb2dArray<T_ty>::castSegment(const Segment2d<T_ty> & segment, T_ty * entry, T_ty * exit, bool * hit) const
+{
+    const Vector2d<T_ty> inv = segment.toRay().getInverseDirection();
+    kernels::castRay(
+        m_lanes[LaneMinX], m_lanes[LaneMinY], m_lanes[LaneMaxX], m_lanes[LaneMaxY],
+        segment.start.x, segment.start.y, inv.x, inv.y, T_ty(1),
+        entry, exit, hit, m_size);
+}
+
+template <typename T_ty>
+void Aabb2dArray<T_ty>::sweep(const SweptBox2d<T_ty> & mover, T_ty * time, T_ty * normalX, T_ty * normalY, bool * hit) const
+{
+    kernels::sweepBox(
+        m_lanes[LaneMinX], m_lanes[LaneMinY], m_lanes[LaneMaxX], m_lanes[LaneMaxY],
+        mover.box.pos.x, mover.box.pos.y, mover.box.radius.x, mover.box.radius.y,
+        T_ty(1) / mover.velocity.x, T_ty(1) / mover.velocity.y,
+        time, normalX, normalY, hit, m_size);
+}
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+template <typename T_ty>
+void Aabb2dArray<T_ty>::reallocate(const std::size_t newCapacity, const bool preserve)
+{
+    if (newCapacity > std::numeric_limits<std::size_t>::max() / sizeof(T_ty))
+        throw std::length_error("Aabb2dArray capacity is too large.");
+
+    T_ty * newLanes[LaneCount] = { nullptr, nullptr, nullptr, nullptr };
+
+    if (newCapacity > 0) {
+        try {
+            for (int lane = 0; lane < LaneCount; ++lane)
+                newLanes[lane] = static_cast<T_ty *>(alignedAlloc(newCapacity * sizeof(T_ty)));
+        } catch (...) {
+            for (int lane = 0; lane < LaneCount; ++lane)
+                alignedFree(newLanes[lane]);
+            throw;
+        }
+    }
+
+    const std::size_t keep = !preserve ? 0 : ((m_size < newCapacity) ? m_size : newCapacity);
+    for (int lane = 0; lane < LaneCount; ++lane) {
+        if (keep > 0)
+            std::memcpy(newLanes[lane], m_lanes[lane], keep * sizeof(T_ty));
+        alignedFree(m_lanes[lane]);
+        m_lanes[lane] = newLanes[lane];
+    }
+    m_size = keep;
+    m_capacity = newCapacity;
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Aabb2dArray_inl
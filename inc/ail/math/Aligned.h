@@ -0,0 +1,60 @@
+#ifndef ail_math_Aligned_h
+#define ail_math_Aligned_h
+
+/** \file Aligned.h
+    \brief Provides helpers for allocating over-aligned memory. (Intended for internal use by the library.)
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/// Default alignment (in bytes) used for contiguous numeric storage.
+/// This matches a typical cache line, which is also enough for the widest SIMD registers.
+const std::size_t defaultAlignment = 64;
+
+/// Allocate a block of memory with the given alignment.
+/// The alignment must be a power of two.
+/// The returned pointer must be released using alignedFree().
+/// Throws std::bad_alloc if the allocation fails, or if bytes is too big to allocate with the padding.
+inline void * alignedAlloc(const std::size_t bytes, const std::size_t alignment = defaultAlignment)
+{
+    // Over-allocate, then store the original pointer just before the aligned block.
+    // The extra space could make a huge request wrap round to a small one, so that's treated as a failure.
+    if (bytes > static_cast<std::size_t>(-1) - alignment - sizeof(void *))
+        throw std::bad_alloc();
+    void * raw = std::malloc(bytes + alignment + sizeof(void *));
+    if (!raw)
+        throw std::bad_alloc();
+
+    const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void *);
+    const std::uintptr_t aligned = (start + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    void ** ptr = reinterpret_cast<void **>(aligned);
+    ptr[-1] = raw;
+    return ptr;
+}
+
+/// Release a block of memory previously allocated by alignedAlloc().
+/// Does nothing if ptr is null.
+inline void alignedFree(void * ptr)
+{
+    if (ptr)
+        std::free(static_cast<void **>(ptr)[-1]);
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Aligned_h
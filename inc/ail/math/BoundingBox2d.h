@@ -9,6 +9,7 @@
     Released open source under the MIT licence.
 */
 
+#include <cstddef>
 #include <initializer_list>
 #include "Vector2d.h"
 
@@ -21,6 +22,7 @@ namespace math {
 /// This is typically used in optimisation algorithms rather than representing
 ///  actual geometry.
 /// Template parameter specifies the underlying value type (e.g. float or double).
+/// The class is trivially copyable, and construction and comparison are constexpr.
 template <typename T_ty>
 class BoundingBox2d
 {
@@ -29,47 +31,71 @@ public:
     // Construction / destruction.
 
     /// Constructor - initialises everything to 0.
-    BoundingBox2d();
+    constexpr BoundingBox2d();
 
     /// Constructor - explicitly initialises the position and size of the box.
     /// pos gives the position of the box's centre.
     /// The x and y components of radius give half the overall width and height.
-    BoundingBox2d(const Vector2d<T_ty> & pos, const Vector2d<T_ty> & radius);
+    constexpr BoundingBox2d(const Vector2d<T_ty> & pos, const Vector2d<T_ty> & radius);
 
     /// Initializer list constructor - expects a pair of vectors.
     /// Order of elements is: position, radius.
     /// If list if empty, values are initialised to 0.
     /// Note that vectors can be constructed as initialiser lists too, so you could
     ///  initialise a bounding box like this: {{x,y}, {w,h}}
-    BoundingBox2d(std::initializer_list<Vector2d<T_ty>> args);
+    AIL_MATH_CONSTEXPR14 BoundingBox2d(std::initializer_list<Vector2d<T_ty>> args);
 
     /// Constructor - explicitly initialises the position and size of the box.
     /// posX and posY give the position of the box's centre.
     /// radiusX and radiusY give half the overall width and height respectively.
-    BoundingBox2d(const T_ty posX, const T_ty posY, const T_ty radiusX, const T_ty radiusY);
+    constexpr BoundingBox2d(const T_ty posX, const T_ty posY, const T_ty radiusX, const T_ty radiusY);
+
+    /// Create a box which only just contains the rectangle between two corners.
+    /// Each component of minCorner must be no greater than the same component of
+    ///  maxCorner. For floating point types, the radius is rounded up if necessary,
+    ///  so that contains() is true for both corners.
+    static BoundingBox2d<T_ty> fromCorners(const Vector2d<T_ty> & minCorner, const Vector2d<T_ty> & maxCorner);
+
+    /// Create a box which only just contains a set of points.
+    /// The corners are found with a SIMD min/max reduction for float and double
+    ///  (see kernels::expandBounds()), then passed to fromCorners(). Coordinates
+    ///  mustn't be NaN. Returns a box with zero position and size if count is 0.
+    /// For very large sets, parallelBoundingBox() in ParallelBatch.h also splits
+    ///  the work across threads.
+    static BoundingBox2d<T_ty> fromPoints(const Vector2d<T_ty> * points, const std::size_t count);
+
+    /// Create a box which only just contains a set of points, stored as separate
+    ///  lanes of x and y coordinates (e.g. from Vector2dArray).
+    /// See the other version of fromPoints().
+    static BoundingBox2d<T_ty> fromPoints(const T_ty * x, const T_ty * y, const std::size_t count);
 
     /// Copy constructor
-    BoundingBox2d(const BoundingBox2d<T_ty> & rhs);
+    BoundingBox2d(const BoundingBox2d<T_ty> & rhs) = default;
+
+    /// Move constructor.
+    BoundingBox2d(BoundingBox2d<T_ty> && rhs) = default;
 
     /// Destructor
-    ~BoundingBox2d();
+    ~BoundingBox2d() = default;
 
 
     //------------------------------------------------------------------------------
     // Operators.
 
     /// Copy assignment operator.
-    BoundingBox2d<T_ty> & operator = (const BoundingBox2d<T_ty> & rhs);
+    BoundingBox2d<T_ty> & operator = (const BoundingBox2d<T_ty> & rhs) = default;
+    /// Move assignment operator.
+    BoundingBox2d<T_ty> & operator = (BoundingBox2d<T_ty> && rhs) = default;
 
     /// Equality test.
     /// Note that this tests for exact equality, which isn't usually desirable for
     ///  floating point types.
-    bool operator == (const BoundingBox2d<T_ty> & rhs) const;
+    constexpr bool operator == (const BoundingBox2d<T_ty> & rhs) const;
 
     /// Equality test.
     /// Note that this tests for (lack of) exact equality, which isn't usually
     ///  desirable for floating point types.
-    bool operator != (const BoundingBox2d<T_ty> & rhs) const;
+    constexpr bool operator != (const BoundingBox2d<T_ty> & rhs) const;
 
 
     //------------------------------------------------------------------------------
@@ -78,25 +104,25 @@ public:
     /// Sets the position and size in one call.
     /// pos gives the position of the box's centre.
     /// The x and y components of radius give half the overall width and height.
-    void set(const Vector2d<T_ty> & pos, const Vector2d<T_ty> & radius);
+    AIL_MATH_CONSTEXPR14 void set(const Vector2d<T_ty> & pos, const Vector2d<T_ty> & radius);
 
     /// Sets the position and size in one call.
     /// posX and posY give the position of the box's centre.
     /// radiusX and radiusY give half the overall width and height respectively.
-    void set(const T_ty posX, const T_ty posY, const T_ty radiusX, const T_ty radiusY);
+    AIL_MATH_CONSTEXPR14 void set(const T_ty posX, const T_ty posY, const T_ty radiusX, const T_ty radiusY);
 
 
     /// Get the position of the -X -Y corner of the box.
-    Vector2d<T_ty> getCornerX1Y1() const;
+    AIL_MATH_CONSTEXPR14 Vector2d<T_ty> getCornerX1Y1() const;
 
     /// Get the position of the +X +Y corner of the box.
-    Vector2d<T_ty> getCornerX2Y2() const;
+    AIL_MATH_CONSTEXPR14 Vector2d<T_ty> getCornerX2Y2() const;
 
     /// Get the position of the -X +Y corner of the box.
-    Vector2d<T_ty> getCornerX1Y2() const;
+    AIL_MATH_CONSTEXPR14 Vector2d<T_ty> getCornerX1Y2() const;
 
     /// Get the position of the +X -Y corner of the box.
-    Vector2d<T_ty> getCornerX2Y1() const;
+    AIL_MATH_CONSTEXPR14 Vector2d<T_ty> getCornerX2Y1() const;
 
 
     //------------------------------------------------------------------------------
@@ -11,30 +11,76 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
 
 #include "BoundingBox2d.h"
+#include "Vector2dKernels.h"
 
 //--------------
 namespace ail {
 namespace math {
 //--------------
 
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+namespace boundingbox2d {
+
+/// Get the centre of a range, for floating point types.
+/// Each end is halved separately, so that very large ranges don't overflow.
+template <typename T_ty>
+inline T_ty centre(const T_ty lower, const T_ty upper, std::true_type)
+{
+    return (lower * T_ty(0.5)) + (upper * T_ty(0.5));
+}
+
+/// Get the centre of a range, for other types. This rounds down.
+template <typename T_ty>
+inline T_ty centre(const T_ty lower, const T_ty upper, std::false_type)
+{
+    return lower + ((upper - lower) / T_ty(2));
+}
+
+/// Grow a radius until it covers a range, for floating point types.
+/// The subtractions below can round down, so this takes at most a couple of steps.
+template <typename T_ty>
+inline T_ty enclose(const T_ty lower, const T_ty upper, const T_ty pos, T_ty radius, std::true_type)
+{
+    while ((pos - radius) > lower || (pos + radius) < upper)
+        radius = std::nextafter(radius, std::numeric_limits<T_ty>::infinity());
+    return radius;
+}
+
+/// Grow a radius until it covers a range, for other types.
+/// The arithmetic is exact, and the centre is rounded down, so the upper end is always the furthest.
+template <typename T_ty>
+inline T_ty enclose(const T_ty, const T_ty, const T_ty, const T_ty radius, std::false_type)
+{
+    return radius;
+}
+
+} // boundingbox2d
+
 //------------------------------------------------------------------------------
 // Construction / destruction.
 
 template <typename T_ty>
-BoundingBox2d<T_ty>::BoundingBox2d()
+constexpr BoundingBox2d<T_ty>::BoundingBox2d() :
+    pos(), radius()
 {
 }
 
 template <typename T_ty>
-BoundingBox2d<T_ty>::BoundingBox2d(const Vector2d<T_ty> & pos, const Vector2d<T_ty> & radius) :
+constexpr BoundingBox2d<T_ty>::BoundingBox2d(const Vector2d<T_ty> & pos, const Vector2d<T_ty> & radius) :
     pos(pos), radius(radius)
 {
 }
 
 template <typename T_ty>
-BoundingBox2d<T_ty>::BoundingBox2d(std::initializer_list<Vector2d<T_ty>> args) :
+AIL_MATH_CONSTEXPR14 BoundingBox2d<T_ty>::BoundingBox2d(std::initializer_list<Vector2d<T_ty>> args) :
     BoundingBox2d()
 {
     if (args.size() == 0)
@@ -48,41 +94,56 @@ BoundingBox2d<T_ty>::BoundingBox2d(std::initializer_list<Vector2d<T_ty>> args) :
 }
 
 template <typename T_ty>
-BoundingBox2d<T_ty>::BoundingBox2d(const T_ty posX, const T_ty posY, const T_ty radiusX, const T_ty radiusY) :
+constexpr BoundingBox2d<T_ty>::BoundingBox2d(const T_ty posX, const T_ty posY, const T_ty radiusX, const T_ty radiusY) :
     pos(posX, posY), radius(radiusX, radiusY)
 {
 }
 
 template <typename T_ty>
-BoundingBox2d<T_ty>::BoundingBox2d(const BoundingBox2d<T_ty> & rhs) :
-    pos(rhs.pos), radius(rhs.size)
+BoundingBox2d<T_ty> BoundingBox2d<T_ty>::fromCorners(const Vector2d<T_ty> & minCorner, const Vector2d<T_ty> & maxCorner)
 {
+    const std::is_floating_point<T_ty> isFloat;
+    BoundingBox2d<T_ty> box;
+    box.pos.x = boundingbox2d::centre(minCorner.x, maxCorner.x, isFloat);
+    box.pos.y = boundingbox2d::centre(minCorner.y, maxCorner.y, isFloat);
+    box.radius.x = boundingbox2d::enclose(minCorner.x, maxCorner.x, box.pos.x, maxCorner.x - box.pos.x, isFloat);
+    box.radius.y = boundingbox2d::enclose(minCorner.y, maxCorner.y, box.pos.y, maxCorner.y - box.pos.y, isFloat);
+    return box;
 }
 
 template <typename T_ty>
-BoundingBox2d<T_ty>::~BoundingBox2d()
+BoundingBox2d<T_ty> BoundingBox2d<T_ty>::fromPoints(const Vector2d<T_ty> * points, const std::size_t count)
 {
-}
+    if (count == 0)
+        return BoundingBox2d<T_ty>();
 
-//------------------------------------------------------------------------------
-// Operators.
+    Vector2d<T_ty> minCorner = points[0], maxCorner = points[0];
+    kernels::expandBounds(points + 1, count - 1, minCorner, maxCorner);
+    return fromCorners(minCorner, maxCorner);
+}
 
 template <typename T_ty>
-BoundingBox2d<T_ty> & BoundingBox2d<T_ty>::operator = (const BoundingBox2d<T_ty> & rhs)
+BoundingBox2d<T_ty> BoundingBox2d<T_ty>::fromPoints(const T_ty * x, const T_ty * y, const std::size_t count)
 {
-    pos = rhs.pos;
-    radius = rhs.radius;
-    return *this;
+    if (count == 0)
+        return BoundingBox2d<T_ty>();
+
+    Vector2d<T_ty> minCorner(x[0], y[0]), maxCorner(x[0], y[0]);
+    kernels::expandBounds(x + 1, y + 1, count - 1, minCorner, maxCorner);
+    return fromCorners(minCorner, maxCorner);
 }
 
+//------------------------------------------------------------------------------
+// Operators.
+
 template <typename T_ty>
-bool BoundingBox2d<T_ty>::operator == (const BoundingBox2d<T_ty> & rhs) const
+constexpr bool BoundingBox2d<T_ty>::operator == (const BoundingBox2d<T_ty> & rhs) const
 {
     return pos == rhs.pos && radius == rhs.radius;
 }
 
 template <typename T_ty>
-bool BoundingBox2d<T_ty>::operator != (const BoundingBox2d<T_ty> & rhs) const
+constexpr bool BoundingBox2d<T_ty>::operator != (const BoundingBox2d<T_ty> & rhs) const
 {
     return !(*this == rhs);
 }
@@ -91,39 +152,39 @@ bool BoundingBox2d<T_ty>::operator != (const BoundingBox2d<T_ty> & rhs) const
 // Accessors / operations.
 
 template <typename T_ty>
-void BoundingBox2d<T_ty>::set(const Vector2d<T_ty> & pos, const Vector2d<T_ty> & size)
+AIL_MATH_CONSTEXPR14 void BoundingBox2d<T_ty>::set(const Vector2d<T_ty> & pos, const Vector2d<T_ty> & radius)
 {
     this->pos = pos;
     this->radius = radius;
 }
 
 template <typename T_ty>
-void BoundingBox2d<T_ty>::set(const T_ty posX, const T_ty posY, const T_ty radiusX, const T_ty radiusY)
+AIL_MATH_CONSTEXPR14 void BoundingBox2d<T_ty>::set(const T_ty posX, const T_ty posY, const T_ty radiusX, const T_ty radiusY)
 {
     pos.set(posX, posY);
     radius.set(radiusX, radiusY);
 }
 
 template <typename T_ty>
-Vector2d<T_ty> BoundingBox2d<T_ty>::getCornerX1Y1() const
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> BoundingBox2d<T_ty>::getCornerX1Y1() const
 {
     return pos - radius;
 }
 
 template <typename T_ty>
-Vector2d<T_ty> BoundingBox2d<T_ty>::getCornerX2Y2() const
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> BoundingBox2d<T_ty>::getCornerX2Y2() const
 {
     return pos + radius;
 }
 
 template <typename T_ty>
-Vector2d<T_ty> BoundingBox2d<T_ty>::getCornerX1Y2() const
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> BoundingBox2d<T_ty>::getCornerX1Y2() const
 {
     return Vector2d<T_ty>(pos.x - radius.x, pos.y + radius.y);
 }
 
 template <typename T_ty>
-Vector2d<T_ty> BoundingBox2d<T_ty>::getCornerX2Y1() const
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> BoundingBox2d<T_ty>::getCornerX2Y1() const
 {
     return Vector2d<T_ty>(pos.x + radius.x, pos.y - radius.y);
 }
@@ -149,6 +210,23 @@ bool BoundingBox2d<T_ty>::intersects(const BoundingBox2d<T_ty> &rhs) const
         std::fabs(pos.y - rhs.pos.y) <= (radius.y + rhs.radius.y);
 }
 
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+
+/// Instantiates BoundingBox2d for one type.
+/// T_prefix is "template" for an instantiation definition (see src/math/BoundingBox2d.cpp),
+///  or "extern template" for a declaration.
+#define AIL_MATH_INSTANTIATE_BOUNDINGBOX2D(T_prefix, T_type) \
+    T_prefix class BoundingBox2d<T_type>;
+
+// See AIL_MATH_EXTERN_TEMPLATES in Vector2d.inl.
+#if defined(AIL_MATH_EXTERN_TEMPLATES)
+AIL_MATH_INSTANTIATE_BOUNDINGBOX2D(extern template, float)
+AIL_MATH_INSTANTIATE_BOUNDINGBOX2D(extern template, double)
+AIL_MATH_INSTANTIATE_BOUNDINGBOX2D(extern template, std::int32_t)
+AIL_MATH_INSTANTIATE_BOUNDINGBOX2D(extern template, std::int64_t)
+#endif
+
 //--------------
 } // math
 } // ail
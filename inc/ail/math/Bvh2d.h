@@ -0,0 +1,213 @@
+#ifndef ail_math_Bvh2d_h
+#define ail_math_Bvh2d_h
+
+/** \file Bvh2d.h
+    \brief Declares a bounding volume hierarchy of 2d boxes. See Bvh2d.inl for implementation.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "BoundingBox2d.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/** A bounding volume hierarchy (BVH) over a set of axis-aligned boxes.
+This is intended for large amounts of static or slowly changing content, such as
+ level geometry, which is queried much more often than it changes.
+The tree is built in one go from an array of boxes. Each box is identified by
+ its index in that array. Nodes are split using the surface area heuristic
+ (which measures perimeter in 2d), evaluated over a fixed number of bins.
+Nodes are stored in a single array in depth-first order, so the first child of
+ a node immediately follows it. Boxes are copied into the same order as the
+ leaves, so a query touches memory mostly in sequence.
+If the boxes move a little, refit() updates the node bounds without changing the
+ structure of the tree. That is much cheaper than rebuilding, but query
+ performance degrades as the boxes move further from where they were built.
+Box and point queries give exactly the same results as calling
+ BoundingBox2d::intersects() or BoundingBox2d::contains() on every box.
+Ray queries are only meaningful for floating point types.
+Template parameter gives the underlying numerical type (e.g. float or double).
+*/
+template <typename T_ty>
+class Bvh2d
+{
+public:
+    /// An index value which never refers to a box.
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    /// Maximum depth of the tree. Nodes at this depth are not split any further.
+    static const std::size_t maxDepth = 48;
+
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - creates an empty tree.
+    /// maxLeafSize is the number of boxes a leaf can hold before splitting is considered.
+    /// Throws std::invalid_argument if maxLeafSize is 0.
+    explicit Bvh2d(const std::size_t maxLeafSize = 4);
+
+    /// Constructor - builds a tree from an array of boxes.
+    /// Throws std::invalid_argument if maxLeafSize is 0, or std::length_error
+    ///  if there are too many boxes.
+    Bvh2d(const BoundingBox2d<T_ty> * boxes, const std::size_t count, const std::size_t maxLeafSize = 4);
+
+
+//------------------------------------------------------------------------------
+// Modifiers.
+
+    /// Replace the contents of the tree with the given array of boxes.
+    /// Throws std::length_error if count doesn't fit in 32 bits.
+    void build(const BoundingBox2d<T_ty> * boxes, const std::size_t count);
+
+    /// Update the tree for new positions or sizes of the same boxes.
+    /// The boxes must be given in the same order as when the tree was built.
+    /// Throws std::invalid_argument if count differs from the number of boxes in the tree.
+    void refit(const BoundingBox2d<T_ty> * boxes, const std::size_t count);
+
+    /// Remove all boxes. This keeps the allocated storage.
+    void clear();
+
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+    /// Get the number of boxes in the tree.
+    std::size_t size() const;
+
+    /// Check if the tree has no boxes.
+    bool empty() const;
+
+    /// Get the number of nodes in the tree.
+    std::size_t getNodeCount() const;
+
+    /// Get the maximum number of boxes a leaf can hold before splitting is considered.
+    std::size_t getMaxLeafSize() const;
+
+    /// Get a box, given its index in the array the tree was built from.
+    const BoundingBox2d<T_ty> & getBox(const std::size_t index) const;
+
+
+//------------------------------------------------------------------------------
+// Queries.
+// These append the indices of matching boxes to the output container, without
+//  clearing it first. The order of the results is unspecified.
+
+    /// Find all boxes which intersect the given box, as determined by BoundingBox2d::intersects().
+    void queryBox(const BoundingBox2d<T_ty> & box, std::vector<std::size_t> & output) const;
+
+    /// Find all boxes which contain the given point, as determined by BoundingBox2d::contains().
+    void queryPoint(const Vector2d<T_ty> & point, std::vector<std::size_t> & output) const;
+
+    /// Find all boxes hit by a ray, i.e. the points origin + (direction * t) for 0 <= t <= maxT.
+    /// The direction doesn't need to be normalised. A ray starting inside a box hits it.
+    void queryRay(const Vector2d<T_ty> & origin, const Vector2d<T_ty> & direction, const T_ty maxT, std::vector<std::size_t> & output) const;
+
+    /// Find the first box hit by a ray, i.e. the points origin + (direction * t) for 0 <= t <= maxT.
+    /// Returns the index of the box, and sets hitT to the value of t where the
+    ///  ray enters it. If several boxes are hit at the same t, the one with the
+    ///  lowest index is returned. Returns npos if nothing is hit.
+    std::size_t raycast(const Vector2d<T_ty> & origin, const Vector2d<T_ty> & direction, const T_ty maxT, T_ty & hitT) const;
+
+
+private:
+//------------------------------------------------------------------------------
+// Internal types.
+
+    /// A node of the tree.
+    struct Node
+    {
+        /// Corner of the node's bounds with the lowest coordinates.
+        Vector2d<T_ty> min;
+        /// Corner of the node's bounds with the highest coordinates.
+        Vector2d<T_ty> max;
+        /// For a leaf, the position of its first box in m_boxes.
+        /// Otherwise, the index of the second child. The first child is always
+        ///  the next node in the array.
+        std::uint32_t offset;
+        /// Number of boxes in a leaf, or 0 for other nodes.
+        std::uint32_t count;
+    };
+
+    /// A node waiting to be built.
+    struct BuildTask
+    {
+        /// If this node is the second child of another node, this is the index
+        ///  of that node (so it can be told where its second child is).
+        ///  Otherwise, it's npos.
+        std::size_t parent;
+        /// Start of the node's range of boxes in m_indices.
+        std::size_t begin;
+        /// End of the node's range of boxes in m_indices.
+        std::size_t end;
+        /// Depth of the node, where the root is 0.
+        std::size_t depth;
+    };
+
+    /// Number of bins used to evaluate the surface area heuristic.
+    static const std::size_t binCount = 16;
+
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+    /// Get the bounds of a box, padded outwards slightly so that rounding can't
+    ///  make a node appear to miss a box which BoundingBox2d::intersects() would hit.
+    static void getPaddedBounds(const BoundingBox2d<T_ty> & box, Vector2d<T_ty> & min, Vector2d<T_ty> & max);
+
+    /// Check if a node's bounds overlap the given region.
+    static bool overlaps(const Node & node, const Vector2d<T_ty> & min, const Vector2d<T_ty> & max);
+
+    /// Clip a ray to the given region, narrowing the range of t.
+    /// Returns false if the ray misses the region.
+    static bool clipRay(const Vector2d<T_ty> & min, const Vector2d<T_ty> & max, const Vector2d<T_ty> & origin, const Vector2d<T_ty> & direction, const Vector2d<T_ty> & invDirection, T_ty & tMin, T_ty & tMax);
+
+    /// Create a node for a range of boxes, and decide whether to split it.
+    /// Returns true if the node was split. On return, m_indices is partitioned
+    ///  so that the first child covers [begin, mid) and the second covers [mid, end).
+    bool buildNode(const BoundingBox2d<T_ty> * boxes, const std::size_t begin, const std::size_t end, const std::size_t depth, std::size_t & mid);
+
+    /// Recalculate the bounds of every node from the stored boxes.
+    void updateBounds();
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// Maximum number of boxes in a leaf before splitting is considered.
+    std::size_t m_maxLeafSize;
+
+    /// Nodes in depth-first order. Node 0 is the root.
+    std::vector<Node> m_nodes;
+
+    /// Copies of the boxes, in the order they appear in the leaves.
+    std::vector<BoundingBox2d<T_ty>> m_boxes;
+
+    /// Original index of each box in m_boxes.
+    std::vector<std::uint32_t> m_indices;
+
+    /// Position of each box in m_boxes, by original index.
+    std::vector<std::uint32_t> m_positions;
+
+    /// Scratch space for building: padded minimum corner of each box, by original index.
+    std::vector<Vector2d<T_ty>> m_buildMin;
+
+    /// Scratch space for building: padded maximum corner of each box, by original index.
+    std::vector<Vector2d<T_ty>> m_buildMax;
+};
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Bvh2d_h
@@ -0,0 +1,559 @@
+#ifndef ail_math_Bvh2d_inl
+#define ail_math_Bvh2d_inl
+
+/** \file Bvh2d.inl
+    \brief Implementation for a bounding volume hierarchy of 2d boxes (see Bvh2d.h).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "Bvh2d.h"
+#include "BoundingBox2d.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+template <typename T_ty>
+const std::size_t Bvh2d<T_ty>::npos;
+
+template <typename T_ty>
+const std::size_t Bvh2d<T_ty>::maxDepth;
+
+template <typename T_ty>
+const std::size_t Bvh2d<T_ty>::binCount;
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+template <typename T_ty>
+Bvh2d<T_ty>::Bvh2d(const std::size_t maxLeafSize) :
+    m_maxLeafSize(maxLeafSize),
+    m_nodes(),
+    m_boxes(),
+    m_indices(),
+    m_positions(),
+    m_buildMin(),
+    m_buildMax()
+{
+    if (maxLeafSize == 0)
+        throw std::invalid_argument("BVH leaves must be able to hold at least 1 box.");
+}
+
+template <typename T_ty>
+Bvh2d<T_ty>::Bvh2d(const BoundingBox2d<T_ty> * boxes, const std::size_t count, const std::size_t maxLeafSize) :
+    Bvh2d(maxLeafSize)
+{
+    build(boxes, count);
+}
+
+//------------------------------------------------------------------------------
+// Modifiers.
+
+template <typename T_ty>
+void Bvh2d<T_ty>::build(const BoundingBox2d<T_ty> * boxes, const std::size_t count)
+{
+    if (count > std::numeric_limits<std::uint32_t>::max())
+        throw std::length_error("Too many boxes for a BVH.");
+
+    clear();
+    if (count == 0)
+        return;
+
+    m_indices.resize(count);
+    m_buildMin.resize(count);
+    m_buildMax.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        m_indices[i] = static_cast<std::uint32_t>(i);
+        getPaddedBounds(boxes[i], m_buildMin[i], m_buildMax[i]);
+    }
+
+    // Nodes are built depth first. The first child of each node is built
+    //  straight away, so that it immediately follows its parent. The second
+    //  child waits on the stack, and its parent is told where it is when it
+    //  finally gets built.
+    std::vector<BuildTask> stack;
+    const BuildTask root = { npos, 0, count, 0 };
+    stack.push_back(root);
+    while (!stack.empty()) {
+        const BuildTask task = stack.back();
+        stack.pop_back();
+
+        if (task.parent != npos)
+            m_nodes[task.parent].offset = static_cast<std::uint32_t>(m_nodes.size());
+
+        const std::size_t node = m_nodes.size();
+        std::size_t mid = 0;
+        if (buildNode(boxes, task.begin, task.end, task.depth, mid)) {
+            const BuildTask second = { node, mid, task.end, task.depth + 1 };
+            const BuildTask first = { npos, task.begin, mid, task.depth + 1 };
+            stack.push_back(second);
+            stack.push_back(first);
+        }
+    }
+
+    // Store the boxes in the order they appear in the leaves.
+    m_boxes.resize(count);
+    m_positions.resize(count);
+    for (std::size_t k = 0; k < count; ++k) {
+        m_boxes[k] = boxes[m_indices[k]];
+        m_positions[m_indices[k]] = static_cast<std::uint32_t>(k);
+    }
+}
+
+template <typename T_ty>
+void Bvh2d<T_ty>::refit(const BoundingBox2d<T_ty> * boxes, const std::size_t count)
+{
+    if (count != m_boxes.size())
+        throw std::invalid_argument("BVH can only be refitted with the same number of boxes.");
+
+    for (std::size_t k = 0; k < count; ++k)
+        m_boxes[k] = boxes[m_indices[k]];
+    updateBounds();
+}
+
+template <typename T_ty>
+void Bvh2d<T_ty>::clear()
+{
+    m_nodes.clear();
+    m_boxes.clear();
+    m_indices.clear();
+    m_positions.clear();
+}
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+template <typename T_ty>
+std::size_t Bvh2d<T_ty>::size() const
+{
+    return m_boxes.size();
+}
+
+template <typename T_ty>
+bool Bvh2d<T_ty>::empty() const
+{
+    return m_boxes.empty();
+}
+
+template <typename T_ty>
+std::size_t Bvh2d<T_ty>::getNodeCount() const
+{
+    return m_nodes.size();
+}
+
+template <typename T_ty>
+std::size_t Bvh2d<T_ty>::getMaxLeafSize() const
+{
+    return m_maxLeafSize;
+}
+
+template <typename T_ty>
+const BoundingBox2d<T_ty> & Bvh2d<T_ty>::getBox(const std::size_t index) const
+{
+    assert(index < m_positions.size());
+    return m_boxes[m_positions[index]];
+}
+
+//------------------------------------------------------------------------------
+// Queries.
+
+template <typename T_ty>
+void Bvh2d<T_ty>::queryBox(const BoundingBox2d<T_ty> & box, std::vector<std::size_t> & output) const
+{
+    if (m_nodes.empty())
+        return;
+
+    Vector2d<T_ty> min, max;
+    getPaddedBounds(box, min, max);
+
+    // Depth is limited, so the stack can never hold more than maxDepth + 1 nodes.
+    std::uint32_t stack[maxDepth + 1];
+    std::size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const std::uint32_t index = stack[--top];
+        const Node & node = m_nodes[index];
+        if (!overlaps(node, min, max))
+            continue;
+
+        if (node.count > 0) {
+            for (std::size_t k = node.offset; k < node.offset + node.count; ++k) {
+                if (m_boxes[k].intersects(box))
+                    output.push_back(m_indices[k]);
+            }
+        } else {
+            stack[top++] = node.offset;
+            stack[top++] = index + 1;
+        }
+    }
+}
+
+template <typename T_ty>
+void Bvh2d<T_ty>::queryPoint(const Vector2d<T_ty> & point, std::vector<std::size_t> & output) const
+{
+    if (m_nodes.empty())
+        return;
+
+    std::uint32_t stack[maxDepth + 1];
+    std::size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const std::uint32_t index = stack[--top];
+        const Node & node = m_nodes[index];
+        if (!overlaps(node, point, point))
+            continue;
+
+        if (node.count > 0) {
+            for (std::size_t k = node.offset; k < node.offset + node.count; ++k) {
+                if (m_boxes[k].contains(point))
+                    output.push_back(m_indices[k]);
+            }
+        } else {
+            stack[top++] = node.offset;
+            stack[top++] = index + 1;
+        }
+    }
+}
+
+template <typename T_ty>
+void Bvh2d<T_ty>::queryRay(const Vector2d<T_ty> & origin, const Vector2d<T_ty> & direction, const T_ty maxT, std::vector<std::size_t> & output) const
+{
+    if (m_nodes.empty())
+        return;
+
+    const Vector2d<T_ty> invDirection(
+        (direction.x != T_ty(0)) ? T_ty(1) / direction.x : T_ty(0),
+        (direction.y != T_ty(0)) ? T_ty(1) / direction.y : T_ty(0));
+
+    std::uint32_t stack[maxDepth + 1];
+    std::size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const std::uint32_t index = stack[--top];
+        const Node & node = m_nodes[index];
+        T_ty tMin = T_ty(0), tMax = maxT;
+        if (!clipRay(node.min, node.max, origin, direction, invDirection, tMin, tMax))
+            continue;
+
+        if (node.count > 0) {
+            for (std::size_t k = node.offset; k < node.offset + node.count; ++k) {
+                const BoundingBox2d<T_ty> & box = m_boxes[k];
+                tMin = T_ty(0);
+                tMax = maxT;
+                if (clipRay(box.getCornerX1Y1(), box.getCornerX2Y2(), origin, direction, invDirection, tMin, tMax))
+                    output.push_back(m_indices[k]);
+            }
+        } else {
+            stack[top++] = node.offset;
+            stack[top++] = index + 1;
+        }
+    }
+}
+
+template <typename T_ty>
+std::size_t Bvh2d<T_ty>::raycast(const Vector2d<T_ty> & origin, const Vector2d<T_ty> & direction, const T_ty maxT, T_ty & hitT) const
+{
+    std::size_t result = npos;
+    if (m_nodes.empty())
+        return result;
+
+    const Vector2d<T_ty> invDirection(
+        (direction.x != T_ty(0)) ? T_ty(1) / direction.x : T_ty(0),
+        (direction.y != T_ty(0)) ? T_ty(1) / direction.y : T_ty(0));
+
+    // Each node on the stack is stored with the value of t where the ray enters
+    //  it, so it can be skipped if something nearer has been hit in the meantime.
+    struct Entry
+    {
+        std::uint32_t node;
+        T_ty t;
+    };
+    Entry stack[maxDepth + 1];
+    std::size_t top = 0;
+
+    T_ty bestT = maxT;
+    T_ty tMin = T_ty(0), tMax = bestT;
+    if (!clipRay(m_nodes[0].min, m_nodes[0].max, origin, direction, invDirection, tMin, tMax))
+        return result;
+    const Entry root = { 0, tMin };
+    stack[top++] = root;
+
+    while (top > 0) {
+        const Entry entry = stack[--top];
+        if (entry.t > bestT)
+            continue;
+
+        const Node & node = m_nodes[entry.node];
+        if (node.count > 0) {
+            for (std::size_t k = node.offset; k < node.offset + node.count; ++k) {
+                const BoundingBox2d<T_ty> & box = m_boxes[k];
+                tMin = T_ty(0);
+                tMax = bestT;
+                if (clipRay(box.getCornerX1Y1(), box.getCornerX2Y2(), origin, direction, invDirection, tMin, tMax) &&
+                    (result == npos || tMin < bestT || (tMin == bestT && m_indices[k] < result))) {
+                    bestT = tMin;
+                    result = m_indices[k];
+                }
+            }
+            continue;
+        }
+
+        // Visit the nearer child first, so more of the tree can be skipped.
+        const Entry children[2] = { { entry.node + 1, T_ty(0) }, { node.offset, T_ty(0) } };
+        bool hits[2];
+        Entry clipped[2];
+        for (int c = 0; c < 2; ++c) {
+            tMin = T_ty(0);
+            tMax = bestT;
+            hits[c] = clipRay(m_nodes[children[c].node].min, m_nodes[children[c].node].max, origin, direction, invDirection, tMin, tMax);
+            clipped[c].node = children[c].node;
+            clipped[c].t = tMin;
+        }
+
+        const int nearer = (hits[1] && (!hits[0] || clipped[1].t < clipped[0].t)) ? 1 : 0;
+        if (hits[1 - nearer])
+            stack[top++] = clipped[1 - nearer];
+        if (hits[nearer])
+            stack[top++] = clipped[nearer];
+    }
+
+    if (result != npos)
+        hitT = bestT;
+    return result;
+}
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+template <typename T_ty>
+void Bvh2d<T_ty>::getPaddedBounds(const BoundingBox2d<T_ty> & box, Vector2d<T_ty> & min, Vector2d<T_ty> & max)
+{
+    // Negative radii are allowed, so the corners could be either way round.
+    const Vector2d<T_ty> a = box.getCornerX1Y1();
+    const Vector2d<T_ty> b = box.getCornerX2Y2();
+    min.set(std::min(a.x, b.x), std::min(a.y, b.y));
+    max.set(std::max(a.x, b.x), std::max(a.y, b.y));
+
+    // BoundingBox2d::intersects() compares the distance between the centres
+    //  with the sum of the radii. Rounding errors in that calculation are a few
+    //  units in the last place of the values involved, so padding by a little
+    //  more than that covers every case. Integers don't need padding.
+    const T_ty scale = std::numeric_limits<T_ty>::epsilon() * T_ty(4);
+    const T_ty padX = scale * ((box.pos.x < T_ty(0) ? -box.pos.x : box.pos.x) + (box.radius.x < T_ty(0) ? -box.radius.x : box.radius.x));
+    const T_ty padY = scale * ((box.pos.y < T_ty(0) ? -box.pos.y : box.pos.y) + (box.radius.y < T_ty(0) ? -box.radius.y : box.radius.y));
+    min.x -= padX;
+    min.y -= padY;
+    max.x += padX;
+    max.y += padY;
+}
+
+template <typename T_ty>
+bool Bvh2d<T_ty>::overlaps(const Node & node, const Vector2d<T_ty> & min, const Vector2d<T_ty> & max)
+{
+    return
+        node.min.x <= max.x &&
+        node.min.y <= max.y &&
+        node.max.x >= min.x &&
+        node.max.y >= min.y;
+}
+
+template <typename T_ty>
+bool Bvh2d<T_ty>::clipRay(const Vector2d<T_ty> & min, const Vector2d<T_ty> & max, const Vector2d<T_ty> & origin, const Vector2d<T_ty> & direction, const Vector2d<T_ty> & invDirection, T_ty & tMin, T_ty & tMax)
+{
+    // A box with a negative radius doesn't cover any points.
+    if (max.x < min.x || max.y < min.y)
+        return false;
+
+    // A ray parallel to an axis can only hit if it starts between the two sides.
+    // Otherwise, find where the ray crosses each side (i.e. the slab method).
+    if (direction.x == T_ty(0)) {
+        if (origin.x < min.x || origin.x > max.x)
+            return false;
+    } else {
+        T_ty t1 = (min.x - origin.x) * invDirection.x;
+        T_ty t2 = (max.x - origin.x) * invDirection.x;
+        if (t1 > t2)
+            std::swap(t1, t2);
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+    }
+
+    if (direction.y == T_ty(0)) {
+        if (origin.y < min.y || origin.y > max.y)
+            return false;
+    } else {
+        T_ty t1 = (min.y - origin.y) * invDirection.y;
+        T_ty t2 = (max.y - origin.y) * invDirection.y;
+        if (t1 > t2)
+            std::swap(t1, t2);
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+    }
+
+    return tMin <= tMax;
+}
+
+template <typename T_ty>
+bool Bvh2d<T_ty>::buildNode(const BoundingBox2d<T_ty> * boxes, const std::size_t begin, const std::size_t end, const std::size_t depth, std::size_t & mid)
+{
+    // Find the bounds of the node, and of the centres of its boxes.
+    Node node;
+    node.min = m_buildMin[m_indices[begin]];
+    node.max = m_buildMax[m_indices[begin]];
+    double centreMin[2] = { static_cast<double>(boxes[m_indices[begin]].pos.x), static_cast<double>(boxes[m_indices[begin]].pos.y) };
+    double centreMax[2] = { centreMin[0], centreMin[1] };
+    for (std::size_t i = begin + 1; i < end; ++i) {
+        const std::uint32_t index = m_indices[i];
+        node.min.set(std::min(node.min.x, m_buildMin[index].x), std::min(node.min.y, m_buildMin[index].y));
+        node.max.set(std::max(node.max.x, m_buildMax[index].x), std::max(node.max.y, m_buildMax[index].y));
+
+        const double centre[2] = { static_cast<double>(boxes[index].pos.x), static_cast<double>(boxes[index].pos.y) };
+        for (int axis = 0; axis < 2; ++axis) {
+            centreMin[axis] = std::min(centreMin[axis], centre[axis]);
+            centreMax[axis] = std::max(centreMax[axis], centre[axis]);
+        }
+    }
+
+    const std::size_t count = end - begin;
+    node.offset = static_cast<std::uint32_t>(begin);
+    node.count = static_cast<std::uint32_t>(count);
+    m_nodes.push_back(node);
+
+    if (count <= m_maxLeafSize || depth >= maxDepth)
+        return false;
+
+    // Sort the boxes into bins by their centres, along each axis in turn.
+    // Each boundary between bins is a candidate split. Its cost is the
+    //  perimeter of the boxes on each side, weighted by the number of them.
+    struct Bin
+    {
+        std::size_t count;
+        double min[2];
+        double max[2];
+    };
+
+    double bestCost = std::numeric_limits<double>::max();
+    int bestAxis = -1;
+    std::size_t bestSplit = 0;
+    for (int axis = 0; axis < 2; ++axis) {
+        const double extent = centreMax[axis] - centreMin[axis];
+        if (!(extent > 0.0))
+            continue;
+        const double scale = static_cast<double>(binCount) / extent;
+
+        Bin bins[binCount];
+        for (std::size_t b = 0; b < binCount; ++b) {
+            bins[b].count = 0;
+            bins[b].min[0] = bins[b].min[1] = std::numeric_limits<double>::max();
+            bins[b].max[0] = bins[b].max[1] = -std::numeric_limits<double>::max();
+        }
+
+        for (std::size_t i = begin; i < end; ++i) {
+            const std::uint32_t index = m_indices[i];
+            const double centre = static_cast<double>(axis == 0 ? boxes[index].pos.x : boxes[index].pos.y);
+            Bin & bin = bins[std::min(binCount - 1, static_cast<std::size_t>((centre - centreMin[axis]) * scale))];
+            ++bin.count;
+            bin.min[0] = std::min(bin.min[0], static_cast<double>(m_buildMin[index].x));
+            bin.min[1] = std::min(bin.min[1], static_cast<double>(m_buildMin[index].y));
+            bin.max[0] = std::max(bin.max[0], static_cast<double>(m_buildMax[index].x));
+            bin.max[1] = std::max(bin.max[1], static_cast<double>(m_buildMax[index].y));
+        }
+
+        // Sweep from the right to find the cost of everything above each boundary.
+        double rightCost[binCount];
+        Bin right = bins[binCount - 1];
+        rightCost[binCount - 1] = static_cast<double>(right.count) * ((right.max[0] - right.min[0]) + (right.max[1] - right.min[1]));
+        for (std::size_t b = binCount - 1; b > 1; --b) {
+            const Bin & bin = bins[b - 1];
+            right.count += bin.count;
+            for (int a = 0; a < 2; ++a) {
+                right.min[a] = std::min(right.min[a], bin.min[a]);
+                right.max[a] = std::max(right.max[a], bin.max[a]);
+            }
+            rightCost[b - 1] = static_cast<double>(right.count) * ((right.max[0] - right.min[0]) + (right.max[1] - right.min[1]));
+        }
+
+        // Sweep from the left, splitting before bin b.
+        Bin left = bins[0];
+        for (std::size_t b = 1; b < binCount; ++b) {
+            if (b > 1) {
+                const Bin & bin = bins[b - 1];
+                left.count += bin.count;
+                for (int a = 0; a < 2; ++a) {
+                    left.min[a] = std::min(left.min[a], bin.min[a]);
+                    left.max[a] = std::max(left.max[a], bin.max[a]);
+                }
+            }
+            if (left.count == 0 || left.count == count)
+                continue;
+
+            const double cost = static_cast<double>(left.count) * ((left.max[0] - left.min[0]) + (left.max[1] - left.min[1])) + rightCost[b];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = b;
+            }
+        }
+    }
+
+    // The node won't be a leaf, so it doesn't hold any boxes itself.
+    m_nodes.back().count = 0;
+
+    if (bestAxis < 0) {
+        // All the boxes have the same centre, so the heuristic can't separate
+        //  them. Split them in half arbitrarily, to keep the leaves small.
+        mid = begin + (count / 2);
+        return true;
+    }
+
+    const double scale = static_cast<double>(binCount) / (centreMax[bestAxis] - centreMin[bestAxis]);
+    const double splitMin = centreMin[bestAxis];
+    mid = static_cast<std::size_t>(std::partition(m_indices.begin() + begin, m_indices.begin() + end,
+        [&](const std::uint32_t index) {
+            const double centre = static_cast<double>(bestAxis == 0 ? boxes[index].pos.x : boxes[index].pos.y);
+            return std::min(binCount - 1, static_cast<std::size_t>((centre - splitMin) * scale)) < bestSplit;
+        }) - m_indices.begin());
+    return true;
+}
+
+template <typename T_ty>
+void Bvh2d<T_ty>::updateBounds()
+{
+    // Children always come after their parents, so working backwards means
+    //  each node's children are updated before the node itself.
+    for (std::size_t n = m_nodes.size(); n > 0; --n) {
+        Node & node = m_nodes[n - 1];
+        if (node.count > 0) {
+            getPaddedBounds(m_boxes[node.offset], node.min, node.max);
+            for (std::size_t k = node.offset + 1; k < node.offset + node.count; ++k) {
+                Vector2d<T_ty> min, max;
+                getPaddedBounds(m_boxes[k], min, max);
+                node.min.set(std::min(node.min.x, min.x), std::min(node.min.y, min.y));
+                node.max.set(std::max(node.max.x, max.x), std::max(node.max.y, max.y));
+            }
+        } else {
+            const Node & first = m_nodes[n];
+            const Node & second = m_nodes[node.offset];
+            node.min.set(std::min(first.min.x, second.min.x), std::min(first.min.y, second.min.y));
+            node.max.set(std::max(first.max.x, second.max.x), std::max(first.max.y, second.max.y));
+        }
+    }
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Bvh2d_inl
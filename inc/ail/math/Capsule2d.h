@@ -0,0 +1,121 @@
+#ifndef ail_math_Capsule2d_h
+#define ail_math_Capsule2d_h
+
+/** \file Capsule2d.h
+    \brief Declares a 2d capsule, with narrow phase collision tests. See Capsule2d.inl for implementation.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <type_traits>
+#include "BoundingBox2d.h"
+#include "Contact2d.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+template <typename T_ty> class Circle2d;
+template <typename T_ty> class OrientedBox2d;
+
+/** A capsule, which is every point within a given radius of a line segment.
+This is a rectangle with semicircular ends, which is a common shape for
+ characters because it slides smoothly over steps and corners. If the start
+ and end are the same, it's a circle.
+The collision tests work with Circle2d and OrientedBox2d too. They're all done
+ by the same separating axis test, without allocating any memory (see
+ Contact2d.inl). Touching counts as an intersection.
+Like Vector2d, the class is trivially copyable and can be constructed at compile time.
+Template parameter gives the underlying numerical type, which must be floating point.
+*/
+template <typename T_ty>
+class Capsule2d
+{
+public:
+    static_assert(std::is_floating_point<T_ty>::value, "Capsule2d is only supported for floating point types.");
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - initialises everything to 0.
+    constexpr Capsule2d();
+
+    /// Constructor - explicitly initialises the centres of the two ends, and the radius.
+    constexpr Capsule2d(const Vector2d<T_ty> & start, const Vector2d<T_ty> & end, const T_ty radius);
+
+
+//------------------------------------------------------------------------------
+// Operators.
+
+    /// Equality test.
+    /// Note that this tests for exact equality, which isn't usually desirable for
+    ///  floating point types.
+    constexpr bool operator == (const Capsule2d<T_ty> & rhs) const;
+
+    /// Inequality test.
+    /// Note that this tests for (lack of) exact equality, which isn't usually
+    ///  desirable for floating point types.
+    constexpr bool operator != (const Capsule2d<T_ty> & rhs) const;
+
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+    /// Get the smallest axis-aligned box which contains the capsule.
+    BoundingBox2d<T_ty> getBounds() const;
+
+    /// Get the point on the capsule's central segment which is closest to the given point.
+    Vector2d<T_ty> getClosestPoint(const Vector2d<T_ty> & point) const;
+
+
+//------------------------------------------------------------------------------
+// Tests.
+
+    /// Check if the given point is inside (or on the edge of) the capsule.
+    bool contains(const Vector2d<T_ty> & point) const;
+
+    /// Check if this capsule intersects a circle.
+    bool intersects(const Circle2d<T_ty> & other) const;
+
+    /// Check if this capsule intersects another capsule.
+    bool intersects(const Capsule2d<T_ty> & other) const;
+
+    /// Check if this capsule intersects an oriented box.
+    bool intersects(const OrientedBox2d<T_ty> & other) const;
+
+    /// Check if this capsule intersects a circle, and get the contact manifold.
+    /// The contact is only set if they intersect. Its normal points from this capsule to the circle.
+    bool getContact(const Circle2d<T_ty> & other, Contact2d<T_ty> & contact) const;
+
+    /// Check if this capsule intersects another capsule, and get the contact manifold.
+    /// The contact is only set if they intersect. Its normal points from this capsule to the other one.
+    bool getContact(const Capsule2d<T_ty> & other, Contact2d<T_ty> & contact) const;
+
+    /// Check if this capsule intersects an oriented box, and get the contact manifold.
+    /// The contact is only set if they intersect. Its normal points from this capsule to the box.
+    bool getContact(const OrientedBox2d<T_ty> & other, Contact2d<T_ty> & contact) const;
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// Centre of the semicircle at one end.
+    Vector2d<T_ty> start;
+
+    /// Centre of the semicircle at the other end.
+    Vector2d<T_ty> end;
+
+    /// Distance from the central segment to the edge.
+    T_ty radius;
+};
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Capsule2d_h
@@ -0,0 +1,119 @@
+#ifndef ail_math_Capsule2d_inl
+#define ail_math_Capsule2d_inl
+
+/** \file Capsule2d.inl
+    \brief Implementation for a 2d capsule (see Capsule2d.h).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "BoundingBox2d.inl"
+#include "Capsule2d.h"
+#include "Contact2d.inl"
+#include "Vector2d.inl"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+template <typename T_ty>
+constexpr Capsule2d<T_ty>::Capsule2d() :
+    start(), end(), radius(0)
+{
+}
+
+template <typename T_ty>
+constexpr Capsule2d<T_ty>::Capsule2d(const Vector2d<T_ty> & start, const Vector2d<T_ty> & end, const T_ty radius) :
+    start(start), end(end), radius(radius)
+{
+}
+
+//------------------------------------------------------------------------------
+// Operators.
+
+template <typename T_ty>
+constexpr bool Capsule2d<T_ty>::operator == (const Capsule2d<T_ty> & rhs) const
+{
+    return start == rhs.start && end == rhs.end && radius == rhs.radius;
+}
+
+template <typename T_ty>
+constexpr bool Capsule2d<T_ty>::operator != (const Capsule2d<T_ty> & rhs) const
+{
+    return !(*this == rhs);
+}
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+template <typename T_ty>
+BoundingBox2d<T_ty> Capsule2d<T_ty>::getBounds() const
+{
+    return BoundingBox2d<T_ty>::fromCorners(
+        Vector2d<T_ty>(((start.x < end.x) ? start.x : end.x) - radius, ((start.y < end.y) ? start.y : end.y) - radius),
+        Vector2d<T_ty>(((start.x > end.x) ? start.x : end.x) + radius, ((start.y > end.y) ? start.y : end.y) + radius));
+}
+
+template <typename T_ty>
+Vector2d<T_ty> Capsule2d<T_ty>::getClosestPoint(const Vector2d<T_ty> & point) const
+{
+    return contact2d::closestOnSegment(point, start, end);
+}
+
+//------------------------------------------------------------------------------
+// Tests.
+
+template <typename T_ty>
+bool Capsule2d<T_ty>::contains(const Vector2d<T_ty> & point) const
+{
+    return getClosestPoint(point).getSqDistance(point) <= radius * radius;
+}
+
+template <typename T_ty>
+bool Capsule2d<T_ty>::intersects(const Circle2d<T_ty> & other) const
+{
+    return contact2d::overlap(contact2d::makeCore(*this), contact2d::makeCore(other));
+}
+
+template <typename T_ty>
+bool Capsule2d<T_ty>::intersects(const Capsule2d<T_ty> & other) const
+{
+    return contact2d::overlap(contact2d::makeCore(*this), contact2d::makeCore(other));
+}
+
+template <typename T_ty>
+bool Capsule2d<T_ty>::intersects(const OrientedBox2d<T_ty> & other) const
+{
+    return contact2d::overlap(contact2d::makeCore(*this), contact2d::makeCore(other));
+}
+
+template <typename T_ty>
+bool Capsule2d<T_ty>::getContact(const Circle2d<T_ty> & other, Contact2d<T_ty> & contact) const
+{
+    return contact2d::collide(contact2d::makeCore(*this), contact2d::makeCore(other), contact);
+}
+
+template <typename T_ty>
+bool Capsule2d<T_ty>::getContact(const Capsule2d<T_ty> & other, Contact2d<T_ty> & contact) const
+{
+    return contact2d::collide(contact2d::makeCore(*this), contact2d::makeCore(other), contact);
+}
+
+template <typename T_ty>
+bool Capsule2d<T_ty>::getContact(const OrientedBox2d<T_ty> & other, Contact2d<T_ty> & contact) const
+{
+    return contact2d::collide(contact2d::makeCore(*this), contact2d::makeCore(other), contact);
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Capsule2d_inl
@@ -0,0 +1,115 @@
+#ifndef ail_math_Circle2d_h
+#define ail_math_Circle2d_h
+
+/** \file Circle2d.h
+    \brief Declares a 2d circle, with narrow phase collision tests. See Circle2d.inl for implementation.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <type_traits>
+#include "BoundingBox2d.h"
+#include "Contact2d.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+template <typename T_ty> class Capsule2d;
+template <typename T_ty> class OrientedBox2d;
+
+/** A circle, given by its centre and radius.
+The collision tests work with Capsule2d and OrientedBox2d too. They're all done
+ by the same separating axis test, without allocating any memory (see
+ Contact2d.inl). Touching counts as an intersection.
+getBounds() gives a BoundingBox2d, so circles can be put in the broad phase
+ structures (e.g. Bvh2d or SweepAndPrune2d) before testing pairs with these
+ functions.
+Like Vector2d, the class is trivially copyable and can be constructed at compile time.
+Template parameter gives the underlying numerical type, which must be floating point.
+*/
+template <typename T_ty>
+class Circle2d
+{
+public:
+    static_assert(std::is_floating_point<T_ty>::value, "Circle2d is only supported for floating point types.");
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - initialises everything to 0.
+    constexpr Circle2d();
+
+    /// Constructor - explicitly initialises the centre and radius.
+    constexpr Circle2d(const Vector2d<T_ty> & pos, const T_ty radius);
+
+
+//------------------------------------------------------------------------------
+// Operators.
+
+    /// Equality test.
+    /// Note that this tests for exact equality, which isn't usually desirable for
+    ///  floating point types.
+    constexpr bool operator == (const Circle2d<T_ty> & rhs) const;
+
+    /// Inequality test.
+    /// Note that this tests for (lack of) exact equality, which isn't usually
+    ///  desirable for floating point types.
+    constexpr bool operator != (const Circle2d<T_ty> & rhs) const;
+
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+    /// Get the smallest axis-aligned box which contains the circle.
+    BoundingBox2d<T_ty> getBounds() const;
+
+
+//------------------------------------------------------------------------------
+// Tests.
+
+    /// Check if the given point is inside (or on the edge of) the circle.
+    bool contains(const Vector2d<T_ty> & point) const;
+
+    /// Check if this circle intersects another circle.
+    bool intersects(const Circle2d<T_ty> & other) const;
+
+    /// Check if this circle intersects a capsule.
+    bool intersects(const Capsule2d<T_ty> & other) const;
+
+    /// Check if this circle intersects an oriented box.
+    bool intersects(const OrientedBox2d<T_ty> & other) const;
+
+    /// Check if this circle intersects another circle, and get the contact manifold.
+    /// The contact is only set if they intersect. Its normal points from this circle to the other one.
+    bool getContact(const Circle2d<T_ty> & other, Contact2d<T_ty> & contact) const;
+
+    /// Check if this circle intersects a capsule, and get the contact manifold.
+    /// The contact is only set if they intersect. Its normal points from this circle to the capsule.
+    bool getContact(const Capsule2d<T_ty> & other, Contact2d<T_ty> & contact) const;
+
+    /// Check if this circle intersects an oriented box, and get the contact manifold.
+    /// The contact is only set if they intersect. Its normal points from this circle to the box.
+    bool getContact(const OrientedBox2d<T_ty> & other, Contact2d<T_ty> & contact) const;
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// Position of the centre.
+    Vector2d<T_ty> pos;
+
+    /// Distance from the centre to the edge.
+    T_ty radius;
+};
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Circle2d_h
@@ -0,0 +1,111 @@
+#ifndef ail_math_Circle2d_inl
+#define ail_math_Circle2d_inl
+
+/** \file Circle2d.inl
+    \brief Implementation for a 2d circle (see Circle2d.h).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "BoundingBox2d.inl"
+#include "Circle2d.h"
+#include "Contact2d.inl"
+#include "Vector2d.inl"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+template <typename T_ty>
+constexpr Circle2d<T_ty>::Circle2d() :
+    pos(), radius(0)
+{
+}
+
+template <typename T_ty>
+constexpr Circle2d<T_ty>::Circle2d(const Vector2d<T_ty> & pos, const T_ty radius) :
+    pos(pos), radius(radius)
+{
+}
+
+//------------------------------------------------------------------------------
+// Operators.
+
+template <typename T_ty>
+constexpr bool Circle2d<T_ty>::operator == (const Circle2d<T_ty> & rhs) const
+{
+    return pos == rhs.pos && radius == rhs.radius;
+}
+
+template <typename T_ty>
+constexpr bool Circle2d<T_ty>::operator != (const Circle2d<T_ty> & rhs) const
+{
+    return !(*this == rhs);
+}
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+template <typename T_ty>
+BoundingBox2d<T_ty> Circle2d<T_ty>::getBounds() const
+{
+    return BoundingBox2d<T_ty>(pos.x, pos.y, radius, radius);
+}
+
+//------------------------------------------------------------------------------
+// Tests.
+
+template <typename T_ty>
+bool Circle2d<T_ty>::contains(const Vector2d<T_ty> & point) const
+{
+    return pos.getSqDistance(point) <= radius * radius;
+}
+
+template <typename T_ty>
+bool Circle2d<T_ty>::intersects(const Circle2d<T_ty> & other) const
+{
+    return contact2d::overlap(contact2d::makeCore(*this), contact2d::makeCore(other));
+}
+
+template <typename T_ty>
+bool Circle2d<T_ty>::intersects(const Capsule2d<T_ty> & other) const
+{
+    return contact2d::overlap(contact2d::makeCore(*this), contact2d::makeCore(other));
+}
+
+template <typename T_ty>
+bool Circle2d<T_ty>::intersects(const OrientedBox2d<T_ty> & other) const
+{
+    return contact2d::overlap(contact2d::makeCore(*this), contact2d::makeCore(other));
+}
+
+template <typename T_ty>
+bool Circle2d<T_ty>::getContact(const Circle2d<T_ty> & other, Contact2d<T_ty> & contact) const
+{
+    return contact2d::collide(contact2d::makeCore(*this), contact2d::makeCore(other), contact);
+}
+
+template <typename T_ty>
+bool Circle2d<T_ty>::getContact(const Capsule2d<T_ty> & other, Contact2d<T_ty> & contact) const
+{
+    return contact2d::collide(contact2d::makeCore(*this), contact2d::makeCore(other), contact);
+}
+
+template <typename T_ty>
+bool Circle2d<T_ty>::getContact(const OrientedBox2d<T_ty> & other, Contact2d<T_ty> & contact) const
+{
+    return contact2d::collide(contact2d::makeCore(*this), contact2d::makeCore(other), contact);
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Circle2d_inl
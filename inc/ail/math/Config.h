@@ -0,0 +1,45 @@
+#ifndef ail_math_Config_h
+#define ail_math_Config_h
+
+/** \file Config.h
+    \brief Detects compiler support for language features which the library can optionally use.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+// C++11 constexpr functions can only contain a single return statement.
+// C++14 relaxed that, so functions which modify a value in place (e.g.
+//  Vector2d::operator +=) can only be constexpr in C++14 mode or later.
+// AIL_MATH_CONSTEXPR14 expands to constexpr where that's supported, and to
+//  nothing otherwise. AIL_MATH_HAS_CONSTEXPR14 is 1 or 0 accordingly.
+#if !defined(AIL_MATH_HAS_CONSTEXPR14)
+    #if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L
+        #define AIL_MATH_HAS_CONSTEXPR14 1
+    #elif defined(_MSC_VER) && _MSC_VER >= 1910 && defined(_MSVC_LANG) && _MSVC_LANG >= 201402L
+        #define AIL_MATH_HAS_CONSTEXPR14 1
+    #else
+        #define AIL_MATH_HAS_CONSTEXPR14 0
+    #endif
+#endif
+
+#if AIL_MATH_HAS_CONSTEXPR14
+    #define AIL_MATH_CONSTEXPR14 constexpr
+#else
+    #define AIL_MATH_CONSTEXPR14
+#endif
+
+// AIL_MATH_PREFETCH_WRITE(address) hints that the memory at address is about
+//  to be written, so the cache line can be fetched while other work is done.
+//  It's only a hint, so it expands to nothing where it isn't supported.
+#if defined(__GNUC__) || defined(__clang__)
+    #define AIL_MATH_PREFETCH_WRITE(address) __builtin_prefetch((address), 1)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <xmmintrin.h>
+    #define AIL_MATH_PREFETCH_WRITE(address) _mm_prefetch(reinterpret_cast<const char *>(address), _MM_HINT_T0)
+#else
+    #define AIL_MATH_PREFETCH_WRITE(address) ((void)0)
+#endif
+
+#endif //ail_math_Config_h
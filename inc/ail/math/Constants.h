@@ -20,12 +20,21 @@ namespace ail {
 namespace math {
 //--------------
 
+/// Identifies types which can represent fractions, i.e. floating point and fixed point (see Fixed.h).
+/// Functions which only make sense for real numbers, such as pi() and the angle
+///  conversions in Utils.h, are only available for these types.
+/// Specialise this for any other numeric type which should be treated as real.
+template <typename T_ty>
+struct isReal : std::is_floating_point<T_ty>
+{
+};
+
 /// Get the value of pi.
 /// Template parameter is required to specify the return type.
 /// Example:  float val = pi<float>();
-/// Only allows floating point types (e.g. float and double). Compilation will fail for any other type.
+/// Only allows real types (e.g. float, double or Fixed). Compilation will fail for any other type.
 template <typename T_ty>
-inline constexpr typename std::enable_if<std::is_floating_point<T_ty>::value, T_ty>::type pi()
+inline constexpr typename std::enable_if<isReal<T_ty>::value, T_ty>::type pi()
 {
     return T_ty(3.141592653589793);
 }
@@ -0,0 +1,63 @@
+#ifndef ail_math_Contact2d_h
+#define ail_math_Contact2d_h
+
+/** \file Contact2d.h
+    \brief Declares a contact manifold between two overlapping 2d shapes. See Contact2d.inl for implementation.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/** Describes how two shapes overlap, for resolving a collision between them.
+This is filled in by the getContact() functions of Circle2d, Capsule2d and
+ OrientedBox2d. The normal is a unit vector which points from the first shape
+ (the one getContact() was called on) towards the second. Moving the second
+ shape by normal * depth separates them.
+There are one or two contact points. Two points are given when a flat side of
+ one shape rests on a flat side of the other, e.g. a box lying on a box. Each
+ point is halfway between the two surfaces, in the overlapping region.
+The points are stored in a fixed size array, so no memory is ever allocated.
+Template parameter gives the underlying numerical type, which should be floating point.
+*/
+template <typename T_ty>
+class Contact2d
+{
+public:
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - initialises everything to 0, with no contact points.
+    constexpr Contact2d();
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// Direction from the first shape to the second, along which the overlap is smallest.
+    Vector2d<T_ty> normal;
+
+    /// How far the shapes overlap along the normal, at the deepest contact point.
+    /// This is 0 if they're only touching.
+    T_ty depth;
+
+    /// The contact points. Only the first pointCount elements are valid.
+    Vector2d<T_ty> points[2];
+
+    /// The number of valid contact points (1 or 2 after a successful test).
+    unsigned pointCount;
+};
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Contact2d_h
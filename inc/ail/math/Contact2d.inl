@@ -0,0 +1,358 @@
+#ifndef ail_math_Contact2d_inl
+#define ail_math_Contact2d_inl
+
+/** \file Contact2d.inl
+    \brief Implementation of the narrow phase collision tests for Circle2d, Capsule2d and OrientedBox2d.
+
+    Every shape is handled as a convex core (a point, a line segment, or a
+     rectangle) expanded by a radius. A circle is a point with a radius, a
+     capsule is a segment with a radius, and a box has a radius of 0. This means
+     that one separating axis test covers every pair of shapes:
+
+     1. Project each core onto the edge normals of the other. If the largest
+        separation is more than the sum of the radii, the shapes don't touch.
+     2. If it's negative, the cores overlap. The edge with the largest
+        separation is the reference edge, and the most opposed edge of the other
+        shape is clipped to its sides, giving up to two contact points.
+     3. Otherwise the cores are apart, and only the radii can make them touch.
+        The closest points of the two cores give the normal and depth. If the
+        normal is along the reference edge's normal, a flat side is resting on
+        another, so the clipping from step 2 is used to get two points.
+
+    The cores are stored in fixed size arrays, so nothing is ever allocated.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cmath>
+#include <limits>
+
+#include "Capsule2d.h"
+#include "Circle2d.h"
+#include "Contact2d.h"
+#include "OrientedBox2d.h"
+#include "Vector2d.inl"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+template <typename T_ty>
+constexpr Contact2d<T_ty>::Contact2d() :
+    normal(), depth(0), points(), pointCount(0)
+{
+}
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+namespace contact2d {
+
+/// The convex core of a shape, and the radius it's expanded by.
+/// normals[i] is the outward unit normal of the edge from vertices[i] to the
+///  next vertex (wrapping around). A segment has two edges, one in each
+///  direction, and a point has none.
+template <typename T_ty>
+struct Core
+{
+    Vector2d<T_ty> vertices[4];
+    Vector2d<T_ty> normals[4];
+    unsigned count;
+    T_ty radius;
+};
+
+/// If a flat side is this close to facing along the normal between the closest points, it's treated as resting on the other shape.
+template <typename T_ty>
+constexpr T_ty faceTolerance()
+{
+    return T_ty(0.999);
+}
+
+template <typename T_ty>
+inline Core<T_ty> makeCore(const Circle2d<T_ty> & circle)
+{
+    Core<T_ty> core;
+    core.vertices[0] = circle.pos;
+    core.count = 1;
+    core.radius = circle.radius;
+    return core;
+}
+
+template <typename T_ty>
+inline Core<T_ty> makeCore(const Capsule2d<T_ty> & capsule)
+{
+    Core<T_ty> core;
+    core.vertices[0] = capsule.start;
+    core.vertices[1] = capsule.end;
+    core.radius = capsule.radius;
+
+    // If both ends are in the same place, it's a circle.
+    const Vector2d<T_ty> direction = capsule.end - capsule.start;
+    const T_ty length = direction.getLength();
+    if (length > T_ty(0)) {
+        core.normals[0] = (direction / length).getRightTangent();
+        core.normals[1] = -core.normals[0];
+        core.count = 2;
+    } else {
+        core.count = 1;
+    }
+    return core;
+}
+
+template <typename T_ty>
+inline Core<T_ty> makeCore(const OrientedBox2d<T_ty> & box)
+{
+    const Vector2d<T_ty> axisY = box.axis.getLeftTangent();
+    const Vector2d<T_ty> x = box.axis * box.radius.x;
+    const Vector2d<T_ty> y = axisY * box.radius.y;
+
+    Core<T_ty> core;
+    core.vertices[0] = box.pos - x - y;
+    core.vertices[1] = box.pos + x - y;
+    core.vertices[2] = box.pos + x + y;
+    core.vertices[3] = box.pos - x + y;
+    core.normals[0] = -axisY;
+    core.normals[1] = box.axis;
+    core.normals[2] = axisY;
+    core.normals[3] = -box.axis;
+    core.count = 4;
+    core.radius = T_ty(0);
+    return core;
+}
+
+/// Get the point on the segment from a to b which is closest to the given point.
+template <typename T_ty>
+inline Vector2d<T_ty> closestOnSegment(const Vector2d<T_ty> & point, const Vector2d<T_ty> & a, const Vector2d<T_ty> & b)
+{
+    const Vector2d<T_ty> ab = b - a;
+    const T_ty sqLength = ab.getSqLength();
+    if (sqLength == T_ty(0))
+        return a;
+    T_ty t = (point - a).dot(ab) / sqLength;
+    t = (t < T_ty(0)) ? T_ty(0) : ((t > T_ty(1)) ? T_ty(1) : t);
+    return a + (ab * t);
+}
+
+/// Find the edge of poly1 with the largest separation from the core of poly2.
+/// Separation is negative along an axis where they overlap. If poly1 is a
+///  point (so it has no edges), the lowest possible value is returned.
+template <typename T_ty>
+inline T_ty findMaxSeparation(const Core<T_ty> & poly1, const Core<T_ty> & poly2, unsigned & edge)
+{
+    T_ty maxSeparation = std::numeric_limits<T_ty>::lowest();
+    edge = 0;
+    if (poly1.count < 2)
+        return maxSeparation;
+
+    for (unsigned i = 0; i < poly1.count; ++i) {
+        T_ty separation = std::numeric_limits<T_ty>::max();
+        for (unsigned j = 0; j < poly2.count; ++j) {
+            const T_ty s = poly1.normals[i].dot(poly2.vertices[j] - poly1.vertices[i]);
+            separation = (s < separation) ? s : separation;
+        }
+        if (separation > maxSeparation) {
+            maxSeparation = separation;
+            edge = i;
+        }
+    }
+    return maxSeparation;
+}
+
+/// Check each vertex of one core against each edge of another, keeping the closest pair found so far.
+template <typename T_ty>
+inline void findClosestToEdges(const Core<T_ty> & edges, const Core<T_ty> & vertices,
+    Vector2d<T_ty> & onEdge, Vector2d<T_ty> & vertex, T_ty & sqDistance)
+{
+    // A segment's two edges are the same, so only one is checked.
+    const unsigned edgeCount = (edges.count > 2) ? edges.count : edges.count - 1;
+    for (unsigned i = 0; i < edgeCount; ++i) {
+        const Vector2d<T_ty> & a = edges.vertices[i];
+        const Vector2d<T_ty> & b = edges.vertices[(i + 1) % edges.count];
+        for (unsigned j = 0; j < vertices.count; ++j) {
+            const Vector2d<T_ty> point = closestOnSegment(vertices.vertices[j], a, b);
+            const T_ty d = point.getSqDistance(vertices.vertices[j]);
+            if (d < sqDistance) {
+                sqDistance = d;
+                onEdge = point;
+                vertex = vertices.vertices[j];
+            }
+        }
+    }
+}
+
+/// Find the closest points of two cores which don't overlap, and return the squared distance between them.
+/// The closest points of two convex polygons always include a vertex of one of
+///  them, so every vertex is checked against every edge of the other core.
+template <typename T_ty>
+inline T_ty findClosest(const Core<T_ty> & a, const Core<T_ty> & b, Vector2d<T_ty> & pointA, Vector2d<T_ty> & pointB)
+{
+    if (a.count == 1 && b.count == 1) {
+        pointA = a.vertices[0];
+        pointB = b.vertices[0];
+        return pointA.getSqDistance(pointB);
+    }
+
+    T_ty sqDistance = std::numeric_limits<T_ty>::max();
+    findClosestToEdges(a, b, pointA, pointB, sqDistance);
+    findClosestToEdges(b, a, pointB, pointA, sqDistance);
+    return sqDistance;
+}
+
+/// Clip the incident core's most opposed edge to the sides of a reference edge, and store the contact.
+/// separation is the separating axis result for the reference edge, which must
+///  be no more than the sum of the radii. Moving the incident core along the
+///  edge normal by the difference separates them, so that gives the depth. flip
+///  indicates that the reference is the second shape, so the normal needs to be
+///  reversed. This always gives at least one point.
+template <typename T_ty>
+inline void clip(const Core<T_ty> & reference, const Core<T_ty> & incident, const unsigned edge, const T_ty separation,
+    const bool flip, Contact2d<T_ty> & contact)
+{
+    const Vector2d<T_ty> & normal = reference.normals[edge];
+    const Vector2d<T_ty> & v11 = reference.vertices[edge];
+    const Vector2d<T_ty> & v12 = reference.vertices[(edge + 1) % reference.count];
+
+    // The incident edge faces most directly against the reference edge, and contains the deepest vertex.
+    Vector2d<T_ty> v21 = incident.vertices[0];
+    Vector2d<T_ty> v22 = incident.vertices[0];
+    if (incident.count > 1) {
+        unsigned best = 0;
+        T_ty minDot = std::numeric_limits<T_ty>::max();
+        for (unsigned j = 0; j < incident.count; ++j) {
+            const T_ty d = normal.dot(incident.normals[j]);
+            if (d < minDot) {
+                minDot = d;
+                best = j;
+            }
+        }
+        v21 = incident.vertices[best];
+        v22 = incident.vertices[(best + 1) % incident.count];
+    }
+
+    // Measure along the reference edge. The incident edge runs in the opposite direction.
+    const Vector2d<T_ty> tangent = normal.getLeftTangent();
+    const T_ty upper1 = tangent.dot(v12 - v11);
+    const T_ty upper2 = tangent.dot(v21 - v11);
+    const T_ty lower2 = tangent.dot(v22 - v11);
+    const T_ty range = upper2 - lower2;
+
+    Vector2d<T_ty> clipped[2] = { v22, v21 };
+    if (range > T_ty(0)) {
+        if (lower2 < T_ty(0)) {
+            const T_ty t = -lower2 / range;
+            clipped[0] = v22 + ((v21 - v22) * ((t < T_ty(1)) ? t : T_ty(1)));
+        }
+        if (upper2 > upper1) {
+            const T_ty t = (upper1 - lower2) / range;
+            clipped[1] = v22 + ((v21 - v22) * ((t > T_ty(0)) ? t : T_ty(0)));
+        }
+    }
+    const unsigned clippedCount = (clipped[0] != clipped[1]) ? 2 : 1;
+
+    // Keep the points which are touching or overlapping, moved halfway between the two surfaces.
+    const T_ty totalRadius = reference.radius + incident.radius;
+    Vector2d<T_ty> points[2];
+    unsigned count = 0;
+    for (unsigned k = 0; k < clippedCount; ++k) {
+        const T_ty s = normal.dot(clipped[k] - v11);
+        if (s <= totalRadius)
+            points[count++] = clipped[k] + (normal * ((reference.radius - incident.radius - s) / T_ty(2)));
+    }
+
+    // In awkward cases, clipping can remove the deepest part of the incident edge.
+    // Its deepest vertex is always close enough to use instead.
+    if (count == 0) {
+        const Vector2d<T_ty> & deepest = (normal.dot(v21 - v11) < normal.dot(v22 - v11)) ? v21 : v22;
+        const T_ty s = normal.dot(deepest - v11);
+        points[count++] = deepest + (normal * ((reference.radius - incident.radius - s) / T_ty(2)));
+    }
+
+    contact.normal = flip ? -normal : normal;
+    contact.depth = totalRadius - separation;
+    contact.points[0] = points[0];
+    contact.points[1] = points[1];
+    contact.pointCount = count;
+}
+
+/// Check if two shapes intersect, from their cores.
+template <typename T_ty>
+inline bool overlap(const Core<T_ty> & a, const Core<T_ty> & b)
+{
+    const T_ty totalRadius = a.radius + b.radius;
+    unsigned edge;
+    const T_ty separationA = findMaxSeparation(a, b, edge);
+    const T_ty separationB = findMaxSeparation(b, a, edge);
+    const T_ty separation = (separationB > separationA) ? separationB : separationA;
+    if (separation > totalRadius)
+        return false;
+    if (separation < T_ty(0) && (a.count > 1 || b.count > 1))
+        return true;
+
+    Vector2d<T_ty> pointA, pointB;
+    return findClosest(a, b, pointA, pointB) <= totalRadius * totalRadius;
+}
+
+/// Check if two shapes intersect, from their cores, and store the contact if they do.
+/// This makes exactly the same decision as overlap().
+template <typename T_ty>
+inline bool collide(const Core<T_ty> & a, const Core<T_ty> & b, Contact2d<T_ty> & contact)
+{
+    const T_ty totalRadius = a.radius + b.radius;
+    unsigned edgeA, edgeB;
+    const T_ty separationA = findMaxSeparation(a, b, edgeA);
+    const T_ty separationB = findMaxSeparation(b, a, edgeB);
+    const bool flip = (separationB > separationA);
+    const T_ty separation = flip ? separationB : separationA;
+    if (separation > totalRadius)
+        return false;
+
+    const Core<T_ty> & reference = flip ? b : a;
+    const Core<T_ty> & incident = flip ? a : b;
+    const unsigned edge = flip ? edgeB : edgeA;
+    const bool hasEdges = (reference.count > 1);
+
+    // The cores overlap, so the axis with the least overlap gives the normal.
+    if (hasEdges && separation < T_ty(0)) {
+        clip(reference, incident, edge, separation, flip, contact);
+        return true;
+    }
+
+    // The cores are apart or just touching, but the radii might make the shapes intersect.
+    Vector2d<T_ty> pointA, pointB;
+    const T_ty sqDistance = findClosest(a, b, pointA, pointB);
+    if (sqDistance > totalRadius * totalRadius)
+        return false;
+
+    const T_ty distance = std::sqrt(sqDistance);
+    const Vector2d<T_ty> referenceNormal = !hasEdges ? Vector2d<T_ty>(T_ty(0), T_ty(1)) :
+        (flip ? -reference.normals[edge] : reference.normals[edge]);
+    const Vector2d<T_ty> normal = (distance > T_ty(0)) ? (pointB - pointA) / distance : referenceNormal;
+
+    // A flat side resting on the other shape can have two contact points.
+    if (hasEdges && normal.dot(referenceNormal) >= faceTolerance<T_ty>()) {
+        clip(reference, incident, edge, separation, flip, contact);
+        return true;
+    }
+
+    contact.normal = normal;
+    contact.depth = totalRadius - distance;
+    contact.points[0] = ((pointA + (normal * a.radius)) + (pointB - (normal * b.radius))) / T_ty(2);
+    contact.points[1] = Vector2d<T_ty>();
+    contact.pointCount = 1;
+    return true;
+}
+
+} // contact2d
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Contact2d_inl
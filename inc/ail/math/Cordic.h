@@ -0,0 +1,351 @@
+#ifndef ail_math_Cordic_h
+#define ail_math_Cordic_h
+
+/** \file Cordic.h
+    \brief CORDIC calculation of sin, cos, atan2 and hypot, using only integer shifts and adds.
+
+    CORDIC turns a vector through a fixed sequence of angles, atan(2^-i), each
+     of which only needs a shift and an add. Every iteration adds roughly one
+     bit of accuracy, so the number of iterations is a template parameter, e.g.:
+
+        float s, c;
+        cordicSinCos<16>(angle, s, c);
+        const float angle = cordicAtan2<24>(y, x);
+
+    This can be faster than the standard library on processors with slow
+     floating point (or none), and it gives the same results everywhere.
+     Each iteration depends on the one before, though, so on processors with
+     a fast FPU the standard library is usually quicker (see bench_Cordic.cpp).
+    TrigCordic in TrigPolicy.h uses these for the conversions between Polar
+     and Vector2d.
+
+    The calculations are done with integers which have 30 fractional bits,
+     and there can be at most 30 iterations. The errors below are absolute
+     rather than ulps, because everything is rounded to the same fixed step:
+     - cordicSinCos: max error about 2^-(n - 1) for n iterations. Rounding
+        limits it to about 2^-26 for 30 iterations. The angle is reduced to
+        [-pi/4, pi/4] in floating point first (as in FastTrig.h), so it's
+        only accurate for |angle| <= 1e6 radians.
+     - cordicAtan2: max error about 2^-(n - 1) radians for n iterations, down
+        to about 2^-27 for 30 iterations. cordicAtan2(0, 0) returns 0.
+     - cordicHypot: max relative error about 2^-(2n - 1) for n iterations,
+        down to about 2^-33 for 17 or more iterations.
+    Float results are also rounded to float.
+    Only float and double are supported, and NaN and infinite inputs aren't.
+
+    The integer calculations in namespace cordic are shared with the fixed
+     point type (see Fixed.h), which always uses all 30 iterations.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "FastTrig.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+//-------------------------------------------------------------------------
+// Internal helpers.
+
+namespace cordic {
+
+/// Number of fractional bits in the integer calculations.
+const int fracBits = 30;
+
+/// Maximum number of iterations. Beyond this, atan(2^-i) would round to less than one step.
+const int maxIterations = 30;
+
+/// Constants for the CORDIC calculations, with fracBits fractional bits.
+/// These are written out in full, rather than calculated with floating point,
+///  so that they're identical everywhere.
+/// The dummy template parameter allows the tables to be defined in a header.
+template <typename T_dummy = void>
+struct Tables
+{
+    /// atan(2^-i) for each iteration i.
+    static const std::int64_t atan[maxIterations];
+
+    /// For each number of iterations n, the product of cos(atan(2^-i)) for the first n iterations.
+    /// Starting a rotation at this length means the result comes out with length 1.
+    static const std::int64_t gain[maxIterations + 1];
+
+    static const std::int64_t pi = 3373259426;
+    static const std::int64_t halfPi = 1686629713;
+    static const std::int64_t twoPi = 6746518852;
+};
+
+template <typename T_dummy> const std::int64_t Tables<T_dummy>::pi;
+template <typename T_dummy> const std::int64_t Tables<T_dummy>::halfPi;
+template <typename T_dummy> const std::int64_t Tables<T_dummy>::twoPi;
+
+template <typename T_dummy>
+const std::int64_t Tables<T_dummy>::atan[maxIterations] = {
+    843314857, 497837829, 263043837, 133525159, 67021687, 33543516, 16775851, 8388437,
+    4194283, 2097149, 1048576, 524288, 262144, 131072, 65536, 32768,
+    16384, 8192, 4096, 2048, 1024, 512, 256, 128,
+    64, 32, 16, 8, 4, 2
+};
+
+template <typename T_dummy>
+const std::int64_t Tables<T_dummy>::gain[maxIterations + 1] = {
+    1073741824, 759250125, 679093957, 658817909, 653730436, 652457347, 652138997, 652059405,
+    652039507, 652034532, 652033289, 652032978, 652032900, 652032881, 652032876, 652032874,
+    652032874, 652032874, 652032874, 652032874, 652032874, 652032874, 652032874, 652032874,
+    652032874, 652032874, 652032874, 652032874, 652032874, 652032874, 652032874
+};
+
+/// Negate a value if mask is -1, or leave it unchanged if mask is 0.
+inline std::int64_t negateIf(const std::int64_t value, const std::int64_t mask)
+{
+    return (value ^ mask) - mask;
+}
+
+/// Rotate the vector (1, 0) through an angle by CORDIC, giving the sin and cos of the angle.
+/// All the values have fracBits fractional bits. CORDIC only converges for
+///  angles up to about 1.74 radians either way, so use sinCos() for larger angles.
+template <int T_iterations>
+inline void rotate(std::int64_t angle, std::int64_t & sinOut, std::int64_t & cosOut)
+{
+    static_assert(T_iterations >= 1 && T_iterations <= maxIterations, "CORDIC needs between 1 and 30 iterations.");
+    typedef Tables<> C;
+
+    // Rotate the vector (gain, 0) through the angle, in steps of atan(2^-i).
+    // Each step turns anticlockwise if the remaining angle is positive, or
+    //  clockwise if it's negative. The direction is applied with a mask rather
+    //  than a branch, because it's unpredictable.
+    std::int64_t x = C::gain[T_iterations];
+    std::int64_t y = 0;
+    for (int i = 0; i < T_iterations; ++i) {
+        const std::int64_t mask = -static_cast<std::int64_t>(angle < 0);
+        const std::int64_t dx = y >> i;
+        const std::int64_t dy = x >> i;
+        x -= negateIf(dx, mask);
+        y += negateIf(dy, mask);
+        angle -= negateIf(C::atan[i], mask);
+    }
+
+    sinOut = y;
+    cosOut = x;
+}
+
+/// Calculate sin and cos of any angle by CORDIC rotation.
+/// All the values have fracBits fractional bits.
+template <int T_iterations>
+inline void sinCos(std::int64_t angle, std::int64_t & sinOut, std::int64_t & cosOut)
+{
+    typedef Tables<> C;
+
+    // Reduce to [-pi, pi], then rotate by half a turn if necessary to get within
+    //  [-pi/2, pi/2].
+    angle %= C::twoPi;
+    if (angle > C::pi)
+        angle -= C::twoPi;
+    else if (angle < -C::pi)
+        angle += C::twoPi;
+
+    bool negate = false;
+    if (angle > C::halfPi) {
+        angle -= C::pi;
+        negate = true;
+    } else if (angle < -C::halfPi) {
+        angle += C::pi;
+        negate = true;
+    }
+
+    std::int64_t s, c;
+    rotate<T_iterations>(angle, s, c);
+    sinOut = negate ? -s : s;
+    cosOut = negate ? -c : c;
+}
+
+/// Scale a vector up by a power of 2, so that the larger component is in [2^57, 2^58).
+/// This keeps CORDIC vectoring accurate. The vector grows by less than 2.4 times
+///  while it's rotated, so it stays well within 64 bits.
+inline void scaleUp(std::int64_t & x, std::int64_t & y)
+{
+    const std::int64_t absX = (x < 0) ? -x : x;
+    const std::int64_t absY = (y < 0) ? -y : y;
+    std::uint64_t larger = static_cast<std::uint64_t>((absX > absY) ? absX : absY);
+    if (larger == 0)
+        return;
+
+    std::int64_t factor = 1;
+    for (int shift = 32; shift != 0; shift >>= 1) {
+        if (larger < (std::uint64_t(1) << (58 - shift))) {
+            larger <<= shift;
+            factor <<= shift;
+        }
+    }
+    x *= factor;
+    y *= factor;
+}
+
+/// Rotate the vector (x, y) onto the positive x axis by CORDIC vectoring, and return
+///  the angle it was turned through, i.e. atan2(y, x).
+/// The angle is in [-pi, pi] with fracBits fractional bits. The vector is left in x
+///  and y, with its length divided by gain[T_iterations]. The vector should already
+///  have been scaled up (see scaleUp()) for accuracy. A zero vector gives 0.
+template <int T_iterations>
+inline std::int64_t vectorise(std::int64_t & x, std::int64_t & y)
+{
+    static_assert(T_iterations >= 1 && T_iterations <= maxIterations, "CORDIC needs between 1 and 30 iterations.");
+    typedef Tables<> C;
+
+    if (x == 0 && y == 0)
+        return 0;
+
+    // Rotate by half a turn if necessary, so that x is positive.
+    std::int64_t angle = 0;
+    if (x < 0) {
+        angle = (y >= 0) ? C::pi : -C::pi;
+        x = -x;
+        y = -y;
+    }
+
+    // Rotate the vector onto the x axis in steps of atan(2^-i), adding up the steps.
+    // Each step turns clockwise if y is positive, or anticlockwise otherwise.
+    for (int i = 0; i < T_iterations; ++i) {
+        const std::int64_t mask = -static_cast<std::int64_t>(y > 0);
+        const std::int64_t dx = y >> i;
+        const std::int64_t dy = x >> i;
+        x -= negateIf(dx, mask);
+        y += negateIf(dy, mask);
+        angle -= negateIf(C::atan[i], mask);
+    }
+    return angle;
+}
+
+/// Calculate atan2(y, x) by CORDIC vectoring. The inputs can have any scale.
+/// The result is in [-pi, pi] with fracBits fractional bits. atan2(0, 0) is 0.
+template <int T_iterations>
+inline std::int64_t atan2(std::int64_t y, std::int64_t x)
+{
+    scaleUp(x, y);
+    return vectorise<T_iterations>(x, y);
+}
+
+/// Convert a value in the range [-pi, pi] to fracBits fractional bits, rounding to nearest.
+template <typename T_ty>
+inline std::int64_t toFixed(const T_ty value)
+{
+    return static_cast<std::int64_t>(fasttrig::roundNearest(static_cast<double>(value) * 1073741824.0));
+}
+
+/// Convert a value with fracBits fractional bits back to floating point.
+template <typename T_ty>
+inline T_ty fromFixed(const std::int64_t value)
+{
+    return static_cast<T_ty>(static_cast<double>(value) * (1.0 / 1073741824.0));
+}
+
+/// Get 2^exponent as a double. The exponent must be in the range [-1022, 1023].
+/// This is much cheaper than std::ldexp(), which also has to handle every
+///  special case of its input.
+inline double powerOf2(const int exponent)
+{
+    const std::uint64_t bits = static_cast<std::uint64_t>(exponent + 1023) << 52;
+    double result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+/// Get the exponent e of a positive finite value, such that 2^(e - 1) <= value < 2^e.
+/// Zero and subnormal values give -1021, which is as if they were 2^-1022.
+inline int getExponent(const double value)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const int biased = static_cast<int>(bits >> 52);
+    return ((biased == 0) ? 1 : biased) - 1022;
+}
+
+/// Convert a vector to integers, scaled exactly by 2^shift so that the larger component is in [2^57, 2^58).
+/// Returns shift. The scaling is done in two halves, so that neither of them
+///  overflows. Subnormal components are scaled as if they were 2^-1022, so they
+///  lose some accuracy, and components which are both zero give zero.
+template <typename T_ty>
+inline int toScaledFixed(const T_ty x, const T_ty y, std::int64_t & xOut, std::int64_t & yOut)
+{
+    const double dx = static_cast<double>(x);
+    const double dy = static_cast<double>(y);
+    const double absX = (dx < 0.0) ? -dx : dx;
+    const double absY = (dy < 0.0) ? -dy : dy;
+    const int shift = 58 - getExponent((absX > absY) ? absX : absY);
+    const double scale1 = powerOf2(shift / 2);
+    const double scale2 = powerOf2(shift - (shift / 2));
+    xOut = static_cast<std::int64_t>((dx * scale1) * scale2);
+    yOut = static_cast<std::int64_t>((dy * scale1) * scale2);
+    return shift;
+}
+
+} // cordic
+
+//-------------------------------------------------------------------------
+// CORDIC functions.
+
+/// Calculate sin and cos of an angle in radians together, using T_iterations CORDIC iterations (1 to 30).
+template <int T_iterations, typename T_ty>
+inline void cordicSinCos(const T_ty angle, T_ty & sinOut, T_ty & cosOut)
+{
+    static_assert(std::is_floating_point<T_ty>::value, "CORDIC is only supported for float and double.");
+
+    // Reduce to [-pi/4, pi/4] accurately, so that the integer calculation doesn't have to.
+    T_ty r, k;
+    fasttrig::reduceQuadrant(angle, r, k);
+
+    std::int64_t s, c;
+    cordic::rotate<T_iterations>(cordic::toFixed(r), s, c);
+    fasttrig::rotateQuadrant(k, cordic::fromFixed<T_ty>(s), cordic::fromFixed<T_ty>(c), sinOut, cosOut);
+}
+
+/// Calculate atan2(y, x) in radians, using T_iterations CORDIC iterations (1 to 30).
+/// The result is in [-pi, pi]. cordicAtan2(0, 0) returns 0.
+template <int T_iterations, typename T_ty>
+inline T_ty cordicAtan2(const T_ty y, const T_ty x)
+{
+    static_assert(std::is_floating_point<T_ty>::value, "CORDIC is only supported for float and double.");
+
+    std::int64_t xi, yi;
+    cordic::toScaledFixed(x, y, xi, yi);
+    return cordic::fromFixed<T_ty>(cordic::vectorise<T_iterations>(xi, yi));
+}
+
+/// Calculate atan2(y, x) in radians and the length of the vector (x, y) together, using
+///  T_iterations CORDIC iterations (1 to 30). This costs the same as cordicAtan2() alone.
+template <int T_iterations, typename T_ty>
+inline void cordicAtan2Hypot(const T_ty y, const T_ty x, T_ty & angleOut, T_ty & hypotOut)
+{
+    static_assert(std::is_floating_point<T_ty>::value, "CORDIC is only supported for float and double.");
+    typedef cordic::Tables<> C;
+
+    std::int64_t xi, yi;
+    const int shift = cordic::toScaledFixed(x, y, xi, yi);
+    angleOut = cordic::fromFixed<T_ty>(cordic::vectorise<T_iterations>(xi, yi));
+
+    // The vector now lies along the x axis, scaled up by 2^shift and divided by the gain.
+    const double gain = static_cast<double>(C::gain[T_iterations]) * (1.0 / 1073741824.0);
+    hypotOut = static_cast<T_ty>(((static_cast<double>(xi) * gain) * cordic::powerOf2(-(shift / 2))) * cordic::powerOf2(-(shift - (shift / 2))));
+}
+
+/// Calculate the length of the vector (x, y), using T_iterations CORDIC iterations (1 to 30).
+template <int T_iterations, typename T_ty>
+inline T_ty cordicHypot(const T_ty x, const T_ty y)
+{
+    T_ty angle, length;
+    cordicAtan2Hypot<T_iterations>(y, x, angle, length);
+    return length;
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Cordic_h
@@ -0,0 +1,292 @@
+#ifndef ail_math_FastTrig_h
+#define ail_math_FastTrig_h
+
+/** \file FastTrig.h
+    \brief Branch-free polynomial approximations of sin, cos and atan2.
+
+    These are intended for batch processing. Each function is written without
+     branches or library calls (other than those which map to single instructions),
+     so loops which call them can be auto-vectorised by the compiler.
+    Note that GCC and Clang will only vectorise calls to std::sqrt (used by
+     the batch conversions) if -fno-math-errno is specified. GCC also needs
+     -fno-trapping-math to vectorise fastAtan2, otherwise it splits the range
+     reduction into separate branches. Neither option changes the results.
+    Only float and double are supported.
+
+    Accuracy, measured against correctly rounded results:
+     - fastSin / fastCos / fastSinCos:
+        float:  max 2 ulp for |angle| <= 1e6 radians.
+        double: max 2 ulp for |angle| <= 1e6 radians.
+        Argument reduction is exact up to about 1.6e6 radians. Accuracy falls
+         off rapidly beyond that, so angles should be kept reasonably small
+         (e.g. by using Polar::simplify()).
+     - fastAtan2:
+        float:  max 3 ulp.
+        double: max 2 ulp.
+        fastAtan2(0, 0) returns 0. The sign of a zero x is ignored, so
+         fastAtan2(+/-0, -0) returns +/-0 rather than +/-pi.
+    NaN and infinite inputs are not supported.
+
+    NOTE: These rely on IEEE rounding behaviour. They will give incorrect results
+     if compiled with options which allow the compiler to reassociate floating
+     point arithmetic (e.g. -ffast-math or /fp:fast).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cmath>
+#include "Constants.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+//-------------------------------------------------------------------------
+// Internal helpers.
+
+namespace fasttrig {
+
+/// Round to the nearest integer (ties to even) without calling a library function.
+/// Valid for |val| < 2^22.
+inline float roundNearest(const float val)
+{
+    const float magic = 12582912.0f; // 1.5 * 2^23
+    return (val + magic) - magic;
+}
+
+/// Round to the nearest integer (ties to even) without calling a library function.
+/// Valid for |val| < 2^51.
+inline double roundNearest(const double val)
+{
+    const double magic = 6755399441055744.0; // 1.5 * 2^52
+    return (val + magic) - magic;
+}
+
+/// Coefficients of the minimax polynomials, by type.
+template <typename T_ty> struct Coeffs;
+
+template <>
+struct Coeffs<float>
+{
+    // sin(r) ~= r + r*z*S(z), for z = r^2 and |r| <= pi/4
+    static float sinPoly(const float z)
+    {
+        return (-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f;
+    }
+
+    // cos(r) ~= 1 - z/2 + z*z*C(z), for z = r^2 and |r| <= pi/4
+    static float cosPoly(const float z)
+    {
+        return (2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f;
+    }
+};
+
+template <>
+struct Coeffs<double>
+{
+    static double sinPoly(const double z)
+    {
+        return ((((1.58962301576546568060e-10 * z - 2.50507477628578072866e-8) * z
+            + 2.75573136213857245213e-6) * z - 1.98412698295895385996e-4) * z
+            + 8.33333333332211858878e-3) * z - 1.66666666666666307295e-1;
+    }
+
+    static double cosPoly(const double z)
+    {
+        return ((((-1.13585365213876817300e-11 * z + 2.08757008419747316778e-9) * z
+            - 2.75573141792967388112e-7) * z + 2.48015872888517045348e-5) * z
+            - 1.38888888888730564116e-3) * z + 4.16666666666665929218e-2;
+    }
+};
+
+/// Approximate atan(t) for 0 <= t <= 1.
+inline float atanUnit(const float t)
+{
+    // Reduce to |u| <= tan(pi/8) using atan(t) = pi/4 + atan((t-1)/(t+1)).
+    // The division is done unconditionally (dividing by 1 if not needed) so
+    //  the compiler doesn't have to branch around it.
+    const bool big = t > 0.4142135623730950f;
+    const float c = big ? 1.0f : 0.0f;
+    const float u = (t - c) / (c * t + 1.0f);
+    const float base = big ? 0.785398163397448f : 0.0f;
+    const float z = u * u;
+    const float p = (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z;
+    return base + (u * p + u);
+}
+
+/// Approximate atan(t) for 0 <= t <= 1.
+inline double atanUnit(const double t)
+{
+    // Reduce to |u| <= 0.66 using atan(t) = pi/4 + atan((t-1)/(t+1)).
+    // The division is done unconditionally (dividing by 1 if not needed) so
+    //  the compiler doesn't have to branch around it.
+    const bool big = t > 0.66;
+    const double c = big ? 1.0 : 0.0;
+    const double u = (t - c) / (c * t + 1.0);
+    const double base = big ? 7.85398163397448309616e-1 : 0.0;
+    const double extra = big ? 3.06161699786838301793e-17 : 0.0; // Low bits of pi/4.
+    const double z = u * u;
+    const double p = ((((-8.750608600031904122785e-1 * z - 1.615753718733365076637e1) * z
+        - 7.500855792314704667340e1) * z - 1.228866684490136173410e2) * z - 6.485021904942025371773e1) * z;
+    const double q = ((((z + 2.485846490142306297962e1) * z + 1.650270098316988542046e2) * z
+        + 4.328810604912902668951e2) * z + 4.853903996359136964868e2) * z + 1.945506571482613964425e2;
+    return base + ((u * (p / q) + u) + extra);
+}
+
+/// Reduce an angle to r in [-pi/4, pi/4], such that angle = r + k * pi/2.
+/// Float angles are reduced in double precision, which keeps the result accurate
+///  near the zeros of sin and cos without losing much throughput.
+inline void reduceQuadrant(const float angle, float & r, float & k)
+{
+    const double kd = roundNearest(static_cast<double>(angle) * 0.636619772367581343076);
+    const double rd = (static_cast<double>(angle) - kd * 1.57079632673412561417e+00) - kd * 6.07710050650619224932e-11;
+    r = static_cast<float>(rd);
+    k = static_cast<float>(kd);
+}
+
+/// Reduce an angle to r in [-pi/4, pi/4], such that angle = r + k * pi/2.
+/// This uses Cody-Waite reduction with pi/2 split into four parts of 33 bits,
+///  so each product with k is exact while |k| < 2^20.
+inline void reduceQuadrant(const double angle, double & r, double & k)
+{
+    k = roundNearest(angle * 0.636619772367581343076);
+    r = (((angle - k * 1.57079632673412561417e+00)
+        - k * 6.07710050630396597660e-11)
+        - k * 2.02226624871116645580e-21)
+        - k * 8.47842766036889956997e-32;
+}
+
+/// Rotate the sine and cosine of a reduced angle r back into the quadrant of angle = r + k * pi/2.
+/// Bitwise operators are used to avoid short-circuit branches.
+template <typename T_ty>
+inline void rotateQuadrant(const T_ty k, const T_ty s, const T_ty c, T_ty & sinOut, T_ty & cosOut)
+{
+    // Get the quadrant q in [0, 3].
+    const T_ty q = k - T_ty(4) * roundNearest((k - T_ty(1.5)) * T_ty(0.25));
+
+    const bool swap = (q == T_ty(1)) | (q == T_ty(3));
+    const bool negSin = q >= T_ty(2);
+    const bool negCos = (q == T_ty(1)) | (q == T_ty(2));
+    const T_ty sinVal = swap ? c : s;
+    const T_ty cosVal = swap ? s : c;
+    sinOut = negSin ? -sinVal : sinVal;
+    cosOut = negCos ? -cosVal : cosVal;
+}
+
+/// Approximate sin and cos together, for float or double.
+template <typename T_ty>
+inline void sinCos(const T_ty angle, T_ty & sinOut, T_ty & cosOut)
+{
+    typedef Coeffs<T_ty> C;
+
+    // Reduce to r in [-pi/4, pi/4].
+    T_ty r, k;
+    reduceQuadrant(angle, r, k);
+
+    const T_ty z = r * r;
+    const T_ty s = r + r * z * C::sinPoly(z);
+    const T_ty c = (T_ty(1) - T_ty(0.5) * z) + z * z * C::cosPoly(z);
+    rotateQuadrant(k, s, c, sinOut, cosOut);
+}
+
+/// Get the ratio of the smaller to the larger absolute component, in [0, 1].
+/// atan2(y, x) can be reconstructed from the arctangent of this using atan2Octant().
+template <typename T_ty>
+inline T_ty atan2Ratio(const T_ty y, const T_ty x)
+{
+    const T_ty ax = std::fabs(x);
+    const T_ty ay = std::fabs(y);
+    const T_ty hi = (ax > ay) ? ax : ay;
+    const T_ty lo = (ax > ay) ? ay : ax;
+    // Avoid dividing by zero. If hi is 0 then lo is 0 too, so the ratio will be 0.
+    return lo / ((hi == T_ty(0)) ? T_ty(1) : hi);
+}
+
+/// Move the arctangent of atan2Ratio(y, x) into the correct octant to give atan2(y, x).
+template <typename T_ty>
+inline T_ty atan2Octant(const T_ty y, const T_ty x, T_ty angle)
+{
+    angle = (std::fabs(y) > std::fabs(x)) ? (pi<T_ty>() * T_ty(0.5)) - angle : angle;
+    angle = (x < T_ty(0)) ? pi<T_ty>() - angle : angle;
+    return (y < T_ty(0)) ? -angle : angle;
+}
+
+/// Approximate atan2(y, x), for float or double.
+template <typename T_ty>
+inline T_ty atan2(const T_ty y, const T_ty x)
+{
+    return atan2Octant(y, x, atanUnit(atan2Ratio(y, x)));
+}
+
+} // fasttrig
+
+//-------------------------------------------------------------------------
+// Public functions.
+
+/// Approximate the sine and cosine of an angle (radians) in one call.
+inline void fastSinCos(const float angle, float & sinOut, float & cosOut)
+{
+    fasttrig::sinCos(angle, sinOut, cosOut);
+}
+
+/// Approximate the sine and cosine of an angle (radians) in one call.
+inline void fastSinCos(const double angle, double & sinOut, double & cosOut)
+{
+    fasttrig::sinCos(angle, sinOut, cosOut);
+}
+
+/// Approximate the sine of an angle (radians).
+inline float fastSin(const float angle)
+{
+    float s, c;
+    fasttrig::sinCos(angle, s, c);
+    return s;
+}
+
+/// Approximate the sine of an angle (radians).
+inline double fastSin(const double angle)
+{
+    double s, c;
+    fasttrig::sinCos(angle, s, c);
+    return s;
+}
+
+/// Approximate the cosine of an angle (radians).
+inline float fastCos(const float angle)
+{
+    float s, c;
+    fasttrig::sinCos(angle, s, c);
+    return c;
+}
+
+/// Approximate the cosine of an angle (radians).
+inline double fastCos(const double angle)
+{
+    double s, c;
+    fasttrig::sinCos(angle, s, c);
+    return c;
+}
+
+/// Approximate the angle (radians) of the vector (x, y) from the +X axis, in the range [-pi, pi].
+/// Equivalent to std::atan2(y, x).
+inline float fastAtan2(const float y, const float x)
+{
+    return fasttrig::atan2(y, x);
+}
+
+/// Approximate the angle (radians) of the vector (x, y) from the +X axis, in the range [-pi, pi].
+/// Equivalent to std::atan2(y, x).
+inline double fastAtan2(const double y, const double x)
+{
+    return fasttrig::atan2(y, x);
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_FastTrig_h
@@ -0,0 +1,357 @@
+#ifndef ail_math_Fixed_h
+#define ail_math_Fixed_h
+
+/** \file Fixed.h
+    \brief Defines a fixed point number type for deterministic calculations.
+
+    Fixed<T_intBits, T_fracBits> stores a signed integer which is scaled by
+     2^T_fracBits, so Fixed<16, 16> covers [-32768, 32768) in steps of 1/65536.
+    Every operation is done with integer arithmetic, so results are
+     bit-identical on every machine and compiler, regardless of floating point
+     settings. That makes it suitable for lockstep simulations. It can be used
+     as the T_ty parameter of Vector2d and Polar:
+
+        typedef Fixed<16, 16> Fx;
+        Vector2d<Fx> v(Fx(3), Fx(4));
+        Polar<Fx> p = v.toPolar();      // Uses sqrt() and atan2() below.
+
+    sqrt() and hypot() use an integer square root, and sin(), cos() and atan2()
+     use CORDIC (see Cordic.h). These are found by argument dependent lookup,
+     so the default trig policy (TrigExact) and Vector2d::getLength() pick them
+     up automatically.
+
+    Notes:
+     - The total number of bits can be at most 32. Intermediate results are
+        calculated in 64 bits, then wrap round (two's complement) if they're out
+        of range, like an unsigned integer would.
+     - Multiplication rounds to the nearest step (halfway cases upwards).
+        Division truncates towards zero, like integer division. Dividing by
+        zero is undefined, as it is for integers.
+     - Squared lengths have to fit in the type, so Vector2d::getSqLength()
+        wraps if a Vector2d<Fixed<16, 16>> is longer than about 181. Lengths
+        use hypot(), which sums the squares in 64 bits, so getLength(),
+        normalise() and toPolar() work for any vector whose length is in range.
+     - The trig functions need T_fracBits <= 30. Internally they're accurate
+        to about 2^-27, so for Fixed<16, 16> the result is within a hair over
+        half a step of the true value. The angle is reduced with a rounded
+        value of 2 pi, so very large angles lose accuracy.
+     - Right shifts of negative numbers are assumed to be arithmetic. That's
+        true of every mainstream compiler, and required from C++20.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cstdint>
+#include <type_traits>
+#include "Config.h"
+#include "Constants.h"
+#include "Cordic.h"
+#include "tmod.h"
+#include "Utils.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/// A signed fixed point number, with T_intBits bits (including the sign) before the point and T_fracBits after.
+/// The class is trivially copyable, and all arithmetic and comparisons are constexpr.
+template <int T_intBits, int T_fracBits>
+class Fixed
+{
+    static_assert(T_intBits >= 1 && T_fracBits >= 0, "Fixed needs at least one integer bit for the sign.");
+    static_assert(T_intBits + T_fracBits <= 32, "Fixed can have at most 32 bits in total.");
+
+public:
+    /// The signed integer type which stores the scaled value.
+    typedef typename std::conditional<(T_intBits + T_fracBits <= 16), std::int16_t, std::int32_t>::type Raw;
+
+    /// The signed integer type used for intermediate results.
+    typedef std::int64_t Wide;
+
+    /// Number of bits before the point, including the sign.
+    static const int intBits = T_intBits;
+
+    /// Number of bits after the point.
+    static const int fracBits = T_fracBits;
+
+//------------------------------------------------------------------------------
+// Construction.
+
+    /// Constructor - initialises to 0.
+    constexpr Fixed() :
+        raw(0)
+    {
+    }
+
+    /// Constructor - converts from an integer. This is exact if the value is in range.
+    template <typename T_int, typename std::enable_if<std::is_integral<T_int>::value, int>::type = 0>
+    constexpr Fixed(const T_int value) :
+        raw(static_cast<Raw>(static_cast<Wide>(value) * scale()))
+    {
+    }
+
+    /// Constructor - converts from floating point, rounding to the nearest step (halfway cases away from zero).
+    /// This is explicit so that floating point can't creep into calculations unnoticed.
+    template <typename T_fp, typename std::enable_if<std::is_floating_point<T_fp>::value, long>::type = 0>
+    explicit constexpr Fixed(const T_fp value) :
+        raw(static_cast<Raw>(value * static_cast<T_fp>(scale()) + ((value < T_fp(0)) ? T_fp(-0.5) : T_fp(0.5))))
+    {
+    }
+
+    /// Make a number directly from its scaled integer value.
+    static constexpr Fixed fromRaw(const Raw value)
+    {
+        return Fixed(value, RawTag());
+    }
+
+    /// Get the smallest positive number, i.e. the size of one step.
+    static constexpr Fixed epsilon()
+    {
+        return fromRaw(1);
+    }
+
+    /// Get the largest number.
+    static constexpr Fixed max()
+    {
+        return fromRaw(static_cast<Raw>((Wide(1) << (T_intBits + T_fracBits - 1)) - 1));
+    }
+
+    /// Get the most negative number.
+    static constexpr Fixed lowest()
+    {
+        return fromRaw(static_cast<Raw>(-(Wide(1) << (T_intBits + T_fracBits - 1))));
+    }
+
+    /// Get the scaled integer value which represents 1.
+    static constexpr Wide scale()
+    {
+        return Wide(1) << T_fracBits;
+    }
+
+
+//------------------------------------------------------------------------------
+// Conversions.
+
+    /// Convert to floating point. This is exact for double.
+    template <typename T_fp, typename std::enable_if<std::is_floating_point<T_fp>::value, int>::type = 0>
+    explicit constexpr operator T_fp() const
+    {
+        return static_cast<T_fp>(raw) / static_cast<T_fp>(scale());
+    }
+
+    /// Convert to an integer, truncating towards zero like a floating point conversion.
+    template <typename T_int, typename std::enable_if<std::is_integral<T_int>::value && !std::is_same<T_int, bool>::value, long>::type = 0>
+    explicit constexpr operator T_int() const
+    {
+        return static_cast<T_int>(raw / scale());
+    }
+
+
+//------------------------------------------------------------------------------
+// Operators.
+// These are defined as friends so that integers are converted implicitly on either side.
+
+    friend constexpr bool operator == (const Fixed lhs, const Fixed rhs) { return lhs.raw == rhs.raw; }
+    friend constexpr bool operator != (const Fixed lhs, const Fixed rhs) { return lhs.raw != rhs.raw; }
+    friend constexpr bool operator < (const Fixed lhs, const Fixed rhs) { return lhs.raw < rhs.raw; }
+    friend constexpr bool operator <= (const Fixed lhs, const Fixed rhs) { return lhs.raw <= rhs.raw; }
+    friend constexpr bool operator > (const Fixed lhs, const Fixed rhs) { return lhs.raw > rhs.raw; }
+    friend constexpr bool operator >= (const Fixed lhs, const Fixed rhs) { return lhs.raw >= rhs.raw; }
+
+    friend constexpr Fixed operator + (const Fixed lhs, const Fixed rhs)
+    {
+        return fromRaw(static_cast<Raw>(static_cast<Wide>(lhs.raw) + rhs.raw));
+    }
+
+    friend constexpr Fixed operator - (const Fixed lhs, const Fixed rhs)
+    {
+        return fromRaw(static_cast<Raw>(static_cast<Wide>(lhs.raw) - rhs.raw));
+    }
+
+    /// Multiplication rounds to the nearest step.
+    friend constexpr Fixed operator * (const Fixed lhs, const Fixed rhs)
+    {
+        return fromRaw(static_cast<Raw>(((static_cast<Wide>(lhs.raw) * rhs.raw) + (scale() >> 1)) >> T_fracBits));
+    }
+
+    /// Division truncates towards zero.
+    friend constexpr Fixed operator / (const Fixed lhs, const Fixed rhs)
+    {
+        return fromRaw(static_cast<Raw>((static_cast<Wide>(lhs.raw) * scale()) / rhs.raw));
+    }
+
+    constexpr Fixed operator - () const
+    {
+        return fromRaw(static_cast<Raw>(-static_cast<Wide>(raw)));
+    }
+
+    constexpr Fixed operator + () const
+    {
+        return *this;
+    }
+
+    AIL_MATH_CONSTEXPR14 Fixed & operator += (const Fixed rhs)
+    {
+        *this = *this + rhs;
+        return *this;
+    }
+
+    AIL_MATH_CONSTEXPR14 Fixed & operator -= (const Fixed rhs)
+    {
+        *this = *this - rhs;
+        return *this;
+    }
+
+    AIL_MATH_CONSTEXPR14 Fixed & operator *= (const Fixed rhs)
+    {
+        *this = *this * rhs;
+        return *this;
+    }
+
+    AIL_MATH_CONSTEXPR14 Fixed & operator /= (const Fixed rhs)
+    {
+        *this = *this / rhs;
+        return *this;
+    }
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// The value multiplied by 2^T_fracBits.
+    Raw raw;
+
+private:
+    /// Distinguishes the raw value constructor from the integer conversion.
+    struct RawTag {};
+
+    constexpr Fixed(const Raw value, RawTag) :
+        raw(value)
+    {
+    }
+};
+
+/// Fixed point numbers are real numbers, so they can be used with pi(), the angle conversions, etc.
+template <int T_intBits, int T_fracBits>
+struct isReal<Fixed<T_intBits, T_fracBits> > : std::true_type
+{
+};
+
+/// Fixed point remainders are exact, like std::fmod. The result has the same sign as numer.
+template <int T_intBits, int T_fracBits>
+struct tmod<Fixed<T_intBits, T_fracBits>, false>
+{
+    /// Pure virtual to prevent instantiation.
+    virtual ~tmod() = 0;
+
+    /// The modulus operation for this structure's type.
+    static inline Fixed<T_intBits, T_fracBits> mod(const Fixed<T_intBits, T_fracBits> numer, const Fixed<T_intBits, T_fracBits> denom)
+    {
+        typedef Fixed<T_intBits, T_fracBits> F;
+        return F::fromRaw(static_cast<typename F::Raw>(numer.raw % denom.raw));
+    }
+};
+
+//-------------------------------------------------------------------------
+// Internal helpers.
+
+namespace fixedpoint {
+
+/// Multiply a value by 2^bits, or divide it (rounding to nearest) if bits is negative.
+inline std::int64_t shiftRound(const std::int64_t value, const int bits)
+{
+    return (bits >= 0) ?
+        value * (std::int64_t(1) << bits) :
+        (value + (std::int64_t(1) << (-bits - 1))) >> -bits;
+}
+
+} // fixedpoint
+
+//-------------------------------------------------------------------------
+// Maths functions.
+// These are found by argument dependent lookup, so generic code can call them
+//  unqualified after "using std::sqrt;" etc.
+
+/// Get the absolute value of a fixed point number.
+template <int T_intBits, int T_fracBits>
+inline constexpr Fixed<T_intBits, T_fracBits> abs(const Fixed<T_intBits, T_fracBits> value)
+{
+    return (value.raw < 0) ? -value : value;
+}
+
+/// Calculate a square root, rounded to the nearest step. Negative values give 0.
+template <int T_intBits, int T_fracBits>
+inline Fixed<T_intBits, T_fracBits> sqrt(const Fixed<T_intBits, T_fracBits> value)
+{
+    typedef Fixed<T_intBits, T_fracBits> F;
+    if (value.raw <= 0)
+        return F();
+
+    // sqrt(raw / 2^f) * 2^f = sqrt(raw * 2^f)
+    const std::uint64_t scaled = static_cast<std::uint64_t>(value.raw) << T_fracBits;
+    std::uint64_t root = intsqrt::fastIsqrt(scaled);
+    if (scaled - (root * root) > root)
+        ++root;
+    return F::fromRaw(static_cast<typename F::Raw>(root));
+}
+
+/// Calculate sqrt((x * x) + (y * y)), rounded to the nearest step.
+/// The squares are summed in 64 bits, so this only wraps if the result itself is out of range.
+template <int T_intBits, int T_fracBits>
+inline Fixed<T_intBits, T_fracBits> hypot(const Fixed<T_intBits, T_fracBits> x, const Fixed<T_intBits, T_fracBits> y)
+{
+    typedef Fixed<T_intBits, T_fracBits> F;
+
+    // sqrt((x / 2^f)^2 + (y / 2^f)^2) * 2^f = sqrt(x^2 + y^2), so raw values can be used as they are.
+    // Each magnitude is at most 2^31, so the sum of squares is at most 2^63.
+    const std::uint64_t a = (x.raw < 0) ? std::uint64_t(0) - static_cast<std::uint64_t>(x.raw) : static_cast<std::uint64_t>(x.raw);
+    const std::uint64_t b = (y.raw < 0) ? std::uint64_t(0) - static_cast<std::uint64_t>(y.raw) : static_cast<std::uint64_t>(y.raw);
+    const std::uint64_t sum = (a * a) + (b * b);
+    std::uint64_t root = intsqrt::fastIsqrt(sum);
+    if (sum - (root * root) > root)
+        ++root;
+    return F::fromRaw(static_cast<typename F::Raw>(root));
+}
+
+/// Calculate the sine of an angle in radians using CORDIC.
+template <int T_intBits, int T_fracBits>
+inline Fixed<T_intBits, T_fracBits> sin(const Fixed<T_intBits, T_fracBits> angle)
+{
+    static_assert(T_fracBits <= cordic::fracBits, "Fixed point trig needs at most 30 fractional bits.");
+    typedef Fixed<T_intBits, T_fracBits> F;
+    std::int64_t s, c;
+    cordic::sinCos<cordic::maxIterations>(fixedpoint::shiftRound(angle.raw, cordic::fracBits - T_fracBits), s, c);
+    return F::fromRaw(static_cast<typename F::Raw>(fixedpoint::shiftRound(s, T_fracBits - cordic::fracBits)));
+}
+
+/// Calculate the cosine of an angle in radians using CORDIC.
+template <int T_intBits, int T_fracBits>
+inline Fixed<T_intBits, T_fracBits> cos(const Fixed<T_intBits, T_fracBits> angle)
+{
+    static_assert(T_fracBits <= cordic::fracBits, "Fixed point trig needs at most 30 fractional bits.");
+    typedef Fixed<T_intBits, T_fracBits> F;
+    std::int64_t s, c;
+    cordic::sinCos<cordic::maxIterations>(fixedpoint::shiftRound(angle.raw, cordic::fracBits - T_fracBits), s, c);
+    return F::fromRaw(static_cast<typename F::Raw>(fixedpoint::shiftRound(c, T_fracBits - cordic::fracBits)));
+}
+
+/// Calculate the angle of the vector (x, y) in radians using CORDIC, in the range [-pi, pi].
+/// As with std::atan2, atan2(0, 0) is 0.
+template <int T_intBits, int T_fracBits>
+inline Fixed<T_intBits, T_fracBits> atan2(const Fixed<T_intBits, T_fracBits> y, const Fixed<T_intBits, T_fracBits> x)
+{
+    static_assert(T_fracBits <= cordic::fracBits, "Fixed point trig needs at most 30 fractional bits.");
+    typedef Fixed<T_intBits, T_fracBits> F;
+    const std::int64_t angle = cordic::atan2<cordic::maxIterations>(y.raw, x.raw);
+    return F::fromRaw(static_cast<typename F::Raw>(fixedpoint::shiftRound(angle, T_fracBits - cordic::fracBits)));
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Fixed_h
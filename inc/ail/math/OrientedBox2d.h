@@ -0,0 +1,130 @@
+#ifndef ail_math_OrientedBox2d_h
+#define ail_math_OrientedBox2d_h
+
+/** \file OrientedBox2d.h
+    \brief Declares a rotated 2d box, with narrow phase collision tests. See OrientedBox2d.inl for implementation.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <type_traits>
+#include "BoundingBox2d.h"
+#include "Contact2d.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+template <typename T_ty> class Capsule2d;
+template <typename T_ty> class Circle2d;
+
+/** A rectangle which can be rotated to any angle.
+It's stored like BoundingBox2d, as a centre position and a radius (half the
+ width and height), plus a unit vector giving the direction of the box's own x
+ axis. Its y axis is axis.getLeftTangent(). With an axis of (1, 0), it covers
+ the same area as the equivalent BoundingBox2d.
+The collision tests work with Circle2d and Capsule2d too. They're all done by
+ the same separating axis test, without allocating any memory (see
+ Contact2d.inl). Touching counts as an intersection.
+Like Vector2d, the class is trivially copyable and can be constructed at compile time.
+Template parameter gives the underlying numerical type, which must be floating point.
+*/
+template <typename T_ty>
+class OrientedBox2d
+{
+public:
+    static_assert(std::is_floating_point<T_ty>::value, "OrientedBox2d is only supported for floating point types.");
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - initialises the position and radius to 0, and aligns the box with the x axis.
+    constexpr OrientedBox2d();
+
+    /// Constructor - explicitly initialises the position, radius and axis.
+    /// The axis must be a unit vector.
+    constexpr OrientedBox2d(const Vector2d<T_ty> & pos, const Vector2d<T_ty> & radius, const Vector2d<T_ty> & axis);
+
+    /// Constructor - makes an oriented box which covers the same area as the given axis-aligned box.
+    constexpr explicit OrientedBox2d(const BoundingBox2d<T_ty> & box);
+
+    /// Make a box which is rotated anticlockwise by the given angle, in radians.
+    static OrientedBox2d<T_ty> fromAngle(const Vector2d<T_ty> & pos, const Vector2d<T_ty> & radius, const T_ty angle);
+
+
+//------------------------------------------------------------------------------
+// Operators.
+
+    /// Equality test.
+    /// Note that this tests for exact equality, which isn't usually desirable for
+    ///  floating point types.
+    constexpr bool operator == (const OrientedBox2d<T_ty> & rhs) const;
+
+    /// Inequality test.
+    /// Note that this tests for (lack of) exact equality, which isn't usually
+    ///  desirable for floating point types.
+    constexpr bool operator != (const OrientedBox2d<T_ty> & rhs) const;
+
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+    /// Get the smallest axis-aligned box which contains this box.
+    BoundingBox2d<T_ty> getBounds() const;
+
+    /// Get one of the corners, in anticlockwise order.
+    /// Index 0 is the corner at -radius.x and -radius.y along the box's own axes.
+    Vector2d<T_ty> getCorner(const unsigned index) const;
+
+
+//------------------------------------------------------------------------------
+// Tests.
+
+    /// Check if the given point is inside (or on the edge of) the box.
+    bool contains(const Vector2d<T_ty> & point) const;
+
+    /// Check if this box intersects a circle.
+    bool intersects(const Circle2d<T_ty> & other) const;
+
+    /// Check if this box intersects a capsule.
+    bool intersects(const Capsule2d<T_ty> & other) const;
+
+    /// Check if this box intersects another oriented box.
+    bool intersects(const OrientedBox2d<T_ty> & other) const;
+
+    /// Check if this box intersects a circle, and get the contact manifold.
+    /// The contact is only set if they intersect. Its normal points from this box to the circle.
+    bool getContact(const Circle2d<T_ty> & other, Contact2d<T_ty> & contact) const;
+
+    /// Check if this box intersects a capsule, and get the contact manifold.
+    /// The contact is only set if they intersect. Its normal points from this box to the capsule.
+    bool getContact(const Capsule2d<T_ty> & other, Contact2d<T_ty> & contact) const;
+
+    /// Check if this box intersects another oriented box, and get the contact manifold.
+    /// The contact is only set if they intersect. Its normal points from this box to the other one.
+    bool getContact(const OrientedBox2d<T_ty> & other, Contact2d<T_ty> & contact) const;
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// Position of the centre.
+    Vector2d<T_ty> pos;
+
+    /// Half the size of the box, along its own x and y axes.
+    Vector2d<T_ty> radius;
+
+    /// Unit vector giving the direction of the box's own x axis.
+    Vector2d<T_ty> axis;
+};
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_OrientedBox2d_h
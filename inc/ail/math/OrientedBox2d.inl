@@ -0,0 +1,137 @@
+#ifndef ail_math_OrientedBox2d_inl
+#define ail_math_OrientedBox2d_inl
+
+/** \file OrientedBox2d.inl
+    \brief Implementation for a rotated 2d box (see OrientedBox2d.h).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cmath>
+#include "BoundingBox2d.inl"
+#include "Contact2d.inl"
+#include "OrientedBox2d.h"
+#include "Vector2d.inl"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+template <typename T_ty>
+constexpr OrientedBox2d<T_ty>::OrientedBox2d() :
+    pos(), radius(), axis(T_ty(1), T_ty(0))
+{
+}
+
+template <typename T_ty>
+constexpr OrientedBox2d<T_ty>::OrientedBox2d(const Vector2d<T_ty> & pos, const Vector2d<T_ty> & radius, const Vector2d<T_ty> & axis) :
+    pos(pos), radius(radius), axis(axis)
+{
+}
+
+template <typename T_ty>
+constexpr OrientedBox2d<T_ty>::OrientedBox2d(const BoundingBox2d<T_ty> & box) :
+    pos(box.pos), radius(box.radius), axis(T_ty(1), T_ty(0))
+{
+}
+
+template <typename T_ty>
+OrientedBox2d<T_ty> OrientedBox2d<T_ty>::fromAngle(const Vector2d<T_ty> & pos, const Vector2d<T_ty> & radius, const T_ty angle)
+{
+    return OrientedBox2d<T_ty>(pos, radius, Vector2d<T_ty>(std::cos(angle), std::sin(angle)));
+}
+
+//------------------------------------------------------------------------------
+// Operators.
+
+template <typename T_ty>
+constexpr bool OrientedBox2d<T_ty>::operator == (const OrientedBox2d<T_ty> & rhs) const
+{
+    return pos == rhs.pos && radius == rhs.radius && axis == rhs.axis;
+}
+
+template <typename T_ty>
+constexpr bool OrientedBox2d<T_ty>::operator != (const OrientedBox2d<T_ty> & rhs) const
+{
+    return !(*this == rhs);
+}
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+template <typename T_ty>
+BoundingBox2d<T_ty> OrientedBox2d<T_ty>::getBounds() const
+{
+    // Each of the box's axes reaches out by its own radius, scaled by how far it points along x or y.
+    const T_ty absX = std::abs(axis.x);
+    const T_ty absY = std::abs(axis.y);
+    return BoundingBox2d<T_ty>(pos.x, pos.y, (absX * radius.x) + (absY * radius.y), (absY * radius.x) + (absX * radius.y));
+}
+
+template <typename T_ty>
+Vector2d<T_ty> OrientedBox2d<T_ty>::getCorner(const unsigned index) const
+{
+    const T_ty x = (index == 1 || index == 2) ? radius.x : -radius.x;
+    const T_ty y = (index >= 2) ? radius.y : -radius.y;
+    return pos + (axis * x) + (axis.getLeftTangent() * y);
+}
+
+//------------------------------------------------------------------------------
+// Tests.
+
+template <typename T_ty>
+bool OrientedBox2d<T_ty>::contains(const Vector2d<T_ty> & point) const
+{
+    // Project the offset onto the box's own axes.
+    const Vector2d<T_ty> offset = point - pos;
+    return std::abs(offset.dot(axis)) <= radius.x && std::abs(offset.dot(axis.getLeftTangent())) <= radius.y;
+}
+
+template <typename T_ty>
+bool OrientedBox2d<T_ty>::intersects(const Circle2d<T_ty> & other) const
+{
+    return contact2d::overlap(contact2d::makeCore(*this), contact2d::makeCore(other));
+}
+
+template <typename T_ty>
+bool OrientedBox2d<T_ty>::intersects(const Capsule2d<T_ty> & other) const
+{
+    return contact2d::overlap(contact2d::makeCore(*this), contact2d::makeCore(other));
+}
+
+template <typename T_ty>
+bool OrientedBox2d<T_ty>::intersects(const OrientedBox2d<T_ty> & other) const
+{
+    return contact2d::overlap(contact2d::makeCore(*this), contact2d::makeCore(other));
+}
+
+template <typename T_ty>
+bool OrientedBox2d<T_ty>::getContact(const Circle2d<T_ty> & other, Contact2d<T_ty> & contact) const
+{
+    return contact2d::collide(contact2d::makeCore(*this), contact2d::makeCore(other), contact);
+}
+
+template <typename T_ty>
+bool OrientedBox2d<T_ty>::getContact(const Capsule2d<T_ty> & other, Contact2d<T_ty> & contact) const
+{
+    return contact2d::collide(contact2d::makeCore(*this), contact2d::makeCore(other), contact);
+}
+
+template <typename T_ty>
+bool OrientedBox2d<T_ty>::getContact(const OrientedBox2d<T_ty> & other, Contact2d<T_ty> & contact) const
+{
+    return contact2d::collide(contact2d::makeCore(*this), contact2d::makeCore(other), contact);
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_OrientedBox2d_inl
@@ -0,0 +1,181 @@
+#ifndef ail_math_ParallelBatch_h
+#define ail_math_ParallelBatch_h
+
+/** \file ParallelBatch.h
+    \brief Parallel versions of common operations on spans of vectors, using ThreadPool.
+
+    Each function splits the span into sub-ranges with parallelFor() or
+     parallelReduce(), and gives exactly the same result as the equivalent
+     serial loop, for any number of threads. The pool defaults to
+     ThreadPool::getDefault().
+    These pay off for large spans, e.g. bulk transforms of point clouds. For a
+     few thousand elements or fewer, the serial loop is usually quicker.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cstddef>
+
+#include "BoundingBox2d.inl"
+#include "Polar.inl"
+#include "ThreadPool.inl"
+#include "TrigPolicy.h"
+#include "Vector2d.inl"
+#include "Vector2dKernels.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+namespace parallelbatch {
+
+/// The corners of the box around a sub-range of points.
+template <typename T_ty>
+struct Bounds
+{
+    Vector2d<T_ty> minCorner;
+    Vector2d<T_ty> maxCorner;
+    bool valid;
+};
+
+/// Get the corners of the box around a non-empty sub-range of points.
+template <typename T_ty>
+inline Bounds<T_ty> getBounds(const Vector2d<T_ty> * points, const std::size_t begin, const std::size_t end)
+{
+    Bounds<T_ty> bounds = { points[begin], points[begin], true };
+    kernels::expandBounds(points + begin + 1, end - begin - 1, bounds.minCorner, bounds.maxCorner);
+    return bounds;
+}
+
+/// Get the corners of the box around a non-empty sub-range of points, stored as separate x and y lanes.
+template <typename T_ty>
+inline Bounds<T_ty> getBounds(const T_ty * x, const T_ty * y, const std::size_t begin, const std::size_t end)
+{
+    const Vector2d<T_ty> first(x[begin], y[begin]);
+    Bounds<T_ty> bounds = { first, first, true };
+    kernels::expandBounds(x + begin + 1, y + begin + 1, end - begin - 1, bounds.minCorner, bounds.maxCorner);
+    return bounds;
+}
+
+/// Merge the bounds of two sub-ranges.
+template <typename T_ty>
+inline Bounds<T_ty> combineBounds(const Bounds<T_ty> & lhs, const Bounds<T_ty> & rhs)
+{
+    if (!lhs.valid)
+        return rhs;
+    if (!rhs.valid)
+        return lhs;
+
+    Bounds<T_ty> bounds = lhs;
+    bounds.minCorner.x = (rhs.minCorner.x < bounds.minCorner.x) ? rhs.minCorner.x : bounds.minCorner.x;
+    bounds.minCorner.y = (rhs.minCorner.y < bounds.minCorner.y) ? rhs.minCorner.y : bounds.minCorner.y;
+    bounds.maxCorner.x = (rhs.maxCorner.x > bounds.maxCorner.x) ? rhs.maxCorner.x : bounds.maxCorner.x;
+    bounds.maxCorner.y = (rhs.maxCorner.y > bounds.maxCorner.y) ? rhs.maxCorner.y : bounds.maxCorner.y;
+    return bounds;
+}
+
+/// The closest point found in a sub-range.
+template <typename T_ty>
+struct Nearest
+{
+    std::size_t index;
+    T_ty sqDistance;
+    bool valid;
+};
+
+/// Keep the closer of two results. The left one wins a tie, which keeps the lowest index.
+template <typename T_ty>
+inline Nearest<T_ty> combineNearest(const Nearest<T_ty> & lhs, const Nearest<T_ty> & rhs)
+{
+    if (!lhs.valid)
+        return rhs;
+    return (rhs.valid && rhs.sqDistance < lhs.sqDistance) ? rhs : lhs;
+}
+
+} // parallelbatch
+
+/// Normalise each vector in place, in parallel.
+/// Equivalent to calling Vector2d::normalise() on each element.
+template <typename T_ty>
+inline void parallelNormalise(Vector2d<T_ty> * vectors, const std::size_t count, ThreadPool & pool = ThreadPool::getDefault())
+{
+    parallelFor(count, [=](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+            vectors[i].normalise();
+    }, pool);
+}
+
+/// Convert each vector to simplified polar coordinates, in parallel.
+/// Equivalent to calling Vector2d::toPolar() on each element, using the same trig policy (see TrigPolicy.h).
+/// The output mustn't overlap the input.
+template <typename T_policy = TrigExact, typename T_ty>
+inline void parallelToPolar(const Vector2d<T_ty> * input, Polar<T_ty> * output, const std::size_t count, ThreadPool & pool = ThreadPool::getDefault())
+{
+    parallelFor(count, [=](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+            input[i].template toPolar<T_policy>(output[i]);
+    }, pool);
+}
+
+/// Get the box which only just contains all of the points, calculated in parallel.
+/// Gives the same box as BoundingBox2d::fromPoints(), which each thread uses on
+///  its own sub-ranges. Returns a box with zero position and size if there are no points.
+template <typename T_ty>
+inline BoundingBox2d<T_ty> parallelBoundingBox(const Vector2d<T_ty> * points, const std::size_t count, ThreadPool & pool = ThreadPool::getDefault())
+{
+    typedef parallelbatch::Bounds<T_ty> Bounds;
+    const Bounds none = { Vector2d<T_ty>(), Vector2d<T_ty>(), false };
+    const Bounds bounds = parallelReduce(count, none,
+        [=](const std::size_t begin, const std::size_t end) { return parallelbatch::getBounds(points, begin, end); },
+        parallelbatch::combineBounds<T_ty>, pool);
+    return bounds.valid ? BoundingBox2d<T_ty>::fromCorners(bounds.minCorner, bounds.maxCorner) : BoundingBox2d<T_ty>();
+}
+
+/// Get the box which only just contains all of the points, stored as separate x and y lanes, calculated in parallel.
+/// See the other version of parallelBoundingBox().
+template <typename T_ty>
+inline BoundingBox2d<T_ty> parallelBoundingBox(const T_ty * x, const T_ty * y, const std::size_t count, ThreadPool & pool = ThreadPool::getDefault())
+{
+    typedef parallelbatch::Bounds<T_ty> Bounds;
+    const Bounds none = { Vector2d<T_ty>(), Vector2d<T_ty>(), false };
+    const Bounds bounds = parallelReduce(count, none,
+        [=](const std::size_t begin, const std::size_t end) { return parallelbatch::getBounds(x, y, begin, end); },
+        parallelbatch::combineBounds<T_ty>, pool);
+    return bounds.valid ? BoundingBox2d<T_ty>::fromCorners(bounds.minCorner, bounds.maxCorner) : BoundingBox2d<T_ty>();
+}
+
+/// Find the point closest to target, searching in parallel.
+/// Distances are compared with Vector2d::getSqDistance(). Returns the index of
+///  the closest point, or count if there are no points. If several points are
+///  equally close, the lowest index is returned.
+template <typename T_ty>
+inline std::size_t parallelFindNearest(const Vector2d<T_ty> * points, const std::size_t count, const Vector2d<T_ty> & target,
+    ThreadPool & pool = ThreadPool::getDefault())
+{
+    typedef parallelbatch::Nearest<T_ty> Nearest;
+    const Nearest none = { count, T_ty(), false };
+    const Nearest nearest = parallelReduce(count, none,
+        [=](const std::size_t begin, const std::size_t end) {
+            Nearest best = { begin, points[begin].getSqDistance(target), true };
+            for (std::size_t i = begin + 1; i < end; ++i) {
+                const T_ty sqDistance = points[i].getSqDistance(target);
+                if (sqDistance < best.sqDistance) {
+                    best.index = i;
+                    best.sqDistance = sqDistance;
+                }
+            }
+            return best;
+        },
+        parallelbatch::combineNearest<T_ty>, pool);
+    return nearest.index;
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_ParallelBatch_h
@@ -9,6 +9,9 @@
     Released open source under the MIT licence.
 */
 
+#include <initializer_list>
+#include "Config.h"
+
 //--------------
 namespace ail {
 namespace math {
@@ -17,11 +20,15 @@ namespace math {
 // Forward declaration to the 2d cartesian vector class. See Vector2.h
 template <typename T_ty> class Vector2d;
 
+// Forward declaration to the default trig policy. See TrigPolicy.h
+struct TrigExact;
+
 /// Declares a 2d polar vector (angle / magnitude).
 /// In an XY cartesian plane, 0 radians points +X, half pi radians (90 degrees) points +Y.
 /// Negative angle and/or magnitude are valid.
 /// Template parameter gives the data type for the angle and magnitude.
 /// Note that this class uses radians so integer types should be avoided.
+/// The class is trivially copyable, and construction and comparison are constexpr.
 template <typename T_ty>
 class Polar
 {
@@ -30,18 +37,21 @@ public:
 // Construction / destruction.
 
     /// Constructor - initialises everything to 0.
-    Polar();
+    constexpr Polar();
 
     /// Constructor - initialises angle and magnitude.
     /// Angle is measured in radians.
-    Polar(const T_ty angle, const T_ty mag);
+    constexpr Polar(const T_ty angle, const T_ty mag);
 
     /// Constructor - initializer list. Components are ordered: angle, magnitude.
     /// If initialiser list is empty then components are initialised to 0.
-    Polar(std::initializer_list<T_ty> args);
+    AIL_MATH_CONSTEXPR14 Polar(std::initializer_list<T_ty> args);
 
     /// Copy constructor.
-    Polar(const Polar<T_ty> & rhs);
+    Polar(const Polar<T_ty> & rhs) = default;
+
+    /// Move constructor.
+    Polar(Polar<T_ty> && rhs) = default;
 
     /// Convert a cartesian coordinate into polar.
     /// This will use the simplest possible representation of a polar angle,
@@ -50,37 +60,39 @@ public:
     explicit Polar(const Vector2d<T_ty> & rhs);
 
     /// Destructor.
-    ~Polar();
+    ~Polar() = default;
 
 
 //------------------------------------------------------------------------------
 // Operators.
 
     /// Assignment operator.
-    Polar<T_ty> & operator = (const Polar<T_ty> & rhs);
+    Polar<T_ty> & operator = (const Polar<T_ty> & rhs) = default;
+    /// Move assignment operator.
+    Polar<T_ty> & operator = (Polar<T_ty> && rhs) = default;
 
     /// Test if this coordinate is exactly equal to another.
     /// Note that this does a simple equality check on the underlying numbers.
     /// It does not check for equivalence, e.g. it will treats 0 radians as being
     ///  not equal to 2 pi radians, even though they are equivalent.
-    bool operator == (const Polar<T_ty> & rhs) const;
+    constexpr bool operator == (const Polar<T_ty> & rhs) const;
 
     /// Test if this coordinate is NOT exactly equal to another.
     /// Note that this does a simple inequality check on the underlying numbers.
     /// It does not check for equivalence, e.g. it will treats 0 radians as being
     ///  not equal to 2 pi radians, even though they are equivalent.
-    bool operator != (const Polar<T_ty> & rhs) const;
+    constexpr bool operator != (const Polar<T_ty> & rhs) const;
 
     /// Negation operator. (Returns a negated copy.)
     /// The returned copy has the magnitude negated. The angle is not changed.
-    Polar<T_ty> operator - () const;
+    constexpr Polar<T_ty> operator - () const;
 
 
 //------------------------------------------------------------------------------
 // Accessors / operations.
 
     /// Set the angle and magnitude in one call.
-    void set(const T_ty angle, const T_ty mag);
+    AIL_MATH_CONSTEXPR14 void set(const T_ty angle, const T_ty mag);
 
     /// Simplify this coordinate in-place (modifies the current object).
     /// This doesn't change the direction/distance represented by the vector,
@@ -98,6 +110,8 @@ public:
     /// This effectively converts both to cartesian coordinates and uses
     ///  a Euclidean distance test.
     /// The sign of dist doesn't matter. Its absolute value will be used.
+    /// The optional template parameter selects the trig policy (see TrigPolicy.h).
+    template <typename T_policy = TrigExact>
     bool isNear(const Polar<T_ty> & other, const T_ty dist) const;
 
     /// Check if this vector is approximately equal to another, within a given margin.
@@ -117,9 +131,13 @@ public:
 // Conversions.
 
     /// Convert this polar coordinate to a cartesian coordinate vector.
+    /// The optional template parameter selects the trig policy (see TrigPolicy.h).
+    template <typename T_policy = TrigExact>
     void toVector2d(Vector2d<T_ty> & output) const;
 
     /// Convert this polar coordinate to a cartesian coordinate vector.
+    /// The optional template parameter selects the trig policy (see TrigPolicy.h).
+    template <typename T_policy = TrigExact>
     Vector2d<T_ty> toVector2d() const;
 
 
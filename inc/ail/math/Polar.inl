@@ -17,6 +17,7 @@
 
 #include "Polar.h"
 #include "Vector2d.h"
+#include "TrigPolicy.h"
 #include "Utils.h"
 #include "Constants.h"
 
@@ -29,20 +30,20 @@ namespace math {
 // Construction / destruction.
 
 template <typename T_ty>
-Polar<T_ty>::Polar() :
+constexpr Polar<T_ty>::Polar() :
     angle(0), mag(0)
 {
 }
 
 template <typename T_ty>
-Polar<T_ty>::Polar(const T_ty angle, const T_ty mag) :
+constexpr Polar<T_ty>::Polar(const T_ty angle, const T_ty mag) :
     angle(angle), mag(mag)
 {
 }
 
 
 template <typename T_ty>
-Polar<T_ty>::Polar(std::initializer_list<T_ty> args) :
+AIL_MATH_CONSTEXPR14 Polar<T_ty>::Polar(std::initializer_list<T_ty> args) :
     Polar()
 {
     if (args.size() == 0)
@@ -55,12 +56,6 @@ Polar<T_ty>::Polar(std::initializer_list<T_ty> args) :
     mag = *(args.begin() + 1);
 }
 
-template <typename T_ty>
-Polar<T_ty>::Polar(const Polar<T_ty> & rhs) :
-    angle(rhs.angle), mag(rhs.mag)
-{
-}
-
 template <typename T_ty>
 Polar<T_ty>::Polar(const Vector2d<T_ty> & rhs) :
     Polar()
@@ -68,36 +63,23 @@ Polar<T_ty>::Polar(const Vector2d<T_ty> & rhs) :
     rhs.toPolar(*this);
 }
 
-template <typename T_ty>
-Polar<T_ty>::~Polar()
-{
-}
-
 //------------------------------------------------------------------------------
 // Operators.
 
 template <typename T_ty>
-Polar<T_ty> & Polar<T_ty>::operator = (const Polar<T_ty> & rhs)
-{
-    angle = rhs.angle;
-    mag = rhs.mag;
-    return *this;
-}
-
-template <typename T_ty>
-bool Polar<T_ty>::operator == (const Polar<T_ty> & rhs) const
+constexpr bool Polar<T_ty>::operator == (const Polar<T_ty> & rhs) const
 {
     return angle == rhs.angle && mag == rhs.mag;
 }
 
 template <typename T_ty>
-bool Polar<T_ty>::operator != (const Polar<T_ty> & rhs) const
+constexpr bool Polar<T_ty>::operator != (const Polar<T_ty> & rhs) const
 {
     return !(angle == rhs.angle && mag == rhs.mag);
 }
 
 template <typename T_ty>
-Polar<T_ty> Polar<T_ty>::operator - () const
+constexpr Polar<T_ty> Polar<T_ty>::operator - () const
 {
     return Polar<T_ty>(angle, -mag);
 }
@@ -106,7 +88,7 @@ Polar<T_ty> Polar<T_ty>::operator - () const
 // Accessors / operations.
 
 template <typename T_ty>
-void Polar<T_ty>::set(const T_ty angle, const T_ty mag)
+AIL_MATH_CONSTEXPR14 void Polar<T_ty>::set(const T_ty angle, const T_ty mag)
 {
     this->angle = angle;
     this->mag = mag;
@@ -122,7 +104,7 @@ void Polar<T_ty>::simplify()
     }
 
     // Make sure the angle is positive and is less than a full circle.
-    angle = wrap(angle, T_ty(0), pi<T_ty>() * T_ty(2));
+    angle = wrapAngle(angle);
 }
 
 template <typename T_ty>
@@ -134,9 +116,10 @@ Polar<T_ty> Polar<T_ty>::getSimplified() const
 }
 
 template <typename T_ty>
+template <typename T_policy>
 bool Polar<T_ty>::isNear(const Polar<T_ty> & other, const T_ty dist) const
 {
-    return toVector2d().isNear(other.toVector2d(), dist);
+    return toVector2d<T_policy>().isNear(other.template toVector2d<T_policy>(), dist);
 }
 
 template <typename T_ty>
@@ -159,20 +142,41 @@ bool Polar<T_ty>::isApproxEqual(const Polar<T_ty> & other, const T_ty angleMargi
 // Conversions.
 
 template <typename T_ty>
+template <typename T_policy>
 void Polar<T_ty>::toVector2d(Vector2d<T_ty> & output) const
 {
-    output.x = mag * std::cos(angle);
-    output.y = mag * std::sin(angle);
+    trigpolicy::toCartesian<T_policy>(angle, mag, output.x, output.y, 0);
 }
 
 template <typename T_ty>
+template <typename T_policy>
 Vector2d<T_ty> Polar<T_ty>::toVector2d() const
 {
     Vector2d<T_ty> output;
-    toVector2d(output);
+    toVector2d<T_policy>(output);
     return output;
 }
 
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+
+/// Instantiates Polar for one type, including the member templates with the
+///  default trig policy.
+/// T_prefix is "template" for an instantiation definition (see src/math/Polar.cpp),
+///  or "extern template" for a declaration.
+/// Polar is only available for floating point types, so there are no integer instantiations.
+#define AIL_MATH_INSTANTIATE_POLAR(T_prefix, T_type) \
+    T_prefix class Polar<T_type>; \
+    T_prefix bool Polar<T_type>::isNear<TrigExact>(const Polar<T_type> &, const T_type) const; \
+    T_prefix void Polar<T_type>::toVector2d<TrigExact>(Vector2d<T_type> &) const; \
+    T_prefix Vector2d<T_type> Polar<T_type>::toVector2d<TrigExact>() const;
+
+// See AIL_MATH_EXTERN_TEMPLATES in Vector2d.inl.
+#if defined(AIL_MATH_EXTERN_TEMPLATES)
+AIL_MATH_INSTANTIATE_POLAR(extern template, float)
+AIL_MATH_INSTANTIATE_POLAR(extern template, double)
+#endif
+
 //--------------
 } // math
 } // ail
@@ -0,0 +1,259 @@
+#ifndef ail_math_PolarBatch_h
+#define ail_math_PolarBatch_h
+
+/** \file PolarBatch.h
+    \brief Batch conversions between cartesian and polar coordinates.
+
+    These convert whole spans of coordinates in one call. For float and double
+     they use the branch-free polynomial approximations from FastTrig.h. Other
+     types fall back to the scalar Vector2d::toPolar() and Polar::toVector2d()
+     functions.
+    Compilers won't vectorise a loop of fastAtan2() calls with the default
+     options, so toPolarBatch dispatches at runtime to an SSE2, AVX2 or AVX-512
+     kernel depending on getSimdLevel() (see Simd.h). The kernels give exactly
+     the same results as the scalar approximation, as long as the compiler isn't
+     allowed to contract multiplies and adds into fused operations. The
+     toCartesianBatch loops are simple enough for the compiler to vectorise.
+
+    Accuracy for float and double, compared to the scalar conversions:
+     - toPolarBatch: magnitudes are identical. Angles are within 3 ulp (float)
+        or 2 ulp (double) of Vector2d::toPolar(), and are simplified in exactly
+        the same way, i.e. magnitude >= 0 and 0 <= angle < 2 pi.
+     - toCartesianBatch: components are within 4 ulp (float) or 3 ulp (double)
+        of Polar::toVector2d() for |angle| <= 1e6 radians.
+    See FastTrig.h for details of the underlying approximations.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "Constants.h"
+#include "FastTrig.h"
+#include "Polar.inl"
+#include "SimdOps.h"
+#include "Vector2d.inl"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+namespace polarbatch {
+
+/// Identifies types which have a fast polynomial implementation.
+template <typename T_ty>
+struct hasFastTrig : std::integral_constant<bool,
+    std::is_same<T_ty, float>::value || std::is_same<T_ty, double>::value>
+{
+};
+
+/// Convert a single cartesian coordinate to simplified polar form without branches.
+/// atan2 returns an angle in [-pi, pi], so simplifying it only needs negative
+///  angles moving up by 2 pi. A tiny negative angle rounds up to exactly 2 pi
+///  though, so that's folded to 0 in the same way as wrapangle::excludePeriod().
+template <typename T_ty>
+inline void toPolar(const T_ty x, const T_ty y, T_ty & angle, T_ty & mag)
+{
+    mag = std::sqrt((x * x) + (y * y));
+    const T_ty period = pi<T_ty>() * T_ty(2);
+    const T_ty a = fastAtan2(y, x);
+    const T_ty wrapped = (a < T_ty(0)) ? a + period : a;
+    angle = (wrapped == period) ? T_ty(0) : wrapped;
+}
+
+/// Convert a single polar coordinate to cartesian form without branches.
+template <typename T_ty>
+inline void toCartesian(const T_ty angle, const T_ty mag, T_ty & x, T_ty & y)
+{
+    T_ty s, c;
+    fastSinCos(angle, s, c);
+    x = mag * c;
+    y = mag * s;
+}
+
+} // polarbatch
+
+namespace kernels {
+
+//------------------------------------------------------------------------------
+// Scalar reference kernels.
+
+namespace scalar {
+
+/// Convert cartesian coordinates to simplified polar coordinates, using the fast approximations.
+template <typename T_ty>
+void toPolar(const T_ty * x, const T_ty * y, T_ty * angle, T_ty * mag, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        polarbatch::toPolar(x[i], y[i], angle[i], mag[i]);
+}
+
+} // scalar
+
+#if defined(AIL_MATH_SIMD_X86)
+
+//------------------------------------------------------------------------------
+// SIMD kernels. The bodies are shared by every instruction set.
+
+AIL_MATH_SIMD_TARGET_BEGIN("sse2")
+namespace sse2 {
+#include "PolarBatchImpl.inl"
+} // sse2
+AIL_MATH_SIMD_TARGET_END
+
+AIL_MATH_SIMD_TARGET_BEGIN("avx2")
+namespace avx2 {
+#include "PolarBatchImpl.inl"
+} // avx2
+AIL_MATH_SIMD_TARGET_END
+
+#if defined(AIL_MATH_SIMD_AVX512)
+AIL_MATH_SIMD_TARGET_BEGIN("avx512f")
+namespace avx512 {
+#include "PolarBatchImpl.inl"
+} // avx512
+AIL_MATH_SIMD_TARGET_END
+#endif // AIL_MATH_SIMD_AVX512
+
+#endif // AIL_MATH_SIMD_X86
+
+//------------------------------------------------------------------------------
+// Dispatching kernels.
+
+/// Convert cartesian coordinates to simplified polar coordinates, using the fast approximations.
+inline void toPolar(const float * x, const float * y, float * angle, float * mag, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(toPolar, float, (x, y, angle, mag, count))
+}
+
+/// Convert cartesian coordinates to simplified polar coordinates, using the fast approximations.
+inline void toPolar(const double * x, const double * y, double * angle, double * mag, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(toPolar, double, (x, y, angle, mag, count))
+}
+
+} // kernels
+
+namespace polarbatch {
+
+/// Number of vectors staged on the stack at a time when converting arrays of structures.
+const std::size_t stagingSize = 256;
+
+template <typename T_ty>
+inline void toPolarSoA(const T_ty * x, const T_ty * y, T_ty * angle, T_ty * mag, const std::size_t count, std::true_type)
+{
+    kernels::toPolar(x, y, angle, mag, count);
+}
+
+template <typename T_ty>
+inline void toPolarSoA(const T_ty * x, const T_ty * y, T_ty * angle, T_ty * mag, const std::size_t count, std::false_type)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const Polar<T_ty> p = Vector2d<T_ty>(x[i], y[i]).toPolar();
+        angle[i] = p.angle;
+        mag[i] = p.mag;
+    }
+}
+
+template <typename T_ty>
+inline void toPolarAoS(const Vector2d<T_ty> * input, Polar<T_ty> * output, const std::size_t count, std::true_type)
+{
+    // Split the components into lanes for the SIMD kernel, a block at a time.
+    T_ty x[stagingSize], y[stagingSize], angle[stagingSize], mag[stagingSize];
+    for (std::size_t start = 0; start < count; start += stagingSize) {
+        const std::size_t n = (count - start < stagingSize) ? count - start : stagingSize;
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = input[start + i].x;
+            y[i] = input[start + i].y;
+        }
+        kernels::toPolar(x, y, angle, mag, n);
+        for (std::size_t i = 0; i < n; ++i)
+            output[start + i].set(angle[i], mag[i]);
+    }
+}
+
+template <typename T_ty>
+inline void toPolarAoS(const Vector2d<T_ty> * input, Polar<T_ty> * output, const std::size_t count, std::false_type)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        input[i].toPolar(output[i]);
+}
+
+template <typename T_ty>
+inline void toCartesianSoA(const T_ty * angle, const T_ty * mag, T_ty * x, T_ty * y, const std::size_t count, std::true_type)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        toCartesian(angle[i], mag[i], x[i], y[i]);
+}
+
+template <typename T_ty>
+inline void toCartesianSoA(const T_ty * angle, const T_ty * mag, T_ty * x, T_ty * y, const std::size_t count, std::false_type)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const Vector2d<T_ty> v = Polar<T_ty>(angle[i], mag[i]).toVector2d();
+        x[i] = v.x;
+        y[i] = v.y;
+    }
+}
+
+template <typename T_ty>
+inline void toCartesianAoS(const Polar<T_ty> * input, Vector2d<T_ty> * output, const std::size_t count, std::true_type)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        toCartesian(input[i].angle, input[i].mag, output[i].x, output[i].y);
+}
+
+template <typename T_ty>
+inline void toCartesianAoS(const Polar<T_ty> * input, Vector2d<T_ty> * output, const std::size_t count, std::false_type)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        input[i].toVector2d(output[i]);
+}
+
+} // polarbatch
+
+/// Convert a span of cartesian coordinates to simplified polar coordinates.
+/// Input and output are given as separate component lanes (structure of arrays).
+/// Each output angle will be in the range 0 <= angle < 2 pi, and each magnitude will be positive.
+/// The output may not overlap the input.
+template <typename T_ty>
+inline void toPolarBatch(const T_ty * x, const T_ty * y, T_ty * angle, T_ty * mag, const std::size_t count)
+{
+    polarbatch::toPolarSoA(x, y, angle, mag, count, polarbatch::hasFastTrig<T_ty>());
+}
+
+/// Convert a span of cartesian vectors to simplified polar coordinates.
+/// Each output angle will be in the range 0 <= angle < 2 pi, and each magnitude will be positive.
+template <typename T_ty>
+inline void toPolarBatch(const Vector2d<T_ty> * input, Polar<T_ty> * output, const std::size_t count)
+{
+    polarbatch::toPolarAoS(input, output, count, polarbatch::hasFastTrig<T_ty>());
+}
+
+/// Convert a span of polar coordinates to cartesian coordinates.
+/// Input and output are given as separate component lanes (structure of arrays).
+/// The output may not overlap the input.
+template <typename T_ty>
+inline void toCartesianBatch(const T_ty * angle, const T_ty * mag, T_ty * x, T_ty * y, const std::size_t count)
+{
+    polarbatch::toCartesianSoA(angle, mag, x, y, count, polarbatch::hasFastTrig<T_ty>());
+}
+
+/// Convert a span of polar coordinates to cartesian vectors.
+template <typename T_ty>
+inline void toCartesianBatch(const Polar<T_ty> * input, Vector2d<T_ty> * output, const std::size_t count)
+{
+    polarbatch::toCartesianAoS(input, output, count, polarbatch::hasFastTrig<T_ty>());
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_PolarBatch_h
@@ -0,0 +1,104 @@
+/** \file PolarBatchImpl.inl
+    \brief Generic bodies of the SIMD batch kernels for converting to polar coordinates. (Intended for internal use by the library.)
+
+    NOTE: This file deliberately has no include guard. PolarBatch.h includes it
+     once inside each instruction set namespace, where the Ops<T_ty> structure
+     from SimdOps.h wraps that instruction set's intrinsics. Don't include it
+     anywhere else.
+
+    Each kernel processes as many whole registers as possible, then hands the
+     remaining elements to the scalar reference kernel. The arithmetic and
+     comparisons are done in the same order as the scalar functions in
+     FastTrig.h so that results are identical.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+/// Approximate atan(t) for 0 <= t <= 1 in each lane, in exactly the same way as fasttrig::atanUnit().
+inline Ops<float>::V atanUnitLanes(const Ops<float>::V t)
+{
+    typedef Ops<float> F;
+    typedef F::V V;
+
+    const F::M big = F::lt(F::set1(0.4142135623730950f), t);
+    const V c = F::select(big, F::set1(1.0f), F::set1(0.0f));
+    const V u = F::div(F::sub(t, c), F::add(F::mul(c, t), F::set1(1.0f)));
+    const V base = F::select(big, F::set1(0.785398163397448f), F::set1(0.0f));
+    const V z = F::mul(u, u);
+    V p = F::sub(F::mul(F::set1(8.05374449538e-2f), z), F::set1(1.38776856032e-1f));
+    p = F::add(F::mul(p, z), F::set1(1.99777106478e-1f));
+    p = F::mul(F::sub(F::mul(p, z), F::set1(3.33329491539e-1f)), z);
+    return F::add(base, F::add(F::mul(u, p), u));
+}
+
+/// Approximate atan(t) for 0 <= t <= 1 in each lane, in exactly the same way as fasttrig::atanUnit().
+inline Ops<double>::V atanUnitLanes(const Ops<double>::V t)
+{
+    typedef Ops<double> D;
+    typedef D::V V;
+
+    const D::M big = D::lt(D::set1(0.66), t);
+    const V c = D::select(big, D::set1(1.0), D::set1(0.0));
+    const V u = D::div(D::sub(t, c), D::add(D::mul(c, t), D::set1(1.0)));
+    const V base = D::select(big, D::set1(7.85398163397448309616e-1), D::set1(0.0));
+    const V extra = D::select(big, D::set1(3.06161699786838301793e-17), D::set1(0.0));
+    const V z = D::mul(u, u);
+    V p = D::sub(D::mul(D::set1(-8.750608600031904122785e-1), z), D::set1(1.615753718733365076637e1));
+    p = D::sub(D::mul(p, z), D::set1(7.500855792314704667340e1));
+    p = D::sub(D::mul(p, z), D::set1(1.228866684490136173410e2));
+    p = D::mul(D::sub(D::mul(p, z), D::set1(6.485021904942025371773e1)), z);
+    V q = D::add(z, D::set1(2.485846490142306297962e1));
+    q = D::add(D::mul(q, z), D::set1(1.650270098316988542046e2));
+    q = D::add(D::mul(q, z), D::set1(4.328810604912902668951e2));
+    q = D::add(D::mul(q, z), D::set1(4.853903996359136964868e2));
+    q = D::add(D::mul(q, z), D::set1(1.945506571482613964425e2));
+    return D::add(base, D::add(D::add(D::mul(u, D::div(p, q)), u), extra));
+}
+
+/// Approximate atan2(y, x) in each lane, in exactly the same way as fastAtan2().
+template <typename T_ty>
+inline typename Ops<T_ty>::V atan2Lanes(const typename Ops<T_ty>::V y, const typename Ops<T_ty>::V x)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+    typedef typename O::M M;
+
+    // See fasttrig::atan2Ratio(). hi can't be negative, so it's 0 wherever it's <= 0.
+    const V ax = O::abs(x);
+    const V ay = O::abs(y);
+    const M xBigger = O::lt(ay, ax);
+    const V hi = O::select(xBigger, ax, ay);
+    const V lo = O::select(xBigger, ay, ax);
+    const V ratio = O::div(lo, O::select(O::le(hi, O::set1(T_ty(0))), O::set1(T_ty(1)), hi));
+
+    // See fasttrig::atan2Octant(). Multiplying by -1 negates zero in the same way as unary minus.
+    V angle = atanUnitLanes(ratio);
+    angle = O::select(O::lt(ax, ay), O::sub(O::set1(pi<T_ty>() * T_ty(0.5)), angle), angle);
+    angle = O::select(O::lt(x, O::set1(T_ty(0))), O::sub(O::set1(pi<T_ty>()), angle), angle);
+    return O::select(O::lt(y, O::set1(T_ty(0))), O::mul(angle, O::set1(T_ty(-1))), angle);
+}
+
+/// Convert cartesian coordinates to simplified polar coordinates.
+template <typename T_ty>
+void toPolar(const T_ty * x, const T_ty * y, T_ty * angle, T_ty * mag, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    const V zero = O::set1(T_ty(0));
+    const V period = O::set1(pi<T_ty>() * T_ty(2));
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width) {
+        const V vx = O::load(x + i);
+        const V vy = O::load(y + i);
+        const V a = atan2Lanes<T_ty>(vy, vx);
+        O::store(mag + i, O::sqrt(O::add(O::mul(vx, vx), O::mul(vy, vy))));
+        // The wrapped angle can't be above the period, so this folds it to 0 exactly where the scalar version does.
+        const V wrapped = O::select(O::lt(a, zero), O::add(a, period), a);
+        O::store(angle + i, O::select(O::le(period, wrapped), zero, wrapped));
+    }
+    scalar::toPolar(x + i, y + i, angle + i, mag + i, count - i);
+}
@@ -0,0 +1,234 @@
+#ifndef ail_math_Quadtree_h
+#define ail_math_Quadtree_h
+
+/** \file Quadtree.h
+    \brief Declares a quadtree spatial index of points. See Quadtree.inl for implementation.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cstddef>
+#include <vector>
+#include "BoundingBox2d.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/** A quadtree spatial index of points, each carrying a payload.
+The tree covers a fixed area, given as a BoundingBox2d on construction. Leaf
+ nodes are split into four quadrants when they hold more than a given number of
+ items, and sibling leaves are merged again when items are removed.
+Nodes are split exactly at their midpoint, so items are never lost to rounding
+ errors in the node bounds.
+Nodes and items are pooled in contiguous arrays, rather than being allocated
+ individually. Each item is identified by a handle, which stays valid until the
+ item is removed (even if it moves).
+Template parameter T_ty gives the underlying numerical type (e.g. float or double).
+Template parameter T_payload gives the type of data stored with each point.
+ It must be default constructible and copyable.
+*/
+template <typename T_ty, typename T_payload>
+class Quadtree
+{
+public:
+    /// Identifies an item in the tree.
+    typedef std::size_t Handle;
+
+    /// A handle value which never refers to an item.
+    static const Handle invalidHandle = static_cast<Handle>(-1);
+
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - creates an empty tree covering the given area.
+    /// maxItemsPerNode is the number of items a leaf node can hold before it is split.
+    /// maxDepth limits how many times nodes can be split. Leaves at the maximum
+    ///  depth will hold any number of items.
+    /// Throws std::invalid_argument if maxItemsPerNode is 0.
+    explicit Quadtree(const BoundingBox2d<T_ty> & bounds, const std::size_t maxItemsPerNode = 8, const std::size_t maxDepth = 16);
+
+
+//------------------------------------------------------------------------------
+// Modifiers.
+
+    /// Insert a point with the given payload, and return its handle.
+    /// Throws std::out_of_range if the position is outside the tree's bounds.
+    Handle insert(const Vector2d<T_ty> & pos, const T_payload & payload);
+
+    /// Remove an item from the tree. Its handle may then be reused by a later insertion.
+    /// Throws std::invalid_argument if the handle doesn't refer to an item.
+    void remove(const Handle handle);
+
+    /// Move an item to a new position.
+    /// This is cheap if the item stays within the same leaf node.
+    /// Throws std::invalid_argument if the handle doesn't refer to an item, or
+    ///  std::out_of_range if the new position is outside the tree's bounds.
+    void move(const Handle handle, const Vector2d<T_ty> & pos);
+
+    /// Remove all items. This keeps the allocated storage.
+    void clear();
+
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+    /// Get the area covered by the tree.
+    const BoundingBox2d<T_ty> & getBounds() const;
+
+    /// Get the number of items in the tree.
+    std::size_t size() const;
+
+    /// Check if the tree has no items.
+    bool empty() const;
+
+    /// Check if a handle refers to an item currently in the tree.
+    bool contains(const Handle handle) const;
+
+    /// Get the position of an item.
+    /// The handle must refer to an item currently in the tree.
+    const Vector2d<T_ty> & getPosition(const Handle handle) const;
+
+    /// Get the payload of an item.
+    /// The handle must refer to an item currently in the tree.
+    T_payload & getPayload(const Handle handle);
+    /// Get the payload of an item.
+    /// The handle must refer to an item currently in the tree.
+    const T_payload & getPayload(const Handle handle) const;
+
+
+//------------------------------------------------------------------------------
+// Queries.
+// These append their results to the output container, without clearing it first.
+
+    /// Find all items within the given box, as determined by BoundingBox2d::contains().
+    void queryBox(const BoundingBox2d<T_ty> & box, std::vector<Handle> & output) const;
+
+    /// Find all items within a certain distance of the given point.
+    /// This gives the same results as calling Vector2d::isNear() on every item.
+    void queryRadius(const Vector2d<T_ty> & point, const T_ty dist, std::vector<Handle> & output) const;
+
+    /// Find the k items nearest to the given point.
+    /// They are output in order of increasing distance. Items at equal
+    ///  distances are ordered by handle. Fewer than k items will be output if
+    ///  the tree doesn't contain enough.
+    void kNearest(const Vector2d<T_ty> & point, const std::size_t k, std::vector<Handle> & output) const;
+
+
+private:
+//------------------------------------------------------------------------------
+// Internal types.
+
+    /// A node of the tree.
+    struct Node
+    {
+        /// Corner of the area covered by this node with the lowest coordinates.
+        Vector2d<T_ty> min;
+        /// Corner of the area covered by this node with the highest coordinates.
+        /// The area is closed, i.e. it includes points on all four edges.
+        Vector2d<T_ty> max;
+        /// Index of the parent node, or npos for the root.
+        std::size_t parent;
+        /// Index of the first of four consecutive children, or npos for a leaf.
+        std::size_t firstChild;
+        /// Index of the first item in a leaf's list, or npos if there are none.
+        std::size_t firstItem;
+        /// Number of items in this node and all its descendants.
+        std::size_t count;
+        /// Depth of this node, where the root is 0.
+        std::size_t depth;
+    };
+
+    /// An item stored in the tree.
+    /// Items in a leaf form a doubly linked list, so they can be unlinked in constant time.
+    struct Item
+    {
+        /// Position of the item.
+        Vector2d<T_ty> pos;
+        /// Data stored with the item.
+        T_payload payload;
+        /// Index of the leaf node containing this item, or npos if this item slot is free.
+        std::size_t node;
+        /// Previous item in the same leaf, or npos.
+        std::size_t prev;
+        /// Next item in the same leaf (or next free item slot), or npos.
+        std::size_t next;
+    };
+
+    /// Index value meaning "none".
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+    /// Throw std::out_of_range if the position is outside the tree's bounds.
+    void checkBounds(const Vector2d<T_ty> & pos) const;
+
+    /// Throw std::invalid_argument if the handle doesn't refer to an item.
+    void checkHandle(const Handle handle) const;
+
+    /// Get the index of the child of a node which should contain the given position.
+    std::size_t getChild(const std::size_t node, const Vector2d<T_ty> & pos) const;
+
+    /// Check if the area covered by a node contains the given position.
+    bool nodeContains(const std::size_t node, const Vector2d<T_ty> & pos) const;
+
+    /// Link an item into the tree, splitting the leaf if necessary.
+    void link(const std::size_t item);
+
+    /// Unlink an item from its leaf, merging nodes if possible.
+    void unlink(const std::size_t item);
+
+    /// Add an item to a leaf's list (without changing any counts).
+    void pushItem(const std::size_t node, const std::size_t item);
+
+    /// Split a leaf into four children, and distribute its items between them.
+    void split(const std::size_t node);
+
+    /// Merge the children of a node back into it, if they are all leaves and
+    ///  there are few enough items. Repeats for the ancestors.
+    void tryMerge(std::size_t node);
+
+    /// Get the squared distance from a point to the nearest part of a node's area.
+    /// This never exceeds the squared distance to any item within the node, even allowing for rounding.
+    T_ty getSqDistance(const std::size_t node, const Vector2d<T_ty> & point) const;
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// Pool of nodes. Children are always allocated as blocks of four.
+    /// Node 0 is the root.
+    std::vector<Node> m_nodes;
+
+    /// Indices of the first node in unused blocks of four.
+    std::vector<std::size_t> m_freeNodeBlocks;
+
+    /// Pool of items, indexed by handle.
+    std::vector<Item> m_items;
+
+    /// Index of the first free item slot, or npos.
+    std::size_t m_freeItem;
+
+    /// Maximum number of items in a leaf before it gets split.
+    std::size_t m_maxItemsPerNode;
+
+    /// Maximum depth of any node.
+    std::size_t m_maxDepth;
+
+    /// Area covered by the tree.
+    BoundingBox2d<T_ty> m_bounds;
+};
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Quadtree_h
@@ -0,0 +1,472 @@
+#ifndef ail_math_Quadtree_inl
+#define ail_math_Quadtree_inl
+
+/** \file Quadtree.inl
+    \brief Implementation for a quadtree spatial index of points (see Quadtree.h).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+#include "Quadtree.h"
+#include "BoundingBox2d.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+template <typename T_ty, typename T_payload>
+const typename Quadtree<T_ty, T_payload>::Handle Quadtree<T_ty, T_payload>::invalidHandle;
+
+template <typename T_ty, typename T_payload>
+const std::size_t Quadtree<T_ty, T_payload>::npos;
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+template <typename T_ty, typename T_payload>
+Quadtree<T_ty, T_payload>::Quadtree(const BoundingBox2d<T_ty> & bounds, const std::size_t maxItemsPerNode, const std::size_t maxDepth) :
+    m_nodes(),
+    m_freeNodeBlocks(),
+    m_items(),
+    m_freeItem(npos),
+    m_maxItemsPerNode(maxItemsPerNode),
+    m_maxDepth(maxDepth),
+    m_bounds(bounds)
+{
+    if (maxItemsPerNode == 0)
+        throw std::invalid_argument("Quadtree nodes must be able to hold at least 1 item.");
+
+    clear();
+}
+
+//------------------------------------------------------------------------------
+// Modifiers.
+
+template <typename T_ty, typename T_payload>
+typename Quadtree<T_ty, T_payload>::Handle Quadtree<T_ty, T_payload>::insert(const Vector2d<T_ty> & pos, const T_payload & payload)
+{
+    checkBounds(pos);
+
+    // Reuse a free item slot if there is one.
+    std::size_t item = m_freeItem;
+    if (item != npos) {
+        m_freeItem = m_items[item].next;
+    } else {
+        item = m_items.size();
+        m_items.push_back(Item());
+    }
+
+    m_items[item].pos = pos;
+    m_items[item].payload = payload;
+    link(item);
+    return item;
+}
+
+template <typename T_ty, typename T_payload>
+void Quadtree<T_ty, T_payload>::remove(const Handle handle)
+{
+    checkHandle(handle);
+    unlink(handle);
+
+    Item & item = m_items[handle];
+    item.payload = T_payload();
+    item.node = npos;
+    item.prev = npos;
+    item.next = m_freeItem;
+    m_freeItem = handle;
+}
+
+template <typename T_ty, typename T_payload>
+void Quadtree<T_ty, T_payload>::move(const Handle handle, const Vector2d<T_ty> & pos)
+{
+    checkHandle(handle);
+    checkBounds(pos);
+
+    // Don't restructure anything if the item stays within the same leaf.
+    if (nodeContains(m_items[handle].node, pos)) {
+        m_items[handle].pos = pos;
+        return;
+    }
+
+    unlink(handle);
+    m_items[handle].pos = pos;
+    link(handle);
+}
+
+template <typename T_ty, typename T_payload>
+void Quadtree<T_ty, T_payload>::clear()
+{
+    m_nodes.resize(1);
+    m_freeNodeBlocks.clear();
+    m_items.clear();
+    m_freeItem = npos;
+
+    Node & root = m_nodes[0];
+    root.min = m_bounds.getCornerX1Y1();
+    root.max = m_bounds.getCornerX2Y2();
+    root.parent = npos;
+    root.firstChild = npos;
+    root.firstItem = npos;
+    root.count = 0;
+    root.depth = 0;
+}
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+template <typename T_ty, typename T_payload>
+const BoundingBox2d<T_ty> & Quadtree<T_ty, T_payload>::getBounds() const
+{
+    return m_bounds;
+}
+
+template <typename T_ty, typename T_payload>
+std::size_t Quadtree<T_ty, T_payload>::size() const
+{
+    return m_nodes[0].count;
+}
+
+template <typename T_ty, typename T_payload>
+bool Quadtree<T_ty, T_payload>::empty() const
+{
+    return m_nodes[0].count == 0;
+}
+
+template <typename T_ty, typename T_payload>
+bool Quadtree<T_ty, T_payload>::contains(const Handle handle) const
+{
+    return handle < m_items.size() && m_items[handle].node != npos;
+}
+
+template <typename T_ty, typename T_payload>
+const Vector2d<T_ty> & Quadtree<T_ty, T_payload>::getPosition(const Handle handle) const
+{
+    assert(contains(handle));
+    return m_items[handle].pos;
+}
+
+template <typename T_ty, typename T_payload>
+T_payload & Quadtree<T_ty, T_payload>::getPayload(const Handle handle)
+{
+    assert(contains(handle));
+    return m_items[handle].payload;
+}
+
+template <typename T_ty, typename T_payload>
+const T_payload & Quadtree<T_ty, T_payload>::getPayload(const Handle handle) const
+{
+    assert(contains(handle));
+    return m_items[handle].payload;
+}
+
+//------------------------------------------------------------------------------
+// Queries.
+
+template <typename T_ty, typename T_payload>
+void Quadtree<T_ty, T_payload>::queryBox(const BoundingBox2d<T_ty> & box, std::vector<Handle> & output) const
+{
+    // The corners are calculated the same way as BoundingBox2d::contains(),
+    //  so no node is skipped if it has an item which the box contains.
+    const Vector2d<T_ty> boxMin = box.getCornerX1Y1();
+    const Vector2d<T_ty> boxMax = box.getCornerX2Y2();
+
+    std::vector<std::size_t> stack(1, 0);
+    while (!stack.empty()) {
+        const Node & node = m_nodes[stack.back()];
+        stack.pop_back();
+
+        if (node.count == 0 ||
+            node.max.x < boxMin.x || node.min.x > boxMax.x ||
+            node.max.y < boxMin.y || node.min.y > boxMax.y)
+            continue;
+
+        if (node.firstChild != npos) {
+            for (std::size_t i = 0; i < 4; ++i)
+                stack.push_back(node.firstChild + i);
+            continue;
+        }
+
+        for (std::size_t item = node.firstItem; item != npos; item = m_items[item].next) {
+            if (box.contains(m_items[item].pos))
+                output.push_back(item);
+        }
+    }
+}
+
+template <typename T_ty, typename T_payload>
+void Quadtree<T_ty, T_payload>::queryRadius(const Vector2d<T_ty> & point, const T_ty dist, std::vector<Handle> & output) const
+{
+    const T_ty sqDist = dist * dist;
+
+    std::vector<std::size_t> stack(1, 0);
+    while (!stack.empty()) {
+        const std::size_t index = stack.back();
+        const Node & node = m_nodes[index];
+        stack.pop_back();
+
+        if (node.count == 0 || getSqDistance(index, point) > sqDist)
+            continue;
+
+        if (node.firstChild != npos) {
+            for (std::size_t i = 0; i < 4; ++i)
+                stack.push_back(node.firstChild + i);
+            continue;
+        }
+
+        for (std::size_t item = node.firstItem; item != npos; item = m_items[item].next) {
+            if (m_items[item].pos.isNear(point, dist))
+                output.push_back(item);
+        }
+    }
+}
+
+template <typename T_ty, typename T_payload>
+void Quadtree<T_ty, T_payload>::kNearest(const Vector2d<T_ty> & point, const std::size_t k, std::vector<Handle> & output) const
+{
+    if (k == 0)
+        return;
+
+    // Nodes are visited nearest first. The best k items found so far are kept
+    //  in a max-heap, so the furthest of them can be replaced quickly.
+    typedef std::pair<T_ty, std::size_t> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> nodes;
+    std::priority_queue<Entry> best;
+
+    nodes.push(Entry(getSqDistance(0, point), 0));
+    while (!nodes.empty()) {
+        const Entry next = nodes.top();
+        nodes.pop();
+
+        // Stop when no remaining node could hold anything nearer than the current k.
+        if (best.size() == k && next.first > best.top().first)
+            break;
+
+        const Node & node = m_nodes[next.second];
+        if (node.count == 0)
+            continue;
+
+        if (node.firstChild != npos) {
+            for (std::size_t i = 0; i < 4; ++i)
+                nodes.push(Entry(getSqDistance(node.firstChild + i, point), node.firstChild + i));
+            continue;
+        }
+
+        for (std::size_t item = node.firstItem; item != npos; item = m_items[item].next) {
+            const Entry candidate(m_items[item].pos.getSqDistance(point), item);
+            if (best.size() < k) {
+                best.push(candidate);
+            } else if (candidate < best.top()) {
+                best.pop();
+                best.push(candidate);
+            }
+        }
+    }
+
+    // The heap gives the furthest first, so fill the output in reverse.
+    const std::size_t start = output.size();
+    output.resize(start + best.size());
+    for (std::size_t i = output.size(); i > start; --i) {
+        output[i - 1] = best.top().second;
+        best.pop();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+template <typename T_ty, typename T_payload>
+void Quadtree<T_ty, T_payload>::checkBounds(const Vector2d<T_ty> & pos) const
+{
+    if (!nodeContains(0, pos))
+        throw std::out_of_range("Position is outside the quadtree bounds.");
+}
+
+template <typename T_ty, typename T_payload>
+void Quadtree<T_ty, T_payload>::checkHandle(const Handle handle) const
+{
+    if (!contains(handle))
+        throw std::invalid_argument("Handle does not refer to an item in the quadtree.");
+}
+
+template <typename T_ty, typename T_payload>
+std::size_t Quadtree<T_ty, T_payload>::getChild(const std::size_t node, const Vector2d<T_ty> & pos) const
+{
+    // Children are ordered: -X-Y, +X-Y, -X+Y, +X+Y.
+    // A child's midpoint is its lower sibling's max, and its upper sibling's min.
+    const Node & n = m_nodes[node];
+    const Vector2d<T_ty> & mid = m_nodes[n.firstChild].max;
+    return n.firstChild + ((pos.x >= mid.x) ? 1 : 0) + ((pos.y >= mid.y) ? 2 : 0);
+}
+
+template <typename T_ty, typename T_payload>
+bool Quadtree<T_ty, T_payload>::nodeContains(const std::size_t node, const Vector2d<T_ty> & pos) const
+{
+    const Node & n = m_nodes[node];
+    return
+        pos.x >= n.min.x && pos.y >= n.min.y &&
+        pos.x <= n.max.x && pos.y <= n.max.y;
+}
+
+template <typename T_ty, typename T_payload>
+void Quadtree<T_ty, T_payload>::link(const std::size_t item)
+{
+    // Descend to the leaf, counting the new item in each node on the way.
+    std::size_t node = 0;
+    ++m_nodes[node].count;
+    while (m_nodes[node].firstChild != npos) {
+        node = getChild(node, m_items[item].pos);
+        ++m_nodes[node].count;
+    }
+
+    pushItem(node, item);
+
+    if (m_nodes[node].count > m_maxItemsPerNode && m_nodes[node].depth < m_maxDepth)
+        split(node);
+}
+
+template <typename T_ty, typename T_payload>
+void Quadtree<T_ty, T_payload>::unlink(const std::size_t item)
+{
+    Item & it = m_items[item];
+    const std::size_t leaf = it.node;
+
+    if (it.prev != npos)
+        m_items[it.prev].next = it.next;
+    else
+        m_nodes[leaf].firstItem = it.next;
+
+    if (it.next != npos)
+        m_items[it.next].prev = it.prev;
+
+    it.prev = npos;
+    it.next = npos;
+
+    for (std::size_t node = leaf; node != npos; node = m_nodes[node].parent)
+        --m_nodes[node].count;
+
+    tryMerge(m_nodes[leaf].parent);
+}
+
+template <typename T_ty, typename T_payload>
+void Quadtree<T_ty, T_payload>::pushItem(const std::size_t node, const std::size_t item)
+{
+    Item & it = m_items[item];
+    it.node = node;
+    it.prev = npos;
+    it.next = m_nodes[node].firstItem;
+
+    if (it.next != npos)
+        m_items[it.next].prev = item;
+
+    m_nodes[node].firstItem = item;
+}
+
+template <typename T_ty, typename T_payload>
+void Quadtree<T_ty, T_payload>::split(const std::size_t node)
+{
+    // Get a block of four nodes. Note that this can reallocate the node pool.
+    std::size_t first;
+    if (!m_freeNodeBlocks.empty()) {
+        first = m_freeNodeBlocks.back();
+        m_freeNodeBlocks.pop_back();
+    } else {
+        first = m_nodes.size();
+        m_nodes.resize(first + 4);
+    }
+
+    const Vector2d<T_ty> min = m_nodes[node].min;
+    const Vector2d<T_ty> max = m_nodes[node].max;
+    const Vector2d<T_ty> mid = min + ((max - min) / T_ty(2));
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        Node & child = m_nodes[first + i];
+        child.min.set((i & 1) ? mid.x : min.x, (i & 2) ? mid.y : min.y);
+        child.max.set((i & 1) ? max.x : mid.x, (i & 2) ? max.y : mid.y);
+        child.parent = node;
+        child.firstChild = npos;
+        child.firstItem = npos;
+        child.count = 0;
+        child.depth = m_nodes[node].depth + 1;
+    }
+
+    // Move the items down into the children.
+    std::size_t item = m_nodes[node].firstItem;
+    m_nodes[node].firstItem = npos;
+    m_nodes[node].firstChild = first;
+
+    while (item != npos) {
+        const std::size_t next = m_items[item].next;
+        const std::size_t child = getChild(node, m_items[item].pos);
+        pushItem(child, item);
+        ++m_nodes[child].count;
+        item = next;
+    }
+
+    // All the items may have gone into the same child, so it may need splitting too.
+    for (std::size_t i = 0; i < 4; ++i) {
+        const std::size_t child = first + i;
+        if (m_nodes[child].count > m_maxItemsPerNode && m_nodes[child].depth < m_maxDepth)
+            split(child);
+    }
+}
+
+template <typename T_ty, typename T_payload>
+void Quadtree<T_ty, T_payload>::tryMerge(std::size_t node)
+{
+    // Merging always happens from the bottom up, so if one node can't be merged
+    //  then none of its ancestors can be either.
+    while (node != npos && m_nodes[node].count <= m_maxItemsPerNode) {
+        const std::size_t first = m_nodes[node].firstChild;
+        for (std::size_t i = 0; i < 4; ++i) {
+            if (m_nodes[first + i].firstChild != npos)
+                return;
+        }
+
+        m_nodes[node].firstChild = npos;
+        for (std::size_t i = 0; i < 4; ++i) {
+            std::size_t item = m_nodes[first + i].firstItem;
+            while (item != npos) {
+                const std::size_t next = m_items[item].next;
+                pushItem(node, item);
+                item = next;
+            }
+            m_nodes[first + i].firstItem = npos;
+        }
+
+        m_freeNodeBlocks.push_back(first);
+        node = m_nodes[node].parent;
+    }
+}
+
+template <typename T_ty, typename T_payload>
+T_ty Quadtree<T_ty, T_payload>::getSqDistance(const std::size_t node, const Vector2d<T_ty> & point) const
+{
+    // Every item in the node lies between min and max. Rounding is monotonic, so
+    //  each difference here can't exceed the corresponding difference for an item.
+    const Node & n = m_nodes[node];
+    const T_ty dx =
+        (point.x < n.min.x) ? (n.min.x - point.x) :
+        (point.x > n.max.x) ? (point.x - n.max.x) : T_ty(0);
+    const T_ty dy =
+        (point.y < n.min.y) ? (n.min.y - point.y) :
+        (point.y > n.max.y) ? (point.y - n.max.y) : T_ty(0);
+    return (dx * dx) + (dy * dy);
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Quadtree_inl
@@ -0,0 +1,112 @@
+#ifndef ail_math_Ray2d_h
+#define ail_math_Ray2d_h
+
+/** \file Ray2d.h
+    \brief Declares a 2d ray, which can be cast against axis-aligned boxes. See Ray2d.inl for implementation.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <type_traits>
+#include "Aabb2d.h"
+#include "BoundingBox2d.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/** A 2d ray, starting at an origin and going on forever in one direction.
+Distances along the ray are measured in multiples of the direction vector, so
+ they're actual distances if the direction is normalised. The point at distance
+ t is origin + (direction * t).
+Casting the ray against a box uses the slab test, without any branches. It gives
+ the distances where the ray enters and leaves the box. Touching a corner or an
+ edge counts as a hit. A ray which starts inside a box enters it at distance 0.
+Aabb2dArray::castRay() tests one ray against lots of boxes at once, and
+ Ray2dKernels.h tests lots of rays against one box, using SIMD.
+Like Vector2d, the class is trivially copyable and can be constructed at compile time.
+Template parameter gives the underlying numerical type, which must be floating point.
+*/
+template <typename T_ty>
+class Ray2d
+{
+public:
+    static_assert(std::is_floating_point<T_ty>::value, "Ray2d is only supported for floating point types.");
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - initialises everything to 0.
+    constexpr Ray2d();
+
+    /// Constructor - explicitly initialises the origin and direction.
+    /// The direction doesn't need to be normalised. If it's zero, the ray only
+    ///  hits boxes which contain its origin.
+    constexpr Ray2d(const Vector2d<T_ty> & origin, const Vector2d<T_ty> & direction);
+
+
+//------------------------------------------------------------------------------
+// Operators.
+
+    /// Equality test.
+    /// Note that this tests for exact equality, which isn't usually desirable for
+    ///  floating point types.
+    constexpr bool operator == (const Ray2d<T_ty> & rhs) const;
+
+    /// Inequality test.
+    /// Note that this tests for (lack of) exact equality, which isn't usually
+    ///  desirable for floating point types.
+    constexpr bool operator != (const Ray2d<T_ty> & rhs) const;
+
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+    /// Get the point at the given distance along the ray.
+    Vector2d<T_ty> getPoint(const T_ty distance) const;
+
+    /// Get the reciprocal of each component of the direction.
+    /// These are infinite for components which are zero. The slab test uses
+    ///  them, so it's worth keeping them if the same ray is cast many times.
+    Vector2d<T_ty> getInverseDirection() const;
+
+
+//------------------------------------------------------------------------------
+// Tests.
+
+    /// Check if the ray hits a box.
+    bool intersects(const BoundingBox2d<T_ty> & box) const;
+
+    /// Check if the ray hits a box, and get the distances where it enters and leaves.
+    /// entry and exit are only set if it's a hit. exit is the largest finite
+    ///  value of T_ty if the ray never leaves the box (i.e. the direction is zero).
+    bool intersects(const BoundingBox2d<T_ty> & box, T_ty & entry, T_ty & exit) const;
+
+    /// Check if the ray hits a box. An empty box is never hit.
+    bool intersects(const Aabb2d<T_ty> & box) const;
+
+    /// Check if the ray hits a box, and get the distances where it enters and leaves.
+    /// An empty box is never hit. See the BoundingBox2d version for details.
+    bool intersects(const Aabb2d<T_ty> & box, T_ty & entry, T_ty & exit) const;
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// Position where the ray starts.
+    Vector2d<T_ty> origin;
+
+    /// Direction which the ray travels in.
+    Vector2d<T_ty> direction;
+};
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Ray2d_h
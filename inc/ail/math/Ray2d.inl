@@ -0,0 +1,153 @@
+#ifndef ail_math_Ray2d_inl
+#define ail_math_Ray2d_inl
+
+/** \file Ray2d.inl
+    \brief Implementation for a 2d ray, which can be cast against axis-aligned boxes (see Ray2d.h).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <limits>
+
+#include "Aabb2d.inl"
+#include "BoundingBox2d.inl"
+#include "Ray2d.h"
+#include "Vector2d.inl"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+namespace ray2d {
+
+/// Cast a ray against a box using the slab test, for distances between 0 and maxDistance.
+/// invX and invY are the reciprocals of the ray's direction. On each axis, the
+///  near edge of the box is picked by the sign of the direction, rather than by
+///  comparing the distances. If the origin is exactly on an edge which the ray
+///  is parallel to, that distance is NaN (0 * infinity). The comparisons below
+///  are ordered so that NaN is skipped, which means that axis doesn't limit the
+///  distances. Each comparison can be done with a single min or max instruction.
+/// Sets entry and exit whether or not it's a hit. It's a hit if entry <= exit,
+///  and the box isn't empty.
+template <typename T_ty>
+inline bool castRay(const T_ty originX, const T_ty originY, const T_ty invX, const T_ty invY,
+    const T_ty minX, const T_ty minY, const T_ty maxX, const T_ty maxY,
+    const T_ty maxDistance, T_ty & entry, T_ty & exit)
+{
+    const T_ty nearX = (((invX < T_ty(0)) ? maxX : minX) - originX) * invX;
+    const T_ty nearY = (((invY < T_ty(0)) ? maxY : minY) - originY) * invY;
+    const T_ty farX = (((invX < T_ty(0)) ? minX : maxX) - originX) * invX;
+    const T_ty farY = (((invY < T_ty(0)) ? minY : maxY) - originY) * invY;
+
+    entry = (nearX > T_ty(0)) ? nearX : T_ty(0);
+    entry = (nearY > entry) ? nearY : entry;
+    exit = (farX < maxDistance) ? farX : maxDistance;
+    exit = (farY < exit) ? farY : exit;
+    return (entry <= exit) & (minX <= maxX) & (minY <= maxY);
+}
+
+/// Cast a ray or segment against a box, only setting entry and exit if it's a hit.
+template <typename T_ty>
+inline bool castRay(const Vector2d<T_ty> & origin, const Vector2d<T_ty> & direction,
+    const Vector2d<T_ty> & min, const Vector2d<T_ty> & max,
+    const T_ty maxDistance, T_ty & entry, T_ty & exit)
+{
+    T_ty rayEntry, rayExit;
+    const bool hit = castRay(origin.x, origin.y, T_ty(1) / direction.x, T_ty(1) / direction.y,
+        min.x, min.y, max.x, max.y, maxDistance, rayEntry, rayExit);
+    if (hit) {
+        entry = rayEntry;
+        exit = rayExit;
+    }
+    return hit;
+}
+
+} // ray2d
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+template <typename T_ty>
+constexpr Ray2d<T_ty>::Ray2d() :
+    origin(), direction()
+{
+}
+
+template <typename T_ty>
+constexpr Ray2d<T_ty>::Ray2d(const Vector2d<T_ty> & origin, const Vector2d<T_ty> & direction) :
+    origin(origin), direction(direction)
+{
+}
+
+//------------------------------------------------------------------------------
+// Operators.
+
+template <typename T_ty>
+constexpr bool Ray2d<T_ty>::operator == (const Ray2d<T_ty> & rhs) const
+{
+    return origin == rhs.origin && direction == rhs.direction;
+}
+
+template <typename T_ty>
+constexpr bool Ray2d<T_ty>::operator != (const Ray2d<T_ty> & rhs) const
+{
+    return !(*this == rhs);
+}
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+template <typename T_ty>
+Vector2d<T_ty> Ray2d<T_ty>::getPoint(const T_ty distance) const
+{
+    return Vector2d<T_ty>(origin.x + (direction.x * distance), origin.y + (direction.y * distance));
+}
+
+template <typename T_ty>
+Vector2d<T_ty> Ray2d<T_ty>::getInverseDirection() const
+{
+    return Vector2d<T_ty>(T_ty(1) / direction.x, T_ty(1) / direction.y);
+}
+
+//------------------------------------------------------------------------------
+// Tests.
+
+template <typename T_ty>
+bool Ray2d<T_ty>::intersects(const BoundingBox2d<T_ty> & box) const
+{
+    T_ty entry, exit;
+    return intersects(box, entry, exit);
+}
+
+template <typename T_ty>
+bool Ray2d<T_ty>::intersects(const BoundingBox2d<T_ty> & box, T_ty & entry, T_ty & exit) const
+{
+    return ray2d::castRay(origin, direction, box.getCornerX1Y1(), box.getCornerX2Y2(),
+        std::numeric_limits<T_ty>::max(), entry, exit);
+}
+
+template <typename T_ty>
+bool Ray2d<T_ty>::intersects(const Aabb2d<T_ty> & box) const
+{
+    T_ty entry, exit;
+    return intersects(box, entry, exit);
+}
+
+template <typename T_ty>
+bool Ray2d<T_ty>::intersects(const Aabb2d<T_ty> & box, T_ty & entry, T_ty & exit) const
+{
+    return ray2d::castRay(origin, direction, box.min, box.max, std::numeric_limits<T_ty>::max(), entry, exit);
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Ray2d_inl
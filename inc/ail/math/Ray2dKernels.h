@@ -0,0 +1,199 @@
+#ifndef ail_math_Ray2dKernels_h
+#define ail_math_Ray2dKernels_h
+
+/** \file Ray2dKernels.h
+    \brief Batch kernels which cast rays against axis-aligned boxes, with runtime SIMD dispatch.
+
+    castRay() tests one ray against several boxes at once, stored as separate
+     lanes of corners (e.g. from Aabb2dArray). castRays() tests several rays at
+     once against one box, with the origins and directions stored as separate
+     x and y lanes (e.g. from Vector2dArray). Each register holds 4, 8 or 16
+     floats (or 2, 4 or 8 doubles), depending on the SIMD level.
+    Both give the distances where each ray enters and leaves each box, and
+     whether it's a hit, exactly as Ray2d::intersects() would. A segment can be
+     cast as a ray from its start, with its end minus its start as the
+     direction, and 1 as the maximum distance. The results are then fractions
+     of the way along the segment, as in Segment2d::intersects().
+    sweepBox() sweeps one moving box against several static boxes, giving the
+     time of impact and contact normal for each, exactly as
+     SweptBox2d::intersects() would.
+    Entry and exit distances (and times and normals) are written for misses
+     too. They're only meaningful for hits.
+    As in Vector2dKernels.h, the generic templates are scalar reference
+     implementations, and the SIMD paths (in Ray2dKernelsImpl.inl) give
+     bit-identical results.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cstddef>
+#include "Ray2d.inl"
+#include "SimdOps.h"
+#include "SweptBox2d.inl"
+
+//--------------
+namespace ail {
+namespace math {
+namespace kernels {
+//--------------
+
+//------------------------------------------------------------------------------
+// Scalar reference kernels.
+
+namespace scalar {
+
+/// Cast one ray against each box, for distances from 0 to maxDistance.
+/// The ray is given by its origin and the reciprocal of its direction (see Ray2d::getInverseDirection()).
+template <typename T_ty>
+void castRay(const T_ty * minX, const T_ty * minY, const T_ty * maxX, const T_ty * maxY,
+    const T_ty originX, const T_ty originY, const T_ty invX, const T_ty invY, const T_ty maxDistance,
+    T_ty * entry, T_ty * exit, bool * hit, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        hit[i] = ray2d::castRay(originX, originY, invX, invY, minX[i], minY[i], maxX[i], maxY[i], maxDistance, entry[i], exit[i]);
+}
+
+/// Cast each ray against one box, for distances from 0 to maxDistance.
+template <typename T_ty>
+void castRays(const T_ty * originX, const T_ty * originY, const T_ty * directionX, const T_ty * directionY,
+    const T_ty minX, const T_ty minY, const T_ty maxX, const T_ty maxY, const T_ty maxDistance,
+    T_ty * entry, T_ty * exit, bool * hit, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        hit[i] = ray2d::castRay(originX[i], originY[i], T_ty(1) / directionX[i], T_ty(1) / directionY[i],
+            minX, minY, maxX, maxY, maxDistance, entry[i], exit[i]);
+    }
+}
+
+/// Sweep a moving box against each static box, for times from 0 to 1.
+/// The moving box is given by its centre, its radius, and the reciprocal of its velocity.
+template <typename T_ty>
+void sweepBox(const T_ty * minX, const T_ty * minY, const T_ty * maxX, const T_ty * maxY,
+    const T_ty originX, const T_ty originY, const T_ty radiusX, const T_ty radiusY, const T_ty invX, const T_ty invY,
+    T_ty * time, T_ty * normalX, T_ty * normalY, bool * hit, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        hit[i] = sweptbox2d::sweep(originX, originY, invX, invY, radiusX, radiusY,
+            minX[i], minY[i], maxX[i], maxY[i], time[i], normalX[i], normalY[i]);
+    }
+}
+
+} // scalar
+
+#if defined(AIL_MATH_SIMD_X86)
+
+//------------------------------------------------------------------------------
+// SIMD kernels. The bodies are shared by every instruction set.
+
+AIL_MATH_SIMD_TARGET_BEGIN("sse2")
+namespace sse2 {
+#include "Ray2dKernelsImpl.inl"
+} // sse2
+AIL_MATH_SIMD_TARGET_END
+
+AIL_MATH_SIMD_TARGET_BEGIN("avx2")
+namespace avx2 {
+#include "Ray2dKernelsImpl.inl"
+} // avx2
+AIL_MATH_SIMD_TARGET_END
+
+#if defined(AIL_MATH_SIMD_AVX512)
+AIL_MATH_SIMD_TARGET_BEGIN("avx512f")
+namespace avx512 {
+#include "Ray2dKernelsImpl.inl"
+} // avx512
+AIL_MATH_SIMD_TARGET_END
+#endif // AIL_MATH_SIMD_AVX512
+
+#endif // AIL_MATH_SIMD_X86
+
+//------------------------------------------------------------------------------
+// Dispatching kernels.
+
+/// Cast one ray against each box, for distances from 0 to maxDistance.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void castRay(const T_ty * minX, const T_ty * minY, const T_ty * maxX, const T_ty * maxY,
+    const T_ty originX, const T_ty originY, const T_ty invX, const T_ty invY, const T_ty maxDistance,
+    T_ty * entry, T_ty * exit, bool * hit, const std::size_t count)
+{
+    scalar::castRay(minX, minY, maxX, maxY, originX, originY, invX, invY, maxDistance, entry, exit, hit, count);
+}
+
+/// Cast one ray against each box, for distances from 0 to maxDistance.
+inline void castRay(const float * minX, const float * minY, const float * maxX, const float * maxY,
+    const float originX, const float originY, const float invX, const float invY, const float maxDistance,
+    float * entry, float * exit, bool * hit, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(castRay, float, (minX, minY, maxX, maxY, originX, originY, invX, invY, maxDistance, entry, exit, hit, count))
+}
+
+/// Cast one ray against each box, for distances from 0 to maxDistance.
+inline void castRay(const double * minX, const double * minY, const double * maxX, const double * maxY,
+    const double originX, const double originY, const double invX, const double invY, const double maxDistance,
+    double * entry, double * exit, bool * hit, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(castRay, double, (minX, minY, maxX, maxY, originX, originY, invX, invY, maxDistance, entry, exit, hit, count))
+}
+
+/// Cast each ray against one box, for distances from 0 to maxDistance.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void castRays(const T_ty * originX, const T_ty * originY, const T_ty * directionX, const T_ty * directionY,
+    const T_ty minX, const T_ty minY, const T_ty maxX, const T_ty maxY, const T_ty maxDistance,
+    T_ty * entry, T_ty * exit, bool * hit, const std::size_t count)
+{
+    scalar::castRays(originX, originY, directionX, directionY, minX, minY, maxX, maxY, maxDistance, entry, exit, hit, count);
+}
+
+/// Cast each ray against one box, for distances from 0 to maxDistance.
+inline void castRays(const float * originX, const float * originY, const float * directionX, const float * directionY,
+    const float minX, const float minY, const float maxX, const float maxY, const float maxDistance,
+    float * entry, float * exit, bool * hit, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(castRays, float, (originX, originY, directionX, directionY, minX, minY, maxX, maxY, maxDistance, entry, exit, hit, count))
+}
+
+/// Cast each ray against one box, for distances from 0 to maxDistance.
+inline void castRays(const double * originX, const double * originY, const double * directionX, const double * directionY,
+    const double minX, const double minY, const double maxX, const double maxY, const double maxDistance,
+    double * entry, double * exit, bool * hit, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(castRays, double, (originX, originY, directionX, directionY, minX, minY, maxX, maxY, maxDistance, entry, exit, hit, count))
+}
+
+/// Sweep a moving box against each static box, for times from 0 to 1.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void sweepBox(const T_ty * minX, const T_ty * minY, const T_ty * maxX, const T_ty * maxY,
+    const T_ty originX, const T_ty originY, const T_ty radiusX, const T_ty radiusY, const T_ty invX, const T_ty invY,
+    T_ty * time, T_ty * normalX, T_ty * normalY, bool * hit, const std::size_t count)
+{
+    scalar::sweepBox(minX, minY, maxX, maxY, originX, originY, radiusX, radiusY, invX, invY, time, normalX, normalY, hit, count);
+}
+
+/// Sweep a moving box against each static box, for times from 0 to 1.
+inline void sweepBox(const float * minX, const float * minY, const float * maxX, const float * maxY,
+    const float originX, const float originY, const float radiusX, const float radiusY, const float invX, const float invY,
+    float * time, float * normalX, float * normalY, bool * hit, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(sweepBox, float, (minX, minY, maxX, maxY, originX, originY, radiusX, radiusY, invX, invY, time, normalX, normalY, hit, count))
+}
+
+/// Sweep a moving box against each static box, for times from 0 to 1.
+inline void sweepBox(const double * minX, const double * minY, const double * maxX, const double * maxY,
+    const double originX, const double originY, const double radiusX, const double radiusY, const double invX, const double invY,
+    double * time, double * normalX, double * normalY, bool * hit, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(sweepBox, double, (minX, minY, maxX, maxY, originX, originY, radiusX, radiusY, invX, invY, time, normalX, normalY, hit, count))
+}
+
+//--------------
+} // kernels
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Ray2dKernels_h
@@ -0,0 +1,161 @@
+/** \file Ray2dKernelsImpl.inl
+    \brief Generic bodies of the SIMD batch kernels for casting rays. (Intended for internal use by the library.)
+
+    NOTE: This file deliberately has no include guard. Ray2dKernels.h includes
+     it once inside each instruction set namespace, where the Ops<T_ty>
+     structure from SimdOps.h wraps that instruction set's intrinsics. Don't
+     include it anywhere else.
+
+    Each kernel processes as many whole registers as possible, then hands the
+     remaining elements to the scalar reference kernel. The slab test is done
+     with the same operations in the same order as ray2d::castRay() and
+     sweptbox2d::sweep(), so results are identical.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+/// Cast a register of rays against a register of boxes. Any of the inputs can be broadcast from a single value.
+/// Stores the entry and exit distances, and returns a bit per lane which is set for hits.
+template <typename T_ty>
+inline unsigned castRayRegister(
+    const typename Ops<T_ty>::V originX, const typename Ops<T_ty>::V originY,
+    const typename Ops<T_ty>::V invX, const typename Ops<T_ty>::V invY,
+    const typename Ops<T_ty>::V minX, const typename Ops<T_ty>::V minY,
+    const typename Ops<T_ty>::V maxX, const typename Ops<T_ty>::V maxY,
+    const typename Ops<T_ty>::V maxDistance, T_ty * entry, T_ty * exit)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+    typedef typename O::M M;
+
+    // The near edge on each axis depends on the sign of the direction.
+    const V zero = O::set1(T_ty(0));
+    const M flipX = O::lt(invX, zero);
+    const M flipY = O::lt(invY, zero);
+    const V nearX = O::mul(O::sub(O::select(flipX, maxX, minX), originX), invX);
+    const V nearY = O::mul(O::sub(O::select(flipY, maxY, minY), originY), invY);
+    const V farX = O::mul(O::sub(O::select(flipX, minX, maxX), originX), invX);
+    const V farY = O::mul(O::sub(O::select(flipY, minY, maxY), originY), invY);
+
+    // min(a, b) and max(a, b) return b if a is NaN, which skips that axis.
+    const V vEntry = O::max(nearY, O::max(nearX, zero));
+    const V vExit = O::min(farY, O::min(farX, maxDistance));
+    O::store(entry, vEntry);
+    O::store(exit, vExit);
+    return O::cmpLe(vEntry, vExit) & O::cmpLe(minX, maxX) & O::cmpLe(minY, maxY);
+}
+
+/// Cast one ray against each box, for distances from 0 to maxDistance.
+template <typename T_ty>
+void castRay(const T_ty * minX, const T_ty * minY, const T_ty * maxX, const T_ty * maxY,
+    const T_ty originX, const T_ty originY, const T_ty invX, const T_ty invY, const T_ty maxDistance,
+    T_ty * entry, T_ty * exit, bool * hit, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    const V vOriginX = O::set1(originX);
+    const V vOriginY = O::set1(originY);
+    const V vInvX = O::set1(invX);
+    const V vInvY = O::set1(invY);
+    const V vMaxDistance = O::set1(maxDistance);
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width) {
+        const unsigned mask = castRayRegister<T_ty>(vOriginX, vOriginY, vInvX, vInvY,
+            O::load(minX + i), O::load(minY + i), O::load(maxX + i), O::load(maxY + i),
+            vMaxDistance, entry + i, exit + i);
+        storeMask(mask, hit + i, O::width);
+    }
+    scalar::castRay(minX + i, minY + i, maxX + i, maxY + i, originX, originY, invX, invY, maxDistance,
+        entry + i, exit + i, hit + i, count - i);
+}
+
+/// Cast each ray against one box, for distances from 0 to maxDistance.
+template <typename T_ty>
+void castRays(const T_ty * originX, const T_ty * originY, const T_ty * directionX, const T_ty * directionY,
+    const T_ty minX, const T_ty minY, const T_ty maxX, const T_ty maxY, const T_ty maxDistance,
+    T_ty * entry, T_ty * exit, bool * hit, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    const V one = O::set1(T_ty(1));
+    const V vMinX = O::set1(minX);
+    const V vMinY = O::set1(minY);
+    const V vMaxX = O::set1(maxX);
+    const V vMaxY = O::set1(maxY);
+    const V vMaxDistance = O::set1(maxDistance);
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width) {
+        const unsigned mask = castRayRegister<T_ty>(O::load(originX + i), O::load(originY + i),
+            O::div(one, O::load(directionX + i)), O::div(one, O::load(directionY + i)),
+            vMinX, vMinY, vMaxX, vMaxY, vMaxDistance, entry + i, exit + i);
+        storeMask(mask, hit + i, O::width);
+    }
+    scalar::castRays(originX + i, originY + i, directionX + i, directionY + i, minX, minY, maxX, maxY, maxDistance,
+        entry + i, exit + i, hit + i, count - i);
+}
+
+/// Sweep a moving box against each static box, for times from 0 to 1.
+template <typename T_ty>
+void sweepBox(const T_ty * minX, const T_ty * minY, const T_ty * maxX, const T_ty * maxY,
+    const T_ty originX, const T_ty originY, const T_ty radiusX, const T_ty radiusY, const T_ty invX, const T_ty invY,
+    T_ty * time, T_ty * normalX, T_ty * normalY, bool * hit, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+    typedef typename O::M M;
+
+    const V zero = O::set1(T_ty(0));
+    const V one = O::set1(T_ty(1));
+    const V vOriginX = O::set1(originX);
+    const V vOriginY = O::set1(originY);
+    const V vRadiusX = O::set1(radiusX);
+    const V vRadiusY = O::set1(radiusY);
+    const V vInvX = O::set1(invX);
+    const V vInvY = O::set1(invY);
+
+    // The velocity is the same for every box, so the near edges and the normals
+    //  which go with them are too.
+    const M flipX = O::lt(vInvX, zero);
+    const M flipY = O::lt(vInvY, zero);
+    const V faceX = O::select(flipX, one, O::set1(T_ty(-1)));
+    const V faceY = O::select(flipY, one, O::set1(T_ty(-1)));
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width) {
+        const V boxMinX = O::load(minX + i);
+        const V boxMinY = O::load(minY + i);
+        const V boxMaxX = O::load(maxX + i);
+        const V boxMaxY = O::load(maxY + i);
+        const V expandedMinX = O::sub(boxMinX, vRadiusX);
+        const V expandedMinY = O::sub(boxMinY, vRadiusY);
+        const V expandedMaxX = O::add(boxMaxX, vRadiusX);
+        const V expandedMaxY = O::add(boxMaxY, vRadiusY);
+
+        const V nearX = O::mul(O::sub(O::select(flipX, expandedMaxX, expandedMinX), vOriginX), vInvX);
+        const V nearY = O::mul(O::sub(O::select(flipY, expandedMaxY, expandedMinY), vOriginY), vInvY);
+        const V farX = O::mul(O::sub(O::select(flipX, expandedMinX, expandedMaxX), vOriginX), vInvX);
+        const V farY = O::mul(O::sub(O::select(flipY, expandedMinY, expandedMaxY), vOriginY), vInvY);
+        const V vTime = O::max(nearY, O::max(nearX, zero));
+        const V vExit = O::min(farY, O::min(farX, one));
+
+        // Equality is tested as a <= b and b <= a, which is false for NaN.
+        const M onX = O::maskAnd(O::le(nearX, vTime), O::le(vTime, nearX));
+        const M onY = O::maskAnd(O::le(nearY, vTime), O::le(vTime, nearY));
+        O::store(time + i, vTime);
+        O::store(normalX + i, O::select(onX, faceX, zero));
+        O::store(normalY + i, O::select(onX, zero, O::select(onY, faceY, zero)));
+
+        const unsigned mask = O::cmpLe(vTime, vExit) &
+            O::cmpLe(expandedMinX, expandedMaxX) & O::cmpLe(expandedMinY, expandedMaxY) &
+            O::cmpLe(boxMinX, boxMaxX) & O::cmpLe(boxMinY, boxMaxY);
+        storeMask(mask, hit + i, O::width);
+    }
+    scalar::sweepBox(minX + i, minY + i, maxX + i, maxY + i, originX, originY, radiusX, radiusY, invX, invY,
+        time + i, normalX + i, normalY + i, hit + i, count - i);
+}
@@ -0,0 +1,115 @@
+#ifndef ail_math_Segment2d_h
+#define ail_math_Segment2d_h
+
+/** \file Segment2d.h
+    \brief Declares a 2d line segment, which can be cast against axis-aligned boxes. See Segment2d.inl for implementation.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <type_traits>
+#include "Aabb2d.h"
+#include "BoundingBox2d.h"
+#include "Ray2d.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/** A straight line between two points, e.g. for line-of-sight checks.
+Positions along the segment are measured as a fraction of the way from start to
+ end, so the point at fraction t is start + ((end - start) * t). Multiply a
+ fraction by getLength() to get an actual distance.
+Casting the segment against a box uses the same branch-free slab test as Ray2d,
+ limited to the part of the ray between the two points.
+Like Vector2d, the class is trivially copyable and can be constructed at compile time.
+Template parameter gives the underlying numerical type, which must be floating point.
+*/
+template <typename T_ty>
+class Segment2d
+{
+public:
+    static_assert(std::is_floating_point<T_ty>::value, "Segment2d is only supported for floating point types.");
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - initialises everything to 0.
+    constexpr Segment2d();
+
+    /// Constructor - explicitly initialises the end points.
+    constexpr Segment2d(const Vector2d<T_ty> & start, const Vector2d<T_ty> & end);
+
+
+//------------------------------------------------------------------------------
+// Operators.
+
+    /// Equality test.
+    /// Note that this tests for exact equality, which isn't usually desirable for
+    ///  floating point types.
+    constexpr bool operator == (const Segment2d<T_ty> & rhs) const;
+
+    /// Inequality test.
+    /// Note that this tests for (lack of) exact equality, which isn't usually
+    ///  desirable for floating point types.
+    constexpr bool operator != (const Segment2d<T_ty> & rhs) const;
+
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+    /// Get the point at the given fraction of the way from start to end.
+    Vector2d<T_ty> getPoint(const T_ty fraction) const;
+
+    /// Get the vector from start to end.
+    Vector2d<T_ty> getDirection() const;
+
+    /// Get the distance from start to end.
+    T_ty getLength() const;
+
+    /// Get a ray which starts at the start of the segment, and goes through the end.
+    /// Distances along the ray are the same as fractions along the segment.
+    Ray2d<T_ty> toRay() const;
+
+
+//------------------------------------------------------------------------------
+// Tests.
+
+    /// Check if the segment crosses or touches a box.
+    bool intersects(const BoundingBox2d<T_ty> & box) const;
+
+    /// Check if the segment crosses or touches a box, and get the fractions of
+    ///  the way along where it enters and leaves.
+    /// entry and exit are only set if it's a hit. entry is 0 if the start is
+    ///  inside the box, and exit is 1 if the end is inside the box.
+    bool intersects(const BoundingBox2d<T_ty> & box, T_ty & entry, T_ty & exit) const;
+
+    /// Check if the segment crosses or touches a box. An empty box is never hit.
+    bool intersects(const Aabb2d<T_ty> & box) const;
+
+    /// Check if the segment crosses or touches a box, and get the fractions of
+    ///  the way along where it enters and leaves.
+    /// An empty box is never hit. See the BoundingBox2d version for details.
+    bool intersects(const Aabb2d<T_ty> & box, T_ty & entry, T_ty & exit) const;
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// Position where the segment starts.
+    Vector2d<T_ty> start;
+
+    /// Position where the segment ends.
+    Vector2d<T_ty> end;
+};
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Segment2d_h
@@ -0,0 +1,111 @@
+#ifndef ail_math_Segment2d_inl
+#define ail_math_Segment2d_inl
+
+/** \file Segment2d.inl
+    \brief Implementation for a 2d line segment, which can be cast against axis-aligned boxes (see Segment2d.h).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "Ray2d.inl"
+#include "Segment2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+template <typename T_ty>
+constexpr Segment2d<T_ty>::Segment2d() :
+    start(), end()
+{
+}
+
+template <typename T_ty>
+constexpr Segment2d<T_ty>::Segment2d(const Vector2d<T_ty> & start, const Vector2d<T_ty> & end) :
+    start(start), end(end)
+{
+}
+
+//------------------------------------------------------------------------------
+// Operators.
+
+template <typename T_ty>
+constexpr bool Segment2d<T_ty>::operator == (const Segment2d<T_ty> & rhs) const
+{
+    return start == rhs.start && end == rhs.end;
+}
+
+template <typename T_ty>
+constexpr bool Segment2d<T_ty>::operator != (const Segment2d<T_ty> & rhs) const
+{
+    return !(*this == rhs);
+}
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+template <typename T_ty>
+Vector2d<T_ty> Segment2d<T_ty>::getPoint(const T_ty fraction) const
+{
+    return toRay().getPoint(fraction);
+}
+
+template <typename T_ty>
+Vector2d<T_ty> Segment2d<T_ty>::getDirection() const
+{
+    return Vector2d<T_ty>(end.x - start.x, end.y - start.y);
+}
+
+template <typename T_ty>
+T_ty Segment2d<T_ty>::getLength() const
+{
+    return start.getDistance(end);
+}
+
+template <typename T_ty>
+Ray2d<T_ty> Segment2d<T_ty>::toRay() const
+{
+    return Ray2d<T_ty>(start, getDirection());
+}
+
+//------------------------------------------------------------------------------
+// Tests.
+
+template <typename T_ty>
+bool Segment2d<T_ty>::intersects(const BoundingBox2d<T_ty> & box) const
+{
+    T_ty entry, exit;
+    return intersects(box, entry, exit);
+}
+
+template <typename T_ty>
+bool Segment2d<T_ty>::intersects(const BoundingBox2d<T_ty> & box, T_ty & entry, T_ty & exit) const
+{
+    return ray2d::castRay(start, getDirection(), box.getCornerX1Y1(), box.getCornerX2Y2(), T_ty(1), entry, exit);
+}
+
+template <typename T_ty>
+bool Segment2d<T_ty>::intersects(const Aabb2d<T_ty> & box) const
+{
+    T_ty entry, exit;
+    return intersects(box, entry, exit);
+}
+
+template <typename T_ty>
+bool Segment2d<T_ty>::intersects(const Aabb2d<T_ty> & box, T_ty & entry, T_ty & exit) const
+{
+    return ray2d::castRay(start, getDirection(), box.min, box.max, T_ty(1), entry, exit);
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Segment2d_inl
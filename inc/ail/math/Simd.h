@@ -0,0 +1,161 @@
+#ifndef ail_math_Simd_h
+#define ail_math_Simd_h
+
+/** \file Simd.h
+    \brief Detects SIMD instruction set support and selects the SIMD level used by batch kernels.
+
+    The batch kernels (see Vector2dKernels.h) are compiled for every instruction
+     set the compiler knows about, and the best one supported by the CPU is
+     picked at runtime. This header provides the detection and selection.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <atomic>
+
+// Work out which instruction sets we can compile kernels for.
+// Define AIL_MATH_NO_SIMD to force the scalar reference kernels everywhere.
+#if !defined(AIL_MATH_NO_SIMD) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+    #define AIL_MATH_SIMD_X86 1
+    #if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1910)
+        #define AIL_MATH_SIMD_AVX512 1
+    #endif
+#endif
+
+#if defined(AIL_MATH_SIMD_X86)
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+    #endif
+#endif
+
+// Kernels for a specific instruction set are compiled inside a target region.
+// GCC and Clang need to be told they may use the instructions in that region.
+// MSVC allows intrinsics anywhere, so the regions are empty.
+#if defined(__clang__)
+    #define AIL_MATH_SIMD_PRAGMA(x) _Pragma(#x)
+    #define AIL_MATH_SIMD_TARGET_BEGIN(isa) AIL_MATH_SIMD_PRAGMA(clang attribute push (__attribute__((target(isa))), apply_to = function))
+    #define AIL_MATH_SIMD_TARGET_END AIL_MATH_SIMD_PRAGMA(clang attribute pop)
+#elif defined(__GNUC__)
+    #define AIL_MATH_SIMD_PRAGMA(x) _Pragma(#x)
+    #define AIL_MATH_SIMD_TARGET_BEGIN(isa) AIL_MATH_SIMD_PRAGMA(GCC push_options) AIL_MATH_SIMD_PRAGMA(GCC target(isa))
+    #define AIL_MATH_SIMD_TARGET_END AIL_MATH_SIMD_PRAGMA(GCC pop_options)
+#else
+    #define AIL_MATH_SIMD_TARGET_BEGIN(isa)
+    #define AIL_MATH_SIMD_TARGET_END
+#endif
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/// Identifies a level of SIMD support.
+/// Each level implies support for all the lower levels.
+enum class SimdLevel
+{
+    /// Portable scalar code. Used on non-x86 targets (including ARM/NEON) and as a reference.
+    Scalar = 0,
+    /// SSE2 (128-bit). This is the baseline for all 64-bit x86 processors.
+    SSE2 = 1,
+    /// AVX2 (256-bit).
+    AVX2 = 2,
+    /// AVX-512 Foundation (512-bit).
+    AVX512 = 3
+};
+
+/// Query the CPU for the highest SIMD level which the kernels can use.
+/// This is relatively expensive. Use getSimdLevel() to get the cached result.
+inline SimdLevel detectSimdLevel()
+{
+#if defined(AIL_MATH_SIMD_X86)
+  #if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = { 0, 0, 0, 0 };
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    if (maxLeaf < 1)
+        return SimdLevel::Scalar;
+
+    __cpuid(info, 1);
+    const bool sse2 = (info[3] & (1 << 26)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!sse2)
+        return SimdLevel::Scalar;
+    if (!osxsave || !avx || maxLeaf < 7)
+        return SimdLevel::SSE2;
+
+    // Check that the OS saves the YMM (and ZMM) registers on context switch.
+    const unsigned long long xcr0 = _xgetbv(0);
+    if ((xcr0 & 0x6) != 0x6)
+        return SimdLevel::SSE2;
+
+    __cpuidex(info, 7, 0);
+    const bool avx2 = (info[1] & (1 << 5)) != 0;
+    const bool avx512f = (info[1] & (1 << 16)) != 0;
+    #if defined(AIL_MATH_SIMD_AVX512)
+    if (avx512f && (xcr0 & 0xe6) == 0xe6)
+        return SimdLevel::AVX512;
+    #else
+    (void)avx512f;
+    #endif
+    return avx2 ? SimdLevel::AVX2 : SimdLevel::SSE2;
+  #else
+    __builtin_cpu_init();
+    #if defined(AIL_MATH_SIMD_AVX512)
+    if (__builtin_cpu_supports("avx512f"))
+        return SimdLevel::AVX512;
+    #endif
+    if (__builtin_cpu_supports("avx2"))
+        return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return SimdLevel::SSE2;
+    return SimdLevel::Scalar;
+  #endif
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+/// Get the highest SIMD level supported by this CPU.
+/// The CPU is queried once, and the result is cached.
+inline SimdLevel getSupportedSimdLevel()
+{
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+/// Internal storage for the SIMD level currently selected for batch kernels.
+inline std::atomic<int> & simdLevelStorage()
+{
+    static std::atomic<int> level(static_cast<int>(getSupportedSimdLevel()));
+    return level;
+}
+
+/// Get the SIMD level currently used by batch kernels.
+/// By default this is the highest level supported by the CPU.
+inline SimdLevel getSimdLevel()
+{
+    return static_cast<SimdLevel>(simdLevelStorage().load(std::memory_order_relaxed));
+}
+
+/// Select the SIMD level used by batch kernels.
+/// This is mainly useful for testing and benchmarking individual code paths.
+/// If the requested level isn't supported by the CPU then the highest supported
+///  level is used instead. Returns the level which was actually selected.
+inline SimdLevel setSimdLevel(const SimdLevel level)
+{
+    const SimdLevel supported = getSupportedSimdLevel();
+    const SimdLevel actual = (static_cast<int>(level) > static_cast<int>(supported)) ? supported : level;
+    simdLevelStorage().store(static_cast<int>(actual), std::memory_order_relaxed);
+    return actual;
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Simd_h
@@ -0,0 +1,358 @@
+#ifndef ail_math_SimdOps_h
+#define ail_math_SimdOps_h
+
+/** \file SimdOps.h
+    \brief Wrappers around the SIMD intrinsics used by the batch kernels. (Intended for internal use by the library.)
+
+    For each instruction set there is an Ops<T_ty> structure for float and
+     double, in a namespace named after the instruction set (sse2, avx2 and
+     avx512). They all have the same members, so a kernel can be written once
+     as a template and compiled for every instruction set by including its body
+     inside each namespace (see Vector2dKernels.h for an example).
+
+    min(a, b) and max(a, b) follow the x86 instructions: they return b unless
+     a is strictly smaller (or bigger), so they're equivalent to (a < b) ? a : b
+     and (a > b) ? a : b, even for NaN and signed zeros.
+
+    Comparisons are available in two forms. The cmp functions return a bit per
+     lane, which is convenient for writing out bools. The others return a lane
+     mask of type M, which can be passed to select(). AVX-512 has dedicated mask
+     registers, so M isn't necessarily the same type as V.
+
+    This header also provides the macro which dispatches a kernel call to the
+     currently selected SIMD level.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "Simd.h"
+
+//--------------
+namespace ail {
+namespace math {
+namespace kernels {
+//--------------
+
+#if defined(AIL_MATH_SIMD_X86)
+
+//------------------------------------------------------------------------------
+// Helpers shared by the SIMD kernels.
+
+/// Write the lowest count bits of a comparison mask to an array of bools.
+/// Each group of 8 bits is spread out to one per byte with a pair of multiplies
+///  (splitting odd and even bits stops the partial products overlapping), then
+///  stored in one go. This relies on x86 being little-endian.
+inline void storeMask(const unsigned mask, bool * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i += 8) {
+        const std::uint64_t bits = (mask >> i) & 0xffu;
+        const std::uint64_t spread = 0x0002040810204081ull;
+        const std::uint64_t bytes = (((bits & 0x55u) * spread) | ((bits & 0xaau) * spread)) & 0x0101010101010101ull;
+        std::memcpy(output + i, &bytes, (count - i < 8) ? count - i : 8);
+    }
+}
+
+//------------------------------------------------------------------------------
+// SSE2 operations.
+
+AIL_MATH_SIMD_TARGET_BEGIN("sse2")
+namespace sse2 {
+
+template <typename T_ty> struct Ops;
+
+template <>
+struct Ops<float>
+{
+    typedef __m128 V;
+    typedef __m128 M;
+    static const std::size_t width = 4;
+    static inline V load(const float * p) { return _mm_loadu_ps(p); }
+    static inline void store(float * p, const V a) { _mm_storeu_ps(p, a); }
+    static inline V set1(const float a) { return _mm_set1_ps(a); }
+    static inline V add(const V a, const V b) { return _mm_add_ps(a, b); }
+    static inline V sub(const V a, const V b) { return _mm_sub_ps(a, b); }
+    static inline V mul(const V a, const V b) { return _mm_mul_ps(a, b); }
+    static inline V div(const V a, const V b) { return _mm_div_ps(a, b); }
+    static inline V sqrt(const V a) { return _mm_sqrt_ps(a); }
+    static inline V min(const V a, const V b) { return _mm_min_ps(a, b); }
+    static inline V max(const V a, const V b) { return _mm_max_ps(a, b); }
+    static inline unsigned cmpLe(const V a, const V b) { return static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(a, b))); }
+    static inline V selectNonZero(const V m, const V a, const V b)
+    {
+        const V mask = _mm_cmpneq_ps(m, _mm_setzero_ps());
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+    static inline M lt(const V a, const V b) { return _mm_cmplt_ps(a, b); }
+    static inline M le(const V a, const V b) { return _mm_cmple_ps(a, b); }
+    static inline M maskAnd(const M a, const M b) { return _mm_and_ps(a, b); }
+    static inline unsigned maskBits(const M m) { return static_cast<unsigned>(_mm_movemask_ps(m)); }
+    static inline V select(const M m, const V a, const V b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static inline V abs(const V a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static inline __m128d widenLow(const V a) { return _mm_cvtps_pd(a); }
+    static inline __m128d widenHigh(const V a) { return _mm_cvtps_pd(_mm_movehl_ps(a, a)); }
+    static inline V narrow(const __m128d low, const __m128d high) { return _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high)); }
+};
+
+template <>
+struct Ops<double>
+{
+    typedef __m128d V;
+    typedef __m128d M;
+    static const std::size_t width = 2;
+    static inline V load(const double * p) { return _mm_loadu_pd(p); }
+    static inline void store(double * p, const V a) { _mm_storeu_pd(p, a); }
+    static inline V set1(const double a) { return _mm_set1_pd(a); }
+    static inline V add(const V a, const V b) { return _mm_add_pd(a, b); }
+    static inline V sub(const V a, const V b) { return _mm_sub_pd(a, b); }
+    static inline V mul(const V a, const V b) { return _mm_mul_pd(a, b); }
+    static inline V div(const V a, const V b) { return _mm_div_pd(a, b); }
+    static inline V sqrt(const V a) { return _mm_sqrt_pd(a); }
+    static inline V min(const V a, const V b) { return _mm_min_pd(a, b); }
+    static inline V max(const V a, const V b) { return _mm_max_pd(a, b); }
+    static inline unsigned cmpLe(const V a, const V b) { return static_cast<unsigned>(_mm_movemask_pd(_mm_cmple_pd(a, b))); }
+    static inline V selectNonZero(const V m, const V a, const V b)
+    {
+        const V mask = _mm_cmpneq_pd(m, _mm_setzero_pd());
+        return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+    }
+    static inline M lt(const V a, const V b) { return _mm_cmplt_pd(a, b); }
+    static inline M le(const V a, const V b) { return _mm_cmple_pd(a, b); }
+    static inline M maskAnd(const M a, const M b) { return _mm_and_pd(a, b); }
+    static inline unsigned maskBits(const M m) { return static_cast<unsigned>(_mm_movemask_pd(m)); }
+    static inline V select(const M m, const V a, const V b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+    static inline V abs(const V a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static inline V copySign(const V mag, const V sign)
+    {
+        const V signBit = _mm_set1_pd(-0.0);
+        return _mm_or_pd(_mm_and_pd(signBit, sign), _mm_andnot_pd(signBit, mag));
+    }
+    // SSE2 has no rounding instructions, so this goes via a truncating integer conversion.
+    // It's only valid for non-negative values less than 2^31.
+    static inline V floorSmall(const V a) { return _mm_cvtepi32_pd(_mm_cvttpd_epi32(a)); }
+};
+
+} // sse2
+AIL_MATH_SIMD_TARGET_END
+
+//------------------------------------------------------------------------------
+// AVX2 operations.
+
+AIL_MATH_SIMD_TARGET_BEGIN("avx2")
+namespace avx2 {
+
+template <typename T_ty> struct Ops;
+
+template <>
+struct Ops<float>
+{
+    typedef __m256 V;
+    typedef __m256 M;
+    static const std::size_t width = 8;
+    static inline V load(const float * p) { return _mm256_loadu_ps(p); }
+    static inline void store(float * p, const V a) { _mm256_storeu_ps(p, a); }
+    static inline V set1(const float a) { return _mm256_set1_ps(a); }
+    static inline V add(const V a, const V b) { return _mm256_add_ps(a, b); }
+    static inline V sub(const V a, const V b) { return _mm256_sub_ps(a, b); }
+    static inline V mul(const V a, const V b) { return _mm256_mul_ps(a, b); }
+    static inline V div(const V a, const V b) { return _mm256_div_ps(a, b); }
+    static inline V sqrt(const V a) { return _mm256_sqrt_ps(a); }
+    static inline V min(const V a, const V b) { return _mm256_min_ps(a, b); }
+    static inline V max(const V a, const V b) { return _mm256_max_ps(a, b); }
+    static inline unsigned cmpLe(const V a, const V b) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ))); }
+    static inline V selectNonZero(const V m, const V a, const V b)
+    {
+        return _mm256_blendv_ps(b, a, _mm256_cmp_ps(m, _mm256_setzero_ps(), _CMP_NEQ_UQ));
+    }
+    static inline M lt(const V a, const V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static inline M le(const V a, const V b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static inline M maskAnd(const M a, const M b) { return _mm256_and_ps(a, b); }
+    static inline unsigned maskBits(const M m) { return static_cast<unsigned>(_mm256_movemask_ps(m)); }
+    static inline V select(const M m, const V a, const V b) { return _mm256_blendv_ps(b, a, m); }
+    static inline V abs(const V a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static inline __m256d widenLow(const V a) { return _mm256_cvtps_pd(_mm256_castps256_ps128(a)); }
+    static inline __m256d widenHigh(const V a) { return _mm256_cvtps_pd(_mm256_extractf128_ps(a, 1)); }
+    static inline V narrow(const __m256d low, const __m256d high)
+    {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(low)), _mm256_cvtpd_ps(high), 1);
+    }
+};
+
+template <>
+struct Ops<double>
+{
+    typedef __m256d V;
+    typedef __m256d M;
+    static const std::size_t width = 4;
+    static inline V load(const double * p) { return _mm256_loadu_pd(p); }
+    static inline void store(double * p, const V a) { _mm256_storeu_pd(p, a); }
+    static inline V set1(const double a) { return _mm256_set1_pd(a); }
+    static inline V add(const V a, const V b) { return _mm256_add_pd(a, b); }
+    static inline V sub(const V a, const V b) { return _mm256_sub_pd(a, b); }
+    static inline V mul(const V a, const V b) { return _mm256_mul_pd(a, b); }
+    static inline V div(const V a, const V b) { return _mm256_div_pd(a, b); }
+    static inline V sqrt(const V a) { return _mm256_sqrt_pd(a); }
+    static inline V min(const V a, const V b) { return _mm256_min_pd(a, b); }
+    static inline V max(const V a, const V b) { return _mm256_max_pd(a, b); }
+    static inline unsigned cmpLe(const V a, const V b) { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LE_OQ))); }
+    static inline V selectNonZero(const V m, const V a, const V b)
+    {
+        return _mm256_blendv_pd(b, a, _mm256_cmp_pd(m, _mm256_setzero_pd(), _CMP_NEQ_UQ));
+    }
+    static inline M lt(const V a, const V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static inline M le(const V a, const V b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    static inline M maskAnd(const M a, const M b) { return _mm256_and_pd(a, b); }
+    static inline unsigned maskBits(const M m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+    static inline V select(const M m, const V a, const V b) { return _mm256_blendv_pd(b, a, m); }
+    static inline V abs(const V a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static inline V copySign(const V mag, const V sign)
+    {
+        const V signBit = _mm256_set1_pd(-0.0);
+        return _mm256_or_pd(_mm256_and_pd(signBit, sign), _mm256_andnot_pd(signBit, mag));
+    }
+    static inline V floorSmall(const V a) { return _mm256_floor_pd(a); }
+};
+
+} // avx2
+AIL_MATH_SIMD_TARGET_END
+
+#if defined(AIL_MATH_SIMD_AVX512)
+
+//------------------------------------------------------------------------------
+// AVX-512 operations.
+
+// GCC falsely warns about the _mm512_undefined_* placeholders inside the intrinsics (GCC bug 105593).
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+AIL_MATH_SIMD_TARGET_BEGIN("avx512f")
+namespace avx512 {
+
+template <typename T_ty> struct Ops;
+
+template <>
+struct Ops<float>
+{
+    typedef __m512 V;
+    typedef __mmask16 M;
+    static const std::size_t width = 16;
+    static inline V load(const float * p) { return _mm512_loadu_ps(p); }
+    static inline void store(float * p, const V a) { _mm512_storeu_ps(p, a); }
+    static inline V set1(const float a) { return _mm512_set1_ps(a); }
+    static inline V add(const V a, const V b) { return _mm512_add_ps(a, b); }
+    static inline V sub(const V a, const V b) { return _mm512_sub_ps(a, b); }
+    static inline V mul(const V a, const V b) { return _mm512_mul_ps(a, b); }
+    static inline V div(const V a, const V b) { return _mm512_div_ps(a, b); }
+    static inline V sqrt(const V a) { return _mm512_sqrt_ps(a); }
+    static inline V min(const V a, const V b) { return _mm512_min_ps(a, b); }
+    static inline V max(const V a, const V b) { return _mm512_max_ps(a, b); }
+    static inline unsigned cmpLe(const V a, const V b) { return static_cast<unsigned>(_mm512_cmp_ps_mask(a, b, _CMP_LE_OQ)); }
+    static inline V selectNonZero(const V m, const V a, const V b)
+    {
+        return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(m, _mm512_setzero_ps(), _CMP_NEQ_UQ), b, a);
+    }
+    static inline M lt(const V a, const V b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static inline M le(const V a, const V b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+    static inline M maskAnd(const M a, const M b) { return static_cast<M>(a & b); }
+    static inline unsigned maskBits(const M m) { return static_cast<unsigned>(m); }
+    static inline V select(const M m, const V a, const V b) { return _mm512_mask_blend_ps(m, b, a); }
+    static inline V abs(const V a) { return _mm512_abs_ps(a); }
+    static inline __m512d widenLow(const V a) { return _mm512_cvtps_pd(_mm512_castps512_ps256(a)); }
+    static inline __m512d widenHigh(const V a)
+    {
+        return _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(a), 1)));
+    }
+    static inline V narrow(const __m512d low, const __m512d high)
+    {
+        const __m512d lowHalf = _mm512_castps_pd(_mm512_castps256_ps512(_mm512_cvtpd_ps(low)));
+        return _mm512_castpd_ps(_mm512_insertf64x4(lowHalf, _mm256_castps_pd(_mm512_cvtpd_ps(high)), 1));
+    }
+};
+
+template <>
+struct Ops<double>
+{
+    typedef __m512d V;
+    typedef __mmask8 M;
+    static const std::size_t width = 8;
+    static inline V load(const double * p) { return _mm512_loadu_pd(p); }
+    static inline void store(double * p, const V a) { _mm512_storeu_pd(p, a); }
+    static inline V set1(const double a) { return _mm512_set1_pd(a); }
+    static inline V add(const V a, const V b) { return _mm512_add_pd(a, b); }
+    static inline V sub(const V a, const V b) { return _mm512_sub_pd(a, b); }
+    static inline V mul(const V a, const V b) { return _mm512_mul_pd(a, b); }
+    static inline V div(const V a, const V b) { return _mm512_div_pd(a, b); }
+    static inline V sqrt(const V a) { return _mm512_sqrt_pd(a); }
+    static inline V min(const V a, const V b) { return _mm512_min_pd(a, b); }
+    static inline V max(const V a, const V b) { return _mm512_max_pd(a, b); }
+    static inline unsigned cmpLe(const V a, const V b) { return static_cast<unsigned>(_mm512_cmp_pd_mask(a, b, _CMP_LE_OQ)); }
+    static inline V selectNonZero(const V m, const V a, const V b)
+    {
+        return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(m, _mm512_setzero_pd(), _CMP_NEQ_UQ), b, a);
+    }
+    static inline M lt(const V a, const V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static inline M le(const V a, const V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+    static inline M maskAnd(const M a, const M b) { return static_cast<M>(a & b); }
+    static inline unsigned maskBits(const M m) { return static_cast<unsigned>(m); }
+    static inline V select(const M m, const V a, const V b) { return _mm512_mask_blend_pd(m, b, a); }
+    static inline V abs(const V a) { return _mm512_abs_pd(a); }
+    static inline V copySign(const V mag, const V sign)
+    {
+        // AVX-512F only has bitwise operations on integer registers.
+        const __m512i signBit = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ull));
+        return _mm512_castsi512_pd(_mm512_or_si512(
+            _mm512_and_si512(signBit, _mm512_castpd_si512(sign)),
+            _mm512_andnot_si512(signBit, _mm512_castpd_si512(mag))));
+    }
+    static inline V floorSmall(const V a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+};
+
+} // avx512
+AIL_MATH_SIMD_TARGET_END
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif // AIL_MATH_SIMD_AVX512
+#endif // AIL_MATH_SIMD_X86
+
+//------------------------------------------------------------------------------
+// Dispatching.
+
+// Calls the named kernel for the currently selected SIMD level.
+// The kernel must be implemented in the scalar namespace and in every instruction set namespace.
+#if defined(AIL_MATH_SIMD_AVX512)
+    #define AIL_MATH_KERNEL_DISPATCH(name, T_ty, args) \
+        switch (getSimdLevel()) { \
+        case SimdLevel::AVX512: avx512::name<T_ty> args; return; \
+        case SimdLevel::AVX2:   avx2::name<T_ty> args; return; \
+        case SimdLevel::SSE2:   sse2::name<T_ty> args; return; \
+        default:                scalar::name<T_ty> args; return; \
+        }
+#elif defined(AIL_MATH_SIMD_X86)
+    #define AIL_MATH_KERNEL_DISPATCH(name, T_ty, args) \
+        switch (getSimdLevel()) { \
+        case SimdLevel::AVX2:   avx2::name<T_ty> args; return; \
+        case SimdLevel::SSE2:   sse2::name<T_ty> args; return; \
+        default:                scalar::name<T_ty> args; return; \
+        }
+#else
+    #define AIL_MATH_KERNEL_DISPATCH(name, T_ty, args) \
+        scalar::name<T_ty> args;
+#endif
+
+//--------------
+} // kernels
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_SimdOps_h
@@ -0,0 +1,223 @@
+#ifndef ail_math_SpatialHashGrid_h
+#define ail_math_SpatialHashGrid_h
+
+/** \file SpatialHashGrid.h
+    \brief Declares a uniform spatial hash grid of points. See SpatialHashGrid.inl for implementation.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/** A uniform grid of square cells, used as a spatial index of points.
+The grid is unbounded. Each cell is hashed into one of a number of buckets, and
+ the points in each bucket form an intrusive linked list. This makes it cheap to
+ insert, remove and move individual points, which suits large numbers of evenly
+ distributed, fast-moving points.
+Alternatively, the whole grid can be rebuilt in one go from an array of
+ positions. This uses a single counting sort by bucket, so it runs in linear
+ time, and it leaves the points of each bucket stored contiguously in memory.
+ That makes subsequent queries cache-friendly. Incremental updates gradually
+ scatter the storage again, until the next rebuild.
+Cell coordinates are calculated in double precision, and must fit in a 64-bit
+ signed integer. Internally, points and buckets are indexed with 32 bits to keep
+ the storage compact, so the grid can hold up to 2^31 points.
+Template parameter gives the underlying numerical type, typically float or double.
+*/
+template <typename T_ty>
+class SpatialHashGrid
+{
+public:
+    /// Identifies a point in the grid.
+    typedef std::size_t Handle;
+
+    /// A handle value which never refers to a point.
+    static const Handle invalidHandle = static_cast<Handle>(-1);
+
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - creates an empty grid.
+    /// cellSize gives the width and height of each cell. It is usually best to
+    ///  make it similar to the typical query radius.
+    /// bucketCount is rounded up to a power of 2. The grid will increase it as
+    ///  necessary, so that there are always at least as many buckets as points.
+    /// Throws std::invalid_argument if cellSize isn't positive, or std::length_error
+    ///  if bucketCount is more than 2^31.
+    explicit SpatialHashGrid(const T_ty cellSize, const std::size_t bucketCount = 1024);
+
+
+//------------------------------------------------------------------------------
+// Modifiers.
+
+    /// Add a point to the grid, and return its handle.
+    /// Throws std::length_error if the grid already holds 2^31 points.
+    Handle insert(const Vector2d<T_ty> & pos);
+
+    /// Remove a point from the grid. Its handle may then be reused by a later insertion.
+    /// Throws std::invalid_argument if the handle doesn't refer to a point.
+    void remove(const Handle handle);
+
+    /// Move a point to a new position. This takes constant time.
+    /// Throws std::invalid_argument if the handle doesn't refer to a point.
+    void move(const Handle handle, const Vector2d<T_ty> & pos);
+
+    /// Remove all points. This keeps the allocated storage.
+    void clear();
+
+    /// Replace the contents of the grid with the given array of positions.
+    /// The handle of each point will be its index in the array.
+    /// Throws std::length_error if count is more than 2^31.
+    void rebuild(const Vector2d<T_ty> * positions, const std::size_t count);
+
+    /// Replace the contents of the grid with the given lanes of x and y components.
+    /// The handle of each point will be its index in the lanes.
+    /// This can be used with the lanes of a Vector2dArray.
+    /// Throws std::length_error if count is more than 2^31.
+    void rebuild(const T_ty * x, const T_ty * y, const std::size_t count);
+
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+    /// Get the width and height of each cell.
+    T_ty getCellSize() const;
+
+    /// Get the number of hash buckets.
+    std::size_t getBucketCount() const;
+
+    /// Get the number of points in the grid.
+    std::size_t size() const;
+
+    /// Check if the grid has no points.
+    bool empty() const;
+
+    /// Check if a handle refers to a point currently in the grid.
+    bool contains(const Handle handle) const;
+
+    /// Get the position of a point.
+    /// The handle must refer to a point currently in the grid.
+    const Vector2d<T_ty> & getPosition(const Handle handle) const;
+
+
+//------------------------------------------------------------------------------
+// Queries.
+
+    /// Find all points within a certain distance of the given point.
+    /// This gives the same results as calling Vector2d::isNear() on every point.
+    /// Results are appended to the output container, without clearing it first.
+    void queryRadius(const Vector2d<T_ty> & point, const T_ty dist, std::vector<Handle> & output) const;
+
+
+private:
+//------------------------------------------------------------------------------
+// Internal types.
+
+    /// Index of a slot, handle or bucket.
+    typedef std::uint32_t Index;
+
+    /// Storage for a point in the grid.
+    /// Slots are kept densely packed, and are reordered by bucket on rebuild.
+    /// The cell isn't stored, since it's cheap to recalculate from the position
+    ///  and that keeps the slot small.
+    struct Slot
+    {
+        /// Position of the point.
+        Vector2d<T_ty> pos;
+        /// Bucket containing the point.
+        Index bucket;
+        /// Handle of the point stored in this slot.
+        Index handle;
+        /// Previous slot in the same bucket, or npos.
+        Index prev;
+        /// Next slot in the same bucket, or npos.
+        Index next;
+    };
+
+    /// Index value meaning "none".
+    static const Index npos = static_cast<Index>(-1);
+
+    /// Maximum number of points or buckets.
+    static const std::size_t maxSize = std::size_t(1) << 31;
+
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+    /// Throw std::invalid_argument if the handle doesn't refer to a point.
+    void checkHandle(const Handle handle) const;
+
+    /// Get the cell coordinate containing the given position component.
+    std::int64_t getCell(const double val) const;
+
+    /// Get the bucket for the given cell.
+    Index getBucket(const std::int64_t cellX, const std::int64_t cellY) const;
+
+    /// Get the bucket for the cell containing the given position.
+    Index getBucket(const Vector2d<T_ty> & pos) const;
+
+    /// Check if a position is in the given cell.
+    bool isInCell(const Vector2d<T_ty> & pos, const std::int64_t cellX, const std::int64_t cellY) const;
+
+    /// Add a slot to the front of its bucket's list.
+    void link(const Index slot);
+
+    /// Remove a slot from its bucket's list.
+    void unlink(const Index slot);
+
+    /// Change the number of buckets (which must be a power of 2), and re-link every point.
+    void setBucketCount(const std::size_t bucketCount);
+
+    /// Change the number of buckets (which must be a power of 2), without re-linking anything.
+    void resizeBuckets(const std::size_t bucketCount);
+
+    /// Build the grid from a set of positions, given by a function of the index.
+    template <typename T_getPos>
+    void rebuildFrom(const std::size_t count, const T_getPos & getPos);
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// Width and height of each cell.
+    T_ty m_cellSize;
+
+    /// Reciprocal of the cell size.
+    double m_cellScale;
+
+    /// Number of bits in a bucket index.
+    unsigned m_bucketBits;
+
+    /// Index of the first slot in each bucket, or npos.
+    std::vector<Index> m_buckets;
+
+    /// Storage for the points, densely packed.
+    std::vector<Slot> m_slots;
+
+    /// Slot containing each handle's point, or npos if the handle is free.
+    std::vector<Index> m_slotOf;
+
+    /// Handles which are free to be reused.
+    std::vector<Index> m_freeHandles;
+
+    /// Bucket of each point during a rebuild, kept to avoid reallocating every time.
+    std::vector<Index> m_sortBuckets;
+};
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_SpatialHashGrid_h
@@ -0,0 +1,418 @@
+#ifndef ail_math_SpatialHashGrid_inl
+#define ail_math_SpatialHashGrid_inl
+
+/** \file SpatialHashGrid.inl
+    \brief Implementation for a uniform spatial hash grid of points (see SpatialHashGrid.h).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+#include "Config.h"
+#include "SpatialHashGrid.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+template <typename T_ty>
+const typename SpatialHashGrid<T_ty>::Handle SpatialHashGrid<T_ty>::invalidHandle;
+
+template <typename T_ty>
+const typename SpatialHashGrid<T_ty>::Index SpatialHashGrid<T_ty>::npos;
+
+template <typename T_ty>
+const std::size_t SpatialHashGrid<T_ty>::maxSize;
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+template <typename T_ty>
+SpatialHashGrid<T_ty>::SpatialHashGrid(const T_ty cellSize, const std::size_t bucketCount) :
+    m_cellSize(cellSize),
+    m_cellScale(1.0 / static_cast<double>(cellSize)),
+    m_bucketBits(0),
+    m_buckets(),
+    m_slots(),
+    m_slotOf(),
+    m_freeHandles(),
+    m_sortBuckets()
+{
+    if (!(cellSize > T_ty(0)))
+        throw std::invalid_argument("Spatial hash grid cell size must be positive.");
+    if (bucketCount > maxSize)
+        throw std::length_error("Too many buckets for a spatial hash grid.");
+
+    std::size_t buckets = 1;
+    while (buckets < bucketCount)
+        buckets *= 2;
+    resizeBuckets(buckets);
+    m_buckets.assign(buckets, npos);
+}
+
+//------------------------------------------------------------------------------
+// Modifiers.
+
+template <typename T_ty>
+typename SpatialHashGrid<T_ty>::Handle SpatialHashGrid<T_ty>::insert(const Vector2d<T_ty> & pos)
+{
+    if (m_slots.size() >= maxSize)
+        throw std::length_error("Too many points for a spatial hash grid.");
+
+    // Keep the load factor at 1 or below, so the bucket lists stay short.
+    if (m_slots.size() >= m_buckets.size())
+        setBucketCount(m_buckets.size() * 2);
+
+    // Reuse a free handle if there is one.
+    Index handle = 0;
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    } else {
+        handle = static_cast<Index>(m_slotOf.size());
+        m_slotOf.push_back(npos);
+    }
+
+    const Index slot = static_cast<Index>(m_slots.size());
+    m_slots.push_back(Slot());
+    m_slots[slot].pos = pos;
+    m_slots[slot].bucket = getBucket(pos);
+    m_slots[slot].handle = handle;
+    link(slot);
+    m_slotOf[handle] = slot;
+    return handle;
+}
+
+template <typename T_ty>
+void SpatialHashGrid<T_ty>::remove(const Handle handle)
+{
+    checkHandle(handle);
+
+    const Index slot = m_slotOf[handle];
+    unlink(slot);
+    m_slotOf[handle] = npos;
+    m_freeHandles.push_back(static_cast<Index>(handle));
+
+    // Fill the gap with the last slot, so the storage stays densely packed.
+    const Index last = static_cast<Index>(m_slots.size() - 1);
+    if (slot != last) {
+        Slot & moved = m_slots[slot];
+        moved = m_slots[last];
+
+        if (moved.prev != npos)
+            m_slots[moved.prev].next = slot;
+        else
+            m_buckets[moved.bucket] = slot;
+
+        if (moved.next != npos)
+            m_slots[moved.next].prev = slot;
+
+        m_slotOf[moved.handle] = slot;
+    }
+    m_slots.pop_back();
+}
+
+template <typename T_ty>
+void SpatialHashGrid<T_ty>::move(const Handle handle, const Vector2d<T_ty> & pos)
+{
+    checkHandle(handle);
+
+    const Index slot = m_slotOf[handle];
+    Slot & s = m_slots[slot];
+    const Index newBucket = getBucket(pos);
+    s.pos = pos;
+
+    // The point only needs re-linking if it has changed bucket.
+    if (s.bucket != newBucket) {
+        unlink(slot);
+        s.bucket = newBucket;
+        link(slot);
+    }
+}
+
+template <typename T_ty>
+void SpatialHashGrid<T_ty>::clear()
+{
+    m_buckets.assign(m_buckets.size(), npos);
+    m_slots.clear();
+    m_slotOf.clear();
+    m_freeHandles.clear();
+}
+
+template <typename T_ty>
+void SpatialHashGrid<T_ty>::rebuild(const Vector2d<T_ty> * positions, const std::size_t count)
+{
+    rebuildFrom(count, [positions](const std::size_t i) { return positions[i]; });
+}
+
+template <typename T_ty>
+void SpatialHashGrid<T_ty>::rebuild(const T_ty * x, const T_ty * y, const std::size_t count)
+{
+    rebuildFrom(count, [x, y](const std::size_t i) { return Vector2d<T_ty>(x[i], y[i]); });
+}
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+template <typename T_ty>
+T_ty SpatialHashGrid<T_ty>::getCellSize() const
+{
+    return m_cellSize;
+}
+
+template <typename T_ty>
+std::size_t SpatialHashGrid<T_ty>::getBucketCount() const
+{
+    return m_buckets.size();
+}
+
+template <typename T_ty>
+std::size_t SpatialHashGrid<T_ty>::size() const
+{
+    return m_slots.size();
+}
+
+template <typename T_ty>
+bool SpatialHashGrid<T_ty>::empty() const
+{
+    return m_slots.empty();
+}
+
+template <typename T_ty>
+bool SpatialHashGrid<T_ty>::contains(const Handle handle) const
+{
+    return handle < m_slotOf.size() && m_slotOf[handle] != npos;
+}
+
+template <typename T_ty>
+const Vector2d<T_ty> & SpatialHashGrid<T_ty>::getPosition(const Handle handle) const
+{
+    assert(contains(handle));
+    return m_slots[m_slotOf[handle]].pos;
+}
+
+//------------------------------------------------------------------------------
+// Queries.
+
+template <typename T_ty>
+void SpatialHashGrid<T_ty>::queryRadius(const Vector2d<T_ty> & point, const T_ty dist, std::vector<Handle> & output) const
+{
+    // Vector2d::isNear() can accept a point fractionally further away than dist,
+    //  due to rounding when squaring. The range of cells is padded slightly to
+    //  make sure no such point is missed.
+    const double pad = std::fabs(static_cast<double>(dist)) * (1.0 + (1.0 / 1024.0));
+    const std::int64_t minX = getCell(static_cast<double>(point.x) - pad);
+    const std::int64_t maxX = getCell(static_cast<double>(point.x) + pad);
+    const std::int64_t minY = getCell(static_cast<double>(point.y) - pad);
+    const std::int64_t maxY = getCell(static_cast<double>(point.y) + pad);
+
+    // If the query covers more cells than there are buckets, it's quicker to check every point.
+    const double cellCount = (static_cast<double>(maxX - minX) + 1.0) * (static_cast<double>(maxY - minY) + 1.0);
+    if (cellCount > static_cast<double>(m_buckets.size())) {
+        for (std::size_t i = 0; i < m_slots.size(); ++i) {
+            if (m_slots[i].pos.isNear(point, dist))
+                output.push_back(m_slots[i].handle);
+        }
+        return;
+    }
+
+    for (std::int64_t cellY = minY; cellY <= maxY; ++cellY) {
+        for (std::int64_t cellX = minX; cellX <= maxX; ++cellX) {
+            // Buckets can be shared by several cells, so check each point's cell too.
+            // This also ensures that no point is output twice.
+            Index i = m_buckets[getBucket(cellX, cellY)];
+            while (i != npos) {
+                const Slot & slot = m_slots[i];
+                if (slot.pos.isNear(point, dist) && isInCell(slot.pos, cellX, cellY))
+                    output.push_back(slot.handle);
+                i = slot.next;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+template <typename T_ty>
+void SpatialHashGrid<T_ty>::checkHandle(const Handle handle) const
+{
+    if (!contains(handle))
+        throw std::invalid_argument("Handle does not refer to a point in the spatial hash grid.");
+}
+
+template <typename T_ty>
+std::int64_t SpatialHashGrid<T_ty>::getCell(const double val) const
+{
+    // Truncating and correcting for negatives matches std::floor for the
+    //  range of cells used here, but it's much quicker on a hot path.
+    const double scaled = val * m_cellScale;
+    std::int64_t cell = static_cast<std::int64_t>(scaled);
+    if (scaled < static_cast<double>(cell))
+        --cell;
+    return cell;
+}
+
+template <typename T_ty>
+typename SpatialHashGrid<T_ty>::Index SpatialHashGrid<T_ty>::getBucket(const std::int64_t cellX, const std::int64_t cellY) const
+{
+    if (m_bucketBits == 0)
+        return 0;
+
+    // Multiplicative hashing, taking the top bits which are the best mixed.
+    const std::uint64_t hash =
+        (static_cast<std::uint64_t>(cellX) * 0x9E3779B97F4A7C15ULL) ^
+        (static_cast<std::uint64_t>(cellY) * 0xC2B2AE3D27D4EB4FULL);
+    return static_cast<Index>(hash >> (64 - m_bucketBits));
+}
+
+template <typename T_ty>
+typename SpatialHashGrid<T_ty>::Index SpatialHashGrid<T_ty>::getBucket(const Vector2d<T_ty> & pos) const
+{
+    return getBucket(getCell(static_cast<double>(pos.x)), getCell(static_cast<double>(pos.y)));
+}
+
+template <typename T_ty>
+bool SpatialHashGrid<T_ty>::isInCell(const Vector2d<T_ty> & pos, const std::int64_t cellX, const std::int64_t cellY) const
+{
+    return getCell(static_cast<double>(pos.x)) == cellX && getCell(static_cast<double>(pos.y)) == cellY;
+}
+
+template <typename T_ty>
+void SpatialHashGrid<T_ty>::link(const Index slot)
+{
+    Slot & s = m_slots[slot];
+    s.prev = npos;
+    s.next = m_buckets[s.bucket];
+
+    if (s.next != npos)
+        m_slots[s.next].prev = slot;
+
+    m_buckets[s.bucket] = slot;
+}
+
+template <typename T_ty>
+void SpatialHashGrid<T_ty>::unlink(const Index slot)
+{
+    Slot & s = m_slots[slot];
+
+    if (s.prev != npos)
+        m_slots[s.prev].next = s.next;
+    else
+        m_buckets[s.bucket] = s.next;
+
+    if (s.next != npos)
+        m_slots[s.next].prev = s.prev;
+
+    s.prev = npos;
+    s.next = npos;
+}
+
+template <typename T_ty>
+void SpatialHashGrid<T_ty>::setBucketCount(const std::size_t bucketCount)
+{
+    if (bucketCount == m_buckets.size())
+        return;
+
+    resizeBuckets(bucketCount);
+    m_buckets.assign(bucketCount, npos);
+
+    // Link in reverse so that each list ends up in ascending order of slot.
+    for (Index i = static_cast<Index>(m_slots.size()); i > 0; --i) {
+        Slot & s = m_slots[i - 1];
+        s.bucket = getBucket(s.pos);
+        link(i - 1);
+    }
+}
+
+template <typename T_ty>
+void SpatialHashGrid<T_ty>::resizeBuckets(const std::size_t bucketCount)
+{
+    assert(bucketCount > 0 && (bucketCount & (bucketCount - 1)) == 0);
+
+    m_bucketBits = 0;
+    while ((std::size_t(1) << m_bucketBits) < bucketCount)
+        ++m_bucketBits;
+    m_buckets.resize(bucketCount);
+}
+
+template <typename T_ty>
+template <typename T_getPos>
+void SpatialHashGrid<T_ty>::rebuildFrom(const std::size_t count, const T_getPos & getPos)
+{
+    if (count > maxSize)
+        throw std::length_error("Too many points for a spatial hash grid.");
+
+    std::size_t bucketCount = m_buckets.size();
+    while (bucketCount < count)
+        bucketCount *= 2;
+    resizeBuckets(bucketCount);
+
+    // The points are sorted by bucket with a single counting sort: count the
+    //  points in each bucket, turn the counts into offsets, then scatter each
+    //  point straight into its slot. The bucket array holds the counts and
+    //  offsets while sorting, so no other scratch space is needed for them.
+    m_sortBuckets.resize(count);
+    m_buckets.assign(bucketCount, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        const Index bucket = getBucket(getPos(i));
+        m_sortBuckets[i] = bucket;
+        ++m_buckets[bucket];
+    }
+
+    Index offset = 0;
+    for (std::size_t b = 0; b < bucketCount; ++b) {
+        const Index bucketSize = m_buckets[b];
+        m_buckets[b] = offset;
+        offset += bucketSize;
+    }
+
+    // The scatter writes to effectively random slots, so it's limited by cache
+    //  misses. Prefetching the slot a few points ahead overlaps them.
+    const std::size_t prefetchDistance = 16;
+    m_slots.resize(count);
+    m_slotOf.resize(count);
+    m_freeHandles.clear();
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i + prefetchDistance < count)
+            AIL_MATH_PREFETCH_WRITE(&m_slots[m_buckets[m_sortBuckets[i + prefetchDistance]]]);
+
+        const Index bucket = m_sortBuckets[i];
+        const Index k = m_buckets[bucket]++;
+        Slot & slot = m_slots[k];
+        slot.pos = getPos(i);
+        slot.bucket = bucket;
+        slot.handle = static_cast<Index>(i);
+        m_slotOf[i] = k;
+    }
+
+    // Each offset has moved on to the end of its bucket, which is where the
+    //  next bucket starts. Empty buckets are the ones which didn't move.
+    Index bucketStart = 0;
+    for (std::size_t b = 0; b < bucketCount; ++b) {
+        const Index bucketEnd = m_buckets[b];
+        m_buckets[b] = (bucketEnd == bucketStart) ? npos : bucketStart;
+        bucketStart = bucketEnd;
+    }
+
+    // The points of each bucket are now contiguous, so they can be linked in order.
+    for (Index k = 0; k < count; ++k) {
+        Slot & slot = m_slots[k];
+        slot.prev = (k > 0 && m_slots[k - 1].bucket == slot.bucket) ? k - 1 : npos;
+        slot.next = (k + 1 < count && m_slots[k + 1].bucket == slot.bucket) ? k + 1 : npos;
+    }
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_SpatialHashGrid_inl
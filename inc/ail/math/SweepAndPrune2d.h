@@ -0,0 +1,226 @@
+#ifndef ail_math_SweepAndPrune2d_h
+#define ail_math_SweepAndPrune2d_h
+
+/** \file SweepAndPrune2d.h
+    \brief Declares a sweep-and-prune broadphase for 2d boxes. See SweepAndPrune2d.inl for implementation.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "BoundingBox2d.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/** A persistent sweep-and-prune (a.k.a. sort-and-sweep) broadphase.
+This keeps track of which pairs of boxes overlap, for large numbers of moving
+ boxes. The ends of every box are kept sorted along each axis. When boxes move,
+ the lists are re-sorted using insertion sort, which is very fast when they are
+ nearly sorted already. Pairs are only checked when the ends of their boxes
+ swap places, so the cost depends on how much the boxes move between updates,
+ rather than on the total number of pairs.
+If lots of boxes are added at once, the lists are sorted and swept from scratch
+ instead.
+Changes to the boxes take effect when update() is called, which reports the
+ pairs which have started or stopped overlapping since the last update.
+Two boxes overlap if their extents (as given by BoundingBox2d::getCornerX1Y1()
+ and BoundingBox2d::getCornerX2Y2()) overlap on both axes, including if they
+ just touch. This matches BoundingBox2d::intersects() apart from rounding.
+Template parameter gives the underlying numerical type (e.g. float or double).
+*/
+template <typename T_ty>
+class SweepAndPrune2d
+{
+public:
+    /// Identifies a box in the broadphase.
+    typedef std::size_t Handle;
+
+    /// A pair of overlapping boxes. The first handle is always less than the second.
+    typedef std::pair<Handle, Handle> Pair;
+
+    /// A handle value which never refers to a box.
+    static const Handle invalidHandle = static_cast<Handle>(-1);
+
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - creates an empty broadphase.
+    SweepAndPrune2d();
+
+
+//------------------------------------------------------------------------------
+// Modifiers.
+// Changes made by these functions are not reflected in the overlapping pairs
+//  until update() is called.
+
+    /// Add a box, and return its handle.
+    /// Throws std::length_error if there are too many boxes.
+    Handle insert(const BoundingBox2d<T_ty> & box);
+
+    /// Remove a box. Its handle may be reused by insertions after the next update.
+    /// Throws std::invalid_argument if the handle doesn't refer to a box.
+    void remove(const Handle handle);
+
+    /// Change the position and/or size of a box.
+    /// Throws std::invalid_argument if the handle doesn't refer to a box.
+    void setBox(const Handle handle, const BoundingBox2d<T_ty> & box);
+
+    /// Remove all boxes and pairs immediately, without reporting any changes.
+    void clear();
+
+    /// Bring the overlapping pairs up to date with all changes since the last update.
+    /// Pairs which have started overlapping are appended to added, and pairs
+    ///  which have stopped overlapping (including because a box was removed)
+    ///  are appended to removed. Neither container is cleared first.
+    void update(std::vector<Pair> & added, std::vector<Pair> & removed);
+
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+    /// Get the number of boxes, including any added or removed since the last update.
+    std::size_t size() const;
+
+    /// Check if there are no boxes.
+    bool empty() const;
+
+    /// Check if a handle refers to a box which hasn't been removed.
+    bool contains(const Handle handle) const;
+
+    /// Get a box.
+    /// The handle must refer to a box which hasn't been removed.
+    const BoundingBox2d<T_ty> & getBox(const Handle handle) const;
+
+    /// Get the number of overlapping pairs, as of the last update.
+    std::size_t getPairCount() const;
+
+    /// Check if two boxes overlapped, as of the last update.
+    bool isOverlapping(const Handle a, const Handle b) const;
+
+    /// Get all the overlapping pairs, as of the last update.
+    /// They are appended to the output container, in no particular order.
+    void getPairs(std::vector<Pair> & output) const;
+
+
+private:
+//------------------------------------------------------------------------------
+// Internal types.
+
+    /// The state of a box.
+    enum State
+    {
+        /// The handle isn't in use.
+        StateFree,
+        /// The box has been inserted since the last update.
+        StateInserted,
+        /// The box is included in the sorted lists.
+        StateActive,
+        /// The box has been removed since the last update.
+        StateRemoved
+    };
+
+    /// A box, identified by its handle.
+    struct Proxy
+    {
+        /// The box as it was given.
+        BoundingBox2d<T_ty> box;
+        /// Corner of the box with the lowest coordinates.
+        Vector2d<T_ty> min;
+        /// Corner of the box with the highest coordinates.
+        Vector2d<T_ty> max;
+        /// Number of pairs the box is in. This lets most lookups in the set of
+        ///  pairs be skipped when boxes are far apart.
+        std::size_t pairCount;
+        /// The state of the box.
+        State state;
+    };
+
+    /// One end of a box along an axis.
+    /// Values are stored here as well as in the box, so that sorting doesn't
+    ///  need to look anything up.
+    struct Endpoint
+    {
+        /// Position of this end along the axis.
+        T_ty value;
+        /// Handle of the box, shifted left by 1. The lowest bit is set for the maximum end.
+        std::uint32_t data;
+    };
+
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+    /// Throw std::invalid_argument if the handle doesn't refer to a box which hasn't been removed.
+    void checkHandle(const Handle handle) const;
+
+    /// Check if one endpoint should be sorted before another.
+    /// At equal positions, minimum ends come first so that touching boxes overlap.
+    static bool isBefore(const Endpoint & lhs, const Endpoint & rhs);
+
+    /// Make a key to identify a pair of boxes in the set of pairs.
+    static std::uint64_t makeKey(const Handle a, const Handle b);
+
+    /// Make a pair from a key.
+    static Pair makePair(const std::uint64_t key);
+
+    /// Check if two boxes overlap, based on their current extents.
+    bool overlaps(const Handle a, const Handle b) const;
+
+    /// Add a pair to the set, if it isn't already there.
+    void addPair(const Handle a, const Handle b, std::vector<Pair> & added);
+
+    /// Remove a pair from the set, if it's there.
+    void removePair(const Handle a, const Handle b, std::vector<Pair> & removed);
+
+    /// Check if two boxes overlap, and add or remove their pair if it has changed.
+    void updatePair(const Handle a, const Handle b, std::vector<Pair> & added, std::vector<Pair> & removed);
+
+    /// Re-sort the endpoints along one axis, updating pairs whose ends swap places.
+    void sortAxis(const int axis, std::vector<Pair> & added, std::vector<Pair> & removed);
+
+    /// Sort both axes from scratch, and find all the overlapping pairs with a single sweep.
+    void rebuild(std::vector<Pair> & added, std::vector<Pair> & removed);
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// Boxes, indexed by handle.
+    std::vector<Proxy> m_proxies;
+
+    /// Handles which are free to be reused.
+    std::vector<Handle> m_freeHandles;
+
+    /// Handles of boxes inserted since the last update.
+    std::vector<Handle> m_inserted;
+
+    /// Handles of boxes removed since the last update.
+    std::vector<Handle> m_removed;
+
+    /// Number of boxes which haven't been removed.
+    std::size_t m_size;
+
+    /// Endpoints of the active boxes, sorted along each axis as of the last update.
+    std::vector<Endpoint> m_endpoints[2];
+
+    /// Keys of the overlapping pairs.
+    std::unordered_set<std::uint64_t> m_pairs;
+};
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_SweepAndPrune2d_h
@@ -0,0 +1,403 @@
+#ifndef ail_math_SweepAndPrune2d_inl
+#define ail_math_SweepAndPrune2d_inl
+
+/** \file SweepAndPrune2d.inl
+    \brief Implementation for a sweep-and-prune broadphase for 2d boxes (see SweepAndPrune2d.h).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+#include "SweepAndPrune2d.h"
+#include "BoundingBox2d.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+template <typename T_ty>
+const typename SweepAndPrune2d<T_ty>::Handle SweepAndPrune2d<T_ty>::invalidHandle;
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+template <typename T_ty>
+SweepAndPrune2d<T_ty>::SweepAndPrune2d() :
+    m_proxies(),
+    m_freeHandles(),
+    m_inserted(),
+    m_removed(),
+    m_size(0),
+    m_endpoints(),
+    m_pairs()
+{
+}
+
+//------------------------------------------------------------------------------
+// Modifiers.
+
+template <typename T_ty>
+typename SweepAndPrune2d<T_ty>::Handle SweepAndPrune2d<T_ty>::insert(const BoundingBox2d<T_ty> & box)
+{
+    // Reuse a free handle if there is one.
+    Handle handle = 0;
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    } else {
+        // Handles are packed into endpoints with a flag, and pairs of them into keys.
+        if (m_proxies.size() >= (std::uint32_t(1) << 31))
+            throw std::length_error("Too many boxes for sweep and prune.");
+        handle = m_proxies.size();
+        m_proxies.push_back(Proxy());
+    }
+
+    m_proxies[handle].pairCount = 0;
+    m_proxies[handle].state = StateInserted;
+    setBox(handle, box);
+    m_inserted.push_back(handle);
+    ++m_size;
+    return handle;
+}
+
+template <typename T_ty>
+void SweepAndPrune2d<T_ty>::remove(const Handle handle)
+{
+    checkHandle(handle);
+    m_proxies[handle].state = StateRemoved;
+    m_removed.push_back(handle);
+    --m_size;
+}
+
+template <typename T_ty>
+void SweepAndPrune2d<T_ty>::setBox(const Handle handle, const BoundingBox2d<T_ty> & box)
+{
+    checkHandle(handle);
+
+    Proxy & proxy = m_proxies[handle];
+    proxy.box = box;
+    proxy.min = box.getCornerX1Y1();
+    proxy.max = box.getCornerX2Y2();
+}
+
+template <typename T_ty>
+void SweepAndPrune2d<T_ty>::clear()
+{
+    m_proxies.clear();
+    m_freeHandles.clear();
+    m_inserted.clear();
+    m_removed.clear();
+    m_size = 0;
+    m_endpoints[0].clear();
+    m_endpoints[1].clear();
+    m_pairs.clear();
+}
+
+template <typename T_ty>
+void SweepAndPrune2d<T_ty>::update(std::vector<Pair> & added, std::vector<Pair> & removed)
+{
+    // Get rid of removed boxes first, so they can't form any new pairs.
+    if (!m_removed.empty()) {
+        for (int axis = 0; axis < 2; ++axis) {
+            std::vector<Endpoint> & endpoints = m_endpoints[axis];
+            endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(),
+                [this](const Endpoint & endpoint) { return m_proxies[endpoint.data >> 1].state == StateRemoved; }),
+                endpoints.end());
+        }
+
+        for (auto it = m_pairs.begin(); it != m_pairs.end(); ) {
+            const Pair pair = makePair(*it);
+            if (m_proxies[pair.first].state == StateRemoved || m_proxies[pair.second].state == StateRemoved) {
+                --m_proxies[pair.first].pairCount;
+                --m_proxies[pair.second].pairCount;
+                removed.push_back(pair);
+                it = m_pairs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        // Handles can't be reused until now, otherwise a new box could be
+        //  mistaken for an old one.
+        for (const Handle handle : m_removed) {
+            m_proxies[handle].state = StateFree;
+            m_freeHandles.push_back(handle);
+        }
+        m_removed.clear();
+    }
+
+    // Insertion sort takes time proportional to how far each endpoint moves.
+    // Endpoints of new boxes could move anywhere, so if there are lots of them,
+    //  it's quicker to start again from scratch.
+    std::size_t insertedCount = 0;
+    for (const Handle handle : m_inserted) {
+        if (m_proxies[handle].state == StateInserted)
+            ++insertedCount;
+    }
+    if (insertedCount > 0 && insertedCount * 16 > m_size) {
+        rebuild(added, removed);
+        return;
+    }
+
+    // Bring the positions of the existing endpoints up to date.
+    for (int axis = 0; axis < 2; ++axis) {
+        for (Endpoint & endpoint : m_endpoints[axis]) {
+            const Proxy & proxy = m_proxies[endpoint.data >> 1];
+            const Vector2d<T_ty> & corner = (endpoint.data & 1) ? proxy.max : proxy.min;
+            endpoint.value = (axis == 0) ? corner.x : corner.y;
+        }
+    }
+
+    // New endpoints go on the end, and get sorted into place with the rest.
+    for (const Handle handle : m_inserted) {
+        Proxy & proxy = m_proxies[handle];
+        if (proxy.state != StateInserted)
+            continue;
+        proxy.state = StateActive;
+
+        const std::uint32_t data = static_cast<std::uint32_t>(handle) << 1;
+        const Endpoint endpointsX[2] = { { proxy.min.x, data }, { proxy.max.x, data | 1 } };
+        const Endpoint endpointsY[2] = { { proxy.min.y, data }, { proxy.max.y, data | 1 } };
+        m_endpoints[0].insert(m_endpoints[0].end(), endpointsX, endpointsX + 2);
+        m_endpoints[1].insert(m_endpoints[1].end(), endpointsY, endpointsY + 2);
+    }
+    m_inserted.clear();
+
+    sortAxis(0, added, removed);
+    sortAxis(1, added, removed);
+}
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+template <typename T_ty>
+std::size_t SweepAndPrune2d<T_ty>::size() const
+{
+    return m_size;
+}
+
+template <typename T_ty>
+bool SweepAndPrune2d<T_ty>::empty() const
+{
+    return m_size == 0;
+}
+
+template <typename T_ty>
+bool SweepAndPrune2d<T_ty>::contains(const Handle handle) const
+{
+    return handle < m_proxies.size() &&
+        (m_proxies[handle].state == StateActive || m_proxies[handle].state == StateInserted);
+}
+
+template <typename T_ty>
+const BoundingBox2d<T_ty> & SweepAndPrune2d<T_ty>::getBox(const Handle handle) const
+{
+    assert(contains(handle));
+    return m_proxies[handle].box;
+}
+
+template <typename T_ty>
+std::size_t SweepAndPrune2d<T_ty>::getPairCount() const
+{
+    return m_pairs.size();
+}
+
+template <typename T_ty>
+bool SweepAndPrune2d<T_ty>::isOverlapping(const Handle a, const Handle b) const
+{
+    if (a == b || a >= m_proxies.size() || b >= m_proxies.size())
+        return false;
+    return m_pairs.count(makeKey(a, b)) > 0;
+}
+
+template <typename T_ty>
+void SweepAndPrune2d<T_ty>::getPairs(std::vector<Pair> & output) const
+{
+    for (const std::uint64_t key : m_pairs)
+        output.push_back(makePair(key));
+}
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+template <typename T_ty>
+void SweepAndPrune2d<T_ty>::checkHandle(const Handle handle) const
+{
+    if (!contains(handle))
+        throw std::invalid_argument("Handle does not refer to a box in the sweep and prune broadphase.");
+}
+
+template <typename T_ty>
+bool SweepAndPrune2d<T_ty>::isBefore(const Endpoint & lhs, const Endpoint & rhs)
+{
+    return lhs.value < rhs.value || (lhs.value == rhs.value && (lhs.data & 1) < (rhs.data & 1));
+}
+
+template <typename T_ty>
+std::uint64_t SweepAndPrune2d<T_ty>::makeKey(const Handle a, const Handle b)
+{
+    return (a < b) ?
+        ((static_cast<std::uint64_t>(a) << 32) | static_cast<std::uint64_t>(b)) :
+        ((static_cast<std::uint64_t>(b) << 32) | static_cast<std::uint64_t>(a));
+}
+
+template <typename T_ty>
+typename SweepAndPrune2d<T_ty>::Pair SweepAndPrune2d<T_ty>::makePair(const std::uint64_t key)
+{
+    return Pair(static_cast<Handle>(key >> 32), static_cast<Handle>(key & 0xFFFFFFFFu));
+}
+
+template <typename T_ty>
+bool SweepAndPrune2d<T_ty>::overlaps(const Handle a, const Handle b) const
+{
+    const Proxy & pa = m_proxies[a];
+    const Proxy & pb = m_proxies[b];
+    return
+        pa.min.x <= pb.max.x &&
+        pb.min.x <= pa.max.x &&
+        pa.min.y <= pb.max.y &&
+        pb.min.y <= pa.max.y;
+}
+
+template <typename T_ty>
+void SweepAndPrune2d<T_ty>::addPair(const Handle a, const Handle b, std::vector<Pair> & added)
+{
+    const std::uint64_t key = makeKey(a, b);
+    if (m_pairs.insert(key).second) {
+        ++m_proxies[a].pairCount;
+        ++m_proxies[b].pairCount;
+        added.push_back(makePair(key));
+    }
+}
+
+template <typename T_ty>
+void SweepAndPrune2d<T_ty>::removePair(const Handle a, const Handle b, std::vector<Pair> & removed)
+{
+    if (m_proxies[a].pairCount == 0 || m_proxies[b].pairCount == 0)
+        return;
+
+    const std::uint64_t key = makeKey(a, b);
+    if (m_pairs.erase(key) > 0) {
+        --m_proxies[a].pairCount;
+        --m_proxies[b].pairCount;
+        removed.push_back(makePair(key));
+    }
+}
+
+template <typename T_ty>
+void SweepAndPrune2d<T_ty>::updatePair(const Handle a, const Handle b, std::vector<Pair> & added, std::vector<Pair> & removed)
+{
+    if (overlaps(a, b))
+        addPair(a, b, added);
+    else
+        removePair(a, b, removed);
+}
+
+template <typename T_ty>
+void SweepAndPrune2d<T_ty>::sortAxis(const int axis, std::vector<Pair> & added, std::vector<Pair> & removed)
+{
+    // Whether two boxes overlap along this axis only changes when the minimum
+    //  end of one passes the maximum end of the other. Insertion sort swaps
+    //  every pair of endpoints which has changed order exactly once, so every
+    //  change is caught. The pair is checked using the final positions of the
+    //  boxes, so the other axis doesn't need to be sorted yet.
+    std::vector<Endpoint> & endpoints = m_endpoints[axis];
+    for (std::size_t i = 1; i < endpoints.size(); ++i) {
+        const Endpoint endpoint = endpoints[i];
+        std::size_t j = i;
+        while (j > 0 && isBefore(endpoint, endpoints[j - 1])) {
+            const Endpoint & other = endpoints[j - 1];
+            if (((endpoint.data ^ other.data) & 1) != 0 && (endpoint.data >> 1) != (other.data >> 1))
+                updatePair(endpoint.data >> 1, other.data >> 1, added, removed);
+            endpoints[j] = other;
+            --j;
+        }
+        endpoints[j] = endpoint;
+    }
+}
+
+template <typename T_ty>
+void SweepAndPrune2d<T_ty>::rebuild(std::vector<Pair> & added, std::vector<Pair> & removed)
+{
+    for (const Handle handle : m_inserted) {
+        if (m_proxies[handle].state == StateInserted)
+            m_proxies[handle].state = StateActive;
+    }
+    m_inserted.clear();
+
+    // Gather the endpoints of every box, and sort them from scratch.
+    for (int axis = 0; axis < 2; ++axis)
+        m_endpoints[axis].clear();
+    for (std::size_t handle = 0; handle < m_proxies.size(); ++handle) {
+        const Proxy & proxy = m_proxies[handle];
+        if (proxy.state != StateActive)
+            continue;
+
+        const std::uint32_t data = static_cast<std::uint32_t>(handle) << 1;
+        const Endpoint endpointsX[2] = { { proxy.min.x, data }, { proxy.max.x, data | 1 } };
+        const Endpoint endpointsY[2] = { { proxy.min.y, data }, { proxy.max.y, data | 1 } };
+        m_endpoints[0].insert(m_endpoints[0].end(), endpointsX, endpointsX + 2);
+        m_endpoints[1].insert(m_endpoints[1].end(), endpointsY, endpointsY + 2);
+    }
+    for (int axis = 0; axis < 2; ++axis)
+        std::sort(m_endpoints[axis].begin(), m_endpoints[axis].end(), &SweepAndPrune2d<T_ty>::isBefore);
+
+    // Sweep along the x axis. Each box is open between the first and second of
+    //  its endpoints (which are the wrong way round if it has a negative
+    //  radius). Every pair which overlaps along the axis is open at the same
+    //  time, so it is checked when the second of them is opened.
+    std::unordered_set<std::uint64_t> pairs;
+    pairs.reserve(m_pairs.size());
+    std::vector<Handle> open;
+    std::vector<std::size_t> openPos(m_proxies.size(), static_cast<std::size_t>(-1));
+    for (const Endpoint & endpoint : m_endpoints[0]) {
+        const Handle handle = endpoint.data >> 1;
+        if (openPos[handle] == static_cast<std::size_t>(-1)) {
+            for (const Handle other : open) {
+                if (overlaps(handle, other))
+                    pairs.insert(makeKey(handle, other));
+            }
+            openPos[handle] = open.size();
+            open.push_back(handle);
+        } else {
+            // Remove this box from the open list, moving the last one into its place.
+            const Handle last = open.back();
+            open[openPos[handle]] = last;
+            openPos[last] = openPos[handle];
+            open.pop_back();
+        }
+    }
+
+    // Report the differences from the old set of pairs.
+    for (const std::uint64_t key : pairs) {
+        if (m_pairs.count(key) == 0)
+            added.push_back(makePair(key));
+    }
+    for (const std::uint64_t key : m_pairs) {
+        if (pairs.count(key) == 0)
+            removed.push_back(makePair(key));
+    }
+
+    for (Proxy & proxy : m_proxies)
+        proxy.pairCount = 0;
+    for (const std::uint64_t key : pairs) {
+        const Pair pair = makePair(key);
+        ++m_proxies[pair.first].pairCount;
+        ++m_proxies[pair.second].pairCount;
+    }
+    m_pairs.swap(pairs);
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_SweepAndPrune2d_inl
@@ -0,0 +1,123 @@
+#ifndef ail_math_SweptBox2d_h
+#define ail_math_SweptBox2d_h
+
+/** \file SweptBox2d.h
+    \brief Declares a moving 2d box, for continuous collision detection. See SweptBox2d.inl for implementation.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <type_traits>
+#include "Aabb2d.h"
+#include "BoundingBox2d.h"
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/** An axis-aligned box which moves by a velocity over one time step.
+BoundingBox2d::intersects() only checks whether two boxes overlap at one moment,
+ so a fast-moving box can pass straight through a thin one between steps. This
+ class checks the whole movement instead, and finds the time of impact.
+Time is measured as a fraction of the step, from 0 to 1, so the box is at
+ box.pos + (velocity * time). The sweep test expands the other box by this box's
+ radius (its Minkowski sum), and casts this box's centre against it as a
+ segment, using the same branch-free slab test as Segment2d. Touching counts as
+ a hit.
+The contact normal is a unit vector along one axis. It points out of the face
+ of the other box which was hit, towards this box. If the boxes already overlap
+ at time 0, or they aren't moving relative to each other, there's no face to
+ hit and the normal is zero. If a corner is hit exactly, the x axis is used.
+Aabb2dArray::sweep() tests one moving box against lots of static boxes at once,
+ using SIMD.
+Like Vector2d, the class is trivially copyable and can be constructed at compile time.
+Template parameter gives the underlying numerical type, which must be floating point.
+*/
+template <typename T_ty>
+class SweptBox2d
+{
+public:
+    static_assert(std::is_floating_point<T_ty>::value, "SweptBox2d is only supported for floating point types.");
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - initialises everything to 0.
+    constexpr SweptBox2d();
+
+    /// Constructor - explicitly initialises the box at the start of the step, and its velocity.
+    constexpr SweptBox2d(const BoundingBox2d<T_ty> & box, const Vector2d<T_ty> & velocity);
+
+
+//------------------------------------------------------------------------------
+// Operators.
+
+    /// Equality test.
+    /// Note that this tests for exact equality, which isn't usually desirable for
+    ///  floating point types.
+    constexpr bool operator == (const SweptBox2d<T_ty> & rhs) const;
+
+    /// Inequality test.
+    /// Note that this tests for (lack of) exact equality, which isn't usually
+    ///  desirable for floating point types.
+    constexpr bool operator != (const SweptBox2d<T_ty> & rhs) const;
+
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+    /// Get the box at the given time, from 0 (the start of the step) to 1 (the end).
+    BoundingBox2d<T_ty> getBoxAt(const T_ty time) const;
+
+    /// Get a box which covers the whole movement.
+    /// This is useful for broad phase checks, e.g. with Bvh2d or SweepAndPrune2d.
+    BoundingBox2d<T_ty> getSweptBounds() const;
+
+
+//------------------------------------------------------------------------------
+// Tests.
+
+    /// Check if this box hits a static box at any time during the step.
+    bool intersects(const BoundingBox2d<T_ty> & target) const;
+
+    /// Check if this box hits a static box during the step, and get the time of impact and contact normal.
+    /// time and normal are only set if it's a hit. The time is 0 if the boxes
+    ///  already touch or overlap at the start of the step.
+    bool intersects(const BoundingBox2d<T_ty> & target, T_ty & time, Vector2d<T_ty> & normal) const;
+
+    /// Check if this box hits a static box at any time during the step. An empty box is never hit.
+    bool intersects(const Aabb2d<T_ty> & target) const;
+
+    /// Check if this box hits a static box during the step, and get the time of impact and contact normal.
+    /// An empty box is never hit. See the BoundingBox2d version for details.
+    bool intersects(const Aabb2d<T_ty> & target, T_ty & time, Vector2d<T_ty> & normal) const;
+
+    /// Check if two moving boxes hit each other at any time during the step.
+    bool intersects(const SweptBox2d<T_ty> & other) const;
+
+    /// Check if two moving boxes hit each other during the step, and get the time of impact and contact normal.
+    /// The normal points out of the other box, towards this one. Both boxes are
+    ///  at getBoxAt(time) when they make contact.
+    bool intersects(const SweptBox2d<T_ty> & other, T_ty & time, Vector2d<T_ty> & normal) const;
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// The box at the start of the step.
+    BoundingBox2d<T_ty> box;
+
+    /// How far the box moves during the step.
+    Vector2d<T_ty> velocity;
+};
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_SweptBox2d_h
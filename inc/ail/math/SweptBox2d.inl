@@ -0,0 +1,179 @@
+#ifndef ail_math_SweptBox2d_inl
+#define ail_math_SweptBox2d_inl
+
+/** \file SweptBox2d.inl
+    \brief Implementation for a moving 2d box, for continuous collision detection (see SweptBox2d.h).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "Aabb2d.inl"
+#include "BoundingBox2d.inl"
+#include "Ray2d.inl"
+#include "SweptBox2d.h"
+#include "Vector2d.inl"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+namespace sweptbox2d {
+
+/// Sweep a box with the given centre and radius against a static box, over one time step.
+/// invX and invY are the reciprocals of the relative velocity. The static box is
+///  expanded by the moving box's radius, and the centre is cast against it as a
+///  segment. The near distances are worked out again exactly as ray2d::castRay()
+///  does, so comparing them to the time of impact shows which face was hit.
+///  Comparisons with NaN are false, so an axis which didn't limit the time never
+///  gives the normal.
+/// Sets time and normal whether or not it's a hit. An empty static box is never
+///  hit, even if expanding it would make it valid.
+template <typename T_ty>
+inline bool sweep(const T_ty originX, const T_ty originY, const T_ty invX, const T_ty invY,
+    const T_ty radiusX, const T_ty radiusY, const T_ty minX, const T_ty minY, const T_ty maxX, const T_ty maxY,
+    T_ty & time, T_ty & normalX, T_ty & normalY)
+{
+    const T_ty expandedMinX = minX - radiusX;
+    const T_ty expandedMinY = minY - radiusY;
+    const T_ty expandedMaxX = maxX + radiusX;
+    const T_ty expandedMaxY = maxY + radiusY;
+
+    T_ty exit;
+    const bool hit = ray2d::castRay(originX, originY, invX, invY,
+        expandedMinX, expandedMinY, expandedMaxX, expandedMaxY, T_ty(1), time, exit);
+
+    const T_ty nearX = (((invX < T_ty(0)) ? expandedMaxX : expandedMinX) - originX) * invX;
+    const T_ty nearY = (((invY < T_ty(0)) ? expandedMaxY : expandedMinY) - originY) * invY;
+    const bool onX = (nearX == time);
+    const bool onY = !onX && (nearY == time);
+    normalX = onX ? ((invX < T_ty(0)) ? T_ty(1) : T_ty(-1)) : T_ty(0);
+    normalY = onY ? ((invY < T_ty(0)) ? T_ty(1) : T_ty(-1)) : T_ty(0);
+    return hit & (minX <= maxX) & (minY <= maxY);
+}
+
+/// Sweep a box against a static box, only setting time and normal if it's a hit.
+template <typename T_ty>
+inline bool sweep(const BoundingBox2d<T_ty> & box, const Vector2d<T_ty> & velocity,
+    const Vector2d<T_ty> & min, const Vector2d<T_ty> & max, T_ty & time, Vector2d<T_ty> & normal)
+{
+    T_ty sweepTime, normalX, normalY;
+    const bool hit = sweep(box.pos.x, box.pos.y, T_ty(1) / velocity.x, T_ty(1) / velocity.y,
+        box.radius.x, box.radius.y, min.x, min.y, max.x, max.y, sweepTime, normalX, normalY);
+    if (hit) {
+        time = sweepTime;
+        normal.set(normalX, normalY);
+    }
+    return hit;
+}
+
+} // sweptbox2d
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+template <typename T_ty>
+constexpr SweptBox2d<T_ty>::SweptBox2d() :
+    box(), velocity()
+{
+}
+
+template <typename T_ty>
+constexpr SweptBox2d<T_ty>::SweptBox2d(const BoundingBox2d<T_ty> & box, const Vector2d<T_ty> & velocity) :
+    box(box), velocity(velocity)
+{
+}
+
+//------------------------------------------------------------------------------
+// Operators.
+
+template <typename T_ty>
+constexpr bool SweptBox2d<T_ty>::operator == (const SweptBox2d<T_ty> & rhs) const
+{
+    return box == rhs.box && velocity == rhs.velocity;
+}
+
+template <typename T_ty>
+constexpr bool SweptBox2d<T_ty>::operator != (const SweptBox2d<T_ty> & rhs) const
+{
+    return !(*this == rhs);
+}
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+template <typename T_ty>
+BoundingBox2d<T_ty> SweptBox2d<T_ty>::getBoxAt(const T_ty time) const
+{
+    return BoundingBox2d<T_ty>(box.pos.x + (velocity.x * time), box.pos.y + (velocity.y * time), box.radius.x, box.radius.y);
+}
+
+template <typename T_ty>
+BoundingBox2d<T_ty> SweptBox2d<T_ty>::getSweptBounds() const
+{
+    const BoundingBox2d<T_ty> end = getBoxAt(T_ty(1));
+    const Vector2d<T_ty> startMin = box.getCornerX1Y1(), startMax = box.getCornerX2Y2();
+    const Vector2d<T_ty> endMin = end.getCornerX1Y1(), endMax = end.getCornerX2Y2();
+    return BoundingBox2d<T_ty>::fromCorners(
+        Vector2d<T_ty>((endMin.x < startMin.x) ? endMin.x : startMin.x, (endMin.y < startMin.y) ? endMin.y : startMin.y),
+        Vector2d<T_ty>((endMax.x > startMax.x) ? endMax.x : startMax.x, (endMax.y > startMax.y) ? endMax.y : startMax.y));
+}
+
+//------------------------------------------------------------------------------
+// Tests.
+
+template <typename T_ty>
+bool SweptBox2d<T_ty>::intersects(const BoundingBox2d<T_ty> & target) const
+{
+    T_ty time;
+    Vector2d<T_ty> normal;
+    return intersects(target, time, normal);
+}
+
+template <typename T_ty>
+bool SweptBox2d<T_ty>::intersects(const BoundingBox2d<T_ty> & target, T_ty & time, Vector2d<T_ty> & normal) const
+{
+    return sweptbox2d::sweep(box, velocity, target.getCornerX1Y1(), target.getCornerX2Y2(), time, normal);
+}
+
+template <typename T_ty>
+bool SweptBox2d<T_ty>::intersects(const Aabb2d<T_ty> & target) const
+{
+    T_ty time;
+    Vector2d<T_ty> normal;
+    return intersects(target, time, normal);
+}
+
+template <typename T_ty>
+bool SweptBox2d<T_ty>::intersects(const Aabb2d<T_ty> & target, T_ty & time, Vector2d<T_ty> & normal) const
+{
+    return sweptbox2d::sweep(box, velocity, target.min, target.max, time, normal);
+}
+
+template <typename T_ty>
+bool SweptBox2d<T_ty>::intersects(const SweptBox2d<T_ty> & other) const
+{
+    T_ty time;
+    Vector2d<T_ty> normal;
+    return intersects(other, time, normal);
+}
+
+template <typename T_ty>
+bool SweptBox2d<T_ty>::intersects(const SweptBox2d<T_ty> & other, T_ty & time, Vector2d<T_ty> & normal) const
+{
+    // Work in the other box's frame of reference, where it's static.
+    const Vector2d<T_ty> relative(velocity.x - other.velocity.x, velocity.y - other.velocity.y);
+    return sweptbox2d::sweep(box, relative, other.box.getCornerX1Y1(), other.box.getCornerX2Y2(), time, normal);
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_SweptBox2d_inl
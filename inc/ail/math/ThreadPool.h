@@ -0,0 +1,216 @@
+#ifndef ail_math_ThreadPool_h
+#define ail_math_ThreadPool_h
+
+/** \file ThreadPool.h
+    \brief Declares a work-stealing thread pool, and parallel loops which run on it. See ThreadPool.inl for implementation.
+
+    parallelFor() and parallelReduce() split a range of indices into
+     sub-ranges, and process them on the threads of a pool, e.g.:
+
+        parallelFor(points.size(), [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+                points[i].normalise();
+        });
+
+    By default they use ThreadPool::getDefault(), which has one thread per
+     hardware thread. ParallelBatch.h has ready-made parallel versions of
+     common Vector2d and Polar operations.
+
+    This uses std::thread, so programs need to link with the platform's thread
+     library (e.g. Threads::Threads in CMake, or -pthread for GCC).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/** A fixed set of threads which share out the chunks of parallel loops.
+Each call to run() splits its chunks evenly between the threads up front. A
+ thread which runs out of chunks steals half of the remaining chunks from
+ another thread, so uneven workloads stay balanced. Each thread's chunks are
+ stored as a range of indices packed into one atomic value, so claiming or
+ stealing chunks is a single compare-and-swap, without any locking.
+The thread which calls run() works on the chunks too, and run() returns when
+ they're all finished. Only one loop runs on a pool at a time. Other threads
+ calling run() wait their turn, and calls from inside a loop which is already
+ running (i.e. nested loops) run serially on the calling thread.
+If a chunk throws an exception, the chunks which haven't started yet are
+ skipped, and run() rethrows the first exception once the others have finished.
+*/
+class ThreadPool
+{
+public:
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - starts the threads.
+    /// threadCount is the total number of threads which work on each loop,
+    ///  including the one which calls run(), so 1 doesn't start any threads.
+    ///  0 uses std::thread::hardware_concurrency().
+    explicit ThreadPool(const unsigned threadCount = 0);
+
+    /// Destructor - stops the threads, waiting for them to finish.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator = (const ThreadPool &) = delete;
+
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+    /// Get the number of threads which work on each loop, including the one which calls run().
+    unsigned getThreadCount() const;
+
+    /// Get a pool shared by the whole program, with one thread per hardware thread.
+    /// It's created on first use.
+    static ThreadPool & getDefault();
+
+
+//------------------------------------------------------------------------------
+// Operations.
+
+    /// Call func(chunk) once for each chunk index in [0, chunkCount), spread across the threads.
+    /// Chunks can run in any order, and at the same time as each other.
+    /// Throws std::length_error if chunkCount doesn't fit in 32 bits.
+    template <typename T_func>
+    void run(const std::size_t chunkCount, const T_func & func);
+
+
+private:
+//------------------------------------------------------------------------------
+// Internal types.
+
+    /// A loop which is being run, with its function type hidden.
+    struct Job
+    {
+        virtual ~Job() {}
+        virtual void runChunk(const std::size_t chunk) const = 0;
+    };
+
+    /// A loop which calls a particular function type.
+    template <typename T_func>
+    struct FunctionJob : public Job
+    {
+        explicit FunctionJob(const T_func & func) : func(func) {}
+        void runChunk(const std::size_t chunk) const override { func(chunk); }
+        const T_func & func;
+    };
+
+    /// The chunks which a thread hasn't started yet, as a range [begin, end).
+    /// begin is stored in the low 32 bits, and end in the high 32 bits.
+    /// This is padded, so that threads don't contend for each other's cache lines.
+    struct Queue
+    {
+        std::atomic<std::uint64_t> range;
+        char padding[64 - sizeof(std::atomic<std::uint64_t>)];
+    };
+
+
+//------------------------------------------------------------------------------
+// Internal operations.
+
+    /// Run the loop of a worker thread, which waits for each job and works on it.
+    void workerLoop(const unsigned index);
+
+    /// Run chunks of the current job, until there are none left to claim or steal.
+    void runChunks(const unsigned index);
+
+    /// Claim the next chunk from a thread's own queue. Returns false if it's empty.
+    bool claim(const unsigned index, std::uint32_t & chunk);
+
+    /// Steal half the remaining chunks from another thread's queue.
+    /// The first stolen chunk is returned in chunk, and the rest are put in
+    ///  the thread's own queue. Returns false if every queue is empty.
+    bool steal(const unsigned index, std::uint32_t & chunk);
+
+    /// Tell the worker threads to finish, and wait for them.
+    void stop();
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// Number of threads working on each loop, including the caller.
+    unsigned m_threadCount;
+
+    /// The worker threads. These have indices 1 upwards, and the caller is 0.
+    std::vector<std::thread> m_threads;
+
+    /// Chunk queue of each thread, by index.
+    std::unique_ptr<Queue[]> m_queues;
+
+    /// The job currently running, if any.
+    const Job * m_job;
+
+    /// Set if a chunk throws an exception, so that the remaining chunks are skipped.
+    std::atomic<bool> m_cancelled;
+
+    /// The first exception thrown by a chunk of the current job.
+    std::exception_ptr m_exception;
+
+    /// Allows only one call to run() at a time.
+    std::mutex m_runMutex;
+
+    /// Protects the members below, and m_exception.
+    std::mutex m_mutex;
+
+    /// Signals the worker threads that a job has started, or that they should stop.
+    std::condition_variable m_startCondition;
+
+    /// Signals the caller that every worker thread has finished the current job.
+    std::condition_variable m_doneCondition;
+
+    /// Incremented each time a job starts.
+    std::uint64_t m_generation;
+
+    /// Number of worker threads still working on the current job.
+    unsigned m_busyCount;
+
+    /// Set when the worker threads should finish.
+    bool m_stopping;
+};
+
+
+//------------------------------------------------------------------------------
+// Parallel loops.
+
+/// Call func(begin, end) for sub-ranges which cover [0, count) between them, in parallel.
+/// Each sub-range has at most grainSize elements, or an automatic size if
+///  grainSize is 0 (see threadpool::getGrainSize()).
+template <typename T_func>
+void parallelFor(const std::size_t count, const T_func & func, ThreadPool & pool = ThreadPool::getDefault(), const std::size_t grainSize = 0);
+
+/// Reduce the range [0, count) to a single value, in parallel.
+/// func(begin, end) returns the value of one sub-range, and combine(lhs, rhs)
+///  merges two values. The values are combined in order from left to right,
+///  starting with identity, so combine needn't be commutative. The sub-ranges
+///  only depend on count and grainSize (not on the number of threads), so the
+///  result is always the same, even for floating point sums.
+/// Each sub-range has at most grainSize elements, or an automatic size if
+///  grainSize is 0 (see threadpool::getGrainSize()).
+template <typename T_value, typename T_func, typename T_combine>
+T_value parallelReduce(const std::size_t count, const T_value & identity, const T_func & func, const T_combine & combine,
+    ThreadPool & pool = ThreadPool::getDefault(), const std::size_t grainSize = 0);
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_ThreadPool_h
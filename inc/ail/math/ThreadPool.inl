@@ -0,0 +1,295 @@
+#ifndef ail_math_ThreadPool_inl
+#define ail_math_ThreadPool_inl
+
+/** \file ThreadPool.inl
+    \brief Implements a work-stealing thread pool, and parallel loops which run on it.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "ThreadPool.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+namespace threadpool {
+
+/// Smallest number of elements in an automatic sub-range. Smaller sub-ranges
+///  would spend a noticeable amount of time on claiming them.
+const std::size_t minGrainSize = 512;
+
+/// Number of sub-ranges aimed for by the automatic size. This is enough to
+///  balance uneven workloads across lots of threads.
+const std::size_t targetChunkCount = 1024;
+
+/// Get the number of elements in each sub-range of a parallel loop over count elements.
+/// Returns grainSize if it isn't 0. Otherwise, the automatic size gives about
+///  targetChunkCount sub-ranges, but at least minGrainSize elements in each.
+inline std::size_t getGrainSize(const std::size_t count, const std::size_t grainSize)
+{
+    if (grainSize != 0)
+        return grainSize;
+    return std::max(minGrainSize, (count + targetChunkCount - 1) / targetChunkCount);
+}
+
+/// Pack a range of chunks into the representation used by ThreadPool::Queue.
+inline std::uint64_t packRange(const std::uint64_t begin, const std::uint64_t end)
+{
+    return begin | (end << 32);
+}
+
+/// Flag which is set while a thread is working on a loop, so that nested loops run serially.
+inline bool & isInsideLoop()
+{
+    static thread_local bool inside = false;
+    return inside;
+}
+
+/// A value stored on its own, so that std::vector<bool> doesn't pack several into one byte.
+template <typename T_value>
+struct Slot
+{
+    T_value value;
+};
+
+} // threadpool
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+inline ThreadPool::ThreadPool(const unsigned threadCount) :
+    m_threadCount((threadCount != 0) ? threadCount : std::max(1u, std::thread::hardware_concurrency())),
+    m_threads(),
+    m_queues(new Queue[m_threadCount]),
+    m_job(nullptr),
+    m_cancelled(false),
+    m_exception(),
+    m_generation(0),
+    m_busyCount(0),
+    m_stopping(false)
+{
+    try {
+        for (unsigned i = 1; i < m_threadCount; ++i)
+            m_threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    } catch (...) {
+        stop();
+        throw;
+    }
+}
+
+inline ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+//------------------------------------------------------------------------------
+// Accessors.
+
+inline unsigned ThreadPool::getThreadCount() const
+{
+    return m_threadCount;
+}
+
+inline ThreadPool & ThreadPool::getDefault()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+//------------------------------------------------------------------------------
+// Operations.
+
+template <typename T_func>
+void ThreadPool::run(const std::size_t chunkCount, const T_func & func)
+{
+    if (chunkCount == 0)
+        return;
+    if (chunkCount > 0xffffffffu)
+        throw std::length_error("ThreadPool::run() - chunk count doesn't fit in 32 bits.");
+
+    // Nested loops run serially, because the other threads are already busy.
+    if (m_threadCount == 1 || chunkCount == 1 || threadpool::isInsideLoop()) {
+        for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+            func(chunk);
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(m_runMutex);
+    const FunctionJob<T_func> job(func);
+    m_job = &job;
+    m_cancelled = false;
+
+    // Share the chunks out evenly to start with.
+    for (unsigned i = 0; i < m_threadCount; ++i) {
+        const std::uint64_t begin = (chunkCount * i) / m_threadCount;
+        const std::uint64_t end = (chunkCount * (i + 1)) / m_threadCount;
+        m_queues[i].range.store(threadpool::packRange(begin, end), std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_generation;
+        m_busyCount = m_threadCount - 1;
+    }
+    m_startCondition.notify_all();
+
+    threadpool::isInsideLoop() = true;
+    runChunks(0);
+    threadpool::isInsideLoop() = false;
+
+    // Wait for every worker to finish, not just every chunk. That stops any of
+    //  them from touching the queues once the next job has started.
+    std::exception_ptr exception;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCondition.wait(lock, [this] { return m_busyCount == 0; });
+        m_job = nullptr;
+        std::swap(exception, m_exception);
+    }
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+//------------------------------------------------------------------------------
+// Internal operations.
+
+inline void ThreadPool::workerLoop(const unsigned index)
+{
+    threadpool::isInsideLoop() = true;
+    std::uint64_t generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_startCondition.wait(lock, [&] { return m_stopping || m_generation != generation; });
+            if (m_stopping)
+                return;
+            generation = m_generation;
+        }
+
+        runChunks(index);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busyCount == 0)
+            m_doneCondition.notify_one();
+    }
+}
+
+inline void ThreadPool::runChunks(const unsigned index)
+{
+    std::uint32_t chunk;
+    while (!m_cancelled.load(std::memory_order_relaxed) && (claim(index, chunk) || steal(index, chunk))) {
+        try {
+            m_job->runChunk(chunk);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_exception)
+                m_exception = std::current_exception();
+            m_cancelled = true;
+        }
+    }
+}
+
+inline bool ThreadPool::claim(const unsigned index, std::uint32_t & chunk)
+{
+    std::atomic<std::uint64_t> & range = m_queues[index].range;
+    std::uint64_t current = range.load(std::memory_order_acquire);
+    for (;;) {
+        const std::uint32_t begin = static_cast<std::uint32_t>(current);
+        const std::uint32_t end = static_cast<std::uint32_t>(current >> 32);
+        if (begin >= end)
+            return false;
+        if (range.compare_exchange_weak(current, threadpool::packRange(begin + 1, end), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            chunk = begin;
+            return true;
+        }
+    }
+}
+
+inline bool ThreadPool::steal(const unsigned index, std::uint32_t & chunk)
+{
+    for (unsigned offset = 1; offset < m_threadCount; ++offset) {
+        std::atomic<std::uint64_t> & range = m_queues[(index + offset) % m_threadCount].range;
+        std::uint64_t current = range.load(std::memory_order_acquire);
+        for (;;) {
+            const std::uint32_t begin = static_cast<std::uint32_t>(current);
+            const std::uint32_t end = static_cast<std::uint32_t>(current >> 32);
+            if (begin >= end)
+                break;
+
+            // Take the top half, leaving the owner with the bottom half.
+            const std::uint32_t middle = end - ((end - begin + 1) / 2);
+            if (range.compare_exchange_weak(current, threadpool::packRange(begin, middle), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                // The thread's own queue is empty, so no other thread can be
+                //  changing it at the moment.
+                chunk = middle;
+                m_queues[index].range.store(threadpool::packRange(middle + 1, end), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+inline void ThreadPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_startCondition.notify_all();
+    for (std::thread & thread : m_threads)
+        thread.join();
+    m_threads.clear();
+}
+
+//------------------------------------------------------------------------------
+// Parallel loops.
+
+template <typename T_func>
+void parallelFor(const std::size_t count, const T_func & func, ThreadPool & pool, const std::size_t grainSize)
+{
+    const std::size_t grain = threadpool::getGrainSize(count, grainSize);
+    pool.run((count + grain - 1) / grain, [&](const std::size_t chunk) {
+        const std::size_t begin = chunk * grain;
+        func(begin, std::min(begin + grain, count));
+    });
+}
+
+template <typename T_value, typename T_func, typename T_combine>
+T_value parallelReduce(const std::size_t count, const T_value & identity, const T_func & func, const T_combine & combine,
+    ThreadPool & pool, const std::size_t grainSize)
+{
+    // Each sub-range stores its value separately, then they're combined in order.
+    const std::size_t grain = threadpool::getGrainSize(count, grainSize);
+    const std::size_t chunkCount = (count + grain - 1) / grain;
+    const threadpool::Slot<T_value> initial = { identity };
+    std::vector<threadpool::Slot<T_value>> values(chunkCount, initial);
+    pool.run(chunkCount, [&](const std::size_t chunk) {
+        const std::size_t begin = chunk * grain;
+        values[chunk].value = func(begin, std::min(begin + grain, count));
+    });
+
+    T_value result = identity;
+    for (const threadpool::Slot<T_value> & slot : values)
+        result = combine(result, slot.value);
+    return result;
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_ThreadPool_inl
@@ -0,0 +1,360 @@
+#ifndef ail_math_TrigPolicy_h
+#define ail_math_TrigPolicy_h
+
+/** \file TrigPolicy.h
+    \brief Compile-time accuracy policies for the trig used by polar/cartesian conversions.
+
+    A policy is a class providing static sin(), cos() and atan2() functions.
+    It can be given as a template argument to the conversion functions of Polar
+    and Vector2d, to trade accuracy for speed in hot loops. For example:
+
+        Vector2d<float> v = p.toVector2d<TrigMinimax>();
+        if (p.isNear<TrigTable>(q, 5.0f)) ...
+
+    The following policies are provided:
+     - TrigExact: calls the standard library. This is the default everywhere,
+        and gives bit-identical results to the standard library functions.
+        Other numeric types can provide their own sin(), cos() and atan2(),
+        which are found by argument dependent lookup (e.g. Fixed in Fixed.h).
+     - TrigMinimax: uses the branch-free polynomials from FastTrig.h.
+        Max 2 ulp for sin/cos (|angle| <= 1e6), and 3 ulp (float) or
+        2 ulp (double) for atan2. Only float and double are supported.
+     - TrigTable: uses lookup tables (9KB for float, 18KB for double)
+        refined with a short series. Max 2 ulp (float) or 3 ulp (double) for
+        sin/cos (|angle| <= 1e6), and 2 ulp for atan2. Only float and double
+        are supported. The tables are built on first use.
+     - TrigCordic<N>: uses N iterations of CORDIC from Cordic.h (default 30,
+        the maximum). Accurate to about 2^-(N - 1) absolute for
+        sin/cos/atan2 (|angle| <= 1e6), or 2^-26 at best. It calculates sin
+        and cos together in Polar::toVector2d(), and the angle and length
+        together in Vector2d::toPolar(). Only float and double are supported.
+    TrigMinimax, TrigTable and TrigCordic don't support NaN or infinite inputs.
+
+    A policy can optionally provide static sinCos(angle, sinOut, cosOut) and/or
+     atan2Hypot(y, x, angleOut, hypotOut), which the conversions use instead
+     of separate calls when they're available.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cmath>
+#include "Constants.h"
+#include "Cordic.h"
+#include "FastTrig.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+namespace trigexact {
+
+// The calls below are unqualified, so that argument dependent lookup finds
+//  the functions for other numeric types as well as the standard ones.
+using std::sin;
+using std::cos;
+using std::atan2;
+
+template <typename T_ty>
+inline auto callSin(const T_ty angle) -> decltype(sin(angle))
+{
+    return sin(angle);
+}
+
+template <typename T_ty>
+inline auto callCos(const T_ty angle) -> decltype(cos(angle))
+{
+    return cos(angle);
+}
+
+template <typename T_ty>
+inline auto callAtan2(const T_ty y, const T_ty x) -> decltype(atan2(y, x))
+{
+    return atan2(y, x);
+}
+
+} // trigexact
+
+/// Trig policy which uses the standard library functions.
+/// Return types match the standard library, so the results are bit-identical
+///  to calling std::sin, std::cos and std::atan2 directly (even for integer types).
+/// Types which have their own sin(), cos() and atan2() in their namespace
+///  (such as Fixed) use those instead.
+struct TrigExact
+{
+    template <typename T_ty>
+    static auto sin(const T_ty angle) -> decltype(trigexact::callSin(angle))
+    {
+        return trigexact::callSin(angle);
+    }
+
+    template <typename T_ty>
+    static auto cos(const T_ty angle) -> decltype(trigexact::callCos(angle))
+    {
+        return trigexact::callCos(angle);
+    }
+
+    template <typename T_ty>
+    static auto atan2(const T_ty y, const T_ty x) -> decltype(trigexact::callAtan2(y, x))
+    {
+        return trigexact::callAtan2(y, x);
+    }
+};
+
+/// Trig policy which uses branch-free minimax polynomial approximations.
+/// See FastTrig.h for details.
+struct TrigMinimax
+{
+    template <typename T_ty>
+    static T_ty sin(const T_ty angle)
+    {
+        return fastSin(angle);
+    }
+
+    template <typename T_ty>
+    static T_ty cos(const T_ty angle)
+    {
+        return fastCos(angle);
+    }
+
+    template <typename T_ty>
+    static T_ty atan2(const T_ty y, const T_ty x)
+    {
+        return fastAtan2(y, x);
+    }
+};
+
+//-------------------------------------------------------------------------
+// Internal helpers.
+
+namespace trigtable {
+
+/// Lookup tables for sin, cos and atan.
+/// The sin/cos tables cover a full circle, and the atan table covers [0, 1]
+///  (after octant reduction).
+template <typename T_ty>
+struct Tables
+{
+    /// Number of sin/cos steps in each quadrant.
+    static const int quadrantSteps = 256;
+
+    /// Number of sin/cos steps in a full circle.
+    static const int circleSteps = quadrantSteps * 4;
+
+    /// Number of atan steps across the reduced range.
+    static const int atanSteps = 256;
+
+    /// Size of each sin/cos step in radians.
+    static T_ty sinCosStep()
+    {
+        return static_cast<T_ty>(pi<double>() * 0.5 / quadrantSteps);
+    }
+
+    /// Constructor - fills in the tables.
+    /// Sin/cos entry i holds the angle q * pi/2 + j * sinCosStep(), where
+    ///  i = q * quadrantSteps + j and j is in [-quadrantSteps/2, quadrantSteps/2).
+    /// This uses the step size exactly as rounded to T_ty, so the entries
+    ///  stay consistent with the argument reduction in sinCos().
+    Tables()
+    {
+        const long double step = sinCosStep();
+        for (int i = 0; i < circleSteps; ++i) {
+            const int j = ((i + (quadrantSteps / 2)) % quadrantSteps) - (quadrantSteps / 2);
+            const int q = ((i - j) / quadrantSteps) % 4;
+            const long double a = static_cast<long double>(j) * step;
+            const T_ty s = static_cast<T_ty>(std::sin(a));
+            const T_ty c = static_cast<T_ty>(std::cos(a));
+
+            // Rotate into the quadrant exactly, rather than adding q * pi/2 to the angle.
+            sinVal[i] = (q == 0) ? s : (q == 1) ? c : (q == 2) ? -s : -c;
+            cosVal[i] = (q == 0) ? c : (q == 1) ? -s : (q == 2) ? -c : s;
+        }
+        for (int i = 0; i <= atanSteps; ++i)
+            atanVal[i] = static_cast<T_ty>(std::atan(static_cast<long double>(i) / atanSteps));
+    }
+
+    /// Get the shared tables for this type, building them on first use.
+    static const Tables & get()
+    {
+        static const Tables tables;
+        return tables;
+    }
+
+    T_ty sinVal[circleSteps];
+    T_ty cosVal[circleSteps];
+    T_ty atanVal[atanSteps + 1];
+};
+
+/// Approximate sin and cos together using the lookup tables.
+template <typename T_ty>
+inline void sinCos(const T_ty angle, T_ty & sinOut, T_ty & cosOut)
+{
+    typedef Tables<T_ty> Tab;
+    const Tab & tab = Tab::get();
+
+    // Reduce to r in [-pi/4, pi/4], then split r into a table step j plus a small remainder d.
+    // The table covers the full circle, so the quadrant only affects the index.
+    // j is kept in the range used to build the table, which can leave |d| up to 1.5 steps.
+    T_ty r, k;
+    fasttrig::reduceQuadrant(angle, r, k);
+    T_ty j = fasttrig::roundNearest(r * static_cast<T_ty>(Tab::quadrantSteps / (pi<double>() * 0.5)));
+    j = (j < T_ty(Tab::quadrantSteps / 2)) ? j : T_ty((Tab::quadrantSteps / 2) - 1);
+    const T_ty d = r - j * Tab::sinCosStep();
+    const long long step = static_cast<long long>(k) * Tab::quadrantSteps + static_cast<long long>(j);
+    const int index = static_cast<int>(step & (Tab::circleSteps - 1));
+
+    // |d| <= 3 pi/2048, so a few terms of each series are enough.
+    const T_ty z = d * d;
+    const T_ty sinD = d - d * z * (T_ty(1) / T_ty(6) - z * (T_ty(1) / T_ty(120)));
+    const T_ty cosDm1 = z * (z * (T_ty(1) / T_ty(24)) - T_ty(0.5)); // cos(d) - 1
+
+    // Angle sum identities, arranged to add the small corrections last.
+    const T_ty sj = tab.sinVal[index];
+    const T_ty cj = tab.cosVal[index];
+    sinOut = sj + (cj * sinD + sj * cosDm1);
+    cosOut = cj + (cj * cosDm1 - sj * sinD);
+}
+
+/// Approximate atan2(y, x) using the lookup table.
+template <typename T_ty>
+inline T_ty atan2(const T_ty y, const T_ty x)
+{
+    typedef Tables<T_ty> Tab;
+    const Tab & tab = Tab::get();
+
+    // Split t into a table entry tj plus a small correction:
+    //  atan(t) = atan(tj) + atan((t - tj) / (1 + t * tj))
+    const T_ty t = fasttrig::atan2Ratio(y, x);
+    const T_ty j = fasttrig::roundNearest(t * T_ty(Tab::atanSteps));
+    const T_ty tj = j / T_ty(Tab::atanSteps);
+    const T_ty d = (t - tj) / (T_ty(1) + t * tj);
+
+    // |d| <= 1/512, so a few terms of the series are enough.
+    const T_ty z = d * d;
+    const T_ty atanD = d - d * z * (T_ty(1) / T_ty(3) - z * (T_ty(1) / T_ty(5)));
+    return fasttrig::atan2Octant(y, x, tab.atanVal[static_cast<int>(j)] + atanD);
+}
+
+} // trigtable
+
+/// Trig policy which uses lookup tables refined with a short series.
+struct TrigTable
+{
+    template <typename T_ty>
+    static T_ty sin(const T_ty angle)
+    {
+        T_ty s, c;
+        trigtable::sinCos(angle, s, c);
+        return s;
+    }
+
+    template <typename T_ty>
+    static T_ty cos(const T_ty angle)
+    {
+        T_ty s, c;
+        trigtable::sinCos(angle, s, c);
+        return c;
+    }
+
+    template <typename T_ty>
+    static T_ty atan2(const T_ty y, const T_ty x)
+    {
+        return trigtable::atan2(y, x);
+    }
+};
+
+/// Trig policy which uses CORDIC with T_iterations iterations (1 to 30).
+/// See Cordic.h for details.
+template <int T_iterations = cordic::maxIterations>
+struct TrigCordic
+{
+    template <typename T_ty>
+    static T_ty sin(const T_ty angle)
+    {
+        T_ty s, c;
+        cordicSinCos<T_iterations>(angle, s, c);
+        return s;
+    }
+
+    template <typename T_ty>
+    static T_ty cos(const T_ty angle)
+    {
+        T_ty s, c;
+        cordicSinCos<T_iterations>(angle, s, c);
+        return c;
+    }
+
+    template <typename T_ty>
+    static T_ty atan2(const T_ty y, const T_ty x)
+    {
+        return cordicAtan2<T_iterations>(y, x);
+    }
+
+    template <typename T_ty>
+    static void sinCos(const T_ty angle, T_ty & sinOut, T_ty & cosOut)
+    {
+        cordicSinCos<T_iterations>(angle, sinOut, cosOut);
+    }
+
+    template <typename T_ty>
+    static void atan2Hypot(const T_ty y, const T_ty x, T_ty & angleOut, T_ty & hypotOut)
+    {
+        cordicAtan2Hypot<T_iterations>(y, x, angleOut, hypotOut);
+    }
+};
+
+//-------------------------------------------------------------------------
+// Internal helpers.
+
+namespace trigpolicy {
+
+// The conversions below use the optional sinCos() and atan2Hypot() functions
+//  if the policy has them. The int/long parameter makes overload resolution
+//  prefer the first version, which is removed by SFINAE if the policy lacks
+//  the function.
+
+/// Convert an angle and magnitude to cartesian coordinates, using sinCos().
+template <typename T_policy, typename T_ty>
+inline auto toCartesian(const T_ty angle, const T_ty mag, T_ty & xOut, T_ty & yOut, int)
+    -> decltype(T_policy::sinCos(angle, xOut, yOut), void())
+{
+    T_ty s, c;
+    T_policy::sinCos(angle, s, c);
+    xOut = mag * c;
+    yOut = mag * s;
+}
+
+/// Convert an angle and magnitude to cartesian coordinates, using sin() and cos().
+template <typename T_policy, typename T_ty>
+inline void toCartesian(const T_ty angle, const T_ty mag, T_ty & xOut, T_ty & yOut, long)
+{
+    xOut = mag * T_policy::cos(angle);
+    yOut = mag * T_policy::sin(angle);
+}
+
+/// Get the angle and length of a vector, using atan2Hypot().
+template <typename T_policy, typename T_vec, typename T_ty>
+inline auto toPolar(const T_vec & vec, T_ty & angleOut, T_ty & magOut, int)
+    -> decltype(T_policy::atan2Hypot(vec.y, vec.x, angleOut, magOut), void())
+{
+    T_policy::atan2Hypot(vec.y, vec.x, angleOut, magOut);
+}
+
+/// Get the angle and length of a vector, using atan2() and the vector's getLength().
+template <typename T_policy, typename T_vec, typename T_ty>
+inline void toPolar(const T_vec & vec, T_ty & angleOut, T_ty & magOut, long)
+{
+    magOut = vec.getLength();
+    angleOut = static_cast<T_ty>(T_policy::atan2(vec.y, vec.x));
+}
+
+} // trigpolicy
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_TrigPolicy_h
@@ -14,6 +14,8 @@
 
 #include <cmath>
 #include <cassert>
+#include <cstdint>
+#include <limits>
 #include <type_traits>
 #include "Constants.h"
 #include "tmod.h"
@@ -26,75 +28,75 @@ namespace math {
 //-------------------------------------------------------------------------
 // Angle conversions.
 
-/// Convert an angle from degrees to radians. Only valid for floating point types.
+/// Convert an angle from degrees to radians. Only valid for real types (see isReal in Constants.h).
 template <typename T_ty>
-inline constexpr typename std::enable_if<std::is_floating_point<T_ty>::value, T_ty>::type
+inline constexpr typename std::enable_if<isReal<T_ty>::value, T_ty>::type
     degToRad(const T_ty angle)
 {
     return (angle * pi<T_ty>()) / T_ty(180);
 }
 
-/// Convert an angle from degrees to gradians. Only valid for floating point types.
+/// Convert an angle from degrees to gradians. Only valid for real types (see isReal in Constants.h).
 template <typename T_ty>
-inline constexpr typename std::enable_if<std::is_floating_point<T_ty>::value, T_ty>::type
+inline constexpr typename std::enable_if<isReal<T_ty>::value, T_ty>::type
     degToGrad(const T_ty angle)
 {
     return (angle / T_ty(0.9));
 }
 
-/// Convert an angle from degrees to full turns. Only valid for floating point types.
+/// Convert an angle from degrees to full turns. Only valid for real types (see isReal in Constants.h).
 template <typename T_ty>
-inline constexpr typename std::enable_if<std::is_floating_point<T_ty>::value, T_ty>::type
+inline constexpr typename std::enable_if<isReal<T_ty>::value, T_ty>::type
     degToTurn(const T_ty angle)
 {
     return angle / T_ty(360);
 }
 
 
-/// Convert an angle from radians to degrees. Only valid for floating point types.
+/// Convert an angle from radians to degrees. Only valid for real types (see isReal in Constants.h).
 template <typename T_ty>
-inline constexpr typename std::enable_if<std::is_floating_point<T_ty>::value, T_ty>::type
+inline constexpr typename std::enable_if<isReal<T_ty>::value, T_ty>::type
     radToDeg(const T_ty angle)
 {
     return (angle * T_ty(180)) / pi<T_ty>();
 }
 
-/// Convert an angle from radians to gradians. Only valid for floating point types.
+/// Convert an angle from radians to gradians. Only valid for real types (see isReal in Constants.h).
 template <typename T_ty>
-inline constexpr typename std::enable_if<std::is_floating_point<T_ty>::value, T_ty>::type
+inline constexpr typename std::enable_if<isReal<T_ty>::value, T_ty>::type
     radToGrad(const T_ty angle)
 {
     return (angle * T_ty(200)) / pi<T_ty>();
 }
 
-/// Convert an angle from radians to full turns. Only valid for floating point types.
+/// Convert an angle from radians to full turns. Only valid for real types (see isReal in Constants.h).
 template <typename T_ty>
-inline constexpr typename std::enable_if<std::is_floating_point<T_ty>::value, T_ty>::type
+inline constexpr typename std::enable_if<isReal<T_ty>::value, T_ty>::type
     radToTurn(const T_ty angle)
 {
     return angle / (T_ty(2) * pi<T_ty>());
 }
 
 
-/// Convert an angle from gradians to degrees. Only valid for floating point types.
+/// Convert an angle from gradians to degrees. Only valid for real types (see isReal in Constants.h).
 template <typename T_ty>
-inline constexpr typename std::enable_if<std::is_floating_point<T_ty>::value, T_ty>::type
+inline constexpr typename std::enable_if<isReal<T_ty>::value, T_ty>::type
     gradToDeg(const T_ty angle)
 {
     return angle * T_ty(0.9);
 }
 
-/// Convert an angle from gradians to radians. Only valid for floating point types.
+/// Convert an angle from gradians to radians. Only valid for real types (see isReal in Constants.h).
 template <typename T_ty>
-inline constexpr typename std::enable_if<std::is_floating_point<T_ty>::value, T_ty>::type
+inline constexpr typename std::enable_if<isReal<T_ty>::value, T_ty>::type
     gradToRad(const T_ty angle)
 {
     return (angle * pi<T_ty>()) / T_ty(200);
 }
 
-/// Convert an angle from gradians to full turns. Only valid for floating point types.
+/// Convert an angle from gradians to full turns. Only valid for real types (see isReal in Constants.h).
 template <typename T_ty>
-inline constexpr typename std::enable_if<std::is_floating_point<T_ty>::value, T_ty>::type
+inline constexpr typename std::enable_if<isReal<T_ty>::value, T_ty>::type
     gradToTurn(const T_ty angle)
 {
     return angle / T_ty(400);
@@ -109,9 +111,9 @@ inline constexpr T_ty
     return angle * T_ty(360);
 }
 
-/// Convert an angle from full turns to radians. Only valid for floating point types.
+/// Convert an angle from full turns to radians. Only valid for real types (see isReal in Constants.h).
 template <typename T_ty>
-inline constexpr typename std::enable_if<std::is_floating_point<T_ty>::value, T_ty>::type
+inline constexpr typename std::enable_if<isReal<T_ty>::value, T_ty>::type
     turnToRad(const T_ty angle)
 {
     return angle * T_ty(2.0) * pi<T_ty>();
@@ -149,18 +151,18 @@ inline constexpr T_ty clamp(const T_ty val, const T_ty range1, const T_ty range2
 }
 
 /// Linearly interpolate between start and end by the given amount. This will extrapolate beyond the original range if necessary.
-/// Only valid for floating point types.
+/// Only valid for real types (see isReal in Constants.h).
 template <typename T_ty>
-inline constexpr typename std::enable_if<std::is_floating_point<T_ty>::value, T_ty>::type
+inline constexpr typename std::enable_if<isReal<T_ty>::value, T_ty>::type
     lerp(const T_ty amount, const T_ty start, const T_ty end)
 {
     return start + (amount * (end - start));
 }
 
 /// Linearly interpolate between start and end by the given amount, clamping the result to the original range.
-/// Only valid for floating point types.
+/// Only valid for real types (see isReal in Constants.h).
 template <typename T_ty>
-inline constexpr typename std::enable_if<std::is_floating_point<T_ty>::value, T_ty>::type
+inline constexpr typename std::enable_if<isReal<T_ty>::value, T_ty>::type
     lerpClamp(const T_ty amount, const T_ty start, const T_ty end)
 {
     return clamp(lerp(amount, start, end), start, end);
@@ -184,6 +186,177 @@ inline T_ty wrap(const T_ty val, T_ty rangeMin, T_ty rangeMax)
     return rem + rangeMax;
 }
 
+namespace wrapangle {
+
+/// Identifies types which have a fast remainder calculation below.
+template <typename T_ty>
+struct hasFastRemainder : std::integral_constant<bool,
+    std::is_same<T_ty, float>::value || std::is_same<T_ty, double>::value>
+{
+};
+
+/// Angles must have a smaller magnitude than this for fmod2Pi() to be exact.
+inline float fmod2PiLimit(float) { return 3.0e9f; }
+inline double fmod2PiLimit(double) { return 4.0e8; }
+
+/// Calculate std::fmod(angle, 2 pi) exactly, using floor instead of a division remainder.
+/// This is done in double precision, where the float value of 2 pi multiplied by a quotient
+///  below 2^29 is exact. Rounding the reciprocal can put the quotient out by one either way,
+///  which the two corrections fix.
+inline float fmod2Pi(const float angle)
+{
+    const double period = static_cast<double>(pi<float>() * 2.0f);
+    const double absAngle = std::fabs(static_cast<double>(angle));
+    const double q = std::floor(absAngle * (1.0 / period));
+    double rem = absAngle - (q * period);
+    rem = (rem < 0.0) ? rem + period : rem;
+    rem = (rem >= period) ? rem - period : rem;
+    return std::copysign(static_cast<float>(rem), angle);
+}
+
+/// Calculate std::fmod(angle, 2 pi) exactly, using floor instead of a division remainder.
+/// 2 pi is split into two halves of 26 bits (Veltkamp's method), so multiplying either half
+///  by a quotient below 2^26 is exact. Dividing can only round the quotient up to the next
+///  integer, never down, which the correction fixes.
+inline double fmod2Pi(const double angle)
+{
+    const double period = pi<double>() * 2.0;
+    const double split = period * 134217729.0; // 2^27 + 1
+    const double high = split - (split - period);
+    const double low = period - high;
+
+    const double absAngle = std::fabs(angle);
+    const double q = std::floor(absAngle / period);
+    double rem = (absAngle - (q * high)) - (q * low);
+    rem = (rem < 0.0) ? rem + period : rem;
+    return std::copysign(rem, angle);
+}
+
+/// Make sure a wrapped angle is less than 2 pi. wrap() rounds tiny negative angles up to 2 pi.
+template <typename T_ty>
+inline T_ty excludePeriod(const T_ty wrapped)
+{
+    return (wrapped == pi<T_ty>() * T_ty(2)) ? T_ty(0) : wrapped;
+}
+
+template <typename T_ty>
+inline T_ty wrapAngle(const T_ty angle, std::false_type)
+{
+    return excludePeriod(wrap(angle, T_ty(0), pi<T_ty>() * T_ty(2)));
+}
+
+template <typename T_ty>
+inline T_ty wrapAngle(const T_ty angle, std::true_type)
+{
+    const T_ty period = pi<T_ty>() * T_ty(2);
+    // Huge angles, infinity and NaN are rare, so they can take the slow path.
+    if (!(std::fabs(angle) < fmod2PiLimit(angle)))
+        return wrapAngle(angle, std::false_type());
+
+    // This combines the remainder in exactly the same way as wrap(), but with selects instead of branches.
+    const T_ty rem = fmod2Pi(angle);
+    const T_ty wrapped = (rem >= T_ty(0)) ? rem + T_ty(0) : rem + period;
+    return excludePeriod(((angle >= T_ty(0)) & (angle < period)) ? angle : wrapped);
+}
+
+} // wrapangle
+
+/// Wrap an angle in radians to the range 0 <= angle < 2 pi. Only valid for real types (see isReal in Constants.h).
+/// For float and double, this is much faster than calling wrap(angle, 0, 2 pi), because it
+///  calculates the remainder with floor instead of std::fmod, and doesn't branch for angles
+///  below about 4e8 in magnitude (3e9 for float). The result is exactly the same, except
+///  that wrap() can round a tiny negative angle up to 2 pi, where this returns 0 instead.
+template <typename T_ty>
+inline typename std::enable_if<isReal<T_ty>::value, T_ty>::type
+    wrapAngle(const T_ty angle)
+{
+    return wrapangle::wrapAngle(angle, wrapangle::hasFastRemainder<T_ty>());
+}
+
+
+//-------------------------------------------------------------------------
+// Integer utilities.
+
+/// Gives a type which can hold the square of any T_ty value without overflowing, where there is one.
+/// Integers smaller than 64 bits are widened to 64 bits. Other types are unchanged.
+template <typename T_ty, bool T_widen = std::is_integral<T_ty>::value && (sizeof(T_ty) < sizeof(std::int64_t))>
+struct widened
+{
+    typedef T_ty type;
+};
+
+template <typename T_ty>
+struct widened<T_ty, true>
+{
+    typedef typename std::conditional<std::is_signed<T_ty>::value, std::int64_t, std::uint64_t>::type type;
+};
+
+namespace intsqrt {
+
+/// Find the largest power of 4 which isn't bigger than value, searching down from bit.
+template <typename T_ty>
+inline constexpr T_ty topBit(const T_ty value, const T_ty bit)
+{
+    return (bit > value) ? topBit(value, T_ty(bit >> 2)) : bit;
+}
+
+/// Calculate the square root one binary digit at a time, from the top bit downwards.
+template <typename T_ty>
+inline constexpr T_ty digits(const T_ty value, const T_ty bit, const T_ty result)
+{
+    return (bit == 0) ? result :
+        (value >= result + bit) ?
+            digits(T_ty(value - (result + bit)), T_ty(bit >> 2), T_ty((result >> 1) + bit)) :
+            digits(value, T_ty(bit >> 2), T_ty(result >> 1));
+}
+
+/// Calculate the square root of an unsigned value, rounded down.
+template <typename T_ty>
+inline constexpr T_ty isqrt(const T_ty value)
+{
+    return digits(value, topBit(value, T_ty(T_ty(1) << (std::numeric_limits<T_ty>::digits - 2))), T_ty(0));
+}
+
+/// Calculate the square root of a 64-bit value, rounded down, at run-time.
+/// This gives exactly the same result as isqrt(), but it's much faster: it starts from the
+///  floating point square root, which can only be out by one or two, and then corrects it.
+inline std::uint64_t fastIsqrt(const std::uint64_t value)
+{
+    // The square root of the largest values rounds up to 2^32, whose square doesn't fit.
+    const std::uint64_t maxRoot = 0xffffffffu;
+    std::uint64_t root = static_cast<std::uint64_t>(std::sqrt(static_cast<double>(value)));
+    root = (root > maxRoot) ? maxRoot : root;
+    while (root * root > value)
+        --root;
+    while (root < maxRoot && (root + 1) * (root + 1) <= value)
+        ++root;
+    return root;
+}
+
+} // intsqrt
+
+/// Get the square root of an integer, rounded down. Negative values give 0. Only valid for integer types.
+/// This never converts to floating point, so it's exact for every value (even 64-bit ones), and
+///  it can be evaluated at compile-time. It takes a step for every two bits though, so at run-time
+///  Vector2d::getLength() and sqrt() for Fixed use intsqrt::fastIsqrt() instead.
+template <typename T_ty>
+inline constexpr typename std::enable_if<std::is_integral<T_ty>::value, T_ty>::type
+    isqrt(const T_ty val)
+{
+    typedef typename std::make_unsigned<T_ty>::type Unsigned;
+    return (val > T_ty(0)) ? static_cast<T_ty>(intsqrt::isqrt(static_cast<Unsigned>(val))) : T_ty(0);
+}
+
+/// Divide one integer by another, rounding the result down (towards negative infinity).
+/// The / operator rounds towards zero instead, which gives the wrong answer e.g. when finding
+///  which tile contains a negative position. Only valid for integer types. rhs must not be 0.
+template <typename T_ty>
+inline constexpr typename std::enable_if<std::is_integral<T_ty>::value, T_ty>::type
+    floorDiv(const T_ty lhs, const T_ty rhs)
+{
+    return (lhs / rhs) - ((((lhs % rhs) != 0) && ((lhs < T_ty(0)) != (rhs < T_ty(0)))) ? T_ty(1) : T_ty(0));
+}
+
 
 //-------------------------------------------------------------------------
 // Comparisons.
@@ -193,7 +366,7 @@ inline T_ty wrap(const T_ty val, T_ty rangeMin, T_ty rangeMax)
 template <typename T_ty>
 inline constexpr bool isApproxEqual(const T_ty lhs, const T_ty rhs, const T_ty margin)
 {
-    return diff(lhs, rhs) <= ((margin >= 0.0) ? margin : margin * -1.0);
+    return diff(lhs, rhs) <= ((margin >= T_ty(0)) ? margin : T_ty(0) - margin);
 }
 
 /// Check if a value is approximately zero, plus/minus the given margin.
@@ -201,7 +374,7 @@ inline constexpr bool isApproxEqual(const T_ty lhs, const T_ty rhs, const T_ty m
 template <typename T_ty>
 inline constexpr bool isApproxZero(const T_ty val, const T_ty margin)
 {
-    return (val >= 0 ? val : -val) <= ((margin >= 0.0) ? margin : margin * -1.0);
+    return (val >= 0 ? val : -val) <= ((margin >= T_ty(0)) ? margin : T_ty(0) - margin);
 }
 
 /// Check if a value is within the range defined by rangeMin and rangeMax.
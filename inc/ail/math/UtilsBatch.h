@@ -0,0 +1,490 @@
+#ifndef ail_math_UtilsBatch_h
+#define ail_math_UtilsBatch_h
+
+/** \file UtilsBatch.h
+    \brief Span versions of the maths utilities from Utils.h, with runtime SIMD dispatch.
+
+    Each function applies the scalar utility of the same name to a span of
+     values, e.g. for processing animation channels or telemetry buffers.
+    Spans are passed in place of the scalar arguments, followed by the output
+     span and the number of elements. The output may be the same as an input
+     span (i.e. processing in place), but mustn't partially overlap one.
+
+    For float and double, the kernels dispatch at runtime to an SSE2, AVX2 or
+     AVX-512 implementation depending on getSimdLevel() (see Simd.h). Other
+     types use a scalar loop. Every result is bit-identical to calling the
+     scalar function on each element, as long as the compiler isn't allowed to
+     contract multiplies and adds into fused operations.
+
+    The scalar wrap() calculates a remainder with std::fmod, which doesn't
+     vectorise. The span version uses a floor-based formulation instead:
+     q = floor(|d| / size), then |d| - q * size is calculated exactly by
+     splitting size into high and low halves (so that neither product is
+     rounded), and finally corrected if the quotient was rounded up. That gives
+     exactly the same remainder as std::fmod while the quotient is below 2^26,
+     which covers anything but extreme inputs (e.g. more than 67 million turns
+     of an angle). Any lanes outside that are recalculated with the scalar
+     function, as are ranges which are empty, not finite, or too small or too
+     large to split.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "Constants.h"
+#include "SimdOps.h"
+#include "Utils.h"
+
+//--------------
+namespace ail {
+namespace math {
+namespace kernels {
+//--------------
+
+//------------------------------------------------------------------------------
+// Scalar reference kernels.
+
+namespace scalar {
+
+/// Wrap each value round to fit within the given range. Equivalent to calling ail::math::wrap() on each element.
+template <typename T_ty>
+void wrap(const T_ty * val, const T_ty rangeMin, const T_ty rangeMax, T_ty * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = math::wrap(val[i], rangeMin, rangeMax);
+}
+
+/// Clamp each value to the given range. Equivalent to calling ail::math::clamp() on each element.
+template <typename T_ty>
+void clamp(const T_ty * val, const T_ty range1, const T_ty range2, T_ty * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = math::clamp(val[i], range1, range2);
+}
+
+/// Interpolate between start and end by each amount. Equivalent to calling ail::math::lerp() on each element.
+template <typename T_ty>
+void lerp(const T_ty * amount, const T_ty start, const T_ty end, T_ty * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = math::lerp(amount[i], start, end);
+}
+
+/// Interpolate between each pair of start and end values by the same amount.
+/// Equivalent to calling ail::math::lerp() on each pair.
+template <typename T_ty>
+void lerp(const T_ty amount, const T_ty * start, const T_ty * end, T_ty * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = math::lerp(amount, start[i], end[i]);
+}
+
+/// Interpolate between start and end by each amount, clamping to the range.
+/// Equivalent to calling ail::math::lerpClamp() on each element.
+template <typename T_ty>
+void lerpClamp(const T_ty * amount, const T_ty start, const T_ty end, T_ty * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = math::lerpClamp(amount[i], start, end);
+}
+
+/// Interpolate between each pair of start and end values by the same amount, clamping to the range.
+/// Equivalent to calling ail::math::lerpClamp() on each pair.
+template <typename T_ty>
+void lerpClamp(const T_ty amount, const T_ty * start, const T_ty * end, T_ty * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = math::lerpClamp(amount, start[i], end[i]);
+}
+
+/// Multiply each value by one factor then divide it by another, i.e. (val * mul) / div.
+/// This is the form of all the angle conversions in Utils.h.
+template <typename T_ty>
+void scale(const T_ty * val, const T_ty mul, const T_ty div, T_ty * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = (val[i] * mul) / div;
+}
+
+} // scalar
+
+//------------------------------------------------------------------------------
+// Helpers shared by the SIMD kernels.
+
+/// The size of a wrapping range, prepared for calculating exact remainders without std::fmod.
+/// The size is split into high and low halves of 26 bits each (Veltkamp's method), so
+///  multiplying either half by a quotient below 2^26 is exact. The calculation is always
+///  done in double precision. A float size has no more than 24 bits, so its low half is zero.
+struct WrapDivisor
+{
+    explicit WrapDivisor(const double rangeSize) :
+        size(rangeSize),
+        high(0),
+        low(0)
+    {
+        const double p = rangeSize * 134217729.0; // 2^27 + 1
+        high = p - (p - rangeSize);
+        low = rangeSize - high;
+    }
+
+    /// Check if the size is suitable for the split. This excludes NaN and infinity, and sizes
+    ///  which are so small or large that the intermediate values could underflow or overflow.
+    bool isSupported() const
+    {
+        return size >= 1e-270 && size <= 1e270;
+    }
+
+    /// Quotients must be below this for the remainder to be exact.
+    static double maxQuotient() { return 67108864.0; } // 2^26
+
+    double size;
+    double high;
+    double low;
+};
+
+#if defined(AIL_MATH_SIMD_X86)
+
+//------------------------------------------------------------------------------
+// SIMD kernels. The bodies are shared by every instruction set.
+
+AIL_MATH_SIMD_TARGET_BEGIN("sse2")
+namespace sse2 {
+#include "UtilsBatchImpl.inl"
+} // sse2
+AIL_MATH_SIMD_TARGET_END
+
+AIL_MATH_SIMD_TARGET_BEGIN("avx2")
+namespace avx2 {
+#include "UtilsBatchImpl.inl"
+} // avx2
+AIL_MATH_SIMD_TARGET_END
+
+#if defined(AIL_MATH_SIMD_AVX512)
+AIL_MATH_SIMD_TARGET_BEGIN("avx512f")
+namespace avx512 {
+#include "UtilsBatchImpl.inl"
+} // avx512
+AIL_MATH_SIMD_TARGET_END
+#endif // AIL_MATH_SIMD_AVX512
+
+#endif // AIL_MATH_SIMD_X86
+
+//------------------------------------------------------------------------------
+// Dispatching kernels.
+
+/// Wrap each value round to fit within the given range.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void wrap(const T_ty * val, const T_ty rangeMin, const T_ty rangeMax, T_ty * output, const std::size_t count)
+{
+    scalar::wrap(val, rangeMin, rangeMax, output, count);
+}
+
+/// Wrap each value round to fit within the given range.
+inline void wrap(const float * val, const float rangeMin, const float rangeMax, float * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(wrap, float, (val, rangeMin, rangeMax, output, count))
+}
+
+/// Wrap each value round to fit within the given range.
+inline void wrap(const double * val, const double rangeMin, const double rangeMax, double * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(wrap, double, (val, rangeMin, rangeMax, output, count))
+}
+
+/// Clamp each value to the given range.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void clamp(const T_ty * val, const T_ty range1, const T_ty range2, T_ty * output, const std::size_t count)
+{
+    scalar::clamp(val, range1, range2, output, count);
+}
+
+/// Clamp each value to the given range.
+inline void clamp(const float * val, const float range1, const float range2, float * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(clamp, float, (val, range1, range2, output, count))
+}
+
+/// Clamp each value to the given range.
+inline void clamp(const double * val, const double range1, const double range2, double * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(clamp, double, (val, range1, range2, output, count))
+}
+
+/// Interpolate between start and end by each amount.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void lerp(const T_ty * amount, const T_ty start, const T_ty end, T_ty * output, const std::size_t count)
+{
+    scalar::lerp(amount, start, end, output, count);
+}
+
+/// Interpolate between start and end by each amount.
+inline void lerp(const float * amount, const float start, const float end, float * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(lerp, float, (amount, start, end, output, count))
+}
+
+/// Interpolate between start and end by each amount.
+inline void lerp(const double * amount, const double start, const double end, double * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(lerp, double, (amount, start, end, output, count))
+}
+
+/// Interpolate between each pair of start and end values by the same amount.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void lerp(const T_ty amount, const T_ty * start, const T_ty * end, T_ty * output, const std::size_t count)
+{
+    scalar::lerp(amount, start, end, output, count);
+}
+
+/// Interpolate between each pair of start and end values by the same amount.
+inline void lerp(const float amount, const float * start, const float * end, float * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(lerp, float, (amount, start, end, output, count))
+}
+
+/// Interpolate between each pair of start and end values by the same amount.
+inline void lerp(const double amount, const double * start, const double * end, double * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(lerp, double, (amount, start, end, output, count))
+}
+
+/// Interpolate between start and end by each amount, clamping to the range.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void lerpClamp(const T_ty * amount, const T_ty start, const T_ty end, T_ty * output, const std::size_t count)
+{
+    scalar::lerpClamp(amount, start, end, output, count);
+}
+
+/// Interpolate between start and end by each amount, clamping to the range.
+inline void lerpClamp(const float * amount, const float start, const float end, float * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(lerpClamp, float, (amount, start, end, output, count))
+}
+
+/// Interpolate between start and end by each amount, clamping to the range.
+inline void lerpClamp(const double * amount, const double start, const double end, double * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(lerpClamp, double, (amount, start, end, output, count))
+}
+
+/// Interpolate between each pair of start and end values by the same amount, clamping to the range.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void lerpClamp(const T_ty amount, const T_ty * start, const T_ty * end, T_ty * output, const std::size_t count)
+{
+    scalar::lerpClamp(amount, start, end, output, count);
+}
+
+/// Interpolate between each pair of start and end values by the same amount, clamping to the range.
+inline void lerpClamp(const float amount, const float * start, const float * end, float * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(lerpClamp, float, (amount, start, end, output, count))
+}
+
+/// Interpolate between each pair of start and end values by the same amount, clamping to the range.
+inline void lerpClamp(const double amount, const double * start, const double * end, double * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(lerpClamp, double, (amount, start, end, output, count))
+}
+
+/// Calculate (val * mul) / div for each value.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void scale(const T_ty * val, const T_ty mul, const T_ty div, T_ty * output, const std::size_t count)
+{
+    scalar::scale(val, mul, div, output, count);
+}
+
+/// Calculate (val * mul) / div for each value.
+inline void scale(const float * val, const float mul, const float div, float * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(scale, float, (val, mul, div, output, count))
+}
+
+/// Calculate (val * mul) / div for each value.
+inline void scale(const double * val, const double mul, const double div, double * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(scale, double, (val, mul, div, output, count))
+}
+
+//--------------
+} // kernels
+//--------------
+
+//-------------------------------------------------------------------------
+// Angle conversions.
+// Multiplying or dividing by 1 doesn't change a value, so each conversion
+//  can be written as (angle * mul) / div without affecting the result.
+
+/// Convert a span of angles from degrees to radians. Only valid for floating point types.
+template <typename T_ty>
+inline typename std::enable_if<std::is_floating_point<T_ty>::value>::type
+    degToRad(const T_ty * angle, T_ty * output, const std::size_t count)
+{
+    kernels::scale(angle, pi<T_ty>(), T_ty(180), output, count);
+}
+
+/// Convert a span of angles from degrees to gradians. Only valid for floating point types.
+template <typename T_ty>
+inline typename std::enable_if<std::is_floating_point<T_ty>::value>::type
+    degToGrad(const T_ty * angle, T_ty * output, const std::size_t count)
+{
+    kernels::scale(angle, T_ty(1), T_ty(0.9), output, count);
+}
+
+/// Convert a span of angles from degrees to full turns. Only valid for floating point types.
+template <typename T_ty>
+inline typename std::enable_if<std::is_floating_point<T_ty>::value>::type
+    degToTurn(const T_ty * angle, T_ty * output, const std::size_t count)
+{
+    kernels::scale(angle, T_ty(1), T_ty(360), output, count);
+}
+
+
+/// Convert a span of angles from radians to degrees. Only valid for floating point types.
+template <typename T_ty>
+inline typename std::enable_if<std::is_floating_point<T_ty>::value>::type
+    radToDeg(const T_ty * angle, T_ty * output, const std::size_t count)
+{
+    kernels::scale(angle, T_ty(180), pi<T_ty>(), output, count);
+}
+
+/// Convert a span of angles from radians to gradians. Only valid for floating point types.
+template <typename T_ty>
+inline typename std::enable_if<std::is_floating_point<T_ty>::value>::type
+    radToGrad(const T_ty * angle, T_ty * output, const std::size_t count)
+{
+    kernels::scale(angle, T_ty(200), pi<T_ty>(), output, count);
+}
+
+/// Convert a span of angles from radians to full turns. Only valid for floating point types.
+template <typename T_ty>
+inline typename std::enable_if<std::is_floating_point<T_ty>::value>::type
+    radToTurn(const T_ty * angle, T_ty * output, const std::size_t count)
+{
+    kernels::scale(angle, T_ty(1), T_ty(2) * pi<T_ty>(), output, count);
+}
+
+
+/// Convert a span of angles from gradians to degrees. Only valid for floating point types.
+template <typename T_ty>
+inline typename std::enable_if<std::is_floating_point<T_ty>::value>::type
+    gradToDeg(const T_ty * angle, T_ty * output, const std::size_t count)
+{
+    kernels::scale(angle, T_ty(0.9), T_ty(1), output, count);
+}
+
+/// Convert a span of angles from gradians to radians. Only valid for floating point types.
+template <typename T_ty>
+inline typename std::enable_if<std::is_floating_point<T_ty>::value>::type
+    gradToRad(const T_ty * angle, T_ty * output, const std::size_t count)
+{
+    kernels::scale(angle, pi<T_ty>(), T_ty(200), output, count);
+}
+
+/// Convert a span of angles from gradians to full turns. Only valid for floating point types.
+template <typename T_ty>
+inline typename std::enable_if<std::is_floating_point<T_ty>::value>::type
+    gradToTurn(const T_ty * angle, T_ty * output, const std::size_t count)
+{
+    kernels::scale(angle, T_ty(1), T_ty(400), output, count);
+}
+
+
+/// Convert a span of angles from full turns to degrees.
+template <typename T_ty>
+inline void turnToDeg(const T_ty * angle, T_ty * output, const std::size_t count)
+{
+    kernels::scale(angle, T_ty(360), T_ty(1), output, count);
+}
+
+/// Convert a span of angles from full turns to radians. Only valid for floating point types.
+/// The scalar version multiplies by 2 then by pi. Doubling is exact, so that's the same as multiplying by 2 pi.
+template <typename T_ty>
+inline typename std::enable_if<std::is_floating_point<T_ty>::value>::type
+    turnToRad(const T_ty * angle, T_ty * output, const std::size_t count)
+{
+    kernels::scale(angle, T_ty(2) * pi<T_ty>(), T_ty(1), output, count);
+}
+
+/// Convert a span of angles from full turns to gradians.
+template <typename T_ty>
+inline void turnToGrad(const T_ty * angle, T_ty * output, const std::size_t count)
+{
+    kernels::scale(angle, T_ty(400), T_ty(1), output, count);
+}
+
+
+//-------------------------------------------------------------------------
+// Numerical utilities.
+
+/// Clamp a span of values to the range defined by range1 and range2.
+/// It doesn't matter which range value is bigger.
+template <typename T_ty>
+inline void clamp(const T_ty * val, const T_ty range1, const T_ty range2, T_ty * output, const std::size_t count)
+{
+    kernels::clamp(val, range1, range2, output, count);
+}
+
+/// Linearly interpolate between start and end by each amount in a span.
+/// This will extrapolate beyond the original range if necessary. Only valid for floating point types.
+template <typename T_ty>
+inline typename std::enable_if<std::is_floating_point<T_ty>::value>::type
+    lerp(const T_ty * amount, const T_ty start, const T_ty end, T_ty * output, const std::size_t count)
+{
+    kernels::lerp(amount, start, end, output, count);
+}
+
+/// Linearly interpolate between corresponding start and end values in two spans by the same amount.
+/// This will extrapolate beyond the original range if necessary. Only valid for floating point types.
+template <typename T_ty>
+inline typename std::enable_if<std::is_floating_point<T_ty>::value>::type
+    lerp(const T_ty amount, const T_ty * start, const T_ty * end, T_ty * output, const std::size_t count)
+{
+    kernels::lerp(amount, start, end, output, count);
+}
+
+/// Linearly interpolate between start and end by each amount in a span, clamping the results to the original range.
+/// Only valid for floating point types.
+template <typename T_ty>
+inline typename std::enable_if<std::is_floating_point<T_ty>::value>::type
+    lerpClamp(const T_ty * amount, const T_ty start, const T_ty end, T_ty * output, const std::size_t count)
+{
+    kernels::lerpClamp(amount, start, end, output, count);
+}
+
+/// Linearly interpolate between corresponding start and end values in two spans by the same amount,
+///  clamping the results to the original ranges. Only valid for floating point types.
+template <typename T_ty>
+inline typename std::enable_if<std::is_floating_point<T_ty>::value>::type
+    lerpClamp(const T_ty amount, const T_ty * start, const T_ty * end, T_ty * output, const std::size_t count)
+{
+    kernels::lerpClamp(amount, start, end, output, count);
+}
+
+/// Wrap a span of values round to fit within the given range.
+/// The wrapping range will be inclusive of rangeMin and exclusive of rangeMax.
+/// If rangeMin > rangeMax, they will be swapped.
+/// If rangeMin == rangeMax then every output will be rangeMin.
+template <typename T_ty>
+inline void wrap(const T_ty * val, const T_ty rangeMin, const T_ty rangeMax, T_ty * output, const std::size_t count)
+{
+    kernels::wrap(val, rangeMin, rangeMax, output, count);
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_UtilsBatch_h
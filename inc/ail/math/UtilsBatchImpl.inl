@@ -0,0 +1,243 @@
+/** \file UtilsBatchImpl.inl
+    \brief Generic bodies of the SIMD batch kernels for the maths utilities. (Intended for internal use by the library.)
+
+    NOTE: This file deliberately has no include guard. UtilsBatch.h includes it
+     once inside each instruction set namespace, where the Ops<T_ty> structure
+     from SimdOps.h wraps that instruction set's intrinsics. Don't include it
+     anywhere else.
+
+    Each kernel processes as many whole registers as possible, then hands the
+     remaining elements to the scalar reference kernel. The arithmetic and
+     comparisons are done in the same order as the scalar functions in Utils.h
+     so that results are identical.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+/// Clamp each lane to a range where range1 < range2, in exactly the same way as ail::math::clamp().
+/// That checks (val < range1) ? range1 : ((val > range2) ? range2 : val), which is what max then min do.
+template <typename T_ty>
+inline typename Ops<T_ty>::V clampAscending(const typename Ops<T_ty>::V val, const typename Ops<T_ty>::V range1, const typename Ops<T_ty>::V range2)
+{
+    return Ops<T_ty>::min(range2, Ops<T_ty>::max(range1, val));
+}
+
+/// Clamp each lane to a range where range1 >= range2 (or either is NaN), in exactly the same way as ail::math::clamp().
+/// That checks (val > range1) ? range1 : ((val < range2) ? range2 : val), which is what min then max do.
+template <typename T_ty>
+inline typename Ops<T_ty>::V clampDescending(const typename Ops<T_ty>::V val, const typename Ops<T_ty>::V range1, const typename Ops<T_ty>::V range2)
+{
+    return Ops<T_ty>::max(range2, Ops<T_ty>::min(range1, val));
+}
+
+/// Clamp each lane to a range which can be in either order, in exactly the same way as ail::math::clamp().
+template <typename T_ty>
+inline typename Ops<T_ty>::V clampLanes(const typename Ops<T_ty>::V val, const typename Ops<T_ty>::V range1, const typename Ops<T_ty>::V range2)
+{
+    typedef Ops<T_ty> O;
+    return O::select(O::lt(range1, range2), clampAscending<T_ty>(val, range1, range2), clampDescending<T_ty>(val, range1, range2));
+}
+
+/// Calculate std::fmod(d, divisor.size) exactly in each lane, using floor instead of a division remainder.
+/// Lanes where the quotient is too big (or not finite) get a meaningless result, and are flagged in fallback.
+inline Ops<double>::V fmodLanes(const Ops<double>::V d, const WrapDivisor & divisor, unsigned & fallback)
+{
+    typedef Ops<double> D;
+    typedef D::V V;
+
+    const V size = D::set1(divisor.size);
+    const V absD = D::abs(d);
+    const V quotient = D::div(absD, size);
+    fallback = ~D::maskBits(D::lt(quotient, D::set1(WrapDivisor::maxQuotient()))) & ((1u << D::width) - 1);
+
+    // Rounding the division can only push the quotient up to the next integer, never down.
+    // If that happened then the remainder is negative, and adding the size back on is exact.
+    const V q = D::floorSmall(quotient);
+    const V rem = D::sub(D::sub(absD, D::mul(q, D::set1(divisor.high))), D::mul(q, D::set1(divisor.low)));
+    const V corrected = D::select(D::lt(rem, D::set1(0.0)), D::add(rem, size), rem);
+
+    // std::fmod gives the remainder the same sign as the dividend, even if it's zero.
+    return D::copySign(corrected, d);
+}
+
+/// Calculate std::fmod(d, divisor.size) exactly in each lane, via double precision.
+/// The remainder from std::fmod is always exactly representable, so narrowing it back to float is exact.
+inline Ops<float>::V fmodLanes(const Ops<float>::V d, const WrapDivisor & divisor, unsigned & fallback)
+{
+    typedef Ops<float> F;
+
+    unsigned fallbackLow = 0, fallbackHigh = 0;
+    const Ops<double>::V low = fmodLanes(F::widenLow(d), divisor, fallbackLow);
+    const Ops<double>::V high = fmodLanes(F::widenHigh(d), divisor, fallbackHigh);
+    fallback = fallbackLow | (fallbackHigh << Ops<double>::width);
+    return F::narrow(low, high);
+}
+
+/// Wrap each value round to fit within the given range.
+template <typename T_ty>
+void wrap(const T_ty * val, T_ty rangeMin, T_ty rangeMax, T_ty * output, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+    typedef typename O::M M;
+
+    if (rangeMin > rangeMax) std::swap(rangeMin, rangeMax);
+    const WrapDivisor divisor(rangeMax - rangeMin);
+    if (!(rangeMin < rangeMax) || !divisor.isSupported()) {
+        scalar::wrap(val, rangeMin, rangeMax, output, count);
+        return;
+    }
+
+    const V vMin = O::set1(rangeMin);
+    const V vMax = O::set1(rangeMax);
+    const V zero = O::set1(T_ty(0));
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width) {
+        const V v = O::load(val + i);
+        const M inRange = O::maskAnd(O::le(vMin, v), O::lt(v, vMax));
+
+        unsigned fallback = 0;
+        const V rem = fmodLanes(O::sub(v, vMin), divisor, fallback);
+        const V wrapped = O::select(O::le(zero, rem), O::add(rem, vMin), O::add(rem, vMax));
+        const V result = O::select(inRange, v, wrapped);
+
+        fallback &= ~O::maskBits(inRange);
+        if (fallback == 0) {
+            O::store(output + i, result);
+        } else {
+            // This is rare, so it doesn't matter that it's slow. The block is
+            //  patched up separately in case the output overwrites the input.
+            T_ty block[O::width];
+            O::store(block, result);
+            for (std::size_t j = 0; j < O::width; ++j) {
+                if (fallback & (1u << j))
+                    block[j] = math::wrap(val[i + j], rangeMin, rangeMax);
+            }
+            std::memcpy(output + i, block, sizeof(block));
+        }
+    }
+    scalar::wrap(val + i, rangeMin, rangeMax, output + i, count - i);
+}
+
+/// Clamp each value to the given range.
+template <typename T_ty>
+void clamp(const T_ty * val, const T_ty range1, const T_ty range2, T_ty * output, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    const V vRange1 = O::set1(range1);
+    const V vRange2 = O::set1(range2);
+
+    std::size_t i = 0;
+    if (range1 < range2) {
+        for (; i + O::width <= count; i += O::width)
+            O::store(output + i, clampAscending<T_ty>(O::load(val + i), vRange1, vRange2));
+    } else {
+        for (; i + O::width <= count; i += O::width)
+            O::store(output + i, clampDescending<T_ty>(O::load(val + i), vRange1, vRange2));
+    }
+    scalar::clamp(val + i, range1, range2, output + i, count - i);
+}
+
+/// Interpolate between start and end by each amount.
+template <typename T_ty>
+void lerp(const T_ty * amount, const T_ty start, const T_ty end, T_ty * output, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    const V vStart = O::set1(start);
+    const V vDelta = O::set1(end - start);
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width)
+        O::store(output + i, O::add(vStart, O::mul(O::load(amount + i), vDelta)));
+    scalar::lerp(amount + i, start, end, output + i, count - i);
+}
+
+/// Interpolate between each pair of start and end values by the same amount.
+template <typename T_ty>
+void lerp(const T_ty amount, const T_ty * start, const T_ty * end, T_ty * output, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    const V vAmount = O::set1(amount);
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width) {
+        const V vStart = O::load(start + i);
+        O::store(output + i, O::add(vStart, O::mul(vAmount, O::sub(O::load(end + i), vStart))));
+    }
+    scalar::lerp(amount, start + i, end + i, output + i, count - i);
+}
+
+/// Interpolate between start and end by each amount, clamping to the range.
+template <typename T_ty>
+void lerpClamp(const T_ty * amount, const T_ty start, const T_ty end, T_ty * output, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    const V vStart = O::set1(start);
+    const V vEnd = O::set1(end);
+    const V vDelta = O::set1(end - start);
+
+    std::size_t i = 0;
+    if (start < end) {
+        for (; i + O::width <= count; i += O::width)
+            O::store(output + i, clampAscending<T_ty>(O::add(vStart, O::mul(O::load(amount + i), vDelta)), vStart, vEnd));
+    } else {
+        for (; i + O::width <= count; i += O::width)
+            O::store(output + i, clampDescending<T_ty>(O::add(vStart, O::mul(O::load(amount + i), vDelta)), vStart, vEnd));
+    }
+    scalar::lerpClamp(amount + i, start, end, output + i, count - i);
+}
+
+/// Interpolate between each pair of start and end values by the same amount, clamping to the range.
+template <typename T_ty>
+void lerpClamp(const T_ty amount, const T_ty * start, const T_ty * end, T_ty * output, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    const V vAmount = O::set1(amount);
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width) {
+        const V vStart = O::load(start + i);
+        const V vEnd = O::load(end + i);
+        const V lerped = O::add(vStart, O::mul(vAmount, O::sub(vEnd, vStart)));
+        O::store(output + i, clampLanes<T_ty>(lerped, vStart, vEnd));
+    }
+    scalar::lerpClamp(amount, start + i, end + i, output + i, count - i);
+}
+
+/// Calculate (val * mul) / div for each value.
+/// Multiplying or dividing by 1 is skipped, since it wouldn't change the result.
+template <typename T_ty>
+void scale(const T_ty * val, const T_ty mul, const T_ty div, T_ty * output, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    const V vMul = O::set1(mul);
+    const V vDiv = O::set1(div);
+
+    std::size_t i = 0;
+    if (div == T_ty(1)) {
+        for (; i + O::width <= count; i += O::width)
+            O::store(output + i, O::mul(O::load(val + i), vMul));
+    } else if (mul == T_ty(1)) {
+        for (; i + O::width <= count; i += O::width)
+            O::store(output + i, O::div(O::load(val + i), vDiv));
+    } else {
+        for (; i + O::width <= count; i += O::width)
+            O::store(output + i, O::div(O::mul(O::load(val + i), vMul), vDiv));
+    }
+    scalar::scale(val + i, mul, div, output + i, count - i);
+}
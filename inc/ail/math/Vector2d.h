@@ -10,6 +10,8 @@
 */
 
 #include <initializer_list>
+#include "Config.h"
+#include "Utils.h"
 
 //--------------
 namespace ail {
@@ -19,8 +21,15 @@ namespace math {
 // Forward declaration to the Polar coordinate class.
 template <typename T_ty> class Polar;
 
+// Forward declaration to the default trig policy. See TrigPolicy.h
+struct TrigExact;
+
 /** A 2d cartesian vector class.
 Template parameter gives the underlying numerical type, typically float or double.
+The class is trivially copyable, so arrays of vectors can be copied with memcpy.
+Construction, comparison and arithmetic are constexpr, so vectors can be used
+ in compile time constants. Operators which modify a vector in place need C++14
+ (see AIL_MATH_CONSTEXPR14 in Config.h).
 */
 template <typename T_ty>
 class Vector2d
@@ -30,81 +39,105 @@ public:
 // Construction / destruction.
 
     /// Constructor - initialises everything to 0.
-    Vector2d();
+    constexpr Vector2d();
 
     /// Constructor - initialises each component directly.
-    Vector2d(const T_ty tX, const T_ty tY);
+    constexpr Vector2d(const T_ty tX, const T_ty tY);
 
     /// Constructor - initializer list. Components are ordered: x, y.
     /// If initialiser list is empty then components are initialised to 0.
-    Vector2d(std::initializer_list<T_ty> args);
+    AIL_MATH_CONSTEXPR14 Vector2d(std::initializer_list<T_ty> args);
 
     /// Copy constructor.
-    Vector2d(const Vector2d<T_ty> & rhs);
+    Vector2d(const Vector2d<T_ty> & rhs) = default;
+
+    /// Move constructor.
+    Vector2d(Vector2d<T_ty> && rhs) = default;
 
     /// Convert from a polar coordinate into 2d cartesian vector.
     explicit Vector2d(const Polar<T_ty> & rhs);
 
     /// Destructor.
-    ~Vector2d();
+    ~Vector2d() = default;
 
 
 //------------------------------------------------------------------------------
 // Operators.
 
     /// Copy assignment operator.
-    Vector2d<T_ty> & operator = (const Vector2d<T_ty> & rhs);
+    Vector2d<T_ty> & operator = (const Vector2d<T_ty> & rhs) = default;
+    /// Move assignment operator.
+    Vector2d<T_ty> & operator = (Vector2d<T_ty> && rhs) = default;
 
     /// Equality test.
-    bool operator == (const Vector2d<T_ty> & rhs) const;
+    constexpr bool operator == (const Vector2d<T_ty> & rhs) const;
     /// Inequality test.
-    bool operator != (const Vector2d<T_ty> & rhs) const;
+    constexpr bool operator != (const Vector2d<T_ty> & rhs) const;
 
     /// Vector addition assignment
-    Vector2d<T_ty> & operator += (const Vector2d<T_ty> & rhs);
+    AIL_MATH_CONSTEXPR14 Vector2d<T_ty> & operator += (const Vector2d<T_ty> & rhs);
     /// Vector subtraction assignment
-    Vector2d<T_ty> & operator -= (const Vector2d<T_ty> & rhs);
+    AIL_MATH_CONSTEXPR14 Vector2d<T_ty> & operator -= (const Vector2d<T_ty> & rhs);
 
     /// Scalar multiplication assignment.
-    Vector2d<T_ty> & operator *= (const T_ty rhs);
+    AIL_MATH_CONSTEXPR14 Vector2d<T_ty> & operator *= (const T_ty rhs);
     /// Scalar division assignment.
-    Vector2d<T_ty> & operator /= (const T_ty rhs);
+    AIL_MATH_CONSTEXPR14 Vector2d<T_ty> & operator /= (const T_ty rhs);
 
     /// Returns a copy of the vector with all components negated.
-    Vector2d<T_ty> operator - () const;
+    constexpr Vector2d<T_ty> operator - () const;
 
 
 //------------------------------------------------------------------------------
 // Accessors / operations.
 
     /// Sets both components in one call.
-    void set(const T_ty tX, const T_ty tY);
+    AIL_MATH_CONSTEXPR14 void set(const T_ty tX, const T_ty tY);
 
     /// Get the Euclidean length of this vector.
+    /// For integer types this is exact (see isqrt in Utils.h), rounded down. It's calculated
+    ///  without overflowing, except that 64-bit integers throw std::overflow_error if the
+    ///  squared length is 2^64 or more.
     T_ty getLength() const;
 
     /// Get the squared Euclidean length of this vector
     /// This is much faster than getLength() as it avoids a square root.
     /// This can be useful for some comparisons.
-    T_ty getSqLength() const;
+    constexpr T_ty getSqLength() const;
+
+    /// Get the squared Euclidean length of this vector in a wider type, so that it doesn't overflow.
+    /// For integers smaller than 64 bits the result is a 64-bit integer (see widened in Utils.h).
+    ///  Other types are unchanged.
+    /// Throws std::overflow_error if the result doesn't fit in the wider type. That only happens
+    ///  for 32-bit integers if both components are -2^31, but it's much more likely for 64-bit integers.
+    constexpr typename widened<T_ty>::type getWideSqLength() const;
 
     /// Get the rectilinear length of this vector.
     /// Also known as the Manhattan length.
     /// This returns the sum of the components' magnitudes.
     T_ty getRectilinearLength() const;
 
+    /// Get the Chebyshev length of this vector.
+    /// This returns the larger of the components' magnitudes. On a grid where diagonal moves are
+    ///  allowed, it's the number of moves needed to cover the vector.
+    constexpr T_ty getChebyshevLength() const;
+
     /// Normalise this vector in place (makes it a unit vector).
+    /// For integer types, each component of the unit vector is rounded to the nearest integer
+    ///  (halfway rounds away from zero), giving the direction of the nearest of the eight
+    ///  neighbouring grid cells. This is calculated exactly, without floating point.
+    /// Zero length vectors are left unchanged.
     void normalise();
     /// Get a normalised copy of this vector.
     Vector2d<T_ty> getNormalised() const;
 
     /// Get the right tangent of this vector
-    Vector2d<T_ty> getRightTangent() const;
+    constexpr Vector2d<T_ty> getRightTangent() const;
     /// Get the left tangent of this vector
-    Vector2d<T_ty> getLeftTangent() const;
+    constexpr Vector2d<T_ty> getLeftTangent() const;
 
     /// Calculate the dot product of this vector with another.
-    T_ty dot(const Vector2d<T_ty> & rhs) const;
+    constexpr T_ty dot(const Vector2d<T_ty> & rhs) const;
 
     /// Get the amount by which this vector projects onto another.
     T_ty getScalarProjection(const Vector2d<T_ty> & rhs) const;
@@ -118,13 +151,23 @@ public:
     T_ty getDistance(const Vector2d<T_ty> & other) const;
 
     /// Treating both vectors as positions, get the square of the distance between this vector and another.
-    T_ty getSqDistance(const Vector2d<T_ty> & other) const;
+    AIL_MATH_CONSTEXPR14 T_ty getSqDistance(const Vector2d<T_ty> & other) const;
+
+    /// Treating both vectors as positions, get the square of the distance between them in a wider type.
+    /// The differences are calculated in the wider type too, so for integers smaller than 64 bits
+    ///  this can't overflow (see getWideSqLength()).
+    constexpr typename widened<T_ty>::type getWideSqDistance(const Vector2d<T_ty> & other) const;
 
     /// Treating both vectors as positions, get the rectilinear distance between this vector and another.
     /// This gets the sum of the differences between each component, also
     ///  known as the Manhattan distance.
     T_ty getRectilinearDistance(const Vector2d<T_ty> & other) const;
 
+    /// Treating both vectors as positions, get the Chebyshev distance between this vector and another.
+    /// This gets the larger of the differences between each component, also known as the
+    ///  chessboard distance.
+    constexpr T_ty getChebyshevDistance(const Vector2d<T_ty> & other) const;
+
     /// Check if this vector represents a position within a certain distance of another.
     /// The comparison uses Euclidean distance, making it more practical for most
     ///  purposes than isNearRectilinear() or isApproxEqual(). Those functions
@@ -152,12 +195,16 @@ public:
     /// This will use the simplest possible representation of a polar angle,
     ///  i.e. the magnitude will be positive, and the angle will be positive and
     ///  less than 2 pi radians (a full circle).
+    /// The optional template parameter selects the trig policy (see TrigPolicy.h).
+    template <typename T_policy = TrigExact>
     void toPolar(Polar<T_ty> & output) const;
 
     /// Convert this cartesian coordinate to a polar coordinate.
     /// This will use the simplest possible representation of a polar angle,
     ///  i.e. the magnitude will be positive, and the angle will be positive and
     ///  less than 2 pi radians (a full circle).
+    /// The optional template parameter selects the trig policy (see TrigPolicy.h).
+    template <typename T_policy = TrigExact>
     Polar<T_ty> toPolar() const;
 
 
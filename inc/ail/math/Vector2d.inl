@@ -11,10 +11,15 @@
 
 #include <cmath>
 #include <cassert>
+#include <cstdint>
+#include <limits>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #include "Vector2d.h"
 #include "Polar.h"
+#include "TrigPolicy.h"
 #include "Utils.h"
 
 //--------------
@@ -22,17 +27,149 @@ namespace ail {
 namespace math {
 //--------------
 
+template <int T_intBits, int T_fracBits> class Fixed;
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+// These are overloaded on std::is_integral, so that integer vectors can be
+//  handled exactly without converting to floating point.
+namespace vector2d {
+
+/// Get the magnitude of a component as an unsigned value of the widened type.
+template <typename T_ty>
+inline constexpr typename std::make_unsigned<typename widened<T_ty>::type>::type magnitude(const T_ty value)
+{
+    typedef typename std::make_unsigned<typename widened<T_ty>::type>::type Unsigned;
+    return (value < T_ty(0)) ? Unsigned(0) - static_cast<Unsigned>(value) : static_cast<Unsigned>(value);
+}
+
+/// Get the magnitude of a component, in its own type.
+template <typename T_ty>
+inline constexpr T_ty absolute(const T_ty value)
+{
+    return (value < T_ty(0)) ? -value : value;
+}
+
+/// Check if (a * a) + (b * b) is no bigger than limit, without overflowing.
+template <typename T_ty>
+inline constexpr bool isSqSumWithin(const T_ty a, const T_ty b, const T_ty limit)
+{
+    return
+        (a == 0 || a <= limit / a) &&
+        (b == 0 || b <= limit / b) &&
+        (a * a) <= limit - (b * b);
+}
+
+/// Get the squared length of an integer vector in the widened type.
+template <typename T_ty>
+inline constexpr typename widened<T_ty>::type sqLength(const T_ty x, const T_ty y, std::true_type)
+{
+    typedef typename widened<T_ty>::type Wide;
+    typedef typename std::make_unsigned<Wide>::type Unsigned;
+    return isSqSumWithin(magnitude(x), magnitude(y), static_cast<Unsigned>(std::numeric_limits<Wide>::max())) ?
+        static_cast<Wide>((magnitude(x) * magnitude(x)) + (magnitude(y) * magnitude(y))) :
+        throw std::overflow_error("The squared length of the vector is too big for its widened type.");
+}
+
+template <typename T_ty>
+inline constexpr T_ty sqLength(const T_ty x, const T_ty y, std::false_type)
+{
+    return (x * x) + (y * y);
+}
+
+/// Get the length of an integer vector exactly, rounded down.
+/// The squared length is calculated unsigned, so it can only overflow for 64-bit components.
+template <typename T_ty>
+inline T_ty length(const T_ty x, const T_ty y, std::true_type)
+{
+    typedef typename std::make_unsigned<typename widened<T_ty>::type>::type Unsigned;
+    const Unsigned a = magnitude(x);
+    const Unsigned b = magnitude(y);
+    if (!isSqSumWithin(a, b, std::numeric_limits<Unsigned>::max()))
+        throw std::overflow_error("The squared length of the vector is too big to calculate its length.");
+    return static_cast<T_ty>(intsqrt::fastIsqrt((a * a) + (b * b)));
+}
+
+template <typename T_ty>
+inline T_ty length(const T_ty x, const T_ty y, std::false_type)
+{
+    // Unqualified, so that sqrt() for other numeric types (e.g. Fixed) is found by argument dependent lookup.
+    using std::sqrt;
+    return sqrt((x * x) + (y * y));
+}
+
+/// Get the length of a fixed point vector with hypot() from Fixed.h.
+/// That sums the squares in 64 bits, since they often don't fit in the type.
+template <int T_intBits, int T_fracBits>
+inline Fixed<T_intBits, T_fracBits> length(const Fixed<T_intBits, T_fracBits> x, const Fixed<T_intBits, T_fracBits> y, std::false_type)
+{
+    return hypot(x, y);
+}
+
+/// Multiply two 64-bit values, giving the full 128-bit result as two halves.
+inline void mulWide(const std::uint64_t lhs, const std::uint64_t rhs, std::uint64_t & high, std::uint64_t & low)
+{
+    const std::uint64_t mask = 0xffffffffu;
+    const std::uint64_t ll = (lhs & mask) * (rhs & mask);
+    const std::uint64_t lh = (lhs & mask) * (rhs >> 32);
+    const std::uint64_t hl = (lhs >> 32) * (rhs & mask);
+    const std::uint64_t hh = (lhs >> 32) * (rhs >> 32);
+    const std::uint64_t mid = (ll >> 32) + (lh & mask) + (hl & mask);
+    low = (mid << 32) | (ll & mask);
+    high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+}
+
+/// Check if a component with magnitude a rounds to 1 in the unit vector, where b is the magnitude of the other component.
+/// That's true if a / sqrt((a * a) + (b * b)) >= 1/2, which simplifies to 3a^2 >= b^2. It's rearranged
+///  as d^2 <= 2a(a - d) where d = b - a, so that it can be checked exactly for any 64-bit magnitudes.
+inline bool roundsToOne(const std::uint64_t a, const std::uint64_t b)
+{
+    if (a == 0) return false;
+    if (b <= a) return true;
+    if (b / 2 >= a) return false;
+
+    // a < b < 2a here, so none of these can overflow.
+    const std::uint64_t d = b - a;
+    std::uint64_t lhsHigh = 0, lhsLow = 0, rhsHigh = 0, rhsLow = 0;
+    mulWide(d, d, lhsHigh, lhsLow);
+    mulWide(a * 2, a - d, rhsHigh, rhsLow);
+    return (lhsHigh < rhsHigh) || (lhsHigh == rhsHigh && lhsLow <= rhsLow);
+}
+
+/// Normalise an integer vector, rounding each component of the unit vector to the nearest integer.
+template <typename T_ty>
+inline void normalise(T_ty & x, T_ty & y, std::true_type)
+{
+    const bool keepX = roundsToOne(magnitude(x), magnitude(y));
+    const bool keepY = roundsToOne(magnitude(y), magnitude(x));
+    x = keepX ? ((x < T_ty(0)) ? T_ty(-1) : T_ty(1)) : T_ty(0);
+    y = keepY ? ((y < T_ty(0)) ? T_ty(-1) : T_ty(1)) : T_ty(0);
+}
+
+template <typename T_ty>
+inline void normalise(T_ty & x, T_ty & y, std::false_type)
+{
+    const T_ty mag = length(x, y, std::false_type());
+    if (mag != 0) {
+        x /= mag;
+        y /= mag;
+    }
+}
+
+} // vector2d
+
 //------------------------------------------------------------------------------
 // Construction / destruction.
 
 template <typename T_ty>
-Vector2d<T_ty>::Vector2d() :
+constexpr Vector2d<T_ty>::Vector2d() :
     x(0), y(0)
 {
 }
 
 template <typename T_ty>
-Vector2d<T_ty>::Vector2d(std::initializer_list<T_ty> args) :
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty>::Vector2d(std::initializer_list<T_ty> args) :
     Vector2d()
 {
     if (args.size() == 0)
@@ -46,17 +183,11 @@ Vector2d<T_ty>::Vector2d(std::initializer_list<T_ty> args) :
 }
 
 template <typename T_ty>
-Vector2d<T_ty>::Vector2d(const T_ty tX, const T_ty tY) :
+constexpr Vector2d<T_ty>::Vector2d(const T_ty tX, const T_ty tY) :
     x(tX), y(tY)
 {
 }
 
-template <typename T_ty>
-Vector2d<T_ty>::Vector2d(const Vector2d<T_ty> & rhs) :
-    x(rhs.x), y(rhs.y)
-{
-}
-
 template <typename T_ty>
 Vector2d<T_ty>::Vector2d(const Polar<T_ty> & rhs) :
     Vector2d<T_ty>()
@@ -64,36 +195,23 @@ Vector2d<T_ty>::Vector2d(const Polar<T_ty> & rhs) :
     rhs.toVector2d(*this);
 }
 
-template <typename T_ty>
-Vector2d<T_ty>::~Vector2d()
-{
-}
-
 //------------------------------------------------------------------------------
 // Operators.
 
 template <typename T_ty>
-Vector2d<T_ty> & Vector2d<T_ty>::operator = (const Vector2d<T_ty> & rhs)
-{
-    x = rhs.x;
-    y = rhs.y;
-    return *this;
-}
-
-template <typename T_ty>
-bool Vector2d<T_ty>::operator == (const Vector2d<T_ty> & rhs) const
+constexpr bool Vector2d<T_ty>::operator == (const Vector2d<T_ty> & rhs) const
 {
     return x == rhs.x && y == rhs.y;
 }
 
 template <typename T_ty>
-bool Vector2d<T_ty>::operator != (const Vector2d<T_ty> & rhs) const
+constexpr bool Vector2d<T_ty>::operator != (const Vector2d<T_ty> & rhs) const
 {
     return !(x == rhs.x && y == rhs.y);
 }
 
 template <typename T_ty>
-Vector2d<T_ty> & Vector2d<T_ty>::operator += (const Vector2d<T_ty> & rhs)
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> & Vector2d<T_ty>::operator += (const Vector2d<T_ty> & rhs)
 {
     x += rhs.x;
     y += rhs.y;
@@ -101,7 +219,7 @@ Vector2d<T_ty> & Vector2d<T_ty>::operator += (const Vector2d<T_ty> & rhs)
 }
 
 template <typename T_ty>
-Vector2d<T_ty> & Vector2d<T_ty>::operator -= (const Vector2d<T_ty> & rhs)
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> & Vector2d<T_ty>::operator -= (const Vector2d<T_ty> & rhs)
 {
     x -= rhs.x;
     y -= rhs.y;
@@ -109,7 +227,7 @@ Vector2d<T_ty> & Vector2d<T_ty>::operator -= (const Vector2d<T_ty> & rhs)
 }
 
 template <typename T_ty>
-Vector2d<T_ty> & Vector2d<T_ty>::operator *= (const T_ty rhs)
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> & Vector2d<T_ty>::operator *= (const T_ty rhs)
 {
     x *= rhs;
     y *= rhs;
@@ -117,7 +235,7 @@ Vector2d<T_ty> & Vector2d<T_ty>::operator *= (const T_ty rhs)
 }
 
 template <typename T_ty>
-Vector2d<T_ty> & Vector2d<T_ty>::operator /= (const T_ty rhs)
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> & Vector2d<T_ty>::operator /= (const T_ty rhs)
 {
     assert(rhs != 0);
     x /= rhs;
@@ -126,7 +244,7 @@ Vector2d<T_ty> & Vector2d<T_ty>::operator /= (const T_ty rhs)
 }
 
 template <typename T_ty>
-Vector2d<T_ty> Vector2d<T_ty>::operator - () const
+constexpr Vector2d<T_ty> Vector2d<T_ty>::operator - () const
 {
     return Vector2d<T_ty>(-x, -y);
 }
@@ -135,7 +253,7 @@ Vector2d<T_ty> Vector2d<T_ty>::operator - () const
 // Accessors / operations.
 
 template <typename T_ty>
-void Vector2d<T_ty>::set(const T_ty tX, const T_ty tY)
+AIL_MATH_CONSTEXPR14 void Vector2d<T_ty>::set(const T_ty tX, const T_ty tY)
 {
     x = tX;
     y = tY;
@@ -144,29 +262,38 @@ void Vector2d<T_ty>::set(const T_ty tX, const T_ty tY)
 template <typename T_ty>
 T_ty Vector2d<T_ty>::getLength() const
 {
-    return std::sqrt((x * x) + (y * y));
+    return vector2d::length(x, y, std::is_integral<T_ty>());
 }
 
 template <typename T_ty>
-T_ty Vector2d<T_ty>::getSqLength() const
+constexpr T_ty Vector2d<T_ty>::getSqLength() const
 {
     return (x*x) + (y*y);
 }
 
+template <typename T_ty>
+constexpr typename widened<T_ty>::type Vector2d<T_ty>::getWideSqLength() const
+{
+    return vector2d::sqLength(x, y, std::is_integral<T_ty>());
+}
+
 template <typename T_ty>
 T_ty Vector2d<T_ty>::getRectilinearLength() const
 {
-    return std::abs(x) + std::abs(y);
+    using std::abs;
+    return abs(x) + abs(y);
+}
+
+template <typename T_ty>
+constexpr T_ty Vector2d<T_ty>::getChebyshevLength() const
+{
+    return (vector2d::absolute(x) >= vector2d::absolute(y)) ? vector2d::absolute(x) : vector2d::absolute(y);
 }
 
 template <typename T_ty>
 void Vector2d<T_ty>::normalise()
 {
-    const T_ty mag = getLength();
-    if (mag != 0) {
-        x /= mag;
-        y /= mag;
-    }
+    vector2d::normalise(x, y, std::is_integral<T_ty>());
 }
 
 template <typename T_ty>
@@ -178,19 +305,19 @@ Vector2d<T_ty> Vector2d<T_ty>::getNormalised() const
 }
 
 template <typename T_ty>
-Vector2d<T_ty> Vector2d<T_ty>::getRightTangent() const
+constexpr Vector2d<T_ty> Vector2d<T_ty>::getRightTangent() const
 {
     return Vector2d<T_ty>(y, -x);
 }
 
 template <typename T_ty>
-Vector2d<T_ty> Vector2d<T_ty>::getLeftTangent() const
+constexpr Vector2d<T_ty> Vector2d<T_ty>::getLeftTangent() const
 {
     return Vector2d<T_ty>(-y, x);
 }
 
 template <typename T_ty>
-T_ty Vector2d<T_ty>::dot(const Vector2d<T_ty> &rhs) const
+constexpr T_ty Vector2d<T_ty>::dot(const Vector2d<T_ty> &rhs) const
 {
     return (x * rhs.x) + (y * rhs.y);
 }
@@ -218,17 +345,33 @@ T_ty Vector2d<T_ty>::getDistance(const Vector2d<T_ty> & other) const
 }
 
 template <typename T_ty>
-T_ty Vector2d<T_ty>::getSqDistance(const Vector2d<T_ty> & other) const
+AIL_MATH_CONSTEXPR14 T_ty Vector2d<T_ty>::getSqDistance(const Vector2d<T_ty> & other) const
 {
     return (*this - other).getSqLength();
 }
 
+template <typename T_ty>
+constexpr typename widened<T_ty>::type Vector2d<T_ty>::getWideSqDistance(const Vector2d<T_ty> & other) const
+{
+    typedef typename widened<T_ty>::type Wide;
+    return vector2d::sqLength(
+        static_cast<Wide>(static_cast<Wide>(x) - static_cast<Wide>(other.x)),
+        static_cast<Wide>(static_cast<Wide>(y) - static_cast<Wide>(other.y)),
+        std::is_integral<T_ty>());
+}
+
 template <typename T_ty>
 T_ty Vector2d<T_ty>::getRectilinearDistance(const Vector2d<T_ty> & other) const
 {
     return (*this - other).getRectilinearLength();
 }
 
+template <typename T_ty>
+constexpr T_ty Vector2d<T_ty>::getChebyshevDistance(const Vector2d<T_ty> & other) const
+{
+    return Vector2d<T_ty>(x - other.x, y - other.y).getChebyshevLength();
+}
+
 template <typename T_ty>
 bool Vector2d<T_ty>::isNear(const Vector2d<T_ty> & other, const T_ty dist) const
 {
@@ -238,7 +381,8 @@ bool Vector2d<T_ty>::isNear(const Vector2d<T_ty> & other, const T_ty dist) const
 template <typename T_ty>
 bool Vector2d<T_ty>::isNearRectilinear(const Vector2d<T_ty> & other, const T_ty dist) const
 {
-    return getRectilinearDistance(other) <= std::abs(dist);
+    using std::abs;
+    return getRectilinearDistance(other) <= abs(dist);
 }
 
 template <typename T_ty>
@@ -253,18 +397,19 @@ bool Vector2d<T_ty>::isApproxEqual(const Vector2d<T_ty> & other, const T_ty marg
 // Conversions.
 
 template <typename T_ty>
+template <typename T_policy>
 void Vector2d<T_ty>::toPolar(Polar<T_ty> & output) const
 {
-    output.mag = getLength();
-    output.angle = static_cast<T_ty>(std::atan2(y, x));
+    trigpolicy::toPolar<T_policy>(*this, output.angle, output.mag, 0);
     output.simplify();
 }
 
 template <typename T_ty>
+template <typename T_policy>
 Polar<T_ty> Vector2d<T_ty>::toPolar() const
 {
     Polar<T_ty> output;
-    toPolar(output);
+    toPolar<T_policy>(output);
     return output;
 }
 
@@ -273,47 +418,88 @@ Polar<T_ty> Vector2d<T_ty>::toPolar() const
 
 /// Adds two cartesian vectors together and returns the result.
 template <typename T_ty>
-Vector2d<T_ty> operator + (const Vector2d<T_ty> & lhs, const Vector2d<T_ty> & rhs)
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> operator + (const Vector2d<T_ty> & lhs, const Vector2d<T_ty> & rhs)
 {
     Vector2d<T_ty> ans(lhs);
-    return ans += rhs;
+    ans += rhs;
+    return ans;
 }
 
 /// Subtracts one cartesian vector (rhs) from another (lhs) and returns the result.
 template <typename T_ty>
-Vector2d<T_ty> operator - (const Vector2d<T_ty> & lhs, const Vector2d<T_ty> & rhs)
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> operator - (const Vector2d<T_ty> & lhs, const Vector2d<T_ty> & rhs)
 {
     Vector2d<T_ty> ans(lhs);
-    return ans -= rhs;
+    ans -= rhs;
+    return ans;
 }
 
 /// Multiplies a cartesian vector by a scalar and returns the result.
 template <typename T_ty>
-Vector2d<T_ty> operator * (const Vector2d<T_ty> & lhs, const T_ty & rhs)
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> operator * (const Vector2d<T_ty> & lhs, const T_ty & rhs)
 {
     Vector2d<T_ty> ans(lhs);
-    return ans *= rhs;
+    ans *= rhs;
+    return ans;
 }
 
 /// Multiplies a cartesian vector by a scalar and returns the result.
 template <typename T_ty>
-Vector2d<T_ty> operator * (const T_ty & lhs, const Vector2d<T_ty> & rhs)
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> operator * (const T_ty & lhs, const Vector2d<T_ty> & rhs)
 {
     Vector2d<T_ty> ans(rhs);
-    return ans *= lhs;
+    ans *= lhs;
+    return ans;
 }
 
 /// Divides a cartesian vector by a scalar and returns the result.
 template <typename T_ty>
-Vector2d<T_ty> operator / (const Vector2d<T_ty> & lhs, const T_ty & rhs)
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> operator / (const Vector2d<T_ty> & lhs, const T_ty & rhs)
 {
     Vector2d<T_ty> ans(lhs);
-    return ans /= rhs;
+    ans /= rhs;
+    return ans;
+}
+
+/// Adds two cartesian vectors together, reusing lhs if it's a temporary.
+/// This saves copying intermediate results in chains like a + b + c.
+template <typename T_ty>
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> operator + (Vector2d<T_ty> && lhs, const Vector2d<T_ty> & rhs)
+{
+    lhs += rhs;
+    return std::move(lhs);
+}
+
+/// Subtracts one cartesian vector (rhs) from another (lhs), reusing lhs if it's a temporary.
+/// This saves copying intermediate results in chains like a + b + c.
+template <typename T_ty>
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> operator - (Vector2d<T_ty> && lhs, const Vector2d<T_ty> & rhs)
+{
+    lhs -= rhs;
+    return std::move(lhs);
+}
+
+/// Multiplies a cartesian vector by a scalar, reusing lhs if it's a temporary.
+/// This saves copying intermediate results in chains like a + b + c.
+template <typename T_ty>
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> operator * (Vector2d<T_ty> && lhs, const T_ty & rhs)
+{
+    lhs *= rhs;
+    return std::move(lhs);
+}
+
+/// Divides a cartesian vector by a scalar, reusing lhs if it's a temporary.
+/// This saves copying intermediate results in chains like a + b + c.
+template <typename T_ty>
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> operator / (Vector2d<T_ty> && lhs, const T_ty & rhs)
+{
+    lhs /= rhs;
+    return std::move(lhs);
 }
 
 /// Divides a scalar by a cartesian vector and returns the result.
 template <typename T_ty>
-Vector2d<T_ty> operator / (const T_ty & lhs, const Vector2d<T_ty> & rhs)
+AIL_MATH_CONSTEXPR14 Vector2d<T_ty> operator / (const T_ty & lhs, const Vector2d<T_ty> & rhs)
 {
     Vector2d<T_ty> ans(rhs);
     ans.x = lhs / ans.x;
@@ -321,6 +507,63 @@ Vector2d<T_ty> operator / (const T_ty & lhs, const Vector2d<T_ty> & rhs)
     return ans;
 }
 
+//------------------------------------------------------------------------------
+// Grid operations.
+
+/// Divide each component by a scalar, rounding down (see floorDiv in Utils.h). Only valid for integer types.
+/// This is useful for finding which tile contains a position, even if the position is negative.
+template <typename T_ty>
+inline constexpr typename std::enable_if<std::is_integral<T_ty>::value, Vector2d<T_ty>>::type
+    floorDiv(const Vector2d<T_ty> & lhs, const T_ty rhs)
+{
+    return Vector2d<T_ty>(floorDiv(lhs.x, rhs), floorDiv(lhs.y, rhs));
+}
+
+/// Divide each component by the corresponding component of another vector, rounding down (see floorDiv in Utils.h).
+/// Only valid for integer types. This is useful for finding which tile contains a position, when the tiles aren't square.
+template <typename T_ty>
+inline constexpr typename std::enable_if<std::is_integral<T_ty>::value, Vector2d<T_ty>>::type
+    floorDiv(const Vector2d<T_ty> & lhs, const Vector2d<T_ty> & rhs)
+{
+    return Vector2d<T_ty>(floorDiv(lhs.x, rhs.x), floorDiv(lhs.y, rhs.y));
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+
+/// Instantiates Vector2d and its global operators for one type.
+/// T_prefix is "template" for an instantiation definition (see src/math/Vector2d.cpp),
+///  or "extern template" for a declaration.
+#define AIL_MATH_INSTANTIATE_VECTOR2D(T_prefix, T_type) \
+    T_prefix class Vector2d<T_type>; \
+    T_prefix Vector2d<T_type> operator + (const Vector2d<T_type> &, const Vector2d<T_type> &); \
+    T_prefix Vector2d<T_type> operator - (const Vector2d<T_type> &, const Vector2d<T_type> &); \
+    T_prefix Vector2d<T_type> operator * (const Vector2d<T_type> &, const T_type &); \
+    T_prefix Vector2d<T_type> operator * (const T_type &, const Vector2d<T_type> &); \
+    T_prefix Vector2d<T_type> operator / (const Vector2d<T_type> &, const T_type &); \
+    T_prefix Vector2d<T_type> operator / (const T_type &, const Vector2d<T_type> &); \
+    T_prefix Vector2d<T_type> operator + (Vector2d<T_type> &&, const Vector2d<T_type> &); \
+    T_prefix Vector2d<T_type> operator - (Vector2d<T_type> &&, const Vector2d<T_type> &); \
+    T_prefix Vector2d<T_type> operator * (Vector2d<T_type> &&, const T_type &); \
+    T_prefix Vector2d<T_type> operator / (Vector2d<T_type> &&, const T_type &);
+
+/// Instantiates the conversions to Polar with the default trig policy.
+/// These are only available for floating point types.
+#define AIL_MATH_INSTANTIATE_VECTOR2D_FP(T_prefix, T_type) \
+    T_prefix void Vector2d<T_type>::toPolar<TrigExact>(Polar<T_type> &) const; \
+    T_prefix Polar<T_type> Vector2d<T_type>::toPolar<TrigExact>() const;
+
+// If AIL_MATH_EXTERN_TEMPLATES is defined then the common types are compiled
+//  once in the ail_math_instances library, instead of in every translation unit.
+#if defined(AIL_MATH_EXTERN_TEMPLATES)
+AIL_MATH_INSTANTIATE_VECTOR2D(extern template, float)
+AIL_MATH_INSTANTIATE_VECTOR2D(extern template, double)
+AIL_MATH_INSTANTIATE_VECTOR2D(extern template, std::int32_t)
+AIL_MATH_INSTANTIATE_VECTOR2D(extern template, std::int64_t)
+AIL_MATH_INSTANTIATE_VECTOR2D_FP(extern template, float)
+AIL_MATH_INSTANTIATE_VECTOR2D_FP(extern template, double)
+#endif
+
 //--------------
 } // math
 } // ail
@@ -0,0 +1,318 @@
+#ifndef ail_math_Vector2dArray_h
+#define ail_math_Vector2dArray_h
+
+/** \file Vector2dArray.h
+    \brief Declares a structure-of-arrays container of 2d cartesian vectors. See Vector2dArray.inl for implementation.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cstddef>
+#include <initializer_list>
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+/** A contiguous array of 2d cartesian vectors, stored as a structure of arrays.
+The x and y components are held in two separate aligned lanes, rather than as
+ interleaved Vector2d objects. This lets whole-array operations run as tight
+ loops which the compiler (or the SIMD kernels) can vectorise.
+Individual elements can still be accessed as if they were Vector2d objects via
+ the Reference proxy returned by the subscript operator and iterators.
+The batch operations use the SIMD kernels from Vector2dKernels.h where available.
+Template parameter gives the underlying numerical type, typically float or double.
+It must be a plain numeric type which can be copied with memcpy.
+*/
+template <typename T_ty>
+class Vector2dArray
+{
+public:
+//------------------------------------------------------------------------------
+// Element access proxies.
+
+    /// Proxy object referring to a single element of the array.
+    /// It behaves like a Vector2d, but reads and writes go directly to the
+    ///  underlying x and y lanes.
+    class Reference
+    {
+    public:
+        /// Constructor - refers to the given pair of components.
+        Reference(T_ty & x, T_ty & y);
+
+        /// Assigns a vector to the referenced element.
+        Reference & operator = (const Vector2d<T_ty> & rhs);
+        /// Assigns the value of another element to the referenced element.
+        Reference & operator = (const Reference & rhs);
+
+        /// Vector addition assignment.
+        Reference & operator += (const Vector2d<T_ty> & rhs);
+        /// Vector subtraction assignment.
+        Reference & operator -= (const Vector2d<T_ty> & rhs);
+        /// Scalar multiplication assignment.
+        Reference & operator *= (const T_ty rhs);
+        /// Scalar division assignment.
+        Reference & operator /= (const T_ty rhs);
+
+        /// Get a copy of the referenced element as a Vector2d.
+        operator Vector2d<T_ty>() const;
+
+        /// Get a copy of the referenced element as a Vector2d.
+        Vector2d<T_ty> get() const;
+
+        /// X component of the referenced element.
+        T_ty & x;
+
+        /// Y component of the referenced element.
+        T_ty & y;
+    };
+
+    /// Iterator over the elements of the array, yielding Reference proxies.
+    class Iterator
+    {
+    public:
+        /// Constructor - points at the given index of the given array.
+        Iterator(Vector2dArray<T_ty> & arr, const std::size_t index);
+
+        /// Get a proxy to the current element.
+        Reference operator * () const;
+
+        /// Advance to the next element.
+        Iterator & operator ++ ();
+
+        /// Equality test.
+        bool operator == (const Iterator & rhs) const;
+        /// Inequality test.
+        bool operator != (const Iterator & rhs) const;
+
+    private:
+        Vector2dArray<T_ty> * m_array;
+        std::size_t m_index;
+    };
+
+    /// Read-only iterator over the elements of the array, yielding Vector2d copies.
+    class ConstIterator
+    {
+    public:
+        /// Constructor - points at the given index of the given array.
+        ConstIterator(const Vector2dArray<T_ty> & arr, const std::size_t index);
+
+        /// Get a copy of the current element.
+        Vector2d<T_ty> operator * () const;
+
+        /// Advance to the next element.
+        ConstIterator & operator ++ ();
+
+        /// Equality test.
+        bool operator == (const ConstIterator & rhs) const;
+        /// Inequality test.
+        bool operator != (const ConstIterator & rhs) const;
+
+    private:
+        const Vector2dArray<T_ty> * m_array;
+        std::size_t m_index;
+    };
+
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+    /// Constructor - creates an empty array.
+    Vector2dArray();
+
+    /// Constructor - creates an array of the given size, with all elements set to 0.
+    explicit Vector2dArray(const std::size_t count);
+
+    /// Constructor - creates an array of the given size, with all elements set to value.
+    Vector2dArray(const std::size_t count, const Vector2d<T_ty> & value);
+
+    /// Constructor - initializer list of vectors.
+    Vector2dArray(std::initializer_list<Vector2d<T_ty>> args);
+
+    /// Constructor - copies the given range of interleaved vectors.
+    Vector2dArray(const Vector2d<T_ty> * vectors, const std::size_t count);
+
+    /// Copy constructor.
+    Vector2dArray(const Vector2dArray<T_ty> & rhs);
+
+    /// Move constructor.
+    Vector2dArray(Vector2dArray<T_ty> && rhs);
+
+    /// Destructor.
+    ~Vector2dArray();
+
+
+//------------------------------------------------------------------------------
+// Operators.
+
+    /// Copy assignment operator.
+    Vector2dArray<T_ty> & operator = (const Vector2dArray<T_ty> & rhs);
+
+    /// Move assignment operator.
+    Vector2dArray<T_ty> & operator = (Vector2dArray<T_ty> && rhs);
+
+    /// Equality test. Arrays are equal if they have the same size and all elements are equal.
+    bool operator == (const Vector2dArray<T_ty> & rhs) const;
+    /// Inequality test.
+    bool operator != (const Vector2dArray<T_ty> & rhs) const;
+
+    /// Get a proxy to the element at the given index.
+    Reference operator [] (const std::size_t index);
+    /// Get a copy of the element at the given index.
+    Vector2d<T_ty> operator [] (const std::size_t index) const;
+
+    /// Element-wise vector addition assignment.
+    /// Throws std::invalid_argument if the arrays are different sizes.
+    Vector2dArray<T_ty> & operator += (const Vector2dArray<T_ty> & rhs);
+    /// Element-wise vector subtraction assignment.
+    /// Throws std::invalid_argument if the arrays are different sizes.
+    Vector2dArray<T_ty> & operator -= (const Vector2dArray<T_ty> & rhs);
+
+    /// Add the same vector to every element.
+    Vector2dArray<T_ty> & operator += (const Vector2d<T_ty> & rhs);
+    /// Subtract the same vector from every element.
+    Vector2dArray<T_ty> & operator -= (const Vector2d<T_ty> & rhs);
+
+    /// Scalar multiplication assignment for every element.
+    Vector2dArray<T_ty> & operator *= (const T_ty rhs);
+    /// Scalar division assignment for every element.
+    Vector2dArray<T_ty> & operator /= (const T_ty rhs);
+
+
+//------------------------------------------------------------------------------
+// Size / storage.
+
+    /// Get the number of elements in the array.
+    std::size_t size() const;
+
+    /// Check if the array has no elements.
+    bool empty() const;
+
+    /// Get the number of elements which can be stored without reallocating.
+    std::size_t capacity() const;
+
+    /// Ensure there is space for at least count elements without reallocating.
+    void reserve(const std::size_t count);
+
+    /// Change the number of elements in the array.
+    /// New elements are initialised to 0.
+    void resize(const std::size_t count);
+
+    /// Remove all elements. This does not release the storage.
+    void clear();
+
+    /// Append a vector to the end of the array.
+    /// Throws std::length_error if the capacity can't grow any further, or
+    ///  std::bad_alloc if the allocation fails.
+    void push_back(const Vector2d<T_ty> & value);
+
+    /// Get a pointer to the contiguous lane of x components.
+    T_ty * x();
+    /// Get a pointer to the contiguous lane of x components.
+    const T_ty * x() const;
+
+    /// Get a pointer to the contiguous lane of y components.
+    T_ty * y();
+    /// Get a pointer to the contiguous lane of y components.
+    const T_ty * y() const;
+
+
+//------------------------------------------------------------------------------
+// Element access.
+
+    /// Get a copy of the element at the given index.
+    Vector2d<T_ty> get(const std::size_t index) const;
+
+    /// Set the element at the given index.
+    void set(const std::size_t index, const Vector2d<T_ty> & value);
+
+    /// Get an iterator to the first element.
+    Iterator begin();
+    /// Get an iterator one past the last element.
+    Iterator end();
+
+    /// Get a read-only iterator to the first element.
+    ConstIterator begin() const;
+    /// Get a read-only iterator one past the last element.
+    ConstIterator end() const;
+
+    /// Copy all elements out into an interleaved buffer.
+    /// The output buffer must have space for size() elements.
+    void copyTo(Vector2d<T_ty> * output) const;
+
+
+//------------------------------------------------------------------------------
+// Batch operations.
+
+    /// Normalise every element in place (makes them unit vectors).
+    /// Elements with zero length are left unchanged, matching Vector2d::normalise().
+    void normalise();
+
+    /// Get the Euclidean length of every element, matching Vector2d::getLength().
+    /// The output buffer must have space for size() values.
+    void getLengths(T_ty * output) const;
+
+    /// Get the squared Euclidean length of every element.
+    /// The output buffer must have space for size() values.
+    void getSqLengths(T_ty * output) const;
+
+    /// Calculate the dot product of every element with the corresponding element of another array.
+    /// The output buffer must have space for size() values.
+    /// Throws std::invalid_argument if the arrays are different sizes.
+    void dot(const Vector2dArray<T_ty> & rhs, T_ty * output) const;
+
+    /// Calculate the dot product of every element with a single vector.
+    /// The output buffer must have space for size() values.
+    void dot(const Vector2d<T_ty> & rhs, T_ty * output) const;
+
+    /// Treating every element as a position, get the square of its distance to a single point.
+    /// The output buffer must have space for size() values.
+    void getSqDistances(const Vector2d<T_ty> & point, T_ty * output) const;
+
+    /// Treating every element as a position, check whether it is within a certain distance of a single point.
+    /// This gives the same results as calling Vector2d::isNear() on each element.
+    /// The output buffer must have space for size() values.
+    void isNear(const Vector2d<T_ty> & point, const T_ty dist, bool * output) const;
+
+
+private:
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+    /// Reallocate the lanes to hold exactly newCapacity elements.
+    /// Existing contents are kept if preserve is true. Otherwise the array is
+    ///  left empty, which avoids copying data that's about to be overwritten.
+    /// Throws std::length_error if the lanes would be too big to address, or
+    ///  std::bad_alloc if the allocation fails.
+    void reallocate(const std::size_t newCapacity, const bool preserve = true);
+
+    /// Throw std::invalid_argument if the other array is not the same size as this one.
+    void checkSize(const Vector2dArray<T_ty> & rhs) const;
+
+
+//------------------------------------------------------------------------------
+// Data.
+
+    /// Lane of x components.
+    T_ty * m_x;
+
+    /// Lane of y components.
+    T_ty * m_y;
+
+    /// Number of elements in use.
+    std::size_t m_size;
+
+    /// Number of elements allocated.
+    std::size_t m_capacity;
+};
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Vector2dArray_h
@@ -0,0 +1,612 @@
+#ifndef ail_math_Vector2dArray_inl
+#define ail_math_Vector2dArray_inl
+
+/** \file Vector2dArray.inl
+    \brief Implementation for a structure-of-arrays container of 2d cartesian vectors (see Vector2dArray.h).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cmath>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Vector2dArray.h"
+#include "Vector2d.h"
+#include "Vector2d.inl"
+#include "Vector2dKernels.h"
+#include "Aligned.h"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+//------------------------------------------------------------------------------
+// Reference proxy.
+
+template <typename T_ty>
+Vector2dArray<T_ty>::Reference::Reference(T_ty & x, T_ty & y) :
+    x(x), y(y)
+{
+}
+
+template <typename T_ty>
+typename Vector2dArray<T_ty>::Reference & Vector2dArray<T_ty>::Reference::operator = (const Vector2d<T_ty> & rhs)
+{
+    x = rhs.x;
+    y = rhs.y;
+    return *this;
+}
+
+template <typename T_ty>
+typename Vector2dArray<T_ty>::Reference & Vector2dArray<T_ty>::Reference::operator = (const Reference & rhs)
+{
+    x = rhs.x;
+    y = rhs.y;
+    return *this;
+}
+
+template <typename T_ty>
+typename Vector2dArray<T_ty>::Reference & Vector2dArray<T_ty>::Reference::operator += (const Vector2d<T_ty> & rhs)
+{
+    x += rhs.x;
+    y += rhs.y;
+    return *this;
+}
+
+template <typename T_ty>
+typename Vector2dArray<T_ty>::Reference & Vector2dArray<T_ty>::Reference::operator -= (const Vector2d<T_ty> & rhs)
+{
+    x -= rhs.x;
+    y -= rhs.y;
+    return *this;
+}
+
+template <typename T_ty>
+typename Vector2dArray<T_ty>::Reference & Vector2dArray<T_ty>::Reference::operator *= (const T_ty rhs)
+{
+    x *= rhs;
+    y *= rhs;
+    return *this;
+}
+
+template <typename T_ty>
+typename Vector2dArray<T_ty>::Reference & Vector2dArray<T_ty>::Reference::operator /= (const T_ty rhs)
+{
+    assert(rhs != 0);
+    x /= rhs;
+    y /= rhs;
+    return *this;
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty>::Reference::operator Vector2d<T_ty>() const
+{
+    return Vector2d<T_ty>(x, y);
+}
+
+template <typename T_ty>
+Vector2d<T_ty> Vector2dArray<T_ty>::Reference::get() const
+{
+    return Vector2d<T_ty>(x, y);
+}
+
+//------------------------------------------------------------------------------
+// Iterators.
+
+template <typename T_ty>
+Vector2dArray<T_ty>::Iterator::Iterator(Vector2dArray<T_ty> & arr, const std::size_t index) :
+    m_array(&arr), m_index(index)
+{
+}
+
+template <typename T_ty>
+typename Vector2dArray<T_ty>::Reference Vector2dArray<T_ty>::Iterator::operator * () const
+{
+    return (*m_array)[m_index];
+}
+
+template <typename T_ty>
+typename Vector2dArray<T_ty>::Iterator & Vector2dArray<T_ty>::Iterator::operator ++ ()
+{
+    ++m_index;
+    return *this;
+}
+
+template <typename T_ty>
+bool Vector2dArray<T_ty>::Iterator::operator == (const Iterator & rhs) const
+{
+    return m_array == rhs.m_array && m_index == rhs.m_index;
+}
+
+template <typename T_ty>
+bool Vector2dArray<T_ty>::Iterator::operator != (const Iterator & rhs) const
+{
+    return !(*this == rhs);
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty>::ConstIterator::ConstIterator(const Vector2dArray<T_ty> & arr, const std::size_t index) :
+    m_array(&arr), m_index(index)
+{
+}
+
+template <typename T_ty>
+Vector2d<T_ty> Vector2dArray<T_ty>::ConstIterator::operator * () const
+{
+    return m_array->get(m_index);
+}
+
+template <typename T_ty>
+typename Vector2dArray<T_ty>::ConstIterator & Vector2dArray<T_ty>::ConstIterator::operator ++ ()
+{
+    ++m_index;
+    return *this;
+}
+
+template <typename T_ty>
+bool Vector2dArray<T_ty>::ConstIterator::operator == (const ConstIterator & rhs) const
+{
+    return m_array == rhs.m_array && m_index == rhs.m_index;
+}
+
+template <typename T_ty>
+bool Vector2dArray<T_ty>::ConstIterator::operator != (const ConstIterator & rhs) const
+{
+    return !(*this == rhs);
+}
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+template <typename T_ty>
+Vector2dArray<T_ty>::Vector2dArray() :
+    m_x(nullptr), m_y(nullptr), m_size(0), m_capacity(0)
+{
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty>::Vector2dArray(const std::size_t count) :
+    Vector2dArray()
+{
+    resize(count);
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty>::Vector2dArray(const std::size_t count, const Vector2d<T_ty> & value) :
+    Vector2dArray()
+{
+    reallocate(count);
+    m_size = count;
+    for (std::size_t i = 0; i < count; ++i) {
+        m_x[i] = value.x;
+        m_y[i] = value.y;
+    }
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty>::Vector2dArray(std::initializer_list<Vector2d<T_ty>> args) :
+    Vector2dArray(args.begin(), args.size())
+{
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty>::Vector2dArray(const Vector2d<T_ty> * vectors, const std::size_t count) :
+    Vector2dArray()
+{
+    reallocate(count);
+    m_size = count;
+    for (std::size_t i = 0; i < count; ++i) {
+        m_x[i] = vectors[i].x;
+        m_y[i] = vectors[i].y;
+    }
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty>::Vector2dArray(const Vector2dArray<T_ty> & rhs) :
+    Vector2dArray()
+{
+    *this = rhs;
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty>::Vector2dArray(Vector2dArray<T_ty> && rhs) :
+    m_x(rhs.m_x), m_y(rhs.m_y), m_size(rhs.m_size), m_capacity(rhs.m_capacity)
+{
+    rhs.m_x = nullptr;
+    rhs.m_y = nullptr;
+    rhs.m_size = 0;
+    rhs.m_capacity = 0;
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty>::~Vector2dArray()
+{
+    alignedFree(m_x);
+    alignedFree(m_y);
+}
+
+//------------------------------------------------------------------------------
+// Operators.
+
+template <typename T_ty>
+Vector2dArray<T_ty> & Vector2dArray<T_ty>::operator = (const Vector2dArray<T_ty> & rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    // The old contents are about to be overwritten, so don't copy them across.
+    if (m_capacity < rhs.m_size)
+        reallocate(rhs.m_size, false);
+
+    if (rhs.m_size > 0) {
+        std::memcpy(m_x, rhs.m_x, rhs.m_size * sizeof(T_ty));
+        std::memcpy(m_y, rhs.m_y, rhs.m_size * sizeof(T_ty));
+    }
+    m_size = rhs.m_size;
+    return *this;
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty> & Vector2dArray<T_ty>::operator = (Vector2dArray<T_ty> && rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    alignedFree(m_x);
+    alignedFree(m_y);
+
+    m_x = rhs.m_x;
+    m_y = rhs.m_y;
+    m_size = rhs.m_size;
+    m_capacity = rhs.m_capacity;
+
+    rhs.m_x = nullptr;
+    rhs.m_y = nullptr;
+    rhs.m_size = 0;
+    rhs.m_capacity = 0;
+    return *this;
+}
+
+template <typename T_ty>
+bool Vector2dArray<T_ty>::operator == (const Vector2dArray<T_ty> & rhs) const
+{
+    if (m_size != rhs.m_size)
+        return false;
+
+    for (std::size_t i = 0; i < m_size; ++i) {
+        if (m_x[i] != rhs.m_x[i] || m_y[i] != rhs.m_y[i])
+            return false;
+    }
+    return true;
+}
+
+template <typename T_ty>
+bool Vector2dArray<T_ty>::operator != (const Vector2dArray<T_ty> & rhs) const
+{
+    return !(*this == rhs);
+}
+
+template <typename T_ty>
+typename Vector2dArray<T_ty>::Reference Vector2dArray<T_ty>::operator [] (const std::size_t index)
+{
+    assert(index < m_size);
+    return Reference(m_x[index], m_y[index]);
+}
+
+template <typename T_ty>
+Vector2d<T_ty> Vector2dArray<T_ty>::operator [] (const std::size_t index) const
+{
+    return get(index);
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty> & Vector2dArray<T_ty>::operator += (const Vector2dArray<T_ty> & rhs)
+{
+    checkSize(rhs);
+    const T_ty * rx = rhs.m_x;
+    const T_ty * ry = rhs.m_y;
+    for (std::size_t i = 0; i < m_size; ++i) {
+        m_x[i] += rx[i];
+        m_y[i] += ry[i];
+    }
+    return *this;
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty> & Vector2dArray<T_ty>::operator -= (const Vector2dArray<T_ty> & rhs)
+{
+    checkSize(rhs);
+    const T_ty * rx = rhs.m_x;
+    const T_ty * ry = rhs.m_y;
+    for (std::size_t i = 0; i < m_size; ++i) {
+        m_x[i] -= rx[i];
+        m_y[i] -= ry[i];
+    }
+    return *this;
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty> & Vector2dArray<T_ty>::operator += (const Vector2d<T_ty> & rhs)
+{
+    const T_ty rx = rhs.x;
+    const T_ty ry = rhs.y;
+    for (std::size_t i = 0; i < m_size; ++i) {
+        m_x[i] += rx;
+        m_y[i] += ry;
+    }
+    return *this;
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty> & Vector2dArray<T_ty>::operator -= (const Vector2d<T_ty> & rhs)
+{
+    const T_ty rx = rhs.x;
+    const T_ty ry = rhs.y;
+    for (std::size_t i = 0; i < m_size; ++i) {
+        m_x[i] -= rx;
+        m_y[i] -= ry;
+    }
+    return *this;
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty> & Vector2dArray<T_ty>::operator *= (const T_ty rhs)
+{
+    for (std::size_t i = 0; i < m_size; ++i) {
+        m_x[i] *= rhs;
+        m_y[i] *= rhs;
+    }
+    return *this;
+}
+
+template <typename T_ty>
+Vector2dArray<T_ty> & Vector2dArray<T_ty>::operator /= (const T_ty rhs)
+{
+    assert(rhs != 0);
+    for (std::size_t i = 0; i < m_size; ++i) {
+        m_x[i] /= rhs;
+        m_y[i] /= rhs;
+    }
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+// Size / storage.
+
+template <typename T_ty>
+std::size_t Vector2dArray<T_ty>::size() const
+{
+    return m_size;
+}
+
+template <typename T_ty>
+bool Vector2dArray<T_ty>::empty() const
+{
+    return m_size == 0;
+}
+
+template <typename T_ty>
+std::size_t Vector2dArray<T_ty>::capacity() const
+{
+    return m_capacity;
+}
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::reserve(const std::size_t count)
+{
+    if (count > m_capacity)
+        reallocate(count);
+}
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::resize(const std::size_t count)
+{
+    reserve(count);
+    for (std::size_t i = m_size; i < count; ++i) {
+        m_x[i] = T_ty(0);
+        m_y[i] = T_ty(0);
+    }
+    m_size = count;
+}
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::clear()
+{
+    m_size = 0;
+}
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::push_back(const Vector2d<T_ty> & value)
+{
+    if (m_size == m_capacity) {
+        // Doubling a huge capacity would wrap round, so it's reported as too big instead.
+        if (m_capacity > std::numeric_limits<std::size_t>::max() / (2 * sizeof(T_ty)))
+            throw std::length_error("Vector2dArray capacity is too large.");
+        reallocate(m_capacity < 8 ? 8 : m_capacity * 2);
+    }
+
+    m_x[m_size] = value.x;
+    m_y[m_size] = value.y;
+    ++m_size;
+}
+
+template <typename T_ty>
+T_ty * Vector2dArray<T_ty>::x()
+{
+    return m_x;
+}
+
+template <typename T_ty>
+const T_ty * Vector2dArray<T_ty>::x() const
+{
+    return m_x;
+}
+
+template <typename T_ty>
+T_ty * Vector2dArray<T_ty>::y()
+{
+    return m_y;
+}
+
+template <typename T_ty>
+const T_ty * Vector2dArray<T_ty>::y() const
+{
+    return m_y;
+}
+
+//------------------------------------------------------------------------------
+// Element access.
+
+template <typename T_ty>
+Vector2d<T_ty> Vector2dArray<T_ty>::get(const std::size_t index) const
+{
+    assert(index < m_size);
+    return Vector2d<T_ty>(m_x[index], m_y[index]);
+}
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::set(const std::size_t index, const Vector2d<T_ty> & value)
+{
+    assert(index < m_size);
+    m_x[index] = value.x;
+    m_y[index] = value.y;
+}
+
+template <typename T_ty>
+typename Vector2dArray<T_ty>::Iterator Vector2dArray<T_ty>::begin()
+{
+    return Iterator(*this, 0);
+}
+
+template <typename T_ty>
+typename Vector2dArray<T_ty>::Iterator Vector2dArray<T_ty>::end()
+{
+    return Iterator(*this, m_size);
+}
+
+template <typename T_ty>
+typename Vector2dArray<T_ty>::ConstIterator Vector2dArray<T_ty>::begin() const
+{
+    return ConstIterator(*this, 0);
+}
+
+template <typename T_ty>
+typename Vector2dArray<T_ty>::ConstIterator Vector2dArray<T_ty>::end() const
+{
+    return ConstIterator(*this, m_size);
+}
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::copyTo(Vector2d<T_ty> * output) const
+{
+    for (std::size_t i = 0; i < m_size; ++i) {
+        output[i].x = m_x[i];
+        output[i].y = m_y[i];
+    }
+}
+
+//------------------------------------------------------------------------------
+// Batch operations.
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::normalise()
+{
+    kernels::normalise(m_x, m_y, m_size);
+}
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::getLengths(T_ty * output) const
+{
+    for (std::size_t i = 0; i < m_size; ++i)
+        output[i] = vector2d::length(m_x[i], m_y[i], std::is_integral<T_ty>());
+}
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::getSqLengths(T_ty * output) const
+{
+    for (std::size_t i = 0; i < m_size; ++i)
+        output[i] = (m_x[i] * m_x[i]) + (m_y[i] * m_y[i]);
+}
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::dot(const Vector2dArray<T_ty> & rhs, T_ty * output) const
+{
+    checkSize(rhs);
+    kernels::dot(m_x, m_y, rhs.m_x, rhs.m_y, output, m_size);
+}
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::dot(const Vector2d<T_ty> & rhs, T_ty * output) const
+{
+    for (std::size_t i = 0; i < m_size; ++i)
+        output[i] = (m_x[i] * rhs.x) + (m_y[i] * rhs.y);
+}
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::getSqDistances(const Vector2d<T_ty> & point, T_ty * output) const
+{
+    kernels::sqDistance(m_x, m_y, point.x, point.y, output, m_size);
+}
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::isNear(const Vector2d<T_ty> & point, const T_ty dist, bool * output) const
+{
+    kernels::isNear(m_x, m_y, point.x, point.y, dist, output, m_size);
+}
+
+//------------------------------------------------------------------------------
+// Internal helpers.
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::reallocate(const std::size_t newCapacity, const bool preserve)
+{
+    if (newCapacity > std::numeric_limits<std::size_t>::max() / sizeof(T_ty))
+        throw std::length_error("Vector2dArray capacity is too large.");
+
+    T_ty * newX = nullptr;
+    T_ty * newY = nullptr;
+
+    if (newCapacity > 0) {
+        newX = static_cast<T_ty *>(alignedAlloc(newCapacity * sizeof(T_ty)));
+        try {
+            newY = static_cast<T_ty *>(alignedAlloc(newCapacity * sizeof(T_ty)));
+        } catch (...) {
+            alignedFree(newX);
+            throw;
+        }
+    }
+
+    const std::size_t keep = !preserve ? 0 : ((m_size < newCapacity) ? m_size : newCapacity);
+    if (keep > 0) {
+        std::memcpy(newX, m_x, keep * sizeof(T_ty));
+        std::memcpy(newY, m_y, keep * sizeof(T_ty));
+    }
+
+    alignedFree(m_x);
+    alignedFree(m_y);
+    m_x = newX;
+    m_y = newY;
+    m_size = keep;
+    m_capacity = newCapacity;
+}
+
+template <typename T_ty>
+void Vector2dArray<T_ty>::checkSize(const Vector2dArray<T_ty> & rhs) const
+{
+    if (rhs.m_size != m_size)
+        throw std::invalid_argument("Vector2dArray sizes do not match.");
+}
+
+//--------------
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Vector2dArray_inl
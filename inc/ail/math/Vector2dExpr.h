@@ -0,0 +1,367 @@
+#ifndef ail_math_Vector2dExpr_h
+#define ail_math_Vector2dExpr_h
+
+/** \file Vector2dExpr.h
+    \brief Optional expression templates which fuse chains of Vector2d arithmetic.
+
+    The global Vector2d operators each return a new vector. In a long chain such
+     as a + b * s - c, every step makes a temporary. The optimiser usually
+     removes these for built-in types, but not always for user numeric types,
+     and never across a whole buffer of vectors.
+
+    Wrapping an operand with expr::lazy() builds an expression object instead.
+     Nothing is calculated until the expression is evaluated, and then each
+     component is computed in a single pass with no intermediate vectors:
+
+        Vector2d<float> r = expr::eval(expr::lazy(a) + expr::lazy(b) * s - c);
+
+    Once one operand is an expression, plain vectors and buffers can be mixed
+     in directly. Note that b * s on its own would use the normal operator.
+
+    Operands can also be contiguous buffers of vectors (std::vector<Vector2d>).
+     The whole chain is then applied element by element in one loop. Single
+     vectors and scalars are broadcast to every element:
+
+        expr::assign(positions, expr::lazy(positions) + expr::lazy(velocities) * dt + offset);
+
+    The output buffer may be one of the operands, because each element of the
+     result only depends on the same element of each operand.
+
+    Expressions refer to their vector and buffer operands rather than copying
+     them, so they should be evaluated in the same statement that creates them.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "Vector2d.h"
+
+//--------------
+namespace ail {
+namespace math {
+namespace expr {
+//--------------
+
+/// Size reported by expressions which don't contain any buffers.
+/// These have the same value at every index, so they can be broadcast.
+const std::size_t broadcast = std::numeric_limits<std::size_t>::max();
+
+/// Combine the sizes of two operands, allowing for broadcasting.
+/// Throws std::invalid_argument if two buffers have different sizes.
+inline std::size_t combineSizes(const std::size_t lhs, const std::size_t rhs)
+{
+    if (lhs == broadcast)
+        return rhs;
+    if (rhs != broadcast && rhs != lhs)
+        throw std::invalid_argument("Buffers in a Vector2d expression have different sizes.");
+    return lhs;
+}
+
+/// Prevents a template parameter being deduced from a function argument.
+/// This lets scalars of other types be converted, e.g. lazy(floatVec) * 2.
+template <typename T_ty>
+struct NonDeduced
+{
+    typedef T_ty type;
+};
+
+/// Base class of all expression types (using CRTP).
+/// T_ty is the numerical type of the result, and T_derived is the actual expression type.
+/// Every expression provides x(index), y(index) and size(). The leaves return
+///  references to their operands, so components are only copied when they're used.
+template <typename T_ty, typename T_derived>
+class Expression
+{
+public:
+    /// The numerical type of the expression's result.
+    typedef T_ty value_type;
+
+    /// Get the actual expression object.
+    const T_derived & derived() const
+    {
+        return static_cast<const T_derived &>(*this);
+    }
+};
+
+/// Leaf expression referring to a single vector.
+template <typename T_ty>
+class VectorRef : public Expression<T_ty, VectorRef<T_ty>>
+{
+public:
+    /// Constructor - refers to the given vector, which must outlive the expression.
+    explicit VectorRef(const Vector2d<T_ty> & vec) : m_vec(vec) {}
+
+    const T_ty & x(const std::size_t) const { return m_vec.x; }
+    const T_ty & y(const std::size_t) const { return m_vec.y; }
+    std::size_t size() const { return broadcast; }
+
+private:
+    const Vector2d<T_ty> & m_vec;
+};
+
+/// Leaf expression referring to a contiguous buffer of vectors.
+template <typename T_ty>
+class BufferRef : public Expression<T_ty, BufferRef<T_ty>>
+{
+public:
+    /// Constructor - refers to the given buffer, which must outlive the expression.
+    BufferRef(const Vector2d<T_ty> * data, const std::size_t count) : m_data(data), m_count(count) {}
+
+    const T_ty & x(const std::size_t index) const { return m_data[index].x; }
+    const T_ty & y(const std::size_t index) const { return m_data[index].y; }
+    std::size_t size() const { return m_count; }
+
+private:
+    const Vector2d<T_ty> * m_data;
+    std::size_t m_count;
+};
+
+/// Adds two expressions.
+template <typename T_ty, typename T_lhs, typename T_rhs>
+class Sum : public Expression<T_ty, Sum<T_ty, T_lhs, T_rhs>>
+{
+public:
+    Sum(const T_lhs & lhs, const T_rhs & rhs) : m_lhs(lhs), m_rhs(rhs) {}
+
+    T_ty x(const std::size_t index) const { return m_lhs.x(index) + m_rhs.x(index); }
+    T_ty y(const std::size_t index) const { return m_lhs.y(index) + m_rhs.y(index); }
+    std::size_t size() const { return combineSizes(m_lhs.size(), m_rhs.size()); }
+
+private:
+    T_lhs m_lhs;
+    T_rhs m_rhs;
+};
+
+/// Subtracts one expression (rhs) from another (lhs).
+template <typename T_ty, typename T_lhs, typename T_rhs>
+class Difference : public Expression<T_ty, Difference<T_ty, T_lhs, T_rhs>>
+{
+public:
+    Difference(const T_lhs & lhs, const T_rhs & rhs) : m_lhs(lhs), m_rhs(rhs) {}
+
+    T_ty x(const std::size_t index) const { return m_lhs.x(index) - m_rhs.x(index); }
+    T_ty y(const std::size_t index) const { return m_lhs.y(index) - m_rhs.y(index); }
+    std::size_t size() const { return combineSizes(m_lhs.size(), m_rhs.size()); }
+
+private:
+    T_lhs m_lhs;
+    T_rhs m_rhs;
+};
+
+/// Multiplies an expression by a scalar.
+template <typename T_ty, typename T_expr>
+class Product : public Expression<T_ty, Product<T_ty, T_expr>>
+{
+public:
+    Product(const T_expr & expr, const T_ty scalar) : m_expr(expr), m_scalar(scalar) {}
+
+    T_ty x(const std::size_t index) const { return m_expr.x(index) * m_scalar; }
+    T_ty y(const std::size_t index) const { return m_expr.y(index) * m_scalar; }
+    std::size_t size() const { return m_expr.size(); }
+
+private:
+    T_expr m_expr;
+    T_ty m_scalar;
+};
+
+/// Divides an expression by a scalar.
+template <typename T_ty, typename T_expr>
+class Quotient : public Expression<T_ty, Quotient<T_ty, T_expr>>
+{
+public:
+    Quotient(const T_expr & expr, const T_ty scalar) : m_expr(expr), m_scalar(scalar)
+    {
+        assert(scalar != 0);
+    }
+
+    T_ty x(const std::size_t index) const { return m_expr.x(index) / m_scalar; }
+    T_ty y(const std::size_t index) const { return m_expr.y(index) / m_scalar; }
+    std::size_t size() const { return m_expr.size(); }
+
+private:
+    T_expr m_expr;
+    T_ty m_scalar;
+};
+
+/// Negates an expression.
+template <typename T_ty, typename T_expr>
+class Negation : public Expression<T_ty, Negation<T_ty, T_expr>>
+{
+public:
+    explicit Negation(const T_expr & expr) : m_expr(expr) {}
+
+    T_ty x(const std::size_t index) const { return -m_expr.x(index); }
+    T_ty y(const std::size_t index) const { return -m_expr.y(index); }
+    std::size_t size() const { return m_expr.size(); }
+
+private:
+    T_expr m_expr;
+};
+
+
+//------------------------------------------------------------------------------
+// Creating expressions.
+
+/// Start an expression from a single vector.
+template <typename T_ty>
+inline VectorRef<T_ty> lazy(const Vector2d<T_ty> & vec)
+{
+    return VectorRef<T_ty>(vec);
+}
+
+/// Start an expression from a buffer of vectors.
+template <typename T_ty, typename T_alloc>
+inline BufferRef<T_ty> lazy(const std::vector<Vector2d<T_ty>, T_alloc> & buffer)
+{
+    return BufferRef<T_ty>(buffer.data(), buffer.size());
+}
+
+/// Start an expression from a contiguous buffer of vectors.
+template <typename T_ty>
+inline BufferRef<T_ty> lazy(const Vector2d<T_ty> * data, const std::size_t count)
+{
+    return BufferRef<T_ty>(data, count);
+}
+
+
+//------------------------------------------------------------------------------
+// Operators.
+// These only apply if at least one operand is already an expression, so the
+//  normal Vector2d operators are unaffected. The other operand can also be a
+//  vector or a buffer, which is wrapped automatically.
+
+template <typename T_ty, typename T_lhs, typename T_rhs>
+inline Sum<T_ty, T_lhs, T_rhs> operator + (const Expression<T_ty, T_lhs> & lhs, const Expression<T_ty, T_rhs> & rhs)
+{
+    return Sum<T_ty, T_lhs, T_rhs>(lhs.derived(), rhs.derived());
+}
+
+template <typename T_ty, typename T_lhs>
+inline Sum<T_ty, T_lhs, VectorRef<T_ty>> operator + (const Expression<T_ty, T_lhs> & lhs, const Vector2d<T_ty> & rhs)
+{
+    return lhs + lazy(rhs);
+}
+
+template <typename T_ty, typename T_rhs>
+inline Sum<T_ty, VectorRef<T_ty>, T_rhs> operator + (const Vector2d<T_ty> & lhs, const Expression<T_ty, T_rhs> & rhs)
+{
+    return lazy(lhs) + rhs;
+}
+
+template <typename T_ty, typename T_alloc, typename T_lhs>
+inline Sum<T_ty, T_lhs, BufferRef<T_ty>> operator + (const Expression<T_ty, T_lhs> & lhs, const std::vector<Vector2d<T_ty>, T_alloc> & rhs)
+{
+    return lhs + lazy(rhs);
+}
+
+template <typename T_ty, typename T_alloc, typename T_rhs>
+inline Sum<T_ty, BufferRef<T_ty>, T_rhs> operator + (const std::vector<Vector2d<T_ty>, T_alloc> & lhs, const Expression<T_ty, T_rhs> & rhs)
+{
+    return lazy(lhs) + rhs;
+}
+
+template <typename T_ty, typename T_lhs, typename T_rhs>
+inline Difference<T_ty, T_lhs, T_rhs> operator - (const Expression<T_ty, T_lhs> & lhs, const Expression<T_ty, T_rhs> & rhs)
+{
+    return Difference<T_ty, T_lhs, T_rhs>(lhs.derived(), rhs.derived());
+}
+
+template <typename T_ty, typename T_lhs>
+inline Difference<T_ty, T_lhs, VectorRef<T_ty>> operator - (const Expression<T_ty, T_lhs> & lhs, const Vector2d<T_ty> & rhs)
+{
+    return lhs - lazy(rhs);
+}
+
+template <typename T_ty, typename T_rhs>
+inline Difference<T_ty, VectorRef<T_ty>, T_rhs> operator - (const Vector2d<T_ty> & lhs, const Expression<T_ty, T_rhs> & rhs)
+{
+    return lazy(lhs) - rhs;
+}
+
+template <typename T_ty, typename T_alloc, typename T_lhs>
+inline Difference<T_ty, T_lhs, BufferRef<T_ty>> operator - (const Expression<T_ty, T_lhs> & lhs, const std::vector<Vector2d<T_ty>, T_alloc> & rhs)
+{
+    return lhs - lazy(rhs);
+}
+
+template <typename T_ty, typename T_alloc, typename T_rhs>
+inline Difference<T_ty, BufferRef<T_ty>, T_rhs> operator - (const std::vector<Vector2d<T_ty>, T_alloc> & lhs, const Expression<T_ty, T_rhs> & rhs)
+{
+    return lazy(lhs) - rhs;
+}
+
+template <typename T_ty, typename T_expr>
+inline Product<T_ty, T_expr> operator * (const Expression<T_ty, T_expr> & lhs, const typename NonDeduced<T_ty>::type & rhs)
+{
+    return Product<T_ty, T_expr>(lhs.derived(), rhs);
+}
+
+template <typename T_ty, typename T_expr>
+inline Product<T_ty, T_expr> operator * (const typename NonDeduced<T_ty>::type & lhs, const Expression<T_ty, T_expr> & rhs)
+{
+    return Product<T_ty, T_expr>(rhs.derived(), lhs);
+}
+
+template <typename T_ty, typename T_expr>
+inline Quotient<T_ty, T_expr> operator / (const Expression<T_ty, T_expr> & lhs, const typename NonDeduced<T_ty>::type & rhs)
+{
+    return Quotient<T_ty, T_expr>(lhs.derived(), rhs);
+}
+
+template <typename T_ty, typename T_expr>
+inline Negation<T_ty, T_expr> operator - (const Expression<T_ty, T_expr> & expr)
+{
+    return Negation<T_ty, T_expr>(expr.derived());
+}
+
+
+//------------------------------------------------------------------------------
+// Evaluation.
+
+/// Evaluate an expression which doesn't contain any buffers.
+template <typename T_ty, typename T_expr>
+inline Vector2d<T_ty> eval(const Expression<T_ty, T_expr> & expr)
+{
+    const T_expr & e = expr.derived();
+    assert(e.size() == broadcast);
+    return Vector2d<T_ty>(e.x(0), e.y(0));
+}
+
+/// Evaluate an expression into a buffer of vectors, in a single pass.
+/// The buffer is resized to match the buffers in the expression. If the expression
+///  doesn't contain any buffers then every existing element is set to its value.
+/// The buffer can safely be one of the expression's operands.
+/// Throws std::invalid_argument if the expression contains buffers of different sizes.
+template <typename T_ty, typename T_alloc, typename T_expr>
+inline void assign(std::vector<Vector2d<T_ty>, T_alloc> & output, const Expression<T_ty, T_expr> & expr)
+{
+    const T_expr & e = expr.derived();
+    const std::size_t count = e.size();
+    if (count != broadcast)
+        output.resize(count);
+
+    Vector2d<T_ty> * out = output.data();
+    const std::size_t n = output.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        // Calculate both components before writing, in case the output is also an operand.
+        const T_ty x = e.x(i);
+        const T_ty y = e.y(i);
+        out[i].x = x;
+        out[i].y = y;
+    }
+}
+
+//--------------
+} // expr
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Vector2dExpr_h
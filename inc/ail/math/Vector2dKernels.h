@@ -0,0 +1,381 @@
+#ifndef ail_math_Vector2dKernels_h
+#define ail_math_Vector2dKernels_h
+
+/** \file Vector2dKernels.h
+    \brief Batch kernels for 2d vector maths over structure-of-arrays data, with runtime SIMD dispatch.
+
+    Each kernel operates on separate x and y lanes (e.g. from Vector2dArray),
+     or on separate lanes of box corners (e.g. from Aabb2dArray). The bounds
+     kernel also has a version for plain arrays of Vector2d.
+    The generic templates are scalar reference implementations which produce
+     exactly the same results as the equivalent Vector2d member functions.
+    The float and double overloads dispatch at runtime to an SSE2, AVX2 or
+     AVX-512 implementation depending on getSimdLevel() (see Simd.h), falling
+     back to the scalar reference where SIMD isn't available (including ARM).
+    The SIMD paths are written once in Vector2dKernelsImpl.inl, using the
+     intrinsic wrappers from SimdOps.h. They do the arithmetic in the same order
+     as the scalar paths, so results are bit-identical as long as the compiler
+     isn't allowed to contract multiplies and adds into fused operations
+     (e.g. -ffp-contract=fast).
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include "SimdOps.h"
+#include "Vector2d.h"
+#include "Vector2d.inl"
+
+//--------------
+namespace ail {
+namespace math {
+namespace kernels {
+//--------------
+
+//------------------------------------------------------------------------------
+// Scalar reference kernels.
+
+namespace scalar {
+
+/// Normalise each vector in place. Zero length vectors are left unchanged.
+/// Equivalent to calling Vector2d::normalise() on each element.
+template <typename T_ty>
+void normalise(T_ty * x, T_ty * y, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        vector2d::normalise(x[i], y[i], std::is_integral<T_ty>());
+}
+
+/// Calculate the dot product of corresponding pairs of vectors.
+/// Equivalent to calling Vector2d::dot() on each pair.
+template <typename T_ty>
+void dot(const T_ty * ax, const T_ty * ay, const T_ty * bx, const T_ty * by, T_ty * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = (ax[i] * bx[i]) + (ay[i] * by[i]);
+}
+
+/// Calculate the squared distance between corresponding pairs of positions.
+/// Equivalent to calling Vector2d::getSqDistance() on each pair.
+template <typename T_ty>
+void sqDistance(const T_ty * ax, const T_ty * ay, const T_ty * bx, const T_ty * by, T_ty * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const T_ty dx = ax[i] - bx[i];
+        const T_ty dy = ay[i] - by[i];
+        output[i] = (dx * dx) + (dy * dy);
+    }
+}
+
+/// Calculate the squared distance between each position and a single point.
+/// Equivalent to calling Vector2d::getSqDistance() on each element.
+template <typename T_ty>
+void sqDistance(const T_ty * ax, const T_ty * ay, const T_ty px, const T_ty py, T_ty * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const T_ty dx = ax[i] - px;
+        const T_ty dy = ay[i] - py;
+        output[i] = (dx * dx) + (dy * dy);
+    }
+}
+
+/// Check whether each pair of positions is within the given distance.
+/// Equivalent to calling Vector2d::isNear() on each pair.
+template <typename T_ty>
+void isNear(const T_ty * ax, const T_ty * ay, const T_ty * bx, const T_ty * by, const T_ty dist, bool * output, const std::size_t count)
+{
+    const T_ty limit = dist * dist;
+    for (std::size_t i = 0; i < count; ++i) {
+        const T_ty dx = ax[i] - bx[i];
+        const T_ty dy = ay[i] - by[i];
+        output[i] = ((dx * dx) + (dy * dy)) <= limit;
+    }
+}
+
+/// Check whether each position is within the given distance of a single point.
+/// Equivalent to calling Vector2d::isNear() on each element.
+template <typename T_ty>
+void isNear(const T_ty * ax, const T_ty * ay, const T_ty px, const T_ty py, const T_ty dist, bool * output, const std::size_t count)
+{
+    const T_ty limit = dist * dist;
+    for (std::size_t i = 0; i < count; ++i) {
+        const T_ty dx = ax[i] - px;
+        const T_ty dy = ay[i] - py;
+        output[i] = ((dx * dx) + (dy * dy)) <= limit;
+    }
+}
+
+/// Check whether each box intersects a single query box, including if they just touch.
+/// Each box is given by its minimum and maximum corners, as in Aabb2d.
+/// Equivalent to calling Aabb2d::intersects() on each box.
+template <typename T_ty>
+void intersects(const T_ty * minX, const T_ty * minY, const T_ty * maxX, const T_ty * maxY,
+    const T_ty qMinX, const T_ty qMinY, const T_ty qMaxX, const T_ty qMaxY, bool * output, const std::size_t count)
+{
+    const bool queryValid = (qMinX <= qMaxX) & (qMinY <= qMaxY);
+    for (std::size_t i = 0; i < count; ++i) {
+        output[i] =
+            (minX[i] <= qMaxX) & (minY[i] <= qMaxY) &
+            (qMinX <= maxX[i]) & (qMinY <= maxY[i]) &
+            (minX[i] <= maxX[i]) & (minY[i] <= maxY[i]) &
+            queryValid;
+    }
+}
+
+/// Expand a pair of box corners to include each position.
+/// minCorner and maxCorner are updated in place, so they should start out as
+///  the first position (or the corners of an existing box). Each component is
+///  updated with (p < min) ? p : min and (p > max) ? p : max. The SIMD versions
+///  compare the positions in a different order, so coordinates mustn't be NaN,
+///  and a zero corner may have either sign if both -0 and +0 are present.
+template <typename T_ty>
+void expandBounds(const T_ty * x, const T_ty * y, const std::size_t count, Vector2d<T_ty> & minCorner, Vector2d<T_ty> & maxCorner)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        minCorner.x = (x[i] < minCorner.x) ? x[i] : minCorner.x;
+        minCorner.y = (y[i] < minCorner.y) ? y[i] : minCorner.y;
+        maxCorner.x = (x[i] > maxCorner.x) ? x[i] : maxCorner.x;
+        maxCorner.y = (y[i] > maxCorner.y) ? y[i] : maxCorner.y;
+    }
+}
+
+/// Expand a pair of box corners to include each position in an array of vectors.
+/// See the structure-of-arrays version above.
+template <typename T_ty>
+void expandBounds(const Vector2d<T_ty> * points, const std::size_t count, Vector2d<T_ty> & minCorner, Vector2d<T_ty> & maxCorner)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const Vector2d<T_ty> & p = points[i];
+        minCorner.x = (p.x < minCorner.x) ? p.x : minCorner.x;
+        minCorner.y = (p.y < minCorner.y) ? p.y : minCorner.y;
+        maxCorner.x = (p.x > maxCorner.x) ? p.x : maxCorner.x;
+        maxCorner.y = (p.y > maxCorner.y) ? p.y : maxCorner.y;
+    }
+}
+
+} // scalar
+
+#if defined(AIL_MATH_SIMD_X86)
+
+//------------------------------------------------------------------------------
+// SIMD kernels. The bodies are shared by every instruction set.
+
+AIL_MATH_SIMD_TARGET_BEGIN("sse2")
+namespace sse2 {
+#include "Vector2dKernelsImpl.inl"
+} // sse2
+AIL_MATH_SIMD_TARGET_END
+
+AIL_MATH_SIMD_TARGET_BEGIN("avx2")
+namespace avx2 {
+#include "Vector2dKernelsImpl.inl"
+} // avx2
+AIL_MATH_SIMD_TARGET_END
+
+#if defined(AIL_MATH_SIMD_AVX512)
+AIL_MATH_SIMD_TARGET_BEGIN("avx512f")
+namespace avx512 {
+#include "Vector2dKernelsImpl.inl"
+} // avx512
+AIL_MATH_SIMD_TARGET_END
+#endif // AIL_MATH_SIMD_AVX512
+
+#endif // AIL_MATH_SIMD_X86
+
+//------------------------------------------------------------------------------
+// Dispatching kernels.
+
+/// Normalise each vector in place. Zero length vectors are left unchanged.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void normalise(T_ty * x, T_ty * y, const std::size_t count)
+{
+    scalar::normalise(x, y, count);
+}
+
+/// Normalise each vector in place. Zero length vectors are left unchanged.
+inline void normalise(float * x, float * y, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(normalise, float, (x, y, count))
+}
+
+/// Normalise each vector in place. Zero length vectors are left unchanged.
+inline void normalise(double * x, double * y, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(normalise, double, (x, y, count))
+}
+
+/// Calculate the dot product of corresponding pairs of vectors.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void dot(const T_ty * ax, const T_ty * ay, const T_ty * bx, const T_ty * by, T_ty * output, const std::size_t count)
+{
+    scalar::dot(ax, ay, bx, by, output, count);
+}
+
+/// Calculate the dot product of corresponding pairs of vectors.
+inline void dot(const float * ax, const float * ay, const float * bx, const float * by, float * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(dot, float, (ax, ay, bx, by, output, count))
+}
+
+/// Calculate the dot product of corresponding pairs of vectors.
+inline void dot(const double * ax, const double * ay, const double * bx, const double * by, double * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(dot, double, (ax, ay, bx, by, output, count))
+}
+
+/// Calculate the squared distance between corresponding pairs of positions.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void sqDistance(const T_ty * ax, const T_ty * ay, const T_ty * bx, const T_ty * by, T_ty * output, const std::size_t count)
+{
+    scalar::sqDistance(ax, ay, bx, by, output, count);
+}
+
+/// Calculate the squared distance between corresponding pairs of positions.
+inline void sqDistance(const float * ax, const float * ay, const float * bx, const float * by, float * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(sqDistance, float, (ax, ay, bx, by, output, count))
+}
+
+/// Calculate the squared distance between corresponding pairs of positions.
+inline void sqDistance(const double * ax, const double * ay, const double * bx, const double * by, double * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(sqDistance, double, (ax, ay, bx, by, output, count))
+}
+
+/// Calculate the squared distance between each position and a single point.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void sqDistance(const T_ty * ax, const T_ty * ay, const T_ty px, const T_ty py, T_ty * output, const std::size_t count)
+{
+    scalar::sqDistance(ax, ay, px, py, output, count);
+}
+
+/// Calculate the squared distance between each position and a single point.
+inline void sqDistance(const float * ax, const float * ay, const float px, const float py, float * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(sqDistance, float, (ax, ay, px, py, output, count))
+}
+
+/// Calculate the squared distance between each position and a single point.
+inline void sqDistance(const double * ax, const double * ay, const double px, const double py, double * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(sqDistance, double, (ax, ay, px, py, output, count))
+}
+
+/// Check whether each pair of positions is within the given distance.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void isNear(const T_ty * ax, const T_ty * ay, const T_ty * bx, const T_ty * by, const T_ty dist, bool * output, const std::size_t count)
+{
+    scalar::isNear(ax, ay, bx, by, dist, output, count);
+}
+
+/// Check whether each pair of positions is within the given distance.
+inline void isNear(const float * ax, const float * ay, const float * bx, const float * by, const float dist, bool * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(isNear, float, (ax, ay, bx, by, dist, output, count))
+}
+
+/// Check whether each pair of positions is within the given distance.
+inline void isNear(const double * ax, const double * ay, const double * bx, const double * by, const double dist, bool * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(isNear, double, (ax, ay, bx, by, dist, output, count))
+}
+
+/// Check whether each position is within the given distance of a single point.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void isNear(const T_ty * ax, const T_ty * ay, const T_ty px, const T_ty py, const T_ty dist, bool * output, const std::size_t count)
+{
+    scalar::isNear(ax, ay, px, py, dist, output, count);
+}
+
+/// Check whether each position is within the given distance of a single point.
+inline void isNear(const float * ax, const float * ay, const float px, const float py, const float dist, bool * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(isNear, float, (ax, ay, px, py, dist, output, count))
+}
+
+/// Check whether each position is within the given distance of a single point.
+inline void isNear(const double * ax, const double * ay, const double px, const double py, const double dist, bool * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(isNear, double, (ax, ay, px, py, dist, output, count))
+}
+
+/// Check whether each box intersects a single query box, including if they just touch.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void intersects(const T_ty * minX, const T_ty * minY, const T_ty * maxX, const T_ty * maxY,
+    const T_ty qMinX, const T_ty qMinY, const T_ty qMaxX, const T_ty qMaxY, bool * output, const std::size_t count)
+{
+    scalar::intersects(minX, minY, maxX, maxY, qMinX, qMinY, qMaxX, qMaxY, output, count);
+}
+
+/// Check whether each box intersects a single query box, including if they just touch.
+inline void intersects(const float * minX, const float * minY, const float * maxX, const float * maxY,
+    const float qMinX, const float qMinY, const float qMaxX, const float qMaxY, bool * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(intersects, float, (minX, minY, maxX, maxY, qMinX, qMinY, qMaxX, qMaxY, output, count))
+}
+
+/// Check whether each box intersects a single query box, including if they just touch.
+inline void intersects(const double * minX, const double * minY, const double * maxX, const double * maxY,
+    const double qMinX, const double qMinY, const double qMaxX, const double qMaxY, bool * output, const std::size_t count)
+{
+    AIL_MATH_KERNEL_DISPATCH(intersects, double, (minX, minY, maxX, maxY, qMinX, qMinY, qMaxX, qMaxY, output, count))
+}
+
+/// Expand a pair of box corners to include each position.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void expandBounds(const T_ty * x, const T_ty * y, const std::size_t count, Vector2d<T_ty> & minCorner, Vector2d<T_ty> & maxCorner)
+{
+    scalar::expandBounds(x, y, count, minCorner, maxCorner);
+}
+
+/// Expand a pair of box corners to include each position.
+inline void expandBounds(const float * x, const float * y, const std::size_t count, Vector2d<float> & minCorner, Vector2d<float> & maxCorner)
+{
+    AIL_MATH_KERNEL_DISPATCH(expandBounds, float, (x, y, count, minCorner, maxCorner))
+}
+
+/// Expand a pair of box corners to include each position.
+inline void expandBounds(const double * x, const double * y, const std::size_t count, Vector2d<double> & minCorner, Vector2d<double> & maxCorner)
+{
+    AIL_MATH_KERNEL_DISPATCH(expandBounds, double, (x, y, count, minCorner, maxCorner))
+}
+
+/// Expand a pair of box corners to include each position in an array of vectors.
+/// Generic version, used for types which don't have a SIMD implementation.
+template <typename T_ty>
+inline void expandBounds(const Vector2d<T_ty> * points, const std::size_t count, Vector2d<T_ty> & minCorner, Vector2d<T_ty> & maxCorner)
+{
+    scalar::expandBounds(points, count, minCorner, maxCorner);
+}
+
+/// Expand a pair of box corners to include each position in an array of vectors.
+inline void expandBounds(const Vector2d<float> * points, const std::size_t count, Vector2d<float> & minCorner, Vector2d<float> & maxCorner)
+{
+    AIL_MATH_KERNEL_DISPATCH(expandBounds, float, (points, count, minCorner, maxCorner))
+}
+
+/// Expand a pair of box corners to include each position in an array of vectors.
+inline void expandBounds(const Vector2d<double> * points, const std::size_t count, Vector2d<double> & minCorner, Vector2d<double> & maxCorner)
+{
+    AIL_MATH_KERNEL_DISPATCH(expandBounds, double, (points, count, minCorner, maxCorner))
+}
+
+//--------------
+} // kernels
+} // math
+} // ail
+//--------------
+
+#endif //ail_math_Vector2dKernels_h
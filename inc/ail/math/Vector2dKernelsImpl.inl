@@ -0,0 +1,260 @@
+/** \file Vector2dKernelsImpl.inl
+    \brief Generic bodies of the SIMD batch kernels for 2d vectors. (Intended for internal use by the library.)
+
+    NOTE: This file deliberately has no include guard. Vector2dKernels.h
+     includes it once inside each instruction set namespace, where the Ops<T_ty>
+     structure from SimdOps.h wraps that instruction set's intrinsics. Don't
+     include it anywhere else.
+
+    Each kernel processes as many whole registers as possible, then hands the
+     remaining elements to the scalar reference kernel. The arithmetic is done in
+     the same order as the scalar Vector2d functions so that results are identical.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+/// Normalise each vector in place. Zero length vectors are left unchanged.
+template <typename T_ty>
+void normalise(T_ty * x, T_ty * y, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width) {
+        const V vx = O::load(x + i);
+        const V vy = O::load(y + i);
+        const V mag = O::sqrt(O::add(O::mul(vx, vx), O::mul(vy, vy)));
+        O::store(x + i, O::selectNonZero(mag, O::div(vx, mag), vx));
+        O::store(y + i, O::selectNonZero(mag, O::div(vy, mag), vy));
+    }
+    scalar::normalise(x + i, y + i, count - i);
+}
+
+/// Calculate the dot product of corresponding pairs of vectors.
+template <typename T_ty>
+void dot(const T_ty * ax, const T_ty * ay, const T_ty * bx, const T_ty * by, T_ty * output, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width) {
+        O::store(output + i, O::add(
+            O::mul(O::load(ax + i), O::load(bx + i)),
+            O::mul(O::load(ay + i), O::load(by + i))));
+    }
+    scalar::dot(ax + i, ay + i, bx + i, by + i, output + i, count - i);
+}
+
+/// Calculate the squared distance between corresponding pairs of positions.
+template <typename T_ty>
+void sqDistance(const T_ty * ax, const T_ty * ay, const T_ty * bx, const T_ty * by, T_ty * output, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width) {
+        const V dx = O::sub(O::load(ax + i), O::load(bx + i));
+        const V dy = O::sub(O::load(ay + i), O::load(by + i));
+        O::store(output + i, O::add(O::mul(dx, dx), O::mul(dy, dy)));
+    }
+    scalar::sqDistance(ax + i, ay + i, bx + i, by + i, output + i, count - i);
+}
+
+/// Calculate the squared distance between each position and a single point.
+template <typename T_ty>
+void sqDistance(const T_ty * ax, const T_ty * ay, const T_ty px, const T_ty py, T_ty * output, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    const V vpx = O::set1(px);
+    const V vpy = O::set1(py);
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width) {
+        const V dx = O::sub(O::load(ax + i), vpx);
+        const V dy = O::sub(O::load(ay + i), vpy);
+        O::store(output + i, O::add(O::mul(dx, dx), O::mul(dy, dy)));
+    }
+    scalar::sqDistance(ax + i, ay + i, px, py, output + i, count - i);
+}
+
+/// Check whether each pair of positions is within the given distance.
+template <typename T_ty>
+void isNear(const T_ty * ax, const T_ty * ay, const T_ty * bx, const T_ty * by, const T_ty dist, bool * output, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    const V limit = O::set1(dist * dist);
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width) {
+        const V dx = O::sub(O::load(ax + i), O::load(bx + i));
+        const V dy = O::sub(O::load(ay + i), O::load(by + i));
+        const unsigned mask = O::cmpLe(O::add(O::mul(dx, dx), O::mul(dy, dy)), limit);
+        storeMask(mask, output + i, O::width);
+    }
+    scalar::isNear(ax + i, ay + i, bx + i, by + i, dist, output + i, count - i);
+}
+
+/// Check whether each position is within the given distance of a single point.
+template <typename T_ty>
+void isNear(const T_ty * ax, const T_ty * ay, const T_ty px, const T_ty py, const T_ty dist, bool * output, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    const V vpx = O::set1(px);
+    const V vpy = O::set1(py);
+    const V limit = O::set1(dist * dist);
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width) {
+        const V dx = O::sub(O::load(ax + i), vpx);
+        const V dy = O::sub(O::load(ay + i), vpy);
+        const unsigned mask = O::cmpLe(O::add(O::mul(dx, dx), O::mul(dy, dy)), limit);
+        storeMask(mask, output + i, O::width);
+    }
+    scalar::isNear(ax + i, ay + i, px, py, dist, output + i, count - i);
+}
+
+/// Check whether each box intersects a single query box, including if they just touch.
+template <typename T_ty>
+void intersects(const T_ty * minX, const T_ty * minY, const T_ty * maxX, const T_ty * maxY,
+    const T_ty qMinX, const T_ty qMinY, const T_ty qMaxX, const T_ty qMaxY, bool * output, const std::size_t count)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    const V vqMinX = O::set1(qMinX);
+    const V vqMinY = O::set1(qMinY);
+    const V vqMaxX = O::set1(qMaxX);
+    const V vqMaxY = O::set1(qMaxY);
+    const unsigned queryMask = ((qMinX <= qMaxX) & (qMinY <= qMaxY)) ? ~0u : 0u;
+
+    std::size_t i = 0;
+    for (; i + O::width <= count; i += O::width) {
+        const V vMinX = O::load(minX + i);
+        const V vMinY = O::load(minY + i);
+        const V vMaxX = O::load(maxX + i);
+        const V vMaxY = O::load(maxY + i);
+        const unsigned mask =
+            O::cmpLe(vMinX, vqMaxX) & O::cmpLe(vMinY, vqMaxY) &
+            O::cmpLe(vqMinX, vMaxX) & O::cmpLe(vqMinY, vMaxY) &
+            O::cmpLe(vMinX, vMaxX) & O::cmpLe(vMinY, vMaxY) &
+            queryMask;
+        storeMask(mask, output + i, O::width);
+    }
+    scalar::intersects(minX + i, minY + i, maxX + i, maxY + i, qMinX, qMinY, qMaxX, qMaxY, output + i, count - i);
+}
+
+/// Merge each lane of a register into a single value, with (lane < value) ? lane : value.
+template <typename T_ty>
+inline void foldMin(const typename Ops<T_ty>::V v, T_ty & value, const std::size_t first, const std::size_t step)
+{
+    T_ty lanes[Ops<T_ty>::width];
+    Ops<T_ty>::store(lanes, v);
+    for (std::size_t i = first; i < Ops<T_ty>::width; i += step)
+        value = (lanes[i] < value) ? lanes[i] : value;
+}
+
+/// Merge each lane of a register into a single value, with (lane > value) ? lane : value.
+template <typename T_ty>
+inline void foldMax(const typename Ops<T_ty>::V v, T_ty & value, const std::size_t first, const std::size_t step)
+{
+    T_ty lanes[Ops<T_ty>::width];
+    Ops<T_ty>::store(lanes, v);
+    for (std::size_t i = first; i < Ops<T_ty>::width; i += step)
+        value = (lanes[i] > value) ? lanes[i] : value;
+}
+
+/// Expand a pair of box corners to include each position.
+/// Two sets of accumulators are used, so that consecutive min/max operations
+///  don't have to wait for each other.
+template <typename T_ty>
+void expandBounds(const T_ty * x, const T_ty * y, const std::size_t count, Vector2d<T_ty> & minCorner, Vector2d<T_ty> & maxCorner)
+{
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    V minX0 = O::set1(minCorner.x), minY0 = O::set1(minCorner.y);
+    V maxX0 = O::set1(maxCorner.x), maxY0 = O::set1(maxCorner.y);
+    V minX1 = minX0, minY1 = minY0, maxX1 = maxX0, maxY1 = maxY0;
+
+    std::size_t i = 0;
+    for (; i + (2 * O::width) <= count; i += 2 * O::width) {
+        const V x0 = O::load(x + i), x1 = O::load(x + i + O::width);
+        const V y0 = O::load(y + i), y1 = O::load(y + i + O::width);
+        minX0 = O::min(x0, minX0);
+        minX1 = O::min(x1, minX1);
+        minY0 = O::min(y0, minY0);
+        minY1 = O::min(y1, minY1);
+        maxX0 = O::max(x0, maxX0);
+        maxX1 = O::max(x1, maxX1);
+        maxY0 = O::max(y0, maxY0);
+        maxY1 = O::max(y1, maxY1);
+    }
+    for (; i + O::width <= count; i += O::width) {
+        const V vx = O::load(x + i);
+        const V vy = O::load(y + i);
+        minX0 = O::min(vx, minX0);
+        minY0 = O::min(vy, minY0);
+        maxX0 = O::max(vx, maxX0);
+        maxY0 = O::max(vy, maxY0);
+    }
+
+    foldMin<T_ty>(O::min(minX0, minX1), minCorner.x, 0, 1);
+    foldMin<T_ty>(O::min(minY0, minY1), minCorner.y, 0, 1);
+    foldMax<T_ty>(O::max(maxX0, maxX1), maxCorner.x, 0, 1);
+    foldMax<T_ty>(O::max(maxY0, maxY1), maxCorner.y, 0, 1);
+    scalar::expandBounds(x + i, y + i, count - i, minCorner, maxCorner);
+}
+
+/// Expand a pair of box corners to include each position in an array of vectors.
+/// The array is processed as a flat array of coordinates, so each register
+///  holds x coordinates in its even lanes and y coordinates in its odd lanes.
+template <typename T_ty>
+void expandBounds(const Vector2d<T_ty> * points, const std::size_t count, Vector2d<T_ty> & minCorner, Vector2d<T_ty> & maxCorner)
+{
+    static_assert(sizeof(Vector2d<T_ty>) == 2 * sizeof(T_ty), "Vector2d must be a pair of coordinates with no padding.");
+    typedef Ops<T_ty> O;
+    typedef typename O::V V;
+
+    T_ty initialMin[O::width], initialMax[O::width];
+    for (std::size_t lane = 0; lane < O::width; lane += 2) {
+        initialMin[lane] = minCorner.x;
+        initialMin[lane + 1] = minCorner.y;
+        initialMax[lane] = maxCorner.x;
+        initialMax[lane + 1] = maxCorner.y;
+    }
+    V min0 = O::load(initialMin), max0 = O::load(initialMax);
+    V min1 = min0, max1 = max0;
+
+    const T_ty * xy = reinterpret_cast<const T_ty *>(points);
+    const std::size_t valueCount = count * 2;
+    std::size_t i = 0;
+    for (; i + (2 * O::width) <= valueCount; i += 2 * O::width) {
+        const V v0 = O::load(xy + i), v1 = O::load(xy + i + O::width);
+        min0 = O::min(v0, min0);
+        min1 = O::min(v1, min1);
+        max0 = O::max(v0, max0);
+        max1 = O::max(v1, max1);
+    }
+    for (; i + O::width <= valueCount; i += O::width) {
+        const V v = O::load(xy + i);
+        min0 = O::min(v, min0);
+        max0 = O::max(v, max0);
+    }
+
+    const V minLanes = O::min(min0, min1), maxLanes = O::max(max0, max1);
+    foldMin<T_ty>(minLanes, minCorner.x, 0, 2);
+    foldMin<T_ty>(minLanes, minCorner.y, 1, 2);
+    foldMax<T_ty>(maxLanes, maxCorner.x, 0, 2);
+    foldMax<T_ty>(maxLanes, maxCorner.y, 1, 2);
+    scalar::expandBounds(points + (i / 2), count - (i / 2), minCorner, maxCorner);
+}
@@ -12,22 +12,88 @@
 
     // Various core/utility headers:
 
+    #include "Aligned.h"
+    #include "Config.h"
     #include "Constants.h"
+    #include "Cordic.h"
+    #include "FastTrig.h"
+    #include "Fixed.h"
+    #include "Simd.h"
+    #include "SimdOps.h"
     #include "Utils.h"
 
 
     // Everything else:
 
+    #include "Aabb2d.h"
+    #include "Aabb2d.inl"
+
+    #include "Aabb2dArray.h"
+    #include "Aabb2dArray.inl"
+
     #include "BoundingBox2d.h"
     #include "BoundingBox2d.inl"
 
+    #include "Bvh2d.h"
+    #include "Bvh2d.inl"
+
+    #include "Capsule2d.h"
+    #include "Capsule2d.inl"
+
+    #include "Circle2d.h"
+    #include "Circle2d.inl"
+
+    #include "Contact2d.h"
+    #include "Contact2d.inl"
+
+    #include "OrientedBox2d.h"
+    #include "OrientedBox2d.inl"
+
+    #include "ParallelBatch.h"
+
     #include "Polar.h"
     #include "Polar.inl"
 
+    #include "PolarBatch.h"
+
+    #include "Quadtree.h"
+    #include "Quadtree.inl"
+
+    #include "Ray2d.h"
+    #include "Ray2d.inl"
+
+    #include "Ray2dKernels.h"
+
+    #include "Segment2d.h"
+    #include "Segment2d.inl"
+
+    #include "SpatialHashGrid.h"
+    #include "SpatialHashGrid.inl"
+
+    #include "SweepAndPrune2d.h"
+    #include "SweepAndPrune2d.inl"
+
+    #include "SweptBox2d.h"
+    #include "SweptBox2d.inl"
+
+    #include "ThreadPool.h"
+    #include "ThreadPool.inl"
+
     #include "tmod.h"
 
+    #include "TrigPolicy.h"
+
+    #include "UtilsBatch.h"
+
     #include "Vector2d.h"
     #include "Vector2d.inl"
 
+    #include "Vector2dExpr.h"
+
+    #include "Vector2dArray.h"
+    #include "Vector2dArray.inl"
+
+    #include "Vector2dKernels.h"
+
 
 #endif //ail_math_ailmath_h
@@ -0,0 +1,31 @@
+/** \file BoundingBox2d.cpp
+    \brief Explicitly instantiates BoundingBox2d for the common types.
+
+    This is part of the ail_math_instances library. Code which defines
+     AIL_MATH_EXTERN_TEMPLATES links against these instead of instantiating
+     them in every translation unit. See BoundingBox2d.inl.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include <cstdint>
+
+#include "ail/math/BoundingBox2d.inl"
+#include "ail/math/Vector2d.inl"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+AIL_MATH_INSTANTIATE_BOUNDINGBOX2D(template, float)
+AIL_MATH_INSTANTIATE_BOUNDINGBOX2D(template, double)
+AIL_MATH_INSTANTIATE_BOUNDINGBOX2D(template, std::int32_t)
+AIL_MATH_INSTANTIATE_BOUNDINGBOX2D(template, std::int64_t)
+
+//--------------
+} // math
+} // ail
+//--------------
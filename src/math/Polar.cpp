@@ -0,0 +1,27 @@
+/** \file Polar.cpp
+    \brief Explicitly instantiates Polar for the common types.
+
+    This is part of the ail_math_instances library. Code which defines
+     AIL_MATH_EXTERN_TEMPLATES links against these instead of instantiating
+     them in every translation unit. See Polar.inl.
+
+    Part of ail, the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "ail/math/Polar.inl"
+#include "ail/math/Vector2d.inl"
+
+//--------------
+namespace ail {
+namespace math {
+//--------------
+
+AIL_MATH_INSTANTIATE_POLAR(template, float)
+AIL_MATH_INSTANTIATE_POLAR(template, double)
+
+//--------------
+} // math
+} // ail
+//--------------
@@ -11,4 +11,16 @@
 
 #include "catch/catch.hpp"
 
+// Catch2 changed Approx so that it no longer allows a small margin around 0 by
+//  default. The tests were written for the original behaviour, so restore it.
+#if defined(CATCH_VERSION_MAJOR) && CATCH_VERSION_MAJOR >= 2
+namespace ail_test {
+    inline Catch::Detail::Approx approx(const double value)
+    {
+        return Catch::Detail::Approx(value).scale(1.0);
+    }
+}
+#define Approx(value) ::ail_test::approx(value)
+#endif
+
 #include "ail/math/ailmath.h"
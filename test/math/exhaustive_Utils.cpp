@@ -0,0 +1,322 @@
+/** \file exhaustive_Utils.cpp
+    \brief Exhaustive accuracy and throughput harness for the single precision angle utilities.
+
+    Usage: ail_exhaustive [filter...] [--threads=<n>] [--stride=<n>]
+    Every one of the 2^32 float bit patterns is passed through each function,
+     and compared to a reference calculated in double precision. The error of
+     each result is measured in units in the last place (ULP) of the correctly
+     rounded float, so a correctly rounded function has a maximum of 0.5.
+    The inputs are split into chunks which are shared out between threads. Each
+     chunk is timed on its own before its results are checked, so the time per
+     call only includes the function itself. The total time for the sweep,
+     including the checks, is reported too.
+    Filters select functions whose names contain any of the strings. A stride
+     above 1 only checks every nth bit pattern, which is useful for a quick run.
+    The exit code is non-zero if any function exceeds its error budget, or if
+     a result is outside the range which the function guarantees.
+
+    This isn't part of the normal test project, because a full run takes
+     minutes even on lots of cores. Configure with AIL_BUILD_EXHAUSTIVE_TESTS
+     to build it and register it with CTest (label "exhaustive").
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "ail/math/ailmath.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+/// Number of bit patterns in each chunk of work.
+const std::uint64_t chunkSize = 1 << 16;
+
+/// Total number of float bit patterns.
+const std::uint64_t patternCount = std::uint64_t(1) << 32;
+
+/// The float value of 2 pi, which is the period used by the float angle functions.
+const double floatPeriod = static_cast<double>(pi<float>() * 2.0f);
+
+/// Describes one function being checked.
+struct Function
+{
+    /// Name shown in the report.
+    const char * name;
+
+    /// Calculate the function for a span of inputs. This is the part which is timed.
+    void (*calculate)(const float * input, float * output, std::size_t count);
+
+    /// Calculate the ideal result in double precision. It must be NaN wherever the result should be NaN.
+    double (*reference)(float input);
+
+    /// Largest error allowed for a finite result, in ULP.
+    double maxUlpBudget;
+
+    /// If the result must be in [0, 2 pi) then this is true. Where the reference
+    ///  rounds to 2 pi, 0 is also treated as correct.
+    bool isAngleRange;
+};
+
+/// Accuracy and timing statistics, accumulated separately by each thread and then merged.
+struct Stats
+{
+    double maxUlp = 0.0;
+    float maxUlpInput = 0.0f;
+    double sumUlp = 0.0;
+    std::uint64_t checked = 0;
+    std::uint64_t overflows = 0;
+    std::uint64_t nanMismatches = 0;
+    std::uint64_t outOfRange = 0;
+    double seconds = 0.0;
+
+    void merge(const Stats & other)
+    {
+        if (other.maxUlp > maxUlp) {
+            maxUlp = other.maxUlp;
+            maxUlpInput = other.maxUlpInput;
+        }
+        sumUlp += other.sumUlp;
+        checked += other.checked;
+        overflows += other.overflows;
+        nanMismatches += other.nanMismatches;
+        outOfRange += other.outOfRange;
+        seconds += other.seconds;
+    }
+};
+
+//-------------------------------------------------------------------------
+// Functions being checked, and their references.
+
+void calculateDegToRad(const float * input, float * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = degToRad(input[i]);
+}
+
+double referenceDegToRad(const float input)
+{
+    return (static_cast<double>(input) * pi<double>()) / 180.0;
+}
+
+void calculateRadToDeg(const float * input, float * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = radToDeg(input[i]);
+}
+
+double referenceRadToDeg(const float input)
+{
+    return (static_cast<double>(input) * 180.0) / pi<double>();
+}
+
+void calculateWrap(const float * input, float * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = wrap(input[i], 0.0f, pi<float>() * 2.0f);
+}
+
+void calculateWrapAngle(const float * input, float * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = wrapAngle(input[i]);
+}
+
+void calculateSimplify(const float * input, float * output, const std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        Polar<float> polar(input[i], 1.0f);
+        polar.simplify();
+        output[i] = polar.angle;
+    }
+}
+
+/// The exact remainder of the input divided by the float value of 2 pi, in the range [0, 2 pi).
+/// std::fmod is always exact, so the only rounding is when the period is added to a negative remainder.
+double referenceWrap(const float input)
+{
+    const double rem = std::fmod(static_cast<double>(input), floatPeriod);
+    return (rem >= 0.0) ? rem : rem + floatPeriod;
+}
+
+// The conversions round twice, and pi<float>() is itself out by almost half an ULP, so they're allowed 2 ULP.
+const Function g_functions[] = {
+    { "degToRad", &calculateDegToRad, &referenceDegToRad, 2.0, false },
+    { "radToDeg", &calculateRadToDeg, &referenceRadToDeg, 2.0, false },
+    { "wrap(0, 2 pi)", &calculateWrap, &referenceWrap, 0.5, false },
+    { "wrapAngle", &calculateWrapAngle, &referenceWrap, 0.5, true },
+    { "Polar::simplify", &calculateSimplify, &referenceWrap, 0.5, true }
+};
+
+//-------------------------------------------------------------------------
+// Sweep.
+
+/// Get the size of one ULP of the float which is nearest to a value.
+double getFloatUlp(const double value)
+{
+    int exponent = 0;
+    std::frexp(value, &exponent);
+    return std::ldexp(1.0, std::max(exponent - 24, -149));
+}
+
+/// Get the error of a result in ULP, or a negative number if it can't be measured.
+/// This also records overflows, NaN mismatches and range violations.
+double measureError(const Function & function, const float result, const double reference, Stats & stats)
+{
+    if (std::isnan(reference) || std::isnan(result)) {
+        if (std::isnan(reference) != std::isnan(result))
+            ++stats.nanMismatches;
+        return -1.0;
+    }
+
+    if (function.isAngleRange) {
+        if (!(result >= 0.0f && result < pi<float>() * 2.0f))
+            ++stats.outOfRange;
+        // The reference may be so close to 2 pi that it rounds to it, in which case 0 is right.
+        if (result == 0.0f && reference > floatPeriod * 0.5)
+            return std::fabs(floatPeriod - reference) / getFloatUlp(reference);
+    }
+
+    if (std::isinf(result) != std::isinf(reference)) {
+        ++stats.overflows;
+        return -1.0;
+    }
+    if (std::isinf(reference))
+        return (result == reference) ? 0.0 : -1.0;
+
+    return std::fabs(static_cast<double>(result) - reference) / getFloatUlp(reference);
+}
+
+/// Check one chunk of bit patterns, starting at first.
+void checkChunk(const Function & function, const std::uint64_t first, const std::uint64_t stride,
+    std::vector<float> & input, std::vector<float> & output, Stats & stats)
+{
+    input.clear();
+    const std::uint64_t last = std::min(first + (chunkSize * stride), patternCount);
+    for (std::uint64_t bits = first; bits < last; bits += stride) {
+        const std::uint32_t pattern = static_cast<std::uint32_t>(bits);
+        float value;
+        std::memcpy(&value, &pattern, sizeof(value));
+        input.push_back(value);
+    }
+    output.resize(input.size());
+
+    const auto start = std::chrono::steady_clock::now();
+    function.calculate(input.data(), output.data(), input.size());
+    stats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        const double ulp = measureError(function, output[i], function.reference(input[i]), stats);
+        if (ulp > stats.maxUlp) {
+            stats.maxUlp = ulp;
+            stats.maxUlpInput = input[i];
+        }
+        if (ulp >= 0.0) {
+            stats.sumUlp += ulp;
+            ++stats.checked;
+        }
+    }
+}
+
+/// Check every bit pattern (or every stride'th) on the given number of threads.
+Stats sweep(const Function & function, const unsigned threadCount, const std::uint64_t stride)
+{
+    const std::uint64_t chunkCount = (patternCount + (chunkSize * stride) - 1) / (chunkSize * stride);
+    std::atomic<std::uint64_t> nextChunk(0);
+    std::vector<Stats> threadStats(threadCount);
+
+    // Chunks are handed out one at a time, because some inputs (e.g. huge angles) are much slower than others.
+    const auto work = [&](const unsigned index) {
+        std::vector<float> input, output;
+        input.reserve(chunkSize);
+        for (std::uint64_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++)
+            checkChunk(function, chunk * chunkSize * stride, stride, input, output, threadStats[index]);
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < threadCount; ++i)
+        threads.emplace_back(work, i);
+    work(0);
+    for (auto & thread : threads)
+        thread.join();
+
+    Stats total;
+    for (const auto & stats : threadStats)
+        total.merge(stats);
+    return total;
+}
+
+/// Parse the value of a numeric --name=<n> option. Returns false if the argument isn't that option.
+bool parseOption(const char * arg, const char * name, std::uint64_t & value)
+{
+    const std::size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) != 0 || arg[length] != '=')
+        return false;
+    value = std::strtoull(arg + length + 1, nullptr, 10);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    std::uint64_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::uint64_t stride = 1;
+    std::vector<std::string> filters;
+    for (int i = 1; i < argc; ++i) {
+        if (!parseOption(argv[i], "--threads", threadCount) && !parseOption(argv[i], "--stride", stride))
+            filters.push_back(argv[i]);
+    }
+    if (threadCount == 0 || stride == 0) {
+        std::fprintf(stderr, "Usage: %s [filter...] [--threads=<n>] [--stride=<n>]\n", argv[0]);
+        return 2;
+    }
+
+    const std::string which = (stride == 1) ? "every float" : "every " + std::to_string(stride) + "th float bit pattern";
+    std::printf("Checking %s on %u thread(s).\n\n", which.c_str(), static_cast<unsigned>(threadCount));
+    std::printf("%-16s %10s %14s %10s %10s %10s %10s %10s %10s\n",
+        "Function", "Max ULP", "at input", "Mean ULP", "Overflow", "NaN diff", "Range", "ns/call", "Seconds");
+
+    bool passed = true;
+    for (const Function & function : g_functions) {
+        if (!filters.empty() && std::none_of(filters.begin(), filters.end(),
+                [&](const std::string & filter) { return std::string(function.name).find(filter) != std::string::npos; }))
+            continue;
+
+        const auto start = std::chrono::steady_clock::now();
+        const Stats stats = sweep(function, static_cast<unsigned>(threadCount), stride);
+        const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // The timed sections add up to the time one thread would take to make every call.
+        const std::uint64_t calls = (patternCount + stride - 1) / stride;
+        const double nanoseconds = (stats.seconds * 1e9) / static_cast<double>(calls);
+        const double mean = (stats.checked > 0) ? stats.sumUlp / static_cast<double>(stats.checked) : 0.0;
+
+        const bool ok = stats.maxUlp <= function.maxUlpBudget && stats.nanMismatches == 0 && stats.outOfRange == 0;
+        passed = passed && ok;
+
+        std::printf("%-16s %10.4f %14.7g %10.6f %10llu %10llu %10llu %10.2f %10.1f%s\n",
+            function.name, stats.maxUlp, static_cast<double>(stats.maxUlpInput), mean,
+            static_cast<unsigned long long>(stats.overflows), static_cast<unsigned long long>(stats.nanMismatches),
+            static_cast<unsigned long long>(stats.outOfRange), nanoseconds, wallSeconds, ok ? "" : "  FAILED");
+        std::fflush(stdout);
+    }
+
+    std::printf("\nOverflow counts finite inputs which gave an infinite result (or vice versa). These aren't errors, because\n"
+        " the calculation can legitimately overflow before the final division. Range counts results outside [0, 2 pi).\n");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,304 @@
+/** \file test_Aabb2d.cpp
+    \brief Unit testing for the Aabb2d class.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+using namespace ail::math;
+
+TEST_CASE("Aabb2d - construction and assignment", "[math::Aabb2d]")
+{
+    SECTION("Default construction initialises to 0")
+    {
+        Aabb2d<float> box;
+        CHECK(box.min == Vector2d<float>(0.0f, 0.0f));
+        CHECK(box.max == Vector2d<float>(0.0f, 0.0f));
+    }
+
+    SECTION("Construction from corners")
+    {
+        Aabb2d<int> a(Vector2d<int>(-1, 2), Vector2d<int>(3, 4));
+        CHECK(a.min == Vector2d<int>(-1, 2));
+        CHECK(a.max == Vector2d<int>(3, 4));
+
+        Aabb2d<int> b(-1, 2, 3, 4);
+        CHECK(a == b);
+        CHECK_FALSE(a != b);
+    }
+
+    SECTION("Uniform initialisation")
+    {
+        Aabb2d<double> box { {1.0, 2.0}, {3.0, 4.0} };
+        CHECK(box.min == Vector2d<double>(1.0, 2.0));
+        CHECK(box.max == Vector2d<double>(3.0, 4.0));
+    }
+
+    SECTION("set() modifiers")
+    {
+        Aabb2d<int> box;
+        box.set(Vector2d<int>(1, 2), Vector2d<int>(5, 6));
+        CHECK(box == Aabb2d<int>(1, 2, 5, 6));
+        box.set(-3, -4, 7, 8);
+        CHECK(box == Aabb2d<int>(-3, -4, 7, 8));
+    }
+}
+
+TEST_CASE("Aabb2d - compile time use and trivial copying", "[math::Aabb2d]")
+{
+    static_assert(std::is_trivially_copyable<Aabb2d<int>>::value, "Aabb2d<int> should be trivially copyable");
+    static_assert(std::is_trivially_copyable<Aabb2d<float>>::value, "Aabb2d<float> should be trivially copyable");
+
+    constexpr Aabb2d<int> box(-1, 2, 3, 4);
+    static_assert(box.min == Vector2d<int>(-1, 2) && box.max == Vector2d<int>(3, 4), "constexpr construction");
+    static_assert(box == Aabb2d<int>(Vector2d<int>(-1, 2), Vector2d<int>(3, 4)), "constexpr equality");
+    static_assert(box != Aabb2d<int>(), "constexpr inequality");
+
+#if AIL_MATH_HAS_CONSTEXPR14
+    static_assert(Aabb2d<int>(BoundingBox2d<int>(1, 3, 2, 1)) == Aabb2d<int>(-1, 2, 3, 4), "constexpr conversion");
+#endif
+
+    CHECK(box.getArea() == 8);
+}
+
+TEST_CASE("Aabb2d - conversion to and from BoundingBox2d", "[math::Aabb2d]")
+{
+    SECTION("Corners match BoundingBox2d")
+    {
+        const BoundingBox2d<float> bb(1.5f, -2.0f, 3.0f, 0.25f);
+        const Aabb2d<float> box(bb);
+        CHECK(box.min == bb.getCornerX1Y1());
+        CHECK(box.max == bb.getCornerX2Y2());
+        CHECK(box.getCentre() == bb.pos);
+        CHECK(box.getSize() == bb.radius * 2.0f);
+    }
+
+    SECTION("Round trip is exact for integers")
+    {
+        std::mt19937 rng(1);
+        std::uniform_int_distribution<int> dist(-100000, 100000);
+        for (int i = 0; i < 1000; ++i) {
+            const BoundingBox2d<int> bb(dist(rng), dist(rng), dist(rng), dist(rng));
+            CHECK(Aabb2d<int>(bb).toBoundingBox() == bb);
+        }
+    }
+
+    SECTION("Round trip is exact for floats which don't round")
+    {
+        std::mt19937 rng(2);
+        std::uniform_int_distribution<int> dist(-4096, 4096);
+        for (int i = 0; i < 1000; ++i) {
+            const BoundingBox2d<float> bb(dist(rng) / 8.0f, dist(rng) / 8.0f, dist(rng) / 16.0f, dist(rng) / 16.0f);
+            CHECK(Aabb2d<float>(bb).toBoundingBox() == bb);
+        }
+    }
+
+    SECTION("contains() matches BoundingBox2d exactly")
+    {
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<double> coord(-10.0, 10.0);
+        std::uniform_real_distribution<double> size(-1.0, 5.0);
+        for (int i = 0; i < 1000; ++i) {
+            const BoundingBox2d<double> bb(coord(rng), coord(rng), size(rng), size(rng));
+            const Vector2d<double> point(coord(rng), coord(rng));
+            CHECK(Aabb2d<double>(bb).contains(point) == bb.contains(point));
+            CHECK(Aabb2d<double>(bb).contains(bb.getCornerX1Y2()) == bb.contains(bb.getCornerX1Y2()));
+        }
+    }
+
+    SECTION("Odd integer sizes round the centre down and the radius up")
+    {
+        const BoundingBox2d<int> bb = Aabb2d<int>(0, 0, 3, 5).toBoundingBox();
+        CHECK(bb.pos == Vector2d<int>(1, 2));
+        CHECK(bb.radius == Vector2d<int>(2, 3));
+
+        const BoundingBox2d<int> negative = Aabb2d<int>(-5, -3, 0, 0).toBoundingBox();
+        CHECK(negative.pos == Vector2d<int>(-3, -2));
+        CHECK(negative.radius == Vector2d<int>(3, 2));
+    }
+
+    SECTION("The result always encloses the original box")
+    {
+        std::mt19937 rng(4);
+        std::uniform_int_distribution<int> dist(-1000, 1000);
+        for (int i = 0; i < 1000; ++i) {
+            const int x1 = dist(rng), y1 = dist(rng), x2 = dist(rng), y2 = dist(rng);
+            const Aabb2d<int> box(std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2));
+            const BoundingBox2d<int> bb = box.toBoundingBox();
+            CHECK(bb.contains(box.min));
+            CHECK(bb.contains(box.max));
+        }
+
+        const Aabb2d<double> tiny(1.0, 1.0, 1.0 + 1e-15, 1.0);
+        const BoundingBox2d<double> bb = tiny.toBoundingBox();
+        CHECK(bb.contains(tiny.min));
+        CHECK(bb.contains(tiny.max));
+    }
+}
+
+TEST_CASE("Aabb2d - measurements", "[math::Aabb2d]")
+{
+    SECTION("Area and perimeter")
+    {
+        const Aabb2d<float> box(-1.0f, 2.0f, 3.0f, 2.5f);
+        CHECK(box.getArea() == 2.0f);
+        CHECK(box.getPerimeter() == 9.0f);
+        CHECK(box.getSize() == Vector2d<float>(4.0f, 0.5f));
+        CHECK_FALSE(box.isEmpty());
+    }
+
+    SECTION("A flat box has no area, but is not empty")
+    {
+        const Aabb2d<int> box(0, 5, 10, 5);
+        CHECK(box.getArea() == 0);
+        CHECK(box.getPerimeter() == 20);
+        CHECK_FALSE(box.isEmpty());
+    }
+
+    SECTION("Empty boxes have no area")
+    {
+        const Aabb2d<int> box(0, 0, -4, 3);
+        CHECK(box.isEmpty());
+        CHECK(box.getArea() == 0);
+        CHECK(box.getPerimeter() == 6);
+
+        const Aabb2d<int> inverted(5, 5, 1, 1);
+        CHECK(inverted.isEmpty());
+        CHECK(inverted.getArea() == 0);
+        CHECK(inverted.getPerimeter() == 0);
+    }
+
+    SECTION("NaN corners count as empty")
+    {
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        CHECK(Aabb2d<float>(nan, 0.0f, 1.0f, 1.0f).isEmpty());
+        CHECK(Aabb2d<float>(0.0f, 0.0f, 1.0f, nan).isEmpty());
+    }
+}
+
+TEST_CASE("Aabb2d - combining boxes", "[math::Aabb2d]")
+{
+    const Aabb2d<int> a(0, 0, 4, 4);
+    const Aabb2d<int> b(2, -1, 6, 3);
+    const Aabb2d<int> c(10, 10, 12, 12);
+
+    SECTION("Union")
+    {
+        CHECK(a.getUnion(b) == Aabb2d<int>(0, -1, 6, 4));
+        CHECK(b.getUnion(a) == Aabb2d<int>(0, -1, 6, 4));
+        CHECK(a.getUnion(c) == Aabb2d<int>(0, 0, 12, 12));
+        CHECK(a.getUnion(a) == a);
+    }
+
+    SECTION("Intersection")
+    {
+        CHECK(a.getIntersection(b) == Aabb2d<int>(2, 0, 4, 3));
+        CHECK(b.getIntersection(a) == Aabb2d<int>(2, 0, 4, 3));
+        CHECK(a.getIntersection(c).isEmpty());
+        CHECK(a.getIntersection(c).getArea() == 0);
+        CHECK(a.getIntersection(a) == a);
+    }
+
+    SECTION("Expand to include a point")
+    {
+        Aabb2d<int> box(a);
+        box.expand(Vector2d<int>(2, 2));
+        CHECK(box == a);
+        box.expand(Vector2d<int>(-3, 7));
+        CHECK(box == Aabb2d<int>(-3, 0, 4, 7));
+    }
+
+    SECTION("Expand to include a box")
+    {
+        Aabb2d<int> box(a);
+        box.expand(c);
+        CHECK(box == a.getUnion(c));
+    }
+
+    SECTION("Expand by a margin")
+    {
+        Aabb2d<float> box(0.0f, 0.0f, 4.0f, 2.0f);
+        box.expand(1.5f);
+        CHECK(box == Aabb2d<float>(-1.5f, -1.5f, 5.5f, 3.5f));
+        box.expand(-3.0f);
+        CHECK(box.isEmpty());
+    }
+
+    SECTION("Building a box from points")
+    {
+        Aabb2d<double> box(std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+            std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest());
+        CHECK(box.isEmpty());
+        box.expand(Vector2d<double>(1.0, -2.0));
+        CHECK(box == Aabb2d<double>(1.0, -2.0, 1.0, -2.0));
+        box.expand(Vector2d<double>(-5.0, 3.0));
+        CHECK(box == Aabb2d<double>(-5.0, -2.0, 1.0, 3.0));
+    }
+}
+
+TEST_CASE("Aabb2d - tests", "[math::Aabb2d]")
+{
+    const Aabb2d<int> a(0, 0, 4, 4);
+
+    SECTION("Contains point")
+    {
+        CHECK(a.contains(Vector2d<int>(2, 2)));
+        CHECK(a.contains(Vector2d<int>(0, 0)));
+        CHECK(a.contains(Vector2d<int>(4, 4)));
+        CHECK(a.contains(Vector2d<int>(0, 4)));
+        CHECK_FALSE(a.contains(Vector2d<int>(-1, 2)));
+        CHECK_FALSE(a.contains(Vector2d<int>(2, 5)));
+        CHECK_FALSE(Aabb2d<int>(4, 4, 0, 0).contains(Vector2d<int>(2, 2)));
+    }
+
+    SECTION("Contains box")
+    {
+        CHECK(a.contains(a));
+        CHECK(a.contains(Aabb2d<int>(1, 1, 3, 3)));
+        CHECK(a.contains(Aabb2d<int>(0, 0, 4, 0)));
+        CHECK_FALSE(a.contains(Aabb2d<int>(1, 1, 5, 3)));
+        CHECK_FALSE(a.contains(Aabb2d<int>(-1, -1, 5, 5)));
+        CHECK_FALSE(a.contains(Aabb2d<int>(3, 3, 1, 1)));
+    }
+
+    SECTION("Intersects")
+    {
+        CHECK(a.intersects(a));
+        CHECK(a.intersects(Aabb2d<int>(3, 3, 8, 8)));
+        CHECK(a.intersects(Aabb2d<int>(-8, -8, 8, 8)));
+        CHECK(a.intersects(Aabb2d<int>(4, 4, 8, 8)));
+        CHECK(a.intersects(Aabb2d<int>(-2, 4, 0, 6)));
+        CHECK_FALSE(a.intersects(Aabb2d<int>(5, 0, 8, 4)));
+        CHECK_FALSE(a.intersects(Aabb2d<int>(0, -3, 4, -1)));
+    }
+
+    SECTION("Empty boxes don't intersect anything")
+    {
+        const Aabb2d<int> empty(3, 3, 1, 1);
+        CHECK_FALSE(a.intersects(empty));
+        CHECK_FALSE(empty.intersects(a));
+        CHECK_FALSE(empty.intersects(empty));
+    }
+
+    SECTION("Intersects matches BoundingBox2d for exactly representable boxes")
+    {
+        std::mt19937 rng(4);
+        std::uniform_int_distribution<int> pos(-40, 40);
+        std::uniform_int_distribution<int> size(0, 20);
+        for (int i = 0; i < 2000; ++i) {
+            const BoundingBox2d<float> lhs(pos(rng) / 4.0f, pos(rng) / 4.0f, size(rng) / 4.0f, size(rng) / 4.0f);
+            const BoundingBox2d<float> rhs(pos(rng) / 4.0f, pos(rng) / 4.0f, size(rng) / 4.0f, size(rng) / 4.0f);
+            CHECK(Aabb2d<float>(lhs).intersects(Aabb2d<float>(rhs)) == lhs.intersects(rhs));
+        }
+    }
+}
@@ -0,0 +1,377 @@
+/** \file test_Aabb2dArray.cpp
+    \brief Unit testing for the Aabb2dArray class, checking every SIMD level against Aabb2d.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <limits>
+#include <new>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Generate random boxes, including some empty, flat and NaN boxes.
+// An odd count is used so that the kernels have to deal with a partial register at the end.
+template <typename T_ty>
+std::vector<Aabb2d<T_ty>> makeTestBoxes(const unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<T_ty> coord(T_ty(-100), T_ty(100));
+    std::uniform_real_distribution<T_ty> size(T_ty(-2), T_ty(20));
+
+    std::vector<Aabb2d<T_ty>> boxes;
+    for (int i = 0; i < 1021; ++i) {
+        const Vector2d<T_ty> min(coord(rng), coord(rng));
+        boxes.push_back(Aabb2d<T_ty>(min, min + Vector2d<T_ty>(size(rng), size(rng))));
+    }
+
+    boxes[5] = Aabb2d<T_ty>(0, 0, 0, 0);
+    boxes[6] = Aabb2d<T_ty>(T_ty(-1000), T_ty(-1000), T_ty(1000), T_ty(1000));
+    boxes[9] = Aabb2d<T_ty>(std::numeric_limits<T_ty>::quiet_NaN(), 0, 1, 1);
+    return boxes;
+}
+
+template <typename T_ty>
+void checkIntersectsMatchesAabb2d()
+{
+    const std::vector<Aabb2d<T_ty>> boxes = makeTestBoxes<T_ty>(1);
+    const Aabb2dArray<T_ty> arr(boxes.data(), boxes.size());
+
+    std::vector<Aabb2d<T_ty>> queries = makeTestBoxes<T_ty>(2);
+    queries.resize(40);
+    queries.push_back(Aabb2d<T_ty>(T_ty(10), T_ty(10), T_ty(-10), T_ty(-10)));
+
+    std::unique_ptr<bool[]> output(new bool[boxes.size()]);
+    const SimdLevel original = getSimdLevel();
+
+    for (int i = 0; i <= static_cast<int>(getSupportedSimdLevel()); ++i) {
+        const SimdLevel level = static_cast<SimdLevel>(i);
+        INFO("SIMD level " << i);
+        REQUIRE(setSimdLevel(level) == level);
+
+        for (const Aabb2d<T_ty> & query : queries) {
+            arr.intersects(query, output.get());
+            std::size_t mismatches = 0;
+            for (std::size_t b = 0; b < boxes.size(); ++b) {
+                if (output[b] != boxes[b].intersects(query))
+                    ++mismatches;
+            }
+            CHECK(mismatches == 0);
+        }
+    }
+
+    setSimdLevel(original);
+}
+
+// Check that casting rays and segments against the whole array matches Ray2d and Segment2d.
+// Axis-parallel, zero length and grazing casts are included, as well as random ones.
+template <typename T_ty>
+void checkCastMatchesRay2d()
+{
+    const std::vector<Aabb2d<T_ty>> boxes = makeTestBoxes<T_ty>(1);
+    const Aabb2dArray<T_ty> arr(boxes.data(), boxes.size());
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<T_ty> coord(T_ty(-120), T_ty(120));
+    std::vector<Segment2d<T_ty>> segments;
+    for (int i = 0; i < 20; ++i)
+        segments.push_back(Segment2d<T_ty>(Vector2d<T_ty>(coord(rng), coord(rng)), Vector2d<T_ty>(coord(rng), coord(rng))));
+    segments.push_back(Segment2d<T_ty>(Vector2d<T_ty>(T_ty(-120), T_ty(3)), Vector2d<T_ty>(T_ty(120), T_ty(3))));
+    segments.push_back(Segment2d<T_ty>(Vector2d<T_ty>(T_ty(0), T_ty(50)), Vector2d<T_ty>(T_ty(0), T_ty(-50))));
+    segments.push_back(Segment2d<T_ty>(Vector2d<T_ty>(T_ty(1), T_ty(1)), Vector2d<T_ty>(T_ty(1), T_ty(1))));
+
+    const std::size_t count = boxes.size();
+    std::unique_ptr<T_ty[]> entry(new T_ty[count]), exit(new T_ty[count]);
+    std::unique_ptr<bool[]> hit(new bool[count]);
+    const SimdLevel original = getSimdLevel();
+
+    for (int i = 0; i <= static_cast<int>(getSupportedSimdLevel()); ++i) {
+        const SimdLevel level = static_cast<SimdLevel>(i);
+        INFO("SIMD level " << i);
+        REQUIRE(setSimdLevel(level) == level);
+
+        for (const Segment2d<T_ty> & segment : segments) {
+            const Ray2d<T_ty> ray = segment.toRay();
+            std::size_t rayMismatches = 0, segmentMismatches = 0;
+
+            arr.castRay(ray, entry.get(), exit.get(), hit.get());
+            for (std::size_t b = 0; b < count; ++b) {
+                T_ty expectedEntry = 0, expectedExit = 0;
+                const bool expectedHit = ray.intersects(boxes[b], expectedEntry, expectedExit);
+                if (hit[b] != expectedHit || (expectedHit && (entry[b] != expectedEntry || exit[b] != expectedExit)))
+                    ++rayMismatches;
+            }
+
+            arr.castSegment(segment, entry.get(), exit.get(), hit.get());
+            for (std::size_t b = 0; b < count; ++b) {
+                T_ty expectedEntry = 0, expectedExit = 0;
+                const bool expectedHit = segment.intersects(boxes[b], expectedEntry, expectedExit);
+                if (hit[b] != expectedHit || (expectedHit && (entry[b] != expectedEntry || exit[b] != expectedExit)))
+                    ++segmentMismatches;
+            }
+
+            CHECK(rayMismatches == 0);
+            CHECK(segmentMismatches == 0);
+        }
+    }
+
+    setSimdLevel(original);
+}
+
+// Check that sweeping a moving box against the whole array matches SweptBox2d.
+template <typename T_ty>
+void checkSweepMatchesSweptBox2d()
+{
+    const std::vector<Aabb2d<T_ty>> boxes = makeTestBoxes<T_ty>(1);
+    const Aabb2dArray<T_ty> arr(boxes.data(), boxes.size());
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<T_ty> coord(T_ty(-120), T_ty(120));
+    std::uniform_real_distribution<T_ty> size(T_ty(0), T_ty(10));
+    std::vector<SweptBox2d<T_ty>> movers;
+    for (int i = 0; i < 20; ++i) {
+        movers.push_back(SweptBox2d<T_ty>(BoundingBox2d<T_ty>(coord(rng), coord(rng), size(rng), size(rng)),
+            Vector2d<T_ty>(coord(rng), coord(rng))));
+    }
+    movers.push_back(SweptBox2d<T_ty>(BoundingBox2d<T_ty>(T_ty(-120), T_ty(3), T_ty(1), T_ty(1)), Vector2d<T_ty>(T_ty(240), T_ty(0))));
+    movers.push_back(SweptBox2d<T_ty>(BoundingBox2d<T_ty>(T_ty(1), T_ty(1), T_ty(2), T_ty(2)), Vector2d<T_ty>()));
+
+    const std::size_t count = boxes.size();
+    std::unique_ptr<T_ty[]> time(new T_ty[count]), normalX(new T_ty[count]), normalY(new T_ty[count]);
+    std::unique_ptr<bool[]> hit(new bool[count]);
+    const SimdLevel original = getSimdLevel();
+
+    for (int i = 0; i <= static_cast<int>(getSupportedSimdLevel()); ++i) {
+        const SimdLevel level = static_cast<SimdLevel>(i);
+        INFO("SIMD level " << i);
+        REQUIRE(setSimdLevel(level) == level);
+
+        for (const SweptBox2d<T_ty> & mover : movers) {
+            arr.sweep(mover, time.get(), normalX.get(), normalY.get(), hit.get());
+            std::size_t mismatches = 0;
+            for (std::size_t b = 0; b < count; ++b) {
+                T_ty expectedTime = 0;
+                Vector2d<T_ty> expectedNormal;
+                const bool expectedHit = mover.intersects(boxes[b], expectedTime, expectedNormal);
+                if (hit[b] != expectedHit || (expectedHit && (time[b] != expectedTime ||
+                    Vector2d<T_ty>(normalX[b], normalY[b]) != expectedNormal)))
+                    ++mismatches;
+            }
+            CHECK(mismatches == 0);
+        }
+    }
+
+    setSimdLevel(original);
+}
+
+} // namespace
+
+TEST_CASE("Aabb2dArray - construction and assignment", "[math::Aabb2dArray]")
+{
+    SECTION("Default construction is empty")
+    {
+        Aabb2dArray<float> a;
+        CHECK(a.size() == 0);
+        CHECK(a.empty());
+        CHECK(a.capacity() == 0);
+        CHECK(a.minX() == nullptr);
+    }
+
+    SECTION("Sized construction initialises to 0")
+    {
+        Aabb2dArray<int> a(5);
+        REQUIRE(a.size() == 5);
+        for (std::size_t i = 0; i < a.size(); ++i)
+            CHECK(a[i] == Aabb2d<int>());
+    }
+
+    SECTION("Uniform initialisation fills the lanes")
+    {
+        Aabb2dArray<int> a { {1, 2, 3, 4}, {-5, -6, 7, 8} };
+        REQUIRE(a.size() == 2);
+        CHECK(a.get(0) == Aabb2d<int>(1, 2, 3, 4));
+        CHECK(a.get(1) == Aabb2d<int>(-5, -6, 7, 8));
+        CHECK(a.minX()[1] == -5);
+        CHECK(a.minY()[1] == -6);
+        CHECK(a.maxX()[1] == 7);
+        CHECK(a.maxY()[1] == 8);
+    }
+
+    SECTION("Copy and move")
+    {
+        Aabb2dArray<double> a { {1, 2, 3, 4}, {5, 6, 7, 8} };
+        Aabb2dArray<double> b(a);
+        CHECK(b == a);
+        b.set(1, Aabb2d<double>(0, 0, 1, 1));
+        CHECK(b != a);
+
+        Aabb2dArray<double> c(std::move(b));
+        CHECK(b.empty());
+        CHECK(c.get(1) == Aabb2d<double>(0, 0, 1, 1));
+
+        b = c;
+        CHECK(b == c);
+        a = std::move(c);
+        CHECK(c.empty());
+        CHECK(a == b);
+    }
+}
+
+TEST_CASE("Aabb2dArray - size and storage", "[math::Aabb2dArray]")
+{
+    Aabb2dArray<float> a;
+    for (int i = 0; i < 100; ++i)
+        a.push_back(Aabb2d<float>(float(i), 0.0f, float(i + 1), 1.0f));
+    REQUIRE(a.size() == 100);
+    CHECK(a.capacity() >= 100);
+    CHECK(a.get(37) == Aabb2d<float>(37.0f, 0.0f, 38.0f, 1.0f));
+
+    a.resize(10);
+    CHECK(a.size() == 10);
+    CHECK(a.get(9) == Aabb2d<float>(9.0f, 0.0f, 10.0f, 1.0f));
+
+    a.resize(12);
+    CHECK(a.get(11) == Aabb2d<float>());
+
+    a.reserve(1000);
+    CHECK(a.capacity() >= 1000);
+    CHECK(a.size() == 12);
+    CHECK(a.get(3) == Aabb2d<float>(3.0f, 0.0f, 4.0f, 1.0f));
+
+    CHECK_THROWS_AS(a.reserve(std::numeric_limits<std::size_t>::max()), std::length_error);
+    CHECK_THROWS_AS(a.reserve(std::numeric_limits<std::size_t>::max() / sizeof(float)), std::bad_alloc);
+    CHECK(a.size() == 12);
+    CHECK(a.get(3) == Aabb2d<float>(3.0f, 0.0f, 4.0f, 1.0f));
+
+    // Assigning a bigger array replaces the contents rather than adding to them.
+    Aabb2dArray<float> b;
+    for (int i = 0; i < 2000; ++i)
+        b.push_back(Aabb2d<float>(float(-i), 0.0f, 0.0f, 1.0f));
+    a = b;
+    REQUIRE(a.size() == 2000);
+    CHECK(a.get(3) == Aabb2d<float>(-3.0f, 0.0f, 0.0f, 1.0f));
+    CHECK(a.get(1999) == Aabb2d<float>(-1999.0f, 0.0f, 0.0f, 1.0f));
+
+    a.clear();
+    CHECK(a.empty());
+}
+
+TEST_CASE("Aabb2dArray - batch intersects", "[math::Aabb2dArray]")
+{
+    SECTION("float matches Aabb2d at every SIMD level")
+    {
+        checkIntersectsMatchesAabb2d<float>();
+    }
+
+    SECTION("double matches Aabb2d at every SIMD level")
+    {
+        checkIntersectsMatchesAabb2d<double>();
+    }
+
+    SECTION("int uses the generic kernel")
+    {
+        Aabb2dArray<int> a { {0, 0, 4, 4}, {5, 5, 6, 6}, {4, 4, 2, 2}, {-3, -3, 0, 0} };
+        bool output[4];
+        a.intersects(Aabb2d<int>(0, 0, 4, 4), output);
+        CHECK(output[0]);
+        CHECK_FALSE(output[1]);
+        CHECK_FALSE(output[2]);
+        CHECK(output[3]);
+    }
+
+    SECTION("getIntersecting() appends indices in order")
+    {
+        const std::vector<Aabb2d<float>> boxes = makeTestBoxes<float>(3);
+        const Aabb2dArray<float> arr(boxes.data(), boxes.size());
+        const Aabb2d<float> query(-20.0f, -30.0f, 25.0f, 10.0f);
+
+        std::vector<std::size_t> expected { 12345 };
+        for (std::size_t i = 0; i < boxes.size(); ++i) {
+            if (boxes[i].intersects(query))
+                expected.push_back(i);
+        }
+        REQUIRE(expected.size() > 10);
+
+        std::vector<std::size_t> output { 12345 };
+        arr.getIntersecting(query, output);
+        CHECK(output == expected);
+    }
+}
+
+TEST_CASE("Aabb2dArray - batch ray casting", "[math::Aabb2dArray]")
+{
+    SECTION("float matches Ray2d and Segment2d at every SIMD level")
+    {
+        checkCastMatchesRay2d<float>();
+    }
+
+    SECTION("double matches Ray2d and Segment2d at every SIMD level")
+    {
+        checkCastMatchesRay2d<double>();
+    }
+
+    SECTION("Some boxes are hit and some are missed")
+    {
+        const Aabb2dArray<float> arr { {0, 0, 2, 2}, {3, 0, 5, 2}, {0, 3, 2, 5}, {4, 4, 3, 3} };
+        float entry[4], exit[4];
+        bool hit[4];
+        arr.castRay(Ray2d<float>(Vector2d<float>(-1.0f, 1.0f), Vector2d<float>(1.0f, 0.0f)), entry, exit, hit);
+        CHECK(hit[0]);
+        CHECK(hit[1]);
+        CHECK_FALSE(hit[2]);
+        CHECK_FALSE(hit[3]);
+        CHECK(entry[1] == 4.0f);
+        CHECK(exit[1] == 6.0f);
+
+        arr.castSegment(Segment2d<float>(Vector2d<float>(-1.0f, 1.0f), Vector2d<float>(3.0f, 1.0f)), entry, exit, hit);
+        CHECK(hit[0]);
+        CHECK(entry[0] == 0.25f);
+        CHECK(exit[0] == 0.75f);
+        CHECK(hit[1]);
+        CHECK(entry[1] == 1.0f);
+        CHECK_FALSE(hit[2]);
+        CHECK_FALSE(hit[3]);
+    }
+}
+
+TEST_CASE("Aabb2dArray - batch sweeps", "[math::Aabb2dArray]")
+{
+    SECTION("float matches SweptBox2d at every SIMD level")
+    {
+        checkSweepMatchesSweptBox2d<float>();
+    }
+
+    SECTION("double matches SweptBox2d at every SIMD level")
+    {
+        checkSweepMatchesSweptBox2d<double>();
+    }
+
+    SECTION("Times and normals for a box moving through a row of walls")
+    {
+        const Aabb2dArray<float> arr { {2, -5, 3, 5}, {6, -5, 7, 5}, {10, 4, 11, 5}, {13, -5, 12, 5} };
+        float time[4], normalX[4], normalY[4];
+        bool hit[4];
+        arr.sweep(SweptBox2d<float>(BoundingBox2d<float>(0.0f, 0.0f, 1.0f, 1.0f), Vector2d<float>(16.0f, 0.0f)),
+            time, normalX, normalY, hit);
+        REQUIRE(hit[0]);
+        CHECK(time[0] == 0.0625f);
+        CHECK(normalX[0] == -1.0f);
+        CHECK(normalY[0] == 0.0f);
+        REQUIRE(hit[1]);
+        CHECK(time[1] == 0.3125f);
+        CHECK_FALSE(hit[2]);
+        CHECK_FALSE(hit[3]);
+    }
+}
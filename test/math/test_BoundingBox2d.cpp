@@ -10,6 +10,12 @@
 
 #include "../common.h"
 
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <type_traits>
+#include <vector>
+
 using namespace ail::math;
 
 TEST_CASE("BoundingBox2d - construction and assignment", "[math::BoundingBox2d]")
@@ -120,11 +126,144 @@ TEST_CASE("BoundingBox2d - construction and assignment", "[math::BoundingBox2d]"
         CHECK_THROWS((BoundingBox2d<double> { {1.1,2.2}, {3.3,4.4}, {5.5,6.6} }));
     }
 
-    // TODO: Copy construction
+    SECTION("Copy construction")
+    {
+        const BoundingBox2d<double> b1(1.5, -2.5, 3.25, 4.75);
+        const BoundingBox2d<double> b2(b1);
+        CHECK(b2.pos.x == 1.5);
+        CHECK(b2.pos.y == -2.5);
+        CHECK(b2.radius.x == 3.25);
+        CHECK(b2.radius.y == 4.75);
+    }
+
     // TODO: Copy assignment
 }
 
-// TODO: set() modifiers
+TEST_CASE("BoundingBox2d - construction from corners", "[math::BoundingBox2d]")
+{
+    SECTION("Integer boxes round the radius up")
+    {
+        const BoundingBox2d<int> box = BoundingBox2d<int>::fromCorners(Vector2d<int>(-3, 2), Vector2d<int>(4, 2));
+        CHECK(box.pos == Vector2d<int>(0, 2));
+        CHECK(box.radius == Vector2d<int>(4, 0));
+        CHECK(box.contains(Vector2d<int>(-3, 2)));
+        CHECK(box.contains(Vector2d<int>(4, 2)));
+    }
+
+    SECTION("Floating point boxes always contain both corners")
+    {
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> dist(-1e6f, 1e6f);
+        bool allContained = true;
+        for (int i = 0; i < 10000; ++i) {
+            const float x1 = dist(rng), x2 = dist(rng), y1 = dist(rng) * 1e-6f, y2 = dist(rng);
+            const Vector2d<float> minCorner(std::min(x1, x2), std::min(y1, y2));
+            const Vector2d<float> maxCorner(std::max(x1, x2), std::max(y1, y2));
+            const BoundingBox2d<float> box = BoundingBox2d<float>::fromCorners(minCorner, maxCorner);
+            allContained = allContained && box.contains(minCorner) && box.contains(maxCorner);
+        }
+        CHECK(allContained);
+    }
+}
+
+TEST_CASE("BoundingBox2d - construction from points", "[math::BoundingBox2d]")
+{
+    SECTION("No points")
+    {
+        CHECK(BoundingBox2d<float>::fromPoints(nullptr, 0) == BoundingBox2d<float>());
+        CHECK(BoundingBox2d<float>::fromPoints(nullptr, nullptr, 0) == BoundingBox2d<float>());
+    }
+
+    SECTION("Integer points")
+    {
+        const std::vector<Vector2d<int>> points = { { 3, -2 }, { -5, 8 }, { 10, 1 } };
+        const int xs[] = { 3, -5, 10 };
+        const int ys[] = { -2, 8, 1 };
+        const BoundingBox2d<int> expected = BoundingBox2d<int>::fromCorners(Vector2d<int>(-5, -2), Vector2d<int>(10, 8));
+        CHECK(BoundingBox2d<int>::fromPoints(points.data(), points.size()) == expected);
+        CHECK(BoundingBox2d<int>::fromPoints(xs, ys, 3) == expected);
+        CHECK(BoundingBox2d<int>::fromPoints(points.data(), 1) == BoundingBox2d<int>(3, -2, 0, 0));
+    }
+
+    SECTION("Floating point points, in both layouts")
+    {
+        std::mt19937 rng(4);
+        std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+        std::vector<Vector2d<double>> points;
+        std::vector<double> xs, ys;
+        for (int i = 0; i < 1001; ++i) {
+            points.push_back(Vector2d<double>(dist(rng), dist(rng)));
+            xs.push_back(points.back().x);
+            ys.push_back(points.back().y);
+        }
+
+        // Every prefix length covers the partial registers at the end.
+        for (std::size_t count = 1; count < 40; ++count) {
+            Vector2d<double> minCorner = points[0], maxCorner = points[0];
+            for (std::size_t i = 1; i < count; ++i) {
+                minCorner.set(std::min(minCorner.x, points[i].x), std::min(minCorner.y, points[i].y));
+                maxCorner.set(std::max(maxCorner.x, points[i].x), std::max(maxCorner.y, points[i].y));
+            }
+            const BoundingBox2d<double> expected = BoundingBox2d<double>::fromCorners(minCorner, maxCorner);
+            CHECK(BoundingBox2d<double>::fromPoints(points.data(), count) == expected);
+            CHECK(BoundingBox2d<double>::fromPoints(xs.data(), ys.data(), count) == expected);
+        }
+
+        const BoundingBox2d<double> box = BoundingBox2d<double>::fromPoints(points.data(), points.size());
+        CHECK(box == BoundingBox2d<double>::fromPoints(xs.data(), ys.data(), xs.size()));
+        bool allContained = true;
+        for (const Vector2d<double> & p : points)
+            allContained = allContained && box.contains(p);
+        CHECK(allContained);
+    }
+}
+
+TEST_CASE("BoundingBox2d - compile time use and trivial copying", "[math::BoundingBox2d]")
+{
+    static_assert(std::is_trivially_copyable<BoundingBox2d<int>>::value, "BoundingBox2d<int> should be trivially copyable");
+    static_assert(std::is_trivially_copyable<BoundingBox2d<float>>::value, "BoundingBox2d<float> should be trivially copyable");
+    static_assert(std::is_trivially_copyable<BoundingBox2d<double>>::value, "BoundingBox2d<double> should be trivially copyable");
+
+    constexpr BoundingBox2d<int> box(1, 2, 3, 4);
+    static_assert(box.pos == Vector2d<int>(1, 2) && box.radius == Vector2d<int>(3, 4), "constexpr construction");
+    static_assert(box == BoundingBox2d<int>(Vector2d<int>(1, 2), Vector2d<int>(3, 4)), "constexpr equality");
+    static_assert(box != BoundingBox2d<int>(), "constexpr inequality");
+
+#if AIL_MATH_HAS_CONSTEXPR14
+    static_assert(box.getCornerX1Y1() == Vector2d<int>(-2, -2), "constexpr corner");
+    static_assert(box.getCornerX2Y2() == Vector2d<int>(4, 6), "constexpr corner");
+    static_assert(BoundingBox2d<int> { {1, 2}, {3, 4} } == box, "constexpr initializer list");
+#endif
+
+    const std::vector<BoundingBox2d<float>> src { {{1.0f, 2.0f}, {3.0f, 4.0f}}, {{-5.0f, 6.5f}, {0.5f, 0.25f}} };
+    std::vector<BoundingBox2d<float>> dst(src.size());
+    std::memcpy(dst.data(), src.data(), src.size() * sizeof(BoundingBox2d<float>));
+    CHECK(dst == src);
+}
+
+TEST_CASE("BoundingBox2d - set() modifiers", "[math::BoundingBox2d]")
+{
+    SECTION("Set from vectors")
+    {
+        BoundingBox2d<int> b;
+        b.set(Vector2d<int>(5, -6), Vector2d<int>(7, 8));
+        CHECK(b.pos.x == 5);
+        CHECK(b.pos.y == -6);
+        CHECK(b.radius.x == 7);
+        CHECK(b.radius.y == 8);
+    }
+
+    SECTION("Set from components")
+    {
+        BoundingBox2d<int> b;
+        b.set(-1, 2, 3, 4);
+        CHECK(b.pos.x == -1);
+        CHECK(b.pos.y == 2);
+        CHECK(b.radius.x == 3);
+        CHECK(b.radius.y == 4);
+    }
+}
+
 // TODO: getCornerX() accessors
 // TODO: equality/inequality operators
 // TODO: contains/intersects tests
@@ -0,0 +1,272 @@
+/** \file test_Bvh2d.cpp
+    \brief Unit testing for the Bvh2d bounding volume hierarchy.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Sort a list of indices so results can be compared regardless of order.
+std::vector<std::size_t> sorted(std::vector<std::size_t> indices)
+{
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
+
+// Generate random boxes, including some which are duplicated, thin or inverted.
+std::vector<BoundingBox2d<float>> randomBoxes(std::mt19937 & rng, const std::size_t count)
+{
+    std::uniform_real_distribution<float> coord(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> size(0.0f, 20.0f);
+    std::vector<BoundingBox2d<float>> boxes;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i % 50 == 0)
+            boxes.push_back(BoundingBox2d<float>(12.5f, -7.5f, 3.0f, 3.0f));
+        else if (i % 77 == 0)
+            boxes.push_back(BoundingBox2d<float>(coord(rng), coord(rng), -size(rng), size(rng)));
+        else if (i % 31 == 0)
+            boxes.push_back(BoundingBox2d<float>(coord(rng), coord(rng), 0.0f, size(rng) * 10.0f));
+        else
+            boxes.push_back(BoundingBox2d<float>(coord(rng), coord(rng), size(rng), size(rng)));
+    }
+    return boxes;
+}
+
+// Find the range of t for which a ray is inside a box, by brute force in double precision.
+// Returns false if the ray misses.
+bool bruteRay(const BoundingBox2d<float> & box, const Vector2d<float> & origin, const Vector2d<float> & direction, const float maxT, double & tEntry)
+{
+    double tMin = 0.0, tMax = maxT;
+    const double o[2] = { origin.x, origin.y };
+    const double d[2] = { direction.x, direction.y };
+    const double lo[2] = { box.getCornerX1Y1().x, box.getCornerX1Y1().y };
+    const double hi[2] = { box.getCornerX2Y2().x, box.getCornerX2Y2().y };
+    for (int a = 0; a < 2; ++a) {
+        if (hi[a] < lo[a])
+            return false;
+        if (d[a] == 0.0) {
+            if (o[a] < lo[a] || o[a] > hi[a])
+                return false;
+            continue;
+        }
+        const double t1 = (lo[a] - o[a]) / d[a];
+        const double t2 = (hi[a] - o[a]) / d[a];
+        tMin = std::max(tMin, std::min(t1, t2));
+        tMax = std::min(tMax, std::max(t1, t2));
+    }
+    tEntry = tMin;
+    return tMin <= tMax;
+}
+
+// Check that every kind of query on the tree matches brute force.
+void checkQueries(const Bvh2d<float> & bvh, const std::vector<BoundingBox2d<float>> & boxes, std::mt19937 & rng)
+{
+    std::uniform_real_distribution<float> coord(-550.0f, 550.0f);
+    std::uniform_real_distribution<float> size(0.0f, 50.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+    for (int q = 0; q < 100; ++q) {
+        const BoundingBox2d<float> box(coord(rng), coord(rng), size(rng), size(rng));
+        const Vector2d<float> point = (q % 4 == 0) ? boxes[q].getCornerX2Y1() : Vector2d<float>(coord(rng), coord(rng));
+
+        std::vector<std::size_t> expectedBox, expectedPoint;
+        for (std::size_t i = 0; i < boxes.size(); ++i) {
+            if (boxes[i].intersects(box))
+                expectedBox.push_back(i);
+            if (boxes[i].contains(point))
+                expectedPoint.push_back(i);
+        }
+
+        std::vector<std::size_t> actualBox, actualPoint;
+        bvh.queryBox(box, actualBox);
+        bvh.queryPoint(point, actualPoint);
+        CHECK(sorted(actualBox) == expectedBox);
+        CHECK(sorted(actualPoint) == expectedPoint);
+
+        // Include rays along each axis, which need special handling.
+        const float a = angle(rng);
+        const Vector2d<float> direction = (q % 10 == 0) ? Vector2d<float>(0.0f, 1.0f) :
+            (q % 10 == 1) ? Vector2d<float>(-2.0f, 0.0f) : Vector2d<float>(std::cos(a), std::sin(a));
+        const float maxT = (q % 3 == 0) ? 1e30f : size(rng) * 10.0f;
+
+        // Rays which only graze a box could go either way with rounding, so
+        //  compare the results loosely. The nearest hit is checked exactly.
+        std::vector<std::size_t> actualRay;
+        bvh.queryRay(point, direction, maxT, actualRay);
+        std::sort(actualRay.begin(), actualRay.end());
+        std::size_t nearest = Bvh2d<float>::npos;
+        double nearestT = 0.0;
+        for (std::size_t i = 0; i < boxes.size(); ++i) {
+            double t = 0.0;
+            const bool hit = bruteRay(boxes[i], point, direction, maxT, t);
+            if (hit && (nearest == Bvh2d<float>::npos || t < nearestT)) {
+                nearest = i;
+                nearestT = t;
+            }
+            const bool expanded = bruteRay(BoundingBox2d<float>(boxes[i].pos, boxes[i].radius + Vector2d<float>(0.01f, 0.01f)), point, direction, maxT, t);
+            const bool found = std::binary_search(actualRay.begin(), actualRay.end(), i);
+            if (hit)
+                CHECK(found);
+            if (found)
+                CHECK(expanded);
+        }
+
+        float hitT = -1.0f;
+        const std::size_t first = bvh.raycast(point, direction, maxT, hitT);
+        if (nearest == Bvh2d<float>::npos) {
+            CHECK(first == Bvh2d<float>::npos);
+            CHECK(hitT == -1.0f);
+        } else {
+            REQUIRE(first != Bvh2d<float>::npos);
+            CHECK(hitT == Approx(nearestT).margin(1e-3));
+            CHECK(std::binary_search(actualRay.begin(), actualRay.end(), first));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Bvh2d - construction and accessors", "[math::Bvh2d]")
+{
+    SECTION("Empty on construction")
+    {
+        Bvh2d<float> bvh;
+        CHECK(bvh.empty());
+        CHECK(bvh.size() == 0);
+        CHECK(bvh.getNodeCount() == 0);
+        CHECK(bvh.getMaxLeafSize() == 4);
+
+        std::vector<std::size_t> output;
+        bvh.queryBox(BoundingBox2d<float>(0.0f, 0.0f, 1.0f, 1.0f), output);
+        bvh.queryPoint(Vector2d<float>(0.0f, 0.0f), output);
+        bvh.queryRay(Vector2d<float>(0.0f, 0.0f), Vector2d<float>(1.0f, 0.0f), 10.0f, output);
+        CHECK(output.empty());
+
+        float t = 0.0f;
+        CHECK(bvh.raycast(Vector2d<float>(0.0f, 0.0f), Vector2d<float>(1.0f, 0.0f), 10.0f, t) == Bvh2d<float>::npos);
+    }
+
+    SECTION("Leaf size must be positive")
+    {
+        CHECK_THROWS_AS(Bvh2d<float>(0), std::invalid_argument);
+    }
+
+    SECTION("Build and access")
+    {
+        std::mt19937 rng(1);
+        const std::vector<BoundingBox2d<float>> boxes = randomBoxes(rng, 1000);
+        Bvh2d<float> bvh(boxes.data(), boxes.size(), 2);
+        CHECK(bvh.size() == boxes.size());
+        CHECK(bvh.getMaxLeafSize() == 2);
+        CHECK(bvh.getNodeCount() >= boxes.size() / 2);
+        for (std::size_t i = 0; i < boxes.size(); ++i)
+            CHECK(bvh.getBox(i) == boxes[i]);
+
+        bvh.clear();
+        CHECK(bvh.empty());
+        CHECK(bvh.getNodeCount() == 0);
+    }
+
+    SECTION("Refit requires the same number of boxes")
+    {
+        const BoundingBox2d<float> boxes[2] = { { { 0.0f, 0.0f }, { 1.0f, 1.0f } }, { { 5.0f, 0.0f }, { 1.0f, 1.0f } } };
+        Bvh2d<float> bvh(boxes, 2);
+        CHECK_THROWS_AS(bvh.refit(boxes, 1), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Bvh2d - queries match brute force", "[math::Bvh2d]")
+{
+    std::mt19937 rng(2);
+    std::vector<BoundingBox2d<float>> boxes = randomBoxes(rng, 3000);
+
+    SECTION("After building")
+    {
+        for (const std::size_t leafSize : { std::size_t(1), std::size_t(4), std::size_t(16) }) {
+            const Bvh2d<float> bvh(boxes.data(), boxes.size(), leafSize);
+            checkQueries(bvh, boxes, rng);
+        }
+    }
+
+    SECTION("After refitting")
+    {
+        Bvh2d<float> bvh(boxes.data(), boxes.size());
+        std::uniform_real_distribution<float> offset(-30.0f, 30.0f);
+        for (auto & box : boxes) {
+            box.pos += Vector2d<float>(offset(rng), offset(rng));
+            box.radius *= 1.5f;
+        }
+        bvh.refit(boxes.data(), boxes.size());
+        for (std::size_t i = 0; i < boxes.size(); ++i)
+            CHECK(bvh.getBox(i) == boxes[i]);
+        checkQueries(bvh, boxes, rng);
+    }
+
+    SECTION("Boxes which all have the same centre")
+    {
+        std::vector<BoundingBox2d<float>> same;
+        for (int i = 0; i < 200; ++i)
+            same.push_back(BoundingBox2d<float>(1.0f, 2.0f, i * 0.5f, 100.0f - i * 0.5f));
+        const Bvh2d<float> bvh(same.data(), same.size());
+
+        std::vector<std::size_t> output;
+        bvh.queryPoint(Vector2d<float>(1.0f, 2.0f), output);
+        CHECK(output.size() == same.size());
+        output.clear();
+        bvh.queryPoint(Vector2d<float>(80.0f, 2.0f), output);
+        CHECK(output.size() == 42);
+    }
+}
+
+TEST_CASE("Bvh2d - rounding and integer types", "[math::Bvh2d]")
+{
+    SECTION("Boxes which only just touch are found")
+    {
+        // These intersect according to BoundingBox2d, even though the edges
+        //  calculated from them don't quite meet.
+        const BoundingBox2d<float> boxes[3] = {
+            { { 0.1f, 0.0f }, { 0.2f, 1.0f } },
+            { { 1e6f, 1e6f }, { 0.5f, 0.5f } },
+            { { -30.0f, 4.0f }, { 1.0f, 1.0f } }
+        };
+        const Bvh2d<float> bvh(boxes, 3, 1);
+        for (int b = 0; b < 3; ++b) {
+            for (float dx = -2.0f; dx <= 2.0f; dx += 0.125f) {
+                const BoundingBox2d<float> query(boxes[b].pos.x + boxes[b].radius.x + 0.7f + dx * 1e-7f * (b == 1 ? 1e6f : 1.0f), boxes[b].pos.y, 0.7f, 0.1f);
+                std::vector<std::size_t> output;
+                bvh.queryBox(query, output);
+                CHECK(std::count(output.begin(), output.end(), std::size_t(b)) == (boxes[b].intersects(query) ? 1 : 0));
+            }
+        }
+    }
+
+    SECTION("Integer boxes")
+    {
+        std::vector<BoundingBox2d<int>> boxes;
+        for (int y = 0; y < 30; ++y) {
+            for (int x = 0; x < 30; ++x)
+                boxes.push_back(BoundingBox2d<int>(x * 10, y * 10, 5, 5));
+        }
+        const Bvh2d<int> bvh(boxes.data(), boxes.size());
+
+        std::vector<std::size_t> output;
+        bvh.queryBox(BoundingBox2d<int>(100, 100, 5, 5), output);
+        CHECK(output.size() == 9);
+        output.clear();
+        bvh.queryPoint(Vector2d<int>(15, 0), output);
+        CHECK(sorted(output) == std::vector<std::size_t>({ 1, 2 }));
+    }
+}
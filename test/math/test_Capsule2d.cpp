@@ -0,0 +1,151 @@
+/** \file test_Capsule2d.cpp
+    \brief Unit testing for the Capsule2d class.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <type_traits>
+
+using namespace ail::math;
+
+TEST_CASE("Capsule2d - construction and accessors", "[math::Capsule2d]")
+{
+    SECTION("Default construction initialises to 0")
+    {
+        const Capsule2d<float> capsule;
+        CHECK(capsule.start == Vector2d<float>());
+        CHECK(capsule.end == Vector2d<float>());
+        CHECK(capsule.radius == 0.0f);
+    }
+
+    SECTION("Construction from the ends and radius")
+    {
+        const Capsule2d<double> capsule(Vector2d<double>(1.0, 2.0), Vector2d<double>(5.0, -2.0), 0.5);
+        CHECK(capsule.start == Vector2d<double>(1.0, 2.0));
+        CHECK(capsule.end == Vector2d<double>(5.0, -2.0));
+        CHECK(capsule.radius == 0.5);
+        CHECK(capsule == Capsule2d<double>(Vector2d<double>(1.0, 2.0), Vector2d<double>(5.0, -2.0), 0.5));
+        CHECK(capsule != Capsule2d<double>(Vector2d<double>(5.0, -2.0), Vector2d<double>(1.0, 2.0), 0.5));
+    }
+
+    SECTION("Bounds")
+    {
+        const Capsule2d<double> capsule(Vector2d<double>(1.0, 2.0), Vector2d<double>(5.0, -2.0), 0.5);
+        const BoundingBox2d<double> bounds = capsule.getBounds();
+        CHECK(bounds.getCornerX1Y1() == Vector2d<double>(0.5, -2.5));
+        CHECK(bounds.getCornerX2Y2() == Vector2d<double>(5.5, 2.5));
+    }
+
+    SECTION("Closest point on the central segment")
+    {
+        const Capsule2d<double> capsule(Vector2d<double>(-2.0, 0.0), Vector2d<double>(2.0, 0.0), 0.5);
+        CHECK(capsule.getClosestPoint(Vector2d<double>(1.0, 3.0)) == Vector2d<double>(1.0, 0.0));
+        CHECK(capsule.getClosestPoint(Vector2d<double>(-5.0, -1.0)) == Vector2d<double>(-2.0, 0.0));
+        CHECK(capsule.getClosestPoint(Vector2d<double>(4.0, 1.0)) == Vector2d<double>(2.0, 0.0));
+
+        // With both ends in the same place, it's a circle.
+        const Capsule2d<double> point(Vector2d<double>(1.0, 1.0), Vector2d<double>(1.0, 1.0), 0.5);
+        CHECK(point.getClosestPoint(Vector2d<double>(4.0, 1.0)) == Vector2d<double>(1.0, 1.0));
+    }
+
+    SECTION("Compile time use and trivial copying")
+    {
+        static_assert(std::is_trivially_copyable<Capsule2d<float>>::value, "Capsule2d<float> should be trivially copyable");
+        constexpr Capsule2d<float> capsule(Vector2d<float>(1.0f, 2.0f), Vector2d<float>(3.0f, 4.0f), 0.5f);
+        static_assert(capsule == Capsule2d<float>(Vector2d<float>(1.0f, 2.0f), Vector2d<float>(3.0f, 4.0f), 0.5f), "constexpr equality");
+    }
+}
+
+TEST_CASE("Capsule2d - containing points", "[math::Capsule2d]")
+{
+    const Capsule2d<double> capsule(Vector2d<double>(-2.0, 0.0), Vector2d<double>(2.0, 0.0), 0.5);
+    CHECK(capsule.contains(Vector2d<double>(0.0, 0.0)));
+    CHECK(capsule.contains(Vector2d<double>(0.0, 0.5)));
+    CHECK(capsule.contains(Vector2d<double>(-1.5, -0.25)));
+    CHECK(capsule.contains(Vector2d<double>(2.25, 0.25)));
+    CHECK_FALSE(capsule.contains(Vector2d<double>(0.0, 0.75)));
+    CHECK_FALSE(capsule.contains(Vector2d<double>(2.5, 0.25)));
+    CHECK_FALSE(capsule.contains(Vector2d<double>(-2.5, 0.5)));
+}
+
+TEST_CASE("Capsule2d - collisions", "[math::Capsule2d]")
+{
+    const Capsule2d<double> a(Vector2d<double>(-2.0, 0.0), Vector2d<double>(2.0, 0.0), 0.5);
+    Contact2d<double> contact;
+
+    SECTION("Parallel capsules give two points along the overlapping part")
+    {
+        const Capsule2d<double> b(Vector2d<double>(1.0, 0.75), Vector2d<double>(5.0, 0.75), 0.5);
+        CHECK(a.intersects(b));
+        REQUIRE(a.getContact(b, contact));
+        CHECK(contact.normal == Vector2d<double>(0.0, 1.0));
+        CHECK(contact.depth == 0.25);
+        REQUIRE(contact.pointCount == 2);
+        CHECK(contact.points[0] == Vector2d<double>(2.0, 0.375));
+        CHECK(contact.points[1] == Vector2d<double>(1.0, 0.375));
+    }
+
+    SECTION("Capsules meeting end to end")
+    {
+        const Capsule2d<double> b(Vector2d<double>(2.5, 0.0), Vector2d<double>(6.0, 0.0), 0.5);
+        CHECK(a.intersects(b));
+        REQUIRE(a.getContact(b, contact));
+        CHECK(contact.normal == Vector2d<double>(1.0, 0.0));
+        CHECK(contact.depth == 0.5);
+        REQUIRE(contact.pointCount == 1);
+        CHECK(contact.points[0] == Vector2d<double>(2.25, 0.0));
+    }
+
+    SECTION("Crossing capsules")
+    {
+        const Capsule2d<double> b(Vector2d<double>(1.0, -1.0), Vector2d<double>(1.0, 3.0), 0.25);
+        CHECK(a.intersects(b));
+        REQUIRE(a.getContact(b, contact));
+        CHECK(contact.normal.getLength() == Approx(1.0));
+        CHECK(contact.depth > 0.0);
+        CHECK(contact.pointCount >= 1);
+    }
+
+    SECTION("Capsules which are apart")
+    {
+        const Capsule2d<double> b(Vector2d<double>(2.5, 1.0), Vector2d<double>(4.0, 3.0), 0.5);
+        CHECK_FALSE(a.intersects(b));
+        CHECK_FALSE(a.getContact(b, contact));
+        CHECK(contact.pointCount == 0);
+    }
+
+    SECTION("Capsule lying on a box")
+    {
+        const OrientedBox2d<double> box(Vector2d<double>(0.0, -1.5), Vector2d<double>(2.0, 1.0), Vector2d<double>(1.0, 0.0));
+        CHECK(a.intersects(box));
+        REQUIRE(a.getContact(box, contact));
+        CHECK(contact.normal == Vector2d<double>(0.0, -1.0));
+        CHECK(contact.depth == 0.0);
+        CHECK(contact.pointCount == 2);
+
+        REQUIRE(box.getContact(a, contact));
+        CHECK(contact.normal == Vector2d<double>(0.0, 1.0));
+        CHECK(contact.depth == 0.0);
+        REQUIRE(contact.pointCount == 2);
+        CHECK(contact.points[0] == Vector2d<double>(2.0, -0.5));
+        CHECK(contact.points[1] == Vector2d<double>(-2.0, -0.5));
+    }
+
+    SECTION("Capsule standing on its end on a box")
+    {
+        const Capsule2d<double> standing(Vector2d<double>(0.0, 0.75), Vector2d<double>(0.0, 3.0), 1.0);
+        const OrientedBox2d<double> box(Vector2d<double>(0.0, -1.0), Vector2d<double>(2.0, 1.0), Vector2d<double>(1.0, 0.0));
+        CHECK(standing.intersects(box));
+        REQUIRE(standing.getContact(box, contact));
+        CHECK(contact.normal == Vector2d<double>(0.0, -1.0));
+        CHECK(contact.depth == 0.25);
+        REQUIRE(contact.pointCount == 1);
+        CHECK(contact.points[0] == Vector2d<double>(0.0, -0.125));
+    }
+}
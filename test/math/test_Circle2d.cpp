@@ -0,0 +1,164 @@
+/** \file test_Circle2d.cpp
+    \brief Unit testing for the Circle2d class.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <cmath>
+#include <type_traits>
+
+using namespace ail::math;
+
+TEST_CASE("Circle2d - construction and accessors", "[math::Circle2d]")
+{
+    SECTION("Default construction initialises to 0")
+    {
+        const Circle2d<float> circle;
+        CHECK(circle.pos == Vector2d<float>());
+        CHECK(circle.radius == 0.0f);
+    }
+
+    SECTION("Construction from a centre and radius")
+    {
+        const Circle2d<double> circle(Vector2d<double>(1.0, 2.0), 3.0);
+        CHECK(circle.pos == Vector2d<double>(1.0, 2.0));
+        CHECK(circle.radius == 3.0);
+        CHECK(circle == Circle2d<double>(Vector2d<double>(1.0, 2.0), 3.0));
+        CHECK(circle != Circle2d<double>(Vector2d<double>(1.0, 2.0), 4.0));
+    }
+
+    SECTION("Bounds")
+    {
+        const Circle2d<double> circle(Vector2d<double>(1.0, 2.0), 3.0);
+        CHECK(circle.getBounds() == BoundingBox2d<double>(1.0, 2.0, 3.0, 3.0));
+    }
+
+    SECTION("Compile time use and trivial copying")
+    {
+        static_assert(std::is_trivially_copyable<Circle2d<float>>::value, "Circle2d<float> should be trivially copyable");
+        constexpr Circle2d<float> circle(Vector2d<float>(1.0f, 2.0f), 3.0f);
+        static_assert(circle == Circle2d<float>(Vector2d<float>(1.0f, 2.0f), 3.0f), "constexpr equality");
+    }
+}
+
+TEST_CASE("Circle2d - containing points", "[math::Circle2d]")
+{
+    const Circle2d<double> circle(Vector2d<double>(1.0, 2.0), 2.0);
+    CHECK(circle.contains(Vector2d<double>(1.0, 2.0)));
+    CHECK(circle.contains(Vector2d<double>(2.0, 3.0)));
+    CHECK(circle.contains(Vector2d<double>(3.0, 2.0)));
+    CHECK_FALSE(circle.contains(Vector2d<double>(3.0, 3.0)));
+    CHECK_FALSE(circle.contains(Vector2d<double>(-1.5, 2.0)));
+}
+
+TEST_CASE("Circle2d - circle collisions", "[math::Circle2d]")
+{
+    const Circle2d<double> a(Vector2d<double>(0.0, 0.0), 1.0);
+    Contact2d<double> contact;
+
+    SECTION("Overlapping circles give one point between the surfaces")
+    {
+        const Circle2d<double> b(Vector2d<double>(1.5, 0.0), 1.0);
+        CHECK(a.intersects(b));
+        REQUIRE(a.getContact(b, contact));
+        CHECK(contact.normal == Vector2d<double>(1.0, 0.0));
+        CHECK(contact.depth == 0.5);
+        REQUIRE(contact.pointCount == 1);
+        CHECK(contact.points[0] == Vector2d<double>(0.75, 0.0));
+
+        // The other way round reverses the normal.
+        REQUIRE(b.getContact(a, contact));
+        CHECK(contact.normal == Vector2d<double>(-1.0, 0.0));
+        CHECK(contact.depth == 0.5);
+        CHECK(contact.points[0] == Vector2d<double>(0.75, 0.0));
+    }
+
+    SECTION("Touching counts as an intersection")
+    {
+        const Circle2d<double> b(Vector2d<double>(0.0, -2.0), 1.0);
+        CHECK(a.intersects(b));
+        REQUIRE(a.getContact(b, contact));
+        CHECK(contact.normal == Vector2d<double>(0.0, -1.0));
+        CHECK(contact.depth == 0.0);
+        CHECK(contact.points[0] == Vector2d<double>(0.0, -1.0));
+    }
+
+    SECTION("Circles which are apart don't intersect, and the contact isn't changed")
+    {
+        const Circle2d<double> b(Vector2d<double>(2.0, 1.0), 1.0);
+        contact.depth = -1.0;
+        CHECK_FALSE(a.intersects(b));
+        CHECK_FALSE(a.getContact(b, contact));
+        CHECK(contact.depth == -1.0);
+        CHECK(contact.pointCount == 0);
+    }
+
+    SECTION("Circles with the same centre still get a unit normal")
+    {
+        const Circle2d<double> b(Vector2d<double>(0.0, 0.0), 0.5);
+        REQUIRE(a.getContact(b, contact));
+        CHECK(contact.normal.getLength() == 1.0);
+        CHECK(contact.depth == 1.5);
+    }
+}
+
+TEST_CASE("Circle2d - collisions with other shapes", "[math::Circle2d]")
+{
+    const OrientedBox2d<double> box(Vector2d<double>(0.0, 0.0), Vector2d<double>(2.0, 1.0), Vector2d<double>(1.0, 0.0));
+    Contact2d<double> contact;
+
+    SECTION("Circle resting on a side of a box")
+    {
+        const Circle2d<double> circle(Vector2d<double>(0.0, 1.5), 1.0);
+        CHECK(circle.intersects(box));
+        REQUIRE(circle.getContact(box, contact));
+        CHECK(contact.normal == Vector2d<double>(0.0, -1.0));
+        CHECK(contact.depth == 0.5);
+        REQUIRE(contact.pointCount == 1);
+        CHECK(contact.points[0] == Vector2d<double>(0.0, 0.75));
+    }
+
+    SECTION("Circle touching a corner of a box")
+    {
+        const Circle2d<double> circle(Vector2d<double>(3.0, 2.0), 1.5);
+        CHECK(circle.intersects(box));
+        REQUIRE(circle.getContact(box, contact));
+        CHECK(contact.normal.x == Approx(-std::sqrt(0.5)));
+        CHECK(contact.normal.y == Approx(-std::sqrt(0.5)));
+        CHECK(contact.depth == Approx(1.5 - std::sqrt(2.0)));
+        CHECK(contact.pointCount == 1);
+
+        const Circle2d<double> apart(Vector2d<double>(3.0, 2.0), 1.4);
+        CHECK_FALSE(apart.intersects(box));
+        CHECK_FALSE(apart.getContact(box, contact));
+    }
+
+    SECTION("Circle centred inside a box")
+    {
+        const Circle2d<double> circle(Vector2d<double>(1.5, 0.0), 0.25);
+        CHECK(circle.intersects(box));
+        REQUIRE(circle.getContact(box, contact));
+        CHECK(contact.normal == Vector2d<double>(-1.0, 0.0));
+        CHECK(contact.depth == 0.75);
+    }
+
+    SECTION("Circle next to the end of a capsule")
+    {
+        const Capsule2d<double> capsule(Vector2d<double>(-2.0, 0.0), Vector2d<double>(2.0, 0.0), 0.5);
+        const Circle2d<double> circle(Vector2d<double>(3.0, 0.0), 0.75);
+        CHECK(circle.intersects(capsule));
+        REQUIRE(circle.getContact(capsule, contact));
+        CHECK(contact.normal == Vector2d<double>(-1.0, 0.0));
+        CHECK(contact.depth == 0.25);
+        REQUIRE(contact.pointCount == 1);
+        CHECK(contact.points[0] == Vector2d<double>(2.375, 0.0));
+
+        CHECK_FALSE(Circle2d<double>(Vector2d<double>(3.0, 1.0), 0.75).intersects(capsule));
+    }
+}
@@ -0,0 +1,123 @@
+/** \file test_Contact2d.cpp
+    \brief Unit testing for the Contact2d class, and the narrow phase tests which fill it in.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <cmath>
+#include <random>
+#include <type_traits>
+
+using namespace ail::math;
+
+namespace
+{
+    // Move a shape by the given offset.
+    Circle2d<double> translate(const Circle2d<double> & circle, const Vector2d<double> & offset)
+    {
+        return Circle2d<double>(circle.pos + offset, circle.radius);
+    }
+
+    Capsule2d<double> translate(const Capsule2d<double> & capsule, const Vector2d<double> & offset)
+    {
+        return Capsule2d<double>(capsule.start + offset, capsule.end + offset, capsule.radius);
+    }
+
+    OrientedBox2d<double> translate(const OrientedBox2d<double> & box, const Vector2d<double> & offset)
+    {
+        return OrientedBox2d<double>(box.pos + offset, box.radius, box.axis);
+    }
+
+    // Check that a pair of shapes gives a consistent result, whichever test is used.
+    // Returns true if they intersect.
+    template <typename T_a, typename T_b>
+    bool checkPair(const T_a & a, const T_b & b)
+    {
+        Contact2d<double> contact;
+        const bool hit = a.getContact(b, contact);
+        CHECK(a.intersects(b) == hit);
+        CHECK(b.intersects(a) == hit);
+        if (!hit)
+            return false;
+
+        CHECK(contact.normal.getLength() == Approx(1.0));
+        CHECK(contact.depth >= 0.0);
+        CHECK(contact.pointCount >= 1u);
+        CHECK(contact.pointCount <= 2u);
+
+        // Moving the second shape along the normal by the depth separates them.
+        CHECK_FALSE(a.intersects(translate(b, contact.normal * (contact.depth + 1e-6))));
+
+        // Testing the other way round gives the opposite normal.
+        Contact2d<double> reversed;
+        REQUIRE(b.getContact(a, reversed));
+        CHECK(reversed.depth == Approx(contact.depth).margin(1e-9));
+        CHECK(reversed.normal.x == Approx(-contact.normal.x).margin(1e-9));
+        CHECK(reversed.normal.y == Approx(-contact.normal.y).margin(1e-9));
+        return true;
+    }
+}
+
+TEST_CASE("Contact2d - construction", "[math::Contact2d]")
+{
+    SECTION("Default construction initialises to 0, with no points")
+    {
+        const Contact2d<float> contact;
+        CHECK(contact.normal == Vector2d<float>());
+        CHECK(contact.depth == 0.0f);
+        CHECK(contact.points[0] == Vector2d<float>());
+        CHECK(contact.points[1] == Vector2d<float>());
+        CHECK(contact.pointCount == 0);
+    }
+
+    SECTION("Compile time use and trivial copying")
+    {
+        static_assert(std::is_trivially_copyable<Contact2d<float>>::value, "Contact2d<float> should be trivially copyable");
+        constexpr Contact2d<float> contact;
+        static_assert(contact.pointCount == 0, "constexpr construction");
+    }
+}
+
+TEST_CASE("Contact2d - random pairs of shapes", "[math::Contact2d]")
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> coord(-4.0, 4.0);
+    std::uniform_real_distribution<double> size(0.1, 2.0);
+    std::uniform_real_distribution<double> angle(-3.14159, 3.14159);
+
+    const auto makeCircle = [&]() {
+        return Circle2d<double>(Vector2d<double>(coord(rng), coord(rng)), size(rng));
+    };
+    const auto makeCapsule = [&]() {
+        const Vector2d<double> start(coord(rng), coord(rng));
+        const double a = angle(rng), length = size(rng) * 2.0;
+        return Capsule2d<double>(start, start + Vector2d<double>(std::cos(a) * length, std::sin(a) * length), size(rng));
+    };
+    const auto makeBox = [&]() {
+        return OrientedBox2d<double>::fromAngle(Vector2d<double>(coord(rng), coord(rng)), Vector2d<double>(size(rng), size(rng)), angle(rng));
+    };
+
+    unsigned hits = 0;
+    for (unsigned i = 0; i < 200; ++i) {
+        const Circle2d<double> circle1 = makeCircle(), circle2 = makeCircle();
+        const Capsule2d<double> capsule1 = makeCapsule(), capsule2 = makeCapsule();
+        const OrientedBox2d<double> box1 = makeBox(), box2 = makeBox();
+
+        hits += checkPair(circle1, circle2) ? 1 : 0;
+        hits += checkPair(circle1, capsule1) ? 1 : 0;
+        hits += checkPair(circle1, box1) ? 1 : 0;
+        hits += checkPair(capsule1, capsule2) ? 1 : 0;
+        hits += checkPair(capsule1, box1) ? 1 : 0;
+        hits += checkPair(box1, box2) ? 1 : 0;
+    }
+
+    // Make sure the test covers both outcomes.
+    CHECK(hits > 100);
+    CHECK(hits < 1100);
+}
@@ -0,0 +1,153 @@
+/** \file test_Cordic.cpp
+    \brief Unit testing for the CORDIC trig functions.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+
+using namespace ail::math;
+
+namespace {
+
+// Get the largest absolute error of cordicSinCos compared to the standard library.
+template <int T_iterations, typename T_ty>
+double worstSinCosError()
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> large(-1e6, 1e6);
+    std::uniform_real_distribution<double> small(-10.0, 10.0);
+
+    double worst = 0.0;
+    for (int i = 0; i < 100000; ++i) {
+        const T_ty angle = static_cast<T_ty>((i % 2) ? large(rng) : small(rng));
+        T_ty s, c;
+        cordicSinCos<T_iterations>(angle, s, c);
+        worst = std::max(worst, std::fabs(s - std::sin(static_cast<double>(angle))));
+        worst = std::max(worst, std::fabs(c - std::cos(static_cast<double>(angle))));
+    }
+    return worst;
+}
+
+// Get the largest absolute error of cordicAtan2, and the largest relative error of cordicHypot.
+template <int T_iterations, typename T_ty>
+void worstAtan2HypotError(double & atan2Error, double & hypotError)
+{
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+
+    atan2Error = 0.0;
+    hypotError = 0.0;
+    for (int i = 0; i < 100000; ++i) {
+        const T_ty y = static_cast<T_ty>(dist(rng));
+        const T_ty x = static_cast<T_ty>(dist(rng));
+        const double exactLength = std::hypot(static_cast<double>(x), static_cast<double>(y));
+        atan2Error = std::max(atan2Error, std::fabs(cordicAtan2<T_iterations>(y, x) - std::atan2(static_cast<double>(y), static_cast<double>(x))));
+        hypotError = std::max(hypotError, std::fabs(cordicHypot<T_iterations>(x, y) - exactLength) / exactLength);
+    }
+}
+
+} // namespace
+
+TEST_CASE("Cordic - sin and cos", "[math::Cordic]")
+{
+    SECTION("Accuracy improves with the number of iterations")
+    {
+        CHECK(worstSinCosError<8, float>() <= std::ldexp(1.0, -6));
+        CHECK(worstSinCosError<16, float>() <= std::ldexp(1.0, -14));
+        CHECK(worstSinCosError<16, double>() <= std::ldexp(1.0, -14));
+        CHECK(worstSinCosError<24, double>() <= std::ldexp(1.0, -22));
+        CHECK(worstSinCosError<30, double>() <= std::ldexp(1.0, -26));
+        CHECK(worstSinCosError<30, float>() <= std::ldexp(1.0, -23));
+    }
+
+    SECTION("Quadrants")
+    {
+        for (int q = -8; q <= 8; ++q) {
+            double s, c;
+            cordicSinCos<30>(q * pi<double>() * 0.5, s, c);
+            CHECK(s == Approx(std::sin(q * pi<double>() * 0.5)).margin(1e-8));
+            CHECK(c == Approx(std::cos(q * pi<double>() * 0.5)).margin(1e-8));
+        }
+    }
+
+    SECTION("Zero")
+    {
+        float s, c;
+        cordicSinCos<30>(0.0f, s, c);
+        CHECK(std::fabs(s) < 1e-8f);
+        CHECK(c == Approx(1.0f));
+    }
+}
+
+TEST_CASE("Cordic - atan2 and hypot", "[math::Cordic]")
+{
+    SECTION("Accuracy improves with the number of iterations")
+    {
+        double atan2Error, hypotError;
+        worstAtan2HypotError<8, float>(atan2Error, hypotError);
+        CHECK(atan2Error <= std::ldexp(1.0, -6));
+        CHECK(hypotError <= std::ldexp(1.0, -14));
+        worstAtan2HypotError<16, double>(atan2Error, hypotError);
+        CHECK(atan2Error <= std::ldexp(1.0, -14));
+        CHECK(hypotError <= std::ldexp(1.0, -30));
+        worstAtan2HypotError<30, double>(atan2Error, hypotError);
+        CHECK(atan2Error <= std::ldexp(1.0, -27));
+        CHECK(hypotError <= std::ldexp(1.0, -32));
+        worstAtan2HypotError<30, float>(atan2Error, hypotError);
+        CHECK(atan2Error <= std::ldexp(1.0, -22));
+        CHECK(hypotError <= std::ldexp(1.0, -23));
+    }
+
+    SECTION("Axes and quadrants")
+    {
+        CHECK(cordicAtan2<30>(0.0, 1.0) == Approx(0.0).margin(1e-8));
+        CHECK(cordicAtan2<30>(1.0, 0.0) == Approx(pi<double>() * 0.5));
+        CHECK(cordicAtan2<30>(-1.0, 0.0) == Approx(-pi<double>() * 0.5));
+        CHECK(cordicAtan2<30>(0.0, -1.0) == Approx(pi<double>()));
+        CHECK(cordicAtan2<30>(1.0, -1.0) == Approx(pi<double>() * 0.75));
+        CHECK(cordicAtan2<30>(-1.0, -1.0) == Approx(-pi<double>() * 0.75));
+        CHECK(cordicAtan2<30>(0.0f, 0.0f) == 0.0f);
+        CHECK(cordicHypot<30>(0.0f, 0.0f) == 0.0f);
+    }
+
+    SECTION("Very large and very small vectors are scaled exactly")
+    {
+        CHECK(cordicHypot<30>(3e300, 4e300) == Approx(5e300));
+        CHECK(cordicHypot<30>(-3e-300, 4e-300) == Approx(5e-300));
+        CHECK(cordicHypot<30>(3e-30f, -4e-30f) == Approx(5e-30f));
+        CHECK(cordicAtan2<30>(4e-300, 3e-300) == Approx(std::atan2(4.0, 3.0)));
+    }
+
+    SECTION("Angle and length together match the separate functions")
+    {
+        float angle, length;
+        cordicAtan2Hypot<20>(-7.5f, 2.25f, angle, length);
+        CHECK(angle == cordicAtan2<20>(-7.5f, 2.25f));
+        CHECK(length == cordicHypot<20>(2.25f, -7.5f));
+    }
+}
+
+TEST_CASE("Cordic - fixed point core", "[math::Cordic]")
+{
+    // atan2 is the same for any scale of the inputs.
+    CHECK(cordic::atan2<30>(3, 4) == cordic::atan2<30>(3LL << 40, 4LL << 40));
+    CHECK(cordic::atan2<30>(0, 0) == 0);
+    CHECK(std::abs(cordic::atan2<30>(0, -5) - cordic::Tables<>::pi) <= 4);
+
+    // sin and cos of pi/2 with all 30 iterations. Each iteration can add a little rounding error.
+    std::int64_t s, c;
+    cordic::sinCos<30>(cordic::Tables<>::halfPi, s, c);
+    CHECK(std::abs(s - (std::int64_t(1) << cordic::fracBits)) <= 16);
+    CHECK(std::abs(c) <= 16);
+}
@@ -0,0 +1,348 @@
+/** \file test_Fixed.cpp
+    \brief Unit testing for the fixed point number type, and its use in Vector2d and Polar.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+
+using namespace ail::math;
+
+namespace {
+
+typedef Fixed<16, 16> Fx;
+typedef Fixed<8, 8> Fx8;
+
+// Get the size of one step of Fx as a double.
+const double step = 1.0 / 65536.0;
+
+} // namespace
+
+TEST_CASE("Fixed - construction and conversion", "[math::Fixed]")
+{
+    SECTION("Storage")
+    {
+        CHECK(sizeof(Fx) == 4);
+        CHECK(sizeof(Fx8) == 2);
+        CHECK(std::is_trivially_copyable<Fx>::value);
+        CHECK(isReal<Fx>::value);
+        CHECK_FALSE(isReal<int>::value);
+        CHECK(isReal<double>::value);
+    }
+
+    SECTION("From integers")
+    {
+        CHECK(Fx().raw == 0);
+        CHECK(Fx(1).raw == 65536);
+        CHECK(Fx(-3).raw == -196608);
+        CHECK(Fx8(5).raw == 1280);
+        CHECK(static_cast<int>(Fx(-7)) == -7);
+    }
+
+    SECTION("From floating point")
+    {
+        CHECK(Fx(0.5).raw == 32768);
+        CHECK(Fx(-0.25f).raw == -16384);
+        CHECK(static_cast<double>(Fx(1.1)) == Approx(1.1).margin(step));
+
+        // Rounding to the nearest step, with halfway cases away from zero.
+        CHECK(Fx(step * 0.49).raw == 0);
+        CHECK(Fx(step * 0.5).raw == 1);
+        CHECK(Fx(-step * 0.5).raw == -1);
+        CHECK(Fx(step * 2.6).raw == 3);
+    }
+
+    SECTION("To integers truncates towards zero")
+    {
+        CHECK(static_cast<int>(Fx(2.75)) == 2);
+        CHECK(static_cast<int>(Fx(-2.75)) == -2);
+        CHECK(static_cast<long long>(Fx(0.999)) == 0);
+    }
+
+    SECTION("Limits")
+    {
+        CHECK(Fx::epsilon().raw == 1);
+        CHECK(Fx::max().raw == 2147483647);
+        CHECK(Fx::lowest().raw == -2147483647 - 1);
+        CHECK(Fx8::max().raw == 32767);
+        CHECK(static_cast<double>(Fx::max()) == Approx(32768.0 - step));
+    }
+}
+
+TEST_CASE("Fixed - arithmetic", "[math::Fixed]")
+{
+    SECTION("Addition and subtraction")
+    {
+        CHECK(Fx(1.5) + Fx(2.25) == Fx(3.75));
+        CHECK(Fx(1.5) - Fx(2.25) == Fx(-0.75));
+        CHECK(Fx(3) + 2 == Fx(5));
+        CHECK(2 - Fx(0.5) == Fx(1.5));
+        CHECK(-Fx(4.5) == Fx(-4.5));
+
+        Fx a(1);
+        a += Fx(0.5);
+        a -= 3;
+        CHECK(a == Fx(-1.5));
+    }
+
+    SECTION("Multiplication rounds to nearest")
+    {
+        CHECK(Fx(1.5) * Fx(-4) == Fx(-6));
+        CHECK(Fx(0.5) * Fx(0.5) == Fx(0.25));
+        CHECK((Fx::epsilon() * Fx(0.5)).raw == 1);
+        CHECK((Fx::epsilon() * Fx(0.25)).raw == 0);
+        CHECK((Fx::epsilon() * Fx(-0.75)).raw == -1);
+        CHECK(3 * Fx(0.25) == Fx(0.75));
+
+        Fx a(2);
+        a *= Fx(-1.25);
+        CHECK(a == Fx(-2.5));
+    }
+
+    SECTION("Division truncates towards zero")
+    {
+        CHECK(Fx(7) / Fx(2) == Fx(3.5));
+        CHECK(Fx(-1) / Fx(4) == Fx(-0.25));
+        CHECK((Fx(1) / Fx(3)).raw == 21845);
+        CHECK((Fx(-1) / Fx(3)).raw == -21845);
+
+        Fx a(9);
+        a /= 2;
+        CHECK(a == Fx(4.5));
+    }
+
+    SECTION("Comparisons")
+    {
+        CHECK(Fx(1) < Fx(1.5));
+        CHECK(Fx(-2) <= -2);
+        CHECK(Fx(0.1) > 0);
+        CHECK(Fx(3) >= Fx(2.999));
+        CHECK(Fx(0.5) != Fx(-0.5));
+        CHECK(Fx(4) == 4);
+    }
+
+    SECTION("Results wrap round if they're out of range")
+    {
+        CHECK(Fx8::max() + Fx8::epsilon() == Fx8::lowest());
+        CHECK(Fx::lowest() - Fx::epsilon() == Fx::max());
+    }
+
+    SECTION("Remainder is exact")
+    {
+        CHECK(tmod<Fx>::mod(Fx(7.5), Fx(2)) == Fx(1.5));
+        CHECK(tmod<Fx>::mod(Fx(-7.5), Fx(2)) == Fx(-1.5));
+        CHECK(wrap(Fx(-1), Fx(0), Fx(360)) == Fx(359));
+    }
+}
+
+TEST_CASE("Fixed - maths functions", "[math::Fixed]")
+{
+    SECTION("abs")
+    {
+        CHECK(abs(Fx(-2.5)) == Fx(2.5));
+        CHECK(abs(Fx(2.5)) == Fx(2.5));
+        CHECK(abs(Fx()) == Fx());
+    }
+
+    SECTION("sqrt of exact squares")
+    {
+        CHECK(sqrt(Fx(0)) == Fx(0));
+        CHECK(sqrt(Fx(1)) == Fx(1));
+        CHECK(sqrt(Fx(16)) == Fx(4));
+        CHECK(sqrt(Fx(2.25)) == Fx(1.5));
+        CHECK(sqrt(Fx(10000)) == Fx(100));
+        CHECK(sqrt(Fx(-4)) == Fx(0));
+        CHECK(sqrt(Fx8(9)) == Fx8(3));
+    }
+
+    SECTION("sqrt rounds to the nearest step")
+    {
+        std::mt19937 rng(1);
+        std::uniform_int_distribution<std::int32_t> raws(1, 2147483647);
+        for (int i = 0; i < 10000; ++i) {
+            const Fx value = Fx::fromRaw(raws(rng));
+            const double expected = std::sqrt(static_cast<double>(value));
+            CHECK(std::fabs(static_cast<double>(sqrt(value)) - expected) <= step * 0.5);
+        }
+    }
+
+    SECTION("sin and cos are within half a step")
+    {
+        // CORDIC has a tiny error of its own, so allow a little over half a step.
+        double maxError = 0.0;
+        for (std::int32_t raw = -500000; raw <= 500000; raw += 13) {
+            const Fx angle = Fx::fromRaw(raw);
+            const double a = static_cast<double>(angle);
+            maxError = std::fmax(maxError, std::fabs(static_cast<double>(sin(angle)) - std::sin(a)));
+            maxError = std::fmax(maxError, std::fabs(static_cast<double>(cos(angle)) - std::cos(a)));
+        }
+        CHECK(maxError <= step * 0.501);
+
+        CHECK(sin(Fx(0)) == Fx(0));
+        CHECK(cos(Fx(0)) == Fx(1));
+        CHECK(sin(pi<Fx>() / 2) == Fx(1));
+        CHECK(cos(pi<Fx>()) == Fx(-1));
+    }
+
+    SECTION("sin and cos of large angles")
+    {
+        for (int i = -30000; i <= 30000; i += 997) {
+            const Fx angle(i);
+            CHECK(static_cast<double>(sin(angle)) == Approx(std::sin(static_cast<double>(i))).margin(step * 2));
+            CHECK(static_cast<double>(cos(angle)) == Approx(std::cos(static_cast<double>(i))).margin(step * 2));
+        }
+    }
+
+    SECTION("atan2 is within half a step")
+    {
+        std::mt19937 rng(2);
+        std::uniform_int_distribution<std::int32_t> raws(-2147483647, 2147483647);
+        std::uniform_int_distribution<std::int32_t> smallRaws(-1000, 1000);
+        double maxError = 0.0;
+        for (int i = 0; i < 20000; ++i) {
+            const bool small = (i % 4 == 0);
+            const Fx y = Fx::fromRaw(small ? smallRaws(rng) : raws(rng));
+            const Fx x = Fx::fromRaw(small ? smallRaws(rng) : raws(rng));
+            const double expected = std::atan2(static_cast<double>(y), static_cast<double>(x));
+            maxError = std::fmax(maxError, std::fabs(static_cast<double>(atan2(y, x)) - expected));
+        }
+        CHECK(maxError <= step * 0.501);
+    }
+
+    SECTION("atan2 on the axes")
+    {
+        CHECK(atan2(Fx(0), Fx(0)) == Fx(0));
+        CHECK(atan2(Fx(0), Fx(5)) == Fx(0));
+        CHECK(atan2(Fx(0), Fx(-5)) == pi<Fx>());
+        // Halving pi would truncate, so compare against the nearest step to pi / 2 instead.
+        CHECK(atan2(Fx(5), Fx(0)) == Fx(pi<double>() / 2.0));
+        CHECK(atan2(Fx(-5), Fx(0)) == Fx(-pi<double>() / 2.0));
+        CHECK(atan2(Fx::max(), Fx::lowest()).raw == Approx(std::atan2(32768.0, -32768.0) * 65536.0).margin(1));
+    }
+}
+
+TEST_CASE("Fixed - utilities", "[math::Fixed]")
+{
+    CHECK(pi<Fx>().raw == 205887);
+    CHECK(degToRad(Fx(180)) == pi<Fx>());
+    CHECK(static_cast<double>(radToDeg(Fx(1))) == Approx(57.29578).margin(0.01));
+    CHECK(lerp(Fx(0.25), Fx(2), Fx(6)) == Fx(3));
+    CHECK(lerpClamp(Fx(2), Fx(2), Fx(6)) == Fx(6));
+    CHECK(isApproxEqual(Fx(1), Fx(1.001), Fx(0.01)));
+    CHECK(isApproxEqual(Fx(1), Fx(1.001), Fx(-0.01)));
+    CHECK_FALSE(isApproxZero(Fx(0.5), Fx(0.1)));
+    CHECK(wrapAngle(Fx(-1)) == pi<Fx>() * 2 - 1);
+    CHECK(wrapAngle(pi<Fx>() * 2) == Fx(0));
+}
+
+TEST_CASE("Fixed - Vector2d and Polar", "[math::Fixed]")
+{
+    SECTION("Vector2d lengths")
+    {
+        const Vector2d<Fx> v(Fx(3), Fx(-4));
+        CHECK(v.getLength() == Fx(5));
+        CHECK(v.getSqLength() == Fx(25));
+        CHECK(v.getRectilinearLength() == Fx(7));
+        CHECK(v.getDistance(Vector2d<Fx>(Fx(0), Fx(-4))) == Fx(3));
+        CHECK(v.isNearRectilinear(Vector2d<Fx>(), Fx(-7)));
+    }
+
+    SECTION("Vector2d lengths near the top of the range")
+    {
+        // The squared lengths of these don't fit in Fixed<16, 16>.
+        CHECK(Vector2d<Fx>(Fx(182), Fx(0)).getLength() == Fx(182));
+        CHECK(Vector2d<Fx>(Fx(0), Fx(-1000)).getLength() == Fx(1000));
+        CHECK(Vector2d<Fx>(Fx(-32767), Fx(0)).getLength() == Fx(32767));
+        CHECK(Vector2d<Fx>(Fx(0), Fx::max()).getLength() == Fx::max());
+        CHECK(Vector2d<Fx>(Fx(300), Fx(-400)).getDistance(Vector2d<Fx>()) == Fx(500));
+
+        const double lengths[][2] = { { 30000.0, 10000.0 }, { -20000.0, 20000.0 }, { 181.5, -181.5 }, { 32000.0, -6000.25 } };
+        for (const auto & xy : lengths) {
+            const Fx length = Vector2d<Fx>(Fx(xy[0]), Fx(xy[1])).getLength();
+            CHECK(static_cast<double>(length) == Approx(std::sqrt((xy[0] * xy[0]) + (xy[1] * xy[1]))).margin(step / 2));
+        }
+
+        // Small lengths are still rounded to the nearest step.
+        CHECK(hypot(Fx::epsilon(), Fx::epsilon()) == Fx::epsilon());
+        CHECK(hypot(Fx(0), Fx(0)) == Fx(0));
+    }
+
+    SECTION("Vector2d normalise")
+    {
+        const Vector2d<Fx> n = Vector2d<Fx>(Fx(10), Fx(-3)).getNormalised();
+        CHECK(static_cast<double>(n.x) == Approx(10.0 / std::sqrt(109.0)).margin(step * 2));
+        CHECK(static_cast<double>(n.y) == Approx(-3.0 / std::sqrt(109.0)).margin(step * 2));
+        CHECK(Vector2d<Fx>(Fx(0), Fx(-2)).getNormalised() == Vector2d<Fx>(Fx(0), Fx(-1)));
+        CHECK(Vector2d<Fx>().getNormalised() == Vector2d<Fx>());
+
+        CHECK(Vector2d<Fx>(Fx(1000), Fx(0)).getNormalised() == Vector2d<Fx>(Fx(1), Fx(0)));
+        CHECK(Vector2d<Fx>(Fx(0), Fx(-32767)).getNormalised() == Vector2d<Fx>(Fx(0), Fx(-1)));
+        const Vector2d<Fx> big = Vector2d<Fx>(Fx(30000), Fx(-10000)).getNormalised();
+        CHECK(static_cast<double>(big.x) == Approx(3.0 / std::sqrt(10.0)).margin(step * 2));
+        CHECK(static_cast<double>(big.y) == Approx(-1.0 / std::sqrt(10.0)).margin(step * 2));
+    }
+
+    SECTION("Conversion to Polar")
+    {
+        const Polar<Fx> p = Vector2d<Fx>(Fx(-3), Fx(-3)).toPolar();
+        CHECK(static_cast<double>(p.angle) == Approx(pi<double>() * 1.25).margin(step));
+        CHECK(static_cast<double>(p.mag) == Approx(std::sqrt(18.0)).margin(step));
+
+        const Polar<Fx> q(Vector2d<Fx>(Fx(0), Fx(2)));
+        CHECK(q.angle == Fx(pi<double>() / 2.0));
+        CHECK(q.mag == Fx(2));
+
+        const Polar<Fx> r = Vector2d<Fx>(Fx(-20000), Fx(20000)).toPolar();
+        CHECK(static_cast<double>(r.angle) == Approx(pi<double>() * 0.75).margin(step));
+        CHECK(static_cast<double>(r.mag) == Approx(std::sqrt(8e8)).margin(step / 2));
+        CHECK(Vector2d<Fx>(Fx(182), Fx(0)).toPolar() == Polar<Fx>(Fx(0), Fx(182)));
+    }
+
+    SECTION("Conversion to Vector2d")
+    {
+        const Vector2d<Fx> v = Polar<Fx>(pi<Fx>() / 3, Fx(4)).toVector2d();
+        CHECK(static_cast<double>(v.x) == Approx(2.0).margin(step * 4));
+        CHECK(static_cast<double>(v.y) == Approx(std::sqrt(12.0)).margin(step * 4));
+    }
+
+    SECTION("Polar simplify")
+    {
+        const Polar<Fx> p = Polar<Fx>(Fx(-1), Fx(-2)).getSimplified();
+        CHECK(p.mag == Fx(2));
+        CHECK(p.angle == pi<Fx>() - 1);
+
+        const Polar<Fx> q = Polar<Fx>(Fx(20), Fx(1)).getSimplified();
+        CHECK(q.angle == Fx(20) - pi<Fx>() * 6);
+    }
+
+    SECTION("Results are bit-reproducible")
+    {
+        // These raw values must be the same on every machine and compiler.
+        const Polar<Fx> p = Vector2d<Fx>(Fx(-3.25), Fx(7.5)).toPolar();
+        CHECK(p.angle.raw == 129742);
+        CHECK(p.mag.raw == 535684);
+
+        const Vector2d<Fx> v = Polar<Fx>(Fx(-2.5), Fx(12)).toVector2d();
+        CHECK(v.x.raw == -630048);
+        CHECK(v.y.raw == -470652);
+
+        CHECK(sin(Fx(1)).raw == 55147);
+        CHECK(cos(Fx(1)).raw == 35409);
+        CHECK(atan2(Fx(1), Fx(-2)).raw == 175502);
+        CHECK(sqrt(Fx(2)).raw == 92682);
+    }
+}
+
+// Check that arithmetic and the angle conversions can be evaluated at compile-time.
+static_assert((Fx(1.5) * Fx(2) + 1 - Fx(0.5) / 2).raw == 3 * 65536 + 49152, "Compile-time evaluation check");
+static_assert(degToRad(Fx(180)) == pi<Fx>(), "Compile-time evaluation check");
+static_assert(Fx(2) > Fx(1.5), "Compile-time evaluation check");
@@ -0,0 +1,174 @@
+/** \file test_OrientedBox2d.cpp
+    \brief Unit testing for the OrientedBox2d class.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <cmath>
+#include <type_traits>
+
+using namespace ail::math;
+
+TEST_CASE("OrientedBox2d - construction and accessors", "[math::OrientedBox2d]")
+{
+    SECTION("Default construction initialises to 0, aligned with the x axis")
+    {
+        const OrientedBox2d<float> box;
+        CHECK(box.pos == Vector2d<float>());
+        CHECK(box.radius == Vector2d<float>());
+        CHECK(box.axis == Vector2d<float>(1.0f, 0.0f));
+    }
+
+    SECTION("Construction from a position, radius and axis")
+    {
+        const OrientedBox2d<double> box(Vector2d<double>(1.0, 2.0), Vector2d<double>(3.0, 4.0), Vector2d<double>(0.0, 1.0));
+        CHECK(box.pos == Vector2d<double>(1.0, 2.0));
+        CHECK(box.radius == Vector2d<double>(3.0, 4.0));
+        CHECK(box.axis == Vector2d<double>(0.0, 1.0));
+        CHECK(box == OrientedBox2d<double>(Vector2d<double>(1.0, 2.0), Vector2d<double>(3.0, 4.0), Vector2d<double>(0.0, 1.0)));
+        CHECK(box != OrientedBox2d<double>(Vector2d<double>(1.0, 2.0), Vector2d<double>(3.0, 4.0), Vector2d<double>(1.0, 0.0)));
+    }
+
+    SECTION("Construction from an axis-aligned box")
+    {
+        const OrientedBox2d<double> box(BoundingBox2d<double>(1.0, 2.0, 3.0, 4.0));
+        CHECK(box == OrientedBox2d<double>(Vector2d<double>(1.0, 2.0), Vector2d<double>(3.0, 4.0), Vector2d<double>(1.0, 0.0)));
+        CHECK(box.getBounds() == BoundingBox2d<double>(1.0, 2.0, 3.0, 4.0));
+    }
+
+    SECTION("Construction from an angle")
+    {
+        const OrientedBox2d<double> box = OrientedBox2d<double>::fromAngle(Vector2d<double>(1.0, 2.0), Vector2d<double>(3.0, 4.0), std::atan(1.0));
+        CHECK(box.pos == Vector2d<double>(1.0, 2.0));
+        CHECK(box.radius == Vector2d<double>(3.0, 4.0));
+        CHECK(box.axis.x == Approx(std::sqrt(0.5)));
+        CHECK(box.axis.y == Approx(std::sqrt(0.5)));
+    }
+
+    SECTION("Corners go anticlockwise")
+    {
+        // Rotated a quarter turn, so its own x axis points up.
+        const OrientedBox2d<double> box(Vector2d<double>(1.0, 2.0), Vector2d<double>(3.0, 4.0), Vector2d<double>(0.0, 1.0));
+        CHECK(box.getCorner(0) == Vector2d<double>(5.0, -1.0));
+        CHECK(box.getCorner(1) == Vector2d<double>(5.0, 5.0));
+        CHECK(box.getCorner(2) == Vector2d<double>(-3.0, 5.0));
+        CHECK(box.getCorner(3) == Vector2d<double>(-3.0, -1.0));
+    }
+
+    SECTION("Bounds of a rotated box")
+    {
+        const OrientedBox2d<double> quarter(Vector2d<double>(1.0, 2.0), Vector2d<double>(3.0, 4.0), Vector2d<double>(0.0, 1.0));
+        CHECK(quarter.getBounds() == BoundingBox2d<double>(1.0, 2.0, 4.0, 3.0));
+
+        const OrientedBox2d<double> diagonal = OrientedBox2d<double>::fromAngle(Vector2d<double>(0.0, 0.0), Vector2d<double>(1.0, 1.0), std::atan(1.0));
+        const BoundingBox2d<double> bounds = diagonal.getBounds();
+        CHECK(bounds.pos == Vector2d<double>(0.0, 0.0));
+        CHECK(bounds.radius.x == Approx(std::sqrt(2.0)));
+        CHECK(bounds.radius.y == Approx(std::sqrt(2.0)));
+    }
+
+    SECTION("Compile time use and trivial copying")
+    {
+        static_assert(std::is_trivially_copyable<OrientedBox2d<float>>::value, "OrientedBox2d<float> should be trivially copyable");
+        constexpr OrientedBox2d<float> box(Vector2d<float>(1.0f, 2.0f), Vector2d<float>(3.0f, 4.0f), Vector2d<float>(0.0f, 1.0f));
+        static_assert(box == OrientedBox2d<float>(Vector2d<float>(1.0f, 2.0f), Vector2d<float>(3.0f, 4.0f), Vector2d<float>(0.0f, 1.0f)), "constexpr equality");
+        constexpr OrientedBox2d<float> aligned(BoundingBox2d<float>(1.0f, 2.0f, 3.0f, 4.0f));
+        static_assert(aligned.axis == Vector2d<float>(1.0f, 0.0f), "constexpr construction from an axis-aligned box");
+    }
+}
+
+TEST_CASE("OrientedBox2d - containing points", "[math::OrientedBox2d]")
+{
+    const OrientedBox2d<double> diagonal = OrientedBox2d<double>::fromAngle(Vector2d<double>(0.0, 0.0), Vector2d<double>(2.0, 0.5), std::atan(1.0));
+    CHECK(diagonal.contains(Vector2d<double>(0.0, 0.0)));
+    CHECK(diagonal.contains(Vector2d<double>(1.0, 1.0)));
+    CHECK(diagonal.contains(Vector2d<double>(-1.25, -1.0)));
+    CHECK_FALSE(diagonal.contains(Vector2d<double>(1.0, -1.0)));
+    CHECK_FALSE(diagonal.contains(Vector2d<double>(1.5, 1.5)));
+
+    const OrientedBox2d<double> aligned(BoundingBox2d<double>(1.0, 2.0, 3.0, 4.0));
+    CHECK(aligned.contains(Vector2d<double>(4.0, 6.0)));
+    CHECK(aligned.contains(Vector2d<double>(-2.0, -2.0)));
+    CHECK_FALSE(aligned.contains(Vector2d<double>(4.5, 2.0)));
+}
+
+TEST_CASE("OrientedBox2d - collisions", "[math::OrientedBox2d]")
+{
+    const OrientedBox2d<double> a(Vector2d<double>(0.0, 0.0), Vector2d<double>(2.0, 1.0), Vector2d<double>(1.0, 0.0));
+    Contact2d<double> contact;
+
+    SECTION("Box resting on a box gives two points, clipped to the overlapping part")
+    {
+        const OrientedBox2d<double> b(Vector2d<double>(1.0, 1.75), Vector2d<double>(2.0, 1.0), Vector2d<double>(1.0, 0.0));
+        CHECK(a.intersects(b));
+        REQUIRE(a.getContact(b, contact));
+        CHECK(contact.normal == Vector2d<double>(0.0, 1.0));
+        CHECK(contact.depth == 0.25);
+        REQUIRE(contact.pointCount == 2);
+        CHECK(contact.points[0] == Vector2d<double>(2.0, 0.875));
+        CHECK(contact.points[1] == Vector2d<double>(-1.0, 0.875));
+
+        // The other way round reverses the normal, but finds the same points.
+        REQUIRE(b.getContact(a, contact));
+        CHECK(contact.normal == Vector2d<double>(0.0, -1.0));
+        CHECK(contact.depth == 0.25);
+        REQUIRE(contact.pointCount == 2);
+        CHECK(contact.points[0] == Vector2d<double>(-1.0, 0.875));
+        CHECK(contact.points[1] == Vector2d<double>(2.0, 0.875));
+    }
+
+    SECTION("Boxes side by side, just touching")
+    {
+        const OrientedBox2d<double> b(Vector2d<double>(-3.0, 0.5), Vector2d<double>(1.0, 1.0), Vector2d<double>(1.0, 0.0));
+        CHECK(a.intersects(b));
+        REQUIRE(a.getContact(b, contact));
+        CHECK(contact.normal == Vector2d<double>(-1.0, 0.0));
+        CHECK(contact.depth == 0.0);
+        CHECK(contact.pointCount == 2);
+    }
+
+    SECTION("Corner of a rotated box digging into a side")
+    {
+        const OrientedBox2d<double> b = OrientedBox2d<double>::fromAngle(Vector2d<double>(0.0, 1.6), Vector2d<double>(0.5, 0.5), std::atan(1.0));
+        CHECK(a.intersects(b));
+        REQUIRE(a.getContact(b, contact));
+        CHECK(contact.normal == Vector2d<double>(0.0, 1.0));
+        CHECK(contact.depth == Approx(std::sqrt(0.5) - 0.6));
+        REQUIRE(contact.pointCount == 1);
+        CHECK(contact.points[0].x == Approx(0.0).margin(1e-12));
+        CHECK(contact.points[0].y == Approx(1.0 - ((std::sqrt(0.5) - 0.6) / 2.0)));
+    }
+
+    SECTION("Rotated boxes with overlapping bounds can still be apart")
+    {
+        const OrientedBox2d<double> square(Vector2d<double>(0.0, 0.0), Vector2d<double>(1.0, 1.0), Vector2d<double>(1.0, 0.0));
+        const OrientedBox2d<double> apart = OrientedBox2d<double>::fromAngle(Vector2d<double>(2.2, 2.2), Vector2d<double>(1.0, 1.0), std::atan(1.0));
+        CHECK(square.getBounds().intersects(apart.getBounds()));
+        CHECK_FALSE(square.intersects(apart));
+        CHECK_FALSE(square.getContact(apart, contact));
+        CHECK(contact.pointCount == 0);
+
+        const OrientedBox2d<double> near = OrientedBox2d<double>::fromAngle(Vector2d<double>(1.6, 1.6), Vector2d<double>(1.0, 1.0), std::atan(1.0));
+        CHECK(square.intersects(near));
+        REQUIRE(square.getContact(near, contact));
+        CHECK(contact.normal.x == Approx(std::sqrt(0.5)));
+        CHECK(contact.normal.y == Approx(std::sqrt(0.5)));
+        CHECK(contact.depth == Approx((2.0 - (3.2 - std::sqrt(2.0))) * std::sqrt(0.5)));
+        REQUIRE(contact.pointCount == 1);
+        CHECK(contact.points[0].x == Approx(contact.points[0].y));
+    }
+
+    SECTION("Box containing a circle and a capsule")
+    {
+        CHECK(a.intersects(Circle2d<double>(Vector2d<double>(0.5, 0.0), 0.25)));
+        CHECK(a.intersects(Capsule2d<double>(Vector2d<double>(-0.5, 0.0), Vector2d<double>(0.5, 0.0), 0.25)));
+        REQUIRE(a.getContact(Capsule2d<double>(Vector2d<double>(-0.5, 0.0), Vector2d<double>(0.5, 0.25), 0.25), contact));
+        CHECK(contact.depth > 0.0);
+    }
+}
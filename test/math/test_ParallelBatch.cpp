@@ -0,0 +1,134 @@
+/** \file test_ParallelBatch.cpp
+    \brief Unit testing for the parallel versions of common vector operations.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Make random points, with a few exact duplicates.
+template <typename T_ty>
+std::vector<Vector2d<T_ty>> makePoints(const std::size_t count, const unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+    std::vector<Vector2d<T_ty>> points;
+    for (std::size_t i = 0; i < count; ++i)
+        points.push_back(Vector2d<T_ty>(static_cast<T_ty>(dist(rng)), static_cast<T_ty>(dist(rng))));
+    for (std::size_t i = 0; i + 7 < count; i += 1000)
+        points[i + 7] = points[i];
+    return points;
+}
+
+} // namespace
+
+TEST_CASE("ParallelBatch - matches serial loops", "[math::ParallelBatch]")
+{
+    const std::vector<Vector2d<double>> points = makePoints<double>(50000, 1);
+    ThreadPool pool1(1), pool2(2), pool4(4), pool8(8);
+    ThreadPool * const pools[] = { &pool1, &pool2, &pool4, &pool8 };
+
+    SECTION("Normalise")
+    {
+        std::vector<Vector2d<double>> expected(points);
+        for (Vector2d<double> & v : expected)
+            v.normalise();
+
+        for (ThreadPool * pool : pools) {
+            std::vector<Vector2d<double>> actual(points);
+            parallelNormalise(actual.data(), actual.size(), *pool);
+            CHECK(actual == expected);
+        }
+    }
+
+    SECTION("Convert to polar")
+    {
+        std::vector<Polar<double>> expected, minimax;
+        for (const Vector2d<double> & v : points) {
+            expected.push_back(v.toPolar());
+            minimax.push_back(v.toPolar<TrigMinimax>());
+        }
+
+        for (ThreadPool * pool : pools) {
+            std::vector<Polar<double>> actual(points.size());
+            parallelToPolar(points.data(), actual.data(), points.size(), *pool);
+            CHECK(actual == expected);
+            parallelToPolar<TrigMinimax>(points.data(), actual.data(), points.size(), *pool);
+            CHECK(actual == minimax);
+        }
+    }
+
+    SECTION("Bounding box")
+    {
+        Vector2d<double> minCorner = points[0], maxCorner = points[0];
+        for (const Vector2d<double> & v : points) {
+            minCorner.set(std::min(minCorner.x, v.x), std::min(minCorner.y, v.y));
+            maxCorner.set(std::max(maxCorner.x, v.x), std::max(maxCorner.y, v.y));
+        }
+        const BoundingBox2d<double> expected = BoundingBox2d<double>::fromCorners(minCorner, maxCorner);
+
+        std::vector<double> xs, ys;
+        for (const Vector2d<double> & v : points) {
+            xs.push_back(v.x);
+            ys.push_back(v.y);
+        }
+
+        CHECK(BoundingBox2d<double>::fromPoints(points.data(), points.size()) == expected);
+        for (ThreadPool * pool : pools) {
+            CHECK(parallelBoundingBox(points.data(), points.size(), *pool) == expected);
+            CHECK(parallelBoundingBox(xs.data(), ys.data(), xs.size(), *pool) == expected);
+        }
+    }
+
+    SECTION("Nearest point")
+    {
+        const std::vector<Vector2d<double>> targets = makePoints<double>(20, 2);
+        for (const Vector2d<double> & target : targets) {
+            std::size_t expected = 0;
+            for (std::size_t i = 1; i < points.size(); ++i) {
+                if (points[i].getSqDistance(target) < points[expected].getSqDistance(target))
+                    expected = i;
+            }
+            for (ThreadPool * pool : pools)
+                CHECK(parallelFindNearest(points.data(), points.size(), target, *pool) == expected);
+        }
+
+        // Ties go to the lowest index. Point 7 is a copy of point 0.
+        for (ThreadPool * pool : pools)
+            CHECK(parallelFindNearest(points.data(), points.size(), points[7], *pool) == 0);
+    }
+}
+
+TEST_CASE("ParallelBatch - edge cases", "[math::ParallelBatch]")
+{
+    SECTION("Empty spans")
+    {
+        CHECK(parallelBoundingBox<float>(nullptr, 0) == BoundingBox2d<float>());
+        CHECK(parallelBoundingBox<float>(nullptr, nullptr, 0) == BoundingBox2d<float>());
+        CHECK(parallelFindNearest<float>(nullptr, 0, Vector2d<float>()) == 0);
+        parallelNormalise<float>(nullptr, 0);
+    }
+
+    SECTION("Integer points")
+    {
+        const std::vector<Vector2d<int>> points = { { 3, -2 }, { -5, 8 }, { 10, 1 } };
+        const BoundingBox2d<int> box = parallelBoundingBox(points.data(), points.size());
+        CHECK(box == BoundingBox2d<int>::fromCorners(Vector2d<int>(-5, -2), Vector2d<int>(10, 8)));
+        for (const Vector2d<int> & p : points)
+            CHECK(box.contains(p));
+        CHECK(parallelFindNearest(points.data(), points.size(), Vector2d<int>(9, 0)) == 2);
+    }
+}
@@ -10,6 +10,9 @@
 
 #include "../common.h"
 
+#include <cstring>
+#include <type_traits>
+
 using namespace ail::math;
 
 /*
@@ -83,6 +86,28 @@ TEST_CASE("Polar - construction and assignment", "[math::Polar]")
     }
 }
 
+TEST_CASE("Polar - compile time use and trivial copying", "[math::Polar]")
+{
+    static_assert(std::is_trivially_copyable<Polar<float>>::value, "Polar<float> should be trivially copyable");
+    static_assert(std::is_trivially_copyable<Polar<double>>::value, "Polar<double> should be trivially copyable");
+
+    constexpr Polar<double> p(1.5, 2.0);
+    static_assert(p.angle == 1.5 && p.mag == 2.0, "constexpr construction");
+    static_assert(Polar<double>() == Polar<double>(0.0, 0.0), "constexpr default construction");
+    static_assert(p != Polar<double>(1.5, -2.0), "constexpr inequality");
+    static_assert(-p == Polar<double>(1.5, -2.0), "constexpr negation");
+
+#if AIL_MATH_HAS_CONSTEXPR14
+    static_assert(Polar<float> { 0.5f, 3.0f } == Polar<float>(0.5f, 3.0f), "constexpr initializer list");
+#endif
+
+    const Polar<float> src[] = { Polar<float>(0.25f, 1.0f), Polar<float>(-3.0f, 0.5f) };
+    Polar<float> dst[2];
+    std::memcpy(dst, src, sizeof(src));
+    CHECK(dst[0] == src[0]);
+    CHECK(dst[1] == src[1]);
+}
+
 TEST_CASE("Polar - comparison operators", "[math::Polar]")
 {
     Polar<double>
@@ -0,0 +1,321 @@
+/** \file test_PolarBatch.cpp
+    \brief Unit testing for the batch cartesian/polar conversions and the fast trig functions.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Map a floating point value onto an integer scale where adjacent values differ by 1.
+// Positive and negative zero both map to 0.
+int64_t toOrdered(const float val)
+{
+    int32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    return (bits < 0) ? -static_cast<int64_t>(bits & 0x7fffffff) : bits;
+}
+
+int64_t toOrdered(const double val)
+{
+    int64_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    return (bits < 0) ? -(bits & 0x7fffffffffffffffLL) : bits;
+}
+
+// Get the distance between two values in units in the last place.
+template <typename T_ty>
+uint64_t ulpDistance(const T_ty lhs, const T_ty rhs)
+{
+    const int64_t a = toOrdered(lhs);
+    const int64_t b = toOrdered(rhs);
+    return (a > b) ? static_cast<uint64_t>(a - b) : static_cast<uint64_t>(b - a);
+}
+
+// Generate random cartesian vectors, including zero and the axes.
+template <typename T_ty>
+std::vector<Vector2d<T_ty>> makeTestVectors(const unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<T_ty> dist(T_ty(-1000), T_ty(1000));
+
+    std::vector<Vector2d<T_ty>> vectors;
+    for (int i = 0; i < 10007; ++i)
+        vectors.push_back(Vector2d<T_ty>(dist(rng), dist(rng)));
+
+    vectors[0] = Vector2d<T_ty>(0, 0);
+    vectors[1] = Vector2d<T_ty>(1, 0);
+    vectors[2] = Vector2d<T_ty>(0, 1);
+    vectors[3] = Vector2d<T_ty>(-1, 0);
+    vectors[4] = Vector2d<T_ty>(0, -1);
+    vectors[5] = Vector2d<T_ty>(-3, -3);
+    vectors[6] = Vector2d<T_ty>(T_ty(1e-20), T_ty(-5));
+    return vectors;
+}
+
+// Generate random polar coordinates, with both small and very large angles.
+template <typename T_ty>
+std::vector<Polar<T_ty>> makeTestPolars(const unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<T_ty> small(T_ty(-10), T_ty(10));
+    std::uniform_real_distribution<T_ty> large(T_ty(-1e6), T_ty(1e6));
+    std::uniform_real_distribution<T_ty> mag(T_ty(-100), T_ty(100));
+
+    std::vector<Polar<T_ty>> polars;
+    for (int i = 0; i < 10007; ++i)
+        polars.push_back(Polar<T_ty>((i % 2) ? small(rng) : large(rng), mag(rng)));
+
+    polars[0] = Polar<T_ty>(0, 1);
+    polars[1] = Polar<T_ty>(pi<T_ty>() * T_ty(0.5), 1);
+    polars[2] = Polar<T_ty>(pi<T_ty>(), 1);
+    polars[3] = Polar<T_ty>(pi<T_ty>() * T_ty(-1.5), 2);
+    return polars;
+}
+
+template <typename T_ty>
+void checkToPolarBatch(const uint64_t maxAngleUlp)
+{
+    const std::vector<Vector2d<T_ty>> input = makeTestVectors<T_ty>(1);
+    const std::size_t count = input.size();
+
+    std::vector<T_ty> x(count), y(count), angles(count), mags(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        x[i] = input[i].x;
+        y[i] = input[i].y;
+    }
+
+    std::vector<Polar<T_ty>> output(count);
+    toPolarBatch(x.data(), y.data(), angles.data(), mags.data(), count);
+    toPolarBatch(input.data(), output.data(), count);
+
+    uint64_t worstAngle = 0;
+    bool magsMatch = true, inRange = true, layoutsMatch = true;
+    for (std::size_t i = 0; i < count; ++i) {
+        const Polar<T_ty> expected = input[i].toPolar();
+        worstAngle = std::max(worstAngle, ulpDistance(angles[i], expected.angle));
+        magsMatch = magsMatch && mags[i] == expected.mag;
+        inRange = inRange && angles[i] >= T_ty(0) && angles[i] < pi<T_ty>() * T_ty(2) && mags[i] >= T_ty(0);
+        layoutsMatch = layoutsMatch && output[i].angle == angles[i] && output[i].mag == mags[i];
+    }
+
+    CHECK(worstAngle <= maxAngleUlp);
+    CHECK(magsMatch);
+    CHECK(inRange);
+    CHECK(layoutsMatch);
+}
+
+template <typename T_ty>
+void checkToCartesianBatch(const uint64_t maxUlp)
+{
+    const std::vector<Polar<T_ty>> input = makeTestPolars<T_ty>(2);
+    const std::size_t count = input.size();
+
+    std::vector<T_ty> angles(count), mags(count), x(count), y(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        angles[i] = input[i].angle;
+        mags[i] = input[i].mag;
+    }
+
+    std::vector<Vector2d<T_ty>> output(count);
+    toCartesianBatch(angles.data(), mags.data(), x.data(), y.data(), count);
+    toCartesianBatch(input.data(), output.data(), count);
+
+    uint64_t worst = 0;
+    bool layoutsMatch = true;
+    for (std::size_t i = 0; i < count; ++i) {
+        const Vector2d<T_ty> expected = input[i].toVector2d();
+        worst = std::max(worst, ulpDistance(x[i], expected.x));
+        worst = std::max(worst, ulpDistance(y[i], expected.y));
+        layoutsMatch = layoutsMatch && output[i].x == x[i] && output[i].y == y[i];
+    }
+
+    CHECK(worst <= maxUlp);
+    CHECK(layoutsMatch);
+}
+
+// Check that every SIMD kernel gives exactly the same bits as the scalar approximation.
+template <typename T_ty>
+void checkToPolarLevels()
+{
+    const std::vector<Vector2d<T_ty>> input = makeTestVectors<T_ty>(3);
+    const std::size_t count = input.size();
+
+    std::vector<T_ty> x(count), y(count), expectedAngles(count), expectedMags(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        x[i] = input[i].x;
+        y[i] = input[i].y;
+    }
+    kernels::scalar::toPolar(x.data(), y.data(), expectedAngles.data(), expectedMags.data(), count);
+
+    const SimdLevel original = getSimdLevel();
+    for (int level = 0; level <= static_cast<int>(getSupportedSimdLevel()); ++level) {
+        setSimdLevel(static_cast<SimdLevel>(level));
+        std::vector<T_ty> angles(count), mags(count);
+        toPolarBatch(x.data(), y.data(), angles.data(), mags.data(), count);
+
+        std::vector<Polar<T_ty>> output(count);
+        toPolarBatch(input.data(), output.data(), count);
+
+        bool same = true;
+        for (std::size_t i = 0; i < count; ++i) {
+            same = same && std::memcmp(&angles[i], &expectedAngles[i], sizeof(T_ty)) == 0;
+            same = same && std::memcmp(&mags[i], &expectedMags[i], sizeof(T_ty)) == 0;
+            same = same && output[i].angle == angles[i] && output[i].mag == mags[i];
+        }
+        INFO("SIMD level " << level);
+        CHECK(same);
+    }
+    setSimdLevel(original);
+}
+
+// Check that tiny negative angles are folded to 0 rather than rounding up to 2 pi, at every SIMD level.
+template <typename T_ty>
+void checkTinyNegativeAngles(const T_ty tinyY)
+{
+    const Vector2d<T_ty> v(T_ty(1), tinyY);
+    REQUIRE(v.toPolar().angle == T_ty(0));
+
+    // Enough values to fill whole registers, plus a scalar tail.
+    const std::size_t count = 37;
+    std::vector<T_ty> x(count, T_ty(1)), y(count, tinyY), angles(count), mags(count);
+    std::vector<Vector2d<T_ty>> input(count, v);
+    std::vector<Polar<T_ty>> output(count);
+
+    const SimdLevel original = getSimdLevel();
+    for (int level = 0; level <= static_cast<int>(getSupportedSimdLevel()); ++level) {
+        setSimdLevel(static_cast<SimdLevel>(level));
+        toPolarBatch(x.data(), y.data(), angles.data(), mags.data(), count);
+        toPolarBatch(input.data(), output.data(), count);
+
+        bool allZero = true;
+        for (std::size_t i = 0; i < count; ++i)
+            allZero = allZero && angles[i] == T_ty(0) && output[i].angle == T_ty(0) && output[i] == v.toPolar();
+        INFO("SIMD level " << level);
+        CHECK(allZero);
+    }
+    setSimdLevel(original);
+}
+
+} // namespace
+
+TEST_CASE("PolarBatch - fast trig functions", "[math::PolarBatch]")
+{
+    SECTION("Exact values")
+    {
+        CHECK(fastSin(0.0f) == 0.0f);
+        CHECK(fastCos(0.0f) == 1.0f);
+        CHECK(fastSin(0.0) == 0.0);
+        CHECK(fastCos(0.0) == 1.0);
+        CHECK(fastAtan2(0.0f, 0.0f) == 0.0f);
+        CHECK(fastAtan2(0.0, 0.0) == 0.0);
+        CHECK(fastAtan2(0.0, 1.0) == 0.0);
+        CHECK(fastAtan2(1.0, 0.0) == pi<double>() * 0.5);
+        CHECK(fastAtan2(0.0, -1.0) == pi<double>());
+    }
+
+    SECTION("Sin and cos are within 2 ulp of the library functions")
+    {
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<double> dist(-1e6, 1e6);
+        uint64_t worstFloat = 0, worstDouble = 0;
+        for (int i = 0; i < 100000; ++i) {
+            const double d = (i % 2) ? dist(rng) : dist(rng) * 1e-5;
+            const float f = static_cast<float>(d);
+            float sf, cf;
+            double sd, cd;
+            fastSinCos(f, sf, cf);
+            fastSinCos(d, sd, cd);
+            // The float results are compared to double results rounded to float.
+            worstFloat = std::max(worstFloat, ulpDistance(sf, static_cast<float>(std::sin(static_cast<double>(f)))));
+            worstFloat = std::max(worstFloat, ulpDistance(cf, static_cast<float>(std::cos(static_cast<double>(f)))));
+            worstDouble = std::max(worstDouble, ulpDistance(sd, std::sin(d)));
+            worstDouble = std::max(worstDouble, ulpDistance(cd, std::cos(d)));
+        }
+        CHECK(worstFloat <= 2);
+        CHECK(worstDouble <= 2);
+    }
+
+    SECTION("Atan2 is within 3 ulp (float) or 2 ulp (double) of the library function")
+    {
+        std::mt19937 rng(4);
+        std::uniform_real_distribution<double> dist(-100.0, 100.0);
+        uint64_t worstFloat = 0, worstDouble = 0;
+        for (int i = 0; i < 100000; ++i) {
+            const double yd = dist(rng), xd = dist(rng);
+            const float yf = static_cast<float>(yd), xf = static_cast<float>(xd);
+            worstFloat = std::max(worstFloat, ulpDistance(fastAtan2(yf, xf),
+                static_cast<float>(std::atan2(static_cast<double>(yf), static_cast<double>(xf)))));
+            worstDouble = std::max(worstDouble, ulpDistance(fastAtan2(yd, xd), std::atan2(yd, xd)));
+        }
+        CHECK(worstFloat <= 3);
+        CHECK(worstDouble <= 2);
+    }
+}
+
+TEST_CASE("PolarBatch - cartesian to polar", "[math::PolarBatch]")
+{
+    SECTION("float")
+    {
+        checkToPolarBatch<float>(3);
+    }
+
+    SECTION("double")
+    {
+        checkToPolarBatch<double>(2);
+    }
+
+    SECTION("Tiny negative angles are simplified to 0, not 2 pi")
+    {
+        checkTinyNegativeAngles<float>(-1e-9f);
+        checkTinyNegativeAngles<double>(-1e-20);
+    }
+
+    SECTION("Every SIMD level gives identical results")
+    {
+        checkToPolarLevels<float>();
+        checkToPolarLevels<double>();
+    }
+}
+
+TEST_CASE("PolarBatch - polar to cartesian", "[math::PolarBatch]")
+{
+    SECTION("float")
+    {
+        checkToCartesianBatch<float>(4);
+    }
+
+    SECTION("double")
+    {
+        checkToCartesianBatch<double>(3);
+    }
+}
+
+TEST_CASE("PolarBatch - other types use the scalar conversions", "[math::PolarBatch]")
+{
+    const Vector2d<long double> input[] = { { 3, 4 }, { -2, 0 }, { 0, -7 } };
+    Polar<long double> polars[3];
+    Vector2d<long double> vectors[3];
+
+    toPolarBatch(input, polars, 3);
+    toCartesianBatch(polars, vectors, 3);
+
+    for (int i = 0; i < 3; ++i) {
+        CHECK(polars[i] == input[i].toPolar());
+        CHECK(vectors[i] == polars[i].toVector2d());
+    }
+}
@@ -0,0 +1,210 @@
+/** \file test_Quadtree.cpp
+    \brief Unit testing for the Quadtree spatial index.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+typedef Quadtree<double, int> Tree;
+
+// Sort a list of handles so results can be compared regardless of order.
+std::vector<Tree::Handle> sorted(std::vector<Tree::Handle> handles)
+{
+    std::sort(handles.begin(), handles.end());
+    return handles;
+}
+
+// Find the k nearest items by brute force, ordered by distance then handle.
+std::vector<Tree::Handle> bruteNearest(const std::vector<std::pair<Tree::Handle, Vector2d<double>>> & items, const Vector2d<double> & point, const std::size_t k)
+{
+    std::vector<std::pair<double, Tree::Handle>> dists;
+    for (const auto & item : items)
+        dists.push_back(std::make_pair(item.second.getSqDistance(point), item.first));
+    std::sort(dists.begin(), dists.end());
+
+    std::vector<Tree::Handle> output;
+    for (std::size_t i = 0; i < k && i < dists.size(); ++i)
+        output.push_back(dists[i].second);
+    return output;
+}
+
+} // namespace
+
+TEST_CASE("Quadtree - construction and modifiers", "[math::Quadtree]")
+{
+    Tree tree(BoundingBox2d<double>(0.0, 0.0, 100.0, 100.0), 4);
+
+    SECTION("Empty on construction")
+    {
+        CHECK(tree.empty());
+        CHECK(tree.size() == 0);
+        CHECK(tree.getBounds() == BoundingBox2d<double>(0.0, 0.0, 100.0, 100.0));
+        CHECK_FALSE(tree.contains(0));
+        CHECK_FALSE(tree.contains(Tree::invalidHandle));
+    }
+
+    SECTION("Zero items per node is invalid")
+    {
+        CHECK_THROWS_AS(Tree(BoundingBox2d<double>(0.0, 0.0, 1.0, 1.0), 0), std::invalid_argument);
+    }
+
+    SECTION("Insert and access")
+    {
+        const Tree::Handle h1 = tree.insert(Vector2d<double>(1.0, 2.0), 10);
+        const Tree::Handle h2 = tree.insert(Vector2d<double>(-50.0, 99.0), 20);
+        CHECK(tree.size() == 2);
+        CHECK(tree.contains(h1));
+        CHECK(tree.contains(h2));
+        CHECK(tree.getPosition(h1) == Vector2d<double>(1.0, 2.0));
+        CHECK(tree.getPayload(h2) == 20);
+
+        tree.getPayload(h1) = 15;
+        CHECK(tree.getPayload(h1) == 15);
+    }
+
+    SECTION("Insert outside bounds")
+    {
+        CHECK_THROWS_AS(tree.insert(Vector2d<double>(100.5, 0.0), 1), std::out_of_range);
+        CHECK(tree.empty());
+
+        // The edges are included.
+        CHECK_NOTHROW(tree.insert(Vector2d<double>(100.0, -100.0), 1));
+    }
+
+    SECTION("Remove")
+    {
+        const Tree::Handle h1 = tree.insert(Vector2d<double>(1.0, 2.0), 10);
+        const Tree::Handle h2 = tree.insert(Vector2d<double>(3.0, 4.0), 20);
+        tree.remove(h1);
+        CHECK(tree.size() == 1);
+        CHECK_FALSE(tree.contains(h1));
+        CHECK(tree.contains(h2));
+        CHECK_THROWS_AS(tree.remove(h1), std::invalid_argument);
+
+        // Handles of removed items are reused.
+        CHECK(tree.insert(Vector2d<double>(5.0, 6.0), 30) == h1);
+    }
+
+    SECTION("Move")
+    {
+        const Tree::Handle h = tree.insert(Vector2d<double>(1.0, 2.0), 10);
+        tree.move(h, Vector2d<double>(-80.0, 70.0));
+        CHECK(tree.getPosition(h) == Vector2d<double>(-80.0, 70.0));
+        CHECK(tree.getPayload(h) == 10);
+        CHECK_THROWS_AS(tree.move(h, Vector2d<double>(0.0, 101.0)), std::out_of_range);
+        CHECK(tree.getPosition(h) == Vector2d<double>(-80.0, 70.0));
+    }
+
+    SECTION("Clear")
+    {
+        for (int i = 0; i < 50; ++i)
+            tree.insert(Vector2d<double>(i, -i), i);
+        tree.clear();
+        CHECK(tree.empty());
+        CHECK(tree.insert(Vector2d<double>(0.0, 0.0), 1) == 0);
+    }
+}
+
+TEST_CASE("Quadtree - queries match brute force", "[math::Quadtree]")
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+    Tree tree(BoundingBox2d<double>(0.0, 0.0, 1000.0, 1000.0), 6);
+
+    // Insert lots of items, including duplicates which can't be separated by splitting.
+    std::vector<std::pair<Tree::Handle, Vector2d<double>>> items;
+    for (int i = 0; i < 2000; ++i) {
+        const Vector2d<double> pos = (i % 100 == 0) ? Vector2d<double>(12.5, 12.5) : Vector2d<double>(dist(rng), dist(rng));
+        items.push_back(std::make_pair(tree.insert(pos, i), pos));
+    }
+
+    // Remove and move some items, so nodes have to be merged and split again.
+    for (std::size_t i = 0; i < items.size(); i += 3) {
+        tree.remove(items[i].first);
+        items[i].first = Tree::invalidHandle;
+    }
+    for (std::size_t i = 1; i < items.size(); i += 5) {
+        if (items[i].first == Tree::invalidHandle)
+            continue;
+        items[i].second = (i % 2) ? Vector2d<double>(dist(rng), dist(rng)) : items[i].second + Vector2d<double>(0.01, 0.0);
+        tree.move(items[i].first, items[i].second);
+    }
+    items.erase(std::remove_if(items.begin(), items.end(),
+        [](const std::pair<Tree::Handle, Vector2d<double>> & item) { return item.first == Tree::invalidHandle; }),
+        items.end());
+    REQUIRE(tree.size() == items.size());
+
+    for (int q = 0; q < 50; ++q) {
+        const Vector2d<double> point(dist(rng), dist(rng));
+        const BoundingBox2d<double> box(point, Vector2d<double>(std::fabs(dist(rng)) * 0.2, std::fabs(dist(rng)) * 0.2));
+        const double radius = std::fabs(dist(rng)) * 0.2;
+
+        std::vector<Tree::Handle> expectedBox, expectedRadius;
+        for (const auto & item : items) {
+            if (box.contains(item.second))
+                expectedBox.push_back(item.first);
+            if (item.second.isNear(point, radius))
+                expectedRadius.push_back(item.first);
+        }
+
+        std::vector<Tree::Handle> actualBox, actualRadius, actualNearest;
+        tree.queryBox(box, actualBox);
+        tree.queryRadius(point, radius, actualRadius);
+        tree.kNearest(point, 10, actualNearest);
+
+        CHECK(sorted(actualBox) == sorted(expectedBox));
+        CHECK(sorted(actualRadius) == sorted(expectedRadius));
+        CHECK(actualNearest == bruteNearest(items, point, 10));
+    }
+}
+
+TEST_CASE("Quadtree - nearest neighbours", "[math::Quadtree]")
+{
+    Quadtree<float, std::string> tree(BoundingBox2d<float>(0.0f, 0.0f, 10.0f, 10.0f), 1);
+    const Quadtree<float, std::string>::Handle a = tree.insert(Vector2d<float>(1.0f, 0.0f), "a");
+    const Quadtree<float, std::string>::Handle b = tree.insert(Vector2d<float>(-3.0f, 0.0f), "b");
+    const Quadtree<float, std::string>::Handle c = tree.insert(Vector2d<float>(0.0f, 2.0f), "c");
+
+    SECTION("Results are ordered by distance")
+    {
+        std::vector<Quadtree<float, std::string>::Handle> output;
+        tree.kNearest(Vector2d<float>(0.0f, 0.0f), 2, output);
+        REQUIRE(output.size() == 2);
+        CHECK(output[0] == a);
+        CHECK(output[1] == c);
+    }
+
+    SECTION("Results are appended, and limited to the number of items")
+    {
+        std::vector<Quadtree<float, std::string>::Handle> output(1, 99);
+        tree.kNearest(Vector2d<float>(0.0f, 0.0f), 10, output);
+        REQUIRE(output.size() == 4);
+        CHECK(output[0] == 99);
+        CHECK(output[3] == b);
+        CHECK(tree.getPayload(output[3]) == "b");
+    }
+
+    SECTION("Zero neighbours")
+    {
+        std::vector<Quadtree<float, std::string>::Handle> output;
+        tree.kNearest(Vector2d<float>(0.0f, 0.0f), 0, output);
+        CHECK(output.empty());
+    }
+}
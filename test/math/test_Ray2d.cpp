@@ -0,0 +1,166 @@
+/** \file test_Ray2d.cpp
+    \brief Unit testing for the Ray2d class.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <limits>
+#include <random>
+#include <type_traits>
+
+using namespace ail::math;
+
+TEST_CASE("Ray2d - construction and accessors", "[math::Ray2d]")
+{
+    SECTION("Default construction initialises to 0")
+    {
+        const Ray2d<float> ray;
+        CHECK(ray.origin == Vector2d<float>());
+        CHECK(ray.direction == Vector2d<float>());
+    }
+
+    SECTION("Construction from vectors")
+    {
+        const Ray2d<double> ray(Vector2d<double>(1.0, 2.0), Vector2d<double>(0.5, -4.0));
+        CHECK(ray.origin == Vector2d<double>(1.0, 2.0));
+        CHECK(ray.direction == Vector2d<double>(0.5, -4.0));
+        CHECK(ray == Ray2d<double>(Vector2d<double>(1.0, 2.0), Vector2d<double>(0.5, -4.0)));
+        CHECK(ray != Ray2d<double>());
+    }
+
+    SECTION("Points and inverse direction")
+    {
+        const Ray2d<double> ray(Vector2d<double>(1.0, 2.0), Vector2d<double>(0.5, -4.0));
+        CHECK(ray.getPoint(0.0) == ray.origin);
+        CHECK(ray.getPoint(2.0) == Vector2d<double>(2.0, -6.0));
+        CHECK(ray.getInverseDirection() == Vector2d<double>(2.0, -0.25));
+
+        const Ray2d<double> flat(Vector2d<double>(), Vector2d<double>(1.0, 0.0));
+        CHECK(flat.getInverseDirection().y == std::numeric_limits<double>::infinity());
+    }
+
+    SECTION("Compile time use and trivial copying")
+    {
+        static_assert(std::is_trivially_copyable<Ray2d<float>>::value, "Ray2d<float> should be trivially copyable");
+        constexpr Ray2d<float> ray(Vector2d<float>(1.0f, 2.0f), Vector2d<float>(3.0f, 4.0f));
+        static_assert(ray == Ray2d<float>(Vector2d<float>(1.0f, 2.0f), Vector2d<float>(3.0f, 4.0f)), "constexpr equality");
+    }
+}
+
+TEST_CASE("Ray2d - casting against boxes", "[math::Ray2d]")
+{
+    const BoundingBox2d<float> box(2.0f, 1.0f, 1.0f, 1.0f); // x from 1 to 3, y from 0 to 2
+    float entry = -1.0f, exit = -1.0f;
+
+    SECTION("Hit from outside")
+    {
+        const Ray2d<float> ray(Vector2d<float>(-1.0f, 1.0f), Vector2d<float>(1.0f, 0.0f));
+        REQUIRE(ray.intersects(box, entry, exit));
+        CHECK(entry == 2.0f);
+        CHECK(exit == 4.0f);
+        CHECK(ray.intersects(box));
+    }
+
+    SECTION("Diagonal hit, with an unnormalised direction")
+    {
+        const Ray2d<float> ray(Vector2d<float>(0.0f, -1.0f), Vector2d<float>(2.0f, 2.0f));
+        REQUIRE(ray.intersects(box, entry, exit));
+        CHECK(entry == 0.5f);
+        CHECK(exit == 1.5f);
+    }
+
+    SECTION("Negative directions")
+    {
+        const Ray2d<float> ray(Vector2d<float>(5.0f, 1.5f), Vector2d<float>(-1.0f, -0.25f));
+        REQUIRE(ray.intersects(box, entry, exit));
+        CHECK(entry == 2.0f);
+        CHECK(exit == 4.0f);
+    }
+
+    SECTION("Starting inside the box")
+    {
+        const Ray2d<float> ray(Vector2d<float>(2.0f, 1.0f), Vector2d<float>(0.0f, 1.0f));
+        REQUIRE(ray.intersects(box, entry, exit));
+        CHECK(entry == 0.0f);
+        CHECK(exit == 1.0f);
+    }
+
+    SECTION("Misses leave the distances unchanged")
+    {
+        CHECK_FALSE(Ray2d<float>(Vector2d<float>(-1.0f, 1.0f), Vector2d<float>(-1.0f, 0.0f)).intersects(box, entry, exit));
+        CHECK_FALSE(Ray2d<float>(Vector2d<float>(-1.0f, 3.0f), Vector2d<float>(1.0f, 0.0f)).intersects(box, entry, exit));
+        CHECK_FALSE(Ray2d<float>(Vector2d<float>(0.0f, 6.0f), Vector2d<float>(1.0f, -1.0f)).intersects(box, entry, exit));
+        CHECK(entry == -1.0f);
+        CHECK(exit == -1.0f);
+    }
+
+    SECTION("Grazing an edge or corner counts as a hit")
+    {
+        // Parallel to an edge, exactly on it. The slab test has to skip the NaN from 0 * infinity.
+        const Ray2d<float> top(Vector2d<float>(-1.0f, 2.0f), Vector2d<float>(1.0f, 0.0f));
+        REQUIRE(top.intersects(box, entry, exit));
+        CHECK(entry == 2.0f);
+        CHECK(exit == 4.0f);
+
+        const Ray2d<float> bottom(Vector2d<float>(-1.0f, 0.0f), Vector2d<float>(1.0f, -0.0f));
+        CHECK(bottom.intersects(box));
+        const Ray2d<float> side(Vector2d<float>(3.0f, -5.0f), Vector2d<float>(0.0f, 1.0f));
+        CHECK(side.intersects(box));
+
+        const Ray2d<float> corner(Vector2d<float>(2.0f, 3.0f), Vector2d<float>(1.0f, -1.0f));
+        REQUIRE(corner.intersects(box, entry, exit));
+        CHECK(entry == 1.0f);
+        CHECK(exit == 1.0f);
+    }
+
+    SECTION("A zero direction only hits boxes containing the origin")
+    {
+        CHECK(Ray2d<float>(Vector2d<float>(2.0f, 1.0f), Vector2d<float>()).intersects(box));
+        CHECK(Ray2d<float>(Vector2d<float>(1.0f, 1.0f), Vector2d<float>()).intersects(box));
+        CHECK_FALSE(Ray2d<float>(Vector2d<float>(0.0f, 1.0f), Vector2d<float>()).intersects(box));
+        CHECK_FALSE(Ray2d<float>(Vector2d<float>(4.0f, 3.0f), Vector2d<float>()).intersects(box));
+    }
+
+    SECTION("Aabb2d gives the same results, and empty boxes are never hit")
+    {
+        const Ray2d<float> ray(Vector2d<float>(0.0f, -1.0f), Vector2d<float>(2.0f, 2.0f));
+        REQUIRE(ray.intersects(Aabb2d<float>(box), entry, exit));
+        CHECK(entry == 0.5f);
+        CHECK(exit == 1.5f);
+
+        CHECK_FALSE(ray.intersects(Aabb2d<float>(3.0f, 0.0f, 1.0f, 2.0f)));
+        CHECK_FALSE(Ray2d<float>(Vector2d<float>(0.0f, 1.0f), Vector2d<float>()).intersects(Aabb2d<float>(3.0f, 0.0f, 1.0f, 2.0f)));
+    }
+}
+
+TEST_CASE("Ray2d - hits agree with the points along the ray", "[math::Ray2d]")
+{
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> coord(-10.0, 10.0);
+    std::uniform_real_distribution<double> size(0.1, 5.0);
+
+    int hits = 0;
+    bool allConsistent = true;
+    for (int i = 0; i < 10000; ++i) {
+        const Ray2d<double> ray(Vector2d<double>(coord(rng), coord(rng)), Vector2d<double>(coord(rng), coord(rng)));
+        const BoundingBox2d<double> box(coord(rng), coord(rng), size(rng), size(rng));
+        double entry = 0.0, exit = 0.0;
+        if (!ray.intersects(box, entry, exit))
+            continue;
+        ++hits;
+
+        // The points where the ray enters and leaves must be on the box, allowing for rounding.
+        const BoundingBox2d<double> grown(box.pos, box.radius + Vector2d<double>(1e-9, 1e-9));
+        allConsistent = allConsistent && entry >= 0.0 && entry <= exit &&
+            grown.contains(ray.getPoint(entry)) && grown.contains(ray.getPoint(exit)) &&
+            grown.contains(ray.getPoint((entry + exit) / 2.0));
+    }
+    CHECK(hits > 100);
+    CHECK(allConsistent);
+}
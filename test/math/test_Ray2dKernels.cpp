@@ -0,0 +1,205 @@
+/** \file test_Ray2dKernels.cpp
+    \brief Unit testing for the batch ray casting kernels, checking every SIMD level against the scalar reference.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Check that two values have exactly the same bit pattern.
+template <typename T_ty>
+bool isBitIdentical(const T_ty lhs, const T_ty rhs)
+{
+    return std::memcmp(&lhs, &rhs, sizeof(T_ty)) == 0;
+}
+
+// Generate random rays, including axis-parallel and zero directions.
+// An odd count is used so that every kernel has to deal with a partial register at the end.
+template <typename T_ty>
+std::vector<Ray2d<T_ty>> makeTestRays(const unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<T_ty> coord(T_ty(-50), T_ty(50));
+
+    std::vector<Ray2d<T_ty>> rays;
+    for (int i = 0; i < 1021; ++i)
+        rays.push_back(Ray2d<T_ty>(Vector2d<T_ty>(coord(rng), coord(rng)), Vector2d<T_ty>(coord(rng), coord(rng))));
+
+    rays[2] = Ray2d<T_ty>(Vector2d<T_ty>(T_ty(-40), T_ty(0)), Vector2d<T_ty>(T_ty(1), T_ty(0)));
+    rays[3] = Ray2d<T_ty>(Vector2d<T_ty>(T_ty(-5), T_ty(20)), Vector2d<T_ty>(T_ty(0), T_ty(-3)));
+    rays[4] = Ray2d<T_ty>(Vector2d<T_ty>(T_ty(1), T_ty(2)), Vector2d<T_ty>(T_ty(0), T_ty(0))); // inside the box
+    rays[7] = Ray2d<T_ty>(Vector2d<T_ty>(T_ty(-40), T_ty(10)), Vector2d<T_ty>(T_ty(1), T_ty(0))); // along the top edge
+    rays[8] = Ray2d<T_ty>(Vector2d<T_ty>(T_ty(60), T_ty(60)), Vector2d<T_ty>(T_ty(0), T_ty(0)));
+    return rays;
+}
+
+template <typename T_ty>
+void checkKernelsMatchScalar()
+{
+    const std::vector<Ray2d<T_ty>> rays = makeTestRays<T_ty>(1);
+    const std::size_t count = rays.size();
+    const Aabb2d<T_ty> box(T_ty(-10), T_ty(-10), T_ty(10), T_ty(10));
+    const T_ty maxDistance = std::numeric_limits<T_ty>::max();
+
+    std::vector<T_ty> originX, originY, directionX, directionY;
+    for (const Ray2d<T_ty> & ray : rays) {
+        originX.push_back(ray.origin.x);
+        originY.push_back(ray.origin.y);
+        directionX.push_back(ray.direction.x);
+        directionY.push_back(ray.direction.y);
+    }
+
+    // The reference results, and a check that they agree with Ray2d.
+    std::vector<T_ty> expectedEntry(count), expectedExit(count);
+    std::unique_ptr<bool[]> expectedHit(new bool[count]);
+    kernels::scalar::castRays(originX.data(), originY.data(), directionX.data(), directionY.data(),
+        box.min.x, box.min.y, box.max.x, box.max.y, maxDistance,
+        expectedEntry.data(), expectedExit.data(), expectedHit.get(), count);
+
+    std::size_t hits = 0;
+    bool matchesRay2d = true;
+    for (std::size_t i = 0; i < count; ++i) {
+        T_ty entry = 0, exit = 0;
+        const bool hit = rays[i].intersects(box, entry, exit);
+        matchesRay2d = matchesRay2d && hit == expectedHit[i] &&
+            (!hit || (entry == expectedEntry[i] && exit == expectedExit[i]));
+        if (hit)
+            ++hits;
+    }
+    CHECK(matchesRay2d);
+    CHECK(hits > 50);
+    CHECK(expectedHit[2]);
+    CHECK(expectedHit[3]);
+    CHECK(expectedHit[4]);
+    CHECK(expectedHit[7]);
+    CHECK_FALSE(expectedHit[8]);
+
+    // One ray against a row of boxes, one per ray above (its origin and the far corner).
+    // Some of these are empty.
+    std::vector<T_ty> minX(originX), minY(originY), maxX(count), maxY(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        maxX[i] = originX[i] + directionX[i];
+        maxY[i] = originY[i] + directionY[i];
+    }
+    const Ray2d<T_ty> single(Vector2d<T_ty>(T_ty(-60), T_ty(-30)), Vector2d<T_ty>(T_ty(3), T_ty(1)));
+    const Vector2d<T_ty> inv = single.getInverseDirection();
+
+    // A box swept over the same boxes, moving parallel to the x axis so that some normals are NaN comparisons.
+    const SweptBox2d<T_ty> mover(BoundingBox2d<T_ty>(T_ty(-60), T_ty(5), T_ty(2), T_ty(3)), Vector2d<T_ty>(T_ty(120), T_ty(0)));
+    const Vector2d<T_ty> moverInv(T_ty(1) / mover.velocity.x, T_ty(1) / mover.velocity.y);
+
+    const SimdLevel original = getSimdLevel();
+
+    for (int l = 0; l <= static_cast<int>(getSupportedSimdLevel()); ++l) {
+        const SimdLevel level = static_cast<SimdLevel>(l);
+        INFO("SIMD level " << l);
+        REQUIRE(setSimdLevel(level) == level);
+
+        // Every starting offset is tested, so unaligned and short spans are covered too.
+        for (std::size_t offset = 0; offset < 20; ++offset) {
+            const std::size_t n = count - offset;
+            std::vector<T_ty> entry(n), exit(n), singleEntry(n), singleExit(n), refEntry(n), refExit(n);
+            std::unique_ptr<bool[]> hit(new bool[n]), singleHit(new bool[n]), refHit(new bool[n]);
+
+            kernels::castRays(originX.data() + offset, originY.data() + offset,
+                directionX.data() + offset, directionY.data() + offset,
+                box.min.x, box.min.y, box.max.x, box.max.y, maxDistance,
+                entry.data(), exit.data(), hit.get(), n);
+
+            kernels::castRay(minX.data() + offset, minY.data() + offset, maxX.data() + offset, maxY.data() + offset,
+                single.origin.x, single.origin.y, inv.x, inv.y, T_ty(100),
+                singleEntry.data(), singleExit.data(), singleHit.get(), n);
+            kernels::scalar::castRay(minX.data() + offset, minY.data() + offset, maxX.data() + offset, maxY.data() + offset,
+                single.origin.x, single.origin.y, inv.x, inv.y, T_ty(100),
+                refEntry.data(), refExit.data(), refHit.get(), n);
+
+            std::vector<T_ty> time(n), normalX(n), normalY(n), refTime(n), refNormalX(n), refNormalY(n);
+            std::unique_ptr<bool[]> sweepHit(new bool[n]), refSweepHit(new bool[n]);
+            kernels::sweepBox(minX.data() + offset, minY.data() + offset, maxX.data() + offset, maxY.data() + offset,
+                mover.box.pos.x, mover.box.pos.y, mover.box.radius.x, mover.box.radius.y, moverInv.x, moverInv.y,
+                time.data(), normalX.data(), normalY.data(), sweepHit.get(), n);
+            kernels::scalar::sweepBox(minX.data() + offset, minY.data() + offset, maxX.data() + offset, maxY.data() + offset,
+                mover.box.pos.x, mover.box.pos.y, mover.box.radius.x, mover.box.radius.y, moverInv.x, moverInv.y,
+                refTime.data(), refNormalX.data(), refNormalY.data(), refSweepHit.get(), n);
+
+            bool allMatch = true;
+            for (std::size_t i = 0; i < n; ++i) {
+                allMatch = allMatch &&
+                    hit[i] == expectedHit[offset + i] &&
+                    isBitIdentical(entry[i], expectedEntry[offset + i]) &&
+                    isBitIdentical(exit[i], expectedExit[offset + i]) &&
+                    singleHit[i] == refHit[i] &&
+                    isBitIdentical(singleEntry[i], refEntry[i]) &&
+                    isBitIdentical(singleExit[i], refExit[i]) &&
+                    sweepHit[i] == refSweepHit[i] &&
+                    isBitIdentical(time[i], refTime[i]) &&
+                    isBitIdentical(normalX[i], refNormalX[i]) &&
+                    isBitIdentical(normalY[i], refNormalY[i]);
+            }
+            CHECK(allMatch);
+        }
+    }
+
+    setSimdLevel(original);
+}
+
+} // namespace
+
+TEST_CASE("Ray2dKernels - conformance with the scalar reference", "[math::Ray2dKernels]")
+{
+    SECTION("float")
+    {
+        checkKernelsMatchScalar<float>();
+    }
+
+    SECTION("double")
+    {
+        checkKernelsMatchScalar<double>();
+    }
+}
+
+TEST_CASE("Ray2dKernels - segments as rays with a maximum distance of 1", "[math::Ray2dKernels]")
+{
+    const Segment2d<float> segments[] = {
+        Segment2d<float>(Vector2d<float>(0.0f, 1.0f), Vector2d<float>(4.0f, 1.0f)),
+        Segment2d<float>(Vector2d<float>(-2.0f, 1.0f), Vector2d<float>(0.5f, 1.0f)),
+        Segment2d<float>(Vector2d<float>(2.0f, 1.0f), Vector2d<float>(2.0f, 5.0f))
+    };
+    const BoundingBox2d<float> box(2.0f, 1.0f, 1.0f, 1.0f);
+
+    float originX[3], originY[3], directionX[3], directionY[3], entry[3], exit[3];
+    bool hit[3];
+    for (int i = 0; i < 3; ++i) {
+        originX[i] = segments[i].start.x;
+        originY[i] = segments[i].start.y;
+        directionX[i] = segments[i].getDirection().x;
+        directionY[i] = segments[i].getDirection().y;
+    }
+    kernels::castRays(originX, originY, directionX, directionY, 1.0f, 0.0f, 3.0f, 2.0f, 1.0f, entry, exit, hit, 3);
+
+    for (int i = 0; i < 3; ++i) {
+        float expectedEntry = 0.0f, expectedExit = 0.0f;
+        CHECK(hit[i] == segments[i].intersects(box, expectedEntry, expectedExit));
+        if (hit[i]) {
+            CHECK(entry[i] == expectedEntry);
+            CHECK(exit[i] == expectedExit);
+        }
+    }
+    CHECK(hit[0]);
+    CHECK_FALSE(hit[1]);
+    CHECK(hit[2]);
+}
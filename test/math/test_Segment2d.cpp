@@ -0,0 +1,115 @@
+/** \file test_Segment2d.cpp
+    \brief Unit testing for the Segment2d class.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <type_traits>
+
+using namespace ail::math;
+
+TEST_CASE("Segment2d - construction and accessors", "[math::Segment2d]")
+{
+    SECTION("Default construction initialises to 0")
+    {
+        const Segment2d<float> segment;
+        CHECK(segment.start == Vector2d<float>());
+        CHECK(segment.end == Vector2d<float>());
+    }
+
+    SECTION("Construction from end points")
+    {
+        const Segment2d<double> segment(Vector2d<double>(1.0, 2.0), Vector2d<double>(4.0, 6.0));
+        CHECK(segment.start == Vector2d<double>(1.0, 2.0));
+        CHECK(segment.end == Vector2d<double>(4.0, 6.0));
+        CHECK(segment == Segment2d<double>(Vector2d<double>(1.0, 2.0), Vector2d<double>(4.0, 6.0)));
+        CHECK(segment != Segment2d<double>());
+    }
+
+    SECTION("Points, direction and length")
+    {
+        const Segment2d<double> segment(Vector2d<double>(1.0, 2.0), Vector2d<double>(4.0, 6.0));
+        CHECK(segment.getDirection() == Vector2d<double>(3.0, 4.0));
+        CHECK(segment.getLength() == 5.0);
+        CHECK(segment.getPoint(0.0) == segment.start);
+        CHECK(segment.getPoint(1.0) == segment.end);
+        CHECK(segment.getPoint(0.5) == Vector2d<double>(2.5, 4.0));
+        CHECK(segment.toRay() == Ray2d<double>(Vector2d<double>(1.0, 2.0), Vector2d<double>(3.0, 4.0)));
+    }
+
+    SECTION("Compile time use and trivial copying")
+    {
+        static_assert(std::is_trivially_copyable<Segment2d<float>>::value, "Segment2d<float> should be trivially copyable");
+        constexpr Segment2d<float> segment(Vector2d<float>(1.0f, 2.0f), Vector2d<float>(3.0f, 4.0f));
+        static_assert(segment == Segment2d<float>(Vector2d<float>(1.0f, 2.0f), Vector2d<float>(3.0f, 4.0f)), "constexpr equality");
+    }
+}
+
+TEST_CASE("Segment2d - casting against boxes", "[math::Segment2d]")
+{
+    const BoundingBox2d<float> box(2.0f, 1.0f, 1.0f, 1.0f); // x from 1 to 3, y from 0 to 2
+    float entry = -1.0f, exit = -1.0f;
+
+    SECTION("Crossing the whole box")
+    {
+        const Segment2d<float> segment(Vector2d<float>(0.0f, 1.0f), Vector2d<float>(4.0f, 1.0f));
+        REQUIRE(segment.intersects(box, entry, exit));
+        CHECK(entry == 0.25f);
+        CHECK(exit == 0.75f);
+        CHECK(segment.intersects(box));
+    }
+
+    SECTION("Ending inside the box")
+    {
+        const Segment2d<float> segment(Vector2d<float>(0.0f, 1.0f), Vector2d<float>(2.0f, 1.0f));
+        REQUIRE(segment.intersects(box, entry, exit));
+        CHECK(entry == 0.5f);
+        CHECK(exit == 1.0f);
+    }
+
+    SECTION("Starting inside the box")
+    {
+        const Segment2d<float> segment(Vector2d<float>(2.0f, 1.0f), Vector2d<float>(2.0f, 5.0f));
+        REQUIRE(segment.intersects(box, entry, exit));
+        CHECK(entry == 0.0f);
+        CHECK(exit == 0.25f);
+    }
+
+    SECTION("Stopping short of the box")
+    {
+        const Segment2d<float> segment(Vector2d<float>(-2.0f, 1.0f), Vector2d<float>(0.5f, 1.0f));
+        CHECK_FALSE(segment.intersects(box, entry, exit));
+        CHECK(entry == -1.0f);
+        CHECK(exit == -1.0f);
+
+        // The same line as a ray does hit it.
+        CHECK(segment.toRay().intersects(box));
+    }
+
+    SECTION("Touching an edge")
+    {
+        CHECK(Segment2d<float>(Vector2d<float>(-2.0f, 1.0f), Vector2d<float>(1.0f, 1.0f)).intersects(box));
+        CHECK(Segment2d<float>(Vector2d<float>(0.0f, 2.0f), Vector2d<float>(5.0f, 2.0f)).intersects(box));
+    }
+
+    SECTION("A segment of zero length only hits boxes containing it")
+    {
+        CHECK(Segment2d<float>(Vector2d<float>(2.0f, 1.0f), Vector2d<float>(2.0f, 1.0f)).intersects(box));
+        CHECK_FALSE(Segment2d<float>(Vector2d<float>(5.0f, 1.0f), Vector2d<float>(5.0f, 1.0f)).intersects(box));
+    }
+
+    SECTION("Aabb2d gives the same results, and empty boxes are never hit")
+    {
+        const Segment2d<float> segment(Vector2d<float>(0.0f, 1.0f), Vector2d<float>(4.0f, 1.0f));
+        REQUIRE(segment.intersects(Aabb2d<float>(box), entry, exit));
+        CHECK(entry == 0.25f);
+        CHECK(exit == 0.75f);
+        CHECK_FALSE(segment.intersects(Aabb2d<float>(3.0f, 0.0f, 1.0f, 2.0f)));
+    }
+}
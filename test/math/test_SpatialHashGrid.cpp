@@ -0,0 +1,234 @@
+/** \file test_SpatialHashGrid.cpp
+    \brief Unit testing for the SpatialHashGrid spatial index.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+typedef SpatialHashGrid<float> Grid;
+
+// Sort a list of handles so results can be compared regardless of order.
+std::vector<Grid::Handle> sorted(std::vector<Grid::Handle> handles)
+{
+    std::sort(handles.begin(), handles.end());
+    return handles;
+}
+
+// Find all points near the given point by brute force.
+// Positions of unused handles should be marked as NaN.
+std::vector<Grid::Handle> bruteNear(const std::vector<Vector2d<float>> & positions, const Vector2d<float> & point, const float dist)
+{
+    std::vector<Grid::Handle> output;
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        if (positions[i].x == positions[i].x && positions[i].isNear(point, dist))
+            output.push_back(i);
+    }
+    return output;
+}
+
+// Check that random radius queries on the grid match brute force.
+void checkQueries(const Grid & grid, const std::vector<Vector2d<float>> & positions, std::mt19937 & rng)
+{
+    std::uniform_real_distribution<float> coord(-120.0f, 120.0f);
+    std::uniform_real_distribution<float> radius(0.0f, 30.0f);
+    for (int q = 0; q < 50; ++q) {
+        const Vector2d<float> point(coord(rng), coord(rng));
+        const float dist = (q == 0) ? 1000.0f : radius(rng);
+
+        std::vector<Grid::Handle> actual;
+        grid.queryRadius(point, dist, actual);
+        CHECK(sorted(actual) == bruteNear(positions, point, dist));
+    }
+}
+
+} // namespace
+
+TEST_CASE("SpatialHashGrid - construction and modifiers", "[math::SpatialHashGrid]")
+{
+    Grid grid(2.5f, 10);
+
+    SECTION("Empty on construction")
+    {
+        CHECK(grid.empty());
+        CHECK(grid.size() == 0);
+        CHECK(grid.getCellSize() == 2.5f);
+        CHECK(grid.getBucketCount() == 16);
+        CHECK_FALSE(grid.contains(0));
+        CHECK_FALSE(grid.contains(Grid::invalidHandle));
+    }
+
+    SECTION("Cell size must be positive")
+    {
+        CHECK_THROWS_AS(Grid(0.0f), std::invalid_argument);
+        CHECK_THROWS_AS(Grid(-1.0f), std::invalid_argument);
+    }
+
+    SECTION("Sizes are limited to 2^31, since indices are stored in 32 bits")
+    {
+        const std::size_t tooMany = (std::size_t(1) << 31) + 1;
+        CHECK_THROWS_AS(Grid(1.0f, tooMany), std::length_error);
+        CHECK_THROWS_AS(grid.rebuild(static_cast<const Vector2d<float> *>(nullptr), tooMany), std::length_error);
+        CHECK_THROWS_AS(grid.rebuild(nullptr, nullptr, tooMany), std::length_error);
+        CHECK(grid.empty());
+    }
+
+    SECTION("Insert and access")
+    {
+        const Grid::Handle h1 = grid.insert(Vector2d<float>(1.0f, 2.0f));
+        const Grid::Handle h2 = grid.insert(Vector2d<float>(-50.0f, 1e6f));
+        CHECK(grid.size() == 2);
+        CHECK(grid.contains(h1));
+        CHECK(grid.contains(h2));
+        CHECK(grid.getPosition(h1) == Vector2d<float>(1.0f, 2.0f));
+        CHECK(grid.getPosition(h2) == Vector2d<float>(-50.0f, 1e6f));
+    }
+
+    SECTION("Bucket count grows with the number of points")
+    {
+        for (int i = 0; i < 100; ++i)
+            grid.insert(Vector2d<float>(i, i));
+        CHECK(grid.getBucketCount() >= 100);
+        CHECK(grid.getPosition(57) == Vector2d<float>(57.0f, 57.0f));
+    }
+
+    SECTION("Remove")
+    {
+        const Grid::Handle h1 = grid.insert(Vector2d<float>(1.0f, 2.0f));
+        const Grid::Handle h2 = grid.insert(Vector2d<float>(3.0f, 4.0f));
+        grid.remove(h1);
+        CHECK(grid.size() == 1);
+        CHECK_FALSE(grid.contains(h1));
+        CHECK(grid.contains(h2));
+        CHECK(grid.getPosition(h2) == Vector2d<float>(3.0f, 4.0f));
+        CHECK_THROWS_AS(grid.remove(h1), std::invalid_argument);
+        CHECK_THROWS_AS(grid.move(h1, Vector2d<float>()), std::invalid_argument);
+
+        // Handles of removed points are reused.
+        CHECK(grid.insert(Vector2d<float>(5.0f, 6.0f)) == h1);
+    }
+
+    SECTION("Move")
+    {
+        const Grid::Handle h = grid.insert(Vector2d<float>(1.0f, 2.0f));
+        grid.move(h, Vector2d<float>(-80.0f, 70.0f));
+        CHECK(grid.getPosition(h) == Vector2d<float>(-80.0f, 70.0f));
+
+        std::vector<Grid::Handle> output;
+        grid.queryRadius(Vector2d<float>(-80.0f, 70.0f), 0.0f, output);
+        CHECK(output == std::vector<Grid::Handle>(1, h));
+        output.clear();
+        grid.queryRadius(Vector2d<float>(1.0f, 2.0f), 1.0f, output);
+        CHECK(output.empty());
+    }
+
+    SECTION("Clear")
+    {
+        for (int i = 0; i < 50; ++i)
+            grid.insert(Vector2d<float>(i, -i));
+        grid.clear();
+        CHECK(grid.empty());
+        CHECK(grid.insert(Vector2d<float>(0.0f, 0.0f)) == 0);
+    }
+}
+
+TEST_CASE("SpatialHashGrid - queries match brute force", "[math::SpatialHashGrid]")
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coord(-100.0f, 100.0f);
+    const float unused = std::numeric_limits<float>::quiet_NaN();
+
+    SECTION("Incremental updates")
+    {
+        // A single bucket means every cell collides.
+        for (const std::size_t bucketCount : { std::size_t(1), std::size_t(1024) }) {
+            Grid grid(4.0f, bucketCount);
+            std::vector<Vector2d<float>> positions;
+            for (int i = 0; i < 1000; ++i) {
+                positions.push_back(Vector2d<float>(coord(rng), coord(rng)));
+                REQUIRE(grid.insert(positions.back()) == positions.size() - 1);
+            }
+
+            for (std::size_t i = 0; i < positions.size(); i += 3) {
+                grid.remove(i);
+                positions[i].set(unused, unused);
+            }
+            for (std::size_t i = 1; i < positions.size(); i += 2) {
+                if (!grid.contains(i))
+                    continue;
+                positions[i] = (i % 4 == 1) ? Vector2d<float>(coord(rng), coord(rng)) : positions[i] + Vector2d<float>(0.5f, -0.5f);
+                grid.move(i, positions[i]);
+            }
+            for (std::size_t i = 0; i < positions.size(); ++i) {
+                if (grid.contains(i))
+                    CHECK(grid.getPosition(i) == positions[i]);
+            }
+
+            checkQueries(grid, positions, rng);
+        }
+    }
+
+    SECTION("Rebuild from positions")
+    {
+        Grid grid(4.0f);
+        grid.insert(Vector2d<float>(1.0f, 1.0f));
+
+        std::vector<Vector2d<float>> positions;
+        for (int i = 0; i < 5000; ++i)
+            positions.push_back(Vector2d<float>(coord(rng), coord(rng)));
+        grid.rebuild(positions.data(), positions.size());
+
+        REQUIRE(grid.size() == positions.size());
+        CHECK(grid.getBucketCount() >= positions.size());
+        for (std::size_t i = 0; i < positions.size(); ++i)
+            CHECK(grid.getPosition(i) == positions[i]);
+        checkQueries(grid, positions, rng);
+
+        // The grid can still be updated incrementally afterwards.
+        grid.remove(10);
+        positions[10].set(unused, unused);
+        positions[20] = Vector2d<float>(99.0f, -99.0f);
+        grid.move(20, positions[20]);
+        positions.push_back(Vector2d<float>(-7.0f, 7.0f));
+        CHECK(grid.insert(positions.back()) == 10);
+        positions[10] = positions.back();
+        positions.pop_back();
+        checkQueries(grid, positions, rng);
+    }
+
+    SECTION("Rebuild from lanes")
+    {
+        Vector2dArray<float> lanes;
+        for (int i = 0; i < 3000; ++i)
+            lanes.push_back(Vector2d<float>(coord(rng), coord(rng)));
+
+        Grid grid(2.0f, 1);
+        grid.rebuild(lanes.x(), lanes.y(), lanes.size());
+
+        std::vector<Vector2d<float>> positions;
+        for (std::size_t i = 0; i < lanes.size(); ++i) {
+            positions.push_back(lanes.get(i));
+            CHECK(grid.getPosition(i) == positions[i]);
+        }
+        checkQueries(grid, positions, rng);
+
+        // Rebuilding with nothing empties the grid.
+        grid.rebuild(lanes.x(), lanes.y(), 0);
+        CHECK(grid.empty());
+        CHECK_FALSE(grid.contains(0));
+    }
+}
@@ -0,0 +1,202 @@
+/** \file test_SweepAndPrune2d.cpp
+    \brief Unit testing for the SweepAndPrune2d broadphase.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+typedef SweepAndPrune2d<float> Sap;
+typedef std::set<Sap::Pair> PairSet;
+
+// Find all overlapping pairs by brute force.
+PairSet brutePairs(const Sap & sap, const std::vector<Sap::Handle> & handles)
+{
+    PairSet pairs;
+    for (std::size_t i = 0; i < handles.size(); ++i) {
+        const Vector2d<float> minI = sap.getBox(handles[i]).getCornerX1Y1(), maxI = sap.getBox(handles[i]).getCornerX2Y2();
+        for (std::size_t j = i + 1; j < handles.size(); ++j) {
+            const Vector2d<float> minJ = sap.getBox(handles[j]).getCornerX1Y1(), maxJ = sap.getBox(handles[j]).getCornerX2Y2();
+            if (minI.x <= maxJ.x && minJ.x <= maxI.x && minI.y <= maxJ.y && minJ.y <= maxI.y)
+                pairs.insert(Sap::Pair(std::min(handles[i], handles[j]), std::max(handles[i], handles[j])));
+        }
+    }
+    return pairs;
+}
+
+// Update the broadphase, apply the reported changes to a set of pairs, and check the result.
+void updateAndCheck(Sap & sap, PairSet & pairs, const std::vector<Sap::Handle> & handles)
+{
+    std::vector<Sap::Pair> added, removed;
+    sap.update(added, removed);
+
+    for (const Sap::Pair & pair : removed) {
+        CHECK(pair.first < pair.second);
+        CHECK(pairs.erase(pair) == 1);
+    }
+    for (const Sap::Pair & pair : added) {
+        CHECK(pair.first < pair.second);
+        CHECK(pairs.insert(pair).second);
+    }
+
+    const PairSet expected = brutePairs(sap, handles);
+    CHECK(pairs == expected);
+    CHECK(sap.getPairCount() == expected.size());
+
+    std::vector<Sap::Pair> current;
+    sap.getPairs(current);
+    CHECK(PairSet(current.begin(), current.end()) == expected);
+}
+
+} // namespace
+
+TEST_CASE("SweepAndPrune2d - construction and modifiers", "[math::SweepAndPrune2d]")
+{
+    Sap sap;
+    std::vector<Sap::Pair> added, removed;
+
+    SECTION("Empty on construction")
+    {
+        CHECK(sap.empty());
+        CHECK(sap.size() == 0);
+        CHECK(sap.getPairCount() == 0);
+        CHECK_FALSE(sap.contains(0));
+        CHECK_FALSE(sap.contains(Sap::invalidHandle));
+
+        sap.update(added, removed);
+        CHECK(added.empty());
+        CHECK(removed.empty());
+    }
+
+    SECTION("Pairs are reported on update")
+    {
+        const Sap::Handle a = sap.insert(BoundingBox2d<float>(0.0f, 0.0f, 1.0f, 1.0f));
+        const Sap::Handle b = sap.insert(BoundingBox2d<float>(1.5f, 0.0f, 1.0f, 1.0f));
+        const Sap::Handle c = sap.insert(BoundingBox2d<float>(10.0f, 0.0f, 1.0f, 1.0f));
+        CHECK(sap.size() == 3);
+        CHECK(sap.getBox(b) == BoundingBox2d<float>(1.5f, 0.0f, 1.0f, 1.0f));
+        CHECK(sap.getPairCount() == 0);
+
+        sap.update(added, removed);
+        CHECK(added == std::vector<Sap::Pair>(1, Sap::Pair(a, b)));
+        CHECK(removed.empty());
+        CHECK(sap.isOverlapping(b, a));
+        CHECK_FALSE(sap.isOverlapping(a, c));
+
+        // Touching boxes overlap.
+        added.clear();
+        sap.setBox(c, BoundingBox2d<float>(3.5f, 0.0f, 1.0f, 1.0f));
+        sap.update(added, removed);
+        CHECK(added == std::vector<Sap::Pair>(1, Sap::Pair(b, c)));
+
+        // Removing a box removes its pairs.
+        added.clear();
+        sap.remove(b);
+        CHECK_FALSE(sap.contains(b));
+        CHECK_THROWS_AS(sap.remove(b), std::invalid_argument);
+        CHECK_THROWS_AS(sap.setBox(b, BoundingBox2d<float>()), std::invalid_argument);
+        sap.update(added, removed);
+        CHECK(added.empty());
+        CHECK(PairSet(removed.begin(), removed.end()) == PairSet({ Sap::Pair(a, b), Sap::Pair(b, c) }));
+        CHECK(sap.getPairCount() == 0);
+
+        // Handles are reused after the update.
+        CHECK(sap.insert(BoundingBox2d<float>()) == b);
+    }
+
+    SECTION("A box removed before it was ever updated")
+    {
+        const Sap::Handle a = sap.insert(BoundingBox2d<float>(0.0f, 0.0f, 1.0f, 1.0f));
+        sap.update(added, removed);
+        const Sap::Handle b = sap.insert(BoundingBox2d<float>(0.0f, 0.0f, 1.0f, 1.0f));
+        sap.remove(b);
+        sap.update(added, removed);
+        CHECK(added.empty());
+        CHECK(removed.empty());
+        CHECK(sap.size() == 1);
+        CHECK(sap.contains(a));
+    }
+
+    SECTION("Clear")
+    {
+        for (int i = 0; i < 10; ++i)
+            sap.insert(BoundingBox2d<float>(i, 0.0f, 0.75f, 0.75f));
+        sap.update(added, removed);
+        CHECK(sap.getPairCount() == 9);
+
+        sap.clear();
+        CHECK(sap.empty());
+        CHECK(sap.getPairCount() == 0);
+        CHECK(sap.insert(BoundingBox2d<float>()) == 0);
+    }
+}
+
+TEST_CASE("SweepAndPrune2d - pairs match brute force", "[math::SweepAndPrune2d]")
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coord(0.0f, 200.0f);
+    std::uniform_real_distribution<float> size(0.0f, 6.0f);
+    std::uniform_real_distribution<float> step(-1.5f, 1.5f);
+
+    Sap sap;
+    PairSet pairs;
+    std::vector<Sap::Handle> handles;
+    auto randomBox = [&]() {
+        // Some boxes have negative radii, or snap to a coarse grid so they touch exactly.
+        const int kind = static_cast<int>(rng() % 10);
+        if (kind == 0)
+            return BoundingBox2d<float>(coord(rng), coord(rng), -size(rng), size(rng));
+        if (kind == 1)
+            return BoundingBox2d<float>(std::floor(coord(rng)), std::floor(coord(rng)), 0.5f, 0.5f);
+        return BoundingBox2d<float>(coord(rng), coord(rng), size(rng), size(rng));
+    };
+
+    // The first update builds everything from scratch.
+    for (int i = 0; i < 600; ++i)
+        handles.push_back(sap.insert(randomBox()));
+    updateAndCheck(sap, pairs, handles);
+
+    for (int frame = 0; frame < 30; ++frame) {
+        // Move most boxes a little, and occasionally teleport or resize one.
+        for (const Sap::Handle handle : handles) {
+            BoundingBox2d<float> box = sap.getBox(handle);
+            if (rng() % 50 == 0)
+                box = randomBox();
+            else
+                box.pos += Vector2d<float>(step(rng), step(rng));
+            sap.setBox(handle, box);
+        }
+
+        // Add and remove a few boxes, which are handled incrementally.
+        for (int i = 0; i < 5; ++i) {
+            const std::size_t index = rng() % handles.size();
+            sap.remove(handles[index]);
+            handles.erase(handles.begin() + index);
+        }
+        for (int i = 0; i < 5; ++i)
+            handles.push_back(sap.insert(randomBox()));
+
+        // Occasionally add lots at once, which triggers a rebuild.
+        if (frame % 10 == 9) {
+            for (int i = 0; i < 100; ++i)
+                handles.push_back(sap.insert(randomBox()));
+        }
+
+        REQUIRE(sap.size() == handles.size());
+        updateAndCheck(sap, pairs, handles);
+    }
+}
@@ -0,0 +1,222 @@
+/** \file test_SweptBox2d.cpp
+    \brief Unit testing for the SweptBox2d class.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <random>
+#include <type_traits>
+
+using namespace ail::math;
+
+TEST_CASE("SweptBox2d - construction and accessors", "[math::SweptBox2d]")
+{
+    SECTION("Default construction initialises to 0")
+    {
+        const SweptBox2d<float> swept;
+        CHECK(swept.box == BoundingBox2d<float>());
+        CHECK(swept.velocity == Vector2d<float>());
+    }
+
+    SECTION("Construction from a box and velocity")
+    {
+        const SweptBox2d<double> swept(BoundingBox2d<double>(1.0, 2.0, 3.0, 4.0), Vector2d<double>(10.0, -6.0));
+        CHECK(swept.box == BoundingBox2d<double>(1.0, 2.0, 3.0, 4.0));
+        CHECK(swept.velocity == Vector2d<double>(10.0, -6.0));
+        CHECK(swept == SweptBox2d<double>(BoundingBox2d<double>(1.0, 2.0, 3.0, 4.0), Vector2d<double>(10.0, -6.0)));
+        CHECK(swept != SweptBox2d<double>());
+    }
+
+    SECTION("Box at a given time, and bounds of the whole movement")
+    {
+        const SweptBox2d<double> swept(BoundingBox2d<double>(1.0, 2.0, 3.0, 4.0), Vector2d<double>(10.0, -6.0));
+        CHECK(swept.getBoxAt(0.0) == swept.box);
+        CHECK(swept.getBoxAt(0.5) == BoundingBox2d<double>(6.0, -1.0, 3.0, 4.0));
+        CHECK(swept.getBoxAt(1.0) == BoundingBox2d<double>(11.0, -4.0, 3.0, 4.0));
+
+        const BoundingBox2d<double> bounds = swept.getSweptBounds();
+        CHECK(bounds.getCornerX1Y1() == Vector2d<double>(-2.0, -8.0));
+        CHECK(bounds.getCornerX2Y2() == Vector2d<double>(14.0, 6.0));
+    }
+
+    SECTION("Compile time use and trivial copying")
+    {
+        static_assert(std::is_trivially_copyable<SweptBox2d<float>>::value, "SweptBox2d<float> should be trivially copyable");
+        constexpr SweptBox2d<float> swept(BoundingBox2d<float>(1.0f, 2.0f, 3.0f, 4.0f), Vector2d<float>(5.0f, 6.0f));
+        static_assert(swept == SweptBox2d<float>(BoundingBox2d<float>(1.0f, 2.0f, 3.0f, 4.0f), Vector2d<float>(5.0f, 6.0f)), "constexpr equality");
+    }
+}
+
+TEST_CASE("SweptBox2d - sweeping against static boxes", "[math::SweptBox2d]")
+{
+    // A thin wall, from x = 10 to 10.5.
+    const BoundingBox2d<float> wall(10.25f, 0.0f, 0.25f, 5.0f);
+    float time = -1.0f;
+    Vector2d<float> normal(7.0f, 7.0f);
+
+    SECTION("A fast box doesn't tunnel through a thin wall")
+    {
+        const SweptBox2d<float> mover(BoundingBox2d<float>(0.0f, 0.0f, 1.0f, 1.0f), Vector2d<float>(16.0f, 0.0f));
+        CHECK_FALSE(mover.getBoxAt(0.0f).intersects(wall));
+        CHECK_FALSE(mover.getBoxAt(1.0f).intersects(wall));
+
+        REQUIRE(mover.intersects(wall, time, normal));
+        CHECK(time == 0.5625f);
+        CHECK(normal == Vector2d<float>(-1.0f, 0.0f));
+        CHECK(mover.intersects(wall));
+    }
+
+    SECTION("Hitting from the other side, and from above")
+    {
+        const SweptBox2d<float> left(BoundingBox2d<float>(20.0f, 1.0f, 1.0f, 1.0f), Vector2d<float>(-16.0f, -1.0f));
+        REQUIRE(left.intersects(wall, time, normal));
+        CHECK(time == 0.53125f);
+        CHECK(normal == Vector2d<float>(1.0f, 0.0f));
+
+        const SweptBox2d<float> down(BoundingBox2d<float>(10.0f, 9.0f, 1.0f, 2.0f), Vector2d<float>(0.0f, -4.0f));
+        REQUIRE(down.intersects(wall, time, normal));
+        CHECK(time == 0.5f);
+        CHECK(normal == Vector2d<float>(0.0f, 1.0f));
+    }
+
+    SECTION("Misses leave the time and normal unchanged")
+    {
+        const SweptBox2d<float> tooShort(BoundingBox2d<float>(0.0f, 0.0f, 1.0f, 1.0f), Vector2d<float>(5.0f, 0.0f));
+        CHECK_FALSE(tooShort.intersects(wall, time, normal));
+        const SweptBox2d<float> passingAbove(BoundingBox2d<float>(0.0f, 7.0f, 1.0f, 1.0f), Vector2d<float>(20.0f, 0.0f));
+        CHECK_FALSE(passingAbove.intersects(wall, time, normal));
+        const SweptBox2d<float> movingAway(BoundingBox2d<float>(0.0f, 0.0f, 1.0f, 1.0f), Vector2d<float>(-20.0f, 3.0f));
+        CHECK_FALSE(movingAway.intersects(wall, time, normal));
+        CHECK(time == -1.0f);
+        CHECK(normal == Vector2d<float>(7.0f, 7.0f));
+    }
+
+    SECTION("Touching at the start of the step")
+    {
+        // Moving into the wall gives a normal, even though the time is 0.
+        const SweptBox2d<float> into(BoundingBox2d<float>(9.0f, 0.0f, 1.0f, 1.0f), Vector2d<float>(5.0f, 0.0f));
+        REQUIRE(into.intersects(wall, time, normal));
+        CHECK(time == 0.0f);
+        CHECK(normal == Vector2d<float>(-1.0f, 0.0f));
+
+        // Moving along the face also touches it, but no face is crossed.
+        const SweptBox2d<float> along(BoundingBox2d<float>(9.0f, 0.0f, 1.0f, 1.0f), Vector2d<float>(0.0f, 5.0f));
+        REQUIRE(along.intersects(wall, time, normal));
+        CHECK(time == 0.0f);
+        CHECK(normal == Vector2d<float>(0.0f, 0.0f));
+    }
+
+    SECTION("Overlapping at the start of the step gives a zero normal")
+    {
+        const SweptBox2d<float> inside(BoundingBox2d<float>(10.0f, 0.0f, 1.0f, 1.0f), Vector2d<float>(3.0f, 1.0f));
+        REQUIRE(inside.intersects(wall, time, normal));
+        CHECK(time == 0.0f);
+        CHECK(normal == Vector2d<float>(0.0f, 0.0f));
+
+        const SweptBox2d<float> still(BoundingBox2d<float>(10.0f, 0.0f, 1.0f, 1.0f), Vector2d<float>());
+        REQUIRE(still.intersects(wall, time, normal));
+        CHECK(normal == Vector2d<float>(0.0f, 0.0f));
+        CHECK_FALSE(SweptBox2d<float>(BoundingBox2d<float>(0.0f, 0.0f, 1.0f, 1.0f), Vector2d<float>()).intersects(wall));
+    }
+
+    SECTION("An exact corner hit uses the x axis")
+    {
+        const SweptBox2d<float> corner(BoundingBox2d<float>(8.0f, 7.0f, 1.0f, 1.0f), Vector2d<float>(2.0f, -2.0f));
+        REQUIRE(corner.intersects(wall, time, normal));
+        CHECK(time == 0.5f);
+        CHECK(normal == Vector2d<float>(-1.0f, 0.0f));
+    }
+
+    SECTION("Aabb2d gives the same results, and empty boxes are never hit")
+    {
+        const SweptBox2d<float> mover(BoundingBox2d<float>(0.0f, 0.0f, 1.0f, 1.0f), Vector2d<float>(16.0f, 0.0f));
+        REQUIRE(mover.intersects(Aabb2d<float>(wall), time, normal));
+        CHECK(time == 0.5625f);
+        CHECK(normal == Vector2d<float>(-1.0f, 0.0f));
+        CHECK_FALSE(mover.intersects(Aabb2d<float>(10.5f, -5.0f, 10.0f, 5.0f)));
+    }
+}
+
+TEST_CASE("SweptBox2d - sweeping two moving boxes", "[math::SweptBox2d]")
+{
+    double time = -1.0;
+    Vector2d<double> normal;
+
+    SECTION("Head on")
+    {
+        const SweptBox2d<double> a(BoundingBox2d<double>(0.0, 0.0, 1.0, 1.0), Vector2d<double>(10.0, 0.0));
+        const SweptBox2d<double> b(BoundingBox2d<double>(10.0, 0.5, 1.0, 1.0), Vector2d<double>(-10.0, 0.0));
+        REQUIRE(a.intersects(b, time, normal));
+        CHECK(time == 0.4);
+        CHECK(normal == Vector2d<double>(-1.0, 0.0));
+        CHECK(a.getBoxAt(time).getCornerX2Y2().x == b.getBoxAt(time).getCornerX1Y1().x);
+
+        REQUIRE(b.intersects(a, time, normal));
+        CHECK(time == 0.4);
+        CHECK(normal == Vector2d<double>(1.0, 0.0));
+    }
+
+    SECTION("Catching up from behind")
+    {
+        const SweptBox2d<double> a(BoundingBox2d<double>(0.0, 0.0, 1.0, 1.0), Vector2d<double>(0.0, 20.0));
+        const SweptBox2d<double> b(BoundingBox2d<double>(0.0, 6.0, 1.0, 1.0), Vector2d<double>(0.0, 12.0));
+        REQUIRE(a.intersects(b, time, normal));
+        CHECK(time == 0.5);
+        CHECK(normal == Vector2d<double>(0.0, -1.0));
+        CHECK(a.intersects(b));
+    }
+
+    SECTION("Moving together never hits")
+    {
+        const SweptBox2d<double> a(BoundingBox2d<double>(0.0, 0.0, 1.0, 1.0), Vector2d<double>(50.0, 50.0));
+        const SweptBox2d<double> b(BoundingBox2d<double>(3.0, 0.0, 1.0, 1.0), Vector2d<double>(50.0, 50.0));
+        CHECK_FALSE(a.intersects(b));
+
+        // Their paths cross, but they're never in the same place at once.
+        const SweptBox2d<double> c(BoundingBox2d<double>(-10.0, 0.0, 1.0, 1.0), Vector2d<double>(20.0, 0.0));
+        const SweptBox2d<double> d(BoundingBox2d<double>(10.0, 10.0, 1.0, 1.0), Vector2d<double>(-20.0, -10.0));
+        CHECK(c.getSweptBounds().intersects(d.getSweptBounds()));
+        CHECK_FALSE(c.intersects(d));
+    }
+}
+
+TEST_CASE("SweptBox2d - hits agree with the boxes along the movement", "[math::SweptBox2d]")
+{
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> coord(-20.0, 20.0);
+    std::uniform_real_distribution<double> size(0.1, 4.0);
+
+    int hits = 0, misses = 0;
+    bool allConsistent = true;
+    for (int i = 0; i < 5000; ++i) {
+        const SweptBox2d<double> mover(BoundingBox2d<double>(coord(rng), coord(rng), size(rng), size(rng)),
+            Vector2d<double>(coord(rng), coord(rng)));
+        const BoundingBox2d<double> target(coord(rng), coord(rng), size(rng), size(rng));
+        const BoundingBox2d<double> grown(target.pos, target.radius + Vector2d<double>(1e-9, 1e-9));
+        const BoundingBox2d<double> shrunk(target.pos, target.radius - Vector2d<double>(1e-9, 1e-9));
+
+        double time = 0.0;
+        Vector2d<double> normal;
+        if (mover.intersects(target, time, normal)) {
+            // The boxes touch at the time of impact, and don't overlap just before it.
+            ++hits;
+            allConsistent = allConsistent && time >= 0.0 && time <= 1.0 &&
+                mover.getBoxAt(time).intersects(grown) &&
+                (time < 1e-6 || !mover.getBoxAt(time - 1e-6).intersects(shrunk));
+        } else {
+            // The boxes never overlap at any point during the step.
+            ++misses;
+            for (int t = 0; t <= 100; ++t)
+                allConsistent = allConsistent && !mover.getBoxAt(t / 100.0).intersects(shrunk);
+        }
+    }
+    CHECK(hits > 100);
+    CHECK(misses > 100);
+    CHECK(allConsistent);
+}
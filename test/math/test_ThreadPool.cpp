@@ -0,0 +1,195 @@
+/** \file test_ThreadPool.cpp
+    \brief Unit testing for the work-stealing thread pool and parallel loops.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Run a loop on a pool, and count how many times each chunk was called.
+std::vector<int> countChunkCalls(ThreadPool & pool, const std::size_t chunkCount)
+{
+    std::unique_ptr<std::atomic<int>[]> calls(new std::atomic<int>[chunkCount]);
+    for (std::size_t i = 0; i < chunkCount; ++i)
+        calls[i] = 0;
+
+    pool.run(chunkCount, [&](const std::size_t chunk) {
+        // Make the work uneven, so that threads have to steal.
+        volatile std::size_t spin = (chunk % 7 == 0) ? 20000 : 10;
+        while (spin > 0)
+            spin = spin - 1;
+        ++calls[chunk];
+    });
+
+    std::vector<int> result;
+    for (std::size_t i = 0; i < chunkCount; ++i)
+        result.push_back(calls[i]);
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("ThreadPool - construction", "[math::ThreadPool]")
+{
+    SECTION("Explicit thread count")
+    {
+        ThreadPool pool(3);
+        CHECK(pool.getThreadCount() == 3);
+    }
+
+    SECTION("Automatic thread count")
+    {
+        ThreadPool pool;
+        CHECK(pool.getThreadCount() >= 1);
+        CHECK(ThreadPool::getDefault().getThreadCount() >= 1);
+    }
+}
+
+TEST_CASE("ThreadPool - run", "[math::ThreadPool]")
+{
+    SECTION("Every chunk runs exactly once")
+    {
+        for (unsigned threads = 1; threads <= 8; threads *= 2) {
+            ThreadPool pool(threads);
+            for (const std::size_t chunkCount : { 1, 2, 7, 100, 5000 })
+                CHECK(countChunkCalls(pool, chunkCount) == std::vector<int>(chunkCount, 1));
+        }
+    }
+
+    SECTION("No chunks")
+    {
+        ThreadPool pool(4);
+        bool called = false;
+        pool.run(0, [&](std::size_t) { called = true; });
+        CHECK_FALSE(called);
+    }
+
+    SECTION("Exceptions are rethrown, and the pool can still be used")
+    {
+        ThreadPool pool(4);
+        CHECK_THROWS_AS(pool.run(1000, [](const std::size_t chunk) {
+            if (chunk == 500)
+                throw std::runtime_error("test");
+        }), std::runtime_error);
+        CHECK(countChunkCalls(pool, 1000) == std::vector<int>(1000, 1));
+    }
+
+    SECTION("Nested loops run serially")
+    {
+        ThreadPool pool(4);
+        std::atomic<int> total(0);
+        pool.run(16, [&](std::size_t) {
+            pool.run(16, [&](std::size_t) { ++total; });
+        });
+        CHECK(total == 256);
+    }
+
+    SECTION("Several threads can use the same pool")
+    {
+        ThreadPool pool(4);
+        std::vector<std::vector<int>> results(4);
+        std::vector<std::thread> callers;
+        for (std::size_t i = 0; i < results.size(); ++i)
+            callers.emplace_back([&, i] { results[i] = countChunkCalls(pool, 1000); });
+        for (std::thread & caller : callers)
+            caller.join();
+        for (const std::vector<int> & result : results)
+            CHECK(result == std::vector<int>(1000, 1));
+    }
+}
+
+TEST_CASE("ThreadPool - parallel loops", "[math::ThreadPool]")
+{
+    ThreadPool pool(4);
+
+    SECTION("parallelFor covers the range in sub-ranges of the grain size")
+    {
+        std::vector<int> covered(1000, 0);
+        std::atomic<bool> tooLong(false);
+        parallelFor(covered.size(), [&](const std::size_t begin, const std::size_t end) {
+            if (end - begin > 64)
+                tooLong = true;
+            for (std::size_t i = begin; i < end; ++i)
+                ++covered[i];
+        }, pool, 64);
+        CHECK(covered == std::vector<int>(1000, 1));
+        CHECK_FALSE(tooLong);
+    }
+
+    SECTION("parallelFor uses the default pool")
+    {
+        std::vector<int> covered(100000, 0);
+        parallelFor(covered.size(), [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+                ++covered[i];
+        });
+        CHECK(covered == std::vector<int>(100000, 1));
+    }
+
+    SECTION("parallelReduce gives the same result for any number of threads")
+    {
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+        std::vector<float> values;
+        for (int i = 0; i < 100000; ++i)
+            values.push_back(dist(rng));
+
+        const auto sum = [&](const std::size_t begin, const std::size_t end) {
+            float total = 0.0f;
+            for (std::size_t i = begin; i < end; ++i)
+                total += values[i];
+            return total;
+        };
+        const auto add = [](const float lhs, const float rhs) { return lhs + rhs; };
+
+        ThreadPool serial(1);
+        const float expected = parallelReduce(values.size(), 0.0f, sum, add, serial, 100);
+        for (unsigned threads = 2; threads <= 8; threads *= 2) {
+            ThreadPool parallel(threads);
+            CHECK(parallelReduce(values.size(), 0.0f, sum, add, parallel, 100) == expected);
+        }
+    }
+
+    SECTION("parallelReduce combines values in order")
+    {
+        const std::vector<std::size_t> begins = parallelReduce(std::size_t(1000), std::vector<std::size_t>(),
+            [](const std::size_t begin, std::size_t) { return std::vector<std::size_t>(1, begin); },
+            [](std::vector<std::size_t> lhs, const std::vector<std::size_t> & rhs) {
+                lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+                return lhs;
+            }, pool, 10);
+        REQUIRE(begins.size() == 100);
+        for (std::size_t i = 0; i < begins.size(); ++i)
+            CHECK(begins[i] == i * 10);
+    }
+
+    SECTION("parallelReduce of an empty range gives the identity")
+    {
+        CHECK(parallelReduce(0, 42, [](std::size_t, std::size_t) { return 1; }, [](int lhs, int rhs) { return lhs + rhs; }, pool) == 42);
+    }
+
+    SECTION("parallelReduce of bools")
+    {
+        const auto both = [](const bool lhs, const bool rhs) { return lhs && rhs; };
+        CHECK(parallelReduce(std::size_t(5000), true,
+            [](const std::size_t begin, std::size_t) { return begin <= 5000; }, both, pool, 1));
+        CHECK_FALSE(parallelReduce(std::size_t(5000), true,
+            [](const std::size_t begin, std::size_t) { return begin != 2048; }, both, pool, 1));
+    }
+}
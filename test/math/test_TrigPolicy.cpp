@@ -0,0 +1,205 @@
+/** \file test_TrigPolicy.cpp
+    \brief Unit testing for the trig accuracy policies used by Polar and Vector2d conversions.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+using namespace ail::math;
+
+namespace {
+
+// Map a floating point value onto an integer scale where adjacent values differ by 1.
+// Positive and negative zero both map to 0.
+int64_t toOrdered(const float val)
+{
+    int32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    return (bits < 0) ? -static_cast<int64_t>(bits & 0x7fffffff) : bits;
+}
+
+int64_t toOrdered(const double val)
+{
+    int64_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    return (bits < 0) ? -(bits & 0x7fffffffffffffffLL) : bits;
+}
+
+// Get the distance between two values in units in the last place.
+template <typename T_ty>
+uint64_t ulpDistance(const T_ty lhs, const T_ty rhs)
+{
+    const int64_t a = toOrdered(lhs);
+    const int64_t b = toOrdered(rhs);
+    return (a > b) ? static_cast<uint64_t>(a - b) : static_cast<uint64_t>(b - a);
+}
+
+// Get the largest error of a policy's sin/cos/atan2 compared to the standard library.
+// Float results are compared to double precision results rounded to float.
+template <typename T_policy, typename T_ty>
+uint64_t worstSinCosUlp()
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> large(-1e6, 1e6);
+    std::uniform_real_distribution<double> small(-10.0, 10.0);
+
+    uint64_t worst = 0;
+    for (int i = 0; i < 100000; ++i) {
+        const T_ty angle = static_cast<T_ty>((i % 2) ? large(rng) : small(rng));
+        const double exact = static_cast<double>(angle);
+        worst = std::max(worst, ulpDistance(T_policy::sin(angle), static_cast<T_ty>(std::sin(exact))));
+        worst = std::max(worst, ulpDistance(T_policy::cos(angle), static_cast<T_ty>(std::cos(exact))));
+    }
+    return worst;
+}
+
+template <typename T_policy, typename T_ty>
+uint64_t worstAtan2Ulp()
+{
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+
+    uint64_t worst = 0;
+    for (int i = 0; i < 100000; ++i) {
+        const T_ty y = static_cast<T_ty>(dist(rng));
+        const T_ty x = static_cast<T_ty>(dist(rng));
+        const double exact = std::atan2(static_cast<double>(y), static_cast<double>(x));
+        worst = std::max(worst, ulpDistance(T_policy::atan2(y, x), static_cast<T_ty>(exact)));
+    }
+    return worst;
+}
+
+} // namespace
+
+TEST_CASE("TrigPolicy - exact policy is the default", "[math::TrigPolicy]")
+{
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+
+    bool allMatch = true;
+    for (int i = 0; i < 1000; ++i) {
+        const Polar<double> p(dist(rng), dist(rng));
+        const Vector2d<double> v(dist(rng), dist(rng));
+        const Vector2d<double> pv = p.toVector2d();
+        const Polar<double> vp = v.toPolar();
+
+        allMatch = allMatch &&
+            pv == p.toVector2d<TrigExact>() &&
+            pv.x == p.mag * std::cos(p.angle) &&
+            pv.y == p.mag * std::sin(p.angle) &&
+            vp == v.toPolar<TrigExact>() &&
+            vp.mag == v.getLength();
+    }
+    CHECK(allMatch);
+
+    SECTION("Integer types keep the standard library return types")
+    {
+        const Polar<int> p(2, 100);
+        CHECK(p.toVector2d<TrigExact>() == Vector2d<int>(static_cast<int>(100 * std::cos(2)), static_cast<int>(100 * std::sin(2))));
+    }
+}
+
+TEST_CASE("TrigPolicy - minimax policy accuracy", "[math::TrigPolicy]")
+{
+    CHECK(worstSinCosUlp<TrigMinimax, float>() <= 2);
+    CHECK(worstSinCosUlp<TrigMinimax, double>() <= 2);
+    CHECK(worstAtan2Ulp<TrigMinimax, float>() <= 3);
+    CHECK(worstAtan2Ulp<TrigMinimax, double>() <= 2);
+}
+
+TEST_CASE("TrigPolicy - table policy accuracy", "[math::TrigPolicy]")
+{
+    CHECK(worstSinCosUlp<TrigTable, float>() <= 2);
+    CHECK(worstSinCosUlp<TrigTable, double>() <= 3);
+    CHECK(worstAtan2Ulp<TrigTable, float>() <= 2);
+    CHECK(worstAtan2Ulp<TrigTable, double>() <= 2);
+
+    SECTION("Exact values")
+    {
+        CHECK(TrigTable::sin(0.0) == 0.0);
+        CHECK(TrigTable::cos(0.0) == 1.0);
+        CHECK(TrigTable::atan2(0.0f, 0.0f) == 0.0f);
+        CHECK(TrigTable::atan2(1.0, 1.0) == Approx(pi<double>() * 0.25));
+    }
+}
+
+TEST_CASE("TrigPolicy - CORDIC policy", "[math::TrigPolicy]")
+{
+    SECTION("Matches the CORDIC functions")
+    {
+        float s, c;
+        cordicSinCos<16>(1.25f, s, c);
+        CHECK(TrigCordic<16>::sin(1.25f) == s);
+        CHECK(TrigCordic<16>::cos(1.25f) == c);
+        CHECK(TrigCordic<16>::atan2(-2.0f, 3.0f) == cordicAtan2<16>(-2.0f, 3.0f));
+        CHECK(TrigCordic<>::atan2(-2.0, 3.0) == cordicAtan2<cordic::maxIterations>(-2.0, 3.0));
+    }
+
+    SECTION("Polar to cartesian uses sin and cos together")
+    {
+        const Polar<double> p(2.5, 10.0);
+        double s, c;
+        cordicSinCos<24>(p.angle, s, c);
+        const Vector2d<double> v = p.toVector2d<TrigCordic<24>>();
+        CHECK(v.x == p.mag * c);
+        CHECK(v.y == p.mag * s);
+        CHECK(v.isApproxEqual(p.toVector2d(), 1e-5));
+    }
+
+    SECTION("Cartesian to polar uses the angle and length together")
+    {
+        const Vector2d<double> v(-3.0, -4.0);
+        double angle, length;
+        cordicAtan2Hypot<24>(v.y, v.x, angle, length);
+        const Polar<double> p = v.toPolar<TrigCordic<24>>();
+        CHECK(p.angle == wrapAngle(angle));
+        CHECK(p.mag == length);
+        CHECK(p.isApproxEqual(v.toPolar(), 1e-6));
+    }
+}
+
+TEST_CASE("TrigPolicy - Polar and Vector2d conversions", "[math::TrigPolicy]")
+{
+    const Polar<float> p1(0.5f, 10.0f);
+    const Polar<float> p2(0.501f, 10.0f);
+    const Vector2d<float> v(-3.0f, 4.0f);
+
+    SECTION("Polar to cartesian")
+    {
+        CHECK(p1.toVector2d<TrigMinimax>().isApproxEqual(p1.toVector2d(), 1e-5f));
+        CHECK(p1.toVector2d<TrigTable>().isApproxEqual(p1.toVector2d(), 1e-5f));
+        CHECK(p1.toVector2d<TrigCordic<>>().isApproxEqual(p1.toVector2d(), 1e-5f));
+
+        Vector2d<float> out;
+        p1.toVector2d<TrigTable>(out);
+        CHECK(out == p1.toVector2d<TrigTable>());
+    }
+
+    SECTION("Cartesian to polar")
+    {
+        const Polar<float> exact = v.toPolar();
+        CHECK(v.toPolar<TrigMinimax>().isApproxEqual(exact, 1e-6f));
+        CHECK(v.toPolar<TrigTable>().isApproxEqual(exact, 1e-6f));
+        CHECK(v.toPolar<TrigTable>().mag == exact.mag);
+        CHECK(v.toPolar<TrigCordic<>>().isApproxEqual(exact, 1e-6f));
+    }
+
+    SECTION("Proximity")
+    {
+        CHECK(p1.isNear<TrigMinimax>(p2, 0.02f));
+        CHECK_FALSE(p1.isNear<TrigMinimax>(p2, 0.005f));
+        CHECK(p1.isNear<TrigTable>(p2, 0.02f));
+        CHECK_FALSE(p1.isNear<TrigTable>(p2, 0.005f));
+    }
+}
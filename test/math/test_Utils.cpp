@@ -10,8 +10,65 @@
 
 #include "../common.h"
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <type_traits>
+
 using namespace ail::math;
 
+namespace {
+
+// Get the result which wrapAngle() should give, i.e. wrap() except that 2 pi becomes 0.
+template <typename T_ty>
+T_ty expectedWrapAngle(const T_ty angle)
+{
+    const T_ty wrapped = wrap(angle, T_ty(0), T_ty(2) * pi<T_ty>());
+    return (wrapped == T_ty(2) * pi<T_ty>()) ? T_ty(0) : wrapped;
+}
+
+// Check that wrapAngle() gives exactly the expected result (including the sign of zero), and that it's in range.
+template <typename T_ty>
+bool isWrapAngleCorrect(const T_ty angle)
+{
+    const T_ty actual = wrapAngle(angle);
+    if (std::isnan(actual))
+        return std::isnan(expectedWrapAngle(angle));
+
+    const T_ty expected = expectedWrapAngle(angle);
+    return std::memcmp(&actual, &expected, sizeof(T_ty)) == 0 &&
+        actual >= T_ty(0) && actual < T_ty(2) * pi<T_ty>();
+}
+
+// Check wrapAngle() for every float bit pattern from first to last (inclusive), stepping by stride.
+// Returns the number of incorrect results. The first few are reported.
+std::uint64_t checkFloatPatterns(const std::uint64_t first, const std::uint64_t last, const std::uint64_t stride)
+{
+    std::uint64_t failures = 0;
+    for (std::uint64_t bits = first; bits <= last; bits += stride) {
+        const std::uint32_t pattern = static_cast<std::uint32_t>(bits);
+        float angle;
+        std::memcpy(&angle, &pattern, sizeof(angle));
+        if (!isWrapAngleCorrect(angle)) {
+            if (++failures <= 10)
+                UNSCOPED_INFO("wrapAngle(" << angle << ") gave " << wrapAngle(angle) << " instead of " << expectedWrapAngle(angle));
+        }
+    }
+    return failures;
+}
+
+// Check every float pattern within count steps either side of a non-zero value.
+std::uint64_t checkFloatPatternsAround(const float centre, const std::uint32_t count)
+{
+    std::uint32_t pattern;
+    std::memcpy(&pattern, &centre, sizeof(pattern));
+    return checkFloatPatterns(pattern - count, pattern + count, 1);
+}
+
+} // namespace
+
 TEST_CASE("Utils - Angle conversion", "[Utils]")
 {
     SECTION("Degrees to other angles")
@@ -574,6 +631,168 @@ TEST_CASE("Utils - General numerical", "[Utils]")
     }
 }
 
+TEST_CASE("Utils - wrapAngle", "[Utils]")
+{
+    SECTION("Examples")
+    {
+        CHECK(wrapAngle(0.0) == 0.0);
+        CHECK(wrapAngle(1.5) == 1.5);
+        CHECK(wrapAngle(pi<double>() * 2.0) == 0.0);
+        CHECK(wrapAngle(-pi<double>() * 2.0) == 0.0);
+        CHECK(wrapAngle(-pi<double>()) == Approx(pi<double>()));
+        CHECK(wrapAngle(pi<double>() * 5.5) == Approx(pi<double>() * 1.5));
+        CHECK(wrapAngle(-1e-20f) == 0.0f);
+        CHECK(wrapAngle(-1e-20) == 0.0);
+        CHECK(wrapAngle(-1e-9f) < pi<float>() * 2.0f);
+        CHECK(wrapAngle(1e20) == wrap(1e20, 0.0, pi<double>() * 2.0));
+        CHECK(std::isnan(wrapAngle(std::numeric_limits<float>::infinity())));
+        CHECK(std::isnan(wrapAngle(std::numeric_limits<double>::quiet_NaN())));
+        CHECK(wrapAngle(-1e-20L) == 0.0L);
+        CHECK(wrapAngle(7.0L) == Approx(7.0 - (pi<double>() * 2.0)));
+    }
+
+    SECTION("float matches wrap for a sample of bit patterns")
+    {
+        // The stride is prime so that every exponent and a wide variety of mantissas are covered.
+        CHECK(checkFloatPatterns(0, 0xFFFFFFFFu, 4093) == 0);
+
+        // Check densely around zero (positive then negative), whole turns, and the limit of the fast path.
+        CHECK(checkFloatPatterns(0, 100000, 1) == 0);
+        CHECK(checkFloatPatterns(0x80000000u, 0x80000000u + 100000, 1) == 0);
+        for (int turns = -3; turns <= 3; ++turns)
+            CHECK(checkFloatPatternsAround(static_cast<float>(turns) * pi<float>() * 2.0f, 20000) == 0);
+        CHECK(checkFloatPatternsAround(3.0e9f, 1000) == 0);
+        CHECK(checkFloatPatternsAround(-3.0e9f, 1000) == 0);
+    }
+
+    SECTION("double matches wrap")
+    {
+        std::mt19937_64 rng(16);
+        std::uniform_real_distribution<double> linear(-1000.0, 1000.0);
+        std::uniform_real_distribution<double> exponent(-30.0, 9.0);
+        std::bernoulli_distribution negative(0.5);
+
+        std::uint64_t failures = 0;
+        for (int i = 0; i < 200000; ++i) {
+            const double sign = negative(rng) ? -1.0 : 1.0;
+            const double angle = (i % 2 == 0) ? linear(rng) : sign * std::pow(10.0, exponent(rng));
+            if (!isWrapAngleCorrect(angle))
+                ++failures;
+        }
+        CHECK(failures == 0);
+
+        // Values either side of whole turns and the limit of the fast path.
+        for (int turns = -1000; turns <= 1000; ++turns) {
+            const double angle = static_cast<double>(turns) * pi<double>() * 2.0;
+            CHECK(isWrapAngleCorrect(angle));
+            CHECK(isWrapAngleCorrect(std::nextafter(angle, -1e300)));
+            CHECK(isWrapAngleCorrect(std::nextafter(angle, 1e300)));
+        }
+        CHECK(isWrapAngleCorrect(4.0e8));
+        CHECK(isWrapAngleCorrect(std::nextafter(4.0e8, 0.0)));
+        CHECK(isWrapAngleCorrect(-std::nextafter(4.0e8, 0.0)));
+        CHECK(isWrapAngleCorrect(std::numeric_limits<double>::denorm_min()));
+        CHECK(isWrapAngleCorrect(-std::numeric_limits<double>::denorm_min()));
+        CHECK(isWrapAngleCorrect(-0.0));
+    }
+}
+
+// This checks every float, which takes several minutes. Run it explicitly with the [exhaustive] tag
+//  (selecting the [Utils] tag on its own will also run it).
+TEST_CASE("Utils - wrapAngle matches wrap for every float", "[.][exhaustive][Utils]")
+{
+    CHECK(checkFloatPatterns(0, 0xFFFFFFFFu, 1) == 0);
+}
+
+TEST_CASE("Utils - Integer utilities", "[Utils]")
+{
+    SECTION("widened")
+    {
+        CHECK((std::is_same<widened<std::int8_t>::type, std::int64_t>::value));
+        CHECK((std::is_same<widened<std::int32_t>::type, std::int64_t>::value));
+        CHECK((std::is_same<widened<std::uint32_t>::type, std::uint64_t>::value));
+        CHECK((std::is_same<widened<std::int64_t>::type, std::int64_t>::value));
+        CHECK((std::is_same<widened<float>::type, float>::value));
+        CHECK((std::is_same<widened<double>::type, double>::value));
+    }
+
+    SECTION("isqrt - exact squares")
+    {
+        CHECK(isqrt(0) == 0);
+        CHECK(isqrt(1) == 1);
+        CHECK(isqrt(4) == 2);
+        CHECK(isqrt(144) == 12);
+        CHECK(isqrt(std::int64_t(3037000499) * 3037000499) == 3037000499);
+        CHECK(isqrt(std::uint64_t(4294967295u) * 4294967295u) == 4294967295u);
+    }
+
+    SECTION("isqrt - rounds down")
+    {
+        CHECK(isqrt(2) == 1);
+        CHECK(isqrt(3) == 1);
+        CHECK(isqrt(143) == 11);
+        CHECK(isqrt(145) == 12);
+        CHECK(isqrt(std::numeric_limits<std::int32_t>::max()) == 46340);
+        CHECK(isqrt(std::numeric_limits<std::int64_t>::max()) == 3037000499);
+        CHECK(isqrt(std::numeric_limits<std::uint64_t>::max()) == 4294967295u);
+        CHECK(isqrt(std::uint8_t(255)) == 15);
+    }
+
+    SECTION("isqrt - negative values give 0")
+    {
+        CHECK(isqrt(-1) == 0);
+        CHECK(isqrt(std::numeric_limits<std::int64_t>::lowest()) == 0);
+    }
+
+    SECTION("isqrt - random values")
+    {
+        std::mt19937_64 rng(1);
+        for (int i = 0; i < 10000; ++i) {
+            // Vary the size of the values, so that small ones are tested too.
+            const std::uint64_t val = rng() >> (i % 64);
+            const std::uint64_t root = isqrt(val);
+            const bool correct =
+                (root * root <= val) &&
+                (root == 4294967295u || (root + 1) * (root + 1) > val);
+            CHECK(correct);
+        }
+    }
+
+    SECTION("fastIsqrt matches isqrt")
+    {
+        std::mt19937_64 rng(2);
+        for (int i = 0; i < 10000; ++i) {
+            const std::uint64_t val = rng() >> (i % 64);
+            CHECK(intsqrt::fastIsqrt(val) == isqrt(val));
+        }
+
+        // Check either side of squares, where rounding the floating point estimate matters most.
+        for (std::uint64_t root = 4294967295u; root > 4294000000u; root -= 997) {
+            const std::uint64_t square = root * root;
+            CHECK(intsqrt::fastIsqrt(square - 1) == root - 1);
+            CHECK(intsqrt::fastIsqrt(square) == root);
+            CHECK(intsqrt::fastIsqrt(square + 1) == root);
+        }
+        CHECK(intsqrt::fastIsqrt(0) == 0);
+        CHECK(intsqrt::fastIsqrt(std::numeric_limits<std::uint64_t>::max()) == 4294967295u);
+    }
+
+    SECTION("floorDiv")
+    {
+        CHECK(floorDiv(7, 2) == 3);
+        CHECK(floorDiv(-7, 2) == -4);
+        CHECK(floorDiv(7, -2) == -4);
+        CHECK(floorDiv(-7, -2) == 3);
+        CHECK(floorDiv(-8, 2) == -4);
+        CHECK(floorDiv(0, 5) == 0);
+        CHECK(floorDiv(-1, 16) == -1);
+        CHECK(floorDiv(-16, 16) == -1);
+        CHECK(floorDiv(-17, 16) == -2);
+        CHECK(floorDiv(15u, 4u) == 3u);
+        CHECK(floorDiv(std::numeric_limits<std::int64_t>::lowest(), std::int64_t(3)) == -3074457345618258603);
+    }
+}
+
 TEST_CASE("Utils - Comparisons", "[Utils]")
 {
     SECTION("isApproxEqual - integers")
@@ -921,3 +1140,5 @@ static_assert(diff(1, 2) == 0 || true, "Compile-time evaluation check");
 static_assert(clamp(1, 2, 3) == 0 || true, "Compile-time evaluation check");
 static_assert(lerp(1.0, 2.0, 3.0) || true, "Compile-time evaluation check");
 static_assert(lerpClamp(1.0, 2.0, 3.0) || true, "Compile-time evaluation check");
+static_assert(isqrt(std::int64_t(1) << 62) == (std::int64_t(1) << 31), "Compile-time evaluation check");
+static_assert(floorDiv(-1, 2) == -1, "Compile-time evaluation check");
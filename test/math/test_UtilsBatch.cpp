@@ -0,0 +1,292 @@
+/** \file test_UtilsBatch.cpp
+    \brief Unit testing for the span versions of the utility functions, checking every SIMD level against the scalar functions.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Get all the SIMD levels which this CPU supports.
+std::vector<SimdLevel> getTestableLevels()
+{
+    std::vector<SimdLevel> levels;
+    const int highest = static_cast<int>(getSupportedSimdLevel());
+    for (int i = 0; i <= highest; ++i)
+        levels.push_back(static_cast<SimdLevel>(i));
+    return levels;
+}
+
+// Check that two values have exactly the same bit pattern, or are both NaN.
+// The payload of a NaN can depend on the order of the operands, so it isn't compared.
+template <typename T_ty>
+bool isSame(const T_ty lhs, const T_ty rhs)
+{
+    if (std::isnan(lhs) && std::isnan(rhs))
+        return true;
+    return std::memcmp(&lhs, &rhs, sizeof(T_ty)) == 0;
+}
+
+// Generate random test values on a mixture of scales, including some awkward values.
+// An odd count is used so that every kernel has to deal with a partial register at the end.
+template <typename T_ty>
+std::vector<T_ty> makeTestValues(const unsigned seed)
+{
+    typedef std::numeric_limits<T_ty> Limits;
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<T_ty> linear(T_ty(-2000), T_ty(2000));
+    std::uniform_real_distribution<T_ty> exponent(T_ty(-30), T_ty(30));
+    std::bernoulli_distribution negative(0.5);
+
+    std::vector<T_ty> values;
+    for (int i = 0; i < 1021; ++i) {
+        if (i % 3 == 0)
+            values.push_back((negative(rng) ? T_ty(-1) : T_ty(1)) * std::pow(T_ty(10), exponent(rng)));
+        else
+            values.push_back(linear(rng));
+    }
+
+    const T_ty awkward[] = {
+        T_ty(0), -T_ty(0), T_ty(360), T_ty(-360), T_ty(720), T_ty(-720), T_ty(180), T_ty(-180),
+        T_ty(-1e-30), T_ty(1e-30), T_ty(1e9), T_ty(-1e9), T_ty(1e20), T_ty(-1e20),
+        Limits::max(), Limits::lowest(), Limits::min(), Limits::denorm_min(),
+        Limits::infinity(), -Limits::infinity(), Limits::quiet_NaN(),
+        std::nextafter(T_ty(360), T_ty(0)), std::nextafter(T_ty(-360), T_ty(0)),
+        T_ty(2) * pi<T_ty>(), T_ty(-2) * pi<T_ty>(), T_ty(7) * pi<T_ty>(), T_ty(-7) * pi<T_ty>()
+    };
+    for (std::size_t i = 0; i < sizeof(awkward) / sizeof(awkward[0]); ++i)
+        values[(i * 37) % values.size()] = awkward[i];
+    return values;
+}
+
+// Call a span function at every SIMD level, for every starting offset, and check each result against a scalar function.
+// Unaligned and short spans are covered by the offsets.
+template <typename T_ty, typename T_span, typename T_scalar>
+void checkSpan(const std::vector<T_ty> & input, const T_span & spanFunction, const T_scalar & scalarFunction)
+{
+    const SimdLevel original = getSimdLevel();
+
+    for (const SimdLevel level : getTestableLevels()) {
+        INFO("SIMD level " << static_cast<int>(level));
+        REQUIRE(setSimdLevel(level) == level);
+
+        for (std::size_t offset = 0; offset < 20; ++offset) {
+            const std::size_t n = input.size() - offset;
+            std::vector<T_ty> output(n);
+            spanFunction(input.data() + offset, output.data(), n);
+
+            bool allMatch = true;
+            for (std::size_t i = 0; i < n; ++i) {
+                const bool match = isSame(output[i], scalarFunction(input[offset + i], offset + i));
+                if (!match)
+                    UNSCOPED_INFO("Mismatch at " << (offset + i) << " for input " << input[offset + i]);
+                allMatch = allMatch && match;
+            }
+            CHECK(allMatch);
+        }
+    }
+
+    setSimdLevel(original);
+}
+
+template <typename T_ty>
+void checkWrap()
+{
+    typedef std::numeric_limits<T_ty> Limits;
+    const std::vector<T_ty> values = makeTestValues<T_ty>(1);
+
+    const T_ty ranges[][2] = {
+        { T_ty(0), T_ty(360) },
+        { T_ty(-180), T_ty(180) },
+        { T_ty(0), T_ty(2) * pi<T_ty>() },
+        { -pi<T_ty>(), pi<T_ty>() },
+        { T_ty(360), T_ty(0) },
+        { T_ty(-0.7), T_ty(1.3) },
+        { T_ty(0.1), T_ty(0.3) },
+        { T_ty(-1e-3), T_ty(1e-3) },
+        { -T_ty(0), T_ty(1) },
+        { T_ty(1e30), T_ty(-1e30) },
+        { T_ty(5), T_ty(5) },
+        { Limits::lowest(), Limits::max() },
+        { Limits::quiet_NaN(), T_ty(1) }
+    };
+
+    for (const auto & range : ranges) {
+        INFO("Range " << range[0] << " to " << range[1]);
+        const T_ty rangeMin = range[0], rangeMax = range[1];
+        checkSpan(values,
+            [&](const T_ty * in, T_ty * out, std::size_t n) { wrap(in, rangeMin, rangeMax, out, n); },
+            [&](const T_ty val, std::size_t) { return wrap(val, rangeMin, rangeMax); });
+    }
+}
+
+template <typename T_ty>
+void checkClampAndLerp()
+{
+    const std::vector<T_ty> values = makeTestValues<T_ty>(2);
+    const std::vector<T_ty> others = makeTestValues<T_ty>(3);
+
+    const T_ty ranges[][2] = {
+        { T_ty(-100), T_ty(100) },
+        { T_ty(100), T_ty(-100) },
+        { T_ty(5), T_ty(5) },
+        { -T_ty(0), T_ty(0) },
+        { T_ty(0), -T_ty(0) },
+        { std::numeric_limits<T_ty>::quiet_NaN(), T_ty(1) }
+    };
+
+    for (const auto & range : ranges) {
+        INFO("Range " << range[0] << " to " << range[1]);
+        const T_ty r1 = range[0], r2 = range[1];
+        checkSpan(values,
+            [&](const T_ty * in, T_ty * out, std::size_t n) { clamp(in, r1, r2, out, n); },
+            [&](const T_ty val, std::size_t) { return clamp(val, r1, r2); });
+        checkSpan(values,
+            [&](const T_ty * in, T_ty * out, std::size_t n) { lerp(in, r1, r2, out, n); },
+            [&](const T_ty val, std::size_t) { return lerp(val, r1, r2); });
+        checkSpan(values,
+            [&](const T_ty * in, T_ty * out, std::size_t n) { lerpClamp(in, r1, r2, out, n); },
+            [&](const T_ty val, std::size_t) { return lerpClamp(val, r1, r2); });
+    }
+
+    const T_ty amounts[] = { T_ty(0), T_ty(0.25), T_ty(1), T_ty(-1.5), T_ty(2) };
+    for (const T_ty amount : amounts) {
+        INFO("Amount " << amount);
+        // The end values are found at the same offset in the other span.
+        checkSpan(values,
+            [&](const T_ty * in, T_ty * out, std::size_t n) { lerp(amount, in, others.data() + (in - values.data()), out, n); },
+            [&](const T_ty val, std::size_t i) { return lerp(amount, val, others[i]); });
+        checkSpan(values,
+            [&](const T_ty * in, T_ty * out, std::size_t n) { lerpClamp(amount, in, others.data() + (in - values.data()), out, n); },
+            [&](const T_ty val, std::size_t i) { return lerpClamp(amount, val, others[i]); });
+    }
+}
+
+template <typename T_ty>
+void checkAngleConversions()
+{
+    const std::vector<T_ty> values = makeTestValues<T_ty>(4);
+
+    #define AIL_TEST_ANGLE_SPAN(name) \
+        checkSpan(values, \
+            [](const T_ty * in, T_ty * out, std::size_t n) { name(in, out, n); }, \
+            [](const T_ty val, std::size_t) { return name(val); })
+
+    AIL_TEST_ANGLE_SPAN(degToRad);
+    AIL_TEST_ANGLE_SPAN(degToGrad);
+    AIL_TEST_ANGLE_SPAN(degToTurn);
+    AIL_TEST_ANGLE_SPAN(radToDeg);
+    AIL_TEST_ANGLE_SPAN(radToGrad);
+    AIL_TEST_ANGLE_SPAN(radToTurn);
+    AIL_TEST_ANGLE_SPAN(gradToDeg);
+    AIL_TEST_ANGLE_SPAN(gradToRad);
+    AIL_TEST_ANGLE_SPAN(gradToTurn);
+    AIL_TEST_ANGLE_SPAN(turnToDeg);
+    AIL_TEST_ANGLE_SPAN(turnToRad);
+    AIL_TEST_ANGLE_SPAN(turnToGrad);
+
+    #undef AIL_TEST_ANGLE_SPAN
+}
+
+} // namespace
+
+TEST_CASE("UtilsBatch - wrap matches the scalar version", "[math::UtilsBatch]")
+{
+    SECTION("float")
+    {
+        checkWrap<float>();
+    }
+
+    SECTION("double")
+    {
+        checkWrap<double>();
+    }
+}
+
+TEST_CASE("UtilsBatch - clamp and lerp match the scalar versions", "[math::UtilsBatch]")
+{
+    SECTION("float")
+    {
+        checkClampAndLerp<float>();
+    }
+
+    SECTION("double")
+    {
+        checkClampAndLerp<double>();
+    }
+}
+
+TEST_CASE("UtilsBatch - angle conversions match the scalar versions", "[math::UtilsBatch]")
+{
+    SECTION("float")
+    {
+        checkAngleConversions<float>();
+    }
+
+    SECTION("double")
+    {
+        checkAngleConversions<double>();
+    }
+}
+
+TEST_CASE("UtilsBatch - wrap of large quotients falls back to fmod", "[math::UtilsBatch]")
+{
+    // Every lane needs the fallback, including when the output overwrites the input.
+    std::vector<double> values;
+    for (int i = 0; i < 64; ++i)
+        values.push_back(1e12 + (i * 1234.5678));
+
+    std::vector<double> output(values);
+    wrap(output.data(), 0.0, 360.0, output.data(), output.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+        CHECK(output[i] == wrap(values[i], 0.0, 360.0));
+}
+
+TEST_CASE("UtilsBatch - in place", "[math::UtilsBatch]")
+{
+    std::vector<float> angles = makeTestValues<float>(5);
+    const std::vector<float> original(angles);
+
+    wrap(angles.data(), 0.0f, 360.0f, angles.data(), angles.size());
+    degToRad(angles.data(), angles.data(), angles.size());
+
+    bool allMatch = true;
+    for (std::size_t i = 0; i < angles.size(); ++i)
+        allMatch = allMatch && isSame(angles[i], degToRad(wrap(original[i], 0.0f, 360.0f)));
+    CHECK(allMatch);
+}
+
+TEST_CASE("UtilsBatch - generic types use the scalar reference", "[math::UtilsBatch]")
+{
+    const int values[] = { -725, -360, -1, 0, 359, 360, 1000 };
+    int wrapped[7], clamped[7], degrees[7];
+    wrap(values, 0, 360, wrapped, 7);
+    clamp(values, 100, -100, clamped, 7);
+    turnToDeg(values, degrees, 7);
+
+    for (int i = 0; i < 7; ++i) {
+        CHECK(wrapped[i] == wrap(values[i], 0, 360));
+        CHECK(clamped[i] == clamp(values[i], 100, -100));
+        CHECK(degrees[i] == turnToDeg(values[i]));
+    }
+
+    const long double amounts[] = { -0.5L, 0.0L, 0.75L, 2.0L };
+    long double lerped[4];
+    lerpClamp(amounts, 10.0L, 20.0L, lerped, 4);
+    for (int i = 0; i < 4; ++i)
+        CHECK(lerped[i] == lerpClamp(amounts[i], 10.0L, 20.0L));
+}
@@ -10,6 +10,15 @@
 
 #include "../common.h"
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
 using namespace ail::math;
 
 TEST_CASE("Vector2d - construction and assignment", "[math::Vector2d]")
@@ -129,6 +138,60 @@ TEST_CASE("Vector2d - construction and assignment", "[math::Vector2d]")
     }
 }
 
+TEST_CASE("Vector2d - compile time use and trivial copying", "[math::Vector2d]")
+{
+    SECTION("Vectors are trivially copyable")
+    {
+        static_assert(std::is_trivially_copyable<Vector2d<int>>::value, "Vector2d<int> should be trivially copyable");
+        static_assert(std::is_trivially_copyable<Vector2d<float>>::value, "Vector2d<float> should be trivially copyable");
+        static_assert(std::is_trivially_copyable<Vector2d<double>>::value, "Vector2d<double> should be trivially copyable");
+
+        const std::vector<Vector2d<float>> src { {1.5f, -2.0f}, {3.0f, 4.25f}, {-5.0f, 6.0f} };
+        std::vector<Vector2d<float>> dst(src.size());
+        std::memcpy(dst.data(), src.data(), src.size() * sizeof(Vector2d<float>));
+        CHECK(dst == src);
+    }
+
+    SECTION("Construction, comparison and products are constexpr")
+    {
+        constexpr Vector2d<int> v(3, -4);
+        static_assert(v.x == 3 && v.y == -4, "constexpr construction");
+        static_assert(Vector2d<int>() == Vector2d<int>(0, 0), "constexpr default construction");
+        static_assert(v != Vector2d<int>(3, 4), "constexpr inequality");
+        static_assert(-v == Vector2d<int>(-3, 4), "constexpr negation");
+        static_assert(v.getSqLength() == 25, "constexpr squared length");
+        static_assert(v.dot(Vector2d<int>(2, 1)) == 2, "constexpr dot product");
+        static_assert(v.getRightTangent() == Vector2d<int>(-4, -3), "constexpr right tangent");
+        static_assert(v.getLeftTangent() == Vector2d<int>(4, 3), "constexpr left tangent");
+
+        // A lookup table built at compile time.
+        constexpr Vector2d<float> directions[] = {
+            Vector2d<float>(1.0f, 0.0f), Vector2d<float>(0.0f, 1.0f),
+            Vector2d<float>(-1.0f, 0.0f), Vector2d<float>(0.0f, -1.0f)
+        };
+        static_assert(directions[1].getLeftTangent() == directions[2], "constexpr lookup table");
+        CHECK(directions[3] == Vector2d<float>(0.0f, -1.0f));
+    }
+
+#if AIL_MATH_HAS_CONSTEXPR14
+    SECTION("Arithmetic is constexpr in C++14")
+    {
+        constexpr Vector2d<int> a(1, 2);
+        constexpr Vector2d<int> b(6, -8);
+        static_assert(a + b == Vector2d<int>(7, -6), "constexpr addition");
+        static_assert(a - b == Vector2d<int>(-5, 10), "constexpr subtraction");
+        static_assert(a * 3 == Vector2d<int>(3, 6), "constexpr multiplication");
+        static_assert(3 * a == Vector2d<int>(3, 6), "constexpr multiplication");
+        static_assert(b / 2 == Vector2d<int>(3, -4), "constexpr division");
+        static_assert(24 / b == Vector2d<int>(4, -3), "constexpr division");
+        static_assert(a.getSqDistance(b) == 125, "constexpr squared distance");
+        static_assert(Vector2d<int> { 5, 6 } == Vector2d<int>(5, 6), "constexpr initializer list");
+        static_assert(Vector2d<int> {} == Vector2d<int>(), "constexpr initializer list");
+        CHECK(a + b == Vector2d<int>(7, -6));
+    }
+#endif
+}
+
 TEST_CASE("Vector2d - comparison operators", "[math::Vector2d]")
 {
     const Vector2d<int>
@@ -815,6 +878,125 @@ TEST_CASE("Vector2d - distance", "[math::Vector2d]")
     }
 }
 
+TEST_CASE("Vector2d - integer operations", "[math::Vector2d]")
+{
+    typedef std::numeric_limits<std::int32_t> Limits32;
+    typedef std::numeric_limits<std::int64_t> Limits64;
+
+    SECTION("Euclidean length is exact")
+    {
+        CHECK(Vector2d<int>(0, 0).getLength() == 0);
+        CHECK(Vector2d<int>(3, -4).getLength() == 5);
+        CHECK(Vector2d<int>(-5, -12).getLength() == 13);
+        // Rounded down.
+        CHECK(Vector2d<int>(1, 1).getLength() == 1);
+        CHECK(Vector2d<int>(-7, 3).getLength() == 7);
+        // No overflow, even though the squared length doesn't fit in 32 bits.
+        CHECK(Vector2d<int>(300000, -400000).getLength() == 500000);
+        CHECK(Vector2d<std::int64_t>(1800000000, -2400000000).getLength() == 3000000000);
+        CHECK(Vector2d<std::int64_t>(4294967295, 0).getLength() == 4294967295);
+        // 64-bit integers can overflow though.
+        CHECK_THROWS_AS(Vector2d<std::int64_t>(4294967296, 0).getLength(), std::overflow_error);
+        CHECK_THROWS_AS(Vector2d<std::int64_t>(Limits64::max(), Limits64::max()).getLength(), std::overflow_error);
+    }
+
+    SECTION("Euclidean length matches isqrt")
+    {
+        std::mt19937 rng(1);
+        std::uniform_int_distribution<std::int32_t> components(Limits32::lowest() + 1, Limits32::max());
+        for (int i = 0; i < 10000; ++i) {
+            // Vary the size of the values, so that small ones are tested too.
+            const int shift = i % 31;
+            const Vector2d<std::int32_t> v(components(rng) >> shift, components(rng) >> shift);
+            CHECK(v.getLength() == static_cast<std::int32_t>(isqrt(v.getWideSqLength())));
+        }
+    }
+
+    SECTION("Wide squared length")
+    {
+        CHECK((std::is_same<decltype(Vector2d<std::int32_t>().getWideSqLength()), std::int64_t>::value));
+        CHECK((std::is_same<decltype(Vector2d<double>().getWideSqLength()), double>::value));
+
+        CHECK(Vector2d<int>(-7, 3).getWideSqLength() == 58);
+        CHECK(Vector2d<int>(Limits32::max(), Limits32::lowest()).getWideSqLength() == 9223372032559808513);
+        CHECK(Vector2d<double>(1.5, -2.0).getWideSqLength() == Approx(6.25));
+        CHECK(Vector2d<std::int64_t>(3037000499, 0).getWideSqLength() == 9223372030926249001);
+        CHECK_THROWS_AS(Vector2d<int>(Limits32::lowest(), Limits32::lowest()).getWideSqLength(), std::overflow_error);
+        CHECK_THROWS_AS(Vector2d<std::int64_t>(3037000500, 0).getWideSqLength(), std::overflow_error);
+    }
+
+    SECTION("Wide squared distance")
+    {
+        CHECK(Vector2d<int>(1, 2).getWideSqDistance(Vector2d<int>(4, -2)) == 25);
+        // The differences don't fit in 32 bits.
+        CHECK(Vector2d<int>(2000000000, 0).getWideSqDistance(Vector2d<int>(-1000000000, 0)) == 9000000000000000000);
+        CHECK_THROWS_AS(Vector2d<int>(Limits32::max(), 0).getWideSqDistance(Vector2d<int>(Limits32::lowest(), 0)), std::overflow_error);
+    }
+
+    SECTION("Chebyshev length and distance")
+    {
+        CHECK(Vector2d<int>(0, 0).getChebyshevLength() == 0);
+        CHECK(Vector2d<int>(-7, 3).getChebyshevLength() == 7);
+        CHECK(Vector2d<int>(2, -9).getChebyshevLength() == 9);
+        CHECK(Vector2d<double>(-1.5, 0.5).getChebyshevLength() == Approx(1.5));
+        CHECK(Vector2d<int>(5, 3).getChebyshevDistance(Vector2d<int>(9, -3)) == 6);
+        CHECK(Vector2d<int>(-2, 46).getChebyshevDistance(Vector2d<int>(13, 63)) == 17);
+        CHECK(Vector2d<int>(-2, 46).getChebyshevDistance(Vector2d<int>(-2, 46)) == 0);
+    }
+
+    SECTION("Normalisation rounds to the nearest grid direction")
+    {
+        CHECK(Vector2d<int>(0, 0).getNormalised() == Vector2d<int>(0, 0));
+        CHECK(Vector2d<int>(15, 0).getNormalised() == Vector2d<int>(1, 0));
+        CHECK(Vector2d<int>(0, -4).getNormalised() == Vector2d<int>(0, -1));
+        CHECK(Vector2d<int>(-3, 4).getNormalised() == Vector2d<int>(-1, 1));
+        CHECK(Vector2d<int>(10, -10).getNormalised() == Vector2d<int>(1, -1));
+        CHECK(Vector2d<int>(2, 1).getNormalised() == Vector2d<int>(1, 0));
+        CHECK(Vector2d<int>(-1, -2).getNormalised() == Vector2d<int>(0, -1));
+        CHECK(Vector2d<std::int64_t>(Limits64::lowest(), Limits64::max()).getNormalised() == Vector2d<std::int64_t>(-1, 1));
+        CHECK(Vector2d<std::int64_t>(Limits64::max(), 1).getNormalised() == Vector2d<std::int64_t>(1, 0));
+
+        Vector2d<int> v(-40, 3);
+        v.normalise();
+        CHECK(v == Vector2d<int>(-1, 0));
+    }
+
+    SECTION("Normalisation matches rounding a floating point unit vector")
+    {
+        std::mt19937_64 rng(1);
+        for (int i = 0; i < 10000; ++i) {
+            // Vary the size of the values, so that small ones are tested too.
+            const int shift = i % 63;
+            const Vector2d<std::int64_t> v(static_cast<std::int64_t>(rng()) >> shift, static_cast<std::int64_t>(rng()) >> shift);
+            if (v == Vector2d<std::int64_t>())
+                continue;
+            const long double length = std::sqrt((static_cast<long double>(v.x) * v.x) + (static_cast<long double>(v.y) * v.y));
+            const Vector2d<std::int64_t> expected(
+                static_cast<std::int64_t>(std::round(v.x / length)),
+                static_cast<std::int64_t>(std::round(v.y / length)));
+            CHECK(v.getNormalised() == expected);
+        }
+    }
+
+    SECTION("Floor division")
+    {
+        CHECK(floorDiv(Vector2d<int>(15, -1), 16) == Vector2d<int>(0, -1));
+        CHECK(floorDiv(Vector2d<int>(-32, 33), 16) == Vector2d<int>(-2, 2));
+        CHECK(floorDiv(Vector2d<int>(-7, 7), Vector2d<int>(4, 2)) == Vector2d<int>(-2, 3));
+    }
+
+    SECTION("Compile-time evaluation")
+    {
+        constexpr Vector2d<int> v(-7, 3);
+        static_assert(v.getWideSqLength() == 58, "constexpr wide squared length");
+        static_assert(v.getWideSqDistance(Vector2d<int>(-4, -1)) == 25, "constexpr wide squared distance");
+        static_assert(v.getChebyshevLength() == 7, "constexpr Chebyshev length");
+        static_assert(v.getChebyshevDistance(Vector2d<int>(1, 1)) == 8, "constexpr Chebyshev distance");
+        static_assert(floorDiv(v, 2) == Vector2d<int>(-4, 1), "constexpr floor division");
+        CHECK(floorDiv(v, Vector2d<int>(2, 2)) == Vector2d<int>(-4, 1));
+    }
+}
+
 TEST_CASE("Vector2d - proximity", "[math::Vector2d]")
 {
     // TODO: Construct vectors here instead of in the test sections.
@@ -0,0 +1,351 @@
+/** \file test_Vector2dArray.cpp
+    \brief Unit testing for the Vector2dArray class.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+using namespace ail::math;
+
+TEST_CASE("Vector2dArray - construction and assignment", "[math::Vector2dArray]")
+{
+    SECTION("Default construction is empty")
+    {
+        Vector2dArray<float> a;
+        CHECK(a.size() == 0);
+        CHECK(a.empty());
+        CHECK(a.x() == nullptr);
+        CHECK(a.y() == nullptr);
+    }
+
+    SECTION("Sized construction initialises to 0")
+    {
+        Vector2dArray<int> a(5);
+        REQUIRE(a.size() == 5);
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            CHECK(a.x()[i] == 0);
+            CHECK(a.y()[i] == 0);
+        }
+    }
+
+    SECTION("Sized construction with value")
+    {
+        Vector2dArray<double> a(3, Vector2d<double>(1.5, -2.5));
+        REQUIRE(a.size() == 3);
+        for (std::size_t i = 0; i < a.size(); ++i)
+            CHECK(a.get(i) == Vector2d<double>(1.5, -2.5));
+    }
+
+    SECTION("Uniform initialisation")
+    {
+        Vector2dArray<int> a { {1, 2}, {3, 4}, {-5, 6} };
+        REQUIRE(a.size() == 3);
+        CHECK(a.get(0) == Vector2d<int>(1, 2));
+        CHECK(a.get(1) == Vector2d<int>(3, 4));
+        CHECK(a.get(2) == Vector2d<int>(-5, 6));
+    }
+
+    SECTION("Construction from interleaved vectors")
+    {
+        const Vector2d<float> src[] = { {1.0f, 2.0f}, {3.0f, 4.0f} };
+        Vector2dArray<float> a(src, 2);
+        REQUIRE(a.size() == 2);
+        CHECK(a.get(0) == src[0]);
+        CHECK(a.get(1) == src[1]);
+
+        Vector2d<float> out[2];
+        a.copyTo(out);
+        CHECK(out[0] == src[0]);
+        CHECK(out[1] == src[1]);
+    }
+
+    SECTION("Lanes are aligned")
+    {
+        Vector2dArray<float> a(17);
+        CHECK(reinterpret_cast<std::uintptr_t>(a.x()) % defaultAlignment == 0);
+        CHECK(reinterpret_cast<std::uintptr_t>(a.y()) % defaultAlignment == 0);
+    }
+
+    SECTION("Copy construction and assignment")
+    {
+        Vector2dArray<int> a { {1, 2}, {3, 4} };
+        Vector2dArray<int> b(a);
+        CHECK(b == a);
+        CHECK(b.x() != a.x());
+
+        Vector2dArray<int> c;
+        c = a;
+        CHECK(c == a);
+    }
+
+    SECTION("Move construction and assignment")
+    {
+        Vector2dArray<int> a { {1, 2}, {3, 4} };
+        const int * lane = a.x();
+        Vector2dArray<int> b(std::move(a));
+        CHECK(b.size() == 2);
+        CHECK(b.x() == lane);
+        CHECK(a.size() == 0);
+
+        Vector2dArray<int> c;
+        c = std::move(b);
+        CHECK(c.size() == 2);
+        CHECK(c.x() == lane);
+        CHECK(b.empty());
+    }
+
+    SECTION("Equality")
+    {
+        Vector2dArray<int> a { {1, 2}, {3, 4} };
+        Vector2dArray<int> b { {1, 2}, {3, 4} };
+        Vector2dArray<int> c { {1, 2}, {3, 5} };
+        Vector2dArray<int> d { {1, 2} };
+        CHECK(a == b);
+        CHECK_FALSE(a != b);
+        CHECK(a != c);
+        CHECK(a != d);
+    }
+}
+
+TEST_CASE("Vector2dArray - storage", "[math::Vector2dArray]")
+{
+    SECTION("push_back grows the array")
+    {
+        Vector2dArray<int> a;
+        for (int i = 0; i < 100; ++i)
+            a.push_back(Vector2d<int>(i, -i));
+
+        REQUIRE(a.size() == 100);
+        CHECK(a.capacity() >= 100);
+        for (int i = 0; i < 100; ++i)
+            CHECK(a.get(i) == Vector2d<int>(i, -i));
+    }
+
+    SECTION("resize keeps existing elements and zeroes new ones")
+    {
+        Vector2dArray<int> a { {1, 2} };
+        a.resize(3);
+        REQUIRE(a.size() == 3);
+        CHECK(a.get(0) == Vector2d<int>(1, 2));
+        CHECK(a.get(2) == Vector2d<int>(0, 0));
+
+        a.resize(1);
+        CHECK(a.size() == 1);
+        CHECK(a.get(0) == Vector2d<int>(1, 2));
+    }
+
+    SECTION("reserve and clear")
+    {
+        Vector2dArray<float> a;
+        a.reserve(50);
+        CHECK(a.capacity() >= 50);
+        CHECK(a.empty());
+
+        a.push_back(Vector2d<float>(1.0f, 1.0f));
+        a.clear();
+        CHECK(a.empty());
+        CHECK(a.capacity() >= 50);
+    }
+
+    SECTION("Reserving more than can be addressed throws, leaving the array unchanged")
+    {
+        Vector2dArray<float> a;
+        a.push_back(Vector2d<float>(1.0f, 2.0f));
+        CHECK_THROWS_AS(a.reserve(std::numeric_limits<std::size_t>::max()), std::length_error);
+        CHECK_THROWS_AS(a.reserve((std::numeric_limits<std::size_t>::max() / sizeof(float)) + 1), std::length_error);
+
+        // This fits in size_t, but the padding for alignment would wrap round.
+        CHECK_THROWS_AS(a.reserve(std::numeric_limits<std::size_t>::max() / sizeof(float)), std::bad_alloc);
+        REQUIRE(a.size() == 1);
+        CHECK(a.get(0) == Vector2d<float>(1.0f, 2.0f));
+    }
+
+    SECTION("Assigning a bigger array replaces the contents")
+    {
+        Vector2dArray<float> a, b;
+        a.push_back(Vector2d<float>(9.0f, 9.0f));
+        for (int i = 0; i < 100; ++i)
+            b.push_back(Vector2d<float>(float(i), float(-i)));
+        a = b;
+        REQUIRE(a.size() == 100);
+        CHECK(a.capacity() >= 100);
+        CHECK(a.get(0) == Vector2d<float>(0.0f, 0.0f));
+        CHECK(a.get(99) == Vector2d<float>(99.0f, -99.0f));
+    }
+}
+
+TEST_CASE("Vector2dArray - element proxies", "[math::Vector2dArray]")
+{
+    Vector2dArray<int> a { {1, 2}, {3, 4}, {5, 6} };
+
+    SECTION("Subscript reads and writes through to the lanes")
+    {
+        a[1] = Vector2d<int>(-7, 8);
+        CHECK(a.x()[1] == -7);
+        CHECK(a.y()[1] == 8);
+
+        a[0].x = 10;
+        CHECK(a.get(0) == Vector2d<int>(10, 2));
+
+        a[2] = a[0];
+        CHECK(a.get(2) == Vector2d<int>(10, 2));
+    }
+
+    SECTION("Proxy arithmetic")
+    {
+        a[0] += Vector2d<int>(1, 1);
+        CHECK(a.get(0) == Vector2d<int>(2, 3));
+
+        a[1] -= Vector2d<int>(1, 1);
+        CHECK(a.get(1) == Vector2d<int>(2, 3));
+
+        a[2] *= 2;
+        CHECK(a.get(2) == Vector2d<int>(10, 12));
+
+        a[2] /= 2;
+        CHECK(a.get(2) == Vector2d<int>(5, 6));
+    }
+
+    SECTION("Proxy converts to Vector2d")
+    {
+        const Vector2d<int> v = a[1];
+        CHECK(v == Vector2d<int>(3, 4));
+        CHECK(a[1].get().getSqLength() == 25);
+    }
+
+    SECTION("Mutable iteration")
+    {
+        for (auto v : a)
+            v *= -1;
+
+        CHECK(a.get(0) == Vector2d<int>(-1, -2));
+        CHECK(a.get(2) == Vector2d<int>(-5, -6));
+    }
+
+    SECTION("Read-only iteration")
+    {
+        const Vector2dArray<int> & ca = a;
+        std::vector<Vector2d<int>> copies;
+        for (const auto v : ca)
+            copies.push_back(v);
+
+        REQUIRE(copies.size() == 3);
+        CHECK(copies[1] == Vector2d<int>(3, 4));
+    }
+}
+
+TEST_CASE("Vector2dArray - batch arithmetic", "[math::Vector2dArray]")
+{
+    Vector2dArray<double> a { {1.0, 2.0}, {-3.0, 4.5}, {0.0, 0.0} };
+    const Vector2dArray<double> b { {0.5, 0.5}, {1.0, -1.0}, {2.0, 3.0} };
+
+    SECTION("Array addition and subtraction")
+    {
+        a += b;
+        CHECK(a.get(0) == Vector2d<double>(1.5, 2.5));
+        CHECK(a.get(1) == Vector2d<double>(-2.0, 3.5));
+        CHECK(a.get(2) == Vector2d<double>(2.0, 3.0));
+
+        a -= b;
+        CHECK(a.get(0) == Vector2d<double>(1.0, 2.0));
+        CHECK(a.get(1) == Vector2d<double>(-3.0, 4.5));
+        CHECK(a.get(2) == Vector2d<double>(0.0, 0.0));
+    }
+
+    SECTION("Mismatched sizes throw")
+    {
+        Vector2dArray<double> c(2);
+        CHECK_THROWS(a += c);
+        CHECK_THROWS(a -= c);
+
+        double out[3];
+        CHECK_THROWS(a.dot(c, out));
+    }
+
+    SECTION("Vector offset")
+    {
+        a += Vector2d<double>(1.0, -1.0);
+        CHECK(a.get(1) == Vector2d<double>(-2.0, 3.5));
+
+        a -= Vector2d<double>(1.0, -1.0);
+        CHECK(a.get(1) == Vector2d<double>(-3.0, 4.5));
+    }
+
+    SECTION("Scalar multiplication and division")
+    {
+        a *= 2.0;
+        CHECK(a.get(0) == Vector2d<double>(2.0, 4.0));
+        CHECK(a.get(1) == Vector2d<double>(-6.0, 9.0));
+
+        a /= 4.0;
+        CHECK(a.get(0) == Vector2d<double>(0.5, 1.0));
+        CHECK(a.get(1) == Vector2d<double>(-1.5, 2.25));
+    }
+
+    SECTION("Results match element-wise Vector2d operations")
+    {
+        Vector2dArray<double> c(a);
+        c += b;
+        c *= 3.0;
+        for (std::size_t i = 0; i < a.size(); ++i)
+            CHECK(c.get(i) == (a.get(i) + b.get(i)) * 3.0);
+    }
+}
+
+TEST_CASE("Vector2dArray - batch operations", "[math::Vector2dArray]")
+{
+    Vector2dArray<float> a { {3.0f, 4.0f}, {-0.5f, 0.25f}, {0.0f, 0.0f}, {12.0f, -5.0f} };
+
+    SECTION("Lengths")
+    {
+        float len[4], sqLen[4];
+        a.getLengths(len);
+        a.getSqLengths(sqLen);
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            CHECK(len[i] == a.get(i).getLength());
+            CHECK(sqLen[i] == a.get(i).getSqLength());
+        }
+        CHECK(len[0] == Approx(5.0f));
+        CHECK(len[3] == Approx(13.0f));
+    }
+
+    SECTION("Normalise matches Vector2d::getNormalised")
+    {
+        Vector2dArray<float> n(a);
+        n.normalise();
+        for (std::size_t i = 0; i < a.size(); ++i)
+            CHECK(n.get(i) == a.get(i).getNormalised());
+
+        // Zero length vectors are left unchanged.
+        CHECK(n.get(2) == Vector2d<float>(0.0f, 0.0f));
+    }
+
+    SECTION("Dot product with another array")
+    {
+        const Vector2dArray<float> b { {1.0f, 0.0f}, {2.0f, 2.0f}, {1.0f, 1.0f}, {-1.0f, 2.0f} };
+        float out[4];
+        a.dot(b, out);
+        for (std::size_t i = 0; i < a.size(); ++i)
+            CHECK(out[i] == a.get(i).dot(b.get(i)));
+    }
+
+    SECTION("Dot product with a single vector")
+    {
+        const Vector2d<float> v(0.5f, -2.0f);
+        float out[4];
+        a.dot(v, out);
+        for (std::size_t i = 0; i < a.size(); ++i)
+            CHECK(out[i] == a.get(i).dot(v));
+    }
+}
@@ -0,0 +1,186 @@
+/** \file test_Vector2dExpr.cpp
+    \brief Unit testing for the Vector2d expression templates.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// A numeric type which counts how many times it's copied. Moves aren't counted.
+// This stands in for user numeric types which are expensive to copy.
+struct Counted
+{
+    static int copies;
+
+    Counted(const int v = 0) : value(v) {}
+    Counted(const Counted & rhs) : value(rhs.value) { ++copies; }
+    Counted(Counted && rhs) : value(rhs.value) {}
+    Counted & operator = (const Counted & rhs) { value = rhs.value; ++copies; return *this; }
+    Counted & operator = (Counted && rhs) { value = rhs.value; return *this; }
+
+    Counted & operator += (const Counted & rhs) { value += rhs.value; return *this; }
+    Counted & operator -= (const Counted & rhs) { value -= rhs.value; return *this; }
+
+    Counted operator + (const Counted & rhs) const { return Counted(value + rhs.value); }
+    Counted operator - (const Counted & rhs) const { return Counted(value - rhs.value); }
+    bool operator == (const Counted & rhs) const { return value == rhs.value; }
+
+    int value;
+};
+
+int Counted::copies = 0;
+
+template <typename T_ty>
+std::vector<Vector2d<T_ty>> makeBuffer(const std::size_t count, const unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(-1000, 1000);
+    std::vector<Vector2d<T_ty>> buffer;
+    for (std::size_t i = 0; i < count; ++i)
+        buffer.push_back(Vector2d<T_ty>(T_ty(dist(rng)) / T_ty(8), T_ty(dist(rng)) / T_ty(8)));
+    return buffer;
+}
+
+} // namespace
+
+TEST_CASE("Vector2dExpr - single vectors", "[math::Vector2dExpr]")
+{
+    const Vector2d<float> a(1.5f, -2.0f), b(3.25f, 4.0f), c(-0.5f, 8.0f);
+    const float s = 2.5f;
+
+    SECTION("Results match the normal operators exactly")
+    {
+        CHECK(expr::eval(expr::lazy(a) + b) == a + b);
+        CHECK(expr::eval(expr::lazy(a) - b) == a - b);
+        CHECK(expr::eval(expr::lazy(a) * s) == a * s);
+        CHECK(expr::eval(s * expr::lazy(a)) == s * a);
+        CHECK(expr::eval(expr::lazy(a) / s) == a / s);
+        CHECK(expr::eval(-expr::lazy(a)) == -a);
+        CHECK(expr::eval(expr::lazy(a) + expr::lazy(b) * s - c) == a + b * s - c);
+        CHECK(expr::eval(a - (expr::lazy(b) + c) / s) == a - (b + c) / s);
+        CHECK(expr::eval(-(expr::lazy(a) - b) * s + c * 2.0f) == -(a - b) * s + c * 2.0f);
+    }
+
+    SECTION("Scalars are converted to the vector type")
+    {
+        CHECK(expr::eval(expr::lazy(a) * 2) == a * 2.0f);
+        CHECK(expr::eval(expr::lazy(Vector2d<int>(7, -9)) / 2) == Vector2d<int>(3, -4));
+    }
+
+    SECTION("Intermediate vectors aren't copied")
+    {
+        const Vector2d<Counted> ca(1, 2), cb(3, 4), cc(5, 6);
+
+        Counted::copies = 0;
+        const Vector2d<Counted> short1 = expr::eval(expr::lazy(ca) + cb);
+        const int shortCopies = Counted::copies;
+
+        Counted::copies = 0;
+        const Vector2d<Counted> long1 = expr::eval(expr::lazy(ca) + cb - cc + ca - cb);
+        const int longCopies = Counted::copies;
+
+        CHECK(short1 == Vector2d<Counted>(4, 6));
+        CHECK(long1 == Vector2d<Counted>(-3, -2));
+        CHECK(longCopies == shortCopies);
+    }
+
+    SECTION("The normal operators reuse temporaries in chains")
+    {
+        const Vector2d<Counted> ca(1, 2), cb(3, 4), cc(5, 6);
+
+        Counted::copies = 0;
+        const Vector2d<Counted> short1 = ca + cb;
+        const int shortCopies = Counted::copies;
+
+        Counted::copies = 0;
+        const Vector2d<Counted> long1 = ca + cb - cc + ca - cb;
+        const int longCopies = Counted::copies;
+
+        CHECK(short1 == Vector2d<Counted>(4, 6));
+        CHECK(long1 == Vector2d<Counted>(-3, -2));
+        CHECK(longCopies == shortCopies);
+    }
+}
+
+TEST_CASE("Vector2dExpr - buffers", "[math::Vector2dExpr]")
+{
+    const std::vector<Vector2d<double>> a = makeBuffer<double>(101, 1);
+    const std::vector<Vector2d<double>> b = makeBuffer<double>(101, 2);
+    const Vector2d<double> offset(0.25, -0.75);
+    const double dt = 0.125;
+
+    SECTION("Each element matches the normal operators exactly")
+    {
+        std::vector<Vector2d<double>> output;
+        expr::assign(output, expr::lazy(a) + expr::lazy(b) * dt - offset);
+        REQUIRE(output.size() == a.size());
+        for (std::size_t i = 0; i < a.size(); ++i)
+            CHECK(output[i] == a[i] + b[i] * dt - offset);
+    }
+
+    SECTION("Buffers can be mixed in directly once there is an expression")
+    {
+        std::vector<Vector2d<double>> output;
+        expr::assign(output, a - (expr::lazy(b) / 4.0) + a);
+        REQUIRE(output.size() == a.size());
+        for (std::size_t i = 0; i < a.size(); ++i)
+            CHECK(output[i] == a[i] - (b[i] / 4.0) + a[i]);
+    }
+
+    SECTION("The output can be one of the operands")
+    {
+        std::vector<Vector2d<double>> positions(a);
+        expr::assign(positions, expr::lazy(positions) + expr::lazy(b) * dt);
+        for (std::size_t i = 0; i < a.size(); ++i)
+            CHECK(positions[i] == a[i] + b[i] * dt);
+
+        expr::assign(positions, -expr::lazy(positions));
+        for (std::size_t i = 0; i < a.size(); ++i)
+            CHECK(positions[i] == -(a[i] + b[i] * dt));
+    }
+
+    SECTION("Raw buffers can be used")
+    {
+        std::vector<Vector2d<double>> output;
+        expr::assign(output, expr::lazy(a.data(), 10) * 3.0);
+        REQUIRE(output.size() == 10);
+        CHECK(output[9] == a[9] * 3.0);
+    }
+
+    SECTION("Expressions without buffers are broadcast to every existing element")
+    {
+        std::vector<Vector2d<double>> output(5);
+        expr::assign(output, expr::lazy(offset) * 2.0);
+        REQUIRE(output.size() == 5);
+        for (const Vector2d<double> & v : output)
+            CHECK(v == offset * 2.0);
+    }
+
+    SECTION("Empty buffers")
+    {
+        const std::vector<Vector2d<double>> empty;
+        std::vector<Vector2d<double>> output(a);
+        expr::assign(output, expr::lazy(empty) + offset);
+        CHECK(output.empty());
+    }
+
+    SECTION("Buffers of different sizes are rejected")
+    {
+        const std::vector<Vector2d<double>> shorter = makeBuffer<double>(100, 3);
+        std::vector<Vector2d<double>> output(a);
+        CHECK_THROWS_AS(expr::assign(output, expr::lazy(a) + shorter), std::invalid_argument);
+        CHECK(output == a);
+    }
+}
@@ -0,0 +1,208 @@
+/** \file test_Vector2dKernels.cpp
+    \brief Unit testing for the batch Vector2d kernels, checking every SIMD level against the scalar Vector2d functions.
+
+    Depends on the Catch framework: https://github.com/philsquared/Catch
+
+    Part of the Avid Insight Library (avidinsight.uk/ail).
+    Copyright (C) 2015-16 Peter R. Bloomfield.
+    Released open source under the MIT licence.
+*/
+
+#include "../common.h"
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace ail::math;
+
+namespace {
+
+// Get all the SIMD levels which this CPU supports.
+std::vector<SimdLevel> getTestableLevels()
+{
+    std::vector<SimdLevel> levels;
+    const int highest = static_cast<int>(getSupportedSimdLevel());
+    for (int i = 0; i <= highest; ++i)
+        levels.push_back(static_cast<SimdLevel>(i));
+    return levels;
+}
+
+// Check that two values have exactly the same bit pattern.
+template <typename T_ty>
+bool isBitIdentical(const T_ty lhs, const T_ty rhs)
+{
+    return std::memcmp(&lhs, &rhs, sizeof(T_ty)) == 0;
+}
+
+// Generate a set of random test vectors, including some awkward values.
+// An odd count is used so that every kernel has to deal with a partial register at the end.
+template <typename T_ty>
+std::vector<Vector2d<T_ty>> makeTestVectors(const unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<T_ty> dist(T_ty(-1000), T_ty(1000));
+
+    std::vector<Vector2d<T_ty>> vectors;
+    for (int i = 0; i < 1021; ++i)
+        vectors.push_back(Vector2d<T_ty>(dist(rng), dist(rng)));
+
+    vectors[3] = Vector2d<T_ty>(0, 0);
+    vectors[10] = Vector2d<T_ty>(T_ty(1e-20), T_ty(-1e-20));
+    vectors[17] = Vector2d<T_ty>(T_ty(0), T_ty(-5));
+    return vectors;
+}
+
+template <typename T_ty>
+void checkKernelsMatchScalar()
+{
+    const std::vector<Vector2d<T_ty>> a = makeTestVectors<T_ty>(1);
+    const std::vector<Vector2d<T_ty>> b = makeTestVectors<T_ty>(2);
+    const Vector2dArray<T_ty> la(a.data(), a.size());
+    const Vector2dArray<T_ty> lb(b.data(), b.size());
+    const std::size_t count = a.size();
+    const Vector2d<T_ty> point(T_ty(12.5), T_ty(-300.25));
+    const T_ty dist = T_ty(400);
+
+    const SimdLevel original = getSimdLevel();
+
+    for (const SimdLevel level : getTestableLevels()) {
+        INFO("SIMD level " << static_cast<int>(level));
+        REQUIRE(setSimdLevel(level) == level);
+
+        // Every starting offset is tested, so unaligned and short spans are covered too.
+        for (std::size_t offset = 0; offset < 20; ++offset) {
+            const std::size_t n = count - offset;
+
+            Vector2dArray<T_ty> norm(la);
+            kernels::normalise(norm.x() + offset, norm.y() + offset, n);
+
+            std::vector<T_ty> dots(n), sqDists(n), pointSqDists(n);
+            kernels::dot(la.x() + offset, la.y() + offset, lb.x() + offset, lb.y() + offset, dots.data(), n);
+            kernels::sqDistance(la.x() + offset, la.y() + offset, lb.x() + offset, lb.y() + offset, sqDists.data(), n);
+            kernels::sqDistance(la.x() + offset, la.y() + offset, point.x, point.y, pointSqDists.data(), n);
+
+            std::unique_ptr<bool[]> near(new bool[n]), pointNear(new bool[n]);
+            kernels::isNear(la.x() + offset, la.y() + offset, lb.x() + offset, lb.y() + offset, dist, near.get(), n);
+            kernels::isNear(la.x() + offset, la.y() + offset, point.x, point.y, dist, pointNear.get(), n);
+
+            // The bounds start from a point in the middle, so that every point can change them.
+            const Vector2d<T_ty> start = a[count / 2];
+            Vector2d<T_ty> minLanes = start, maxLanes = start, minPoints = start, maxPoints = start;
+            Vector2d<T_ty> expectedMin = start, expectedMax = start;
+            kernels::expandBounds(la.x() + offset, la.y() + offset, n, minLanes, maxLanes);
+            kernels::expandBounds(a.data() + offset, n, minPoints, maxPoints);
+            kernels::scalar::expandBounds(a.data() + offset, n, expectedMin, expectedMax);
+            CHECK(isBitIdentical(minLanes.x, expectedMin.x));
+            CHECK(isBitIdentical(minLanes.y, expectedMin.y));
+            CHECK(isBitIdentical(maxLanes.x, expectedMax.x));
+            CHECK(isBitIdentical(maxLanes.y, expectedMax.y));
+            CHECK(minPoints == expectedMin);
+            CHECK(maxPoints == expectedMax);
+
+            bool allMatch = true;
+            for (std::size_t i = 0; i < n; ++i) {
+                const Vector2d<T_ty> & va = a[offset + i];
+                const Vector2d<T_ty> & vb = b[offset + i];
+                const Vector2d<T_ty> expectedNorm = va.getNormalised();
+
+                allMatch = allMatch &&
+                    isBitIdentical(norm.x()[offset + i], expectedNorm.x) &&
+                    isBitIdentical(norm.y()[offset + i], expectedNorm.y) &&
+                    isBitIdentical(dots[i], va.dot(vb)) &&
+                    isBitIdentical(sqDists[i], va.getSqDistance(vb)) &&
+                    isBitIdentical(pointSqDists[i], va.getSqDistance(point)) &&
+                    near[i] == va.isNear(vb, dist) &&
+                    pointNear[i] == va.isNear(point, dist);
+            }
+            CHECK(allMatch);
+        }
+    }
+
+    setSimdLevel(original);
+}
+
+} // namespace
+
+TEST_CASE("Vector2dKernels - SIMD level selection", "[math::Vector2dKernels]")
+{
+    const SimdLevel original = getSimdLevel();
+
+    SECTION("Default level is the highest supported")
+    {
+        CHECK(getSimdLevel() == getSupportedSimdLevel());
+    }
+
+    SECTION("Scalar can always be selected")
+    {
+        CHECK(setSimdLevel(SimdLevel::Scalar) == SimdLevel::Scalar);
+        CHECK(getSimdLevel() == SimdLevel::Scalar);
+    }
+
+    SECTION("Unsupported levels are clamped")
+    {
+        CHECK(setSimdLevel(SimdLevel::AVX512) == getSupportedSimdLevel());
+    }
+
+    setSimdLevel(original);
+}
+
+TEST_CASE("Vector2dKernels - conformance with scalar Vector2d", "[math::Vector2dKernels]")
+{
+    SECTION("float")
+    {
+        checkKernelsMatchScalar<float>();
+    }
+
+    SECTION("double")
+    {
+        checkKernelsMatchScalar<double>();
+    }
+}
+
+TEST_CASE("Vector2dKernels - generic types use the scalar reference", "[math::Vector2dKernels]")
+{
+    const int ax[] = { 3, -4, 0 };
+    const int ay[] = { 4, 2, 0 };
+    const int bx[] = { 1, 1, 7 };
+    const int by[] = { 1, -2, 7 };
+
+    int dots[3], sqDists[3];
+    bool near[3];
+    kernels::dot(ax, ay, bx, by, dots, 3);
+    kernels::sqDistance(ax, ay, bx, by, sqDists, 3);
+    kernels::isNear(ax, ay, 0, 0, 5, near, 3);
+
+    Vector2d<int> minCorner(ax[0], ay[0]), maxCorner(ax[0], ay[0]);
+    kernels::expandBounds(ax + 1, ay + 1, 2, minCorner, maxCorner);
+    CHECK(minCorner == Vector2d<int>(-4, 0));
+    CHECK(maxCorner == Vector2d<int>(3, 4));
+
+    for (int i = 0; i < 3; ++i) {
+        const Vector2d<int> va(ax[i], ay[i]), vb(bx[i], by[i]);
+        CHECK(dots[i] == va.dot(vb));
+        CHECK(sqDists[i] == va.getSqDistance(vb));
+        CHECK(near[i] == va.isNear(Vector2d<int>(), 5));
+    }
+}
+
+TEST_CASE("Vector2dKernels - Vector2dArray batch operations", "[math::Vector2dKernels]")
+{
+    const std::vector<Vector2d<float>> src = makeTestVectors<float>(3);
+    const Vector2dArray<float> arr(src.data(), src.size());
+    const Vector2d<float> point(1.0f, 2.0f);
+
+    std::vector<float> sqDists(arr.size());
+    std::unique_ptr<bool[]> near(new bool[arr.size()]);
+    arr.getSqDistances(point, sqDists.data());
+    arr.isNear(point, 250.0f, near.get());
+
+    bool allMatch = true;
+    for (std::size_t i = 0; i < arr.size(); ++i) {
+        allMatch = allMatch &&
+            sqDists[i] == src[i].getSqDistance(point) &&
+            near[i] == src[i].isNear(point, 250.0f);
+    }
+    CHECK(allMatch);
+}